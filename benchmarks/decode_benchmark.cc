@@ -18,6 +18,8 @@
 #include <stdio.h>
 #include <iostream>
 #include <random>
+#include <string>
+#include <vector>
 
 #include "arrow/test-util.h"
 #include "arrow/util/compression.h"
@@ -32,170 +34,64 @@
  * TODO: this file needs some major cleanup.
  */
 
+// Collects the values to encode and encodes them into a single page
 class DeltaBitPackEncoder {
  public:
-  explicit DeltaBitPackEncoder(int mini_block_size = 8) {
-    mini_block_size_ = mini_block_size;
-  }
+  DeltaBitPackEncoder() : encoder_(nullptr) {}
 
   void Add(int64_t v) { values_.push_back(v); }
 
   uint8_t* Encode(int* encoded_len) {
-    uint8_t* result = new uint8_t[10 * 1024 * 1024];
-    int num_mini_blocks = static_cast<int>(arrow::BitUtil::Ceil(num_values() - 1,
-                                                                mini_block_size_));
-    uint8_t* mini_block_widths = NULL;
-
-    arrow::BitWriter writer(result, 10 * 1024 * 1024);
-
-    // Writer the size of each block. We only use 1 block currently.
-    writer.PutVlqInt(static_cast<uint32_t>(num_mini_blocks * mini_block_size_));
-
-    // Write the number of mini blocks.
-    writer.PutVlqInt(static_cast<uint32_t>(num_mini_blocks));
-
-    // Write the number of values.
-    writer.PutVlqInt(num_values() - 1);
-
-    // Write the first value.
-    writer.PutZigZagVlqInt(static_cast<uint32_t>(values_[0]));
-
-    // Compute the values as deltas and the min delta.
-    int64_t min_delta = std::numeric_limits<int64_t>::max();
-    for (size_t i = values_.size() - 1; i > 0; --i) {
-      values_[i] -= values_[i - 1];
-      min_delta = std::min(min_delta, values_[i]);
-    }
-
-    // Write out the min delta.
-    writer.PutZigZagVlqInt(static_cast<int32_t>(min_delta));
-
-    // We need to save num_mini_blocks bytes to store the bit widths of the mini
-    // blocks.
-    mini_block_widths = writer.GetNextBytePtr(num_mini_blocks);
-
-    int idx = 1;
-    for (int i = 0; i < num_mini_blocks; ++i) {
-      int n = std::min(mini_block_size_, num_values() - idx);
-
-      // Compute the max delta in this mini block.
-      int64_t max_delta = std::numeric_limits<int64_t>::min();
-      for (int j = 0; j < n; ++j) {
-        max_delta = std::max(values_[idx + j], max_delta);
-      }
-
-      // The bit width for this block is the number of bits needed to store
-      // (max_delta - min_delta).
-      int bit_width = arrow::BitUtil::NumRequiredBits(max_delta - min_delta);
-      mini_block_widths[i] = static_cast<uint8_t>(bit_width);
-
-      // Encode this mini blocking using min_delta and bit_width
-      for (int j = 0; j < n; ++j) {
-        writer.PutValue(values_[idx + j] - min_delta, bit_width);
-      }
-
-      // Pad out the last block.
-      for (int j = n; j < mini_block_size_; ++j) {
-        writer.PutValue(0, bit_width);
-      }
-      idx += n;
-    }
-
-    writer.Flush();
-    *encoded_len = writer.bytes_written();
-    return result;
+    encoder_.Put(values_.data(), num_values());
+    buffer_ = encoder_.FlushValues();
+    *encoded_len = static_cast<int>(buffer_->size());
+    return const_cast<uint8_t*>(buffer_->data());
   }
 
   int num_values() const { return static_cast<int>(values_.size()); }
 
  private:
-  int mini_block_size_;
+  parquet::DeltaBitPackEncoder<parquet::Int64Type> encoder_;
   std::vector<int64_t> values_;
+  std::shared_ptr<parquet::Buffer> buffer_;
 };
 
-class DeltaLengthByteArrayEncoder {
+template <typename EncoderType>
+class ByteArrayEncoder {
  public:
-  explicit DeltaLengthByteArrayEncoder(int mini_block_size = 8)
-      : len_encoder_(mini_block_size),
-        buffer_(new uint8_t[10 * 1024 * 1024]),
-        offset_(0),
-        plain_encoded_len_(0) {}
-
-  void Add(const std::string& s) {
-    Add(reinterpret_cast<const uint8_t*>(s.data()), static_cast<int>(s.size()));
-  }
-
-  void Add(const uint8_t* ptr, int len) {
-    plain_encoded_len_ += static_cast<int>(len + sizeof(int));
-    len_encoder_.Add(len);
-    memcpy(buffer_ + offset_, ptr, len);
-    offset_ += len;
-  }
-
-  uint8_t* Encode(int* encoded_len) {
-    uint8_t* encoded_lengths = len_encoder_.Encode(encoded_len);
-    memmove(buffer_ + *encoded_len + sizeof(int), buffer_, offset_);
-    memcpy(buffer_, encoded_len, sizeof(int));
-    memcpy(buffer_ + sizeof(int), encoded_lengths, *encoded_len);
-    *encoded_len += static_cast<int>(offset_ + sizeof(int));
-    return buffer_;
-  }
-
-  int num_values() const { return len_encoder_.num_values(); }
-  int plain_encoded_len() const { return plain_encoded_len_; }
-
- private:
-  DeltaBitPackEncoder len_encoder_;
-  uint8_t* buffer_;
-  int offset_;
-  int plain_encoded_len_;
-};
-
-class DeltaByteArrayEncoder {
- public:
-  DeltaByteArrayEncoder() : plain_encoded_len_(0) {}
+  ByteArrayEncoder() : encoder_(nullptr), plain_encoded_len_(0) {}
 
   void Add(const std::string& s) {
     plain_encoded_len_ += static_cast<int>(s.size() + sizeof(int));
-    int min_len = static_cast<int>(std::min(s.size(), last_value_.size()));
-    int prefix_len = 0;
-    for (int i = 0; i < min_len; ++i) {
-      if (s[i] == last_value_[i]) {
-        ++prefix_len;
-      } else {
-        break;
-      }
-    }
-    prefix_len_encoder_.Add(prefix_len);
-    suffix_encoder_.Add(reinterpret_cast<const uint8_t*>(s.data()) + prefix_len,
-                        static_cast<int>(s.size() - prefix_len));
-    last_value_ = s;
+    values_.push_back(s);
   }
 
   uint8_t* Encode(int* encoded_len) {
-    int prefix_buffer_len;
-    uint8_t* prefix_buffer = prefix_len_encoder_.Encode(&prefix_buffer_len);
-    int suffix_buffer_len;
-    uint8_t* suffix_buffer = suffix_encoder_.Encode(&suffix_buffer_len);
-
-    uint8_t* buffer = new uint8_t[10 * 1024 * 1024];
-    memcpy(buffer, &prefix_buffer_len, sizeof(int));
-    memcpy(buffer + sizeof(int), prefix_buffer, prefix_buffer_len);
-    memcpy(buffer + sizeof(int) + prefix_buffer_len, suffix_buffer, suffix_buffer_len);
-    *encoded_len = static_cast<int>(sizeof(int) + prefix_buffer_len + suffix_buffer_len);
-    return buffer;
+    std::vector<parquet::ByteArray> values;
+    for (const std::string& s : values_) {
+      values.push_back(parquet::ByteArray(static_cast<uint32_t>(s.size()),
+                                          reinterpret_cast<const uint8_t*>(s.data())));
+    }
+    encoder_.Put(values.data(), num_values());
+    buffer_ = encoder_.FlushValues();
+    *encoded_len = static_cast<int>(buffer_->size());
+    return const_cast<uint8_t*>(buffer_->data());
   }
 
-  int num_values() const { return prefix_len_encoder_.num_values(); }
+  int num_values() const { return static_cast<int>(values_.size()); }
   int plain_encoded_len() const { return plain_encoded_len_; }
 
  private:
-  DeltaBitPackEncoder prefix_len_encoder_;
-  DeltaLengthByteArrayEncoder suffix_encoder_;
-  std::string last_value_;
+  EncoderType encoder_;
+  std::vector<std::string> values_;
+  std::shared_ptr<parquet::Buffer> buffer_;
   int plain_encoded_len_;
 };
 
+using DeltaLengthByteArrayEncoder =
+    ByteArrayEncoder<parquet::DeltaLengthByteArrayEncoder>;
+using DeltaByteArrayEncoder = ByteArrayEncoder<parquet::DeltaByteArrayEncoder>;
+
 uint64_t TestPlainIntEncoding(const uint8_t* data, int num_values, int batch_size) {
   uint64_t result = 0;
   parquet::PlainDecoder<parquet::Int64Type> decoder(nullptr);
@@ -214,16 +110,8 @@ uint64_t TestPlainIntEncoding(const uint8_t* data, int num_values, int batch_siz
 uint64_t TestBinaryPackedEncoding(const char* name, const std::vector<int64_t>& values,
                                   int benchmark_iters = -1,
                                   int benchmark_batch_size = 1) {
-  int mini_block_size;
-  if (values.size() < 8) {
-    mini_block_size = 8;
-  } else if (values.size() < 16) {
-    mini_block_size = 16;
-  } else {
-    mini_block_size = 32;
-  }
   parquet::DeltaBitPackDecoder<parquet::Int64Type> decoder(nullptr);
-  DeltaBitPackEncoder encoder(mini_block_size);
+  DeltaBitPackEncoder encoder;
   for (size_t i = 0; i < values.size(); ++i) {
     encoder.Add(values[i]);
   }
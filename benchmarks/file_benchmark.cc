@@ -0,0 +1,457 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+#include "benchmark/benchmark.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "arrow/api.h"
+#include "arrow/io/memory.h"
+#include "arrow/util/bit-util.h"
+
+#include "parquet/arrow/reader.h"
+#include "parquet/arrow/writer.h"
+#include "parquet/file_reader.h"
+#include "parquet/properties.h"
+#include "parquet/util/memory.h"
+
+/**
+ * End-to-end benchmarks that write and read whole files of realistic tables
+ * through the Arrow API:
+ *
+ *   lineitem: a TPC-H lineitem like table of keys, decimals as doubles, dates,
+ *     flags and a free text comment
+ *   events: wide rows of sparse optional columns, 95% of them null
+ *   nested: optional lists of integers and lists of tags
+ *   strings_low / strings_high: a string column of 16 respectively only
+ *     distinct values
+ *
+ * The write benchmarks take the dataset, codec, whether dictionary encoding is
+ * enabled and the number of threads as arguments, the read benchmarks the
+ * dataset, codec, number of threads and the percentage of columns read.
+ * Rows/s are reported as items, MB/s as the size of the Arrow data.
+ */
+
+#define EXIT_NOT_OK(s)                                        \
+  do {                                                        \
+    ::arrow::Status _s = (s);                                 \
+    if (ARROW_PREDICT_FALSE(!_s.ok())) {                      \
+      std::cout << "Exiting: " << _s.ToString() << std::endl; \
+      exit(EXIT_FAILURE);                                     \
+    }                                                         \
+  } while (0)
+
+namespace parquet {
+
+using ::arrow::Array;
+using ::arrow::Table;
+
+namespace benchmark {
+
+constexpr int64_t NUM_ROWS = 256 * 1024;
+constexpr int64_t ROW_GROUP_SIZE = 64 * 1024;
+
+enum Dataset { LINEITEM, EVENTS, NESTED, STRINGS_LOW, STRINGS_HIGH };
+
+static const Compression::type kCodecs[] = {Compression::UNCOMPRESSED,
+                                            Compression::SNAPPY, Compression::GZIP,
+                                            Compression::ZSTD};
+
+// ----------------------------------------------------------------------
+// Dataset generation
+
+class TableBuilder {
+ public:
+  void AddColumn(const std::string& name, const std::shared_ptr<Array>& array,
+                 bool nullable) {
+    auto field = ::arrow::field(name, array->type(), nullable);
+    fields_.push_back(field);
+    columns_.push_back(std::make_shared<::arrow::Column>(field, array));
+  }
+
+  std::shared_ptr<Table> Finish() {
+    return Table::Make(::arrow::schema(fields_), columns_);
+  }
+
+ private:
+  std::vector<std::shared_ptr<::arrow::Field>> fields_;
+  std::vector<std::shared_ptr<::arrow::Column>> columns_;
+};
+
+template <typename Builder>
+static std::shared_ptr<Array> Finish(Builder* builder) {
+  std::shared_ptr<Array> array;
+  EXIT_NOT_OK(builder->Finish(&array));
+  return array;
+}
+
+static std::string RandomText(std::mt19937* rng, int min_length, int max_length) {
+  static const char kChars[] = "abcdefghijklmnopqrstuvwxyz ";
+  std::uniform_int_distribution<int> length(min_length, max_length);
+  std::uniform_int_distribution<int> c(0, static_cast<int>(sizeof(kChars)) - 2);
+  std::string text(static_cast<size_t>(length(*rng)), ' ');
+  for (char& ch : text) {
+    ch = kChars[c(*rng)];
+  }
+  return text;
+}
+
+static std::shared_ptr<Table> MakeLineItem(int64_t num_rows) {
+  std::mt19937 rng(42);
+  static const char* kFlags[] = {"A", "N", "R"};
+  static const char* kStatus[] = {"F", "O"};
+  static const char* kInstructions[] = {"DELIVER IN PERSON", "COLLECT COD", "NONE",
+                                        "TAKE BACK RETURN"};
+  static const char* kModes[] = {"AIR", "FOB", "MAIL", "RAIL", "REG AIR", "SHIP",
+                                 "TRUCK"};
+
+  ::arrow::Int64Builder orderkey, partkey, suppkey;
+  ::arrow::Int32Builder linenumber, shipdate, commitdate, receiptdate;
+  ::arrow::DoubleBuilder quantity, price, discount, tax;
+  ::arrow::StringBuilder flag, status, instruction, mode, comment;
+  std::uniform_int_distribution<int> small(0, 1 << 16);
+  int64_t order = 1;
+  int32_t line = 1;
+  for (int64_t i = 0; i < num_rows; ++i) {
+    // Orders of 1 to 7 lines
+    if (line > 1 + small(rng) % 7) {
+      order += 1 + small(rng) % 4;
+      line = 1;
+    }
+    const int32_t date = 8035 + small(rng) % 2526;
+    EXIT_NOT_OK(orderkey.Append(order));
+    EXIT_NOT_OK(partkey.Append(1 + small(rng) * 3));
+    EXIT_NOT_OK(suppkey.Append(1 + small(rng) % 10000));
+    EXIT_NOT_OK(linenumber.Append(line++));
+    EXIT_NOT_OK(quantity.Append(static_cast<double>(1 + small(rng) % 50)));
+    EXIT_NOT_OK(price.Append(static_cast<double>(small(rng)) * 1.37));
+    EXIT_NOT_OK(discount.Append(static_cast<double>(small(rng) % 11) / 100));
+    EXIT_NOT_OK(tax.Append(static_cast<double>(small(rng) % 9) / 100));
+    EXIT_NOT_OK(flag.Append(kFlags[small(rng) % 3]));
+    EXIT_NOT_OK(status.Append(kStatus[small(rng) % 2]));
+    EXIT_NOT_OK(shipdate.Append(date));
+    EXIT_NOT_OK(commitdate.Append(date + small(rng) % 60 - 30));
+    EXIT_NOT_OK(receiptdate.Append(date + 1 + small(rng) % 30));
+    EXIT_NOT_OK(instruction.Append(kInstructions[small(rng) % 4]));
+    EXIT_NOT_OK(mode.Append(kModes[small(rng) % 7]));
+    EXIT_NOT_OK(comment.Append(RandomText(&rng, 10, 43)));
+  }
+
+  TableBuilder table;
+  table.AddColumn("l_orderkey", Finish(&orderkey), false);
+  table.AddColumn("l_partkey", Finish(&partkey), false);
+  table.AddColumn("l_suppkey", Finish(&suppkey), false);
+  table.AddColumn("l_linenumber", Finish(&linenumber), false);
+  table.AddColumn("l_quantity", Finish(&quantity), false);
+  table.AddColumn("l_extendedprice", Finish(&price), false);
+  table.AddColumn("l_discount", Finish(&discount), false);
+  table.AddColumn("l_tax", Finish(&tax), false);
+  table.AddColumn("l_returnflag", Finish(&flag), false);
+  table.AddColumn("l_linestatus", Finish(&status), false);
+  table.AddColumn("l_shipdate", Finish(&shipdate), false);
+  table.AddColumn("l_commitdate", Finish(&commitdate), false);
+  table.AddColumn("l_receiptdate", Finish(&receiptdate), false);
+  table.AddColumn("l_shipinstruct", Finish(&instruction), false);
+  table.AddColumn("l_shipmode", Finish(&mode), false);
+  table.AddColumn("l_comment", Finish(&comment), false);
+  return table.Finish();
+}
+
+static std::shared_ptr<Table> MakeEvents(int64_t num_rows) {
+  constexpr int kNumSparseColumns = 48;
+  std::mt19937 rng(43);
+  std::uniform_int_distribution<int> percent(0, 99);
+  std::uniform_int_distribution<int64_t> value(0, 1 << 20);
+
+  TableBuilder table;
+  ::arrow::Int64Builder id, timestamp;
+  int64_t time = 1500000000000;
+  for (int64_t i = 0; i < num_rows; ++i) {
+    EXIT_NOT_OK(id.Append(i));
+    time += value(rng) % 100;
+    EXIT_NOT_OK(timestamp.Append(time));
+  }
+  table.AddColumn("event_id", Finish(&id), false);
+  table.AddColumn("timestamp", Finish(&timestamp), false);
+
+  for (int c = 0; c < kNumSparseColumns; ++c) {
+    const std::string name = "attr_" + std::to_string(c);
+    if (c % 3 == 0) {
+      ::arrow::Int64Builder builder;
+      for (int64_t i = 0; i < num_rows; ++i) {
+        EXIT_NOT_OK(percent(rng) < 5 ? builder.Append(value(rng)) : builder.AppendNull());
+      }
+      table.AddColumn(name, Finish(&builder), true);
+    } else if (c % 3 == 1) {
+      ::arrow::DoubleBuilder builder;
+      for (int64_t i = 0; i < num_rows; ++i) {
+        EXIT_NOT_OK(percent(rng) < 5 ? builder.Append(static_cast<double>(value(rng)))
+                                     : builder.AppendNull());
+      }
+      table.AddColumn(name, Finish(&builder), true);
+    } else {
+      ::arrow::StringBuilder builder;
+      for (int64_t i = 0; i < num_rows; ++i) {
+        EXIT_NOT_OK(percent(rng) < 5 ? builder.Append(RandomText(&rng, 4, 16))
+                                     : builder.AppendNull());
+      }
+      table.AddColumn(name, Finish(&builder), true);
+    }
+  }
+  return table.Finish();
+}
+
+// An optional list of num_rows lists of 0 to max_length values of
+// value_builder, 10% of them null
+template <typename Builder, typename MakeValue>
+static std::shared_ptr<Array> MakeList(int64_t num_rows, int max_length,
+                                       std::mt19937* rng, Builder* value_builder,
+                                       MakeValue make_value) {
+  std::uniform_int_distribution<int> length(0, max_length);
+  std::uniform_int_distribution<int> percent(0, 99);
+  auto offsets = std::make_shared<::arrow::PoolBuffer>(::arrow::default_memory_pool());
+  EXIT_NOT_OK(offsets->Resize((num_rows + 1) * sizeof(int32_t)));
+  int32_t* offsets_ptr = reinterpret_cast<int32_t*>(offsets->mutable_data());
+  auto is_valid = std::make_shared<::arrow::PoolBuffer>(::arrow::default_memory_pool());
+  EXIT_NOT_OK(is_valid->Resize(::arrow::BitUtil::CeilByte(num_rows) / 8));
+  memset(is_valid->mutable_data(), 0, static_cast<size_t>(is_valid->size()));
+
+  int32_t offset = 0;
+  int64_t null_count = 0;
+  for (int64_t i = 0; i < num_rows; ++i) {
+    offsets_ptr[i] = offset;
+    if (percent(*rng) < 10) {
+      ++null_count;
+    } else {
+      ::arrow::BitUtil::SetBit(is_valid->mutable_data(), i);
+      const int n = length(*rng);
+      for (int j = 0; j < n; ++j) {
+        EXIT_NOT_OK(value_builder->Append(make_value()));
+      }
+      offset += n;
+    }
+  }
+  offsets_ptr[num_rows] = offset;
+
+  std::shared_ptr<Array> values = Finish(value_builder);
+  auto value_field = ::arrow::field("item", values->type(), false);
+  return std::make_shared<::arrow::ListArray>(::arrow::list(value_field), num_rows,
+                                              offsets, values, is_valid, null_count);
+}
+
+static std::shared_ptr<Table> MakeNested(int64_t num_rows) {
+  static const char* kTags[] = {"home", "sports", "news", "video", "mobile", "ads",
+                                "shop", "music"};
+  std::mt19937 rng(44);
+  std::uniform_int_distribution<int64_t> value(0, 1 << 24);
+  std::uniform_int_distribution<int> tag(0, 7);
+
+  ::arrow::Int64Builder id, item_ids;
+  ::arrow::StringBuilder tags;
+  for (int64_t i = 0; i < num_rows; ++i) {
+    EXIT_NOT_OK(id.Append(i));
+  }
+
+  TableBuilder table;
+  table.AddColumn("id", Finish(&id), false);
+  table.AddColumn("item_ids",
+                  MakeList(num_rows, 8, &rng, &item_ids, [&] { return value(rng); }),
+                  true);
+  table.AddColumn(
+      "tags",
+      MakeList(num_rows, 4, &rng, &tags, [&] { return std::string(kTags[tag(rng)]); }),
+      true);
+  return table.Finish();
+}
+
+static std::shared_ptr<Table> MakeStrings(int64_t num_rows, int cardinality) {
+  std::mt19937 rng(45);
+  std::vector<std::string> dictionary;
+  for (int i = 0; i < cardinality; ++i) {
+    dictionary.push_back(RandomText(&rng, 8, 32));
+  }
+  std::uniform_int_distribution<int> index(0, cardinality - 1);
+
+  ::arrow::StringBuilder builder;
+  for (int64_t i = 0; i < num_rows; ++i) {
+    if (cardinality < num_rows) {
+      EXIT_NOT_OK(builder.Append(dictionary[index(rng)]));
+    } else {
+      EXIT_NOT_OK(builder.Append(dictionary[i]));
+    }
+  }
+  TableBuilder table;
+  table.AddColumn("s", Finish(&builder), false);
+  return table.Finish();
+}
+
+// The tables are generated once per process
+static std::shared_ptr<Table> GetTable(Dataset dataset) {
+  static std::map<Dataset, std::shared_ptr<Table>> tables;
+  std::shared_ptr<Table>& table = tables[dataset];
+  if (table == nullptr) {
+    switch (dataset) {
+      case LINEITEM:
+        table = MakeLineItem(NUM_ROWS);
+        break;
+      case EVENTS:
+        table = MakeEvents(NUM_ROWS);
+        break;
+      case NESTED:
+        table = MakeNested(NUM_ROWS);
+        break;
+      case STRINGS_LOW:
+        table = MakeStrings(NUM_ROWS, 16);
+        break;
+      case STRINGS_HIGH:
+        table = MakeStrings(NUM_ROWS, static_cast<int>(NUM_ROWS));
+        break;
+    }
+  }
+  return table;
+}
+
+static int64_t ArrayDataSize(const ::arrow::ArrayData& data) {
+  int64_t size = 0;
+  for (const auto& buffer : data.buffers) {
+    if (buffer != nullptr) {
+      size += buffer->size();
+    }
+  }
+  for (const auto& child : data.child_data) {
+    size += ArrayDataSize(*child);
+  }
+  return size;
+}
+
+// Size of the Arrow data of the columns
+static int64_t TableSize(const Table& table, int num_columns) {
+  int64_t size = 0;
+  for (int i = 0; i < num_columns; ++i) {
+    for (const auto& chunk : table.column(i)->data()->chunks()) {
+      size += ArrayDataSize(*chunk->data());
+    }
+  }
+  return size;
+}
+
+// ----------------------------------------------------------------------
+// Benchmarks
+
+static std::shared_ptr<Buffer> WriteFile(const Table& table, Compression::type codec,
+                                         bool dictionary, int num_threads) {
+  WriterProperties::Builder builder;
+  builder.compression(codec);
+  if (dictionary) {
+    builder.enable_dictionary();
+  } else {
+    builder.disable_dictionary();
+  }
+  auto sink = std::make_shared<InMemoryOutputStream>();
+  std::unique_ptr<arrow::FileWriter> writer;
+  EXIT_NOT_OK(arrow::FileWriter::Open(*table.schema(), ::arrow::default_memory_pool(),
+                                      sink, builder.build(), &writer));
+  writer->set_num_threads(num_threads);
+  EXIT_NOT_OK(writer->WriteTable(table, ROW_GROUP_SIZE));
+  EXIT_NOT_OK(writer->Close());
+  return sink->GetBuffer();
+}
+
+// Arguments: dataset, index into kCodecs, dictionary enabled, threads
+static void BM_WriteFile(::benchmark::State& state) {
+  std::shared_ptr<Table> table = GetTable(static_cast<Dataset>(state.range(0)));
+  const Compression::type codec = kCodecs[state.range(1)];
+  const bool dictionary = state.range(2) != 0;
+  const int num_threads = static_cast<int>(state.range(3));
+
+  while (state.KeepRunning()) {
+    std::shared_ptr<Buffer> buffer = WriteFile(*table, codec, dictionary, num_threads);
+    ::benchmark::DoNotOptimize(buffer);
+  }
+  state.SetItemsProcessed(state.iterations() * table->num_rows());
+  state.SetBytesProcessed(state.iterations() * TableSize(*table, table->num_columns()));
+}
+
+// Arguments: dataset, index into kCodecs, threads, percentage of the columns
+static void BM_ReadFile(::benchmark::State& state) {
+  std::shared_ptr<Table> table = GetTable(static_cast<Dataset>(state.range(0)));
+  const Compression::type codec = kCodecs[state.range(1)];
+  const int num_threads = static_cast<int>(state.range(2));
+  std::shared_ptr<Buffer> buffer = WriteFile(*table, codec, true, 1);
+
+  const int num_columns = std::max(
+      1, static_cast<int>(table->num_columns() * state.range(3) / 100));
+  std::vector<int> column_indices(num_columns);
+  for (int i = 0; i < num_columns; ++i) {
+    column_indices[i] = i;
+  }
+
+  while (state.KeepRunning()) {
+    arrow::FileReader reader(
+        ::arrow::default_memory_pool(),
+        ParquetFileReader::Open(std::make_shared<::arrow::io::BufferReader>(buffer)));
+    reader.set_num_threads(num_threads);
+    std::shared_ptr<Table> out;
+    EXIT_NOT_OK(reader.ReadTable(column_indices, &out));
+    ::benchmark::DoNotOptimize(out);
+  }
+  state.SetItemsProcessed(state.iterations() * table->num_rows());
+  state.SetBytesProcessed(state.iterations() * TableSize(*table, num_columns));
+}
+
+static void WriteArguments(::benchmark::internal::Benchmark* b) {
+  for (int dataset = LINEITEM; dataset <= STRINGS_HIGH; ++dataset) {
+    for (int codec = 0; codec < 4; ++codec) {
+      for (int dictionary = 0; dictionary <= 1; ++dictionary) {
+        for (int threads : {1, 4}) {
+          b->Args({dataset, codec, dictionary, threads});
+        }
+      }
+    }
+  }
+}
+
+static void ReadArguments(::benchmark::internal::Benchmark* b) {
+  for (int dataset = LINEITEM; dataset <= STRINGS_HIGH; ++dataset) {
+    for (int codec = 0; codec < 4; ++codec) {
+      for (int threads : {1, 4}) {
+        for (int percent : {10, 50, 100}) {
+          // Tables of a few columns are always read completely
+          if (percent < 100 && (dataset == STRINGS_LOW || dataset == STRINGS_HIGH)) {
+            continue;
+          }
+          b->Args({dataset, codec, threads, percent});
+        }
+      }
+    }
+  }
+}
+
+BENCHMARK(BM_WriteFile)->Apply(WriteArguments)->UseRealTime();
+BENCHMARK(BM_ReadFile)->Apply(ReadArguments)->UseRealTime();
+
+}  // namespace benchmark
+
+}  // namespace parquet
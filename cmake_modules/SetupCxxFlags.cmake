@@ -194,6 +194,10 @@ if (PARQUET_USE_SSE)
   add_definitions(-DPARQUET_USE_SSE)
 endif()
 
+if (PARQUET_USE_IO_URING)
+  add_definitions(-DPARQUET_USE_IO_URING)
+endif()
+
 if (APPLE)
   # Depending on the default OSX_DEPLOYMENT_TARGET (< 10.9), libstdc++ may be
   # the default standard library which does not support C++11. libc++ is the
@@ -19,11 +19,17 @@
 #define PARQUET_API_READER_H
 
 // Column reader API
+#include "parquet/block_cache.h"
+#include "parquet/bloom_filter.h"
 #include "parquet/column_reader.h"
 #include "parquet/column_scanner.h"
 #include "parquet/exception.h"
 #include "parquet/file_reader.h"
 #include "parquet/metadata.h"
+#include "parquet/metadata_cache.h"
+#include "parquet/page_cache.h"
+#include "parquet/page_index.h"
+#include "parquet/predicate.h"
 #include "parquet/printer.h"
 
 // Schemas
@@ -17,7 +17,13 @@
 
 #include "benchmark/benchmark.h"
 
+#include <algorithm>
+#include <cstring>
 #include <iostream>
+#include <numeric>
+#include <random>
+#include <string>
+#include <vector>
 
 #include "parquet/arrow/reader.h"
 #include "parquet/arrow/writer.h"
@@ -28,6 +34,7 @@
 #include "parquet/util/memory.h"
 
 #include "arrow/api.h"
+#include "arrow/util/bit-util.h"
 
 using arrow::BooleanBuilder;
 using arrow::NumericBuilder;
@@ -195,6 +202,281 @@ BENCHMARK_TEMPLATE2(BM_ReadColumn, true, DoubleType);
 BENCHMARK_TEMPLATE2(BM_ReadColumn, false, BooleanType);
 BENCHMARK_TEMPLATE2(BM_ReadColumn, true, BooleanType);
 
+// ----------------------------------------------------------------------
+// Nested, string, decimal and timestamp columns
+
+constexpr int64_t NESTED_BENCHMARK_SIZE = 1024 * 1024;
+
+enum ColumnCase {
+  LIST_INT64,
+  LIST_STRUCT,
+  NULLABLE_STRINGS,
+  DICTIONARY_STRINGS,
+  DECIMALS,
+  INT96_TIMESTAMPS
+};
+
+// Size of the Arrow buffers of data, including its children
+static int64_t ArrayDataSize(const ::arrow::ArrayData& data) {
+  int64_t size = 0;
+  for (const auto& buffer : data.buffers) {
+    if (buffer != nullptr) {
+      size += buffer->size();
+    }
+  }
+  for (const auto& child : data.child_data) {
+    size += ArrayDataSize(*child);
+  }
+  return size;
+}
+
+// Validity bitmap of length entries, null_percent of them null at random
+static std::shared_ptr<Buffer> MakeValidBits(int64_t length, int null_percent,
+                                             std::mt19937* rng, int64_t* null_count) {
+  std::uniform_int_distribution<int> percent(0, 99);
+  auto valid_bits = std::make_shared<::arrow::PoolBuffer>(::arrow::default_memory_pool());
+  EXIT_NOT_OK(valid_bits->Resize(::arrow::BitUtil::CeilByte(length) / 8));
+  memset(valid_bits->mutable_data(), 0, static_cast<size_t>(valid_bits->size()));
+  *null_count = 0;
+  for (int64_t i = 0; i < length; i++) {
+    if (percent(*rng) < null_percent) {
+      ++*null_count;
+    } else {
+      ::arrow::BitUtil::SetBit(valid_bits->mutable_data(), i);
+    }
+  }
+  return valid_bits;
+}
+
+// Nullable strings of 8 to 24 characters, of only 16 distinct values if
+// dictionary
+static std::shared_ptr<::arrow::Array> MakeStrings(int64_t length, int null_percent,
+                                                   bool dictionary, std::mt19937* rng) {
+  std::uniform_int_distribution<int> percent(0, 99);
+  std::uniform_int_distribution<int> char_distribution('a', 'z');
+  std::uniform_int_distribution<int> string_length(8, 24);
+  auto random_string = [&]() {
+    std::string value(static_cast<size_t>(string_length(*rng)), ' ');
+    for (char& c : value) {
+      c = static_cast<char>(char_distribution(*rng));
+    }
+    return value;
+  };
+  std::vector<std::string> dictionary_values;
+  for (int i = 0; i < 16; i++) {
+    dictionary_values.push_back(random_string());
+  }
+  std::uniform_int_distribution<int> index(0, 15);
+
+  ::arrow::StringBuilder builder;
+  for (int64_t i = 0; i < length; i++) {
+    if (percent(*rng) < null_percent) {
+      EXIT_NOT_OK(builder.AppendNull());
+    } else {
+      EXIT_NOT_OK(builder.Append(dictionary ? dictionary_values[index(*rng)]
+                                            : random_string()));
+    }
+  }
+  std::shared_ptr<::arrow::Array> array;
+  EXIT_NOT_OK(builder.Finish(&array));
+  return array;
+}
+
+// Nullable lists of 0 to 7 entries of values, sliced to the entries used
+static std::shared_ptr<::arrow::Array> MakeList(
+    int64_t length, const std::shared_ptr<::arrow::Array>& values, std::mt19937* rng) {
+  std::uniform_int_distribution<int> list_length(0, 7);
+  int64_t null_count = 0;
+  std::shared_ptr<Buffer> valid_bits = MakeValidBits(length, 10, rng, &null_count);
+  auto offsets = std::make_shared<::arrow::PoolBuffer>(::arrow::default_memory_pool());
+  EXIT_NOT_OK(offsets->Resize((length + 1) * sizeof(int32_t)));
+  int32_t* offsets_ptr = reinterpret_cast<int32_t*>(offsets->mutable_data());
+  int32_t offset = 0;
+  for (int64_t i = 0; i < length; i++) {
+    offsets_ptr[i] = offset;
+    if (::arrow::BitUtil::GetBit(valid_bits->data(), i)) {
+      offset = std::min(offset + list_length(*rng),
+                        static_cast<int32_t>(values->length()));
+    }
+  }
+  offsets_ptr[length] = offset;
+  auto value_field = ::arrow::field("item", values->type(), values->null_count() > 0);
+  return std::make_shared<::arrow::ListArray>(::arrow::list(value_field), length,
+                                              offsets, values->Slice(0, offset),
+                                              valid_bits, null_count);
+}
+
+static std::shared_ptr<::arrow::Array> MakeInt64s(int64_t length, std::mt19937* rng) {
+  std::uniform_int_distribution<int64_t> value(0, 1LL << 40);
+  ::arrow::Int64Builder builder;
+  for (int64_t i = 0; i < length; i++) {
+    EXIT_NOT_OK(builder.Append(value(*rng)));
+  }
+  std::shared_ptr<::arrow::Array> array;
+  EXIT_NOT_OK(builder.Finish(&array));
+  return array;
+}
+
+// A table of a single column of the case, null_percent of its entries null
+// where it applies
+static std::shared_ptr<::arrow::Table> MakeColumnCaseTable(ColumnCase column_case,
+                                                           int null_percent) {
+  const int64_t length = NESTED_BENCHMARK_SIZE;
+  std::mt19937 rng(42);
+  std::shared_ptr<::arrow::Array> array;
+  switch (column_case) {
+    case LIST_INT64:
+      array = MakeList(length, MakeInt64s(length * 7, &rng), &rng);
+      break;
+    case LIST_STRUCT: {
+      std::shared_ptr<::arrow::Array> ids = MakeInt64s(length * 7, &rng);
+      std::shared_ptr<::arrow::Array> names =
+          MakeStrings(length * 7, null_percent, true, &rng);
+      auto struct_type = ::arrow::struct_({::arrow::field("id", ids->type(), false),
+                                           ::arrow::field("name", names->type())});
+      int64_t null_count = 0;
+      std::shared_ptr<Buffer> valid_bits =
+          MakeValidBits(length * 7, null_percent, &rng, &null_count);
+      std::vector<std::shared_ptr<::arrow::Array>> children = {ids, names};
+      auto structs = std::make_shared<::arrow::StructArray>(
+          struct_type, length * 7, children, valid_bits, null_count);
+      array = MakeList(length, structs, &rng);
+      break;
+    }
+    case NULLABLE_STRINGS:
+      array = MakeStrings(length, null_percent, false, &rng);
+      break;
+    case DICTIONARY_STRINGS:
+      array = MakeStrings(length, null_percent, true, &rng);
+      break;
+    case DECIMALS: {
+      std::uniform_int_distribution<int64_t> value(0, 1LL << 50);
+      ::arrow::Decimal128Builder builder(::arrow::decimal(18, 2),
+                                         ::arrow::default_memory_pool());
+      for (int64_t i = 0; i < length; i++) {
+        EXIT_NOT_OK(builder.Append(::arrow::Decimal128(value(rng))));
+      }
+      EXIT_NOT_OK(builder.Finish(&array));
+      break;
+    }
+    case INT96_TIMESTAMPS: {
+      std::uniform_int_distribution<int64_t> value(0, 1LL << 60);
+      ::arrow::TimestampBuilder builder(::arrow::timestamp(::arrow::TimeUnit::NANO),
+                                        ::arrow::default_memory_pool());
+      for (int64_t i = 0; i < length; i++) {
+        EXIT_NOT_OK(builder.Append(value(rng)));
+      }
+      EXIT_NOT_OK(builder.Finish(&array));
+      break;
+    }
+  }
+  auto field = ::arrow::field("column", array->type(), true);
+  auto column = std::make_shared<::arrow::Column>(field, array);
+  return ::arrow::Table::Make(::arrow::schema({field}), {column});
+}
+
+static std::shared_ptr<::arrow::Buffer> WriteColumnCaseTable(
+    const ::arrow::Table& table, ColumnCase column_case) {
+  arrow::ArrowWriterProperties::Builder arrow_properties;
+  if (column_case == INT96_TIMESTAMPS) {
+    arrow_properties.enable_deprecated_int96_timestamps();
+  }
+  auto output = std::make_shared<InMemoryOutputStream>();
+  EXIT_NOT_OK(WriteTable(table, ::arrow::default_memory_pool(), output,
+                         NESTED_BENCHMARK_SIZE / 4, default_writer_properties(),
+                         arrow_properties.build()));
+  return output->GetBuffer();
+}
+
+static void SetColumnCaseProcessed(::benchmark::State& state,
+                                   const ::arrow::Table& table) {
+  state.SetItemsProcessed(state.iterations() * table.num_rows());
+  state.SetBytesProcessed(state.iterations() *
+                          ArrayDataSize(*table.column(0)->data()->chunk(0)->data()));
+}
+
+// Arguments: the ColumnCase and the percentage of null entries
+static void BM_WriteColumnCase(::benchmark::State& state) {
+  const auto column_case = static_cast<ColumnCase>(state.range(0));
+  std::shared_ptr<::arrow::Table> table =
+      MakeColumnCaseTable(column_case, static_cast<int>(state.range(1)));
+  while (state.KeepRunning()) {
+    ::benchmark::DoNotOptimize(WriteColumnCaseTable(*table, column_case));
+  }
+  SetColumnCaseProcessed(state, *table);
+}
+
+// Arguments: the ColumnCase, the percentage of null entries and the number of
+// threads
+static void BM_ReadColumnCase(::benchmark::State& state) {
+  const auto column_case = static_cast<ColumnCase>(state.range(0));
+  std::shared_ptr<::arrow::Table> table =
+      MakeColumnCaseTable(column_case, static_cast<int>(state.range(1)));
+  std::shared_ptr<::arrow::Buffer> buffer = WriteColumnCaseTable(*table, column_case);
+  while (state.KeepRunning()) {
+    auto reader =
+        ParquetFileReader::Open(std::make_shared<::arrow::io::BufferReader>(buffer));
+    FileReader filereader(::arrow::default_memory_pool(), std::move(reader));
+    filereader.set_num_threads(static_cast<int>(state.range(2)));
+    std::shared_ptr<::arrow::Table> out;
+    EXIT_NOT_OK(filereader.ReadTable(&out));
+  }
+  SetColumnCaseProcessed(state, *table);
+}
+
+// As BM_ReadColumnCase, through a RecordBatchReader over all row groups
+static void BM_ReadColumnCaseBatches(::benchmark::State& state) {
+  const auto column_case = static_cast<ColumnCase>(state.range(0));
+  std::shared_ptr<::arrow::Table> table =
+      MakeColumnCaseTable(column_case, static_cast<int>(state.range(1)));
+  std::shared_ptr<::arrow::Buffer> buffer = WriteColumnCaseTable(*table, column_case);
+  while (state.KeepRunning()) {
+    auto reader =
+        ParquetFileReader::Open(std::make_shared<::arrow::io::BufferReader>(buffer));
+    std::vector<int> row_groups(reader->metadata()->num_row_groups());
+    std::iota(row_groups.begin(), row_groups.end(), 0);
+    FileReader filereader(::arrow::default_memory_pool(), std::move(reader));
+    filereader.set_num_threads(static_cast<int>(state.range(2)));
+    std::shared_ptr<::arrow::RecordBatchReader> batch_reader;
+    EXIT_NOT_OK(filereader.GetRecordBatchReader(row_groups, &batch_reader));
+    std::shared_ptr<::arrow::RecordBatch> batch;
+    do {
+      EXIT_NOT_OK(batch_reader->ReadNext(&batch));
+    } while (batch != nullptr);
+  }
+  SetColumnCaseProcessed(state, *table);
+}
+
+static void WriteColumnCaseArguments(::benchmark::internal::Benchmark* b) {
+  for (int column_case = LIST_INT64; column_case <= INT96_TIMESTAMPS; column_case++) {
+    if (column_case == NULLABLE_STRINGS) {
+      for (int null_percent : {0, 10, 50, 90}) {
+        b->Args({column_case, null_percent});
+      }
+    } else {
+      b->Args({column_case, 10});
+    }
+  }
+}
+
+static void ReadColumnCaseArguments(::benchmark::internal::Benchmark* b) {
+  for (int column_case = LIST_INT64; column_case <= INT96_TIMESTAMPS; column_case++) {
+    for (int num_threads : {1, 4, 16}) {
+      if (column_case == NULLABLE_STRINGS) {
+        for (int null_percent : {0, 10, 50, 90}) {
+          b->Args({column_case, null_percent, num_threads});
+        }
+      } else {
+        b->Args({column_case, 10, num_threads});
+      }
+    }
+  }
+}
+
+BENCHMARK(BM_WriteColumnCase)->Apply(WriteColumnCaseArguments);
+BENCHMARK(BM_ReadColumnCase)->Apply(ReadColumnCaseArguments)->UseRealTime();
+BENCHMARK(BM_ReadColumnCaseBatches)->Apply(ReadColumnCaseArguments)->UseRealTime();
+
 }  // namespace benchmark
 
 }  // namespace parquet
@@ -24,20 +24,26 @@
 #include "gtest/gtest.h"
 
 #include <arrow/compute/api.h>
+#include <algorithm>
 #include <cstdint>
 #include <functional>
+#include <numeric>
 #include <sstream>
+#include <string>
 #include <vector>
 
 #include "parquet/api/reader.h"
 #include "parquet/api/writer.h"
+#include "parquet/arrow/dataset.h"
 
 #include "parquet/arrow/reader.h"
+#include "parquet/arrow/record_reader.h"
 #include "parquet/arrow/schema.h"
 #include "parquet/arrow/test-util.h"
 #include "parquet/arrow/writer.h"
 
 #include "parquet/file_writer.h"
+#include "parquet/util/thread-pool.h"
 
 #include "arrow/api.h"
 #include "arrow/test-util.h"
@@ -321,12 +327,17 @@ using ParquetWriter = TypedColumnWriter<ParquetDataType<T>>;
 void WriteTableToBuffer(const std::shared_ptr<Table>& table, int num_threads,
                         int64_t row_group_size,
                         const std::shared_ptr<ArrowWriterProperties>& arrow_properties,
-                        std::shared_ptr<Buffer>* out) {
+                        std::shared_ptr<Buffer>* out,
+                        const std::shared_ptr<WriterProperties>& properties =
+                            default_writer_properties()) {
   auto sink = std::make_shared<InMemoryOutputStream>();
 
-  ASSERT_OK_NO_THROW(WriteTable(*table, ::arrow::default_memory_pool(), sink,
-                                row_group_size, default_writer_properties(),
-                                arrow_properties));
+  std::unique_ptr<FileWriter> writer;
+  ASSERT_OK_NO_THROW(FileWriter::Open(*table->schema(), ::arrow::default_memory_pool(),
+                                      sink, properties, arrow_properties, &writer));
+  writer->set_num_threads(num_threads);
+  ASSERT_OK_NO_THROW(writer->WriteTable(*table, row_group_size));
+  ASSERT_OK_NO_THROW(writer->Close());
   *out = sink->GetBuffer();
 }
 
@@ -1340,6 +1351,23 @@ TEST(TestArrowReadWrite, CoerceTimestampsLosePrecision) {
   // Loss of precision
   ASSERT_RAISES(Invalid, WriteTable(*t4, ::arrow::default_memory_pool(), sink, 10,
                                     default_writer_properties(), coerce_micros));
+
+  // Unless truncation is allowed, then the values are rounded towards zero
+  std::vector<int64_t> truncated_values = {1489269000, 1489270000, 1489271000,
+                                           1489272000, 1489272000, 1489273000};
+  std::shared_ptr<Array> a_truncated;
+  ArrayFromVector<::arrow::TimestampType, int64_t>(t_ms, is_valid, truncated_values,
+                                                   &a_truncated);
+  auto s5 = std::shared_ptr<::arrow::Schema>(new ::arrow::Schema({field("f_ns", t_ms)}));
+  auto expected = Table::Make(s5, {std::make_shared<Column>("f_ns", a_truncated)});
+
+  std::shared_ptr<Table> truncated;
+  DoSimpleRoundtrip(t4, 1, t4->num_rows(), {}, &truncated,
+                    ArrowWriterProperties::Builder()
+                        .coerce_timestamps(TimeUnit::MILLI)
+                        ->allow_truncated_timestamps()
+                        ->build());
+  AssertTablesEqual(*expected, *truncated);
 }
 
 TEST(TestArrowReadWrite, ConvertedDateTimeTypes) {
@@ -1476,6 +1504,657 @@ TEST(TestArrowReadWrite, MultithreadedRead) {
   AssertTablesEqual(*table, *result);
 }
 
+TEST(TestArrowReadWrite, MultithreadedWrite) {
+  const int num_columns = 20;
+  const int num_rows = 1000;
+  const int num_threads = 4;
+
+  std::shared_ptr<Table> table;
+  MakeDoubleTable(num_columns, num_rows, 1, &table);
+
+  // Write several row groups, each with all columns written concurrently
+  std::shared_ptr<Buffer> buffer;
+  WriteTableToBuffer(table, num_threads, num_rows / 4,
+                     default_arrow_writer_properties(), &buffer);
+
+  std::unique_ptr<FileReader> reader;
+  ASSERT_OK_NO_THROW(OpenFile(std::make_shared<BufferReader>(buffer),
+                              ::arrow::default_memory_pool(),
+                              ::parquet::default_reader_properties(), nullptr, &reader));
+  ASSERT_EQ(4, reader->num_row_groups());
+
+  std::shared_ptr<Table> result;
+  ASSERT_OK_NO_THROW(reader->ReadTable(&result));
+  AssertTablesEqual(*table, *result);
+}
+
+TEST(TestArrowReadWrite, MaxRowGroupBytes) {
+  const int num_columns = 4;
+  const int num_rows = 100000;
+  const int64_t max_row_group_bytes = 256 * 1024;
+
+  std::shared_ptr<Table> table;
+  MakeDoubleTable(num_columns, num_rows, 1, &table);
+
+  auto sink = std::make_shared<InMemoryOutputStream>();
+  std::shared_ptr<WriterProperties> properties = WriterProperties::Builder()
+                                                     .disable_dictionary()
+                                                     ->max_row_group_bytes(
+                                                         max_row_group_bytes)
+                                                     ->build();
+  ASSERT_OK_NO_THROW(WriteTable(*table, ::arrow::default_memory_pool(), sink, num_rows,
+                                properties));
+
+  std::unique_ptr<FileReader> reader;
+  ASSERT_OK_NO_THROW(OpenFile(std::make_shared<BufferReader>(sink->GetBuffer()),
+                              ::arrow::default_memory_pool(),
+                              ::parquet::default_reader_properties(), nullptr, &reader));
+  // About num_rows * num_columns * sizeof(double) bytes in total
+  const auto metadata = reader->parquet_reader()->metadata();
+  ASSERT_LT(10, metadata->num_row_groups());
+  for (int i = 0; i < metadata->num_row_groups(); i++) {
+    ASSERT_GE(2 * max_row_group_bytes, metadata->RowGroup(i)->total_byte_size());
+  }
+
+  std::shared_ptr<Table> result;
+  ASSERT_OK_NO_THROW(reader->ReadTable(&result));
+  AssertTablesEqual(*table, *result, false);
+}
+
+TEST(TestArrowReadWrite, MemoryLimit) {
+  const int num_columns = 4;
+  const int num_rows = 100000;
+  const int64_t memory_limit = 256 * 1024;
+
+  std::shared_ptr<Table> table;
+  MakeDoubleTable(num_columns, num_rows, 1, &table);
+
+  // The buffered row groups are closed once they hold the limit
+  auto sink = std::make_shared<InMemoryOutputStream>();
+  std::shared_ptr<WriterProperties> properties = WriterProperties::Builder()
+                                                     .disable_dictionary()
+                                                     ->memory_limit(memory_limit)
+                                                     ->build();
+  ASSERT_OK_NO_THROW(WriteTable(*table, ::arrow::default_memory_pool(), sink, num_rows,
+                                properties));
+  std::shared_ptr<Buffer> buffer = sink->GetBuffer();
+
+  // Reads that need more memory than the limit fail
+  ReaderProperties reader_properties;
+  reader_properties.set_memory_limit(1024);
+  std::unique_ptr<FileReader> reader;
+  ASSERT_OK_NO_THROW(OpenFile(std::make_shared<BufferReader>(buffer),
+                              reader_properties.memory_pool(), reader_properties,
+                              nullptr, &reader));
+  ASSERT_LT(1, reader->num_row_groups());
+  std::shared_ptr<Table> result;
+  ASSERT_FALSE(reader->ReadTable(&result).ok());
+
+  reader_properties.set_memory_limit(64 * 1024 * 1024);
+  ASSERT_OK_NO_THROW(OpenFile(std::make_shared<BufferReader>(buffer),
+                              reader_properties.memory_pool(), reader_properties,
+                              nullptr, &reader));
+  std::unique_ptr<ColumnReader> column_reader;
+  ASSERT_OK_NO_THROW(reader->GetColumn(0, &column_reader));
+  std::shared_ptr<Array> batch;
+  ASSERT_OK_NO_THROW(column_reader->NextBatch(1000, &batch));
+  ASSERT_LT(0, column_reader->memory_usage());
+  ASSERT_LT(0, reader_properties.memory_usage());
+
+  ASSERT_OK_NO_THROW(reader->ReadTable(&result));
+  AssertTablesEqual(*table, *result, false);
+}
+
+TEST(TestArrowReadWrite, MultiSliceRowGroups) {
+  const int num_columns = 2;
+  const int num_rows = 20000;
+  const int64_t write_batch_size = 100;
+
+  std::shared_ptr<Table> table;
+  MakeDoubleTable(num_columns, num_rows, 1, &table);
+
+  // Both limits write the rows of a row group in slices of at least
+  // write_batch_size rows
+  std::vector<std::shared_ptr<WriterProperties>> all_properties;
+  all_properties.push_back(WriterProperties::Builder()
+                               .disable_dictionary()
+                               ->write_batch_size(write_batch_size)
+                               ->max_row_group_bytes(64 * 1024)
+                               ->build());
+  all_properties.push_back(WriterProperties::Builder()
+                               .disable_dictionary()
+                               ->write_batch_size(write_batch_size)
+                               ->memory_limit(64 * 1024)
+                               ->build());
+  for (const auto& properties : all_properties) {
+    auto sink = std::make_shared<InMemoryOutputStream>();
+    ASSERT_OK_NO_THROW(WriteTable(*table, ::arrow::default_memory_pool(), sink,
+                                  num_rows, properties));
+
+    std::unique_ptr<FileReader> reader;
+    ASSERT_OK_NO_THROW(OpenFile(std::make_shared<BufferReader>(sink->GetBuffer()),
+                                ::arrow::default_memory_pool(), &reader));
+    const auto metadata = reader->parquet_reader()->metadata();
+    ASSERT_LT(1, metadata->num_row_groups());
+    int64_t total_rows = 0;
+    for (int i = 0; i < metadata->num_row_groups(); i++) {
+      const int64_t row_group_rows = metadata->RowGroup(i)->num_rows();
+      if (i < metadata->num_row_groups() - 1) {
+        ASSERT_LT(write_batch_size, row_group_rows);
+      }
+      for (int j = 0; j < num_columns; j++) {
+        ASSERT_EQ(row_group_rows, metadata->RowGroup(i)->ColumnChunk(j)->num_values());
+      }
+      total_rows += row_group_rows;
+    }
+    ASSERT_EQ(num_rows, total_rows);
+
+    std::shared_ptr<Table> result;
+    ASSERT_OK_NO_THROW(reader->ReadTable(&result));
+    AssertTablesEqual(*table, *result, false);
+  }
+}
+
+TEST(TestArrowReadWrite, MultithreadedReadRowGroups) {
+  const int num_columns = 2;
+  const int num_rows = 1000;
+  const int num_threads = 4;
+
+  std::shared_ptr<Table> table;
+  MakeDoubleTable(num_columns, num_rows, 1, &table);
+
+  std::shared_ptr<Buffer> buffer;
+  WriteTableToBuffer(table, 1, num_rows / 10, default_arrow_writer_properties(),
+                     &buffer);
+
+  ArrowReaderProperties arrow_properties;
+  arrow_properties.set_parallelize_row_groups(true);
+  std::unique_ptr<FileReader> reader;
+  ASSERT_OK_NO_THROW(OpenFile(std::make_shared<BufferReader>(buffer),
+                              ::arrow::default_memory_pool(),
+                              ::parquet::default_reader_properties(), nullptr,
+                              arrow_properties, &reader));
+  reader->set_num_threads(num_threads);
+  // Fewer threads in the pool than the reader may use
+  reader->set_thread_pool(std::make_shared<ThreadPool>(2));
+  ASSERT_EQ(10, reader->num_row_groups());
+
+  std::shared_ptr<Table> result;
+  ASSERT_OK_NO_THROW(reader->ReadTable(&result));
+  ASSERT_OK(result->Validate());
+  // A chunk per row group
+  for (int i = 0; i < num_columns; i++) {
+    ASSERT_EQ(10, result->column(i)->data()->num_chunks());
+  }
+  AssertTablesEqual(*table, *result, false);
+}
+
+TEST(TestArrowReadWrite, MultithreadedReadPages) {
+  const int num_rows = 10000;
+
+  // Dictionary encoded strings with nulls, in a single row group
+  ::arrow::StringBuilder builder;
+  for (int i = 0; i < num_rows; i++) {
+    if (i % 7 == 0) {
+      ASSERT_OK(builder.AppendNull());
+    } else {
+      ASSERT_OK(builder.Append("value-" + std::to_string(i % 100)));
+    }
+  }
+  std::shared_ptr<Array> values;
+  ASSERT_OK(builder.Finish(&values));
+  std::shared_ptr<Table> table = MakeSimpleTable(values, true);
+
+  auto sink = std::make_shared<InMemoryOutputStream>();
+  std::shared_ptr<WriterProperties> properties =
+      WriterProperties::Builder().data_pagesize(512)->write_batch_size(100)->build();
+  ASSERT_OK_NO_THROW(WriteTable(*table, ::arrow::default_memory_pool(), sink, num_rows,
+                                properties));
+
+  ArrowReaderProperties arrow_properties;
+  arrow_properties.set_parallelize_pages(true);
+  std::unique_ptr<FileReader> reader;
+  ASSERT_OK_NO_THROW(OpenFile(std::make_shared<BufferReader>(sink->GetBuffer()),
+                              ::arrow::default_memory_pool(),
+                              ::parquet::default_reader_properties(), nullptr,
+                              arrow_properties, &reader));
+  reader->set_num_threads(4);
+  ASSERT_EQ(1, reader->num_row_groups());
+
+  std::shared_ptr<Table> result;
+  ASSERT_OK_NO_THROW(reader->ReadTable(&result));
+  ASSERT_OK(result->Validate());
+  // A chunk per page range
+  ASSERT_EQ(4, result->column(0)->data()->num_chunks());
+  AssertTablesEqual(*table, *result, false);
+}
+
+TEST(TestArrowReadWrite, ReadRows) {
+  const int num_rows = 10000;
+
+  ::arrow::Int64Builder builder;
+  for (int i = 0; i < num_rows; i++) {
+    if (i % 7 == 0) {
+      ASSERT_OK(builder.AppendNull());
+    } else {
+      ASSERT_OK(builder.Append(i));
+    }
+  }
+  std::shared_ptr<Array> values;
+  ASSERT_OK(builder.Finish(&values));
+  std::shared_ptr<Table> table = MakeSimpleTable(values, true);
+
+  auto sink = std::make_shared<InMemoryOutputStream>();
+  std::shared_ptr<WriterProperties> properties =
+      WriterProperties::Builder().data_pagesize(512)->write_batch_size(100)->build();
+  ASSERT_OK_NO_THROW(
+      WriteTable(*table, ::arrow::default_memory_pool(), sink, 3000, properties));
+
+  std::unique_ptr<FileReader> reader;
+  ASSERT_OK_NO_THROW(OpenFile(std::make_shared<BufferReader>(sink->GetBuffer()),
+                              ::arrow::default_memory_pool(),
+                              ::parquet::default_reader_properties(), nullptr, &reader));
+  ASSERT_EQ(4, reader->num_row_groups());
+
+  // The second range spans two row groups
+  std::vector<RowRange> ranges = {{5, 10}, {2990, 3010}, {5000, 5000}, {9999, 10000}};
+  std::shared_ptr<Table> result;
+  ASSERT_OK_NO_THROW(reader->ReadRows(ranges, {0}, &result));
+  ASSERT_OK(result->Validate());
+  ASSERT_EQ(36, result->num_rows());
+  const ::arrow::ChunkedArray& chunks = *result->column(0)->data();
+  std::vector<RowRange> expected = {{5, 10}, {2990, 3000}, {3000, 3010}, {9999, 10000}};
+  ASSERT_EQ(static_cast<int>(expected.size()), chunks.num_chunks());
+  for (size_t i = 0; i < expected.size(); ++i) {
+    const int64_t length = expected[i].end - expected[i].begin;
+    ASSERT_TRUE(chunks.chunk(static_cast<int>(i))
+                    ->Equals(values->Slice(expected[i].begin, length)));
+  }
+
+  // Runs of consecutive rows are read as a range
+  ASSERT_OK_NO_THROW(reader->TakeRows({1, 2, 3, 4000, 7000, 7001}, {0}, &result));
+  ASSERT_EQ(6, result->num_rows());
+  ASSERT_EQ(3, result->column(0)->data()->num_chunks());
+  ASSERT_TRUE(result->column(0)->data()->chunk(2)->Equals(values->Slice(7000, 2)));
+
+  ASSERT_RAISES(Invalid, reader->ReadRows({{10, 20}, {15, 30}}, {0}, &result));
+  ASSERT_RAISES(Invalid, reader->ReadRows({{10, num_rows + 1}}, {0}, &result));
+}
+
+TEST(TestArrowReadWrite, ReadDictionaryColumn) {
+  const int num_rows = 1000;
+
+  ::arrow::StringBuilder builder;
+  for (int i = 0; i < num_rows; i++) {
+    if (i % 7 == 0) {
+      ASSERT_OK(builder.AppendNull());
+    } else {
+      ASSERT_OK(builder.Append("value-" + std::to_string(i % 10)));
+    }
+  }
+  std::shared_ptr<Array> values;
+  ASSERT_OK(builder.Finish(&values));
+  std::shared_ptr<Table> table = MakeSimpleTable(values, true);
+
+  // Four row groups, each with its own dictionary
+  std::shared_ptr<Buffer> buffer;
+  WriteTableToBuffer(table, 1, num_rows / 4, default_arrow_writer_properties(), &buffer);
+
+  ArrowReaderProperties arrow_properties;
+  arrow_properties.set_read_dictionary(0, true);
+  std::unique_ptr<FileReader> reader;
+  ASSERT_OK_NO_THROW(OpenFile(std::make_shared<BufferReader>(buffer),
+                              ::arrow::default_memory_pool(),
+                              ::parquet::default_reader_properties(), nullptr,
+                              arrow_properties, &reader));
+
+  std::shared_ptr<Table> result;
+  ASSERT_OK_NO_THROW(reader->ReadTable(&result));
+  std::shared_ptr<ChunkedArray> chunked_array = result->column(0)->data();
+  ASSERT_EQ(1, chunked_array->num_chunks());
+  ASSERT_EQ(::arrow::Type::DICTIONARY, chunked_array->type()->id());
+
+  const auto& dict_array =
+      static_cast<const ::arrow::DictionaryArray&>(*chunked_array->chunk(0));
+  const auto& dictionary =
+      static_cast<const ::arrow::StringArray&>(*dict_array.dictionary());
+  const auto& indices = static_cast<const ::arrow::Int32Array&>(*dict_array.indices());
+  const auto& expected = static_cast<const ::arrow::StringArray&>(*values);
+
+  // The row group dictionaries are concatenated, values are not materialized
+  ASSERT_EQ(40, dictionary.length());
+  ASSERT_EQ(num_rows, dict_array.length());
+  ASSERT_EQ(expected.null_count(), dict_array.null_count());
+  for (int i = 0; i < num_rows; i++) {
+    ASSERT_EQ(expected.IsNull(i), dict_array.IsNull(i));
+    if (!expected.IsNull(i)) {
+      ASSERT_EQ(expected.GetString(i), dictionary.GetString(indices.Value(i)));
+    }
+  }
+}
+
+TEST(TestArrowReadWrite, WriteDictionaryColumn) {
+  const int num_rows = 1000;
+
+  // The last two entries of the dictionary are not referenced
+  ::arrow::StringBuilder dictionary_builder;
+  for (int i = 0; i < 10; i++) {
+    ASSERT_OK(dictionary_builder.Append("value-" + std::to_string(i)));
+  }
+  std::shared_ptr<Array> dictionary;
+  ASSERT_OK(dictionary_builder.Finish(&dictionary));
+
+  ::arrow::Int8Builder indices_builder;
+  ::arrow::StringBuilder expected_builder;
+  for (int i = 0; i < num_rows; i++) {
+    if (i % 7 == 0) {
+      ASSERT_OK(indices_builder.AppendNull());
+      ASSERT_OK(expected_builder.AppendNull());
+    } else {
+      ASSERT_OK(indices_builder.Append(static_cast<int8_t>(i % 8)));
+      ASSERT_OK(expected_builder.Append("value-" + std::to_string(i % 8)));
+    }
+  }
+  std::shared_ptr<Array> indices;
+  ASSERT_OK(indices_builder.Finish(&indices));
+  std::shared_ptr<Array> expected;
+  ASSERT_OK(expected_builder.Finish(&expected));
+
+  auto dict_type = std::make_shared<::arrow::DictionaryType>(::arrow::int8(), dictionary);
+  auto dict_array = std::make_shared<::arrow::DictionaryArray>(dict_type, indices);
+  std::shared_ptr<Table> table = MakeSimpleTable(dict_array->Slice(1), true);
+
+  std::shared_ptr<Buffer> buffer;
+  WriteTableToBuffer(table, 1, num_rows, default_arrow_writer_properties(), &buffer);
+
+  // The dictionary page holds the Arrow dictionary
+  ArrowReaderProperties arrow_properties;
+  arrow_properties.set_read_dictionary(0, true);
+  std::unique_ptr<FileReader> reader;
+  ASSERT_OK_NO_THROW(OpenFile(std::make_shared<BufferReader>(buffer),
+                              ::arrow::default_memory_pool(),
+                              ::parquet::default_reader_properties(), nullptr,
+                              arrow_properties, &reader));
+  std::shared_ptr<Table> result;
+  ASSERT_OK_NO_THROW(reader->ReadTable(&result));
+  const auto& result_array =
+      static_cast<const ::arrow::DictionaryArray&>(*result->column(0)->data()->chunk(0));
+  ASSERT_EQ(10, result_array.dictionary()->length());
+
+  ASSERT_OK_NO_THROW(OpenFile(std::make_shared<BufferReader>(buffer),
+                              ::arrow::default_memory_pool(),
+                              ::parquet::default_reader_properties(), nullptr, &reader));
+  ASSERT_OK_NO_THROW(reader->ReadTable(&result));
+  AssertTablesEqual(*MakeSimpleTable(expected->Slice(1), true), *result, false);
+}
+
+// Columns "int32", "int64" and "string" of sorted values, the strings with
+// long shared prefixes. Every ninth value is null
+void MakeSortedTable(int num_rows, std::shared_ptr<Table>* out) {
+  ::arrow::Int32Builder int32_builder;
+  ::arrow::Int64Builder int64_builder;
+  ::arrow::StringBuilder string_builder;
+  for (int i = 0; i < num_rows; i++) {
+    if (i % 9 == 0) {
+      ASSERT_OK(int32_builder.AppendNull());
+      ASSERT_OK(int64_builder.AppendNull());
+      ASSERT_OK(string_builder.AppendNull());
+    } else {
+      ASSERT_OK(int32_builder.Append(i * 3 - 1000));
+      ASSERT_OK(int64_builder.Append((static_cast<int64_t>(1) << 40) + i * 1000));
+      ASSERT_OK(string_builder.Append("prefix/shared/by/all/" + std::to_string(i)));
+    }
+  }
+  std::vector<std::shared_ptr<Array>> arrays(3);
+  ASSERT_OK(int32_builder.Finish(&arrays[0]));
+  ASSERT_OK(int64_builder.Finish(&arrays[1]));
+  ASSERT_OK(string_builder.Finish(&arrays[2]));
+  std::vector<std::string> names({"int32", "int64", "string"});
+  std::vector<std::shared_ptr<::arrow::Column>> columns;
+  std::vector<std::shared_ptr<::arrow::Field>> fields;
+  for (size_t i = 0; i < arrays.size(); i++) {
+    columns.push_back(MakeColumn(names[i], arrays[i], true));
+    fields.push_back(columns.back()->field());
+  }
+  *out = Table::Make(std::make_shared<::arrow::Schema>(fields), columns);
+}
+
+TEST(TestArrowReadWrite, DeltaEncodedColumns) {
+  const int num_rows = 1000;
+  std::shared_ptr<Table> table;
+  MakeSortedTable(num_rows, &table);
+
+  for (Encoding::type string_encoding :
+       {Encoding::DELTA_LENGTH_BYTE_ARRAY, Encoding::DELTA_BYTE_ARRAY}) {
+    // Small pages so that the decoders are set up again on every page
+    std::shared_ptr<WriterProperties> properties =
+        WriterProperties::Builder()
+            .disable_dictionary()
+            ->encoding("int32", Encoding::DELTA_BINARY_PACKED)
+            ->encoding("int64", Encoding::DELTA_BINARY_PACKED)
+            ->encoding("string", string_encoding)
+            ->data_pagesize(512)
+            ->build();
+    std::shared_ptr<Buffer> buffer;
+    WriteTableToBuffer(table, 1, num_rows / 2, default_arrow_writer_properties(),
+                       &buffer, properties);
+
+    std::unique_ptr<FileReader> reader;
+    ASSERT_OK_NO_THROW(OpenFile(std::make_shared<BufferReader>(buffer),
+                                ::arrow::default_memory_pool(), &reader));
+    auto row_group = reader->parquet_reader()->metadata()->RowGroup(0);
+    const std::vector<Encoding::type> expected_encodings(
+        {Encoding::DELTA_BINARY_PACKED, Encoding::DELTA_BINARY_PACKED, string_encoding});
+    for (int i = 0; i < 3; i++) {
+      const std::vector<Encoding::type>& encodings =
+          row_group->ColumnChunk(i)->encodings();
+      ASSERT_NE(encodings.end(), std::find(encodings.begin(), encodings.end(),
+                                           expected_encodings[i]));
+    }
+    std::shared_ptr<Table> result;
+    ASSERT_OK_NO_THROW(reader->ReadTable(&result));
+    AssertTablesEqual(*table, *result, false);
+  }
+}
+
+TEST(TestArrowReadWrite, AutoEncodedColumns) {
+  const int num_rows = 1000;
+  std::shared_ptr<Table> table;
+  MakeSortedTable(num_rows, &table);
+
+  std::shared_ptr<WriterProperties> properties =
+      WriterProperties::Builder().enable_auto_encoding()->build();
+  std::shared_ptr<Buffer> buffer;
+  WriteTableToBuffer(table, 1, num_rows / 2, default_arrow_writer_properties(), &buffer,
+                     properties);
+
+  std::unique_ptr<FileReader> reader;
+  ASSERT_OK_NO_THROW(OpenFile(std::make_shared<BufferReader>(buffer),
+                              ::arrow::default_memory_pool(), &reader));
+  // The sorted integers are delta encoded, whatever the strings are encoded
+  // with is read back as well
+  auto metadata = reader->parquet_reader()->metadata();
+  for (int rg = 0; rg < metadata->num_row_groups(); rg++) {
+    for (int i = 0; i < 2; i++) {
+      const std::vector<Encoding::type>& encodings =
+          metadata->RowGroup(rg)->ColumnChunk(i)->encodings();
+      ASSERT_NE(encodings.end(), std::find(encodings.begin(), encodings.end(),
+                                           Encoding::DELTA_BINARY_PACKED));
+    }
+  }
+  std::shared_ptr<Table> result;
+  ASSERT_OK_NO_THROW(reader->ReadTable(&result));
+  AssertTablesEqual(*table, *result, false);
+}
+
+TEST(TestArrowReadWrite, RequiredColumnsAcrossPages) {
+  const int num_rows = 1000;
+  // Does not divide the number of values per page, so that batches span pages
+  const int batch_size = 37;
+
+  std::vector<int32_t> int32_values;
+  std::vector<int64_t> int64_values;
+  std::vector<std::string> string_values;
+  for (int i = 0; i < num_rows; i++) {
+    int32_values.push_back(i % 50 - 25);
+    int64_values.push_back((static_cast<int64_t>(1) << 40) + i % 50);
+    string_values.push_back("value-" + std::to_string(i % 50));
+  }
+  std::vector<std::shared_ptr<Array>> arrays(3);
+  ::arrow::ArrayFromVector<::arrow::Int32Type, int32_t>(int32_values, &arrays[0]);
+  ::arrow::ArrayFromVector<::arrow::Int64Type, int64_t>(int64_values, &arrays[1]);
+  ::arrow::ArrayFromVector<::arrow::StringType, std::string>(string_values, &arrays[2]);
+  std::vector<std::string> names({"int32", "int64", "string"});
+  std::vector<std::shared_ptr<::arrow::Column>> columns;
+  std::vector<std::shared_ptr<::arrow::Field>> fields;
+  for (size_t i = 0; i < arrays.size(); i++) {
+    columns.push_back(MakeColumn(names[i], arrays[i], false));
+    fields.push_back(columns.back()->field());
+  }
+  auto table = Table::Make(std::make_shared<::arrow::Schema>(fields), columns);
+
+  for (bool dictionary : {false, true}) {
+    WriterProperties::Builder builder;
+    if (!dictionary) {
+      builder.disable_dictionary();
+    }
+    std::shared_ptr<WriterProperties> properties = builder.data_pagesize(256)->build();
+    std::shared_ptr<Buffer> buffer;
+    WriteTableToBuffer(table, 1, num_rows, default_arrow_writer_properties(), &buffer,
+                       properties);
+
+    std::unique_ptr<FileReader> reader;
+    ASSERT_OK_NO_THROW(OpenFile(std::make_shared<BufferReader>(buffer),
+                                ::arrow::default_memory_pool(), &reader));
+    auto row_group = reader->parquet_reader()->metadata()->RowGroup(0);
+    for (int i = 0; i < table->num_columns(); i++) {
+      ASSERT_EQ(dictionary, row_group->ColumnChunk(i)->has_dictionary_page() != 0);
+
+      std::unique_ptr<ColumnReader> column_reader;
+      ASSERT_OK_NO_THROW(reader->GetColumn(i, &column_reader));
+      for (int offset = 0; offset < num_rows; offset += batch_size) {
+        std::shared_ptr<Array> batch;
+        ASSERT_OK_NO_THROW(column_reader->NextBatch(batch_size, &batch));
+        ASSERT_EQ(std::min(batch_size, num_rows - offset), batch->length());
+        ASSERT_TRUE(batch->Equals(arrays[i]->Slice(offset, batch->length())));
+      }
+    }
+  }
+}
+
+TEST(TestArrowReadWrite, WriteStructColumn) {
+  const int num_rows = 100;
+
+  // The values of a below the null structs are valid, they are written as nulls
+  std::vector<bool> struct_is_valid, a_is_valid, expected_a_is_valid, b_is_valid;
+  std::vector<int32_t> a_values;
+  std::vector<std::string> b_values;
+  std::vector<int64_t> c_values;
+  for (int i = 0; i < num_rows; i++) {
+    struct_is_valid.push_back(i % 5 != 0);
+    a_is_valid.push_back(i % 3 != 0);
+    expected_a_is_valid.push_back(i % 3 != 0 && i % 5 != 0);
+    b_is_valid.push_back(i % 7 != 0 && i % 5 != 0);
+    a_values.push_back(i);
+    b_values.push_back("value-" + std::to_string(i));
+    c_values.push_back(i * 2);
+  }
+  std::shared_ptr<Array> a, expected_a, b, c, struct_validity;
+  ::arrow::ArrayFromVector<::arrow::Int32Type, int32_t>(a_is_valid, a_values, &a);
+  ::arrow::ArrayFromVector<::arrow::Int32Type, int32_t>(expected_a_is_valid, a_values,
+                                                        &expected_a);
+  ::arrow::ArrayFromVector<::arrow::StringType, std::string>(b_is_valid, b_values, &b);
+  ::arrow::ArrayFromVector<::arrow::Int64Type, int64_t>(c_values, &c);
+  ::arrow::ArrayFromVector<::arrow::BooleanType, bool>(struct_is_valid, struct_is_valid,
+                                                       &struct_validity);
+
+  auto struct_type = ::arrow::struct_({::arrow::field("a", ::arrow::int32()),
+                                       ::arrow::field("b", ::arrow::utf8())});
+  auto struct_array = std::make_shared<::arrow::StructArray>(
+      struct_type, num_rows, std::vector<std::shared_ptr<Array>>({a, b}),
+      struct_validity->null_bitmap(), struct_validity->null_count());
+  auto schema = ::arrow::schema({::arrow::field("s", struct_type),
+                                 ::arrow::field("c", ::arrow::int64(), false)});
+  std::shared_ptr<Table> table = Table::Make(
+      schema, {std::make_shared<Column>(schema->field(0), struct_array),
+               std::make_shared<Column>(schema->field(1), c)});
+
+  // Row groups that do not start at a chunk boundary
+  std::shared_ptr<Buffer> buffer;
+  WriteTableToBuffer(table, 1, 30, default_arrow_writer_properties(), &buffer);
+
+  std::unique_ptr<FileReader> reader;
+  ASSERT_OK_NO_THROW(OpenFile(std::make_shared<BufferReader>(buffer),
+                              ::arrow::default_memory_pool(),
+                              ::parquet::default_reader_properties(), nullptr, &reader));
+  ASSERT_EQ(3, reader->parquet_reader()->metadata()->num_columns());
+  std::shared_ptr<Table> result;
+  ASSERT_OK_NO_THROW(reader->ReadTable(&result));
+  ASSERT_EQ(2, result->num_columns());
+  ASSERT_EQ(num_rows, result->num_rows());
+
+  std::shared_ptr<ChunkedArray> result_structs = result->column(0)->data();
+  int64_t row = 0;
+  for (int chunk = 0; chunk < result_structs->num_chunks(); chunk++) {
+    const auto& result_struct =
+        static_cast<const ::arrow::StructArray&>(*result_structs->chunk(chunk));
+    for (int64_t i = 0; i < result_struct.length(); i++) {
+      ASSERT_EQ(struct_is_valid[row + i], result_struct.IsValid(i)) << row + i;
+    }
+    internal::AssertArraysEqual(*expected_a->Slice(row, result_struct.length()),
+                                *result_struct.field(0));
+    internal::AssertArraysEqual(*b->Slice(row, result_struct.length()),
+                                *result_struct.field(1));
+    row += result_struct.length();
+  }
+  ASSERT_EQ(num_rows, row);
+  ASSERT_TRUE(result->column(1)->data()->Equals(ChunkedArray({c})));
+}
+
+TEST(TestArrowReadWrite, WriteStructOfListColumn) {
+  // [{l: [1, 2]}, null, {l: null}, {l: []}, {l: [3, null]}]
+  std::shared_ptr<Array> values, offsets, list_validity, struct_validity;
+  ::arrow::ArrayFromVector<::arrow::Int32Type, int32_t>({true, true, true, false},
+                                                        {1, 2, 3, 0}, &values);
+  ::arrow::ArrayFromVector<::arrow::BooleanType, bool>(
+      {true, true, false, true, true}, {true, true, false, true, true}, &list_validity);
+  ::arrow::ArrayFromVector<::arrow::BooleanType, bool>(
+      {true, false, true, true, true}, {true, false, true, true, true}, &struct_validity);
+  std::vector<int32_t> offset_values = {0, 2, 2, 2, 2, 4};
+  auto offsets_buffer = std::make_shared<Buffer>(
+      reinterpret_cast<const uint8_t*>(offset_values.data()),
+      static_cast<int64_t>(offset_values.size() * sizeof(int32_t)));
+  auto list_array = std::make_shared<ListArray>(
+      ::arrow::list(::arrow::int32()), 5, offsets_buffer, values,
+      list_validity->null_bitmap(), list_validity->null_count());
+  auto struct_type = ::arrow::struct_({::arrow::field("l", list_array->type())});
+  auto struct_array = std::make_shared<::arrow::StructArray>(
+      struct_type, 5, std::vector<std::shared_ptr<Array>>({list_array}),
+      struct_validity->null_bitmap(), struct_validity->null_count());
+  std::shared_ptr<Table> table = MakeSimpleTable(struct_array, true);
+
+  std::shared_ptr<Buffer> buffer;
+  WriteTableToBuffer(table, 1, 5, default_arrow_writer_properties(), &buffer);
+
+  std::unique_ptr<ParquetFileReader> reader =
+      ParquetFileReader::Open(std::make_shared<BufferReader>(buffer));
+  ASSERT_EQ(4, reader->metadata()->schema()->Column(0)->max_definition_level());
+  auto column_reader =
+      std::static_pointer_cast<Int32Reader>(reader->RowGroup(0)->Column(0));
+  std::vector<int16_t> def_levels(10), rep_levels(10);
+  std::vector<int32_t> result_values(10);
+  int64_t values_read;
+  ASSERT_EQ(7, column_reader->ReadBatch(10, def_levels.data(), rep_levels.data(),
+                                        result_values.data(), &values_read));
+  ASSERT_EQ(3, values_read);
+  def_levels.resize(7);
+  rep_levels.resize(7);
+  result_values.resize(3);
+  ASSERT_EQ(std::vector<int16_t>({4, 4, 0, 1, 2, 4, 3}), def_levels);
+  ASSERT_EQ(std::vector<int16_t>({0, 1, 0, 0, 0, 0, 1}), rep_levels);
+  ASSERT_EQ(std::vector<int32_t>({1, 2, 3}), result_values);
+}
+
 TEST(TestArrowReadWrite, ReadSingleRowGroup) {
   const int num_columns = 20;
   const int num_rows = 1000;
@@ -1536,6 +2215,286 @@ TEST(TestArrowReadWrite, GetRecordBatchReader) {
   ASSERT_EQ(nullptr, batch);
 }
 
+TEST(TestArrowReadWrite, GetRecordBatchReaderPrefetch) {
+  const int num_rows = 1000;
+
+  ::arrow::Int64Builder builder;
+  for (int i = 0; i < num_rows; i++) {
+    ASSERT_OK(builder.Append(i));
+  }
+  std::shared_ptr<Array> values;
+  ASSERT_OK(builder.Finish(&values));
+  std::shared_ptr<Table> table = MakeSimpleTable(values, false);
+
+  std::shared_ptr<Buffer> buffer;
+  WriteTableToBuffer(table, 1, num_rows / 10, default_arrow_writer_properties(),
+                     &buffer);
+
+  std::unique_ptr<FileReader> reader;
+  ASSERT_OK_NO_THROW(OpenFile(std::make_shared<BufferReader>(buffer),
+                              ::arrow::default_memory_pool(),
+                              ::parquet::default_reader_properties(), nullptr, &reader));
+  reader->set_thread_pool(std::make_shared<ThreadPool>(2));
+
+  const std::vector<int> row_groups = {9, 3, 0, 2, 5};
+  for (int prefetch_depth : {1, 3, 10}) {
+    std::shared_ptr<::arrow::RecordBatchReader> rb_reader;
+    ASSERT_OK_NO_THROW(
+        reader->GetRecordBatchReader(row_groups, {0}, prefetch_depth, &rb_reader));
+    std::shared_ptr<::arrow::RecordBatch> batch;
+    for (int row_group : row_groups) {
+      ASSERT_OK(rb_reader->ReadNext(&batch));
+      ASSERT_TRUE(values->Slice(row_group * 100, 100)->Equals(batch->column(0)));
+    }
+    ASSERT_OK(rb_reader->ReadNext(&batch));
+    ASSERT_EQ(nullptr, batch);
+  }
+
+  // Row groups that are still being read when the reader goes away
+  std::shared_ptr<::arrow::RecordBatchReader> rb_reader;
+  ASSERT_OK_NO_THROW(reader->GetRecordBatchReader(row_groups, {0}, 4, &rb_reader));
+  std::shared_ptr<::arrow::RecordBatch> batch;
+  ASSERT_OK(rb_reader->ReadNext(&batch));
+  rb_reader.reset();
+}
+
+TEST(TestArrowReadWrite, GetRecordBatchReaderBatchSize) {
+  const int num_rows = 1000;
+
+  ::arrow::Int64Builder builder;
+  for (int i = 0; i < num_rows; i++) {
+    ASSERT_OK(builder.Append(i));
+  }
+  std::shared_ptr<Array> values;
+  ASSERT_OK(builder.Finish(&values));
+  std::shared_ptr<Table> table = MakeSimpleTable(values, true);
+
+  std::shared_ptr<Buffer> buffer;
+  WriteTableToBuffer(table, 1, num_rows / 10, default_arrow_writer_properties(),
+                     &buffer);
+
+  ArrowReaderProperties arrow_properties;
+  arrow_properties.set_batch_size(64);
+  std::unique_ptr<FileReader> reader;
+  ASSERT_OK_NO_THROW(OpenFile(std::make_shared<BufferReader>(buffer),
+                              ::arrow::default_memory_pool(),
+                              ::parquet::default_reader_properties(), nullptr,
+                              arrow_properties, &reader));
+
+  for (int prefetch_depth : {0, 2}) {
+    // The batches span the row groups 3, 4 and 5
+    std::shared_ptr<::arrow::RecordBatchReader> rb_reader;
+    ASSERT_OK_NO_THROW(
+        reader->GetRecordBatchReader({3, 4, 5}, {0}, prefetch_depth, &rb_reader));
+    std::shared_ptr<::arrow::RecordBatch> batch;
+    for (int64_t offset = 300; offset < 600; offset += 64) {
+      const int64_t length = std::min<int64_t>(64, 600 - offset);
+      ASSERT_OK(rb_reader->ReadNext(&batch));
+      ASSERT_NE(nullptr, batch);
+      ASSERT_EQ(length, batch->num_rows());
+      ASSERT_TRUE(values->Slice(offset, length)->Equals(batch->column(0)));
+    }
+    ASSERT_OK(rb_reader->ReadNext(&batch));
+    ASSERT_EQ(nullptr, batch);
+  }
+}
+
+TEST(TestArrowReadWrite, FilterRowGroups) {
+  const int num_rows = 1000;
+
+  ::arrow::Int64Builder builder;
+  for (int i = 0; i < num_rows; i++) {
+    ASSERT_OK(builder.Append(i));
+  }
+  std::shared_ptr<Array> values;
+  ASSERT_OK(builder.Finish(&values));
+  std::shared_ptr<Table> table = MakeSimpleTable(values, false);
+
+  // Ten row groups of 100 sorted values
+  std::shared_ptr<Buffer> buffer;
+  WriteTableToBuffer(table, 1, num_rows / 10, default_arrow_writer_properties(),
+                     &buffer);
+
+  auto OpenWithFilter = [&buffer](const std::shared_ptr<::parquet::Predicate>& filter,
+                                  std::unique_ptr<FileReader>* reader) {
+    ArrowReaderProperties arrow_properties;
+    arrow_properties.set_filter(filter);
+    return OpenFile(std::make_shared<BufferReader>(buffer),
+                    ::arrow::default_memory_pool(),
+                    ::parquet::default_reader_properties(), nullptr, arrow_properties,
+                    reader);
+  };
+
+  // Row groups 2, 3 and 4 hold values in [250, 480)
+  std::unique_ptr<FileReader> reader;
+  ASSERT_OK_NO_THROW(
+      OpenWithFilter(predicate::And({predicate::GreaterEqual<Int64Type>(0, 250),
+                                     predicate::Less<Int64Type>(0, 480)}),
+                     &reader));
+
+  std::shared_ptr<Table> result;
+  ASSERT_OK_NO_THROW(reader->ReadTable(&result));
+  ASSERT_EQ(300, result->num_rows());
+  ASSERT_EQ(1, result->column(0)->data()->num_chunks());
+  ASSERT_TRUE(values->Slice(200, 300)->Equals(result->column(0)->data()->chunk(0)));
+
+  std::shared_ptr<::arrow::RecordBatchReader> rb_reader;
+  ASSERT_OK_NO_THROW(reader->GetRecordBatchReader({9, 3, 0, 2}, &rb_reader));
+  std::shared_ptr<::arrow::RecordBatch> batch;
+  ASSERT_OK(rb_reader->ReadNext(&batch));
+  ASSERT_TRUE(values->Slice(300, 100)->Equals(batch->column(0)));
+  ASSERT_OK(rb_reader->ReadNext(&batch));
+  ASSERT_TRUE(values->Slice(200, 100)->Equals(batch->column(0)));
+  ASSERT_OK(rb_reader->ReadNext(&batch));
+  ASSERT_EQ(nullptr, batch);
+
+  // No row group can match
+  ASSERT_OK_NO_THROW(OpenWithFilter(predicate::In<Int64Type>(0, {-1, 1000}), &reader));
+  ASSERT_OK_NO_THROW(reader->ReadTable(&result));
+  ASSERT_EQ(0, result->num_rows());
+  ASSERT_EQ(1, result->num_columns());
+}
+
+TEST(TestArrowReadWrite, ComputeAggregates) {
+  const int num_rows = 1000;
+
+  // Every fourth value is null
+  ::arrow::Int64Builder builder;
+  for (int i = 0; i < num_rows; i++) {
+    if (i % 4 == 0) {
+      ASSERT_OK(builder.AppendNull());
+    } else {
+      ASSERT_OK(builder.Append(i));
+    }
+  }
+  std::shared_ptr<Array> values;
+  ASSERT_OK(builder.Finish(&values));
+  std::shared_ptr<Table> table = MakeSimpleTable(values, true);
+
+  auto CheckAggregates = [](const FileAggregates& aggregates, int64_t num_rows,
+                            int64_t min, int64_t max, int num_decoded_chunks) {
+    ASSERT_EQ(num_rows, aggregates.num_rows);
+    ASSERT_EQ(num_rows / 100, static_cast<int64_t>(aggregates.row_groups.size()));
+    ASSERT_EQ(1U, aggregates.columns.size());
+    const ColumnAggregate& column = aggregates.columns[0];
+    ASSERT_EQ(num_rows / 4 * 3, column.num_values);
+    ASSERT_EQ(num_rows / 4, column.null_count);
+    ASSERT_EQ(num_decoded_chunks, column.num_decoded_chunks);
+    auto statistics = std::static_pointer_cast<Int64Statistics>(column.statistics);
+    ASSERT_TRUE(statistics->HasMinMax());
+    ASSERT_EQ(min, statistics->min());
+    ASSERT_EQ(max, statistics->max());
+  };
+
+  // Ten row groups of 100 sorted values
+  std::shared_ptr<Buffer> buffer;
+  WriteTableToBuffer(table, 1, num_rows / 10, default_arrow_writer_properties(),
+                     &buffer);
+  std::unique_ptr<FileReader> reader;
+  ASSERT_OK_NO_THROW(OpenFile(std::make_shared<BufferReader>(buffer),
+                              ::arrow::default_memory_pool(), &reader));
+  FileAggregates aggregates;
+  ASSERT_OK_NO_THROW(reader->ComputeAggregates({0}, &aggregates));
+  CheckAggregates(aggregates, num_rows, 1, 999, 0);
+
+  // Row groups 2, 3 and 4 hold values in [250, 480)
+  ArrowReaderProperties arrow_properties;
+  arrow_properties.set_filter(predicate::And(
+      {predicate::GreaterEqual<Int64Type>(0, 250), predicate::Less<Int64Type>(0, 480)}));
+  ASSERT_OK_NO_THROW(OpenFile(std::make_shared<BufferReader>(buffer),
+                              ::arrow::default_memory_pool(),
+                              ::parquet::default_reader_properties(), nullptr,
+                              arrow_properties, &reader));
+  ASSERT_OK_NO_THROW(reader->ComputeAggregates({0}, &aggregates));
+  CheckAggregates(aggregates, 300, 201, 499, 0);
+  ASSERT_EQ(std::vector<int>({2, 3, 4}), aggregates.row_groups);
+
+  // Without statistics every chunk is decoded
+  auto sink = std::make_shared<InMemoryOutputStream>();
+  std::unique_ptr<FileWriter> writer;
+  ASSERT_OK_NO_THROW(FileWriter::Open(
+      *table->schema(), ::arrow::default_memory_pool(), sink,
+      WriterProperties::Builder().disable_statistics()->build(),
+      default_arrow_writer_properties(), &writer));
+  ASSERT_OK_NO_THROW(writer->WriteTable(*table, num_rows / 10));
+  ASSERT_OK_NO_THROW(writer->Close());
+  ASSERT_OK_NO_THROW(OpenFile(std::make_shared<BufferReader>(sink->GetBuffer()),
+                              ::arrow::default_memory_pool(), &reader));
+  ASSERT_OK_NO_THROW(reader->ComputeAggregates({0}, &aggregates));
+  CheckAggregates(aggregates, num_rows, 1, 999, 10);
+}
+
+TEST(TestArrowReadWrite, DatasetReader) {
+  const int num_rows = 1000;
+
+  ::arrow::Int64Builder builder;
+  for (int i = 0; i < num_rows; i++) {
+    ASSERT_OK(builder.Append(i));
+  }
+  std::shared_ptr<Array> values;
+  ASSERT_OK(builder.Finish(&values));
+
+  // Files of 300, 300 and 400 sorted values in row groups of 100
+  std::vector<std::shared_ptr<Buffer>> buffers(3);
+  const int64_t offsets[] = {0, 300, 600, num_rows};
+  for (int i = 0; i < 3; ++i) {
+    std::shared_ptr<Table> table = MakeSimpleTable(
+        values->Slice(offsets[i], offsets[i + 1] - offsets[i]), false);
+    WriteTableToBuffer(table, 1, 100, default_arrow_writer_properties(), &buffers[i]);
+  }
+
+  auto OpenDataset = [&buffers](std::unique_ptr<DatasetReader>* dataset) -> Status {
+    std::vector<std::unique_ptr<FileReader>> files;
+    for (const auto& buffer : buffers) {
+      std::unique_ptr<FileReader> reader;
+      RETURN_NOT_OK(OpenFile(std::make_shared<BufferReader>(buffer),
+                             ::arrow::default_memory_pool(),
+                             ::parquet::default_reader_properties(), nullptr, &reader));
+      files.push_back(std::move(reader));
+    }
+    return DatasetReader::Open(std::move(files), dataset);
+  };
+
+  std::unique_ptr<DatasetReader> dataset;
+  ASSERT_OK_NO_THROW(OpenDataset(&dataset));
+  ASSERT_EQ(3, dataset->num_files());
+  ASSERT_EQ(1, dataset->schema()->num_fields());
+  dataset->set_thread_pool(std::make_shared<ThreadPool>(3));
+  dataset->set_num_threads(2);
+
+  for (int prefetch_depth : {0, 1, 4, 20}) {
+    std::shared_ptr<::arrow::RecordBatchReader> rb_reader;
+    ASSERT_OK_NO_THROW(
+        dataset->GetRecordBatchReader({0}, nullptr, prefetch_depth, &rb_reader));
+    std::shared_ptr<::arrow::RecordBatch> batch;
+    for (int64_t offset = 0; offset < num_rows; offset += 100) {
+      ASSERT_OK(rb_reader->ReadNext(&batch));
+      ASSERT_NE(nullptr, batch);
+      ASSERT_TRUE(values->Slice(offset, 100)->Equals(batch->column(0)));
+    }
+    ASSERT_OK(rb_reader->ReadNext(&batch));
+    ASSERT_EQ(nullptr, batch);
+  }
+
+  // The first two files are pruned, of the third one only the row groups
+  // from 700 on can match
+  std::shared_ptr<::arrow::RecordBatchReader> rb_reader;
+  ASSERT_OK_NO_THROW(dataset->GetRecordBatchReader(
+      {0}, predicate::GreaterEqual<Int64Type>(0, 750), 2, &rb_reader));
+  std::shared_ptr<::arrow::RecordBatch> batch;
+  for (int64_t offset = 700; offset < num_rows; offset += 100) {
+    ASSERT_OK(rb_reader->ReadNext(&batch));
+    ASSERT_TRUE(values->Slice(offset, 100)->Equals(batch->column(0)));
+  }
+  ASSERT_OK(rb_reader->ReadNext(&batch));
+  ASSERT_EQ(nullptr, batch);
+
+  // A file of another schema
+  std::shared_ptr<Table> other = MakeSimpleTable(values, true);
+  WriteTableToBuffer(other, 1, 100, default_arrow_writer_properties(), &buffers[1]);
+  ASSERT_RAISES(Invalid, OpenDataset(&dataset));
+}
+
 TEST(TestArrowReadWrite, ScanContents) {
   const int num_columns = 20;
   const int num_rows = 1000;
@@ -1583,6 +2542,42 @@ TEST(TestArrowReadWrite, ReadColumnSubset) {
   AssertTablesEqual(*expected, *result);
 }
 
+TEST(TestArrowReadWrite, NextBatchInto) {
+  const int num_rows = 100;
+  const int batch_size = 40;
+
+  std::shared_ptr<Array> values;
+  ASSERT_OK(NullableArray<::arrow::StringType>(num_rows, 10, 0, &values));
+  auto schema = ::arrow::schema({::arrow::field("a", values->type())});
+  std::shared_ptr<Table> table = Table::Make(schema, {values});
+
+  std::shared_ptr<Buffer> buffer;
+  WriteTableToBuffer(table, 1, num_rows / 2, default_arrow_writer_properties(), &buffer);
+
+  std::unique_ptr<FileReader> reader;
+  ASSERT_OK_NO_THROW(OpenFile(std::make_shared<BufferReader>(buffer),
+                              ::arrow::default_memory_pool(),
+                              ::parquet::default_reader_properties(), nullptr, &reader));
+  std::unique_ptr<ColumnReader> col_reader;
+  ASSERT_OK(reader->GetColumn(0, &col_reader));
+
+  ColumnBatchBuffers buffers;
+  buffers.values = std::make_shared<PoolBuffer>(::arrow::default_memory_pool());
+  std::shared_ptr<Array> batch;
+  ASSERT_RAISES(Invalid, col_reader->NextBatchInto(batch_size, buffers, &batch));
+  buffers.is_valid = std::make_shared<PoolBuffer>(::arrow::default_memory_pool());
+  buffers.data = std::make_shared<PoolBuffer>(::arrow::default_memory_pool());
+
+  for (int offset = 0; offset < num_rows; offset += batch_size) {
+    ASSERT_OK(col_reader->NextBatchInto(batch_size, buffers, &batch));
+    ASSERT_EQ(std::min(batch_size, num_rows - offset), batch->length());
+    ASSERT_TRUE(batch->Equals(values->Slice(offset, batch->length())));
+    // Decoded into the buffers of the caller
+    ASSERT_EQ(buffers.values.get(), batch->data()->buffers[1].get());
+    ASSERT_EQ(buffers.data.get(), batch->data()->buffers[2].get());
+  }
+}
+
 TEST(TestArrowReadWrite, ListLargeRecords) {
   const int num_rows = 50;
 
@@ -2060,6 +3055,34 @@ TEST_F(TestNestedSchemaRead, ReadTablePartial) {
   ValidateTableArrayTypes(*table);
 }
 
+TEST_F(TestNestedSchemaRead, ProjectNestedLeaf) {
+  CreateSimpleNestedParquet(Repetition::OPTIONAL);
+
+  std::vector<int> indices;
+  ASSERT_OK_NO_THROW(reader_->GetColumnIndices({"group1"}, &indices));
+  ASSERT_EQ(std::vector<int>({0, 1}), indices);
+  ASSERT_OK_NO_THROW(reader_->GetColumnIndices({"leaf3", "group1.leaf2"}, &indices));
+  ASSERT_EQ(std::vector<int>({2, 1}), indices);
+  ASSERT_RAISES(Invalid, reader_->GetColumnIndices({"group1.leaf4"}, &indices));
+  ASSERT_RAISES(Invalid, reader_->GetColumnIndices({"group"}, &indices));
+
+  // The validity of the struct comes from the levels of the projected leaf
+  std::shared_ptr<Table> table;
+  ASSERT_OK_NO_THROW(reader_->GetColumnIndices({"group1.leaf2"}, &indices));
+  ASSERT_OK_NO_THROW(reader_->ReadTable(indices, &table));
+  ASSERT_EQ(table->num_rows(), NUM_SIMPLE_TEST_ROWS);
+  ASSERT_EQ(table->num_columns(), 1);
+  ASSERT_EQ(table->schema()->field(0)->type()->num_children(), 1);
+  ValidateTableArrayTypes(*table);
+
+  auto struct_field_array =
+      std::static_pointer_cast<::arrow::StructArray>(table->column(0)->data()->chunk(0));
+  auto leaf2_array =
+      std::static_pointer_cast<::arrow::Int32Array>(struct_field_array->field(0));
+  ValidateArray(*struct_field_array, NUM_SIMPLE_TEST_ROWS / 3);
+  ValidateColumnArray(*leaf2_array, NUM_SIMPLE_TEST_ROWS * 2 / 3);
+}
+
 TEST_F(TestNestedSchemaRead, StructAndListTogetherUnsupported) {
   CreateSimpleNestedParquet(Repetition::REPEATED);
   std::shared_ptr<Table> table;
@@ -2169,6 +3192,143 @@ INSTANTIATE_TEST_CASE_P(
         std::make_tuple("fixed_length_decimal.parquet", ::arrow::decimal(25, 2)),
         std::make_tuple("fixed_length_decimal_legacy.parquet", ::arrow::decimal(13, 2))));
 
+// Returns the given pages once
+class VectorPageReader : public PageReader {
+ public:
+  explicit VectorPageReader(const std::vector<std::shared_ptr<Page>>& pages)
+      : pages_(pages), page_index_(0) {}
+
+  std::shared_ptr<Page> NextPage() override {
+    if (page_index_ == pages_.size()) {
+      return nullptr;
+    }
+    return pages_[page_index_++];
+  }
+
+  void set_max_page_header_size(uint32_t size) override {}
+
+ private:
+  std::vector<std::shared_ptr<Page>> pages_;
+  size_t page_index_;
+};
+
+TEST(TestRecordReader, PlainValuesSharedWithPage) {
+  NodePtr node = PrimitiveNode::Make("int64", Repetition::REQUIRED, ParquetType::INT64);
+  ColumnDescriptor descr(node, 0, 0);
+
+  const int num_values = 100;
+  std::shared_ptr<Buffer> values;
+  ASSERT_OK(::arrow::AllocateBuffer(default_memory_pool(), num_values * sizeof(int64_t),
+                                    &values));
+  auto values_data = reinterpret_cast<int64_t*>(values->mutable_data());
+  std::iota(values_data, values_data + num_values, 0);
+
+  auto shared_page = std::make_shared<DataPage>(values, num_values, Encoding::PLAIN,
+                                                Encoding::RLE, Encoding::RLE);
+  shared_page->set_buffer_shared(true);
+  auto page = std::make_shared<DataPage>(values, num_values, Encoding::PLAIN,
+                                         Encoding::RLE, Encoding::RLE);
+
+  auto record_reader = internal::RecordReader::Make(&descr);
+  record_reader->SetPageReader(std::unique_ptr<PageReader>(
+      new VectorPageReader({shared_page, page})));
+
+  // Points into the page that is shared
+  ASSERT_EQ(10, record_reader->ReadRecords(10));
+  ASSERT_EQ(values->data(), record_reader->values());
+  ASSERT_EQ(values->data(), record_reader->ReleaseValues()->data());
+
+  // Copied once the batch spans pages
+  record_reader->Reset();
+  ASSERT_EQ(num_values, record_reader->ReadRecords(num_values));
+  std::shared_ptr<Buffer> batch = record_reader->ReleaseValues();
+  ASSERT_NE(values->data(), batch->data());
+  auto batch_data = reinterpret_cast<const int64_t*>(batch->data());
+  for (int i = 0; i < num_values; ++i) {
+    ASSERT_EQ((i + 10) % num_values, batch_data[i]);
+  }
+}
+
+TEST(TestRecordReader, PlainValuesAcrossSharedPages) {
+  NodePtr node = PrimitiveNode::Make("int32", Repetition::REQUIRED, ParquetType::INT32);
+  ColumnDescriptor descr(node, 0, 0);
+
+  const int num_pages = 3;
+  const int values_per_page = 30;
+  std::vector<std::shared_ptr<Page>> pages;
+  for (int i = 0; i < num_pages; ++i) {
+    std::shared_ptr<Buffer> values;
+    ASSERT_OK(::arrow::AllocateBuffer(default_memory_pool(),
+                                      values_per_page * sizeof(int32_t), &values));
+    auto values_data = reinterpret_cast<int32_t*>(values->mutable_data());
+    std::iota(values_data, values_data + values_per_page, i * values_per_page);
+    auto page = std::make_shared<DataPage>(values, values_per_page, Encoding::PLAIN,
+                                           Encoding::RLE, Encoding::RLE);
+    page->set_buffer_shared(true);
+    pages.push_back(page);
+  }
+
+  auto record_reader = internal::RecordReader::Make(&descr);
+  record_reader->SetPageReader(
+      std::unique_ptr<PageReader>(new VectorPageReader(pages)));
+
+  // Every batch starts with values borrowed from a page, which are copied
+  // once the batch continues on the next page
+  const int batch_size = 25;
+  int next_value = 0;
+  while (next_value < num_pages * values_per_page) {
+    record_reader->Reset();
+    const int64_t records_read = record_reader->ReadRecords(batch_size);
+    ASSERT_EQ(std::min(batch_size, num_pages * values_per_page - next_value),
+              records_read);
+    std::shared_ptr<Buffer> batch = record_reader->ReleaseValues();
+    ASSERT_LE(records_read * static_cast<int64_t>(sizeof(int32_t)), batch->size());
+    auto batch_data = reinterpret_cast<const int32_t*>(batch->data());
+    for (int64_t i = 0; i < records_read; ++i) {
+      ASSERT_EQ(next_value++, batch_data[i]);
+    }
+  }
+  ASSERT_EQ(0, record_reader->ReadRecords(batch_size));
+}
+
+TEST(TestRecordReader, RecycleBuffer) {
+  NodePtr node = PrimitiveNode::Make("int64", Repetition::REQUIRED, ParquetType::INT64);
+  ColumnDescriptor descr(node, 0, 0);
+
+  const int num_values = 100;
+  std::shared_ptr<Buffer> values;
+  ASSERT_OK(::arrow::AllocateBuffer(default_memory_pool(), num_values * sizeof(int64_t),
+                                    &values));
+  auto values_data = reinterpret_cast<int64_t*>(values->mutable_data());
+  std::iota(values_data, values_data + num_values, 0);
+  auto page = std::make_shared<DataPage>(values, num_values, Encoding::PLAIN,
+                                         Encoding::RLE, Encoding::RLE);
+
+  auto record_reader = internal::RecordReader::Make(&descr);
+  record_reader->SetPageReader(std::unique_ptr<PageReader>(
+      new VectorPageReader({page, page, page})));
+
+  ASSERT_EQ(num_values, record_reader->ReadRecords(num_values));
+  std::shared_ptr<Buffer> first = record_reader->ReleaseValues();
+  const uint8_t* first_data = first->data();
+  // Ignored while it is referenced elsewhere
+  record_reader->RecycleBuffer(first);
+  record_reader->RecycleBuffer(std::move(first));
+
+  // Replaced the first buffer when it was released
+  record_reader->Reset();
+  ASSERT_EQ(num_values, record_reader->ReadRecords(num_values));
+  ASSERT_NE(first_data, record_reader->values());
+  std::shared_ptr<Buffer> second = record_reader->ReleaseValues();
+
+  // The recycled buffer replaced the second one
+  record_reader->Reset();
+  ASSERT_EQ(num_values, record_reader->ReadRecords(num_values));
+  ASSERT_EQ(first_data, record_reader->values());
+  std::shared_ptr<Buffer> third = record_reader->ReleaseValues();
+  ASSERT_EQ(0, memcmp(values->data(), third->data(), num_values * sizeof(int64_t)));
+}
+
 }  // namespace arrow
 
 }  // namespace parquet
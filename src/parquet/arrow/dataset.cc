@@ -0,0 +1,229 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+
+#include "parquet/arrow/dataset.h"
+
+#include <algorithm>
+#include <deque>
+#include <future>
+#include <sstream>
+#include <utility>
+
+#include "arrow/api.h"
+#include "arrow/io/file.h"
+
+#include "parquet/util/thread-pool.h"
+
+using arrow::RecordBatchReader;
+using arrow::Status;
+
+namespace parquet {
+namespace arrow {
+
+namespace {
+
+struct DatasetRowGroup {
+  FileReader* file;
+  int row_group;
+};
+
+// Reads the row groups of a dataset in order. If prefetch_depth is positive,
+// that many of the following row groups are read on the thread pool while the
+// current one is consumed
+class DatasetRecordBatchReader : public RecordBatchReader {
+ public:
+  DatasetRecordBatchReader(std::vector<DatasetRowGroup> row_groups,
+                           const std::vector<int>& column_indices,
+                           std::shared_ptr<::arrow::Schema> schema,
+                           ThreadPool* thread_pool, int prefetch_depth)
+      : row_groups_(std::move(row_groups)),
+        column_indices_(column_indices),
+        schema_(std::move(schema)),
+        thread_pool_(thread_pool),
+        prefetch_depth_(std::max(prefetch_depth, 0)),
+        next_row_group_(0) {}
+
+  ~DatasetRecordBatchReader() {
+    // The reads still running use the file readers
+    for (auto& read : prefetched_) {
+      read.wait();
+    }
+  }
+
+  std::shared_ptr<::arrow::Schema> schema() const override { return schema_; }
+
+  Status ReadNext(std::shared_ptr<::arrow::RecordBatch>* out) override {
+    while (true) {
+      if (table_batch_reader_ != nullptr) {
+        RETURN_NOT_OK(table_batch_reader_->ReadNext(out));
+        if (*out != nullptr) {
+          return Status::OK();
+        }
+        table_batch_reader_.reset();
+        table_.reset();
+      }
+
+      if (prefetch_depth_ > 0) {
+        // Keep prefetch_depth_ row groups in flight behind the one taken next
+        while (prefetched_.size() <= static_cast<size_t>(prefetch_depth_) &&
+               next_row_group_ < row_groups_.size()) {
+          Prefetch(row_groups_[next_row_group_++]);
+        }
+        if (prefetched_.empty()) {
+          *out = nullptr;
+          return Status::OK();
+        }
+        ReadResult result = prefetched_.front().get();
+        prefetched_.pop_front();
+        RETURN_NOT_OK(result.status);
+        table_ = result.table;
+      } else {
+        if (next_row_group_ == row_groups_.size()) {
+          *out = nullptr;
+          return Status::OK();
+        }
+        const DatasetRowGroup& row_group = row_groups_[next_row_group_++];
+        RETURN_NOT_OK(
+            row_group.file->ReadRowGroup(row_group.row_group, column_indices_, &table_));
+      }
+      // Row groups without rows yield no batch, the next one is read
+      table_batch_reader_.reset(new ::arrow::TableBatchReader(*table_));
+    }
+  }
+
+ private:
+  struct ReadResult {
+    Status status;
+    std::shared_ptr<::arrow::Table> table;
+  };
+
+  void Prefetch(const DatasetRowGroup& row_group) {
+    auto promise = std::make_shared<std::promise<ReadResult>>();
+    prefetched_.push_back(promise->get_future());
+    const std::vector<int>& column_indices = column_indices_;
+    thread_pool_->Spawn([promise, row_group, &column_indices]() {
+      ReadResult result;
+      result.status = row_group.file->ReadRowGroup(row_group.row_group, column_indices,
+                                                   &result.table);
+      promise->set_value(std::move(result));
+    });
+  }
+
+  std::vector<DatasetRowGroup> row_groups_;
+  std::vector<int> column_indices_;
+  std::shared_ptr<::arrow::Schema> schema_;
+  ThreadPool* thread_pool_;
+  const int prefetch_depth_;
+  size_t next_row_group_;
+  std::shared_ptr<::arrow::Table> table_;
+  std::unique_ptr<::arrow::TableBatchReader> table_batch_reader_;
+  // Row groups that are being read ahead, in the order they are consumed
+  std::deque<std::future<ReadResult>> prefetched_;
+};
+
+}  // namespace
+
+DatasetReader::DatasetReader(std::vector<std::unique_ptr<FileReader>> files,
+                             std::shared_ptr<::arrow::Schema> schema)
+    : files_(std::move(files)), schema_(std::move(schema)) {}
+
+Status DatasetReader::Open(std::vector<std::unique_ptr<FileReader>> files,
+                           std::unique_ptr<DatasetReader>* out) {
+  if (files.empty()) {
+    return Status::Invalid("A dataset needs at least one file");
+  }
+  const SchemaDescriptor* expected = files[0]->parquet_reader()->metadata()->schema();
+  for (size_t i = 1; i < files.size(); ++i) {
+    if (!files[i]->parquet_reader()->metadata()->schema()->Equals(*expected)) {
+      std::stringstream ss;
+      ss << "File " << i << " of the dataset has a different schema than file 0";
+      return Status::Invalid(ss.str());
+    }
+  }
+
+  std::vector<int> indices(expected->num_columns());
+  for (size_t i = 0; i < indices.size(); ++i) {
+    indices[i] = static_cast<int>(i);
+  }
+  std::shared_ptr<::arrow::Schema> schema;
+  RETURN_NOT_OK(files[0]->GetSchema(indices, &schema));
+
+  out->reset(new DatasetReader(std::move(files), std::move(schema)));
+  return Status::OK();
+}
+
+Status DatasetReader::Open(const std::vector<std::string>& paths,
+                           ::arrow::MemoryPool* pool, const ReaderProperties& properties,
+                           const ArrowReaderProperties& arrow_properties,
+                           std::unique_ptr<DatasetReader>* out) {
+  std::vector<std::unique_ptr<FileReader>> files;
+  for (const std::string& path : paths) {
+    std::shared_ptr<::arrow::io::ReadableFile> handle;
+    RETURN_NOT_OK(::arrow::io::ReadableFile::Open(path, pool, &handle));
+    std::unique_ptr<FileReader> file;
+    RETURN_NOT_OK(OpenFile(handle, pool, properties, nullptr, arrow_properties, &file));
+    files.push_back(std::move(file));
+  }
+  return Open(std::move(files), out);
+}
+
+Status DatasetReader::GetRecordBatchReader(const std::vector<int>& column_indices,
+                                           const std::shared_ptr<Predicate>& filter,
+                                           int prefetch_depth,
+                                           std::shared_ptr<RecordBatchReader>* out) {
+  std::shared_ptr<::arrow::Schema> schema;
+  RETURN_NOT_OK(files_[0]->GetSchema(column_indices, &schema));
+
+  // The files are pruned from the statistics of their row groups, as the
+  // metadata has no statistics of whole files
+  std::vector<DatasetRowGroup> row_groups;
+  for (const auto& file : files_) {
+    std::shared_ptr<FileMetaData> metadata = file->parquet_reader()->metadata();
+    for (int i = 0; i < metadata->num_row_groups(); ++i) {
+      bool can_match = true;
+      if (filter != nullptr) {
+        PARQUET_CATCH_NOT_OK(can_match = filter->CanMatch(*metadata->RowGroup(i)));
+      }
+      if (can_match) {
+        row_groups.push_back({file.get(), i});
+      }
+    }
+  }
+
+  ThreadPool* thread_pool =
+      thread_pool_ ? thread_pool_.get() : ThreadPool::GetDefault().get();
+  *out = std::make_shared<DatasetRecordBatchReader>(
+      std::move(row_groups), column_indices, schema, thread_pool, prefetch_depth);
+  return Status::OK();
+}
+
+void DatasetReader::set_num_threads(int num_threads) {
+  for (const auto& file : files_) {
+    file->set_num_threads(num_threads);
+  }
+}
+
+void DatasetReader::set_thread_pool(const std::shared_ptr<ThreadPool>& pool) {
+  thread_pool_ = pool;
+  for (const auto& file : files_) {
+    file->set_thread_pool(pool);
+  }
+}
+
+}  // namespace arrow
+}  // namespace parquet
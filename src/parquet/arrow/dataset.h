@@ -0,0 +1,103 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+
+#ifndef PARQUET_ARROW_DATASET_H
+#define PARQUET_ARROW_DATASET_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "parquet/arrow/reader.h"
+#include "parquet/predicate.h"
+#include "parquet/util/visibility.h"
+
+namespace arrow {
+
+class MemoryPool;
+class RecordBatchReader;
+class Schema;
+class Status;
+}  // namespace arrow
+
+namespace parquet {
+
+class ThreadPool;
+
+namespace arrow {
+
+// Reads a dataset made of several Parquet files with the same schema, e.g. the
+// files of a directory, as one stream of record batches. The row groups of all
+// the files are read on one thread pool: up to prefetch_depth row groups,
+// possibly of different files, are read at the same time, and the columns of
+// each with up to num_threads threads.
+class PARQUET_EXPORT DatasetReader {
+ public:
+  // The files must all have the schema of the first one, else an Invalid
+  // Status is returned. There must be at least one file
+  static ::arrow::Status Open(std::vector<std::unique_ptr<FileReader>> files,
+                              std::unique_ptr<DatasetReader>* out);
+
+  // Open the files at paths with the given properties
+  static ::arrow::Status Open(const std::vector<std::string>& paths,
+                              ::arrow::MemoryPool* pool,
+                              const ReaderProperties& properties,
+                              const ArrowReaderProperties& arrow_properties,
+                              std::unique_ptr<DatasetReader>* out);
+
+  // The Arrow schema of the files
+  const std::shared_ptr<::arrow::Schema>& schema() const { return schema_; }
+
+  int num_files() const { return static_cast<int>(files_.size()); }
+
+  FileReader* file(int i) const { return files_[i].get(); }
+
+  /// \brief Return a RecordBatchReader of the leaf columns column_indices of
+  ///     the row groups of every file, in file order, that filter may match,
+  ///     see Predicate::CanMatch. Files none of whose row groups can match are
+  ///     not read at all. filter may be nullptr. The batches of a row group
+  ///     follow its chunks as with FileReader::GetRecordBatchReader. With a
+  ///     positive prefetch_depth, that many of the following row groups are
+  ///     read in the background. The RecordBatchReader must not outlive the
+  ///     DatasetReader
+  ::arrow::Status GetRecordBatchReader(const std::vector<int>& column_indices,
+                                       const std::shared_ptr<Predicate>& filter,
+                                       int prefetch_depth,
+                                       std::shared_ptr<::arrow::RecordBatchReader>* out);
+
+  /// Set the number of threads that read the columns of a row group, 1 by
+  /// default
+  void set_num_threads(int num_threads);
+
+  /// Set the pool that runs the reads of all files. By default the
+  /// process-wide ThreadPool::GetDefault pool is used
+  void set_thread_pool(const std::shared_ptr<ThreadPool>& pool);
+
+ private:
+  DatasetReader(std::vector<std::unique_ptr<FileReader>> files,
+                std::shared_ptr<::arrow::Schema> schema);
+
+  std::vector<std::unique_ptr<FileReader>> files_;
+  std::shared_ptr<::arrow::Schema> schema_;
+  std::shared_ptr<ThreadPool> thread_pool_;
+};
+
+}  // namespace arrow
+}  // namespace parquet
+
+#endif  // PARQUET_ARROW_DATASET_H
@@ -20,8 +20,13 @@
 #include <algorithm>
 #include <atomic>
 #include <chrono>
+#include <climits>
+#include <cstring>
+#include <deque>
+#include <future>
 #include <mutex>
 #include <queue>
+#include <sstream>
 #include <string>
 #include <thread>
 #include <type_traits>
@@ -31,13 +36,15 @@
 #include "arrow/util/bit-util.h"
 #include "arrow/util/decimal.h"
 #include "arrow/util/logging.h"
-#include "arrow/util/parallel.h"
 
 #include "parquet/arrow/record_reader.h"
 #include "parquet/arrow/schema.h"
 #include "parquet/column_reader.h"
 #include "parquet/schema.h"
+#include "parquet/util/list-levels.h"
 #include "parquet/util/schema-util.h"
+#include "parquet/util/temporal.h"
+#include "parquet/util/thread-pool.h"
 
 using arrow::Array;
 using arrow::BooleanArray;
@@ -56,26 +63,16 @@ using parquet::schema::Node;
 
 // Help reduce verbosity
 using ParquetReader = parquet::ParquetFileReader;
-using arrow::ParallelFor;
 using arrow::RecordBatchReader;
 
 using parquet::internal::RecordReader;
+using parquet::internal::SharedDictionary;
 
 namespace parquet {
 namespace arrow {
 
 using ::arrow::BitUtil::BytesForBits;
 
-constexpr int64_t kJulianToUnixEpochDays = 2440588LL;
-constexpr int64_t kMillisecondsInADay = 86400000LL;
-constexpr int64_t kNanosecondsInADay = kMillisecondsInADay * 1000LL * 1000LL;
-
-static inline int64_t impala_timestamp_to_nanoseconds(const Int96& impala_timestamp) {
-  int64_t days_since_epoch = impala_timestamp.value[2] - kJulianToUnixEpochDays;
-  int64_t nanoseconds = *(reinterpret_cast<const int64_t*>(&(impala_timestamp.value)));
-  return days_since_epoch * kNanosecondsInADay + nanoseconds;
-}
-
 template <typename ArrowType>
 using ArrayType = typename ::arrow::TypeTraits<ArrowType>::ArrayType;
 
@@ -129,6 +126,27 @@ class AllRowGroupsIterator : public FileColumnIterator {
   int next_row_group_;
 };
 
+class SelectedRowGroupsIterator : public FileColumnIterator {
+ public:
+  explicit SelectedRowGroupsIterator(int column_index, const std::vector<int>& row_groups,
+                                     ParquetFileReader* reader)
+      : FileColumnIterator(column_index, reader),
+        row_groups_(row_groups),
+        next_row_group_(0) {}
+
+  std::unique_ptr<::parquet::PageReader> NextChunk() override {
+    if (next_row_group_ == row_groups_.size()) {
+      return nullptr;
+    }
+    return reader_->RowGroup(row_groups_[next_row_group_++])
+        ->GetColumnPageReader(column_index_);
+  }
+
+ private:
+  std::vector<int> row_groups_;
+  size_t next_row_group_;
+};
+
 class SingleRowGroupIterator : public FileColumnIterator {
  public:
   explicit SingleRowGroupIterator(int column_index, int row_group_number,
@@ -153,19 +171,94 @@ class SingleRowGroupIterator : public FileColumnIterator {
   bool done_;
 };
 
+// Iterates over the data pages of a column chunk that hold the rows
+// [begin, end) of the row group. The range has to start at a page boundary
+class PageRangeIterator : public FileColumnIterator {
+ public:
+  explicit PageRangeIterator(int column_index, int row_group_number,
+                             const RowRange& rows, ParquetFileReader* reader)
+      : FileColumnIterator(column_index, reader),
+        row_group_number_(row_group_number),
+        rows_(rows),
+        done_(false) {}
+
+  std::unique_ptr<::parquet::PageReader> NextChunk() override {
+    if (done_) {
+      return nullptr;
+    }
+
+    int64_t first_row_index;
+    auto result = reader_->RowGroup(row_group_number_)
+                      ->GetColumnPageReader(column_index_, rows_.begin, rows_.end,
+                                            &first_row_index);
+    if (first_row_index != rows_.begin) {
+      throw ParquetException("Page range does not start at a page boundary");
+    }
+    done_ = true;
+    return result;
+  }
+
+ private:
+  int row_group_number_;
+  RowRange rows_;
+  bool done_;
+};
+
+// Iterates over the data pages of a column chunk that hold the rows
+// [begin, end) of the row group. The pages start at first_row_index(), the
+// rows before begin still have to be skipped
+class RowRangeIterator : public FileColumnIterator {
+ public:
+  explicit RowRangeIterator(int column_index, int row_group_number,
+                            const RowRange& rows, ParquetFileReader* reader)
+      : FileColumnIterator(column_index, reader),
+        row_group_number_(row_group_number),
+        rows_(rows),
+        first_row_index_(0),
+        done_(false) {}
+
+  std::unique_ptr<::parquet::PageReader> NextChunk() override {
+    if (done_) {
+      return nullptr;
+    }
+    done_ = true;
+    return reader_->RowGroup(row_group_number_)
+        ->GetColumnPageReader(column_index_, rows_.begin, rows_.end, &first_row_index_);
+  }
+
+  int64_t first_row_index() const { return first_row_index_; }
+
+ private:
+  int row_group_number_;
+  RowRange rows_;
+  int64_t first_row_index_;
+  bool done_;
+};
+
+// If prefetch_depth is positive, that many of the following row groups are
+// read on the thread pool while the current one is consumed
 class RowGroupRecordBatchReader : public ::arrow::RecordBatchReader {
  public:
   explicit RowGroupRecordBatchReader(const std::vector<int>& row_group_indices,
                                      const std::vector<int>& column_indices,
                                      std::shared_ptr<::arrow::Schema> schema,
-                                     FileReader* reader)
+                                     FileReader* reader,
+                                     ThreadPool* thread_pool = nullptr,
+                                     int prefetch_depth = 0)
       : row_group_indices_(row_group_indices),
         column_indices_(column_indices),
         schema_(schema),
         file_reader_(reader),
+        thread_pool_(thread_pool),
+        prefetch_depth_(thread_pool == nullptr ? 0 : std::max(prefetch_depth, 0)),
         next_row_group_(0) {}
 
-  ~RowGroupRecordBatchReader() {}
+  ~RowGroupRecordBatchReader() {
+    // The reads still running use file_reader_
+    for (auto& read : prefetched_) {
+      read.wait();
+    }
+  }
 
   std::shared_ptr<::arrow::Schema> schema() const override { return schema_; }
 
@@ -182,28 +275,67 @@ class RowGroupRecordBatchReader : public ::arrow::RecordBatchReader {
       }
     }
 
-    // all row groups has been consumed
-    if (next_row_group_ == row_group_indices_.size()) {
-      *out = nullptr;
-      return Status::OK();
-    }
+    if (prefetch_depth_ > 0) {
+      // Keep prefetch_depth_ row groups in flight behind the one taken next
+      while (prefetched_.size() <= static_cast<size_t>(prefetch_depth_) &&
+             next_row_group_ < row_group_indices_.size()) {
+        Prefetch(row_group_indices_[next_row_group_++]);
+      }
+      // all row groups has been consumed
+      if (prefetched_.empty()) {
+        *out = nullptr;
+        return Status::OK();
+      }
+      PrefetchedRowGroup row_group = prefetched_.front().get();
+      prefetched_.pop_front();
+      RETURN_NOT_OK(row_group.status);
+      table_ = row_group.table;
+    } else {
+      // all row groups has been consumed
+      if (next_row_group_ == row_group_indices_.size()) {
+        *out = nullptr;
+        return Status::OK();
+      }
 
-    RETURN_NOT_OK(file_reader_->ReadRowGroup(row_group_indices_[next_row_group_],
-                                             column_indices_, &table_));
+      RETURN_NOT_OK(file_reader_->ReadRowGroup(row_group_indices_[next_row_group_],
+                                               column_indices_, &table_));
 
-    next_row_group_++;
+      next_row_group_++;
+    }
     table_batch_reader_.reset(new ::arrow::TableBatchReader(*table_.get()));
     return table_batch_reader_->ReadNext(out);
   }
 
  private:
+  struct PrefetchedRowGroup {
+    Status status;
+    std::shared_ptr<::arrow::Table> table;
+  };
+
+  void Prefetch(int row_group_index) {
+    auto promise = std::make_shared<std::promise<PrefetchedRowGroup>>();
+    prefetched_.push_back(promise->get_future());
+    FileReader* file_reader = file_reader_;
+    const std::vector<int>& column_indices = column_indices_;
+    thread_pool_->Spawn([promise, file_reader, &column_indices, row_group_index]() {
+      PrefetchedRowGroup result;
+      result.status =
+          file_reader->ReadRowGroup(row_group_index, column_indices, &result.table);
+      promise->set_value(std::move(result));
+    });
+  }
+
   std::vector<int> row_group_indices_;
   std::vector<int> column_indices_;
   std::shared_ptr<::arrow::Schema> schema_;
   FileReader* file_reader_;
+  ThreadPool* thread_pool_;
+  const int prefetch_depth_;
   size_t next_row_group_;
   std::shared_ptr<::arrow::Table> table_;
   std::unique_ptr<::arrow::TableBatchReader> table_batch_reader_;
+  // Row groups that are being read ahead, in the order they are consumed
+  std::deque<std::future<PrefetchedRowGroup>> prefetched_;
 };
 
 // ----------------------------------------------------------------------
@@ -211,17 +343,25 @@ class RowGroupRecordBatchReader : public ::arrow::RecordBatchReader {
 
 class FileReader::Impl {
  public:
-  Impl(MemoryPool* pool, std::unique_ptr<ParquetFileReader> reader)
-      : pool_(pool), reader_(std::move(reader)), num_threads_(1) {}
+  Impl(MemoryPool* pool, std::unique_ptr<ParquetFileReader> reader,
+       const ArrowReaderProperties& properties)
+      : pool_(pool),
+        reader_(std::move(reader)),
+        properties_(properties),
+        num_threads_(1) {}
 
   virtual ~Impl() {}
 
   Status GetColumn(int i, std::unique_ptr<ColumnReader>* out);
+  Status GetColumn(int i, const std::vector<int>& row_groups,
+                   std::unique_ptr<ColumnReader>* out);
   Status ReadSchemaField(int i, std::shared_ptr<Array>* out);
   Status ReadSchemaField(int i, const std::vector<int>& indices,
                          std::shared_ptr<Array>* out);
+  Status ReadSchemaField(int i, const std::vector<int>& indices,
+                         const std::vector<int>& row_groups, std::shared_ptr<Array>* out);
   Status GetReaderForNode(int index, const Node* node, const std::vector<int>& indices,
-                          int16_t def_level,
+                          const std::vector<int>& row_groups, int16_t def_level,
                           std::unique_ptr<ColumnReader::ColumnReaderImpl>* out);
   Status ReadColumn(int i, std::shared_ptr<Array>* out);
   Status ReadColumnChunk(int column_index, int row_group_index,
@@ -235,6 +375,82 @@ class FileReader::Impl {
   Status ReadTable(std::shared_ptr<Table>* table);
   Status ReadRowGroup(int i, std::shared_ptr<Table>* table);
 
+  // Reader of batches of properties_.batch_size() rows
+  Status GetRecordBatchReader(const std::vector<int>& row_groups,
+                              const std::vector<int>& indices,
+                              const std::shared_ptr<::arrow::Schema>& schema,
+                              bool prefetch, std::shared_ptr<RecordBatchReader>* out);
+
+  int64_t batch_size() const { return properties_.batch_size(); }
+
+  // Read the fields of ReadTable with a task per row group and field. The
+  // chunks of the fields whose entry in split_columns is a column index are
+  // further split into page ranges
+  Status ReadRowGroupChunks(const std::vector<int>& indices,
+                            const std::vector<int>& field_indices,
+                            const std::vector<int>& split_columns,
+                            const std::vector<int>& row_groups,
+                            const std::shared_ptr<::arrow::Schema>& schema,
+                            std::vector<std::shared_ptr<Column>>* columns);
+
+  // The column of the field if its chunks can be split into page ranges in
+  // all of the row groups, -1 otherwise
+  int SplitColumn(int field_index, const std::vector<int>& indices,
+                  const std::vector<int>& row_groups);
+
+  // Split the column chunk into up to num_threads_ ranges of rows that start
+  // at page boundaries. out is left empty if the chunk cannot be split
+  Status PageRanges(int column_index, int row_group_index, std::vector<RowRange>* out);
+
+  Status ReadPageRange(int column_index, int row_group_index, const RowRange& rows,
+                       const std::shared_ptr<SharedDictionary>& dictionary,
+                       std::shared_ptr<Array>* out);
+
+  // The rows of a row group that FileReader::ReadRows reads
+  struct RowGroupRows {
+    int row_group;
+    RowRange rows;
+  };
+
+  Status ReadRows(const std::vector<RowRange>& ranges, const std::vector<int>& indices,
+                  std::shared_ptr<Table>* out);
+
+  // Split the ranges of rows of the file at the row group boundaries
+  Status SplitRowRanges(const std::vector<RowRange>& ranges,
+                        std::vector<RowGroupRows>* out);
+
+  // Read the rows of the column with a chunk each. The rows of a row group
+  // whose data pages follow each other are read with a single page reader
+  Status ReadRowGroupRows(int column_index, const std::vector<RowGroupRows>& rows,
+                          ::arrow::ArrayVector* out);
+
+  // Read the rows [begin, end) of rows, all of a single row group, with a
+  // single page reader
+  Status ReadContiguousRows(int column_index, const std::vector<RowGroupRows>& rows,
+                            size_t begin, size_t end, ::arrow::ArrayVector* out);
+
+  // Whether any of the selected columns of the field is read as a dictionary
+  bool ReadsDictionary(int field_index, const std::vector<int>& indices);
+
+  // Estimated cost of reading the column chunk: decoding its pages plus
+  // decompressing them, which takes longer per byte for the codecs that
+  // compress better. The parallel reads start the largest tasks first.
+  int64_t ColumnChunkCost(int column_index, int row_group_index);
+
+  // Share of ColumnChunkCost of the rows of the chunk
+  int64_t RowsCost(int column_index, int row_group_index, const RowRange& rows);
+
+  // Estimated cost of reading the selected columns of the field in the row
+  // groups
+  int64_t ReadCost(int field_index, const std::vector<int>& indices,
+                   const std::vector<int>& row_groups);
+
+  Status MakeEmptyArray(const std::shared_ptr<Field>& field,
+                        std::shared_ptr<Array>* out);
+
+  // Drop the row groups that the filter of the properties rules out
+  Status FilterRowGroups(const std::vector<int>& row_groups, std::vector<int>* out);
+
   bool CheckForFlatColumn(const ColumnDescriptor* descr);
   bool CheckForFlatListColumn(const ColumnDescriptor* descr);
 
@@ -246,19 +462,36 @@ class FileReader::Impl {
 
   void set_num_threads(int num_threads) { num_threads_ = num_threads; }
 
+  void set_thread_pool(const std::shared_ptr<ThreadPool>& pool) { thread_pool_ = pool; }
+
+  ThreadPool* thread_pool() const {
+    return thread_pool_ ? thread_pool_.get() : ThreadPool::GetDefault().get();
+  }
+
   ParquetFileReader* reader() { return reader_.get(); }
 
+  const ArrowReaderProperties& properties() const { return properties_; }
+
  private:
   MemoryPool* pool_;
   std::unique_ptr<ParquetFileReader> reader_;
+  ArrowReaderProperties properties_;
 
   int num_threads_;
+  std::shared_ptr<ThreadPool> thread_pool_;
 };
 
 class ColumnReader::ColumnReaderImpl {
  public:
   virtual ~ColumnReaderImpl() {}
   virtual Status NextBatch(int64_t records_to_read, std::shared_ptr<Array>* out) = 0;
+  virtual Status NextBatchInto(int64_t records_to_read, const ColumnBatchBuffers& buffers,
+                               std::shared_ptr<Array>* out) = 0;
+  // Keep the buffers of data for the following batches, see
+  // ColumnReader::RecycleBuffers
+  virtual void RecycleBuffers(std::shared_ptr<::arrow::ArrayData> data) = 0;
+  // See ColumnReader::memory_usage
+  virtual int64_t memory_usage() = 0;
   virtual Status GetDefLevels(const int16_t** data, size_t* length) = 0;
   virtual Status GetRepLevels(const int16_t** data, size_t* length) = 0;
   virtual const std::shared_ptr<Field> field() = 0;
@@ -267,14 +500,24 @@ class ColumnReader::ColumnReaderImpl {
 // Reader implementation for primitive arrays
 class PARQUET_NO_EXPORT PrimitiveImpl : public ColumnReader::ColumnReaderImpl {
  public:
-  PrimitiveImpl(MemoryPool* pool, std::unique_ptr<FileColumnIterator> input)
+  PrimitiveImpl(MemoryPool* pool, std::unique_ptr<FileColumnIterator> input,
+                bool read_dictionary = false)
       : pool_(pool), input_(std::move(input)), descr_(input_->descr()) {
-    record_reader_ = RecordReader::Make(descr_, pool_);
+    // Indices are only passed through for flat top-level columns, the nested
+    // readers build their types from the schema
+    read_dictionary = read_dictionary && descr_->physical_type() == Type::BYTE_ARRAY &&
+                      descr_->max_repetition_level() == 0 &&
+                      descr_->schema_node()->parent() == input_->schema()->group_node();
+    record_reader_ = RecordReader::Make(descr_, pool_, read_dictionary);
     DCHECK(NodeToField(*input_->descr()->schema_node(), &field_).ok());
     NextRowGroup();
   }
 
   Status NextBatch(int64_t records_to_read, std::shared_ptr<Array>* out) override;
+  Status NextBatchInto(int64_t records_to_read, const ColumnBatchBuffers& buffers,
+                       std::shared_ptr<Array>* out) override;
+  void RecycleBuffers(std::shared_ptr<::arrow::ArrayData> data) override;
+  int64_t memory_usage() override { return record_reader_->memory_usage(); }
 
   template <typename ParquetType>
   Status WrapIntoListArray(std::shared_ptr<Array>* array);
@@ -284,9 +527,23 @@ class PARQUET_NO_EXPORT PrimitiveImpl : public ColumnReader::ColumnReaderImpl {
 
   const std::shared_ptr<Field> field() override { return field_; }
 
+  // Share the decoded dictionary with the readers of other page ranges of
+  // the column chunk
+  void set_shared_dictionary(std::shared_ptr<SharedDictionary> dictionary) {
+    record_reader_->set_shared_dictionary(std::move(dictionary));
+  }
+
+  // Skip the next num_records records, without decoding their values where
+  // the encoding allows it
+  Status SkipRecords(int64_t num_records, int64_t* records_skipped);
+
  private:
   void NextRowGroup();
 
+  // Decodes into buffers if it is not nullptr
+  Status ReadBatch(int64_t records_to_read, const ColumnBatchBuffers* buffers,
+                   std::shared_ptr<Array>* out);
+
   MemoryPool* pool_;
   std::unique_ptr<FileColumnIterator> input_;
   const ColumnDescriptor* descr_;
@@ -309,6 +566,12 @@ class PARQUET_NO_EXPORT StructImpl : public ColumnReader::ColumnReaderImpl {
   }
 
   Status NextBatch(int64_t records_to_read, std::shared_ptr<Array>* out) override;
+  Status NextBatchInto(int64_t records_to_read, const ColumnBatchBuffers& buffers,
+                       std::shared_ptr<Array>* out) override {
+    return Status::NotImplemented("Struct columns cannot be read into caller buffers");
+  }
+  void RecycleBuffers(std::shared_ptr<::arrow::ArrayData> data) override;
+  int64_t memory_usage() override;
   Status GetDefLevels(const int16_t** data, size_t* length) override;
   Status GetRepLevels(const int16_t** data, size_t* length) override;
   const std::shared_ptr<Field> field() override { return field_; }
@@ -325,22 +588,179 @@ class PARQUET_NO_EXPORT StructImpl : public ColumnReader::ColumnReaderImpl {
                  const std::vector<std::shared_ptr<ColumnReaderImpl>>& children);
 };
 
-FileReader::FileReader(MemoryPool* pool, std::unique_ptr<ParquetFileReader> reader)
-    : impl_(new FileReader::Impl(pool, std::move(reader))) {}
+ArrowReaderProperties default_arrow_reader_properties() {
+  static ArrowReaderProperties default_properties;
+  return default_properties;
+}
+
+FileReader::FileReader(MemoryPool* pool, std::unique_ptr<ParquetFileReader> reader,
+                       const ArrowReaderProperties& properties)
+    : impl_(new FileReader::Impl(pool, std::move(reader), properties)) {}
 
 FileReader::~FileReader() {}
 
+// Columns read as dictionary only know their type after reading, as the
+// dictionary is part of it
+static std::shared_ptr<Field> FieldForArray(const std::shared_ptr<Field>& field,
+                                            const std::shared_ptr<Array>& array) {
+  if (array->type()->Equals(*field->type())) {
+    return field;
+  }
+  return std::make_shared<Field>(field->name(), array->type(), field->nullable(),
+                                 field->metadata());
+}
+
+static std::shared_ptr<::arrow::Schema> SchemaForColumns(
+    const std::shared_ptr<::arrow::Schema>& schema,
+    const std::vector<std::shared_ptr<Column>>& columns) {
+  std::vector<std::shared_ptr<Field>> fields;
+  for (const auto& column : columns) {
+    fields.push_back(column->field());
+  }
+  return ::arrow::schema(fields, schema->metadata());
+}
+
+// Reads batches of batch_size rows through the readers of the fields, which
+// move on to the following row group as needed. If prefetch is set the next
+// batch is read on the thread pool while the current one is consumed
+class ColumnBatchRecordBatchReader : public ::arrow::RecordBatchReader {
+ public:
+  ColumnBatchRecordBatchReader(std::vector<std::unique_ptr<ColumnReader>> readers,
+                               std::shared_ptr<::arrow::Schema> schema, int64_t num_rows,
+                               int64_t batch_size, ThreadPool* thread_pool, bool prefetch)
+      : readers_(std::move(readers)),
+        schema_(std::move(schema)),
+        rows_remaining_(num_rows),
+        batch_size_(batch_size),
+        thread_pool_(thread_pool),
+        prefetch_(prefetch && thread_pool != nullptr) {}
+
+  ~ColumnBatchRecordBatchReader() {
+    // A read that is still running uses the readers
+    if (next_batch_.valid()) {
+      next_batch_.wait();
+    }
+  }
+
+  std::shared_ptr<::arrow::Schema> schema() const override { return schema_; }
+
+  Status ReadNext(std::shared_ptr<::arrow::RecordBatch>* out) override {
+    DecodedBatch batch = next_batch_.valid() ? next_batch_.get() : ReadBatch();
+    RETURN_NOT_OK(batch.status);
+    *out = batch.batch;
+    if (prefetch_ && rows_remaining_ > 0) {
+      auto promise = std::make_shared<std::promise<DecodedBatch>>();
+      next_batch_ = promise->get_future();
+      thread_pool_->Spawn([promise, this]() { promise->set_value(ReadBatch()); });
+    }
+    return Status::OK();
+  }
+
+ private:
+  struct DecodedBatch {
+    Status status;
+    std::shared_ptr<::arrow::RecordBatch> batch;
+  };
+
+  DecodedBatch ReadBatch() {
+    DecodedBatch result;
+    if (rows_remaining_ == 0) {
+      return result;
+    }
+    const int64_t num_rows = std::min(batch_size_, rows_remaining_);
+    std::vector<std::shared_ptr<Field>> fields;
+    std::vector<std::shared_ptr<Array>> arrays;
+    try {
+      for (size_t i = 0; i < readers_.size(); ++i) {
+        std::shared_ptr<Array> array;
+        result.status = readers_[i]->NextBatch(num_rows, &array);
+        if (!result.status.ok()) {
+          return result;
+        }
+        if (array == nullptr || array->length() != num_rows) {
+          result.status = Status::IOError("Column ended before the row group did");
+          return result;
+        }
+        fields.push_back(FieldForArray(schema_->field(static_cast<int>(i)), array));
+        arrays.push_back(array);
+      }
+    } catch (const ::parquet::ParquetException& e) {
+      result.status = Status::IOError(e.what());
+      return result;
+    }
+    rows_remaining_ -= num_rows;
+    result.batch = ::arrow::RecordBatch::Make(
+        ::arrow::schema(fields, schema_->metadata()), num_rows, arrays);
+    return result;
+  }
+
+  std::vector<std::unique_ptr<ColumnReader>> readers_;
+  std::shared_ptr<::arrow::Schema> schema_;
+  int64_t rows_remaining_;
+  const int64_t batch_size_;
+  ThreadPool* thread_pool_;
+  const bool prefetch_;
+  std::future<DecodedBatch> next_batch_;
+};
+
+Status FileReader::Impl::GetRecordBatchReader(
+    const std::vector<int>& row_groups, const std::vector<int>& indices,
+    const std::shared_ptr<::arrow::Schema>& schema, bool prefetch,
+    std::shared_ptr<RecordBatchReader>* out) {
+  std::vector<int> field_indices;
+  if (!ColumnIndicesToFieldIndices(*reader_->metadata()->schema(), indices,
+                                   &field_indices)) {
+    return Status::Invalid("Invalid column index");
+  }
+
+  int64_t num_rows = 0;
+  for (int i : row_groups) {
+    num_rows += reader_->metadata()->RowGroup(i)->num_rows();
+  }
+
+  std::vector<std::unique_ptr<ColumnReader>> readers;
+  if (num_rows > 0) {
+    const Node* root = reader_->metadata()->schema()->group_node();
+    for (int i : field_indices) {
+      std::unique_ptr<ColumnReader::ColumnReaderImpl> reader_impl;
+      RETURN_NOT_OK(GetReaderForNode(i, root->field(i).get(), indices, row_groups, 1,
+                                     &reader_impl));
+      if (reader_impl == nullptr) {
+        return Status::NotImplemented("Field cannot be read in batches");
+      }
+      readers.emplace_back(new ColumnReader(std::move(reader_impl)));
+    }
+  }
+
+  *out = std::make_shared<ColumnBatchRecordBatchReader>(
+      std::move(readers), schema, num_rows, properties_.batch_size(), thread_pool(),
+      prefetch);
+  return Status::OK();
+}
+
 Status FileReader::Impl::GetColumn(int i, std::unique_ptr<ColumnReader>* out) {
   std::unique_ptr<FileColumnIterator> input(new AllRowGroupsIterator(i, reader_.get()));
 
   std::unique_ptr<ColumnReader::ColumnReaderImpl> impl(
-      new PrimitiveImpl(pool_, std::move(input)));
+      new PrimitiveImpl(pool_, std::move(input), properties_.read_dictionary(i)));
+  *out = std::unique_ptr<ColumnReader>(new ColumnReader(std::move(impl)));
+  return Status::OK();
+}
+
+Status FileReader::Impl::GetColumn(int i, const std::vector<int>& row_groups,
+                                   std::unique_ptr<ColumnReader>* out) {
+  std::unique_ptr<FileColumnIterator> input(
+      new SelectedRowGroupsIterator(i, row_groups, reader_.get()));
+
+  std::unique_ptr<ColumnReader::ColumnReaderImpl> impl(
+      new PrimitiveImpl(pool_, std::move(input), properties_.read_dictionary(i)));
   *out = std::unique_ptr<ColumnReader>(new ColumnReader(std::move(impl)));
   return Status::OK();
 }
 
 Status FileReader::Impl::GetReaderForNode(
-    int index, const Node* node, const std::vector<int>& indices, int16_t def_level,
+    int index, const Node* node, const std::vector<int>& indices,
+    const std::vector<int>& row_groups, int16_t def_level,
     std::unique_ptr<ColumnReader::ColumnReaderImpl>* out) {
   *out = nullptr;
 
@@ -352,7 +772,7 @@ Status FileReader::Impl::GetReaderForNode(
       // TODO(itaiin): Remove the -1 index hack when all types of nested reads
       // are supported. This currently just signals the lower level reader resolution
       // to abort
-      RETURN_NOT_OK(GetReaderForNode(index, group->field(i).get(), indices,
+      RETURN_NOT_OK(GetReaderForNode(index, group->field(i).get(), indices, row_groups,
                                      static_cast<int16_t>(def_level + 1), &child_reader));
       if (child_reader != nullptr) {
         children.push_back(std::move(child_reader));
@@ -381,7 +801,7 @@ Status FileReader::Impl::GetReaderForNode(
     // Otherwise *out keeps the nullptr value.
     if (std::find(indices.begin(), indices.end(), column_index) != indices.end()) {
       std::unique_ptr<ColumnReader> reader;
-      RETURN_NOT_OK(GetColumn(column_index, &reader));
+      RETURN_NOT_OK(GetColumn(column_index, row_groups, &reader));
       *out = std::move(reader->impl_);
     }
   }
@@ -401,12 +821,22 @@ Status FileReader::Impl::ReadSchemaField(int i, std::shared_ptr<Array>* out) {
 
 Status FileReader::Impl::ReadSchemaField(int i, const std::vector<int>& indices,
                                          std::shared_ptr<Array>* out) {
+  std::vector<int> row_groups(reader_->metadata()->num_row_groups());
+  for (size_t j = 0; j < row_groups.size(); ++j) {
+    row_groups[j] = static_cast<int>(j);
+  }
+  return ReadSchemaField(i, indices, row_groups, out);
+}
+
+Status FileReader::Impl::ReadSchemaField(int i, const std::vector<int>& indices,
+                                         const std::vector<int>& row_groups,
+                                         std::shared_ptr<Array>* out) {
   auto parquet_schema = reader_->metadata()->schema();
 
   auto node = parquet_schema->group_node()->field(i).get();
   std::unique_ptr<ColumnReader::ColumnReaderImpl> reader_impl;
 
-  RETURN_NOT_OK(GetReaderForNode(i, node, indices, 1, &reader_impl));
+  RETURN_NOT_OK(GetReaderForNode(i, node, indices, row_groups, 1, &reader_impl));
   if (reader_impl == nullptr) {
     *out = nullptr;
     return Status::OK();
@@ -419,7 +849,7 @@ Status FileReader::Impl::ReadSchemaField(int i, const std::vector<int>& indices,
   int64_t records_to_read = 0;
 
   const FileMetaData& metadata = *reader_->metadata();
-  for (int j = 0; j < metadata.num_row_groups(); j++) {
+  for (int j : row_groups) {
     records_to_read += metadata.RowGroup(j)->ColumnChunk(i)->num_values();
   }
 
@@ -453,8 +883,8 @@ Status FileReader::Impl::ReadColumnChunk(int column_index, int row_group_index,
   std::unique_ptr<FileColumnIterator> input(
       new SingleRowGroupIterator(column_index, row_group_index, reader_.get()));
 
-  std::unique_ptr<ColumnReader::ColumnReaderImpl> impl(
-      new PrimitiveImpl(pool_, std::move(input)));
+  std::unique_ptr<ColumnReader::ColumnReaderImpl> impl(new PrimitiveImpl(
+      pool_, std::move(input), properties_.read_dictionary(column_index)));
   ColumnReader flat_column_reader(std::move(impl));
 
   std::shared_ptr<Array> array;
@@ -477,12 +907,14 @@ Status FileReader::Impl::ReadRowGroup(int row_group_index,
 
   // TODO(wesm): Refactor to share more code with ReadTable
 
+  PARQUET_CATCH_NOT_OK(reader_->PreBuffer({row_group_index}, indices));
+
   auto ReadColumnFunc = [&indices, &row_group_index, &schema, &columns, this](int i) {
     int column_index = indices[i];
 
     std::shared_ptr<Array> array;
     RETURN_NOT_OK(ReadColumnChunk(column_index, row_group_index, &array));
-    columns[i] = std::make_shared<Column>(schema->field(i), array);
+    columns[i] = std::make_shared<Column>(FieldForArray(schema->field(i), array), array);
     return Status::OK();
   };
 
@@ -491,45 +923,477 @@ Status FileReader::Impl::ReadRowGroup(int row_group_index,
       RETURN_NOT_OK(ReadColumnFunc(i));
     }
   } else {
-    RETURN_NOT_OK(ParallelFor(nthreads, num_columns, ReadColumnFunc));
+    std::vector<int64_t> costs(num_columns);
+    for (int i = 0; i < num_columns; i++) {
+      costs[i] = ColumnChunkCost(indices[i], row_group_index);
+    }
+    RETURN_NOT_OK(
+        ParallelForLargestFirst(thread_pool(), nthreads, costs, ReadColumnFunc));
   }
 
-  *out = Table::Make(schema, columns);
+  *out = Table::Make(SchemaForColumns(schema, columns), columns);
   return Status::OK();
 }
 
-Status FileReader::Impl::ReadTable(const std::vector<int>& indices,
-                                   std::shared_ptr<Table>* out) {
+Status FileReader::Impl::MakeEmptyArray(const std::shared_ptr<Field>& field,
+                                        std::shared_ptr<Array>* out) {
+  std::unique_ptr<::arrow::ArrayBuilder> builder;
+  RETURN_NOT_OK(::arrow::MakeBuilder(pool_, field->type(), &builder));
+  return builder->Finish(out);
+}
+
+bool FileReader::Impl::ReadsDictionary(int field_index,
+                                       const std::vector<int>& indices) {
+  const SchemaDescriptor* parquet_schema = reader_->metadata()->schema();
+  const Node* node = parquet_schema->group_node()->field(field_index).get();
+  for (int column_index : indices) {
+    if (properties_.read_dictionary(column_index) &&
+        parquet_schema->GetColumnRoot(column_index) == node) {
+      return true;
+    }
+  }
+  return false;
+}
+
+int64_t FileReader::Impl::ColumnChunkCost(int column_index, int row_group_index) {
+  auto column_chunk =
+      reader_->metadata()->RowGroup(row_group_index)->ColumnChunk(column_index);
+  int64_t decompression_factor;
+  switch (column_chunk->compression()) {
+    case Compression::UNCOMPRESSED:
+      decompression_factor = 0;
+      break;
+    case Compression::SNAPPY:
+    case Compression::LZO:
+    case Compression::LZ4:
+      decompression_factor = 1;
+      break;
+    default:
+      decompression_factor = 3;
+      break;
+  }
+  return column_chunk->total_uncompressed_size() +
+         decompression_factor * column_chunk->total_compressed_size();
+}
+
+int64_t FileReader::Impl::RowsCost(int column_index, int row_group_index,
+                                   const RowRange& rows) {
+  const int64_t num_rows = reader_->metadata()->RowGroup(row_group_index)->num_rows();
+  if (num_rows == 0) {
+    return 0;
+  }
+  return static_cast<int64_t>(
+      static_cast<double>(ColumnChunkCost(column_index, row_group_index)) *
+      static_cast<double>(rows.end - rows.begin) / static_cast<double>(num_rows));
+}
+
+int64_t FileReader::Impl::ReadCost(int field_index, const std::vector<int>& indices,
+                                   const std::vector<int>& row_groups) {
+  const SchemaDescriptor* parquet_schema = reader_->metadata()->schema();
+  const Node* node = parquet_schema->group_node()->field(field_index).get();
+  int64_t cost = 0;
+  for (int column_index : indices) {
+    if (parquet_schema->GetColumnRoot(column_index) != node) {
+      continue;
+    }
+    for (int row_group_index : row_groups) {
+      cost += ColumnChunkCost(column_index, row_group_index);
+    }
+  }
+  return cost;
+}
+
+int FileReader::Impl::SplitColumn(int field_index, const std::vector<int>& indices,
+                                  const std::vector<int>& row_groups) {
+  const SchemaDescriptor* parquet_schema = reader_->metadata()->schema();
+  const Node* node = parquet_schema->group_node()->field(field_index).get();
+  if (!node->is_primitive() || node->is_repeated() ||
+      ReadsDictionary(field_index, indices)) {
+    return -1;
+  }
+  const int column_index = parquet_schema->ColumnIndex(*node);
+  for (int i : row_groups) {
+    auto rg_metadata = reader_->metadata()->RowGroup(i);
+    if (!rg_metadata->ColumnChunk(column_index)->has_offset_index()) {
+      return -1;
+    }
+  }
+  return column_index;
+}
+
+Status FileReader::Impl::PageRanges(int column_index, int row_group_index,
+                                    std::vector<RowRange>* out) {
+  out->clear();
+  auto row_group = reader_->RowGroup(row_group_index);
+  std::unique_ptr<OffsetIndex> offset_index;
+  PARQUET_CATCH_NOT_OK(offset_index = row_group->GetOffsetIndex(column_index));
+  if (offset_index == nullptr || offset_index->num_pages() <= 1) {
+    return Status::OK();
+  }
+  const std::vector<PageLocation>& pages = offset_index->page_locations();
+  const int num_pages = offset_index->num_pages();
+  const int num_ranges = std::min(num_threads_, num_pages);
+  const int64_t num_rows = row_group->metadata()->num_rows();
+  for (int i = 0; i < num_ranges; ++i) {
+    const int64_t begin = pages[i * num_pages / num_ranges].first_row_index;
+    const int64_t end = i + 1 < num_ranges
+                            ? pages[(i + 1) * num_pages / num_ranges].first_row_index
+                            : num_rows;
+    if (begin < end) {
+      out->push_back({begin, end});
+    }
+  }
+  if (out->size() <= 1) {
+    out->clear();
+  }
+  return Status::OK();
+}
+
+Status FileReader::Impl::ReadPageRange(
+    int column_index, int row_group_index, const RowRange& rows,
+    const std::shared_ptr<SharedDictionary>& dictionary, std::shared_ptr<Array>* out) {
+  std::unique_ptr<FileColumnIterator> input(
+      new PageRangeIterator(column_index, row_group_index, rows, reader_.get()));
+  std::unique_ptr<PrimitiveImpl> impl;
+  PARQUET_CATCH_NOT_OK(impl.reset(new PrimitiveImpl(
+      pool_, std::move(input), properties_.read_dictionary(column_index))));
+  impl->set_shared_dictionary(dictionary);
+  ColumnReader reader(std::move(impl));
+  return reader.NextBatch(rows.end - rows.begin, out);
+}
+
+Status FileReader::Impl::ReadRows(const std::vector<RowRange>& ranges,
+                                  const std::vector<int>& indices,
+                                  std::shared_ptr<Table>* out) {
   std::shared_ptr<::arrow::Schema> schema;
   RETURN_NOT_OK(GetSchema(indices, &schema));
 
-  // We only need to read schema fields which have columns indicated
-  // in the indices vector
   std::vector<int> field_indices;
   if (!ColumnIndicesToFieldIndices(*reader_->metadata()->schema(), indices,
                                    &field_indices)) {
     return Status::Invalid("Invalid column index");
   }
+  const SchemaDescriptor* parquet_schema = reader_->metadata()->schema();
+  const int num_fields = static_cast<int>(field_indices.size());
+  std::vector<int> column_indices(num_fields);
+  for (int i = 0; i < num_fields; ++i) {
+    const Node* node = parquet_schema->group_node()->field(field_indices[i]).get();
+    if (!node->is_primitive() || node->is_repeated() ||
+        ReadsDictionary(field_indices[i], indices)) {
+      return Status::NotImplemented(
+          "Reading rows of nested, repeated or dictionary columns");
+    }
+    column_indices[i] = parquet_schema->ColumnIndex(*node);
+  }
 
-  std::vector<std::shared_ptr<Column>> columns(field_indices.size());
-  auto ReadColumnFunc = [&indices, &field_indices, &schema, &columns, this](int i) {
-    std::shared_ptr<Array> array;
-    RETURN_NOT_OK(ReadSchemaField(field_indices[i], indices, &array));
-    columns[i] = std::make_shared<Column>(schema->field(i), array);
+  std::vector<RowGroupRows> rows;
+  RETURN_NOT_OK(SplitRowRanges(ranges, &rows));
+
+  std::vector<std::shared_ptr<Column>> columns(num_fields);
+  auto ReadColumnFunc = [&column_indices, &rows, &schema, &columns, this](int i) {
+    ::arrow::ArrayVector chunks;
+    RETURN_NOT_OK(ReadRowGroupRows(column_indices[i], rows, &chunks));
+    if (chunks.empty()) {
+      std::shared_ptr<Array> array;
+      RETURN_NOT_OK(MakeEmptyArray(schema->field(i), &array));
+      chunks.push_back(array);
+    }
+    columns[i] =
+        std::make_shared<Column>(FieldForArray(schema->field(i), chunks[0]), chunks);
     return Status::OK();
   };
 
-  int num_fields = static_cast<int>(field_indices.size());
   int nthreads = std::min<int>(num_threads_, num_fields);
-  if (nthreads == 1) {
+  if (nthreads <= 1) {
     for (int i = 0; i < num_fields; i++) {
       RETURN_NOT_OK(ReadColumnFunc(i));
     }
   } else {
-    RETURN_NOT_OK(ParallelFor(nthreads, num_fields, ReadColumnFunc));
+    std::vector<int64_t> costs(num_fields, 0);
+    for (int i = 0; i < num_fields; i++) {
+      for (const RowGroupRows& row_group_rows : rows) {
+        costs[i] +=
+            RowsCost(column_indices[i], row_group_rows.row_group, row_group_rows.rows);
+      }
+    }
+    RETURN_NOT_OK(
+        ParallelForLargestFirst(thread_pool(), nthreads, costs, ReadColumnFunc));
   }
 
-  std::shared_ptr<Table> table = Table::Make(schema, columns);
+  std::shared_ptr<Table> table = Table::Make(SchemaForColumns(schema, columns), columns);
+  RETURN_NOT_OK(table->Validate());
+  *out = table;
+  return Status::OK();
+}
+
+Status FileReader::Impl::SplitRowRanges(const std::vector<RowRange>& ranges,
+                                        std::vector<RowGroupRows>* out) {
+  out->clear();
+  const FileMetaData& metadata = *reader_->metadata();
+  std::vector<int64_t> row_group_rows(metadata.num_row_groups());
+  int64_t num_rows = 0;
+  for (int i = 0; i < metadata.num_row_groups(); ++i) {
+    row_group_rows[i] = metadata.RowGroup(i)->num_rows();
+    num_rows += row_group_rows[i];
+  }
+
+  int row_group = 0;
+  // First row of row_group in the file
+  int64_t row_group_begin = 0;
+  int64_t previous_end = 0;
+  for (const RowRange& range : ranges) {
+    if (range.begin < previous_end || range.end < range.begin) {
+      return Status::Invalid("Row ranges must be sorted and must not overlap");
+    }
+    if (range.end > num_rows) {
+      return Status::Invalid("Row range exceeds the rows of the file");
+    }
+    previous_end = range.end;
+    int64_t begin = range.begin;
+    while (begin < range.end) {
+      while (begin >= row_group_begin + row_group_rows[row_group]) {
+        row_group_begin += row_group_rows[row_group];
+        ++row_group;
+      }
+      const int64_t end =
+          std::min(range.end, row_group_begin + row_group_rows[row_group]);
+      out->push_back({row_group, {begin - row_group_begin, end - row_group_begin}});
+      begin = end;
+    }
+  }
+  return Status::OK();
+}
+
+Status FileReader::Impl::ReadRowGroupRows(int column_index,
+                                          const std::vector<RowGroupRows>& rows,
+                                          ::arrow::ArrayVector* out) {
+  size_t begin = 0;
+  while (begin < rows.size()) {
+    const int row_group = rows[begin].row_group;
+    std::unique_ptr<OffsetIndex> offset_index;
+    PARQUET_CATCH_NOT_OK(offset_index =
+                             reader_->RowGroup(row_group)->GetOffsetIndex(column_index));
+    size_t end = begin + 1;
+    if (offset_index == nullptr || offset_index->num_pages() == 0) {
+      // The whole column chunk is read either way
+      while (end < rows.size() && rows[end].row_group == row_group) {
+        ++end;
+      }
+    } else {
+      // Rows in the same or the next page as the previous ones do not add a
+      // gap to the data that is read
+      int last_page = std::max(offset_index->FindPage(rows[begin].rows.end - 1), 0);
+      while (end < rows.size() && rows[end].row_group == row_group &&
+             offset_index->FindPage(rows[end].rows.begin) <= last_page + 1) {
+        last_page = std::max(offset_index->FindPage(rows[end].rows.end - 1), last_page);
+        ++end;
+      }
+    }
+    RETURN_NOT_OK(ReadContiguousRows(column_index, rows, begin, end, out));
+    begin = end;
+  }
+  return Status::OK();
+}
+
+Status FileReader::Impl::ReadContiguousRows(int column_index,
+                                            const std::vector<RowGroupRows>& rows,
+                                            size_t begin, size_t end,
+                                            ::arrow::ArrayVector* out) {
+  const RowRange range = {rows[begin].rows.begin, rows[end - 1].rows.end};
+  auto iterator =
+      new RowRangeIterator(column_index, rows[begin].row_group, range, reader_.get());
+  std::unique_ptr<FileColumnIterator> input(iterator);
+  std::unique_ptr<PrimitiveImpl> impl;
+  PARQUET_CATCH_NOT_OK(impl.reset(new PrimitiveImpl(pool_, std::move(input))));
+
+  // The constructor opened the page reader
+  int64_t row = iterator->first_row_index();
+  for (size_t i = begin; i < end; ++i) {
+    const RowRange& rows_to_read = rows[i].rows;
+    int64_t records_skipped;
+    RETURN_NOT_OK(impl->SkipRecords(rows_to_read.begin - row, &records_skipped));
+    if (records_skipped != rows_to_read.begin - row) {
+      return Status::IOError("Column chunk ended before the rows to read");
+    }
+    std::shared_ptr<Array> array;
+    RETURN_NOT_OK(impl->NextBatch(rows_to_read.end - rows_to_read.begin, &array));
+    if (array == nullptr || array->length() != rows_to_read.end - rows_to_read.begin) {
+      return Status::IOError("Column chunk ended before the rows to read");
+    }
+    out->push_back(array);
+    row = rows_to_read.end;
+  }
+  return Status::OK();
+}
+
+Status FileReader::Impl::ReadRowGroupChunks(
+    const std::vector<int>& indices, const std::vector<int>& field_indices,
+    const std::vector<int>& split_columns, const std::vector<int>& row_groups,
+    const std::shared_ptr<::arrow::Schema>& schema,
+    std::vector<std::shared_ptr<Column>>* columns) {
+  // A task reads the row groups [begin, end) of a field, or only the rows of
+  // a page range of the row group begin. The dictionaries of DictionaryArrays
+  // are part of their type, so the chunks of a column read as dictionaries
+  // could not be put together and it is read as one task.
+  struct Task {
+    int field;
+    size_t begin;
+    size_t end;
+    bool page_range;
+    RowRange rows;
+    std::shared_ptr<SharedDictionary> dictionary;
+  };
+  const int num_fields = static_cast<int>(field_indices.size());
+  std::vector<Task> tasks;
+  std::vector<size_t> first_task(num_fields);
+  std::vector<RowRange> ranges;
+  for (int i = 0; i < num_fields; ++i) {
+    first_task[i] = tasks.size();
+    if (ReadsDictionary(field_indices[i], indices)) {
+      tasks.push_back({i, 0, row_groups.size(), false, {0, 0}, nullptr});
+      continue;
+    }
+    for (size_t j = 0; j < row_groups.size(); ++j) {
+      if (split_columns[i] >= 0) {
+        RETURN_NOT_OK(PageRanges(split_columns[i], row_groups[j], &ranges));
+      } else {
+        ranges.clear();
+      }
+      if (ranges.empty()) {
+        tasks.push_back({i, j, j + 1, false, {0, 0}, nullptr});
+        continue;
+      }
+      auto dictionary = std::make_shared<SharedDictionary>();
+      for (const RowRange& rows : ranges) {
+        tasks.push_back({i, j, j + 1, true, rows, dictionary});
+      }
+    }
+  }
+
+  std::vector<std::shared_ptr<Array>> chunks(tasks.size());
+  auto ReadChunkFunc = [&indices, &field_indices, &split_columns, &row_groups, &tasks,
+                        &chunks, this](int i) {
+    const Task& task = tasks[i];
+    if (task.page_range) {
+      return ReadPageRange(split_columns[task.field], row_groups[task.begin], task.rows,
+                           task.dictionary, &chunks[i]);
+    }
+    std::vector<int> task_row_groups(row_groups.begin() + task.begin,
+                                     row_groups.begin() + task.end);
+    return ReadSchemaField(field_indices[task.field], indices, task_row_groups,
+                           &chunks[i]);
+  };
+  const int num_tasks = static_cast<int>(tasks.size());
+  std::vector<int64_t> costs(num_tasks);
+  for (int i = 0; i < num_tasks; ++i) {
+    const Task& task = tasks[i];
+    if (task.page_range) {
+      costs[i] = RowsCost(split_columns[task.field], row_groups[task.begin], task.rows);
+    } else {
+      std::vector<int> task_row_groups(row_groups.begin() + task.begin,
+                                       row_groups.begin() + task.end);
+      costs[i] = ReadCost(field_indices[task.field], indices, task_row_groups);
+    }
+  }
+  RETURN_NOT_OK(ParallelForLargestFirst(thread_pool(), std::min(num_threads_, num_tasks),
+                                        costs, ReadChunkFunc));
+
+  // Assemble the chunks of every column in row and row group order
+  for (int i = 0; i < num_fields; ++i) {
+    const size_t end = i + 1 < num_fields ? first_task[i + 1] : tasks.size();
+    ::arrow::ArrayVector field_chunks;
+    for (size_t j = first_task[i]; j < end; ++j) {
+      if (chunks[j] != nullptr) {
+        field_chunks.push_back(chunks[j]);
+      }
+    }
+    if (field_chunks.empty()) {
+      std::shared_ptr<Array> array;
+      RETURN_NOT_OK(MakeEmptyArray(schema->field(i), &array));
+      field_chunks.push_back(array);
+    }
+    (*columns)[i] = std::make_shared<Column>(
+        FieldForArray(schema->field(i), field_chunks[0]), field_chunks);
+  }
+  return Status::OK();
+}
+
+Status FileReader::Impl::ReadTable(const std::vector<int>& indices,
+                                   std::shared_ptr<Table>* out) {
+  std::shared_ptr<::arrow::Schema> schema;
+  RETURN_NOT_OK(GetSchema(indices, &schema));
+
+  // We only need to read schema fields which have columns indicated
+  // in the indices vector
+  std::vector<int> field_indices;
+  if (!ColumnIndicesToFieldIndices(*reader_->metadata()->schema(), indices,
+                                   &field_indices)) {
+    return Status::Invalid("Invalid column index");
+  }
+
+  std::vector<int> all_row_groups(reader_->metadata()->num_row_groups());
+  for (size_t i = 0; i < all_row_groups.size(); ++i) {
+    all_row_groups[i] = static_cast<int>(i);
+  }
+  std::vector<int> row_groups;
+  RETURN_NOT_OK(FilterRowGroups(all_row_groups, &row_groups));
+
+  int num_fields = static_cast<int>(field_indices.size());
+  std::vector<int> split_columns(num_fields, -1);
+  bool split_pages = false;
+  if (properties_.parallelize_pages() && num_threads_ > 1) {
+    for (int i = 0; i < num_fields; ++i) {
+      split_columns[i] = SplitColumn(field_indices[i], indices, row_groups);
+      split_pages = split_pages || split_columns[i] >= 0;
+    }
+  }
+
+  // The page ranges are read on their own rather than from the whole chunks
+  std::vector<int> buffered_indices;
+  for (int column_index : indices) {
+    if (std::find(split_columns.begin(), split_columns.end(), column_index) ==
+        split_columns.end()) {
+      buffered_indices.push_back(column_index);
+    }
+  }
+  PARQUET_CATCH_NOT_OK(reader_->PreBuffer(row_groups, buffered_indices));
+
+  std::vector<std::shared_ptr<Column>> columns(num_fields);
+
+  if (split_pages || (properties_.parallelize_row_groups() && num_threads_ > 1 &&
+                      row_groups.size() > 1)) {
+    RETURN_NOT_OK(ReadRowGroupChunks(indices, field_indices, split_columns, row_groups,
+                                     schema, &columns));
+  } else {
+    auto ReadColumnFunc = [&indices, &row_groups, &field_indices, &schema, &columns,
+                           this](int i) {
+      std::shared_ptr<Array> array;
+      RETURN_NOT_OK(ReadSchemaField(field_indices[i], indices, row_groups, &array));
+      if (array == nullptr) {
+        // No row group left to read from
+        RETURN_NOT_OK(MakeEmptyArray(schema->field(i), &array));
+      }
+      columns[i] =
+          std::make_shared<Column>(FieldForArray(schema->field(i), array), array);
+      return Status::OK();
+    };
+
+    int nthreads = std::min<int>(num_threads_, num_fields);
+    if (nthreads == 1) {
+      for (int i = 0; i < num_fields; i++) {
+        RETURN_NOT_OK(ReadColumnFunc(i));
+      }
+    } else {
+      std::vector<int64_t> costs(num_fields);
+      for (int i = 0; i < num_fields; i++) {
+        costs[i] = ReadCost(field_indices[i], indices, row_groups);
+      }
+      RETURN_NOT_OK(
+          ParallelForLargestFirst(thread_pool(), nthreads, costs, ReadColumnFunc));
+    }
+  }
+
+  std::shared_ptr<Table> table = Table::Make(SchemaForColumns(schema, columns), columns);
   RETURN_NOT_OK(table->Validate());
   *out = table;
   return Status::OK();
@@ -544,6 +1408,25 @@ Status FileReader::Impl::ReadTable(std::shared_ptr<Table>* table) {
   return ReadTable(indices, table);
 }
 
+Status FileReader::Impl::FilterRowGroups(const std::vector<int>& row_groups,
+                                         std::vector<int>* out) {
+  const std::shared_ptr<Predicate>& filter = properties_.filter();
+  if (filter == nullptr) {
+    *out = row_groups;
+    return Status::OK();
+  }
+
+  out->clear();
+  for (int i : row_groups) {
+    bool can_match = true;
+    PARQUET_CATCH_NOT_OK(can_match = filter->CanMatch(*reader_->metadata()->RowGroup(i)));
+    if (can_match) {
+      out->push_back(i);
+    }
+  }
+  return Status::OK();
+}
+
 Status FileReader::Impl::ReadRowGroup(int i, std::shared_ptr<Table>* table) {
   std::vector<int> indices(reader_->metadata()->num_columns());
 
@@ -557,15 +1440,24 @@ Status FileReader::Impl::ReadRowGroup(int i, std::shared_ptr<Table>* table) {
 Status OpenFile(const std::shared_ptr<::arrow::io::ReadableFileInterface>& file,
                 MemoryPool* allocator, const ReaderProperties& props,
                 const std::shared_ptr<FileMetaData>& metadata,
+                const ArrowReaderProperties& arrow_props,
                 std::unique_ptr<FileReader>* reader) {
   std::unique_ptr<RandomAccessSource> io_wrapper(new ArrowInputFile(file));
   std::unique_ptr<ParquetReader> pq_reader;
   PARQUET_CATCH_NOT_OK(pq_reader =
                            ParquetReader::Open(std::move(io_wrapper), props, metadata));
-  reader->reset(new FileReader(allocator, std::move(pq_reader)));
+  reader->reset(new FileReader(allocator, std::move(pq_reader), arrow_props));
   return Status::OK();
 }
 
+Status OpenFile(const std::shared_ptr<::arrow::io::ReadableFileInterface>& file,
+                MemoryPool* allocator, const ReaderProperties& props,
+                const std::shared_ptr<FileMetaData>& metadata,
+                std::unique_ptr<FileReader>* reader) {
+  return OpenFile(file, allocator, props, metadata, default_arrow_reader_properties(),
+                  reader);
+}
+
 Status OpenFile(const std::shared_ptr<::arrow::io::ReadableFileInterface>& file,
                 MemoryPool* allocator, std::unique_ptr<FileReader>* reader) {
   return OpenFile(file, allocator, ::parquet::default_reader_properties(), nullptr,
@@ -611,6 +1503,13 @@ Status FileReader::GetRecordBatchReader(const std::vector<int>& row_group_indice
 Status FileReader::GetRecordBatchReader(const std::vector<int>& row_group_indices,
                                         const std::vector<int>& column_indices,
                                         std::shared_ptr<RecordBatchReader>* out) {
+  return GetRecordBatchReader(row_group_indices, column_indices, 0, out);
+}
+
+Status FileReader::GetRecordBatchReader(const std::vector<int>& row_group_indices,
+                                        const std::vector<int>& column_indices,
+                                        int prefetch_depth,
+                                        std::shared_ptr<RecordBatchReader>* out) {
   // column indicies check
   std::shared_ptr<::arrow::Schema> schema;
   RETURN_NOT_OK(GetSchema(column_indices, &schema));
@@ -626,8 +1525,17 @@ Status FileReader::GetRecordBatchReader(const std::vector<int>& row_group_indice
     }
   }
 
-  *out = std::make_shared<RowGroupRecordBatchReader>(row_group_indices, column_indices,
-                                                     schema, this);
+  std::vector<int> selected_row_groups;
+  RETURN_NOT_OK(impl_->FilterRowGroups(row_group_indices, &selected_row_groups));
+
+  if (impl_->batch_size() > 0) {
+    return impl_->GetRecordBatchReader(selected_row_groups, column_indices, schema,
+                                       prefetch_depth > 0, out);
+  }
+
+  *out = std::make_shared<RowGroupRecordBatchReader>(selected_row_groups, column_indices,
+                                                     schema, this, impl_->thread_pool(),
+                                                     prefetch_depth);
   return Status::OK();
 }
 
@@ -648,6 +1556,59 @@ Status FileReader::ReadTable(const std::vector<int>& indices,
   }
 }
 
+Status FileReader::GetColumnIndices(const std::vector<std::string>& column_paths,
+                                    std::vector<int>* column_indices) {
+  const SchemaDescriptor* schema = impl_->parquet_reader()->metadata()->schema();
+  std::vector<std::string> leaf_paths(schema->num_columns());
+  for (int i = 0; i < schema->num_columns(); ++i) {
+    leaf_paths[i] = schema->Column(i)->path()->ToDotString();
+  }
+
+  std::vector<int> result;
+  for (const std::string& path : column_paths) {
+    const std::string prefix = path + ".";
+    bool found = false;
+    for (int i = 0; i < schema->num_columns(); ++i) {
+      const std::string& leaf_path = leaf_paths[i];
+      if (leaf_path == path || leaf_path.compare(0, prefix.size(), prefix) == 0) {
+        if (std::find(result.begin(), result.end(), i) == result.end()) {
+          result.push_back(i);
+        }
+        found = true;
+      }
+    }
+    if (!found) {
+      return Status::Invalid("No column at path " + path);
+    }
+  }
+  *column_indices = std::move(result);
+  return Status::OK();
+}
+
+Status FileReader::ReadRows(const std::vector<RowRange>& ranges,
+                            const std::vector<int>& column_indices,
+                            std::shared_ptr<Table>* out) {
+  try {
+    return impl_->ReadRows(ranges, column_indices, out);
+  } catch (const ::parquet::ParquetException& e) {
+    return ::arrow::Status::IOError(e.what());
+  }
+}
+
+Status FileReader::TakeRows(const std::vector<int64_t>& rows,
+                            const std::vector<int>& column_indices,
+                            std::shared_ptr<Table>* out) {
+  std::vector<RowRange> ranges;
+  for (int64_t row : rows) {
+    if (!ranges.empty() && ranges.back().end == row) {
+      ++ranges.back().end;
+    } else {
+      ranges.push_back({row, row + 1});
+    }
+  }
+  return ReadRows(ranges, column_indices, out);
+}
+
 Status FileReader::ReadRowGroup(int i, std::shared_ptr<Table>* out) {
   try {
     return impl_->ReadRowGroup(i, out);
@@ -674,6 +1635,10 @@ int FileReader::num_row_groups() const { return impl_->num_row_groups(); }
 
 void FileReader::set_num_threads(int num_threads) { impl_->set_num_threads(num_threads); }
 
+void FileReader::set_thread_pool(const std::shared_ptr<ThreadPool>& pool) {
+  impl_->set_thread_pool(pool);
+}
+
 Status FileReader::ScanContents(std::vector<int> columns, const int32_t column_batch_size,
                                 int64_t* num_rows) {
   try {
@@ -684,6 +1649,17 @@ Status FileReader::ScanContents(std::vector<int> columns, const int32_t column_b
   }
 }
 
+Status FileReader::ComputeAggregates(const std::vector<int>& column_indices,
+                                     FileAggregates* out) {
+  try {
+    *out = impl_->reader()->ComputeAggregates(column_indices,
+                                              impl_->properties().filter());
+    return Status::OK();
+  } catch (const ::parquet::ParquetException& e) {
+    return Status::IOError(e.what());
+  }
+}
+
 const ParquetFileReader* FileReader::parquet_reader() const {
   return impl_->parquet_reader();
 }
@@ -703,8 +1679,6 @@ Status PrimitiveImpl::WrapIntoListArray(std::shared_ptr<Array>* array) {
   if (descr_->max_repetition_level() > 0) {
     // Walk downwards to extract nullability
     std::vector<bool> nullable;
-    std::vector<std::shared_ptr<::arrow::Int32Builder>> offset_builders;
-    std::vector<std::shared_ptr<::arrow::BooleanBuilder>> valid_bits_builders;
     nullable.push_back(current_field->nullable());
     while (current_field->type()->num_children() > 0) {
       if (current_field->type()->num_children() > 1) {
@@ -717,14 +1691,11 @@ Status PrimitiveImpl::WrapIntoListArray(std::shared_ptr<Array>* array) {
         }
         current_field = current_field->type()->child(0);
       }
-      offset_builders.emplace_back(
-          std::make_shared<::arrow::Int32Builder>(::arrow::int32(), pool_));
-      valid_bits_builders.emplace_back(
-          std::make_shared<::arrow::BooleanBuilder>(::arrow::boolean(), pool_));
       nullable.push_back(current_field->nullable());
     }
 
-    int64_t list_depth = offset_builders.size();
+    const int list_depth = static_cast<int>(nullable.size()) - 1;
+    DCHECK_EQ(list_depth, descr_->max_repetition_level());
     // This describes the minimal definition that describes a level that
     // reflects a value in the primitive values array.
     int16_t values_def_level = descr_->max_definition_level();
@@ -733,10 +1704,12 @@ Status PrimitiveImpl::WrapIntoListArray(std::shared_ptr<Array>* array) {
     }
 
     // The definition levels that are needed so that a list is declared
-    // as empty and not null.
+    // as empty and not null, and those that declare it null.
     std::vector<int16_t> empty_def_level(list_depth);
+    std::vector<int16_t> null_def_level(list_depth);
     int def_level = 0;
     for (int i = 0; i < list_depth; i++) {
+      null_def_level[i] = nullable[i] ? static_cast<int16_t>(def_level) : -1;
       if (nullable[i]) {
         def_level++;
       }
@@ -744,55 +1717,32 @@ Status PrimitiveImpl::WrapIntoListArray(std::shared_ptr<Array>* array) {
       def_level++;
     }
 
-    int32_t values_offset = 0;
-    std::vector<int64_t> null_counts(list_depth, 0);
-    for (int64_t i = 0; i < total_levels_read; i++) {
-      int16_t rep_level = rep_levels[i];
-      if (rep_level < descr_->max_repetition_level()) {
-        for (int64_t j = rep_level; j < list_depth; j++) {
-          if (j == (list_depth - 1)) {
-            RETURN_NOT_OK(offset_builders[j]->Append(values_offset));
-          } else {
-            RETURN_NOT_OK(offset_builders[j]->Append(
-                static_cast<int32_t>(offset_builders[j + 1]->length())));
-          }
-
-          if (((empty_def_level[j] - 1) == def_levels[i]) && (nullable[j])) {
-            RETURN_NOT_OK(valid_bits_builders[j]->Append(false));
-            null_counts[j]++;
-            break;
-          } else {
-            RETURN_NOT_OK(valid_bits_builders[j]->Append(true));
-            if (empty_def_level[j] == def_levels[i]) {
-              break;
-            }
-          }
-        }
-      }
-      if (def_levels[i] >= values_def_level) {
-        values_offset++;
-      }
-    }
-    // Add the final offset to all lists
-    for (int64_t j = 0; j < list_depth; j++) {
-      if (j == (list_depth - 1)) {
-        RETURN_NOT_OK(offset_builders[j]->Append(values_offset));
-      } else {
-        RETURN_NOT_OK(offset_builders[j]->Append(
-            static_cast<int32_t>(offset_builders[j + 1]->length())));
-      }
+    // Every level starts at most one list per depth, so the offsets and
+    // validity bitmaps are allocated for all of them and trimmed afterwards
+    std::vector<std::shared_ptr<PoolBuffer>> offsets;
+    std::vector<std::shared_ptr<PoolBuffer>> valid_bits;
+    std::vector<int32_t*> offsets_data;
+    std::vector<uint8_t*> valid_bits_data;
+    for (int j = 0; j < list_depth; j++) {
+      offsets.push_back(std::make_shared<PoolBuffer>(pool_));
+      RETURN_NOT_OK(offsets[j]->Resize((total_levels_read + 1) * sizeof(int32_t)));
+      offsets_data.push_back(reinterpret_cast<int32_t*>(offsets[j]->mutable_data()));
+      valid_bits.push_back(std::make_shared<PoolBuffer>(pool_));
+      RETURN_NOT_OK(valid_bits[j]->Resize(BytesForBits(total_levels_read)));
+      memset(valid_bits[j]->mutable_data(), 0, valid_bits[j]->size());
+      valid_bits_data.push_back(valid_bits[j]->mutable_data());
     }
 
-    std::vector<std::shared_ptr<Buffer>> offsets;
-    std::vector<std::shared_ptr<Buffer>> valid_bits;
-    std::vector<int64_t> list_lengths;
-    for (int64_t j = 0; j < list_depth; j++) {
-      list_lengths.push_back(offset_builders[j]->length() - 1);
-      std::shared_ptr<Array> array;
-      RETURN_NOT_OK(offset_builders[j]->Finish(&array));
-      offsets.emplace_back(std::static_pointer_cast<Int32Array>(array)->values());
-      RETURN_NOT_OK(valid_bits_builders[j]->Finish(&array));
-      valid_bits.emplace_back(std::static_pointer_cast<BooleanArray>(array)->values());
+    std::vector<int64_t> list_lengths(list_depth, 0);
+    std::vector<int64_t> null_counts(list_depth, 0);
+    ::parquet::internal::LevelsToListOffsets(
+        def_levels, rep_levels, total_levels_read, list_depth, empty_def_level.data(),
+        null_def_level.data(), values_def_level, offsets_data.data(),
+        valid_bits_data.data(), list_lengths.data(), null_counts.data());
+
+    for (int j = 0; j < list_depth; j++) {
+      RETURN_NOT_OK(offsets[j]->Resize((list_lengths[j] + 1) * sizeof(int32_t)));
+      RETURN_NOT_OK(valid_bits[j]->Resize(BytesForBits(list_lengths[j])));
     }
 
     std::shared_ptr<Array> output(*array);
@@ -849,7 +1799,7 @@ struct TransferFunctor {
     std::copy(values, values + length, out_ptr);
 
     if (reader->nullable_values()) {
-      std::shared_ptr<PoolBuffer> is_valid = reader->ReleaseIsValid();
+      std::shared_ptr<ResizableBuffer> is_valid = reader->ReleaseIsValid();
       *out = std::make_shared<ArrayType<ArrowType>>(type, length, data, is_valid,
                                                     reader->null_count());
     } else {
@@ -866,10 +1816,10 @@ struct TransferFunctor<ArrowType, ParquetType,
                     const std::shared_ptr<::arrow::DataType>& type,
                     std::shared_ptr<Array>* out) {
     int64_t length = reader->values_written();
-    std::shared_ptr<PoolBuffer> values = reader->ReleaseValues();
+    std::shared_ptr<Buffer> values = reader->ReleaseValues();
 
     if (reader->nullable_values()) {
-      std::shared_ptr<PoolBuffer> is_valid = reader->ReleaseIsValid();
+      std::shared_ptr<ResizableBuffer> is_valid = reader->ReleaseIsValid();
       *out = std::make_shared<ArrayType<ArrowType>>(type, length, values, is_valid,
                                                     reader->null_count());
     } else {
@@ -885,24 +1835,11 @@ struct TransferFunctor<::arrow::BooleanType, BooleanType> {
                     const std::shared_ptr<::arrow::DataType>& type,
                     std::shared_ptr<Array>* out) {
     int64_t length = reader->values_written();
-    std::shared_ptr<Buffer> data;
-
-    const int64_t buffer_size = BytesForBits(length);
-    RETURN_NOT_OK(::arrow::AllocateBuffer(pool, buffer_size, &data));
-
-    // Transfer boolean values to packed bitmap
-    auto values = reinterpret_cast<const bool*>(reader->values());
-    uint8_t* data_ptr = data->mutable_data();
-    memset(data_ptr, 0, buffer_size);
-
-    for (int64_t i = 0; i < length; i++) {
-      if (values[i]) {
-        ::arrow::BitUtil::SetBit(data_ptr, i);
-      }
-    }
+    // The record reader decodes boolean values into a packed bitmap already
+    std::shared_ptr<Buffer> data = reader->ReleaseValues();
 
     if (reader->nullable_values()) {
-      std::shared_ptr<PoolBuffer> is_valid = reader->ReleaseIsValid();
+      std::shared_ptr<ResizableBuffer> is_valid = reader->ReleaseIsValid();
       RETURN_NOT_OK(is_valid->Resize(BytesForBits(length), false));
       *out = std::make_shared<BooleanArray>(type, length, data, is_valid,
                                             reader->null_count());
@@ -925,12 +1862,10 @@ struct TransferFunctor<::arrow::TimestampType, Int96Type> {
     RETURN_NOT_OK(::arrow::AllocateBuffer(pool, length * sizeof(int64_t), &data));
 
     auto data_ptr = reinterpret_cast<int64_t*>(data->mutable_data());
-    for (int64_t i = 0; i < length; i++) {
-      *data_ptr++ = impala_timestamp_to_nanoseconds(values[i]);
-    }
+    ::parquet::internal::Int96ToNanoseconds(values, length, data_ptr);
 
     if (reader->nullable_values()) {
-      std::shared_ptr<PoolBuffer> is_valid = reader->ReleaseIsValid();
+      std::shared_ptr<ResizableBuffer> is_valid = reader->ReleaseIsValid();
       *out = std::make_shared<TimestampArray>(type, length, data, is_valid,
                                               reader->null_count());
     } else {
@@ -952,13 +1887,10 @@ struct TransferFunctor<::arrow::Date64Type, Int32Type> {
     std::shared_ptr<Buffer> data;
     RETURN_NOT_OK(::arrow::AllocateBuffer(pool, length * sizeof(int64_t), &data));
     auto out_ptr = reinterpret_cast<int64_t*>(data->mutable_data());
-
-    for (int64_t i = 0; i < length; i++) {
-      *out_ptr++ = static_cast<int64_t>(values[i]) * kMillisecondsInADay;
-    }
+    ::parquet::internal::DaysToMilliseconds(values, length, out_ptr);
 
     if (reader->nullable_values()) {
-      std::shared_ptr<PoolBuffer> is_valid = reader->ReleaseIsValid();
+      std::shared_ptr<ResizableBuffer> is_valid = reader->ReleaseIsValid();
       *out = std::make_shared<::arrow::Date64Array>(type, length, data, is_valid,
                                                     reader->null_count());
     } else {
@@ -968,127 +1900,166 @@ struct TransferFunctor<::arrow::Date64Type, Int32Type> {
   }
 };
 
-template <typename ArrowType, typename ParquetType>
-struct TransferFunctor<
-    ArrowType, ParquetType,
-    typename std::enable_if<std::is_same<ParquetType, ByteArrayType>::value ||
-                            std::is_same<ParquetType, FLBAType>::value>::type> {
+// Convert from BINARY type to STRING
+static void BinaryToString(const std::shared_ptr<::arrow::DataType>& type,
+                           std::shared_ptr<Array>* out) {
+  if (type->id() == ::arrow::Type::STRING) {
+    auto new_data = (*out)->data()->Copy();
+    new_data->type = type;
+    *out = ::arrow::MakeArray(new_data);
+  }
+}
+
+// Wrap the decoded dictionary indices and the dictionary into a DictionaryArray
+static Status TransferDictionary(RecordReader* reader,
+                                 const std::shared_ptr<::arrow::DataType>& value_type,
+                                 std::shared_ptr<Array>* out) {
+  std::shared_ptr<Array> dictionary;
+  PARQUET_CATCH_NOT_OK(dictionary = reader->ReleaseDictionary());
+  BinaryToString(value_type, &dictionary);
+
+  int64_t length = reader->values_written();
+  std::shared_ptr<Buffer> indices_data = reader->ReleaseValues();
+  std::shared_ptr<Array> indices;
+  if (reader->nullable_values()) {
+    std::shared_ptr<ResizableBuffer> is_valid = reader->ReleaseIsValid();
+    indices = std::make_shared<Int32Array>(length, indices_data, is_valid,
+                                           reader->null_count());
+  } else {
+    indices = std::make_shared<Int32Array>(length, indices_data);
+  }
+
+  auto type = ::arrow::dictionary(::arrow::int32(), dictionary);
+  *out = std::make_shared<::arrow::DictionaryArray>(type, indices);
+  return Status::OK();
+}
+
+// Wrap the offsets and data of the decoded BYTE_ARRAY values into a BinaryArray
+static Status TransferBinary(RecordReader* reader, MemoryPool* pool,
+                             const std::shared_ptr<::arrow::DataType>& type,
+                             std::shared_ptr<Array>* out) {
+  int64_t length = reader->values_written();
+  std::shared_ptr<Buffer> offsets = reader->ReleaseValues();
+  std::shared_ptr<ResizableBuffer> data;
+  PARQUET_CATCH_NOT_OK(data = reader->ReleaseBinaryData());
+  if (length == 0) {
+    // The leading offset is only written together with the first value
+    RETURN_NOT_OK(::arrow::AllocateBuffer(pool, sizeof(int32_t), &offsets));
+    *reinterpret_cast<int32_t*>(offsets->mutable_data()) = 0;
+  }
+
+  if (reader->nullable_values()) {
+    std::shared_ptr<ResizableBuffer> is_valid = reader->ReleaseIsValid();
+    *out = std::make_shared<::arrow::BinaryArray>(length, offsets, data, is_valid,
+                                                  reader->null_count());
+  } else {
+    *out = std::make_shared<::arrow::BinaryArray>(length, offsets, data);
+  }
+  BinaryToString(type, out);
+  return Status::OK();
+}
+
+static Status TransferFixedSizeBinary(RecordReader* reader,
+                                      const std::shared_ptr<::arrow::DataType>& type,
+                                      std::shared_ptr<Array>* out) {
+  int64_t length = reader->values_written();
+  std::shared_ptr<Buffer> data = reader->ReleaseValues();
+  if (reader->nullable_values()) {
+    std::shared_ptr<ResizableBuffer> is_valid = reader->ReleaseIsValid();
+    *out = std::make_shared<::arrow::FixedSizeBinaryArray>(type, length, data, is_valid,
+                                                           reader->null_count());
+  } else {
+    *out = std::make_shared<::arrow::FixedSizeBinaryArray>(type, length, data);
+  }
+  return Status::OK();
+}
+
+template <typename ArrowType>
+struct TransferFunctor<ArrowType, ByteArrayType> {
   Status operator()(RecordReader* reader, MemoryPool* pool,
                     const std::shared_ptr<::arrow::DataType>& type,
                     std::shared_ptr<Array>* out) {
-    RETURN_NOT_OK(reader->builder()->Finish(out));
-
-    if (type->id() == ::arrow::Type::STRING) {
-      // Convert from BINARY type to STRING
-      auto new_data = (*out)->data()->Copy();
-      new_data->type = type;
-      *out = ::arrow::MakeArray(new_data);
+    if (reader->read_dictionary()) {
+      return TransferDictionary(reader, type, out);
     }
-    return Status::OK();
+    return TransferBinary(reader, pool, type, out);
   }
 };
 
-static uint64_t BytesToInteger(const uint8_t* bytes, int32_t start, int32_t stop) {
-  using ::arrow::BitUtil::FromBigEndian;
-
-  const int32_t length = stop - start;
-
-  DCHECK_GE(length, 0);
-  DCHECK_LE(length, 8);
-
-  switch (length) {
-    case 0:
-      return 0;
-    case 1:
-      return bytes[start];
-    case 2:
-      return FromBigEndian(*reinterpret_cast<const uint16_t*>(bytes + start));
-    case 3: {
-      const uint64_t first_two_bytes =
-          FromBigEndian(*reinterpret_cast<const uint16_t*>(bytes + start));
-      const uint64_t last_byte = bytes[stop - 1];
-      return first_two_bytes << 8 | last_byte;
-    }
-    case 4:
-      return FromBigEndian(*reinterpret_cast<const uint32_t*>(bytes + start));
-    case 5: {
-      const uint64_t first_four_bytes =
-          FromBigEndian(*reinterpret_cast<const uint32_t*>(bytes + start));
-      const uint64_t last_byte = bytes[stop - 1];
-      return first_four_bytes << 8 | last_byte;
-    }
-    case 6: {
-      const uint64_t first_four_bytes =
-          FromBigEndian(*reinterpret_cast<const uint32_t*>(bytes + start));
-      const uint64_t last_two_bytes =
-          FromBigEndian(*reinterpret_cast<const uint16_t*>(bytes + start + 4));
-      return first_four_bytes << 16 | last_two_bytes;
-    }
-    case 7: {
-      const uint64_t first_four_bytes =
-          FromBigEndian(*reinterpret_cast<const uint32_t*>(bytes + start));
-      const uint64_t second_two_bytes =
-          FromBigEndian(*reinterpret_cast<const uint16_t*>(bytes + start + 4));
-      const uint64_t last_byte = bytes[stop - 1];
-      return first_four_bytes << 24 | second_two_bytes << 8 | last_byte;
-    }
-    case 8:
-      return FromBigEndian(*reinterpret_cast<const uint64_t*>(bytes + start));
-    default: {
-      DCHECK(false);
-      return UINT64_MAX;
-    }
+template <typename ArrowType>
+struct TransferFunctor<ArrowType, FLBAType> {
+  Status operator()(RecordReader* reader, MemoryPool* pool,
+                    const std::shared_ptr<::arrow::DataType>& type,
+                    std::shared_ptr<Array>* out) {
+    return TransferFixedSizeBinary(reader, type, out);
   }
-}
+};
 
 static constexpr int32_t kMinDecimalBytes = 1;
 static constexpr int32_t kMaxDecimalBytes = 16;
 
-/// \brief Convert a sequence of big-endian bytes to one int64_t (high bits) and one
-/// uint64_t (low bits).
-static void BytesToIntegerPair(const uint8_t* bytes,
-                               const int32_t total_number_of_bytes_used, int64_t* high,
-                               uint64_t* low) {
-  DCHECK_GE(total_number_of_bytes_used, kMinDecimalBytes);
-  DCHECK_LE(total_number_of_bytes_used, kMaxDecimalBytes);
-
-  /// Bytes are coming in big-endian, so the first byte is the MSB and therefore holds the
-  /// sign bit.
-  const bool is_negative = static_cast<int8_t>(bytes[0]) < 0;
-
-  /// Sign extend the low bits if necessary
-  *low = UINT64_MAX * (is_negative && total_number_of_bytes_used < 8);
-  *high = -1 * (is_negative && total_number_of_bytes_used < kMaxDecimalBytes);
-
-  /// Stop byte of the high bytes
-  const int32_t high_bits_offset = std::max(0, total_number_of_bytes_used - 8);
-
-  /// Shift left enough bits to make room for the incoming int64_t
-  *high <<= high_bits_offset * CHAR_BIT;
-
-  /// Preserve the upper bits by inplace OR-ing the int64_t
-  *high |= BytesToInteger(bytes, 0, high_bits_offset);
-
-  /// Stop byte of the low bytes
-  const int32_t low_bits_offset = std::min(total_number_of_bytes_used, 8);
-
-  /// Shift left enough bits to make room for the incoming uint64_t
-  *low <<= low_bits_offset * CHAR_BIT;
-
-  /// Preserve the upper bits by inplace OR-ing the uint64_t
-  *low |= BytesToInteger(bytes, high_bits_offset, total_number_of_bytes_used);
+/// \brief Sign extend the kNumBytes big-endian bytes at bytes to an int64_t
+template <int32_t kNumBytes>
+static inline int64_t LoadBigEndianSigned(const uint8_t* bytes) {
+  static_assert(kNumBytes >= 1 && kNumBytes <= 8, "kNumBytes must be in [1, 8]");
+  // The bytes end up the most significant ones, the arithmetic shift drags the
+  // sign bit down
+  uint64_t raw = 0;
+  memcpy(&raw, bytes, kNumBytes);
+  return static_cast<int64_t>(::arrow::BitUtil::FromBigEndian(raw)) >>
+         (64 - kNumBytes * CHAR_BIT);
 }
 
-static inline void RawBytesToDecimalBytes(const uint8_t* value, int32_t byte_width,
-                                          uint8_t* out_buf) {
-  // view the first 8 bytes as an unsigned 64-bit integer
-  auto low = reinterpret_cast<uint64_t*>(out_buf);
-
-  // view the second 8 bytes as a signed 64-bit integer
-  auto high = reinterpret_cast<int64_t*>(out_buf + sizeof(uint64_t));
+/// \brief Convert num_values big-endian two's complement integers of kByteWidth
+/// bytes to the little-endian Decimal128 layout, the low uint64_t then the high
+/// int64_t of each value.
+template <int32_t kByteWidth>
+static void BigEndianToDecimal128(const uint8_t* values, int64_t num_values,
+                                  uint8_t* out) {
+  static_assert(kByteWidth >= kMinDecimalBytes && kByteWidth <= kMaxDecimalBytes,
+                "Unsupported decimal byte width");
+  constexpr int32_t kHighBytes = kByteWidth > 8 ? kByteWidth - 8 : 1;
+  for (int64_t i = 0; i < num_values; ++i, values += kByteWidth, out += 16) {
+    int64_t high;
+    uint64_t low;
+    if (kByteWidth <= 8) {
+      const int64_t value = LoadBigEndianSigned<kByteWidth <= 8 ? kByteWidth : 8>(values);
+      low = static_cast<uint64_t>(value);
+      high = value >> 63;
+    } else {
+      high = LoadBigEndianSigned<kHighBytes>(values);
+      memcpy(&low, values + kHighBytes, sizeof(uint64_t));
+      low = ::arrow::BitUtil::FromBigEndian(low);
+    }
+    memcpy(out, &low, sizeof(uint64_t));
+    memcpy(out + sizeof(uint64_t), &high, sizeof(int64_t));
+  }
+}
 
-  // Convert the fixed size binary array bytes into a Decimal128 compatible layout
-  BytesToIntegerPair(value, byte_width, high, low);
+using DecimalConversion = void (*)(const uint8_t*, int64_t, uint8_t*);
+
+static DecimalConversion GetBigEndianToDecimal128(int32_t byte_width) {
+  static const DecimalConversion kConversions[] = {
+      nullptr,
+      BigEndianToDecimal128<1>,
+      BigEndianToDecimal128<2>,
+      BigEndianToDecimal128<3>,
+      BigEndianToDecimal128<4>,
+      BigEndianToDecimal128<5>,
+      BigEndianToDecimal128<6>,
+      BigEndianToDecimal128<7>,
+      BigEndianToDecimal128<8>,
+      BigEndianToDecimal128<9>,
+      BigEndianToDecimal128<10>,
+      BigEndianToDecimal128<11>,
+      BigEndianToDecimal128<12>,
+      BigEndianToDecimal128<13>,
+      BigEndianToDecimal128<14>,
+      BigEndianToDecimal128<15>,
+      BigEndianToDecimal128<16>};
+  DCHECK_GE(byte_width, kMinDecimalBytes);
+  DCHECK_LE(byte_width, kMaxDecimalBytes);
+  return kConversions[byte_width];
 }
 
 /// \brief Convert an array of FixedLenByteArrays to an arrow::Decimal128Array
@@ -1104,9 +2075,10 @@ struct TransferFunctor<::arrow::Decimal128Type, FLBAType> {
                     std::shared_ptr<Array>* out) {
     DCHECK_EQ(type->id(), ::arrow::Type::DECIMAL);
 
-    // Finish the built data into a temporary array
+    // Wrap the decoded bytes into a temporary array
     std::shared_ptr<Array> array;
-    RETURN_NOT_OK(reader->builder()->Finish(&array));
+    RETURN_NOT_OK(TransferFixedSizeBinary(
+        reader, ::arrow::fixed_size_binary(reader->descr()->type_length()), &array));
     const auto& fixed_size_binary_array =
         static_cast<const ::arrow::FixedSizeBinaryArray&>(*array);
 
@@ -1117,9 +2089,16 @@ struct TransferFunctor<::arrow::Decimal128Type, FLBAType> {
         static_cast<const ::arrow::FixedSizeBinaryType&>(*fixed_size_binary_array.type())
             .byte_width();
 
+    if (byte_width < kMinDecimalBytes || byte_width > kMaxDecimalBytes) {
+      std::stringstream ss;
+      ss << "Decimals of " << byte_width << " bytes are not supported";
+      return Status::NotImplemented(ss.str());
+    }
+
     // The byte width of each decimal value
     const int32_t type_length =
         static_cast<const ::arrow::Decimal128Type&>(*type).byte_width();
+    DCHECK_EQ(type_length, 16);
 
     // number of elements in the entire array
     const int64_t length = fixed_size_binary_array.length();
@@ -1128,22 +2107,12 @@ struct TransferFunctor<::arrow::Decimal128Type, FLBAType> {
     std::shared_ptr<Buffer> data;
     RETURN_NOT_OK(::arrow::AllocateBuffer(pool, length * type_length, &data));
 
-    // raw bytes that we can write to
-    uint8_t* out_ptr = data->mutable_data();
-
-    // convert each FixedSizeBinary value to valid decimal bytes
+    // Convert all the slots, the ones of nulls hold some bytes as well, which saves
+    // branching on the validity of each value
     const int64_t null_count = fixed_size_binary_array.null_count();
-    if (null_count > 0) {
-      for (int64_t i = 0; i < length; ++i, out_ptr += type_length) {
-        if (!fixed_size_binary_array.IsNull(i)) {
-          RawBytesToDecimalBytes(fixed_size_binary_array.GetValue(i), byte_width,
-                                 out_ptr);
-        }
-      }
-    } else {
-      for (int64_t i = 0; i < length; ++i, out_ptr += type_length) {
-        RawBytesToDecimalBytes(fixed_size_binary_array.GetValue(i), byte_width, out_ptr);
-      }
+    if (length > 0) {
+      GetBigEndianToDecimal128(byte_width)(fixed_size_binary_array.GetValue(0), length,
+                                           data->mutable_data());
     }
 
     *out = std::make_shared<::arrow::Decimal128Array>(
@@ -1197,7 +2166,7 @@ static Status DecimalIntegerTransfer(RecordReader* reader, MemoryPool* pool,
   }
 
   if (reader->nullable_values()) {
-    std::shared_ptr<PoolBuffer> is_valid = reader->ReleaseIsValid();
+    std::shared_ptr<ResizableBuffer> is_valid = reader->ReleaseIsValid();
     *out = std::make_shared<::arrow::Decimal128Array>(type, length, data, is_valid,
                                                       reader->null_count());
   } else {
@@ -1234,7 +2203,58 @@ struct TransferFunctor<::arrow::Decimal128Type, Int64Type> {
     TRANSFER_DATA(ArrowType, ParquetType);          \
   } break;
 
+// True if the values of columns of the type are handed off in the buffers that
+// they are decoded into, rather than converted into new ones
+static bool DecodesInPlace(const ::arrow::DataType& type) {
+  switch (type.id()) {
+    case ::arrow::Type::BOOL:
+    case ::arrow::Type::INT32:
+    case ::arrow::Type::INT64:
+    case ::arrow::Type::FLOAT:
+    case ::arrow::Type::DOUBLE:
+    case ::arrow::Type::STRING:
+    case ::arrow::Type::BINARY:
+    case ::arrow::Type::DATE32:
+    case ::arrow::Type::TIME32:
+    case ::arrow::Type::TIME64:
+    case ::arrow::Type::FIXED_SIZE_BINARY:
+      return true;
+    case ::arrow::Type::TIMESTAMP:
+      // Nanoseconds are converted from INT96
+      return static_cast<const ::arrow::TimestampType&>(type).unit() !=
+             ::arrow::TimeUnit::NANO;
+    default:
+      return false;
+  }
+}
+
 Status PrimitiveImpl::NextBatch(int64_t records_to_read, std::shared_ptr<Array>* out) {
+  return ReadBatch(records_to_read, nullptr, out);
+}
+
+Status PrimitiveImpl::NextBatchInto(int64_t records_to_read,
+                                    const ColumnBatchBuffers& buffers,
+                                    std::shared_ptr<Array>* out) {
+  if (!DecodesInPlace(*field_->type())) {
+    return Status::NotImplemented("Columns of type " + field_->type()->ToString() +
+                                  " cannot be read into caller buffers");
+  }
+  if (!buffers.values) {
+    return Status::Invalid("A values buffer is required");
+  }
+  if (record_reader_->nullable_values() && !buffers.is_valid) {
+    return Status::Invalid("A validity buffer is required for nullable values");
+  }
+  if (descr_->physical_type() == Type::BYTE_ARRAY && !record_reader_->read_dictionary() &&
+      !buffers.data) {
+    return Status::Invalid("A data buffer is required for BYTE_ARRAY values");
+  }
+  return ReadBatch(records_to_read, &buffers, out);
+}
+
+Status PrimitiveImpl::ReadBatch(int64_t records_to_read,
+                                const ColumnBatchBuffers* buffers,
+                                std::shared_ptr<Array>* out) {
   if (!record_reader_->HasMoreData()) {
     // Exhausted all row groups.
     *out = nullptr;
@@ -1247,10 +2267,14 @@ Status PrimitiveImpl::NextBatch(int64_t records_to_read, std::shared_ptr<Array>*
   }
 
   try {
-    // Pre-allocation gives much better performance for flat columns
+    // Pre-allocation gives much better performance for flat columns. Reset
+    // first so the values of the previous batch are not reserved for again
+    record_reader_->Reset();
+    if (buffers != nullptr) {
+      record_reader_->SetOutputBuffers(buffers->values, buffers->is_valid, buffers->data);
+    }
     record_reader_->Reserve(records_to_read);
 
-    record_reader_->Reset();
     while (records_to_read > 0) {
       if (!record_reader_->HasMoreData()) {
         break;
@@ -1324,6 +2348,37 @@ Status PrimitiveImpl::NextBatch(int64_t records_to_read, std::shared_ptr<Array>*
   return Status::OK();
 }
 
+void PrimitiveImpl::RecycleBuffers(std::shared_ptr<::arrow::ArrayData> data) {
+  if (data.use_count() != 1) {
+    return;
+  }
+  for (auto& buffer : data->buffers) {
+    record_reader_->RecycleBuffer(std::move(buffer));
+  }
+  // The values of list arrays
+  for (auto& child : data->child_data) {
+    RecycleBuffers(std::move(child));
+  }
+}
+
+Status PrimitiveImpl::SkipRecords(int64_t num_records, int64_t* records_skipped) {
+  *records_skipped = 0;
+  try {
+    // Drop the values of the previous batch first
+    record_reader_->Reset();
+    while (*records_skipped < num_records && record_reader_->HasMoreData()) {
+      const int64_t skipped = record_reader_->SkipRecords(num_records - *records_skipped);
+      *records_skipped += skipped;
+      if (skipped == 0) {
+        NextRowGroup();
+      }
+    }
+  } catch (const ::parquet::ParquetException& e) {
+    return ::arrow::Status::IOError(e.what());
+  }
+  return Status::OK();
+}
+
 void PrimitiveImpl::NextRowGroup() {
   std::unique_ptr<PageReader> page_reader = input_->NextChunk();
   record_reader_->SetPageReader(std::move(page_reader));
@@ -1350,15 +2405,33 @@ Status ColumnReader::NextBatch(int64_t records_to_read, std::shared_ptr<Array>*
   return impl_->NextBatch(records_to_read, out);
 }
 
+Status ColumnReader::NextBatchInto(int64_t records_to_read,
+                                   const ColumnBatchBuffers& buffers,
+                                   std::shared_ptr<Array>* out) {
+  return impl_->NextBatchInto(records_to_read, buffers, out);
+}
+
+void ColumnReader::RecycleBuffers(std::shared_ptr<Array> array) {
+  if (array) {
+    std::shared_ptr<::arrow::ArrayData> data = array->data();
+    array.reset();
+    impl_->RecycleBuffers(std::move(data));
+  }
+}
+
+int64_t ColumnReader::memory_usage() { return impl_->memory_usage(); }
+
 // StructImpl methods
 
 Status StructImpl::DefLevelsToNullArray(std::shared_ptr<Buffer>* null_bitmap_out,
                                         int64_t* null_count_out) {
   std::shared_ptr<Buffer> null_bitmap;
   auto null_count = 0;
+  // The levels of any child tell whether the struct is defined, see
+  // GetDefLevels, so they are not combined into the levels of the struct
   const int16_t* def_levels_data;
   size_t def_levels_length;
-  RETURN_NOT_OK(GetDefLevels(&def_levels_data, &def_levels_length));
+  RETURN_NOT_OK(children_[0]->GetDefLevels(&def_levels_data, &def_levels_length));
   RETURN_NOT_OK(GetEmptyBitmap(pool_, def_levels_length, &null_bitmap));
   uint8_t* null_bitmap_ptr = null_bitmap->mutable_data();
   for (size_t i = 0; i < def_levels_length; i++) {
@@ -1366,7 +2439,6 @@ Status StructImpl::DefLevelsToNullArray(std::shared_ptr<Buffer>* null_bitmap_out
       // Mark null
       null_count += 1;
     } else {
-      DCHECK_EQ(def_levels_data[i], struct_def_level_);
       ::arrow::BitUtil::SetBit(null_bitmap_ptr, i);
     }
   }
@@ -1376,8 +2448,6 @@ Status StructImpl::DefLevelsToNullArray(std::shared_ptr<Buffer>* null_bitmap_out
   return Status::OK();
 }
 
-// TODO(itaiin): Consider caching the results of this calculation -
-//   note that this is only used once for each read for now
 Status StructImpl::GetDefLevels(const int16_t** data, size_t* length) {
   *data = nullptr;
   if (children_.size() == 0) {
@@ -1386,34 +2456,34 @@ Status StructImpl::GetDefLevels(const int16_t** data, size_t* length) {
     return Status::OK();
   }
 
-  // We have at least one child
+  // When a struct is defined, all of its children def levels are at least at
+  // nesting level, and def level equals nesting level.
+  // When a struct is not defined, all of its children def levels equal the
+  // level of the ancestor that is not defined, which is less than the
+  // nesting level. All other possibilities are malformed definition data.
+  // The levels of the first child thus are those of the struct, capped at
+  // the nesting level, and the other children, e.g. the siblings of a
+  // projected leaf, are only checked in debug builds.
   const int16_t* child_def_levels;
   size_t child_length;
   RETURN_NOT_OK(children_[0]->GetDefLevels(&child_def_levels, &child_length));
-  auto size = child_length * sizeof(int16_t);
-  RETURN_NOT_OK(def_levels_buffer_.Resize(size));
-  // Initialize with the minimal def level
-  std::memset(def_levels_buffer_.mutable_data(), -1, size);
+  RETURN_NOT_OK(def_levels_buffer_.Resize(child_length * sizeof(int16_t)));
   auto result_levels = reinterpret_cast<int16_t*>(def_levels_buffer_.mutable_data());
+  for (size_t i = 0; i < child_length; i++) {
+    result_levels[i] = std::min(child_def_levels[i], struct_def_level_);
+  }
 
-  // When a struct is defined, all of its children def levels are at least at
-  // nesting level, and def level equals nesting level.
-  // When a struct is not defined, all of its children def levels are less than
-  // the nesting level, and the def level equals max(children def levels)
-  // All other possibilities are malformed definition data.
-  for (auto& child : children_) {
+#ifndef NDEBUG
+  for (size_t j = 1; j < children_.size(); ++j) {
     size_t current_child_length;
-    RETURN_NOT_OK(child->GetDefLevels(&child_def_levels, &current_child_length));
+    RETURN_NOT_OK(children_[j]->GetDefLevels(&child_def_levels, &current_child_length));
     DCHECK_EQ(child_length, current_child_length);
     for (size_t i = 0; i < child_length; i++) {
-      // Check that value is either uninitialized, or current
-      // and previous children def levels agree on the struct level
-      DCHECK((result_levels[i] == -1) || ((result_levels[i] >= struct_def_level_) ==
-                                          (child_def_levels[i] >= struct_def_level_)));
-      result_levels[i] =
-          std::max(result_levels[i], std::min(child_def_levels[i], struct_def_level_));
+      DCHECK_EQ(result_levels[i], std::min(child_def_levels[i], struct_def_level_));
     }
   }
+#endif
+
   *data = reinterpret_cast<const int16_t*>(def_levels_buffer_.data());
   *length = child_length;
   return Status::OK();
@@ -1434,6 +2504,23 @@ Status StructImpl::GetRepLevels(const int16_t** data, size_t* length) {
   return Status::NotImplemented("GetRepLevels is not implemented for struct");
 }
 
+void StructImpl::RecycleBuffers(std::shared_ptr<::arrow::ArrayData> data) {
+  if (data.use_count() != 1 || data->child_data.size() != children_.size()) {
+    return;
+  }
+  for (size_t i = 0; i < children_.size(); ++i) {
+    children_[i]->RecycleBuffers(std::move(data->child_data[i]));
+  }
+}
+
+int64_t StructImpl::memory_usage() {
+  int64_t size = def_levels_buffer_.capacity();
+  for (const auto& child : children_) {
+    size += child->memory_usage();
+  }
+  return size;
+}
+
 Status StructImpl::NextBatch(int64_t records_to_read, std::shared_ptr<Array>* out) {
   std::vector<std::shared_ptr<Array>> children_arrays;
   std::shared_ptr<Buffer> null_bitmap;
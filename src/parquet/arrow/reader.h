@@ -19,6 +19,8 @@
 #define PARQUET_ARROW_READER_H
 
 #include <memory>
+#include <string>
+#include <unordered_set>
 #include <vector>
 
 #include "parquet/api/reader.h"
@@ -37,12 +39,88 @@ class Table;
 
 namespace parquet {
 
+class ThreadPool;
+
 namespace arrow {
 
 class ColumnChunkReader;
 class ColumnReader;
 class RowGroupReader;
 
+// Arrow specific options for reading Parquet files
+class PARQUET_EXPORT ArrowReaderProperties {
+ public:
+  ArrowReaderProperties()
+      : parallelize_row_groups_(false), parallelize_pages_(false), batch_size_(0) {}
+
+  // Read the indicated BYTE_ARRAY column as arrow::DictionaryArray with int32
+  // indices. The column chunks' dictionaries are passed through instead of
+  // materializing every value; values of pages that are not dictionary encoded
+  // are appended to the dictionary. Only flat top-level columns are supported,
+  // the setting is ignored for others.
+  //
+  // As the dictionary is part of the Arrow type, the type of these columns in
+  // the read tables differs from the type reported by GetSchema.
+  void set_read_dictionary(int column_index, bool read_dict) {
+    if (read_dict) {
+      read_dict_indices_.insert(column_index);
+    } else {
+      read_dict_indices_.erase(column_index);
+    }
+  }
+
+  bool read_dictionary(int column_index) const {
+    return read_dict_indices_.count(column_index) > 0;
+  }
+
+  // Skip the row groups whose statistics rule out that any of their rows
+  // satisfies the filter in FileReader::ReadTable and GetRecordBatchReader. The
+  // rows of the remaining row groups are returned unfiltered.
+  void set_filter(const std::shared_ptr<Predicate>& filter) { filter_ = filter; }
+
+  const std::shared_ptr<Predicate>& filter() const { return filter_; }
+
+  // Let FileReader::ReadTable decode every row group of every column as a task
+  // of its own instead of one task per column, so that tables with fewer
+  // columns than threads still keep all of them busy. The columns of the
+  // returned table have a chunk per row group. Columns read as dictionaries
+  // are still decoded as a single task. Off by default
+  void set_parallelize_row_groups(bool parallelize) {
+    parallelize_row_groups_ = parallelize;
+  }
+
+  bool parallelize_row_groups() const { return parallelize_row_groups_; }
+
+  // Let FileReader::ReadTable also split the column chunks into ranges of
+  // their data pages that are decompressed and decoded as tasks of their own,
+  // sharing the chunk's decoded dictionary. Applies to the top-level columns
+  // that are not repeated, not read as dictionaries and have an offset index
+  // in every row group read; the columns get a chunk per page range. Implies
+  // a task per row group as with set_parallelize_row_groups. Off by default
+  void set_parallelize_pages(bool parallelize) { parallelize_pages_ = parallelize; }
+
+  bool parallelize_pages() const { return parallelize_pages_; }
+
+  // If positive, the RecordBatchReaders of FileReader::GetRecordBatchReader
+  // return batches of batch_size rows, the last one holding the remaining
+  // rows. The batches are decoded as they are read and may span row groups,
+  // so that memory use does not depend on the size of the row groups. By
+  // default every row group is read at once and split into batches along
+  // its chunks
+  void set_batch_size(int64_t batch_size) { batch_size_ = batch_size; }
+
+  int64_t batch_size() const { return batch_size_; }
+
+ private:
+  std::unordered_set<int> read_dict_indices_;
+  std::shared_ptr<Predicate> filter_;
+  bool parallelize_row_groups_;
+  bool parallelize_pages_;
+  int64_t batch_size_;
+};
+
+PARQUET_EXPORT ArrowReaderProperties default_arrow_reader_properties();
+
 // Arrow read adapter class for deserializing Parquet files as Arrow row
 // batches.
 //
@@ -101,7 +179,8 @@ class RowGroupReader;
 // arrays
 class PARQUET_EXPORT FileReader {
  public:
-  FileReader(::arrow::MemoryPool* pool, std::unique_ptr<ParquetFileReader> reader);
+  FileReader(::arrow::MemoryPool* pool, std::unique_ptr<ParquetFileReader> reader,
+             const ArrowReaderProperties& properties = default_arrow_reader_properties());
 
   // Since the distribution of columns amongst a Parquet file's row groups may
   // be uneven (the number of values in each column chunk can be different), we
@@ -169,6 +248,18 @@ class PARQUET_EXPORT FileReader {
                                        const std::vector<int>& column_indices,
                                        std::shared_ptr<::arrow::RecordBatchReader>* out);
 
+  /// \brief Return a RecordBatchReader as above that reads the following
+  ///     prefetch_depth row groups in the background while the batches of the
+  ///     current one are consumed. The row groups are read on the thread pool
+  ///     of the reader (see set_thread_pool), each with up to num_threads
+  ///     threads. With ArrowReaderProperties::batch_size the batches are read
+  ///     one after the other, so a positive prefetch_depth reads one batch
+  ///     ahead. The RecordBatchReader must not outlive the FileReader
+  ::arrow::Status GetRecordBatchReader(const std::vector<int>& row_group_indices,
+                                       const std::vector<int>& column_indices,
+                                       int prefetch_depth,
+                                       std::shared_ptr<::arrow::RecordBatchReader>* out);
+
   // Read a table of columns into a Table
   ::arrow::Status ReadTable(std::shared_ptr<::arrow::Table>* out);
 
@@ -177,15 +268,48 @@ class PARQUET_EXPORT FileReader {
   ::arrow::Status ReadTable(const std::vector<int>& column_indices,
                             std::shared_ptr<::arrow::Table>* out);
 
+  // The column indices of the leaves at or below the dot separated paths,
+  // e.g. "a.b.c" for a leaf or "a.b" for all leaves of the struct, to pass
+  // to ReadTable and the other reads. Only the column chunks of these leaves
+  // are read; their structs hold just the projected children and take their
+  // validity from the levels of these leaves.
+  ::arrow::Status GetColumnIndices(const std::vector<std::string>& column_paths,
+                                   std::vector<int>* column_indices);
+
   ::arrow::Status ReadRowGroup(int i, const std::vector<int>& column_indices,
                                std::shared_ptr<::arrow::Table>* out);
 
   ::arrow::Status ReadRowGroup(int i, std::shared_ptr<::arrow::Table>* out);
 
+  /// \brief Read the rows of the sorted, non-overlapping ranges [begin, end)
+  /// of the indicated columns, counting rows across the row groups of the
+  /// file. The ranges are mapped to the row groups and, with an offset index,
+  /// to the data pages that hold them; only those pages are read and the
+  /// rows before a range in its first page are skipped without decoding
+  /// where the encoding allows it. The columns get a chunk per range and row
+  /// group. Only top-level columns that are neither nested nor repeated and
+  /// not read as dictionaries are supported
+  ::arrow::Status ReadRows(const std::vector<RowRange>& ranges,
+                           const std::vector<int>& column_indices,
+                           std::shared_ptr<::arrow::Table>* out);
+
+  /// \brief ReadRows of the rows with the given ascending indices, runs of
+  /// consecutive rows are read as ranges
+  ::arrow::Status TakeRows(const std::vector<int64_t>& rows,
+                           const std::vector<int>& column_indices,
+                           std::shared_ptr<::arrow::Table>* out);
+
   /// \brief Scan file contents with one thread, return number of rows
   ::arrow::Status ScanContents(std::vector<int> columns, const int32_t column_batch_size,
                                int64_t* num_rows);
 
+  /// \brief Count the rows, and the values and nulls and find the min and
+  /// max of the indicated leaf columns over the row groups that the filter of
+  /// the ArrowReaderProperties does not rule out, from the metadata where it
+  /// allows, see ParquetFileReader::ComputeAggregates
+  ::arrow::Status ComputeAggregates(const std::vector<int>& column_indices,
+                                    FileAggregates* out);
+
   /// \brief Return a reader for the RowGroup, this object must not outlive the
   ///   FileReader.
   std::shared_ptr<RowGroupReader> RowGroup(int row_group_index);
@@ -198,6 +322,11 @@ class PARQUET_EXPORT FileReader {
   /// default only 1 thread is used
   void set_num_threads(int num_threads);
 
+  /// Set the pool that runs the reads when more than one thread is used. The
+  /// number of threads is the limit of the reads of this reader on the pool.
+  /// By default the process-wide ThreadPool::GetDefault pool is used
+  void set_thread_pool(const std::shared_ptr<ThreadPool>& pool);
+
   virtual ~FileReader();
 
  private:
@@ -241,6 +370,19 @@ class PARQUET_EXPORT ColumnChunkReader {
   int row_group_index_;
 };
 
+// Buffers of the caller that ColumnReader::NextBatchInto decodes a batch into.
+// They are emptied for the batch and grown with Resize and Reserve, which is
+// where the caller controls their allocation, and end up in the returned array.
+struct PARQUET_EXPORT ColumnBatchBuffers {
+  // Fixed width values, the bitmap of BOOLEAN values, the int32 offsets of
+  // BYTE_ARRAY values or the indices of the ones read as dictionary
+  std::shared_ptr<::arrow::ResizableBuffer> values;
+  // Validity bitmap, required for nullable values
+  std::shared_ptr<::arrow::ResizableBuffer> is_valid;
+  // Bytes of BYTE_ARRAY values, required unless they are read as dictionary
+  std::shared_ptr<::arrow::ResizableBuffer> data;
+};
+
 // At this point, the column reader is a stream iterator. It only knows how to
 // read the next batch of values for a particular column from the file until it
 // runs out.
@@ -263,6 +405,30 @@ class PARQUET_EXPORT ColumnReader {
   // the data available in the file.
   ::arrow::Status NextBatch(int64_t batch_size, std::shared_ptr<::arrow::Array>* out);
 
+  // Hand an array returned by NextBatch back once it is consumed, so that its
+  // buffers are reused for the following batches instead of allocating new
+  // ones. Buffers that are still referenced elsewhere, e.g. by slices of the
+  // array, are left alone.
+  void RecycleBuffers(std::shared_ptr<::arrow::Array> array);
+
+  // Bytes the reader holds in memory between batches: the buffers it decodes
+  // into and keeps for reuse, the decoded dictionaries and the pages being
+  // decompressed or read ahead. Open the FileReader with the memory_pool()
+  // of the ReaderProperties to bound these with set_memory_limit as well.
+  int64_t memory_usage();
+
+  // Like NextBatch, but decodes the values into the buffers of the caller
+  // instead of new ones of the reader's pool, e.g. into preallocated vectors of
+  // an execution engine. Only for the types whose values Arrow lays out as
+  // Parquet decodes them: BOOL, INT32, INT64, FLOAT, DOUBLE, STRING, BINARY,
+  // DATE32, TIME32, TIME64, FIXED_SIZE_BINARY and TIMESTAMP but of
+  // nanoseconds. Other types and struct columns return NotImplemented. The
+  // offsets and validity bitmaps of lists are still allocated from the pool.
+  // The buffers are overwritten, so the array of a previous batch that was
+  // read into them must not be in use anymore.
+  ::arrow::Status NextBatchInto(int64_t batch_size, const ColumnBatchBuffers& buffers,
+                                std::shared_ptr<::arrow::Array>* out);
+
  private:
   std::unique_ptr<ColumnReaderImpl> impl_;
   explicit ColumnReader(std::unique_ptr<ColumnReaderImpl> impl);
@@ -283,6 +449,14 @@ PARQUET_EXPORT
                          const std::shared_ptr<FileMetaData>& metadata,
                          std::unique_ptr<FileReader>* reader);
 
+PARQUET_EXPORT
+::arrow::Status OpenFile(const std::shared_ptr<::arrow::io::ReadableFileInterface>& file,
+                         ::arrow::MemoryPool* allocator,
+                         const ReaderProperties& properties,
+                         const std::shared_ptr<FileMetaData>& metadata,
+                         const ArrowReaderProperties& arrow_properties,
+                         std::unique_ptr<FileReader>* reader);
+
 PARQUET_EXPORT
 ::arrow::Status OpenFile(const std::shared_ptr<::arrow::io::ReadableFileInterface>& file,
                          ::arrow::MemoryPool* allocator,
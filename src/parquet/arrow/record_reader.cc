@@ -19,8 +19,11 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <cstring>
+#include <limits>
 #include <memory>
 #include <sstream>
+#include <vector>
 
 #include <arrow/buffer.h>
 #include <arrow/memory_pool.h>
@@ -50,11 +53,20 @@ static bool IsDictionaryIndexEncoding(const Encoding::type& e) {
   return e == Encoding::RLE_DICTIONARY || e == Encoding::PLAIN_DICTIONARY;
 }
 
+// The most buffers returned with RecordReader::RecycleBuffer that are kept for
+// the following batches, enough for the values, validity bitmaps and BYTE_ARRAY
+// data of a few batches in flight
+constexpr size_t kMaxSpareBuffers = 8;
+
 class RecordReader::RecordReaderImpl {
  public:
-  RecordReaderImpl(const ColumnDescriptor* descr, MemoryPool* pool)
+  RecordReaderImpl(const ColumnDescriptor* descr, MemoryPool* pool,
+                   bool read_dictionary)
       : descr_(descr),
         pool_(pool),
+        read_dictionary_(read_dictionary),
+        dictionary_offset_(0),
+        binary_data_length_(0),
         num_buffered_values_(0),
         num_decoded_values_(0),
         max_def_level_(descr->max_definition_level()),
@@ -66,19 +78,33 @@ class RecordReader::RecordReaderImpl {
         null_count_(0),
         levels_written_(0),
         levels_position_(0),
-        levels_capacity_(0) {
+        levels_capacity_(0),
+        output_buffers_(false) {
     nullable_values_ = internal::HasSpacedValues(descr);
+
+    // Top-level columns are not read through their levels by a parent, so
+    // their definition levels can go straight into valid_bits_
+    const schema::Node* parent = descr->schema_node()->parent();
+    levels_to_bitmap_ = max_def_level_ == 1 && max_rep_level_ == 0 &&
+                        parent != nullptr && parent->parent() == nullptr;
     values_ = std::make_shared<PoolBuffer>(pool);
     valid_bits_ = std::make_shared<PoolBuffer>(pool);
     def_levels_ = std::make_shared<PoolBuffer>(pool);
     rep_levels_ = std::make_shared<PoolBuffer>(pool);
+    binary_data_ = std::make_shared<PoolBuffer>(pool);
 
-    if (descr->physical_type() == Type::BYTE_ARRAY) {
-      builder_.reset(new ::arrow::BinaryBuilder(pool));
+    binary_values_ = !read_dictionary && descr->physical_type() == Type::BYTE_ARRAY;
+    bitmap_values_ = descr->physical_type() == Type::BOOLEAN;
+    if (read_dictionary || binary_values_) {
+      value_byte_width_ = static_cast<int>(sizeof(int32_t));
     } else if (descr->physical_type() == Type::FIXED_LEN_BYTE_ARRAY) {
-      int byte_width = descr->type_length();
-      std::shared_ptr<::arrow::DataType> type = ::arrow::fixed_size_binary(byte_width);
-      builder_.reset(new ::arrow::FixedSizeBinaryBuilder(type, pool));
+      value_byte_width_ = descr->type_length();
+    } else {
+      value_byte_width_ = GetTypeByteSize(descr->physical_type());
+    }
+
+    if (read_dictionary) {
+      builder_.reset(new ::arrow::BinaryBuilder(pool));
     }
     Reset();
   }
@@ -87,14 +113,59 @@ class RecordReader::RecordReaderImpl {
 
   virtual int64_t ReadRecords(int64_t num_records) = 0;
 
+  virtual int64_t SkipRecords(int64_t num_records) = 0;
+
   // Dictionary decoders must be reset when advancing row groups
   virtual void ResetDecoders() = 0;
 
+  virtual std::shared_ptr<::arrow::Array> ReleaseDictionary() = 0;
+
+  // Capacity of the buffers of the batch and of the spare buffers, and the
+  // bytes held by the page reader
+  virtual int64_t memory_usage() {
+    int64_t size = pager_ ? pager_->memory_usage() : 0;
+    for (const Buffer* buffer : {static_cast<const Buffer*>(values_.get()),
+                                 static_cast<const Buffer*>(valid_bits_.get()),
+                                 static_cast<const Buffer*>(binary_data_.get()),
+                                 static_cast<const Buffer*>(def_levels_.get()),
+                                 static_cast<const Buffer*>(rep_levels_.get())}) {
+      if (buffer != nullptr) {
+        size += buffer->capacity();
+      }
+    }
+    for (const auto& buffer : spare_buffers_) {
+      size += buffer->capacity();
+    }
+    return size;
+  }
+
   void SetPageReader(std::unique_ptr<PageReader> reader) {
     pager_ = std::move(reader);
+    if (BorrowsNumericValues()) {
+      // Decompressed pages can then be borrowed from as well, which leaves
+      // decompression as the only copy of the values
+      pager_->set_reuse_decompression_buffer(false);
+    }
     ResetDecoders();
   }
 
+  // True if the values of batches read from a single PLAIN page are a slice
+  // of the page that Arrow uses as is for INT32, INT64, FLOAT and DOUBLE
+  bool BorrowsNumericValues() const {
+    if (nullable_values_) {
+      return false;
+    }
+    switch (descr_->physical_type()) {
+      case Type::INT32:
+      case Type::INT64:
+      case Type::FLOAT:
+      case Type::DOUBLE:
+        return true;
+      default:
+        return false;
+    }
+  }
+
   bool HasMoreData() const { return pager_ != nullptr; }
 
   int16_t* def_levels() const {
@@ -105,7 +176,9 @@ class RecordReader::RecordReaderImpl {
     return reinterpret_cast<int16_t*>(rep_levels_->mutable_data());
   }
 
-  uint8_t* values() const { return values_->mutable_data(); }
+  const uint8_t* values() const {
+    return borrowed_values_ ? borrowed_values_->data() : values_->data();
+  }
 
   /// \brief Number of values written including nulls (if any)
   int64_t values_written() const { return values_written_; }
@@ -121,20 +194,71 @@ class RecordReader::RecordReaderImpl {
 
   bool nullable_values() const { return nullable_values_; }
 
-  std::shared_ptr<PoolBuffer> ReleaseValues() {
-    auto result = values_;
-    values_ = std::make_shared<PoolBuffer>(pool_);
+  std::shared_ptr<Buffer> ReleaseValues() {
+    if (borrowed_values_) {
+      std::shared_ptr<Buffer> result = std::move(borrowed_values_);
+      borrowed_values_ = nullptr;
+      return result;
+    }
+    std::shared_ptr<Buffer> result = values_;
+    values_ = NewBuffer(ReleasedCapacity(*result));
     return result;
   }
 
-  std::shared_ptr<PoolBuffer> ReleaseIsValid() {
+  std::shared_ptr<ResizableBuffer> ReleaseIsValid() {
     auto result = valid_bits_;
-    valid_bits_ = std::make_shared<PoolBuffer>(pool_);
+    valid_bits_ = NewBuffer(ReleasedCapacity(*result));
+    return result;
+  }
+
+  std::shared_ptr<ResizableBuffer> ReleaseBinaryData() {
+    auto result = binary_data_;
+    PARQUET_THROW_NOT_OK(result->Resize(binary_data_length_, false));
+    binary_data_ = NewBuffer(ReleasedCapacity(*result));
     return result;
   }
 
+  void SetOutputBuffers(const std::shared_ptr<ResizableBuffer>& values,
+                        const std::shared_ptr<ResizableBuffer>& valid_bits,
+                        const std::shared_ptr<ResizableBuffer>& binary_data) {
+    if (!values || (nullable_values_ && !valid_bits) ||
+        (binary_values_ && !binary_data)) {
+      throw ParquetException("Missing output buffers for column " +
+                             descr_->path()->ToDotString());
+    }
+    ResetValues();
+    // The buffers in use are kept to replace the caller's ones when the
+    // batch is released
+    values_ = ExchangeBuffer(std::move(values_), values);
+    if (nullable_values_) {
+      valid_bits_ = ExchangeBuffer(std::move(valid_bits_), valid_bits);
+    }
+    if (binary_values_) {
+      binary_data_ = ExchangeBuffer(std::move(binary_data_), binary_data);
+    }
+    output_buffers_ = true;
+  }
+
+  void RecycleBuffer(std::shared_ptr<Buffer> buffer) {
+    // Buffers still referenced elsewhere, e.g. by slices, are left alone, as
+    // are the slices of data pages that values may be borrowed from
+    if (!buffer || buffer.use_count() != 1 || spare_buffers_.size() >= kMaxSpareBuffers) {
+      return;
+    }
+    auto pool_buffer = std::dynamic_pointer_cast<PoolBuffer>(buffer);
+    if (pool_buffer) {
+      spare_buffers_.push_back(std::move(pool_buffer));
+    }
+  }
+
   ::arrow::ArrayBuilder* builder() { return builder_.get(); }
 
+  bool read_dictionary() const { return read_dictionary_; }
+
+  void set_shared_dictionary(std::shared_ptr<SharedDictionary> dictionary) {
+    shared_dictionary_ = std::move(dictionary);
+  }
+
   // Process written repetition/definition levels to reach the end of
   // records. Process no more levels than necessary to delimit the indicated
   // number of logical records. Updates internal state of RecordReader
@@ -179,6 +303,8 @@ class RecordReader::RecordReaderImpl {
     if (descr_->max_definition_level() == 0) {
       return 0;
     }
+    ScopedReadTimer timer(pager_->read_counters(),
+                          &ColumnReadCounters::level_decode_nanos);
     return definition_level_decoder_.Decode(static_cast<int>(batch_size), levels);
   }
 
@@ -186,6 +312,8 @@ class RecordReader::RecordReaderImpl {
     if (descr_->max_repetition_level() == 0) {
       return 0;
     }
+    ScopedReadTimer timer(pager_->read_counters(),
+                          &ColumnReadCounters::level_decode_nanos);
     return repetition_level_decoder_.Decode(static_cast<int>(batch_size), levels);
   }
 
@@ -228,8 +356,19 @@ class RecordReader::RecordReaderImpl {
         new_values_capacity = BitUtil::NextPower2(new_values_capacity + 1);
       }
 
-      int type_size = GetTypeByteSize(descr_->physical_type());
-      PARQUET_THROW_NOT_OK(values_->Resize(new_values_capacity * type_size, false));
+      if (bitmap_values_) {
+        const int64_t values_bytes_old = BitUtil::BytesForBits(values_written_);
+        const int64_t values_bytes_new = BitUtil::BytesForBits(new_values_capacity);
+        PARQUET_THROW_NOT_OK(values_->Resize(values_bytes_new, false));
+
+        // Avoid valgrind warnings
+        memset(values_->mutable_data() + values_bytes_old, 0,
+               values_bytes_new - values_bytes_old);
+      } else {
+        // The offsets of BYTE_ARRAY values need one more entry
+        const int64_t num_slots = new_values_capacity + (binary_values_ ? 1 : 0);
+        PARQUET_THROW_NOT_OK(values_->Resize(num_slots * value_byte_width_, false));
+      }
       values_capacity_ = new_values_capacity;
     }
     if (nullable_values_) {
@@ -274,13 +413,67 @@ class RecordReader::RecordReaderImpl {
   }
 
   void ResetValues() {
+    borrowed_values_ = nullptr;
+    output_buffers_ = false;
     if (values_written_ > 0) {
       // Resize to 0, but do not shrink to fit
       PARQUET_THROW_NOT_OK(values_->Resize(0, false));
       PARQUET_THROW_NOT_OK(valid_bits_->Resize(0, false));
+      PARQUET_THROW_NOT_OK(binary_data_->Resize(0, false));
       values_written_ = 0;
       values_capacity_ = 0;
       null_count_ = 0;
+      binary_data_length_ = 0;
+    }
+  }
+
+  // Copy the values that point into a data page to values_, which must have
+  // room for them, before more values are appended
+  void CopyBorrowedValues() {
+    memcpy(values_->mutable_data(), borrowed_values_->data(),
+           static_cast<size_t>(borrowed_values_->size()));
+    borrowed_values_ = nullptr;
+  }
+
+  // Replaces a released buffer with one that has room for capacity bytes,
+  // so the next batches start at the high-water mark instead of growing from
+  // empty. Takes a recycled buffer if there is any
+  std::shared_ptr<ResizableBuffer> NewBuffer(int64_t capacity) {
+    std::shared_ptr<PoolBuffer> result;
+    if (spare_buffers_.empty()) {
+      result = std::make_shared<PoolBuffer>(pool_);
+    } else {
+      result = std::move(spare_buffers_.back());
+      spare_buffers_.pop_back();
+      PARQUET_THROW_NOT_OK(result->Resize(0, false));
+    }
+    PARQUET_THROW_NOT_OK(result->Reserve(capacity));
+    return result;
+  }
+
+  // Buffers of the caller are not the high-water mark of those of the reader
+  int64_t ReleasedCapacity(const Buffer& released) const {
+    return output_buffers_ ? 0 : released.capacity();
+  }
+
+  // Puts the buffer in use aside with the spare ones and returns the caller's
+  // one, emptied, to decode into instead
+  std::shared_ptr<ResizableBuffer> ExchangeBuffer(
+      std::shared_ptr<ResizableBuffer> current,
+      const std::shared_ptr<ResizableBuffer>& replacement) {
+    PARQUET_THROW_NOT_OK(replacement->Resize(0, false));
+    RecycleBuffer(std::move(current));
+    return replacement;
+  }
+
+  // Make room for num_bytes more BYTE_ARRAY data
+  void ReserveBinaryData(int64_t num_bytes) {
+    const int64_t required = binary_data_length_ + num_bytes;
+    if (required > std::numeric_limits<int32_t>::max()) {
+      throw ParquetException("BYTE_ARRAY data of a batch must not exceed 2GB");
+    }
+    if (required > binary_data_->size()) {
+      PARQUET_THROW_NOT_OK(binary_data_->Resize(BitUtil::NextPower2(required), false));
     }
   }
 
@@ -288,6 +481,27 @@ class RecordReader::RecordReaderImpl {
   const ColumnDescriptor* descr_;
   ::arrow::MemoryPool* pool_;
 
+  // If set, values_ holds int32 dictionary indices and builder_ the
+  // dictionaries they refer to. The current column chunk's dictionary starts at
+  // dictionary_offset_ in builder_.
+  const bool read_dictionary_;
+  int32_t dictionary_offset_;
+
+  // If set, the dictionary is decoded once for all readers of the chunk
+  std::shared_ptr<SharedDictionary> shared_dictionary_;
+
+  // If set, BYTE_ARRAY values are assembled in Arrow's binary layout: values_
+  // holds values_written_ + 1 int32 offsets into binary_data_
+  bool binary_values_;
+  std::shared_ptr<ResizableBuffer> binary_data_;
+  int64_t binary_data_length_;
+
+  // If set, BOOLEAN values are decoded into a bitmap, as Arrow lays them out
+  bool bitmap_values_;
+
+  // Size of one entry in values_, unless bitmap_values_ is set
+  int value_byte_width_;
+
   std::unique_ptr<PageReader> pager_;
   std::shared_ptr<Page> current_page_;
 
@@ -314,6 +528,10 @@ class RecordReader::RecordReaderImpl {
 
   bool nullable_values_;
 
+  // If set, the definition levels are decoded into valid_bits_ and are not
+  // buffered in def_levels_
+  bool levels_to_bitmap_;
+
   bool at_record_start_;
   int64_t records_read_;
 
@@ -325,19 +543,30 @@ class RecordReader::RecordReaderImpl {
   int64_t levels_position_;
   int64_t levels_capacity_;
 
-  // TODO(wesm): ByteArray / FixedLenByteArray types
+  // Dictionary values if read_dictionary_ is set
   std::unique_ptr<::arrow::ArrayBuilder> builder_;
 
-  std::shared_ptr<::arrow::PoolBuffer> values_;
+  std::shared_ptr<ResizableBuffer> values_;
+
+  // If set, the values_written_ values are in this slice of a data page
+  // instead of values_
+  std::shared_ptr<Buffer> borrowed_values_;
+
+  // If set, values_, valid_bits_ and binary_data_ of the batch are buffers
+  // of the caller, see SetOutputBuffers. Values are never borrowed then
+  bool output_buffers_;
 
   template <typename T>
   T* ValuesHead() {
     return reinterpret_cast<T*>(values_->mutable_data()) + values_written_;
   }
 
-  std::shared_ptr<::arrow::PoolBuffer> valid_bits_;
+  std::shared_ptr<ResizableBuffer> valid_bits_;
   std::shared_ptr<::arrow::PoolBuffer> def_levels_;
   std::shared_ptr<::arrow::PoolBuffer> rep_levels_;
+
+  // Buffers returned with RecycleBuffer to replace released ones with
+  std::vector<std::shared_ptr<::arrow::PoolBuffer>> spare_buffers_;
 };
 
 // The minimum number of repetition/definition levels to decode at a time, for
@@ -349,24 +578,85 @@ class TypedRecordReader : public RecordReader::RecordReaderImpl {
  public:
   typedef typename DType::c_type T;
 
-  TypedRecordReader(const ColumnDescriptor* schema, ::arrow::MemoryPool* pool)
-      : RecordReader::RecordReaderImpl(schema, pool), current_decoder_(nullptr) {}
+  TypedRecordReader(const ColumnDescriptor* schema, ::arrow::MemoryPool* pool,
+                    bool read_dictionary)
+      : RecordReader::RecordReaderImpl(schema, pool, read_dictionary),
+        current_decoder_(nullptr),
+        scratch_(std::make_shared<PoolBuffer>(pool)),
+        previous_dictionary_num_values_(0) {}
 
   void ResetDecoders() override { decoders_.clear(); }
 
-  inline void ReadValuesSpaced(int64_t values_with_nulls, int64_t null_count) {
-    uint8_t* valid_bits = valid_bits_->mutable_data();
-    const int64_t valid_bits_offset = values_written_;
+  // Adds the decoded dictionary of the column chunk, unless it is shared
+  // with other readers, and the buffers kept for the next dictionary page
+  int64_t memory_usage() override {
+    int64_t size = RecordReaderImpl::memory_usage();
+    auto it = decoders_.find(static_cast<int>(Encoding::RLE_DICTIONARY));
+    if (it != decoders_.end() && shared_dictionary_ == nullptr) {
+      const DecodedDictionary& dictionary =
+          static_cast<DictionaryDecoder<DType>*>(it->second.get())->decoded_dictionary();
+      if (dictionary.values) {
+        size += dictionary.values->size();
+      }
+      if (dictionary.byte_array_data) {
+        size += dictionary.byte_array_data->size();
+      }
+    }
+    size += scratch_->capacity();
+    if (previous_dictionary_page_) {
+      size += previous_dictionary_page_->capacity();
+    }
+    return size;
+  }
 
-    int64_t num_decoded = current_decoder_->DecodeSpaced(
-        ValuesHead<T>(), static_cast<int>(values_with_nulls),
-        static_cast<int>(null_count), valid_bits, valid_bits_offset);
-    DCHECK_EQ(num_decoded, values_with_nulls);
+  std::shared_ptr<::arrow::Array> ReleaseDictionary() override {
+    throw ParquetException("Only BYTE_ARRAY columns can be read as dictionary");
+  }
+
+  // Decode num_values values with the decoder of the current page. PLAIN and
+  // dictionary decoders are called directly, which lets their Decode be
+  // inlined here, the others through Decoder::Decode.
+  inline int DecodeDense(T* out, int num_values) {
+    switch (current_decoder_->encoding()) {
+      case Encoding::PLAIN:
+        return DecodeWith<PlainDecoder<DType>>(out, num_values);
+      case Encoding::RLE_DICTIONARY:
+        return DecodeWith<DictionaryDecoder<DType>>(out, num_values);
+      default:
+        return current_decoder_->Decode(out, num_values);
+    }
+  }
+
+  template <typename ConcreteDecoder>
+  inline int DecodeWith(T* out, int num_values) {
+    auto decoder = static_cast<ConcreteDecoder*>(current_decoder_);
+    return decoder->ConcreteDecoder::Decode(out, num_values);
+  }
+
+  // As Decoder::DecodeSpaced, with the values decoded by DecodeDense
+  inline void ReadValuesSpaced(int64_t values_with_nulls, int64_t null_count) {
+    const int num_slots = static_cast<int>(values_with_nulls);
+    const int values_to_read = static_cast<int>(values_with_nulls - null_count);
+    T* out = ValuesHead<T>();
+    if (DecodeDense(out, values_to_read) != values_to_read) {
+      throw ParquetException("Number of values / definition_levels read did not match");
+    }
+    if (null_count > 0) {
+      memset(out + values_to_read, 0, (num_slots - values_to_read) * sizeof(T));
+      // The slots of an all-null batch are only zeroed
+      if (values_to_read > 0) {
+        internal::SpaceValues(out, num_slots, static_cast<int>(null_count),
+                              valid_bits_->data(), values_written_);
+      }
+    }
   }
 
   inline void ReadValuesDense(int64_t values_to_read) {
-    int64_t num_decoded =
-        current_decoder_->Decode(ValuesHead<T>(), static_cast<int>(values_to_read));
+    if (values_written_ == 0 && values_to_read > 0 && !output_buffers_ &&
+        BorrowValues(values_to_read)) {
+      return;
+    }
+    int64_t num_decoded = DecodeDense(ValuesHead<T>(), static_cast<int>(values_to_read));
     DCHECK_EQ(num_decoded, values_to_read);
   }
 
@@ -376,6 +666,9 @@ class TypedRecordReader : public RecordReader::RecordReaderImpl {
     const int64_t possible_num_values =
         std::max(num_records, levels_written_ - levels_position_);
     ReserveValues(possible_num_values);
+    if (borrowed_values_) {
+      CopyBorrowedValues();
+    }
 
     const int64_t start_levels_position = levels_position_;
 
@@ -394,6 +687,8 @@ class TypedRecordReader : public RecordReader::RecordReaderImpl {
       records_read = values_to_read = num_records;
     }
 
+    ScopedReadTimer timer(pager_->read_counters(),
+                          &ColumnReadCounters::value_decode_nanos);
     int64_t null_count = 0;
     if (nullable_values_) {
       int64_t values_with_nulls = 0;
@@ -428,6 +723,10 @@ class TypedRecordReader : public RecordReader::RecordReaderImpl {
   }
 
   int64_t ReadRecords(int64_t num_records) override {
+    if (levels_to_bitmap_) {
+      return ReadRecordsToBitmap(num_records);
+    }
+
     // Delimit records, then read values at the end
     int64_t records_read = 0;
 
@@ -494,9 +793,164 @@ class TypedRecordReader : public RecordReader::RecordReaderImpl {
     return records_read;
   }
 
+  // ReadRecords for levels_to_bitmap_. The definition levels of exactly the
+  // records to read are decoded into valid_bits_, which leaves no levels
+  // buffered between calls
+  int64_t ReadRecordsToBitmap(int64_t num_records) {
+    int64_t records_read = 0;
+    while (records_read < num_records && HasNext()) {
+      const int64_t batch_size =
+          std::min(num_records - records_read, available_values_current_page());
+      if (batch_size == 0) {
+        break;
+      }
+      ReserveValues(batch_size);
+
+      int64_t null_count = 0;
+      int64_t levels_read = 0;
+      {
+        ScopedReadTimer timer(pager_->read_counters(),
+                              &ColumnReadCounters::level_decode_nanos);
+        levels_read = definition_level_decoder_.DecodeBitmap(
+            static_cast<int>(batch_size), valid_bits_->mutable_data(), values_written_,
+            &null_count);
+      }
+      if (levels_read == 0) {
+        break;
+      }
+      {
+        ScopedReadTimer timer(pager_->read_counters(),
+                              &ColumnReadCounters::value_decode_nanos);
+        ReadValuesSpaced(levels_read, null_count);
+      }
+      ConsumeBufferedValues(levels_read);
+
+      values_written_ += levels_read;
+      null_count_ += null_count;
+      records_read += levels_read;
+    }
+    return records_read;
+  }
+
+  int64_t SkipRecords(int64_t num_records) override {
+    // Levels that are buffered but not read yet come first
+    int64_t records_skipped = SkipBufferedRecords(num_records);
+
+    while (records_skipped < num_records || (max_rep_level_ > 0 && !at_record_start_)) {
+      if (max_rep_level_ == 0 && num_decoded_values_ == num_buffered_values_) {
+        // Drop the following pages that are skipped entirely before they are
+        // decompressed
+        records_skipped += pager_->SkipDataPages(num_records - records_skipped);
+        if (records_skipped == num_records) {
+          break;
+        }
+      }
+      if (!HasNext()) {
+        break;
+      }
+      const int64_t available = available_values_current_page();
+
+      if (max_rep_level_ == 0) {
+        // Each level is a record, skip them without buffering
+        const int64_t num_levels = std::min(num_records - records_skipped, available);
+        if (num_levels == available) {
+          // The values of the page are not decoded at all
+          ConsumeBufferedValues(num_levels);
+        } else {
+          SkipLevels(num_levels);
+        }
+        records_skipped += num_levels;
+      } else {
+        // Buffer the levels to find where the records end
+        const int64_t batch_size =
+            std::min(std::max(kMinLevelBatchSize, num_records - records_skipped),
+                     available);
+        ReserveLevels(batch_size);
+        int16_t* def_levels = this->def_levels() + levels_written_;
+        int16_t* rep_levels = this->rep_levels() + levels_written_;
+        const int64_t levels_read = ReadDefinitionLevels(batch_size, def_levels);
+        if (ReadRepetitionLevels(batch_size, rep_levels) != levels_read) {
+          throw ParquetException("Number of decoded rep / def levels did not match");
+        }
+        if (levels_read == 0) {
+          break;
+        }
+        levels_written_ += levels_read;
+        records_skipped += SkipBufferedRecords(num_records - records_skipped);
+      }
+    }
+    return records_skipped;
+  }
+
  private:
   typedef Decoder<DType> DecoderType;
 
+  // Skip up to num_records records of the buffered levels that are not read
+  // yet and the values they refer to. The skipped levels are dropped from the
+  // buffers.
+  //
+  // \return Number of records skipped
+  int64_t SkipBufferedRecords(int64_t num_records) {
+    if (levels_position_ == levels_written_) {
+      return 0;
+    }
+    const int64_t start_levels_position = levels_position_;
+    int64_t values_to_skip = 0;
+    int64_t records_skipped = 0;
+    if (max_rep_level_ > 0) {
+      records_skipped = DelimitRecords(num_records, &values_to_skip);
+    } else {
+      records_skipped = std::min(levels_written_ - levels_position_, num_records);
+      const int16_t* def_levels = this->def_levels() + levels_position_;
+      for (int64_t i = 0; i < records_skipped; ++i) {
+        if (def_levels[i] == max_def_level_) {
+          ++values_to_skip;
+        }
+      }
+      levels_position_ += records_skipped;
+    }
+    if (current_decoder_->Skip(static_cast<int>(values_to_skip)) != values_to_skip) {
+      ParquetException::EofException();
+    }
+    ConsumeBufferedValues(levels_position_ - start_levels_position);
+
+    int16_t* def_data = def_levels();
+    std::copy(def_data + levels_position_, def_data + levels_written_,
+              def_data + start_levels_position);
+    if (max_rep_level_ > 0) {
+      int16_t* rep_data = rep_levels();
+      std::copy(rep_data + levels_position_, rep_data + levels_written_,
+                rep_data + start_levels_position);
+    }
+    levels_written_ -= levels_position_ - start_levels_position;
+    levels_position_ = start_levels_position;
+    return records_skipped;
+  }
+
+  // Skip num_levels levels of the current data page that are not buffered
+  // and the values they refer to. Only for columns that are not repeated
+  void SkipLevels(int64_t num_levels) {
+    int64_t values_to_skip = num_levels;
+    if (max_def_level_ > 0) {
+      // Decoded after the buffered levels, which are kept
+      ReserveLevels(num_levels);
+      int16_t* def_levels = this->def_levels() + levels_written_;
+      if (ReadDefinitionLevels(num_levels, def_levels) != num_levels) {
+        ParquetException::EofException();
+      }
+      values_to_skip = 0;
+      for (int64_t i = 0; i < num_levels; ++i) {
+        if (def_levels[i] == max_def_level_) {
+          ++values_to_skip;
+        }
+      }
+    }
+    if (current_decoder_->Skip(static_cast<int>(values_to_skip)) != values_to_skip) {
+      ParquetException::EofException();
+    }
+    ConsumeBufferedValues(num_levels);
+  }
+
   // Map of encoding type to the respective decoder object. For example, a
   // column chunk's data pages may include both dictionary-encoded and
   // plain-encoded data.
@@ -504,87 +958,350 @@ class TypedRecordReader : public RecordReader::RecordReaderImpl {
 
   DecoderType* current_decoder_;
 
+  // Let the values of a batch that are PLAIN encoded in a single data page
+  // point into the page instead of copying them, if the page shares the
+  // bytes of the file. This is what makes reading the required columns of
+  // uncompressed, memory mapped files zero-copy.
+  //
+  // \return false if the values must be decoded instead
+  bool BorrowValues(int64_t values_to_read) {
+    if (current_decoder_->encoding() != Encoding::PLAIN ||
+        !current_page_->is_buffer_shared()) {
+      return false;
+    }
+    auto decoder = static_cast<PlainDecoder<DType>*>(current_decoder_);
+    const uint8_t* data = decoder->data();
+    // Arrow expects the values to be naturally aligned
+    if (reinterpret_cast<uintptr_t>(data) % alignof(T) != 0) {
+      return false;
+    }
+    const int64_t offset = data - current_page_->data();
+    if (decoder->Skip(static_cast<int>(values_to_read)) != values_to_read) {
+      ParquetException::EofException();
+    }
+    borrowed_values_ = ::arrow::SliceBuffer(current_page_->buffer(), offset,
+                                            values_to_read * sizeof(T));
+    return true;
+  }
+
+  // Decoded values of pages that are appended to the dictionary
+  std::shared_ptr<PoolBuffer> scratch_;
+
+  // The dictionary page of the previous column chunk and its decoded values,
+  // which are used again if the next chunk has a byte-identical dictionary
+  // page, as writers that reuse dictionaries across row groups produce
+  std::shared_ptr<PoolBuffer> previous_dictionary_page_;
+  int32_t previous_dictionary_num_values_;
+  DecodedDictionary previous_dictionary_;
+
+  // Whether page is the same as previous_dictionary_page_
+  bool IsPreviousDictionary(const DictionaryPage* page) const {
+    return previous_dictionary_page_ != nullptr &&
+           page->num_values() == previous_dictionary_num_values_ &&
+           page->size() == previous_dictionary_page_->size() &&
+           memcmp(page->data(), previous_dictionary_page_->data(),
+                  static_cast<size_t>(page->size())) == 0;
+  }
+
   // Advance to the next data page
   bool ReadNewPage();
 
   void ConfigureDictionary(const DictionaryPage* page);
+
+  // Append a column chunk's dictionary to builder_ when reading indices
+  void AppendDictionary(DictionaryDecoder<DType>* decoder) {}
+
+  // Decode indices into the values, leaving space for nulls if null_count > 0
+  void ReadDictionaryIndices(int64_t values_with_nulls, int64_t null_count) {}
+
+  // Decode BYTE_ARRAY or FIXED_LEN_BYTE_ARRAY values into Arrow's layout,
+  // leaving space for nulls if null_count > 0
+  void ReadBinaryValues(int64_t values_with_nulls, int64_t null_count) {}
 };
 
+// The reader of REQUIRED columns that are not nested, which RecordReader::Make
+// picks when the column is opened. Every value is a record and there are no
+// levels, so the values are decoded page by page with none of the bookkeeping
+// of levels and nulls.
+template <typename DType>
+class RequiredRecordReader : public TypedRecordReader<DType> {
+ public:
+  RequiredRecordReader(const ColumnDescriptor* schema, ::arrow::MemoryPool* pool,
+                       bool read_dictionary)
+      : TypedRecordReader<DType>(schema, pool, read_dictionary) {}
+
+  int64_t ReadRecords(int64_t num_records) override {
+    int64_t records_read = 0;
+    while (records_read < num_records && this->HasNext()) {
+      const int64_t batch_size =
+          std::min(num_records - records_read, this->available_values_current_page());
+      if (batch_size == 0) {
+        break;
+      }
+      this->ReserveValues(batch_size);
+      if (this->borrowed_values_) {
+        this->CopyBorrowedValues();
+      }
+      {
+        ScopedReadTimer timer(this->pager_->read_counters(),
+                              &ColumnReadCounters::value_decode_nanos);
+        this->ReadValuesDense(batch_size);
+      }
+      this->ConsumeBufferedValues(batch_size);
+
+      this->values_written_ += batch_size;
+      records_read += batch_size;
+    }
+    return records_read;
+  }
+};
+
+// BOOLEAN values are bit-packed in the page
 template <>
-inline void TypedRecordReader<ByteArrayType>::ReadValuesDense(int64_t values_to_read) {
-  auto values = ValuesHead<ByteArray>();
-  int64_t num_decoded =
-      current_decoder_->Decode(values, static_cast<int>(values_to_read));
-  DCHECK_EQ(num_decoded, values_to_read);
+inline bool TypedRecordReader<BooleanType>::BorrowValues(int64_t values_to_read) {
+  return false;
+}
 
+template <>
+inline void TypedRecordReader<ByteArrayType>::AppendDictionary(
+    DictionaryDecoder<ByteArrayType>* decoder) {
   auto builder = static_cast<::arrow::BinaryBuilder*>(builder_.get());
-  for (int64_t i = 0; i < num_decoded; i++) {
-    PARQUET_THROW_NOT_OK(
-        builder->Append(values[i].ptr, static_cast<int64_t>(values[i].len)));
+  dictionary_offset_ = static_cast<int32_t>(builder->length());
+
+  const ByteArray* dictionary = decoder->dictionary();
+  for (int i = 0; i < decoder->dictionary_length(); i++) {
+    PARQUET_THROW_NOT_OK(builder->Append(dictionary[i].ptr,
+                                         static_cast<int64_t>(dictionary[i].len)));
   }
-  ResetValues();
 }
 
 template <>
-inline void TypedRecordReader<FLBAType>::ReadValuesDense(int64_t values_to_read) {
-  auto values = ValuesHead<FLBA>();
-  int64_t num_decoded =
-      current_decoder_->Decode(values, static_cast<int>(values_to_read));
-  DCHECK_EQ(num_decoded, values_to_read);
+inline void TypedRecordReader<ByteArrayType>::ReadDictionaryIndices(
+    int64_t values_with_nulls, int64_t null_count) {
+  const int num_values = static_cast<int>(values_with_nulls - null_count);
+  int32_t* indices = ValuesHead<int32_t>();
+
+  if (current_decoder_->encoding() == Encoding::RLE_DICTIONARY) {
+    auto decoder = static_cast<DictionaryDecoder<ByteArrayType>*>(current_decoder_);
+    if (decoder->DecodeIndices(indices, num_values) != num_values) {
+      ParquetException::EofException();
+    }
+    if (dictionary_offset_ > 0) {
+      for (int i = 0; i < num_values; i++) {
+        indices[i] += dictionary_offset_;
+      }
+    }
+  } else {
+    // Pages that are not dictionary encoded, e.g. after the writer fell back to
+    // PLAIN, extend the dictionary by their values
+    PARQUET_THROW_NOT_OK(scratch_->Resize(num_values * sizeof(ByteArray), false));
+    auto values = reinterpret_cast<ByteArray*>(scratch_->mutable_data());
+    if (current_decoder_->Decode(values, num_values) != num_values) {
+      ParquetException::EofException();
+    }
+    auto builder = static_cast<::arrow::BinaryBuilder*>(builder_.get());
+    for (int i = 0; i < num_values; i++) {
+      indices[i] = static_cast<int32_t>(builder->length());
+      PARQUET_THROW_NOT_OK(
+          builder->Append(values[i].ptr, static_cast<int64_t>(values[i].len)));
+    }
+  }
+
+  if (null_count > 0) {
+    // Add spacing for null entries from the back, as in Decoder::DecodeSpaced
+    const uint8_t* valid_bits = valid_bits_->data();
+    int64_t values_to_move = num_values;
+    for (int64_t i = values_with_nulls - 1; i >= 0; i--) {
+      if (BitUtil::GetBit(valid_bits, values_written_ + i)) {
+        indices[i] = indices[--values_to_move];
+      } else {
+        indices[i] = 0;
+      }
+    }
+  }
+}
 
-  auto builder = static_cast<::arrow::FixedSizeBinaryBuilder*>(builder_.get());
-  for (int64_t i = 0; i < num_decoded; i++) {
-    PARQUET_THROW_NOT_OK(builder->Append(values[i].ptr));
+template <>
+inline std::shared_ptr<::arrow::Array>
+TypedRecordReader<ByteArrayType>::ReleaseDictionary() {
+  std::shared_ptr<::arrow::Array> dictionary;
+  PARQUET_THROW_NOT_OK(builder_->Finish(&dictionary));
+
+  // Finish resets the builder, but indices read from here on still refer to
+  // the dictionary of the current column chunk
+  dictionary_offset_ = 0;
+  auto it = decoders_.find(static_cast<int>(Encoding::RLE_DICTIONARY));
+  if (it != decoders_.end()) {
+    AppendDictionary(static_cast<DictionaryDecoder<ByteArrayType>*>(it->second.get()));
   }
-  ResetValues();
+  return dictionary;
 }
 
 template <>
-inline void TypedRecordReader<ByteArrayType>::ReadValuesSpaced(int64_t values_to_read,
+inline void TypedRecordReader<ByteArrayType>::ReadBinaryValues(int64_t values_with_nulls,
                                                                int64_t null_count) {
-  uint8_t* valid_bits = valid_bits_->mutable_data();
-  const int64_t valid_bits_offset = values_written_;
-  auto values = ValuesHead<ByteArray>();
+  if (values_with_nulls == 0) {
+    return;
+  }
+  const int num_values = static_cast<int>(values_with_nulls - null_count);
+  int32_t* offsets = ValuesHead<int32_t>();
+  if (values_written_ == 0) {
+    offsets[0] = 0;
+  }
 
-  int64_t num_decoded = current_decoder_->DecodeSpaced(
-      values, static_cast<int>(values_to_read), static_cast<int>(null_count), valid_bits,
-      valid_bits_offset);
-  DCHECK_EQ(num_decoded, values_to_read);
+  if (current_decoder_->encoding() == Encoding::PLAIN) {
+    // PLAIN values are copied straight from the page
+    auto decoder = static_cast<PlainDecoder<ByteArrayType>*>(current_decoder_);
+    ReserveBinaryData(decoder->bytes_left());
+    uint8_t* out = binary_data_->mutable_data() + binary_data_length_;
+    if (decoder->DecodeBinary(num_values, offsets, out) != num_values) {
+      ParquetException::EofException();
+    }
+  } else {
+    PARQUET_THROW_NOT_OK(scratch_->Resize(num_values * sizeof(ByteArray), false));
+    auto values = reinterpret_cast<ByteArray*>(scratch_->mutable_data());
+    if (current_decoder_->Decode(values, num_values) != num_values) {
+      ParquetException::EofException();
+    }
 
-  auto builder = static_cast<::arrow::BinaryBuilder*>(builder_.get());
+    int64_t num_bytes = 0;
+    for (int i = 0; i < num_values; i++) {
+      num_bytes += values[i].len;
+    }
+    ReserveBinaryData(num_bytes);
+
+    uint8_t* data = binary_data_->mutable_data();
+    int32_t offset = offsets[0];
+    for (int i = 0; i < num_values; i++) {
+      memcpy(data + offset, values[i].ptr, values[i].len);
+      offset += static_cast<int32_t>(values[i].len);
+      offsets[i + 1] = offset;
+    }
+  }
+  binary_data_length_ = offsets[num_values];
+
+  if (null_count > 0) {
+    // Null entries are empty, spread the offsets from the back
+    const uint8_t* valid_bits = valid_bits_->data();
+    int64_t values_to_move = num_values;
+    for (int64_t i = values_with_nulls - 1; i >= 0; i--) {
+      offsets[i + 1] = offsets[values_to_move];
+      if (BitUtil::GetBit(valid_bits, values_written_ + i)) {
+        --values_to_move;
+      }
+    }
+  }
+}
 
-  for (int64_t i = 0; i < num_decoded; i++) {
-    if (::arrow::BitUtil::GetBit(valid_bits, valid_bits_offset + i)) {
-      PARQUET_THROW_NOT_OK(
-          builder->Append(values[i].ptr, static_cast<int64_t>(values[i].len)));
+template <>
+inline void TypedRecordReader<FLBAType>::ReadBinaryValues(int64_t values_with_nulls,
+                                                          int64_t null_count) {
+  const int num_values = static_cast<int>(values_with_nulls - null_count);
+  const int64_t type_length = descr_->type_length();
+  uint8_t* out = values_->mutable_data() + values_written_ * type_length;
+
+  PARQUET_THROW_NOT_OK(scratch_->Resize(num_values * sizeof(FLBA), false));
+  auto values = reinterpret_cast<FLBA*>(scratch_->mutable_data());
+  if (current_decoder_->Decode(values, num_values) != num_values) {
+    ParquetException::EofException();
+  }
+
+  if (null_count == 0 && num_values > 0 &&
+      current_decoder_->encoding() == Encoding::PLAIN) {
+    // PLAIN values are contiguous in the page
+    memcpy(out, values[0].ptr, num_values * type_length);
+    return;
+  }
+
+  const uint8_t* valid_bits = valid_bits_->data();
+  int64_t value_index = 0;
+  for (int64_t i = 0; i < values_with_nulls; i++, out += type_length) {
+    if (null_count == 0 || BitUtil::GetBit(valid_bits, values_written_ + i)) {
+      memcpy(out, values[value_index++].ptr, type_length);
     } else {
-      PARQUET_THROW_NOT_OK(builder->AppendNull());
+      memset(out, 0, type_length);
     }
   }
-  ResetValues();
+}
+
+template <>
+inline void TypedRecordReader<ByteArrayType>::ReadValuesDense(int64_t values_to_read) {
+  if (read_dictionary_) {
+    ReadDictionaryIndices(values_to_read, 0);
+  } else {
+    ReadBinaryValues(values_to_read, 0);
+  }
+}
+
+template <>
+inline void TypedRecordReader<FLBAType>::ReadValuesDense(int64_t values_to_read) {
+  ReadBinaryValues(values_to_read, 0);
+}
+
+template <>
+inline void TypedRecordReader<ByteArrayType>::ReadValuesSpaced(int64_t values_to_read,
+                                                               int64_t null_count) {
+  if (read_dictionary_) {
+    ReadDictionaryIndices(values_to_read, null_count);
+  } else {
+    ReadBinaryValues(values_to_read, null_count);
+  }
 }
 
 template <>
 inline void TypedRecordReader<FLBAType>::ReadValuesSpaced(int64_t values_to_read,
                                                           int64_t null_count) {
-  uint8_t* valid_bits = valid_bits_->mutable_data();
-  const int64_t valid_bits_offset = values_written_;
-  auto values = ValuesHead<FLBA>();
-
-  int64_t num_decoded = current_decoder_->DecodeSpaced(
-      values, static_cast<int>(values_to_read), static_cast<int>(null_count), valid_bits,
-      valid_bits_offset);
-  DCHECK_EQ(num_decoded, values_to_read);
-
-  auto builder = static_cast<::arrow::FixedSizeBinaryBuilder*>(builder_.get());
-  for (int64_t i = 0; i < num_decoded; i++) {
-    if (::arrow::BitUtil::GetBit(valid_bits, valid_bits_offset + i)) {
-      PARQUET_THROW_NOT_OK(builder->Append(values[i].ptr));
-    } else {
-      PARQUET_THROW_NOT_OK(builder->AppendNull());
+  ReadBinaryValues(values_to_read, null_count);
+}
+
+// PLAIN values are copied bit-packed as they are in the page. Other encodings
+// are decoded one value at a time
+template <>
+inline void TypedRecordReader<BooleanType>::ReadValuesDense(int64_t values_to_read) {
+  const int num_values = static_cast<int>(values_to_read);
+  uint8_t* bitmap = values_->mutable_data();
+  if (current_decoder_->encoding() == Encoding::PLAIN) {
+    auto decoder = static_cast<PlainDecoder<BooleanType>*>(current_decoder_);
+    if (decoder->DecodeBitmap(bitmap, values_written_, num_values) != num_values) {
+      ParquetException::EofException();
     }
+    return;
+  }
+  PARQUET_THROW_NOT_OK(scratch_->Resize(num_values * sizeof(bool), false));
+  auto values = reinterpret_cast<bool*>(scratch_->mutable_data());
+  if (current_decoder_->Decode(values, num_values) != num_values) {
+    ParquetException::EofException();
+  }
+  for (int i = 0; i < num_values; i++) {
+    BitUtil::SetBitTo(bitmap, values_written_ + i, values[i]);
+  }
+}
+
+template <>
+inline void TypedRecordReader<BooleanType>::ReadValuesSpaced(int64_t values_with_nulls,
+                                                             int64_t null_count) {
+  const int num_values = static_cast<int>(values_with_nulls - null_count);
+  uint8_t* bitmap = values_->mutable_data();
+  const uint8_t* valid_bits = valid_bits_->data();
+  if (current_decoder_->encoding() == Encoding::PLAIN) {
+    auto decoder = static_cast<PlainDecoder<BooleanType>*>(current_decoder_);
+    decoder->DecodeBitmapSpaced(
+        bitmap, values_written_, static_cast<int>(values_with_nulls),
+        static_cast<int>(null_count), valid_bits, values_written_);
+    return;
+  }
+  PARQUET_THROW_NOT_OK(scratch_->Resize(num_values * sizeof(bool), false));
+  auto values = reinterpret_cast<bool*>(scratch_->mutable_data());
+  if (current_decoder_->Decode(values, num_values) != num_values) {
+    ParquetException::EofException();
+  }
+  int value_index = 0;
+  for (int64_t i = 0; i < values_with_nulls; i++) {
+    const int64_t slot = values_written_ + i;
+    const bool is_valid = BitUtil::GetBit(valid_bits, slot);
+    BitUtil::SetBitTo(bitmap, slot, is_valid && values[value_index]);
+    value_index += is_valid;
   }
-  ResetValues();
 }
 
 template <typename DType>
@@ -602,9 +1319,6 @@ inline void TypedRecordReader<DType>::ConfigureDictionary(const DictionaryPage*
 
   if (page->encoding() == Encoding::PLAIN_DICTIONARY ||
       page->encoding() == Encoding::PLAIN) {
-    PlainDecoder<DType> dictionary(descr_);
-    dictionary.SetData(page->num_values(), page->data(), page->size());
-
     // The dictionary is fully decoded during DictionaryDecoder::Init, so the
     // DictionaryPage buffer is no longer required after this step
     //
@@ -612,8 +1326,38 @@ inline void TypedRecordReader<DType>::ConfigureDictionary(const DictionaryPage*
     // dictionary makes sense and whether performance can be improved
 
     auto decoder = std::make_shared<DictionaryDecoder<DType>>(descr_, pool_);
-    decoder->SetDict(&dictionary);
+    auto DecodeDictionary = [this, page, &decoder]() {
+      DecodedDictionary cached;
+      if (page->GetDecodedDictionary(&cached)) {
+        decoder->SetDict(cached);
+      } else {
+        PlainDecoder<DType> dictionary(descr_);
+        dictionary.SetData(page->num_values(), page->data(), page->size());
+        decoder->SetDict(&dictionary);
+        page->PutDecodedDictionary(decoder->decoded_dictionary());
+      }
+      return decoder->decoded_dictionary();
+    };
+    if (IsPreviousDictionary(page)) {
+      decoder->SetDict(previous_dictionary_);
+    } else {
+      if (shared_dictionary_ != nullptr) {
+        decoder->SetDict(shared_dictionary_->Get(DecodeDictionary));
+      } else {
+        DecodeDictionary();
+      }
+      // The page buffer may be reused for the following pages
+      previous_dictionary_page_ = AllocateBuffer(pool_, page->size());
+      memcpy(previous_dictionary_page_->mutable_data(), page->data(),
+             static_cast<size_t>(page->size()));
+      previous_dictionary_num_values_ = page->num_values();
+      previous_dictionary_ = decoder->decoded_dictionary();
+    }
     decoders_[encoding] = decoder;
+
+    if (read_dictionary_) {
+      AppendDictionary(decoder.get());
+    }
   } else {
     ParquetException::NYI("only plain dictionary encoding has been implemented");
   }
@@ -625,6 +1369,8 @@ template <typename DType>
 bool TypedRecordReader<DType>::ReadNewPage() {
   // Loop until we find the next data page.
   const uint8_t* buffer;
+  int64_t data_size;
+  Encoding::type encoding;
 
   while (true) {
     current_page_ = pager_->NextPage();
@@ -650,7 +1396,7 @@ bool TypedRecordReader<DType>::ReadNewPage() {
       // If the data page includes repetition and definition levels, we
       // initialize the level decoder and subtract the encoded level bytes from
       // the page size to determine the number of bytes in the encoded data.
-      int64_t data_size = page->size();
+      data_size = page->size();
 
       // Data page Layout: Repetition Levels - Definition Levels - encoded values.
       // Levels are encoded as rle or bit-packed.
@@ -673,80 +1419,133 @@ bool TypedRecordReader<DType>::ReadNewPage() {
         buffer += def_levels_bytes;
         data_size -= def_levels_bytes;
       }
+      encoding = page->encoding();
+    } else if (current_page_->type() == PageType::DATA_PAGE_V2) {
+      const DataPageV2* page = static_cast<const DataPageV2*>(current_page_.get());
 
-      // Get a decoder object for this page or create a new decoder if this is the
-      // first page with this encoding.
-      Encoding::type encoding = page->encoding();
+      num_buffered_values_ = page->num_values();
+      num_decoded_values_ = 0;
+      buffer = page->data();
+      data_size = page->size();
 
-      if (IsDictionaryIndexEncoding(encoding)) {
-        encoding = Encoding::RLE_DICTIONARY;
+      // Data page V2 layout: Repetition Levels - Definition Levels - encoded
+      // values. The levels are RLE encoded and have no length prefix.
+      if (page->repetition_levels_byte_length() + page->definition_levels_byte_length() >
+          data_size) {
+        throw ParquetException("Levels of the data page are larger than the page");
       }
+      if (descr_->max_repetition_level() > 0) {
+        repetition_level_decoder_.SetDataV2(page->repetition_levels_byte_length(),
+                                            descr_->max_repetition_level(),
+                                            static_cast<int>(num_buffered_values_),
+                                            buffer);
+      }
+      buffer += page->repetition_levels_byte_length();
+      data_size -= page->repetition_levels_byte_length();
 
-      auto it = decoders_.find(static_cast<int>(encoding));
-      if (it != decoders_.end()) {
-        if (encoding == Encoding::RLE_DICTIONARY) {
-          DCHECK(current_decoder_->encoding() == Encoding::RLE_DICTIONARY);
-        }
-        current_decoder_ = it->second.get();
-      } else {
-        switch (encoding) {
-          case Encoding::PLAIN: {
-            std::shared_ptr<DecoderType> decoder(new PlainDecoder<DType>(descr_));
-            decoders_[static_cast<int>(encoding)] = decoder;
-            current_decoder_ = decoder.get();
-            break;
-          }
-          case Encoding::RLE_DICTIONARY:
-            throw ParquetException("Dictionary page must be before data page.");
-
-          case Encoding::DELTA_BINARY_PACKED:
-          case Encoding::DELTA_LENGTH_BYTE_ARRAY:
-          case Encoding::DELTA_BYTE_ARRAY:
-            ParquetException::NYI("Unsupported encoding");
-
-          default:
-            throw ParquetException("Unknown encoding type.");
-        }
+      if (descr_->max_definition_level() > 0) {
+        definition_level_decoder_.SetDataV2(page->definition_levels_byte_length(),
+                                            descr_->max_definition_level(),
+                                            static_cast<int>(num_buffered_values_),
+                                            buffer);
       }
-      current_decoder_->SetData(static_cast<int>(num_buffered_values_), buffer,
-                                static_cast<int>(data_size));
-      return true;
+      buffer += page->definition_levels_byte_length();
+      data_size -= page->definition_levels_byte_length();
+      encoding = page->encoding();
     } else {
       // We don't know what this page type is. We're allowed to skip non-data
       // pages.
       continue;
     }
+
+    // Get a decoder object for this page or create a new decoder if this is the
+    // first page with this encoding.
+    if (IsDictionaryIndexEncoding(encoding)) {
+      encoding = Encoding::RLE_DICTIONARY;
+    }
+
+    auto it = decoders_.find(static_cast<int>(encoding));
+    if (it != decoders_.end()) {
+      if (encoding == Encoding::RLE_DICTIONARY) {
+        DCHECK(current_decoder_->encoding() == Encoding::RLE_DICTIONARY);
+      }
+      current_decoder_ = it->second.get();
+    } else {
+      switch (encoding) {
+        case Encoding::PLAIN: {
+          std::shared_ptr<DecoderType> decoder(new PlainDecoder<DType>(descr_));
+          decoders_[static_cast<int>(encoding)] = decoder;
+          current_decoder_ = decoder.get();
+          break;
+        }
+        case Encoding::RLE_DICTIONARY:
+          throw ParquetException("Dictionary page must be before data page.");
+
+        case Encoding::DELTA_BINARY_PACKED:
+        case Encoding::DELTA_LENGTH_BYTE_ARRAY:
+        case Encoding::DELTA_BYTE_ARRAY: {
+          std::shared_ptr<DecoderType> decoder =
+              MakeDeltaDecoder<DType>(encoding, descr_, pool_);
+          decoders_[static_cast<int>(encoding)] = decoder;
+          current_decoder_ = decoder.get();
+          break;
+        }
+
+        case Encoding::BYTE_STREAM_SPLIT: {
+          std::shared_ptr<DecoderType> decoder =
+              MakeByteStreamSplitDecoder<DType>(descr_);
+          decoders_[static_cast<int>(encoding)] = decoder;
+          current_decoder_ = decoder.get();
+          break;
+        }
+
+        default:
+          throw ParquetException("Unknown encoding type.");
+      }
+    }
+    current_decoder_->SetData(static_cast<int>(num_buffered_values_), buffer,
+                              static_cast<int>(data_size));
+    return true;
   }
   return true;
 }
 
+template <typename DType>
+static RecordReader::RecordReaderImpl* MakeTypedRecordReader(
+    const ColumnDescriptor* descr, MemoryPool* pool, bool read_dictionary) {
+  if (descr->max_definition_level() == 0 && descr->max_repetition_level() == 0) {
+    return new RequiredRecordReader<DType>(descr, pool, read_dictionary);
+  }
+  return new TypedRecordReader<DType>(descr, pool, read_dictionary);
+}
+
 std::shared_ptr<RecordReader> RecordReader::Make(const ColumnDescriptor* descr,
-                                                 MemoryPool* pool) {
+                                                 MemoryPool* pool, bool read_dictionary) {
   switch (descr->physical_type()) {
     case Type::BOOLEAN:
       return std::shared_ptr<RecordReader>(
-          new RecordReader(new TypedRecordReader<BooleanType>(descr, pool)));
+          new RecordReader(MakeTypedRecordReader<BooleanType>(descr, pool, false)));
     case Type::INT32:
       return std::shared_ptr<RecordReader>(
-          new RecordReader(new TypedRecordReader<Int32Type>(descr, pool)));
+          new RecordReader(MakeTypedRecordReader<Int32Type>(descr, pool, false)));
     case Type::INT64:
       return std::shared_ptr<RecordReader>(
-          new RecordReader(new TypedRecordReader<Int64Type>(descr, pool)));
+          new RecordReader(MakeTypedRecordReader<Int64Type>(descr, pool, false)));
     case Type::INT96:
       return std::shared_ptr<RecordReader>(
-          new RecordReader(new TypedRecordReader<Int96Type>(descr, pool)));
+          new RecordReader(MakeTypedRecordReader<Int96Type>(descr, pool, false)));
     case Type::FLOAT:
       return std::shared_ptr<RecordReader>(
-          new RecordReader(new TypedRecordReader<FloatType>(descr, pool)));
+          new RecordReader(MakeTypedRecordReader<FloatType>(descr, pool, false)));
     case Type::DOUBLE:
       return std::shared_ptr<RecordReader>(
-          new RecordReader(new TypedRecordReader<DoubleType>(descr, pool)));
+          new RecordReader(MakeTypedRecordReader<DoubleType>(descr, pool, false)));
     case Type::BYTE_ARRAY:
-      return std::shared_ptr<RecordReader>(
-          new RecordReader(new TypedRecordReader<ByteArrayType>(descr, pool)));
+      return std::shared_ptr<RecordReader>(new RecordReader(
+          MakeTypedRecordReader<ByteArrayType>(descr, pool, read_dictionary)));
     case Type::FIXED_LEN_BYTE_ARRAY:
       return std::shared_ptr<RecordReader>(
-          new RecordReader(new TypedRecordReader<FLBAType>(descr, pool)));
+          new RecordReader(MakeTypedRecordReader<FLBAType>(descr, pool, false)));
     default:
       DCHECK(false);
   }
@@ -765,6 +1564,10 @@ int64_t RecordReader::ReadRecords(int64_t num_records) {
   return impl_->ReadRecords(num_records);
 }
 
+int64_t RecordReader::SkipRecords(int64_t num_records) {
+  return impl_->SkipRecords(num_records);
+}
+
 void RecordReader::Reset() { return impl_->Reset(); }
 
 void RecordReader::Reserve(int64_t num_values) { impl_->Reserve(num_values); }
@@ -775,16 +1578,38 @@ const int16_t* RecordReader::rep_levels() const { return impl_->rep_levels(); }
 
 const uint8_t* RecordReader::values() const { return impl_->values(); }
 
-std::shared_ptr<PoolBuffer> RecordReader::ReleaseValues() {
+std::shared_ptr<Buffer> RecordReader::ReleaseValues() {
   return impl_->ReleaseValues();
 }
 
-std::shared_ptr<PoolBuffer> RecordReader::ReleaseIsValid() {
+std::shared_ptr<ResizableBuffer> RecordReader::ReleaseIsValid() {
   return impl_->ReleaseIsValid();
 }
 
+std::shared_ptr<ResizableBuffer> RecordReader::ReleaseBinaryData() {
+  return impl_->ReleaseBinaryData();
+}
+
+void RecordReader::RecycleBuffer(std::shared_ptr<Buffer> buffer) {
+  impl_->RecycleBuffer(std::move(buffer));
+}
+
+int64_t RecordReader::memory_usage() { return impl_->memory_usage(); }
+
+void RecordReader::SetOutputBuffers(const std::shared_ptr<ResizableBuffer>& values,
+                                    const std::shared_ptr<ResizableBuffer>& valid_bits,
+                                    const std::shared_ptr<ResizableBuffer>& binary_data) {
+  impl_->SetOutputBuffers(values, valid_bits, binary_data);
+}
+
 ::arrow::ArrayBuilder* RecordReader::builder() { return impl_->builder(); }
 
+bool RecordReader::read_dictionary() const { return impl_->read_dictionary(); }
+
+std::shared_ptr<::arrow::Array> RecordReader::ReleaseDictionary() {
+  return impl_->ReleaseDictionary();
+}
+
 int64_t RecordReader::values_written() const { return impl_->values_written(); }
 
 int64_t RecordReader::levels_position() const { return impl_->levels_position(); }
@@ -795,11 +1620,27 @@ int64_t RecordReader::null_count() const { return impl_->null_count(); }
 
 bool RecordReader::nullable_values() const { return impl_->nullable_values(); }
 
+const ColumnDescriptor* RecordReader::descr() const { return impl_->descr(); }
+
 bool RecordReader::HasMoreData() const { return impl_->HasMoreData(); }
 
 void RecordReader::SetPageReader(std::unique_ptr<PageReader> reader) {
   impl_->SetPageReader(std::move(reader));
 }
 
+void RecordReader::set_shared_dictionary(std::shared_ptr<SharedDictionary> dictionary) {
+  impl_->set_shared_dictionary(std::move(dictionary));
+}
+
+DecodedDictionary SharedDictionary::Get(
+    const std::function<DecodedDictionary()>& decode) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (!decoded_) {
+    dictionary_ = decode();
+    decoded_ = true;
+  }
+  return dictionary_;
+}
+
 }  // namespace internal
 }  // namespace parquet
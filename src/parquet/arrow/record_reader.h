@@ -20,8 +20,10 @@
 
 #include <cstdint>
 #include <cstring>
+#include <functional>
 #include <iostream>
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 
@@ -31,12 +33,30 @@
 #include <arrow/util/bit-util.h>
 
 #include "parquet/column_reader.h"
+#include "parquet/encoding.h"
 #include "parquet/schema.h"
 #include "parquet/util/visibility.h"
 
 namespace parquet {
 namespace internal {
 
+/// \brief Dictionary of a column chunk that is decoded once and shared by the
+/// RecordReaders that read ranges of the chunk's pages concurrently.
+/// Thread-safe
+class SharedDictionary {
+ public:
+  SharedDictionary() : decoded_(false) {}
+
+  /// \brief The dictionary; the first caller decodes it with decode while
+  /// the others wait for it
+  DecodedDictionary Get(const std::function<DecodedDictionary()>& decode);
+
+ private:
+  std::mutex mutex_;
+  bool decoded_;
+  DecodedDictionary dictionary_;
+};
+
 /// \brief Stateful column reader that delimits semantic records for both flat
 /// and nested columns
 ///
@@ -47,25 +67,40 @@ class RecordReader {
   // So that we can create subclasses
   class RecordReaderImpl;
 
+  /// \param[in] read_dictionary for BYTE_ARRAY columns, decode int32 indices
+  /// into values() and collect the dictionaries in builder() instead of
+  /// appending every value to builder()
   static std::shared_ptr<RecordReader> Make(
       const ColumnDescriptor* descr,
-      ::arrow::MemoryPool* pool = ::arrow::default_memory_pool());
+      ::arrow::MemoryPool* pool = ::arrow::default_memory_pool(),
+      bool read_dictionary = false);
 
   virtual ~RecordReader();
 
-  /// \brief Decoded definition levels
+  /// \brief Decoded definition levels. Not buffered for the optional columns
+  /// at the top level of the schema that are not repeated, their levels are
+  /// decoded into the validity bitmap directly
   const int16_t* def_levels() const;
 
   /// \brief Decoded repetition levels
   const int16_t* rep_levels() const;
 
-  /// \brief Decoded values, including nulls, if any
+  /// \brief Decoded values, including nulls, if any. For BYTE_ARRAY columns
+  /// these are values_written() + 1 int32 offsets into the binary data, for
+  /// FIXED_LEN_BYTE_ARRAY columns the values' bytes, for BOOLEAN columns a
+  /// bitmap of the values
   const uint8_t* values() const;
 
   /// \brief Attempt to read indicated number of records from column chunk
   /// \return number of records read
   int64_t ReadRecords(int64_t num_records);
 
+  /// \brief Skip the indicated number of records without decoding their
+  /// values where the encoding allows it. Whole data pages of columns that
+  /// are not repeated are dropped without being decoded
+  /// \return number of records skipped
+  int64_t SkipRecords(int64_t num_records);
+
   /// \brief Pre-allocate space for data. Results in better flat read performance
   void Reserve(int64_t num_values);
 
@@ -73,10 +108,49 @@ class RecordReader {
   /// result of calling ReadRecords
   void Reset();
 
-  std::shared_ptr<PoolBuffer> ReleaseValues();
-  std::shared_ptr<PoolBuffer> ReleaseIsValid();
+  /// \brief The values of the batch. For columns that are neither nullable
+  /// nor BOOLEAN, the values of a batch that is read from a single PLAIN
+  /// encoded data page are a slice of the page rather than a copy if the
+  /// page shares the bytes of the file, e.g. for uncompressed, memory mapped
+  /// files
+  std::shared_ptr<Buffer> ReleaseValues();
+  std::shared_ptr<ResizableBuffer> ReleaseIsValid();
+
+  /// \brief Bytes of the decoded BYTE_ARRAY values that the offsets in
+  /// values() refer to
+  std::shared_ptr<ResizableBuffer> ReleaseBinaryData();
+
+  /// \brief Return a buffer released by this reader once it is consumed, to
+  /// replace the buffers released by the following batches with. The
+  /// released buffers start with the capacity of the previous ones either
+  /// way. Ignored unless buffer is the only reference to it
+  void RecycleBuffer(std::shared_ptr<Buffer> buffer);
+
+  /// \brief Bytes the reader holds in memory: the buffers of the current
+  /// batch and those kept to be reused, the decoded dictionary and those of
+  /// its PageReader
+  int64_t memory_usage();
+
+  /// \brief Decode the values of the next batch into buffers of the caller,
+  /// which are emptied and grown with Resize as needed. They are handed
+  /// back by the Release functions. valid_bits is only used if the values
+  /// are nullable, binary_data only for BYTE_ARRAY values. Values are never
+  /// borrowed from the data pages for such a batch
+  void SetOutputBuffers(const std::shared_ptr<ResizableBuffer>& values,
+                        const std::shared_ptr<ResizableBuffer>& valid_bits,
+                        const std::shared_ptr<ResizableBuffer>& binary_data);
+
+  /// \brief Dictionary values if read_dictionary() is set, nullptr otherwise
   ::arrow::ArrayBuilder* builder();
 
+  /// \brief True if values() holds indices into a dictionary
+  bool read_dictionary() const;
+
+  /// \brief Finish the dictionary that the indices in values() refer to. The
+  /// dictionary of the current column chunk is kept for the indices that are
+  /// read afterwards
+  std::shared_ptr<::arrow::Array> ReleaseDictionary();
+
   /// \brief Number of values written including nulls (if any)
   int64_t values_written() const;
 
@@ -94,6 +168,8 @@ class RecordReader {
   /// \brief True if the leaf values are nullable
   bool nullable_values() const;
 
+  const ColumnDescriptor* descr() const;
+
   /// \brief Return true if the record reader has more internal data yet to
   /// process
   bool HasMoreData() const;
@@ -102,6 +178,11 @@ class RecordReader {
   /// \param[in] reader obtained from RowGroupReader::GetColumnPageReader
   void SetPageReader(std::unique_ptr<PageReader> reader);
 
+  /// \brief Take the decoded dictionary of the column chunk from dictionary
+  /// instead of decoding the dictionary page. Only for readers of a single
+  /// column chunk
+  void set_shared_dictionary(std::shared_ptr<SharedDictionary> dictionary);
+
  private:
   std::unique_ptr<RecordReaderImpl> impl_;
   explicit RecordReader(RecordReaderImpl* impl);
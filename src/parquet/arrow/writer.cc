@@ -18,6 +18,9 @@
 #include "parquet/arrow/writer.h"
 
 #include <algorithm>
+#include <cstring>
+#include <functional>
+#include <limits>
 #include <string>
 #include <vector>
 
@@ -28,12 +31,15 @@
 
 #include "parquet/arrow/schema.h"
 #include "parquet/util/logging.h"
+#include "parquet/util/temporal.h"
+#include "parquet/util/thread-pool.h"
 
 using arrow::Array;
 using arrow::BinaryArray;
 using arrow::BooleanArray;
 using arrow::ChunkedArray;
 using arrow::Decimal128Array;
+using arrow::DictionaryArray;
 using arrow::Field;
 using arrow::FixedSizeBinaryArray;
 using arrow::Int16Array;
@@ -44,6 +50,7 @@ using arrow::NumericArray;
 using arrow::PoolBuffer;
 using arrow::PrimitiveArray;
 using arrow::Status;
+using arrow::StructArray;
 using arrow::Table;
 using arrow::TimeUnit;
 
@@ -68,10 +75,35 @@ std::shared_ptr<ArrowWriterProperties> default_arrow_writer_properties() {
 
 namespace {
 
+// Levels of a leaf of a nested column and its values. The validity bitmap of
+// the values also has the nulls of the groups above the leaf, and the level
+// buffers may be shared with other leaves of the same column.
+struct LeafLevels {
+  std::shared_ptr<std::vector<int16_t>> def_levels;
+  // nullptr without a repeated ancestor
+  std::shared_ptr<std::vector<int16_t>> rep_levels;
+  std::shared_ptr<Array> values;
+};
+
+// Levels of the entries of a nesting level of a nested column, shared by all
+// the leaves below it. Entry i is stored in slot slots[i] of the arrays of the
+// level, or has no slot (-1) if it belongs to a null or empty list.
+struct NestedLevels {
+  std::shared_ptr<std::vector<int16_t>> def_levels;
+  // nullptr without a repeated ancestor
+  std::shared_ptr<std::vector<int16_t>> rep_levels;
+  std::shared_ptr<std::vector<int64_t>> slots;
+
+  // Levels of the entries that are defined down to this level
+  int16_t def_level;
+  int16_t rep_level;
+};
+
 class LevelBuilder {
  public:
   explicit LevelBuilder(MemoryPool* pool)
-      : def_levels_(::arrow::int16(), pool), rep_levels_(::arrow::int16(), pool) {}
+      : def_levels_(::arrow::int16(), pool), rep_levels_(::arrow::int16(), pool),
+        pool_(pool) {}
 
   Status VisitInline(const Array& array);
 
@@ -97,6 +129,16 @@ class LevelBuilder {
     return VisitInline(*array.values());
   }
 
+  // Dictionary arrays are leaves like the flat arrays, the indices and the
+  // dictionary are written as they are by ArrowColumnWriter::WriteDictionary
+  Status Visit(const DictionaryArray& array) {
+    array_offsets_.push_back(static_cast<int32_t>(array.offset()));
+    valid_bitmaps_.push_back(array.null_bitmap_data());
+    null_counts_.push_back(array.null_count());
+    values_array_ = std::make_shared<DictionaryArray>(array.data());
+    return Status::OK();
+  }
+
 #define NOT_IMPLEMENTED_VISIT(ArrowTypePrefix)                             \
   Status Visit(const ::arrow::ArrowTypePrefix##Array& array) {             \
     return Status::NotImplemented("Level generation for " #ArrowTypePrefix \
@@ -105,7 +147,6 @@ class LevelBuilder {
 
   NOT_IMPLEMENTED_VISIT(Struct)
   NOT_IMPLEMENTED_VISIT(Union)
-  NOT_IMPLEMENTED_VISIT(Dictionary)
 
   Status GenerateLevels(const Array& array, const std::shared_ptr<Field>& field,
                         int64_t* values_offset, int64_t* num_values, int64_t* num_levels,
@@ -179,6 +220,23 @@ class LevelBuilder {
     return Status::OK();
   }
 
+  // Levels of all the leaves of a column with structs, in schema order. Unlike
+  // the list-only columns of GenerateLevels, the levels of every struct and
+  // list are computed once and reused for all the leaves below it.
+  Status GenerateNestedLevels(const Array& array, const std::shared_ptr<Field>& field,
+                              std::vector<LeafLevels>* leaves) {
+    const int64_t length = array.length();
+    NestedLevels root;
+    root.def_levels = std::make_shared<std::vector<int16_t>>(length, 0);
+    root.slots = std::make_shared<std::vector<int64_t>>(length);
+    for (int64_t i = 0; i < length; i++) {
+      (*root.slots)[i] = i;
+    }
+    root.def_level = 0;
+    root.rep_level = 0;
+    return HandleNested(array, field, root, leaves);
+  }
+
   Status HandleList(int16_t def_level, int16_t rep_level, int64_t index) {
     if (nullable_[rep_level]) {
       if (null_counts_[rep_level] == 0 ||
@@ -238,6 +296,169 @@ class LevelBuilder {
   }
 
  private:
+  Status HandleNested(const Array& array, const std::shared_ptr<Field>& field,
+                      const NestedLevels& parent, std::vector<LeafLevels>* leaves) {
+    NestedLevels levels;
+    switch (array.type()->id()) {
+      case ::arrow::Type::STRUCT: {
+        const auto& struct_array = static_cast<const StructArray&>(array);
+        StructLevels(struct_array, *field, parent, &levels);
+        for (int i = 0; i < field->type()->num_children(); i++) {
+          // The children are not sliced with the struct
+          std::shared_ptr<Array> child =
+              ::arrow::MakeArray(struct_array.data()->child_data[i])
+                  ->Slice(struct_array.offset(), struct_array.length());
+          RETURN_NOT_OK(HandleNested(*child, field->type()->child(i), levels, leaves));
+        }
+        return Status::OK();
+      }
+      case ::arrow::Type::LIST: {
+        const auto& list_array = static_cast<const ListArray&>(array);
+        ListLevels(list_array, *field, parent, &levels);
+        return HandleNested(*list_array.values(), field->type()->child(0), levels,
+                            leaves);
+      }
+      default: {
+        LeafLevels leaf;
+        RETURN_NOT_OK(LeafLevelsOf(array, *field, parent, &leaf));
+        leaves->push_back(std::move(leaf));
+        return Status::OK();
+      }
+    }
+  }
+
+  void StructLevels(const StructArray& array, const Field& field,
+                    const NestedLevels& parent, NestedLevels* out) {
+    // The entries keep the slots, the children are aligned with the struct
+    out->slots = parent.slots;
+    out->rep_levels = parent.rep_levels;
+    out->rep_level = parent.rep_level;
+    if (!field.nullable()) {
+      out->def_levels = parent.def_levels;
+      out->def_level = parent.def_level;
+      return;
+    }
+    out->def_level = static_cast<int16_t>(parent.def_level + 1);
+    out->def_levels = std::make_shared<std::vector<int16_t>>(*parent.def_levels);
+    const std::vector<int64_t>& slots = *parent.slots;
+    std::vector<int16_t>& def_levels = *out->def_levels;
+    for (size_t i = 0; i < slots.size(); i++) {
+      if (def_levels[i] == parent.def_level && array.IsValid(slots[i])) {
+        def_levels[i] = out->def_level;
+      }
+    }
+  }
+
+  void ListLevels(const ListArray& array, const Field& field, const NestedLevels& parent,
+                  NestedLevels* out) {
+    // Defined but empty lists have list_def_level
+    const auto list_def_level =
+        static_cast<int16_t>(parent.def_level + (field.nullable() ? 1 : 0));
+    out->def_level = static_cast<int16_t>(list_def_level + 1);
+    out->rep_level = static_cast<int16_t>(parent.rep_level + 1);
+    out->def_levels = std::make_shared<std::vector<int16_t>>();
+    out->rep_levels = std::make_shared<std::vector<int16_t>>();
+    out->slots = std::make_shared<std::vector<int64_t>>();
+
+    const std::vector<int64_t>& slots = *parent.slots;
+    for (size_t i = 0; i < slots.size(); i++) {
+      const int16_t def_level = (*parent.def_levels)[i];
+      const int16_t rep_level = parent.rep_levels ? (*parent.rep_levels)[i] : 0;
+      const int64_t slot = slots[i];
+      if (def_level < parent.def_level || (field.nullable() && array.IsNull(slot))) {
+        // Null here or above, the entry has no elements
+        out->def_levels->push_back(def_level);
+        out->rep_levels->push_back(rep_level);
+        out->slots->push_back(-1);
+        continue;
+      }
+      const int32_t begin = array.value_offset(slot);
+      const int32_t length = array.value_offset(slot + 1) - begin;
+      if (length == 0) {
+        out->def_levels->push_back(list_def_level);
+        out->rep_levels->push_back(rep_level);
+        out->slots->push_back(-1);
+      }
+      for (int32_t j = 0; j < length; j++) {
+        out->def_levels->push_back(out->def_level);
+        out->rep_levels->push_back(j == 0 ? rep_level : out->rep_level);
+        out->slots->push_back(begin + j);
+      }
+    }
+  }
+
+  Status LeafLevelsOf(const Array& array, const Field& field, const NestedLevels& parent,
+                      LeafLevels* out) {
+    const std::vector<int64_t>& slots = *parent.slots;
+    const std::vector<int16_t>& parent_def_levels = *parent.def_levels;
+    const bool is_null_type = array.type()->id() == ::arrow::Type::NA;
+
+    // The values of the slots are written, they have to be contiguous as for
+    // GenerateLevels. Some of them are undefined if a struct above is null.
+    int64_t first_slot = -1;
+    int64_t num_slots = 0;
+    bool has_undefined_slots = false;
+    for (size_t i = 0; i < slots.size(); i++) {
+      if (slots[i] < 0) {
+        continue;
+      }
+      if (first_slot < 0) {
+        first_slot = slots[i];
+      } else if (slots[i] != first_slot + num_slots) {
+        return Status::NotImplemented("Null lists with elements are not supported");
+      }
+      ++num_slots;
+      has_undefined_slots |= parent_def_levels[i] < parent.def_level;
+    }
+    first_slot = std::max<int64_t>(first_slot, 0);
+
+    out->rep_levels = parent.rep_levels;
+    if (field.nullable()) {
+      const auto def_level = static_cast<int16_t>(parent.def_level + 1);
+      out->def_levels = std::make_shared<std::vector<int16_t>>(parent_def_levels);
+      for (size_t i = 0; i < slots.size(); i++) {
+        if (parent_def_levels[i] == parent.def_level && !is_null_type &&
+            array.IsValid(slots[i])) {
+          (*out->def_levels)[i] = def_level;
+        }
+      }
+    } else {
+      out->def_levels = parent.def_levels;
+    }
+
+    std::shared_ptr<Array> values = array.Slice(first_slot, num_slots);
+    if (!has_undefined_slots || is_null_type) {
+      out->values = values;
+      return Status::OK();
+    }
+
+    // Mark the slots below null structs as null
+    auto data = std::make_shared<::arrow::ArrayData>(*values->data());
+    const int64_t array_offset = data->offset;
+    auto valid_bits = std::make_shared<PoolBuffer>(pool_);
+    RETURN_NOT_OK(valid_bits->Resize(BitUtil::BytesForBits(array_offset + num_slots)));
+    int64_t null_count = 0;
+    int64_t k = 0;
+    for (size_t i = 0; i < slots.size(); i++) {
+      if (slots[i] < 0) {
+        continue;
+      }
+      const int16_t leaf_def_level = (*out->def_levels)[i];
+      const bool valid = leaf_def_level == parent.def_level + (field.nullable() ? 1 : 0);
+      if (valid) {
+        BitUtil::SetBit(valid_bits->mutable_data(), array_offset + k);
+      } else {
+        BitUtil::ClearBit(valid_bits->mutable_data(), array_offset + k);
+        ++null_count;
+      }
+      ++k;
+    }
+    data->buffers[0] = valid_bits;
+    data->null_count = null_count;
+    out->values = ::arrow::MakeArray(data);
+    return Status::OK();
+  }
+
   Int16Builder def_levels_;
   Int16Builder rep_levels_;
 
@@ -250,6 +471,8 @@ class LevelBuilder {
   int64_t min_offset_idx_;
   int64_t max_offset_idx_;
   std::shared_ptr<Array> values_array_;
+
+  MemoryPool* pool_;
 };
 
 Status LevelBuilder::VisitInline(const Array& array) {
@@ -281,15 +504,125 @@ struct ColumnWriterContext {
   std::shared_ptr<PoolBuffer> def_levels_buffer;
 };
 
-Status GetLeafType(const ::arrow::DataType& type, ::arrow::Type::type* leaf_type) {
-  if (type.id() == ::arrow::Type::LIST || type.id() == ::arrow::Type::STRUCT) {
-    if (type.num_children() != 1) {
-      return Status::Invalid("Nested column branch had multiple children");
+// Call func with the consecutive slices of the chunks of data that make up
+// [offset, offset + size)
+Status VisitSlices(const ChunkedArray& data, int64_t offset, const int64_t size,
+                   const std::function<Status(const Array&)>& func) {
+  int64_t absolute_position = 0;
+  int chunk_index = 0;
+  int64_t chunk_offset = 0;
+  while (chunk_index < data.num_chunks() && absolute_position < offset) {
+    const int64_t chunk_length = data.chunk(chunk_index)->length();
+    if (absolute_position + chunk_length > offset) {
+      // Relative offset into the chunk to reach the desired start offset for
+      // writing
+      chunk_offset = offset - absolute_position;
+      break;
+    } else {
+      ++chunk_index;
+      absolute_position += chunk_length;
     }
-    return GetLeafType(*type.child(0)->type(), leaf_type);
-  } else {
-    *leaf_type = type.id();
-    return Status::OK();
+  }
+
+  if (absolute_position >= data.length()) {
+    return Status::Invalid("Cannot write data at offset past end of chunked array");
+  }
+
+  int64_t values_written = 0;
+  while (values_written < size) {
+    const Array& chunk = *data.chunk(chunk_index);
+    const int64_t available_values = chunk.length() - chunk_offset;
+    const int64_t chunk_write_size = std::min(size - values_written, available_values);
+
+    // The chunk offset here will be 0 except for possibly the first chunk
+    // because of the advancing logic above
+    std::shared_ptr<Array> array_to_write = chunk.Slice(chunk_offset, chunk_write_size);
+    RETURN_NOT_OK(func(*array_to_write));
+
+    if (chunk_write_size == available_values) {
+      chunk_offset = 0;
+      ++chunk_index;
+    }
+    values_written += chunk_write_size;
+  }
+
+  return Status::OK();
+}
+
+// Columns with a struct anywhere are written with
+// LevelBuilder::GenerateNestedLevels, they may have several leaves
+bool HasStruct(const ::arrow::DataType& type) {
+  if (type.id() == ::arrow::Type::STRUCT) {
+    return true;
+  }
+  for (int i = 0; i < type.num_children(); i++) {
+    if (HasStruct(*type.child(i)->type())) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// Number of Parquet leaf columns of an Arrow column of type
+int NumLeaves(const ::arrow::DataType& type) {
+  if (type.num_children() == 0) {
+    return 1;
+  }
+  int num_leaves = 0;
+  for (int i = 0; i < type.num_children(); i++) {
+    num_leaves += NumLeaves(*type.child(i)->type());
+  }
+  return num_leaves;
+}
+
+// Whether dictionary arrays of type can be written into a column of
+// physical_type as indices and dictionary, without converting them to dense
+// arrays first
+bool CanWriteDictionary(const ::arrow::DictionaryType& type, Type::type physical_type) {
+  switch (type.dictionary()->type()->id()) {
+    case ::arrow::Type::INT32:
+      return physical_type == Type::INT32;
+    case ::arrow::Type::INT64:
+      return physical_type == Type::INT64;
+    case ::arrow::Type::FLOAT:
+      return physical_type == Type::FLOAT;
+    case ::arrow::Type::DOUBLE:
+      return physical_type == Type::DOUBLE;
+    case ::arrow::Type::BINARY:
+    case ::arrow::Type::STRING:
+      return physical_type == Type::BYTE_ARRAY;
+    default:
+      return false;
+  }
+}
+
+// Whether the column writer can take the definition levels of a flat array from
+// its validity bitmap. The types whose nulls are dropped from the values before
+// they are written need the levels to place the nulls.
+bool WritesLevelsFromBitmap(const Array& array) {
+  if (array.null_count() == 0) {
+    return true;
+  }
+  switch (array.type()->id()) {
+    case ::arrow::Type::NA:
+    case ::arrow::Type::BOOL:
+    case ::arrow::Type::FIXED_SIZE_BINARY:
+    case ::arrow::Type::DECIMAL:
+      return false;
+    default:
+      return true;
+  }
+}
+
+// Indices that do not fit into an int32 are replaced by -1, which the column
+// writer rejects as out of range
+template <typename ArrowType>
+void ConvertDictionaryIndices(const PrimitiveArray& indices, int32_t* out) {
+  const auto& typed_indices = static_cast<const NumericArray<ArrowType>&>(indices);
+  for (int64_t i = 0; i < indices.length(); i++) {
+    const int64_t index = typed_indices.Value(i);
+    out[i] = index > std::numeric_limits<int32_t>::max() ? -1
+                                                         : static_cast<int32_t>(index);
   }
 }
 
@@ -302,47 +635,14 @@ class ArrowColumnWriter {
   Status Write(const Array& data);
 
   Status Write(const ChunkedArray& data, int64_t offset, const int64_t size) {
-    int64_t absolute_position = 0;
-    int chunk_index = 0;
-    int64_t chunk_offset = 0;
-    while (chunk_index < data.num_chunks() && absolute_position < offset) {
-      const int64_t chunk_length = data.chunk(chunk_index)->length();
-      if (absolute_position + chunk_length > offset) {
-        // Relative offset into the chunk to reach the desired start offset for
-        // writing
-        chunk_offset = offset - absolute_position;
-        break;
-      } else {
-        ++chunk_index;
-        absolute_position += chunk_length;
-      }
-    }
-
-    if (absolute_position >= data.length()) {
-      return Status::Invalid("Cannot write data at offset past end of chunked array");
-    }
-
-    int64_t values_written = 0;
-    while (values_written < size) {
-      const Array& chunk = *data.chunk(chunk_index);
-      const int64_t available_values = chunk.length() - chunk_offset;
-      const int64_t chunk_write_size = std::min(size - values_written, available_values);
-
-      // The chunk offset here will be 0 except for possibly the first chunk
-      // because of the advancing logic above
-      std::shared_ptr<Array> array_to_write = chunk.Slice(chunk_offset, chunk_write_size);
-      RETURN_NOT_OK(Write(*array_to_write));
-
-      if (chunk_write_size == available_values) {
-        chunk_offset = 0;
-        ++chunk_index;
-      }
-      values_written += chunk_write_size;
-    }
-
-    return Status::OK();
+    return VisitSlices(data, offset, size,
+                       [this](const Array& slice) { return Write(slice); });
   }
 
+  // Write the values of a leaf with levels computed by the caller
+  Status WriteLeaf(const Array& values_array, int64_t num_levels,
+                   const int16_t* def_levels, const int16_t* rep_levels);
+
   Status Close() {
     PARQUET_CATCH_NOT_OK(writer_->Close());
     return Status::OK();
@@ -356,6 +656,9 @@ class ArrowColumnWriter {
   Status WriteTimestamps(const Array& data, int64_t num_levels, const int16_t* def_levels,
                          const int16_t* rep_levels);
 
+  Status WriteDictionary(const Array& data, int64_t num_levels, const int16_t* def_levels,
+                         const int16_t* rep_levels);
+
   Status WriteTimestampsCoerce(const Array& data, int64_t num_levels,
                                const int16_t* def_levels, const int16_t* rep_levels);
 
@@ -392,6 +695,26 @@ class ArrowColumnWriter {
     return Status::OK();
   }
 
+  template <typename ParquetType>
+  Status WriteBatchDictionary(int64_t num_levels, const int16_t* def_levels,
+                              const int16_t* rep_levels, const uint8_t* valid_bits,
+                              int64_t valid_bits_offset, const int32_t* indices,
+                              const typename ParquetType::c_type* dictionary,
+                              int64_t dictionary_length) {
+    auto typed_writer = static_cast<TypedColumnWriter<ParquetType>*>(writer_);
+    PARQUET_CATCH_NOT_OK(typed_writer->WriteBatchDictionary(
+        num_levels, def_levels, rep_levels, valid_bits, valid_bits_offset, indices,
+        dictionary, dictionary_length));
+    return Status::OK();
+  }
+
+  // Whether every slot of the leaf values holds a value, i.e. neither the leaf
+  // nor a group between it and its innermost repeated ancestor is optional
+  bool values_required() const {
+    const ColumnDescriptor* descr = writer_->descr();
+    return descr->repeated_ancestor_def_level() == descr->max_definition_level();
+  }
+
   ColumnWriterContext* ctx_;
   ColumnWriter* writer_;
   std::shared_ptr<Field> field_;
@@ -407,7 +730,7 @@ Status ArrowColumnWriter::TypedWriteBatch(const Array& array, int64_t num_levels
   auto values =
       reinterpret_cast<const ArrowCType*>(data.values()->data()) + data.offset();
 
-  if (writer_->descr()->schema_node()->is_required() || (data.null_count() == 0)) {
+  if (values_required() || (data.null_count() == 0)) {
     // no nulls, just dump the data
     RETURN_NOT_OK((WriteNonNullableBatch<ParquetType, ArrowType>(
         static_cast<const ArrowType&>(*array.type()), array.length(), num_levels,
@@ -562,9 +885,7 @@ Status ArrowColumnWriter::WriteNullableBatch<Int96Type, ::arrow::TimestampType>(
   Int96* buffer;
   RETURN_NOT_OK(ctx_->GetScratchData<Int96>(num_values, &buffer));
   if (type.unit() == TimeUnit::NANO) {
-    for (int i = 0; i < num_values; i++) {
-      internal::NanosecondsToImpalaTimestamp(values[i], &buffer[i]);
-    }
+    ::parquet::internal::NanosecondsToInt96(values, num_values, buffer);
   } else {
     return Status::NotImplemented("Only NANO timestamps are supported for Int96 writing");
   }
@@ -579,9 +900,7 @@ Status ArrowColumnWriter::WriteNonNullableBatch<Int96Type, ::arrow::TimestampTyp
   Int96* buffer;
   RETURN_NOT_OK(ctx_->GetScratchData<Int96>(num_values, &buffer));
   if (type.unit() == TimeUnit::NANO) {
-    for (int i = 0; i < num_values; i++) {
-      internal::NanosecondsToImpalaTimestamp(values[i], buffer + i);
-    }
+    ::parquet::internal::NanosecondsToInt96(values, num_values, buffer);
   } else {
     return Status::NotImplemented("Only NANO timestamps are supported for Int96 writing");
   }
@@ -629,22 +948,21 @@ Status ArrowColumnWriter::WriteTimestampsCoerce(const Array& array, int64_t num_
   auto target_type = ::arrow::timestamp(target_unit);
 
   auto DivideBy = [&](const int64_t factor) {
-    for (int64_t i = 0; i < array.length(); i++) {
-      if (!data.IsNull(i) && (values[i] % factor != 0)) {
-        std::stringstream ss;
-        ss << "Casting from " << type.ToString() << " to " << target_type->ToString()
-           << " would lose data: " << values[i];
-        return Status::Invalid(ss.str());
-      }
-      buffer[i] = values[i] / factor;
+    const bool check_truncation = !ctx_->properties->truncated_timestamps_allowed();
+    const int64_t lossy = ::parquet::internal::DivideTimestamps(
+        values, array.length(), factor, data.null_bitmap_data(), data.offset(),
+        check_truncation, buffer);
+    if (lossy >= 0) {
+      std::stringstream ss;
+      ss << "Casting from " << type.ToString() << " to " << target_type->ToString()
+         << " would lose data: " << values[lossy];
+      return Status::Invalid(ss.str());
     }
     return Status::OK();
   };
 
   auto MultiplyBy = [&](const int64_t factor) {
-    for (int64_t i = 0; i < array.length(); i++) {
-      buffer[i] = values[i] * factor;
-    }
+    ::parquet::internal::MultiplyTimestamps(values, array.length(), factor, buffer);
     return Status::OK();
   };
 
@@ -665,7 +983,7 @@ Status ArrowColumnWriter::WriteTimestampsCoerce(const Array& array, int64_t num_
     RETURN_NOT_OK(DivideBy(1000));
   }
 
-  if (writer_->descr()->schema_node()->is_required() || (data.null_count() == 0)) {
+  if (values_required() || (data.null_count() == 0)) {
     // no nulls, just dump the data
     RETURN_NOT_OK((WriteNonNullableBatch<Int64Type, ::arrow::TimestampType>(
         static_cast<const ::arrow::TimestampType&>(*target_type), array.length(),
@@ -679,30 +997,27 @@ Status ArrowColumnWriter::WriteTimestampsCoerce(const Array& array, int64_t num_
   return Status::OK();
 }
 
-// This specialization seems quite similar but it significantly differs in two points:
-// * offset is added at the most latest time to the pointer as we have sub-byte access
-// * Arrow data is stored bitwise thus we cannot use std::copy to transform from
-//   ArrowType::c_type to ParquetType::c_type
-
 template <>
 Status ArrowColumnWriter::TypedWriteBatch<BooleanType, ::arrow::BooleanType>(
     const Array& array, int64_t num_levels, const int16_t* def_levels,
     const int16_t* rep_levels) {
-  bool* buffer;
-  RETURN_NOT_OK(ctx_->GetScratchData<bool>(array.length(), &buffer));
-
   const auto& data = static_cast<const BooleanArray&>(array);
-  auto values = reinterpret_cast<const uint8_t*>(data.values()->data());
 
-  int buffer_idx = 0;
-  int64_t offset = array.offset();
-  for (int i = 0; i < data.length(); i++) {
-    if (!data.IsNull(i)) {
-      buffer[buffer_idx++] = BitUtil::GetBit(values, offset + i);
-    }
+  // The values are handed to the column writer as the bitmap they are in, the
+  // null entries are skipped by their bit in the validity bitmap
+  const uint8_t* values = nullptr;
+  if (data.values()) {
+    values = data.values()->data();
   }
-
-  return WriteBatch<BooleanType>(num_levels, def_levels, rep_levels, buffer);
+  const uint8_t* valid_bits = nullptr;
+  if (!values_required() && data.null_count() > 0) {
+    valid_bits = data.null_bitmap_data();
+  }
+  auto typed_writer = static_cast<TypedColumnWriter<BooleanType>*>(writer_);
+  PARQUET_CATCH_NOT_OK(typed_writer->WriteBatchBitmap(num_levels, def_levels, rep_levels,
+                                                      valid_bits, data.offset(), values,
+                                                      data.offset()));
+  return Status::OK();
 }
 
 template <>
@@ -716,9 +1031,6 @@ template <>
 Status ArrowColumnWriter::TypedWriteBatch<ByteArrayType, ::arrow::BinaryType>(
     const Array& array, int64_t num_levels, const int16_t* def_levels,
     const int16_t* rep_levels) {
-  ByteArray* buffer;
-  RETURN_NOT_OK(ctx_->GetScratchData<ByteArray>(num_levels, &buffer));
-
   const auto& data = static_cast<const BinaryArray&>(array);
 
   // In the case of an array consisting of only empty strings or all null,
@@ -731,25 +1043,19 @@ Status ArrowColumnWriter::TypedWriteBatch<ByteArrayType, ::arrow::BinaryType>(
   }
 
   // Slice offset is accounted for in raw_value_offsets
-  const int32_t* value_offset = data.raw_value_offsets();
+  const int32_t* value_offsets = data.raw_value_offsets();
 
-  if (writer_->descr()->schema_node()->is_required() || (data.null_count() == 0)) {
-    // no nulls, just dump the data
-    for (int64_t i = 0; i < data.length(); i++) {
-      buffer[i] =
-          ByteArray(value_offset[i + 1] - value_offset[i], values + value_offset[i]);
-    }
-  } else {
-    int buffer_idx = 0;
-    for (int64_t i = 0; i < data.length(); i++) {
-      if (!data.IsNull(i)) {
-        buffer[buffer_idx++] =
-            ByteArray(value_offset[i + 1] - value_offset[i], values + value_offset[i]);
-      }
-    }
+  // The offsets and data are handed to the column writer as they are, the
+  // null entries are skipped by their bit in the validity bitmap
+  const uint8_t* valid_bits = nullptr;
+  if (!values_required() && data.null_count() > 0) {
+    valid_bits = data.null_bitmap_data();
   }
-
-  return WriteBatch<ByteArrayType>(num_levels, def_levels, rep_levels, buffer);
+  auto typed_writer = static_cast<TypedColumnWriter<ByteArrayType>*>(writer_);
+  PARQUET_CATCH_NOT_OK(typed_writer->WriteBatchBinary(num_levels, def_levels, rep_levels,
+                                                      valid_bits, data.offset(),
+                                                      value_offsets, values));
+  return Status::OK();
 }
 
 template <>
@@ -762,7 +1068,7 @@ Status ArrowColumnWriter::TypedWriteBatch<FLBAType, ::arrow::FixedSizeBinaryType
   FLBA* buffer;
   RETURN_NOT_OK(ctx_->GetScratchData<FLBA>(num_levels, &buffer));
 
-  if (writer_->descr()->schema_node()->is_required() || data.null_count() == 0) {
+  if (values_required() || data.null_count() == 0) {
     // no nulls, just dump the data
     // todo(advancedxy): use a writeBatch to avoid this step
     for (int64_t i = 0; i < length; i++) {
@@ -780,6 +1086,53 @@ Status ArrowColumnWriter::TypedWriteBatch<FLBAType, ::arrow::FixedSizeBinaryType
   return WriteBatch<FLBAType>(num_levels, def_levels, rep_levels, buffer);
 }
 
+/// \brief Convert num_values Decimal128 values to their low kByteWidth bytes in
+/// big-endian order, the layout of decimals in FIXED_LEN_BYTE_ARRAY columns
+template <int32_t kByteWidth>
+static void Decimal128ToBigEndian(const uint8_t* values, int64_t num_values,
+                                  uint8_t* out) {
+  static_assert(kByteWidth >= 1 && kByteWidth <= 16, "Unsupported decimal byte width");
+  constexpr int32_t kHighBytes = kByteWidth > 8 ? kByteWidth - 8 : 0;
+  constexpr int32_t kLowBytes = kByteWidth - kHighBytes;
+  for (int64_t i = 0; i < num_values; ++i, values += 16, out += kByteWidth) {
+    uint64_t low;
+    uint64_t high;
+    memcpy(&low, values, sizeof(uint64_t));
+    memcpy(&high, values + sizeof(uint64_t), sizeof(uint64_t));
+    low = ::arrow::BitUtil::ToBigEndian(low);
+    high = ::arrow::BitUtil::ToBigEndian(high);
+    memcpy(out, reinterpret_cast<const uint8_t*>(&high) + 8 - kHighBytes, kHighBytes);
+    memcpy(out + kHighBytes, reinterpret_cast<const uint8_t*>(&low) + 8 - kLowBytes,
+           kLowBytes);
+  }
+}
+
+using DecimalConversion = void (*)(const uint8_t*, int64_t, uint8_t*);
+
+static DecimalConversion GetDecimal128ToBigEndian(int32_t byte_width) {
+  static const DecimalConversion kConversions[] = {
+      nullptr,
+      Decimal128ToBigEndian<1>,
+      Decimal128ToBigEndian<2>,
+      Decimal128ToBigEndian<3>,
+      Decimal128ToBigEndian<4>,
+      Decimal128ToBigEndian<5>,
+      Decimal128ToBigEndian<6>,
+      Decimal128ToBigEndian<7>,
+      Decimal128ToBigEndian<8>,
+      Decimal128ToBigEndian<9>,
+      Decimal128ToBigEndian<10>,
+      Decimal128ToBigEndian<11>,
+      Decimal128ToBigEndian<12>,
+      Decimal128ToBigEndian<13>,
+      Decimal128ToBigEndian<14>,
+      Decimal128ToBigEndian<15>,
+      Decimal128ToBigEndian<16>};
+  DCHECK_GE(byte_width, 1);
+  DCHECK_LE(byte_width, 16);
+  return kConversions[byte_width];
+}
+
 template <>
 Status ArrowColumnWriter::TypedWriteBatch<FLBAType, ::arrow::Decimal128Type>(
     const Array& array, int64_t num_levels, const int16_t* def_levels,
@@ -791,37 +1144,27 @@ Status ArrowColumnWriter::TypedWriteBatch<FLBAType, ::arrow::Decimal128Type>(
   RETURN_NOT_OK(ctx_->GetScratchData<FLBA>(num_levels, &buffer));
 
   const auto& decimal_type = static_cast<const ::arrow::Decimal128Type&>(*data.type());
-  const int32_t offset =
-      decimal_type.byte_width() - DecimalSize(decimal_type.precision());
+  const int32_t byte_width = DecimalSize(decimal_type.precision());
 
   const bool does_not_have_nulls =
-      writer_->descr()->schema_node()->is_required() || data.null_count() == 0;
+      values_required() || data.null_count() == 0;
 
+  // All the slots are converted, the ones of nulls hold some bytes as well
   // TODO(phillipc): This is potentially very wasteful if we have a lot of nulls
-  std::vector<uint64_t> big_endian_values(static_cast<size_t>(length) * 2);
+  std::vector<uint8_t> big_endian_values(static_cast<size_t>(length * byte_width));
+  if (length > 0) {
+    GetDecimal128ToBigEndian(byte_width)(data.GetValue(0), length,
+                                         big_endian_values.data());
+  }
 
-  // TODO(phillipc): Look into whether our compilers will perform loop unswitching so we
-  // don't have to keep writing two loops to handle the case where we know there are no
-  // nulls
   if (does_not_have_nulls) {
-    // no nulls, just dump the data
-    // todo(advancedxy): use a writeBatch to avoid this step
-    for (int64_t i = 0, j = 0; i < length; ++i, j += 2) {
-      auto unsigned_64_bit = reinterpret_cast<const uint64_t*>(data.GetValue(i));
-      big_endian_values[j] = ::arrow::BitUtil::ToBigEndian(unsigned_64_bit[1]);
-      big_endian_values[j + 1] = ::arrow::BitUtil::ToBigEndian(unsigned_64_bit[0]);
-      buffer[i] = FixedLenByteArray(
-          reinterpret_cast<const uint8_t*>(&big_endian_values[j]) + offset);
+    for (int64_t i = 0; i < length; ++i) {
+      buffer[i] = FixedLenByteArray(&big_endian_values[i * byte_width]);
     }
   } else {
-    for (int64_t i = 0, buffer_idx = 0, j = 0; i < length; ++i) {
+    for (int64_t i = 0, buffer_idx = 0; i < length; ++i) {
       if (!data.IsNull(i)) {
-        auto unsigned_64_bit = reinterpret_cast<const uint64_t*>(data.GetValue(i));
-        big_endian_values[j] = ::arrow::BitUtil::ToBigEndian(unsigned_64_bit[1]);
-        big_endian_values[j + 1] = ::arrow::BitUtil::ToBigEndian(unsigned_64_bit[0]);
-        buffer[buffer_idx++] = FixedLenByteArray(
-            reinterpret_cast<const uint8_t*>(&big_endian_values[j]) + offset);
-        j += 2;
+        buffer[buffer_idx++] = FixedLenByteArray(&big_endian_values[i * byte_width]);
       }
     }
   }
@@ -829,9 +1172,85 @@ Status ArrowColumnWriter::TypedWriteBatch<FLBAType, ::arrow::Decimal128Type>(
   return WriteBatch<FLBAType>(num_levels, def_levels, rep_levels, buffer);
 }
 
+Status ArrowColumnWriter::WriteDictionary(const Array& array, int64_t num_levels,
+                                          const int16_t* def_levels,
+                                          const int16_t* rep_levels) {
+  const auto& data = static_cast<const DictionaryArray&>(array);
+  const auto& dict_type = static_cast<const ::arrow::DictionaryType&>(*data.type());
+  if (!CanWriteDictionary(dict_type, writer_->type())) {
+    std::stringstream ss;
+    ss << "Dictionary value type not supported: "
+       << dict_type.dictionary()->type()->ToString();
+    return Status::NotImplemented(ss.str());
+  }
+
+  // The column writer takes int32 indices
+  const auto& indices = static_cast<const PrimitiveArray&>(*data.indices());
+  const int32_t* indices_ptr;
+  int32_t* buffer;
+  switch (indices.type()->id()) {
+    case ::arrow::Type::INT32:
+      indices_ptr = static_cast<const ::arrow::Int32Array&>(indices).raw_values();
+      break;
+    case ::arrow::Type::INT8:
+      RETURN_NOT_OK(ctx_->GetScratchData<int32_t>(indices.length(), &buffer));
+      ConvertDictionaryIndices<::arrow::Int8Type>(indices, buffer);
+      indices_ptr = buffer;
+      break;
+    case ::arrow::Type::INT16:
+      RETURN_NOT_OK(ctx_->GetScratchData<int32_t>(indices.length(), &buffer));
+      ConvertDictionaryIndices<::arrow::Int16Type>(indices, buffer);
+      indices_ptr = buffer;
+      break;
+    case ::arrow::Type::INT64:
+      RETURN_NOT_OK(ctx_->GetScratchData<int32_t>(indices.length(), &buffer));
+      ConvertDictionaryIndices<::arrow::Int64Type>(indices, buffer);
+      indices_ptr = buffer;
+      break;
+    default:
+      return Status::NotImplemented("Dictionary indices of type " +
+                                    indices.type()->ToString() + " not supported");
+  }
+
+  const uint8_t* valid_bits = data.null_count() == 0 ? nullptr : data.null_bitmap_data();
+  const Array& dictionary = *dict_type.dictionary();
+
+#define WRITE_DICTIONARY_CASE(ArrowEnum, ArrowType, ParquetType)                        \
+  case ::arrow::Type::ArrowEnum:                                                        \
+    return WriteBatchDictionary<ParquetType>(                                           \
+        num_levels, def_levels, rep_levels, valid_bits, data.offset(), indices_ptr,     \
+        static_cast<const ::arrow::ArrowType&>(dictionary).raw_values(),                \
+        dictionary.length());
+
+  switch (dictionary.type()->id()) {
+    WRITE_DICTIONARY_CASE(INT32, Int32Array, Int32Type)
+    WRITE_DICTIONARY_CASE(INT64, Int64Array, Int64Type)
+    WRITE_DICTIONARY_CASE(FLOAT, FloatArray, FloatType)
+    WRITE_DICTIONARY_CASE(DOUBLE, DoubleArray, DoubleType)
+    default:
+      break;
+  }
+
+  // Only the dictionary entries are converted, not the values
+  const auto& binary_dictionary = static_cast<const BinaryArray&>(dictionary);
+  std::vector<ByteArray> dictionary_values(binary_dictionary.length());
+  for (int64_t i = 0; i < binary_dictionary.length(); i++) {
+    int32_t value_length;
+    const uint8_t* value = binary_dictionary.GetValue(i, &value_length);
+    dictionary_values[i] = ByteArray(value_length, value);
+  }
+  return WriteBatchDictionary<ByteArrayType>(
+      num_levels, def_levels, rep_levels, valid_bits, data.offset(), indices_ptr,
+      dictionary_values.data(), binary_dictionary.length());
+}
+
 Status ArrowColumnWriter::Write(const Array& data) {
-  ::arrow::Type::type values_type;
-  RETURN_NOT_OK(GetLeafType(*data.type(), &values_type));
+  const ColumnDescriptor* descr = writer_->descr();
+  if (field_->type()->num_children() == 0 && descr->max_definition_level() == 1 &&
+      descr->max_repetition_level() == 0 && WritesLevelsFromBitmap(data)) {
+    // The definition levels are the validity bitmap, no int16 level is built
+    return WriteLeaf(data, data.length(), nullptr, nullptr);
+  }
 
   std::shared_ptr<Array> _values_array;
   int64_t values_offset;
@@ -852,27 +1271,34 @@ Status ArrowColumnWriter::Write(const Array& data) {
     rep_levels = reinterpret_cast<const int16_t*>(rep_levels_buffer->data());
   }
   std::shared_ptr<Array> values_array = _values_array->Slice(values_offset, num_values);
+  return WriteLeaf(*values_array, num_levels, def_levels, rep_levels);
+}
 
-#define WRITE_BATCH_CASE(ArrowEnum, ArrowType, ParquetType)                            \
-  case ::arrow::Type::ArrowEnum:                                                       \
-    return TypedWriteBatch<ParquetType, ::arrow::ArrowType>(*values_array, num_levels, \
+Status ArrowColumnWriter::WriteLeaf(const Array& values_array, int64_t num_levels,
+                                    const int16_t* def_levels,
+                                    const int16_t* rep_levels) {
+#define WRITE_BATCH_CASE(ArrowEnum, ArrowType, ParquetType)                           \
+  case ::arrow::Type::ArrowEnum:                                                      \
+    return TypedWriteBatch<ParquetType, ::arrow::ArrowType>(values_array, num_levels, \
                                                             def_levels, rep_levels);
 
-  switch (values_type) {
+  switch (values_array.type()->id()) {
     case ::arrow::Type::UINT32: {
       if (writer_->properties()->version() == ParquetVersion::PARQUET_1_0) {
         // Parquet 1.0 reader cannot read the UINT_32 logical type. Thus we need
         // to use the larger Int64Type to store them lossless.
-        return TypedWriteBatch<Int64Type, ::arrow::UInt32Type>(*values_array, num_levels,
+        return TypedWriteBatch<Int64Type, ::arrow::UInt32Type>(values_array, num_levels,
                                                                def_levels, rep_levels);
       } else {
-        return TypedWriteBatch<Int32Type, ::arrow::UInt32Type>(*values_array, num_levels,
+        return TypedWriteBatch<Int32Type, ::arrow::UInt32Type>(values_array, num_levels,
                                                                def_levels, rep_levels);
       }
     }
       WRITE_BATCH_CASE(NA, NullType, Int32Type)
     case ::arrow::Type::TIMESTAMP:
-      return WriteTimestamps(*values_array, num_levels, def_levels, rep_levels);
+      return WriteTimestamps(values_array, num_levels, def_levels, rep_levels);
+    case ::arrow::Type::DICTIONARY:
+      return WriteDictionary(values_array, num_levels, def_levels, rep_levels);
       WRITE_BATCH_CASE(BOOL, BooleanType, BooleanType)
       WRITE_BATCH_CASE(INT8, Int8Type, Int32Type)
       WRITE_BATCH_CASE(UINT8, UInt8Type, Int32Type)
@@ -895,7 +1321,7 @@ Status ArrowColumnWriter::Write(const Array& data) {
       break;
   }
   std::stringstream ss;
-  ss << "Data type not supported as list value: " << values_array->type()->ToString();
+  ss << "Data type not supported as list value: " << values_array.type()->ToString();
   return Status::NotImplemented(ss.str());
 }
 
@@ -912,7 +1338,8 @@ class FileWriter::Impl {
         row_group_writer_(nullptr),
         column_write_context_(pool, arrow_properties.get()),
         arrow_properties_(arrow_properties),
-        closed_(false) {}
+        closed_(false),
+        num_threads_(1) {}
 
   Status NewRowGroup(int64_t chunk_size) {
     if (row_group_writer_ != nullptr) {
@@ -922,6 +1349,14 @@ class FileWriter::Impl {
     return Status::OK();
   }
 
+  Status NewBufferedRowGroup() {
+    if (row_group_writer_ != nullptr) {
+      PARQUET_CATCH_NOT_OK(row_group_writer_->Close());
+    }
+    PARQUET_CATCH_NOT_OK(row_group_writer_ = writer_->AppendBufferedRowGroup());
+    return Status::OK();
+  }
+
   Status Close() {
     if (!closed_) {
       // Make idempotent
@@ -943,47 +1378,225 @@ class FileWriter::Impl {
 
   Status WriteColumnChunk(const std::shared_ptr<ChunkedArray>& data, int64_t offset,
                           const int64_t size) {
-    // DictionaryArrays are not yet handled with a fast path. To still support
-    // writing them as a workaround, we convert them back to their non-dictionary
-    // representation.
-    if (data->type()->id() == ::arrow::Type::DICTIONARY) {
+    if (HasStruct(*data->type())) {
+      return WriteNestedColumn(row_group_writer_->current_column(),
+                               &column_write_context_, data, offset, size);
+    }
+    ColumnWriter* column_writer;
+    PARQUET_CATCH_NOT_OK(column_writer = row_group_writer_->NextColumn());
+    int current_column_idx = row_group_writer_->current_column();
+    return WriteColumn(current_column_idx - 1, column_writer, &column_write_context_,
+                       data, offset, size);
+  }
+
+  // Write the slice of all columns of the table into a buffered row group
+  Status WriteBufferedColumns(const Table& table, int64_t offset, int64_t size) {
+    int num_columns = table.num_columns();
+    int nthreads = std::min<int>(num_threads_, num_columns);
+
+    // Index of the first leaf column of every table column
+    std::vector<int> first_leaves(num_columns);
+    for (int i = 1; i < num_columns; i++) {
+      first_leaves[i] = first_leaves[i - 1] + NumLeaves(*table.column(i - 1)->type());
+    }
+
+    if (nthreads <= 1) {
+      for (int i = 0; i < num_columns; i++) {
+        RETURN_NOT_OK(WriteBufferedColumn(first_leaves[i], &column_write_context_,
+                                          table.column(i)->data(), offset, size));
+      }
+      return Status::OK();
+    }
+
+    auto WriteColumnFunc = [&table, &first_leaves, offset, size, this](int i) {
+      // The scratch buffers of the context cannot be shared between threads
+      ColumnWriterContext ctx(memory_pool(), arrow_properties_.get());
+      return WriteBufferedColumn(first_leaves[i], &ctx, table.column(i)->data(), offset,
+                                 size);
+    };
+    return ParallelFor(thread_pool(), nthreads, num_columns, WriteColumnFunc);
+  }
+
+  // Write the table into buffered row groups of at most chunk_size rows. With
+  // a WriterProperties::max_row_group_bytes target or a memory_limit, the
+  // rows of a row group are written in slices and the row group is closed
+  // once its estimated size reaches the target or the memory it holds
+  // reaches the limit.
+  Status WriteBufferedRowGroups(const Table& table, int64_t chunk_size) {
+    const int64_t max_row_group_bytes = properties().max_row_group_bytes();
+    const int64_t memory_limit = properties().memory_limit();
+    const int64_t min_slice_size = std::max<int64_t>(1, properties().write_batch_size());
+    int64_t offset = 0;
+    while (offset < table.num_rows()) {
+      RETURN_NOT_OK(NewBufferedRowGroup());
+      int64_t num_rows = 0;
+      int64_t num_bytes = 0;
+      int64_t memory_usage = 0;
+      while (num_rows < chunk_size && offset < table.num_rows()) {
+        int64_t size = std::min(chunk_size - num_rows, table.num_rows() - offset);
+        if (max_row_group_bytes > 0) {
+          size = std::min(size, GuessSliceSize(max_row_group_bytes, num_bytes, num_rows,
+                                               min_slice_size));
+        }
+        if (memory_limit > 0) {
+          size = std::min(size, GuessSliceSize(memory_limit, memory_usage, num_rows,
+                                               min_slice_size));
+        }
+        RETURN_NOT_OK(WriteBufferedColumns(table, offset, size));
+        offset += size;
+        num_rows += size;
+        if (max_row_group_bytes > 0) {
+          PARQUET_CATCH_NOT_OK(num_bytes = row_group_writer_->EstimatedSize());
+          if (num_bytes >= max_row_group_bytes) break;
+        }
+        if (memory_limit > 0) {
+          PARQUET_CATCH_NOT_OK(memory_usage = row_group_writer_->memory_usage());
+          if (memory_usage >= memory_limit) break;
+        }
+      }
+    }
+    return Status::OK();
+  }
+
+  // Guess from the bytes of the rows written so far how many more reach target
+  static int64_t GuessSliceSize(int64_t target, int64_t num_bytes, int64_t num_rows,
+                                int64_t min_slice_size) {
+    int64_t guess = min_slice_size;
+    if (num_bytes > 0) {
+      guess = static_cast<int64_t>(static_cast<double>(target - num_bytes) *
+                                   static_cast<double>(num_rows) /
+                                   static_cast<double>(num_bytes));
+    }
+    return std::max(min_slice_size, guess);
+  }
+
+  Status WriteBufferedColumn(int first_leaf, ColumnWriterContext* ctx,
+                             const std::shared_ptr<ChunkedArray>& data, int64_t offset,
+                             int64_t size) {
+    if (HasStruct(*data->type())) {
+      return WriteNestedColumn(first_leaf, ctx, data, offset, size);
+    }
+    ColumnWriter* column_writer;
+    PARQUET_CATCH_NOT_OK(column_writer = row_group_writer_->column(first_leaf));
+    return WriteColumn(first_leaf, column_writer, ctx, data, offset, size);
+  }
+
+  // Write the leaf columns first_leaf, first_leaf + 1, ... of a column with
+  // structs. The levels of all slices are generated before the first leaf is
+  // written, as the leaves of an unbuffered row group are written one after
+  // the other.
+  Status WriteNestedColumn(int first_leaf, ColumnWriterContext* ctx,
+                           const std::shared_ptr<ChunkedArray>& data, int64_t offset,
+                           int64_t size) {
+    const int num_leaves = NumLeaves(*data->type());
+    std::vector<int> leaf_indices(num_leaves);
+    for (int i = 0; i < num_leaves; i++) {
+      leaf_indices[i] = first_leaf + i;
+    }
+    std::shared_ptr<::arrow::Schema> arrow_schema;
+    RETURN_NOT_OK(FromParquetSchema(writer_->schema(), leaf_indices,
+                                    writer_->key_value_metadata(), &arrow_schema));
+    if (arrow_schema->num_fields() != 1) {
+      return Status::Invalid("The leaves do not belong to a single column");
+    }
+    const std::shared_ptr<Field>& field = arrow_schema->field(0);
+
+    std::vector<std::vector<LeafLevels>> slices;
+    RETURN_NOT_OK(VisitSlices(*data, offset, size, [&slices, &field, ctx](
+                                                       const Array& slice) {
+      std::vector<LeafLevels> leaves;
+      RETURN_NOT_OK(
+          LevelBuilder(ctx->memory_pool).GenerateNestedLevels(slice, field, &leaves));
+      slices.push_back(std::move(leaves));
+      return Status::OK();
+    }));
+
+    for (int i = 0; i < num_leaves; i++) {
+      ColumnWriter* column_writer;
+      if (row_group_writer_->buffered()) {
+        PARQUET_CATCH_NOT_OK(column_writer = row_group_writer_->column(first_leaf + i));
+      } else {
+        PARQUET_CATCH_NOT_OK(column_writer = row_group_writer_->NextColumn());
+      }
+      ArrowColumnWriter arrow_writer(ctx, column_writer, field);
+      for (const auto& leaves : slices) {
+        if (static_cast<int>(leaves.size()) != num_leaves) {
+          return Status::Invalid("Column does not match the schema of the file");
+        }
+        const LeafLevels& leaf = leaves[i];
+        const int16_t* rep_levels =
+            leaf.rep_levels ? leaf.rep_levels->data() : nullptr;
+        RETURN_NOT_OK(arrow_writer.WriteLeaf(
+            *leaf.values, static_cast<int64_t>(leaf.def_levels->size()),
+            leaf.def_levels->data(), rep_levels));
+      }
+      RETURN_NOT_OK(CloseUnbuffered(&arrow_writer));
+    }
+    return Status::OK();
+  }
+
+  Status WriteColumn(int column_index, ColumnWriter* column_writer,
+                     ColumnWriterContext* ctx, const std::shared_ptr<ChunkedArray>& data,
+                     int64_t offset, const int64_t size) {
+    // DictionaryArrays whose indices and dictionary cannot be written as they
+    // are, see ArrowColumnWriter::WriteDictionary, are converted back to their
+    // non-dictionary representation.
+    if (data->type()->id() == ::arrow::Type::DICTIONARY &&
+        !CanWriteDictionary(static_cast<const ::arrow::DictionaryType&>(*data->type()),
+                            column_writer->type())) {
       const ::arrow::DictionaryType& dict_type =
           static_cast<const ::arrow::DictionaryType&>(*data->type());
 
       // TODO(ARROW-1648): Remove this special handling once we require an Arrow
       // version that has this fixed.
       if (dict_type.dictionary()->type()->id() == ::arrow::Type::NA) {
-        auto null_array = std::make_shared<::arrow::NullArray>(data->length());
-        return WriteColumnChunk(*null_array);
+        ::arrow::ArrayVector chunks = {
+            std::make_shared<::arrow::NullArray>(data->length())};
+        auto null_array = std::make_shared<::arrow::ChunkedArray>(chunks);
+        return WriteColumn(column_index, column_writer, ctx, null_array, 0,
+                           data->length());
       }
 
-      FunctionContext ctx(this->memory_pool());
+      FunctionContext func_ctx(ctx->memory_pool);
       ::arrow::compute::Datum cast_input(data);
       ::arrow::compute::Datum cast_output;
-      RETURN_NOT_OK(Cast(&ctx, cast_input, dict_type.dictionary()->type(), CastOptions(),
-                         &cast_output));
-      return WriteColumnChunk(cast_output.chunked_array(), 0, data->length());
+      RETURN_NOT_OK(Cast(&func_ctx, cast_input, dict_type.dictionary()->type(),
+                         CastOptions(), &cast_output));
+      return WriteColumn(column_index, column_writer, ctx, cast_output.chunked_array(), 0,
+                         data->length());
     }
 
-    ColumnWriter* column_writer;
-    PARQUET_CATCH_NOT_OK(column_writer = row_group_writer_->NextColumn());
-
     // TODO(wesm): This trick to construct a schema for one Parquet root node
     // will not work for arbitrary nested data
-    int current_column_idx = row_group_writer_->current_column();
     std::shared_ptr<::arrow::Schema> arrow_schema;
-    RETURN_NOT_OK(FromParquetSchema(writer_->schema(), {current_column_idx - 1},
+    RETURN_NOT_OK(FromParquetSchema(writer_->schema(), {column_index},
                                     writer_->key_value_metadata(), &arrow_schema));
 
-    ArrowColumnWriter arrow_writer(&column_write_context_, column_writer,
-                                   arrow_schema->field(0));
+    ArrowColumnWriter arrow_writer(ctx, column_writer, arrow_schema->field(0));
 
     RETURN_NOT_OK(arrow_writer.Write(*data, offset, size));
-    return arrow_writer.Close();
+    return CloseUnbuffered(&arrow_writer);
+  }
+
+  // The column writers of a buffered row group get the rows of several slices
+  // and are closed once by RowGroupWriter::Close
+  Status CloseUnbuffered(ArrowColumnWriter* arrow_writer) {
+    if (row_group_writer_->buffered()) {
+      return Status::OK();
+    }
+    return arrow_writer->Close();
   }
 
   const WriterProperties& properties() const { return *writer_->properties(); }
 
+  void set_num_threads(int num_threads) { num_threads_ = num_threads; }
+
+  void set_thread_pool(const std::shared_ptr<ThreadPool>& pool) { thread_pool_ = pool; }
+
+  ThreadPool* thread_pool() const {
+    return thread_pool_ ? thread_pool_.get() : ThreadPool::GetDefault().get();
+  }
+
   ::arrow::MemoryPool* memory_pool() const { return column_write_context_.memory_pool; }
 
   virtual ~Impl() {}
@@ -996,6 +1609,8 @@ class FileWriter::Impl {
   ColumnWriterContext column_write_context_;
   std::shared_ptr<ArrowWriterProperties> arrow_properties_;
   bool closed_;
+  int num_threads_;
+  std::shared_ptr<ThreadPool> thread_pool_;
 };
 
 Status FileWriter::NewRowGroup(int64_t chunk_size) {
@@ -1019,6 +1634,12 @@ Status FileWriter::Close() { return impl_->Close(); }
 
 MemoryPool* FileWriter::memory_pool() const { return impl_->memory_pool(); }
 
+void FileWriter::set_num_threads(int num_threads) { impl_->set_num_threads(num_threads); }
+
+void FileWriter::set_thread_pool(const std::shared_ptr<ThreadPool>& pool) {
+  impl_->set_thread_pool(pool);
+}
+
 FileWriter::~FileWriter() {}
 
 FileWriter::FileWriter(MemoryPool* pool, std::unique_ptr<ParquetFileWriter> writer,
@@ -1076,17 +1697,8 @@ Status FileWriter::WriteTable(const Table& table, int64_t chunk_size) {
     chunk_size = impl_->properties().max_row_group_length();
   }
 
-  for (int chunk = 0; chunk * chunk_size < table.num_rows(); chunk++) {
-    int64_t offset = chunk * chunk_size;
-    int64_t size = std::min(chunk_size, table.num_rows() - offset);
-
-    RETURN_NOT_OK_ELSE(NewRowGroup(size), PARQUET_IGNORE_NOT_OK(Close()));
-    for (int i = 0; i < table.num_columns(); i++) {
-      auto chunked_data = table.column(i)->data();
-      RETURN_NOT_OK_ELSE(WriteColumnChunk(chunked_data, offset, size),
-                         PARQUET_IGNORE_NOT_OK(Close()));
-    }
-  }
+  RETURN_NOT_OK_ELSE(impl_->WriteBufferedRowGroups(table, chunk_size),
+                     PARQUET_IGNORE_NOT_OK(Close()));
   return Status::OK();
 }
 
@@ -0,0 +1,234 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "parquet/block_cache.h"
+
+#include <algorithm>
+#include <cstring>
+#include <functional>
+
+#include "parquet/exception.h"
+#include "parquet/util/lru-cache.h"
+
+namespace parquet {
+
+namespace {
+
+struct BlockKey {
+  std::string key;
+  int64_t block_index;
+
+  bool operator==(const BlockKey& other) const {
+    return block_index == other.block_index && key == other.key;
+  }
+};
+
+struct BlockKeyHash {
+  size_t operator()(const BlockKey& key) const {
+    const size_t h = std::hash<std::string>()(key.key);
+    return h ^ (std::hash<int64_t>()(key.block_index) + 0x9e3779b9 + (h << 6) + (h >> 2));
+  }
+};
+
+struct BlockSize {
+  int64_t operator()(const std::shared_ptr<Buffer>& block) const { return block->size(); }
+};
+
+}  // namespace
+
+struct BlockCache::Shard {
+  explicit Shard(int64_t capacity) : blocks(capacity) {}
+
+  std::mutex mutex;
+  internal::LruCache<BlockKey, std::shared_ptr<Buffer>, BlockSize, BlockKeyHash> blocks;
+};
+
+constexpr int64_t BlockCache::kDefaultBlockSize;
+constexpr int BlockCache::kDefaultNumShards;
+
+BlockCache::BlockCache(int64_t capacity, int64_t block_size, int num_shards)
+    : capacity_(capacity), block_size_(block_size), hits_(0), misses_(0) {
+  if (block_size <= 0 || num_shards <= 0) {
+    throw ParquetException("BlockCache needs a positive block size and shard count");
+  }
+  for (int i = 0; i < num_shards; ++i) {
+    shards_.emplace_back(new Shard(capacity / num_shards));
+  }
+}
+
+BlockCache::~BlockCache() {}
+
+BlockCache::Shard* BlockCache::GetShard(const std::string& key, int64_t block_index) {
+  const size_t hash = BlockKeyHash()({key, block_index});
+  return shards_[hash % shards_.size()].get();
+}
+
+std::shared_ptr<Buffer> BlockCache::Get(const std::string& key, int64_t block_index) {
+  Shard* shard = GetShard(key, block_index);
+  std::lock_guard<std::mutex> lock(shard->mutex);
+  const std::shared_ptr<Buffer>* block = shard->blocks.Get({key, block_index});
+  if (block == nullptr) {
+    ++misses_;
+    return nullptr;
+  }
+  ++hits_;
+  return *block;
+}
+
+void BlockCache::Put(const std::string& key, int64_t block_index,
+                     std::shared_ptr<Buffer> block) {
+  Shard* shard = GetShard(key, block_index);
+  std::lock_guard<std::mutex> lock(shard->mutex);
+  shard->blocks.Put({key, block_index}, std::move(block));
+}
+
+void BlockCache::Clear() {
+  for (auto& shard : shards_) {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    shard->blocks.Clear();
+  }
+}
+
+int64_t BlockCache::size() const {
+  int64_t result = 0;
+  for (auto& shard : shards_) {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    result += shard->blocks.size();
+  }
+  return result;
+}
+
+int64_t BlockCache::num_entries() const {
+  int64_t result = 0;
+  for (auto& shard : shards_) {
+    std::lock_guard<std::mutex> lock(shard->mutex);
+    result += shard->blocks.num_entries();
+  }
+  return result;
+}
+
+CachingRandomAccessSource::CachingRandomAccessSource(
+    std::unique_ptr<RandomAccessSource> source, std::shared_ptr<BlockCache> cache,
+    ::arrow::MemoryPool* pool)
+    : source_(std::move(source)),
+      cache_(std::move(cache)),
+      pool_(pool),
+      key_(source_->cache_key()),
+      size_(source_->Size()),
+      position_(0) {
+  if (key_.empty()) {
+    throw ParquetException("Only sources with a cache key can be cached");
+  }
+}
+
+void CachingRandomAccessSource::Close() { source_->Close(); }
+
+int64_t CachingRandomAccessSource::Tell() { return position_; }
+
+int64_t CachingRandomAccessSource::Size() const { return size_; }
+
+int64_t CachingRandomAccessSource::Read(int64_t nbytes, uint8_t* out) {
+  const int64_t bytes_read = ReadAt(position_, nbytes, out);
+  position_ += bytes_read;
+  return bytes_read;
+}
+
+std::shared_ptr<Buffer> CachingRandomAccessSource::Read(int64_t nbytes) {
+  std::shared_ptr<Buffer> result = ReadAt(position_, nbytes);
+  position_ += result->size();
+  return result;
+}
+
+std::shared_ptr<Buffer> CachingRandomAccessSource::ReadAt(int64_t position,
+                                                          int64_t nbytes) {
+  nbytes = std::max(std::min(nbytes, size_ - position), static_cast<int64_t>(0));
+  std::vector<std::shared_ptr<Buffer>> blocks = GetBlocks(position, nbytes);
+  if (blocks.size() == 1) {
+    return ::arrow::SliceBuffer(blocks[0], position % cache_->block_size(), nbytes);
+  }
+  std::shared_ptr<PoolBuffer> result = AllocateBuffer(pool_, nbytes);
+  ReadAt(position, nbytes, result->mutable_data());
+  return result;
+}
+
+int64_t CachingRandomAccessSource::ReadAt(int64_t position, int64_t nbytes,
+                                          uint8_t* out) {
+  nbytes = std::max(std::min(nbytes, size_ - position), static_cast<int64_t>(0));
+  const int64_t block_size = cache_->block_size();
+  int64_t offset = position % block_size;
+  int64_t bytes_copied = 0;
+  for (const auto& block : GetBlocks(position, nbytes)) {
+    const int64_t length = std::min(block->size() - offset, nbytes - bytes_copied);
+    memcpy(out + bytes_copied, block->data() + offset, length);
+    bytes_copied += length;
+    offset = 0;
+  }
+  return bytes_copied;
+}
+
+std::string CachingRandomAccessSource::cache_key() const { return key_; }
+
+std::vector<std::shared_ptr<Buffer>> CachingRandomAccessSource::GetBlocks(
+    int64_t position, int64_t nbytes) {
+  std::vector<std::shared_ptr<Buffer>> blocks;
+  if (nbytes <= 0) {
+    return blocks;
+  }
+  const int64_t block_size = cache_->block_size();
+  const int64_t first = position / block_size;
+  const int64_t last = (position + nbytes - 1) / block_size;
+  for (int64_t i = first; i <= last; ++i) {
+    blocks.push_back(cache_->Get(key_, i));
+  }
+
+  // Read every run of missing blocks with a single request
+  const auto num_blocks = static_cast<int64_t>(blocks.size());
+  for (int64_t begin = 0; begin < num_blocks; ++begin) {
+    if (blocks[begin] != nullptr) {
+      continue;
+    }
+    int64_t end = begin + 1;
+    while (end < num_blocks && blocks[end] == nullptr) {
+      ++end;
+    }
+    const int64_t read_offset = (first + begin) * block_size;
+    const int64_t read_length = std::min((first + end) * block_size, size_) - read_offset;
+    std::shared_ptr<Buffer> data = source_->ReadAt(read_offset, read_length);
+    if (data->size() < read_length) {
+      throw ParquetException("Unable to read the block from the source");
+    }
+    for (int64_t i = begin; i < end; ++i) {
+      const int64_t offset = (i - begin) * block_size;
+      const int64_t length = std::min(block_size, read_length - offset);
+      std::shared_ptr<Buffer> block;
+      if (end - begin == 1) {
+        block = data;
+      } else {
+        // Blocks of their own so that evicting one releases its memory
+        std::shared_ptr<PoolBuffer> copy = AllocateBuffer(pool_, length);
+        memcpy(copy->mutable_data(), data->data() + offset, length);
+        block = copy;
+      }
+      cache_->Put(key_, first + i, block);
+      blocks[i] = std::move(block);
+    }
+    begin = end - 1;
+  }
+  return blocks;
+}
+
+}  // namespace parquet
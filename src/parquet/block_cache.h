@@ -0,0 +1,121 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef PARQUET_BLOCK_CACHE_H
+#define PARQUET_BLOCK_CACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "parquet/util/memory.h"
+#include "parquet/util/visibility.h"
+
+namespace parquet {
+
+// Thread-safe LRU cache of fixed-size blocks of files, keyed on the cache key
+// of the source (see RandomAccessSource::cache_key) and the index of the
+// block. Set one on ReaderProperties to share the footers, dictionary pages
+// and column chunks that are read by several readers of the same files.
+//
+// The cache is split into shards with a lock and an LRU list each, every
+// shard holds up to capacity / num_shards bytes.
+class PARQUET_EXPORT BlockCache {
+ public:
+  static constexpr int64_t kDefaultBlockSize = 1024 * 1024;
+  static constexpr int kDefaultNumShards = 16;
+
+  explicit BlockCache(int64_t capacity, int64_t block_size = kDefaultBlockSize,
+                      int num_shards = kDefaultNumShards);
+  ~BlockCache();
+
+  // Returns nullptr if the block is not cached
+  std::shared_ptr<Buffer> Get(const std::string& key, int64_t block_index);
+
+  void Put(const std::string& key, int64_t block_index, std::shared_ptr<Buffer> block);
+
+  void Clear();
+
+  int64_t capacity() const { return capacity_; }
+  int64_t block_size() const { return block_size_; }
+
+  // Total size of the cached blocks
+  int64_t size() const;
+  int64_t num_entries() const;
+
+  // Number of calls to Get that found / did not find the block
+  int64_t hits() const { return hits_.load(); }
+  int64_t misses() const { return misses_.load(); }
+
+ private:
+  struct Shard;
+
+  Shard* GetShard(const std::string& key, int64_t block_index);
+
+  const int64_t capacity_;
+  const int64_t block_size_;
+  std::vector<std::unique_ptr<Shard>> shards_;
+  std::atomic<int64_t> hits_;
+  std::atomic<int64_t> misses_;
+};
+
+// Source that serves reads from the blocks of a BlockCache and reads the
+// missing blocks from the wrapped source, merging adjacent ones into a single
+// request. Reads that fall into a single block are zero-copy slices of it.
+class PARQUET_EXPORT CachingRandomAccessSource : public RandomAccessSource {
+ public:
+  CachingRandomAccessSource(std::unique_ptr<RandomAccessSource> source,
+                            std::shared_ptr<BlockCache> cache,
+                            ::arrow::MemoryPool* pool = ::arrow::default_memory_pool());
+
+  void Close() override;
+
+  int64_t Tell() override;
+
+  int64_t Size() const override;
+
+  // Returns bytes read
+  int64_t Read(int64_t nbytes, uint8_t* out) override;
+
+  std::shared_ptr<Buffer> Read(int64_t nbytes) override;
+
+  std::shared_ptr<Buffer> ReadAt(int64_t position, int64_t nbytes) override;
+
+  /// Returns bytes read
+  int64_t ReadAt(int64_t position, int64_t nbytes, uint8_t* out) override;
+
+  std::string cache_key() const override;
+
+ private:
+  // The blocks that hold the bytes [position, position + nbytes)
+  std::vector<std::shared_ptr<Buffer>> GetBlocks(int64_t position, int64_t nbytes);
+
+  std::unique_ptr<RandomAccessSource> source_;
+  std::shared_ptr<BlockCache> cache_;
+  ::arrow::MemoryPool* pool_;
+  const std::string key_;
+  const int64_t size_;
+  int64_t position_;
+};
+
+}  // namespace parquet
+
+#endif  // PARQUET_BLOCK_CACHE_H
@@ -0,0 +1,177 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "arrow/io/memory.h"
+
+#include "parquet/bloom_filter.h"
+#include "parquet/column_writer.h"
+#include "parquet/file_reader.h"
+#include "parquet/file_writer.h"
+#include "parquet/schema.h"
+#include "parquet/util/memory.h"
+
+namespace parquet {
+
+using schema::GroupNode;
+
+namespace test {
+
+static ByteArray ToByteArray(const std::string& value) {
+  return ByteArray(static_cast<uint32_t>(value.size()),
+                   reinterpret_cast<const uint8_t*>(value.data()));
+}
+
+TEST(TestBloomFilter, XxHash) {
+  // Reference values of the 64 bit xxHash with seed 0
+  ASSERT_EQ(0xEF46DB3751D8E999ULL, BloomFilter::Hash(ToByteArray("")));
+  ASSERT_EQ(0xD24EC4F1A98C6E5BULL, BloomFilter::Hash(ToByteArray("a")));
+  ASSERT_EQ(0x44BC2CF5AD770999ULL, BloomFilter::Hash(ToByteArray("abc")));
+  ASSERT_EQ(0xFBCEA83C8A378BF1ULL,
+            BloomFilter::Hash(ToByteArray("Nobody inspects the spammish repetition")));
+
+  std::string bytes = "0123456789ab";
+  FLBA flba(reinterpret_cast<const uint8_t*>(bytes.data()));
+  ASSERT_EQ(BloomFilter::Hash(ToByteArray(bytes)), BloomFilter::Hash(flba, 12));
+}
+
+TEST(TestBloomFilter, OptimalNumOfBytes) {
+  ASSERT_EQ(BloomFilter::kMinimumBytes, BloomFilter::OptimalNumOfBytes(0, 0.01));
+  ASSERT_EQ(BloomFilter::kMaximumBytes,
+            BloomFilter::OptimalNumOfBytes(1U << 31, 0.001));
+
+  uint32_t num_bytes = BloomFilter::OptimalNumOfBytes(100000, 0.01);
+  ASSERT_EQ(0U, num_bytes & (num_bytes - 1));
+  ASSERT_GE(num_bytes, 100000U);
+  ASSERT_LT(BloomFilter::OptimalNumOfBytes(100000, 0.5), num_bytes);
+
+  ASSERT_THROW(BloomFilter::OptimalNumOfBytes(100, 0.0), ParquetException);
+  ASSERT_THROW(BloomFilter::OptimalNumOfBytes(100, 1.0), ParquetException);
+  ASSERT_EQ(64U, BloomFilter(33).num_bytes());
+}
+
+TEST(TestBloomFilter, InsertAndFind) {
+  const int32_t num_values = 10000;
+  BloomFilter filter(BloomFilter::OptimalNumOfBytes(num_values, 0.01));
+  for (int64_t i = 0; i < num_values; ++i) {
+    filter.InsertHash(BloomFilter::Hash(i));
+  }
+
+  for (int64_t i = 0; i < num_values; ++i) {
+    ASSERT_TRUE(filter.FindHash(BloomFilter::Hash(i)));
+  }
+  int false_positives = 0;
+  for (int64_t i = num_values; i < 2 * num_values; ++i) {
+    false_positives += filter.FindHash(BloomFilter::Hash(i));
+  }
+  ASSERT_LT(false_positives, num_values / 50);
+
+  // Round trip
+  InMemoryOutputStream sink;
+  filter.WriteTo(&sink);
+  ArrowInputFile source(std::make_shared<::arrow::io::BufferReader>(sink.GetBuffer()));
+  std::unique_ptr<BloomFilter> result = BloomFilter::Deserialize(&source, 0);
+  ASSERT_EQ(filter.num_bytes(), result->num_bytes());
+  for (int64_t i = 0; i < 2 * num_values; ++i) {
+    ASSERT_EQ(filter.FindHash(BloomFilter::Hash(i)),
+              result->FindHash(BloomFilter::Hash(i)));
+  }
+}
+
+TEST(TestBloomFilter, ColumnChunk) {
+  const int num_rows = 1000;
+  auto gnode = std::static_pointer_cast<GroupNode>(GroupNode::Make(
+      "schema", Repetition::REQUIRED,
+      {schema::Int64("id", Repetition::REQUIRED),
+       schema::ByteArray("name", Repetition::OPTIONAL),
+       schema::Int32("plain", Repetition::REQUIRED)}));
+  std::shared_ptr<WriterProperties> properties = WriterProperties::Builder()
+                                                     .enable_bloom_filter("id")
+                                                     ->enable_bloom_filter("name", 0.05)
+                                                     ->build();
+
+  std::vector<int64_t> ids(num_rows);
+  std::vector<int32_t> plain(num_rows);
+  std::vector<std::string> names(num_rows);
+  std::vector<ByteArray> name_values;
+  std::vector<int16_t> name_def_levels(num_rows);
+  for (int i = 0; i < num_rows; ++i) {
+    ids[i] = i * 7;
+    plain[i] = i;
+    names[i] = "name" + std::to_string(i);
+    name_def_levels[i] = i % 3 == 0 ? 0 : 1;
+    if (name_def_levels[i]) {
+      name_values.push_back(ToByteArray(names[i]));
+    }
+  }
+
+  std::shared_ptr<InMemoryOutputStream> sink(new InMemoryOutputStream());
+  auto file_writer = ParquetFileWriter::Open(sink, gnode, properties);
+  RowGroupWriter* row_group_writer = file_writer->AppendRowGroup();
+  static_cast<Int64Writer*>(row_group_writer->NextColumn())
+      ->WriteBatch(num_rows, nullptr, nullptr, ids.data());
+  static_cast<ByteArrayWriter*>(row_group_writer->NextColumn())
+      ->WriteBatch(num_rows, name_def_levels.data(), nullptr, name_values.data());
+  static_cast<Int32Writer*>(row_group_writer->NextColumn())
+      ->WriteBatch(num_rows, nullptr, nullptr, plain.data());
+  row_group_writer->Close();
+  file_writer->Close();
+
+  auto file_reader = ParquetFileReader::Open(
+      std::make_shared<::arrow::io::BufferReader>(sink->GetBuffer()));
+  auto rg_reader = file_reader->RowGroup(0);
+  ASSERT_TRUE(rg_reader->metadata()->ColumnChunk(0)->has_bloom_filter());
+  ASSERT_FALSE(rg_reader->metadata()->ColumnChunk(2)->has_bloom_filter());
+  ASSERT_EQ(nullptr, rg_reader->GetBloomFilter(2));
+
+  std::unique_ptr<BloomFilter> id_filter = rg_reader->GetBloomFilter(0);
+  ASSERT_NE(nullptr, id_filter);
+  int false_positives = 0;
+  for (int64_t i = 0; i < num_rows * 7; ++i) {
+    bool found = id_filter->FindHash(BloomFilter::Hash(i));
+    if (i % 7 == 0) {
+      ASSERT_TRUE(found);
+    } else {
+      false_positives += found;
+    }
+  }
+  ASSERT_LT(false_positives, num_rows * 6 / 20);
+
+  std::unique_ptr<BloomFilter> name_filter = rg_reader->GetBloomFilter(1);
+  ASSERT_NE(nullptr, name_filter);
+  for (const ByteArray& value : name_values) {
+    ASSERT_TRUE(name_filter->FindHash(BloomFilter::Hash(value)));
+  }
+
+  // The column chunks are still readable
+  auto id_reader = std::static_pointer_cast<Int64Reader>(rg_reader->Column(0));
+  std::vector<int64_t> ids_out(num_rows);
+  int64_t values_read;
+  id_reader->ReadBatch(num_rows, nullptr, nullptr, ids_out.data(), &values_read);
+  ASSERT_EQ(num_rows, values_read);
+  ASSERT_EQ(ids, ids_out);
+}
+
+}  // namespace test
+
+}  // namespace parquet
@@ -0,0 +1,255 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "parquet/bloom_filter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include "parquet/exception.h"
+#include "parquet/parquet_types.h"
+#include "parquet/thrift.h"
+
+namespace parquet {
+
+// The serialized BloomFilterHeader is a few bytes, read this many when
+// deserializing to be sure to get all of it
+static constexpr int64_t kMaxBloomFilterHeaderSize = 64;
+
+// Bits per block and per word
+static constexpr uint32_t kBytesPerBlock = 32;
+static constexpr int kWordsPerBlock = 8;
+
+// Multiplied with the lower half of a hash to select one bit in every word
+static constexpr uint32_t SALT[kWordsPerBlock] = {0x47b6137bU, 0x44974d91U, 0x8824ad5bU,
+                                                  0xa2b7289dU, 0x705495c7U, 0x2df1424bU,
+                                                  0x9efc4947U, 0x5c6bfb31U};
+
+// ----------------------------------------------------------------------
+// xxHash64, see https://github.com/Cyan4973/xxHash
+
+static constexpr uint64_t PRIME64_1 = 11400714785074694791ULL;
+static constexpr uint64_t PRIME64_2 = 14029467366897019727ULL;
+static constexpr uint64_t PRIME64_3 = 1609587929392839161ULL;
+static constexpr uint64_t PRIME64_4 = 9650029242287828579ULL;
+static constexpr uint64_t PRIME64_5 = 2870177450012600261ULL;
+
+static inline uint64_t RotateLeft(uint64_t value, int bits) {
+  return (value << bits) | (value >> (64 - bits));
+}
+
+static inline uint64_t Load64(const uint8_t* data) {
+  uint64_t value;
+  memcpy(&value, data, sizeof(value));
+  return value;
+}
+
+static inline uint32_t Load32(const uint8_t* data) {
+  uint32_t value;
+  memcpy(&value, data, sizeof(value));
+  return value;
+}
+
+static inline uint64_t XxRound(uint64_t acc, uint64_t input) {
+  acc += input * PRIME64_2;
+  acc = RotateLeft(acc, 31);
+  return acc * PRIME64_1;
+}
+
+static inline uint64_t XxMergeRound(uint64_t acc, uint64_t value) {
+  acc ^= XxRound(0, value);
+  return acc * PRIME64_1 + PRIME64_4;
+}
+
+static uint64_t XxHash64(const uint8_t* data, int64_t length) {
+  const uint8_t* end = data + length;
+  uint64_t hash;
+
+  if (length >= 32) {
+    const uint8_t* limit = end - 32;
+    uint64_t v1 = PRIME64_1 + PRIME64_2;
+    uint64_t v2 = PRIME64_2;
+    uint64_t v3 = 0;
+    uint64_t v4 = 0 - PRIME64_1;
+    do {
+      v1 = XxRound(v1, Load64(data));
+      v2 = XxRound(v2, Load64(data + 8));
+      v3 = XxRound(v3, Load64(data + 16));
+      v4 = XxRound(v4, Load64(data + 24));
+      data += 32;
+    } while (data <= limit);
+
+    hash =
+        RotateLeft(v1, 1) + RotateLeft(v2, 7) + RotateLeft(v3, 12) + RotateLeft(v4, 18);
+    hash = XxMergeRound(hash, v1);
+    hash = XxMergeRound(hash, v2);
+    hash = XxMergeRound(hash, v3);
+    hash = XxMergeRound(hash, v4);
+  } else {
+    hash = PRIME64_5;
+  }
+
+  hash += static_cast<uint64_t>(length);
+
+  for (; data + 8 <= end; data += 8) {
+    hash ^= XxRound(0, Load64(data));
+    hash = RotateLeft(hash, 27) * PRIME64_1 + PRIME64_4;
+  }
+  if (data + 4 <= end) {
+    hash ^= static_cast<uint64_t>(Load32(data)) * PRIME64_1;
+    hash = RotateLeft(hash, 23) * PRIME64_2 + PRIME64_3;
+    data += 4;
+  }
+  for (; data < end; ++data) {
+    hash ^= static_cast<uint64_t>(*data) * PRIME64_5;
+    hash = RotateLeft(hash, 11) * PRIME64_1;
+  }
+
+  hash ^= hash >> 33;
+  hash *= PRIME64_2;
+  hash ^= hash >> 29;
+  hash *= PRIME64_3;
+  hash ^= hash >> 32;
+  return hash;
+}
+
+// ----------------------------------------------------------------------
+// BloomFilter
+
+constexpr uint32_t BloomFilter::kMinimumBytes;
+constexpr uint32_t BloomFilter::kMaximumBytes;
+
+static uint32_t RoundNumBytes(uint32_t num_bytes) {
+  num_bytes = std::min(std::max(num_bytes, BloomFilter::kMinimumBytes),
+                       BloomFilter::kMaximumBytes);
+  uint32_t result = BloomFilter::kMinimumBytes;
+  while (result < num_bytes) {
+    result <<= 1;
+  }
+  return result;
+}
+
+BloomFilter::BloomFilter(uint32_t num_bytes, ::arrow::MemoryPool* pool)
+    : num_bytes_(RoundNumBytes(num_bytes)), data_(AllocateBuffer(pool, num_bytes_)) {
+  memset(data_->mutable_data(), 0, num_bytes_);
+}
+
+uint32_t BloomFilter::OptimalNumOfBytes(uint32_t ndv, double fpp) {
+  if (!(fpp > 0.0 && fpp < 1.0)) {
+    throw ParquetException("Bloom filter false positive probability must be in (0, 1)");
+  }
+  // Each value sets kWordsPerBlock bits, one per word of its block
+  double num_bits =
+      -8.0 * static_cast<double>(ndv) / std::log(1.0 - std::pow(fpp, 1.0 / 8));
+  if (num_bits >= static_cast<double>(kMaximumBytes) * 8) {
+    return kMaximumBytes;
+  }
+  return RoundNumBytes(static_cast<uint32_t>(num_bits / 8));
+}
+
+std::unique_ptr<BloomFilter> BloomFilter::Deserialize(RandomAccessSource* source,
+                                                      int64_t offset,
+                                                      ::arrow::MemoryPool* pool) {
+  std::shared_ptr<Buffer> header_buffer =
+      source->ReadAt(offset, kMaxBloomFilterHeaderSize);
+  uint32_t header_size = static_cast<uint32_t>(header_buffer->size());
+  format::BloomFilterHeader header;
+  DeserializeThriftMsg(header_buffer->data(), &header_size, &header);
+
+  if (!header.algorithm.__isset.BLOCK || !header.hash.__isset.XXHASH ||
+      !header.compression.__isset.UNCOMPRESSED) {
+    throw ParquetException("Unsupported Bloom filter algorithm, hash or compression");
+  }
+  uint32_t num_bytes = static_cast<uint32_t>(header.numBytes);
+  if (header.numBytes <= 0 || RoundNumBytes(num_bytes) != num_bytes) {
+    throw ParquetException("Corrupted Bloom filter: invalid bitset size");
+  }
+
+  std::unique_ptr<BloomFilter> filter(new BloomFilter(num_bytes, pool));
+  int64_t bytes_read =
+      source->ReadAt(offset + header_size, num_bytes, filter->data_->mutable_data());
+  if (bytes_read != num_bytes) {
+    throw ParquetException("Unable to read Bloom filter bitset");
+  }
+  return filter;
+}
+
+uint64_t BloomFilter::Hash(int32_t value) {
+  return XxHash64(reinterpret_cast<const uint8_t*>(&value), sizeof(value));
+}
+
+uint64_t BloomFilter::Hash(int64_t value) {
+  return XxHash64(reinterpret_cast<const uint8_t*>(&value), sizeof(value));
+}
+
+uint64_t BloomFilter::Hash(float value) {
+  return XxHash64(reinterpret_cast<const uint8_t*>(&value), sizeof(value));
+}
+
+uint64_t BloomFilter::Hash(double value) {
+  return XxHash64(reinterpret_cast<const uint8_t*>(&value), sizeof(value));
+}
+
+uint64_t BloomFilter::Hash(const Int96& value) {
+  return XxHash64(reinterpret_cast<const uint8_t*>(value.value), sizeof(value.value));
+}
+
+uint64_t BloomFilter::Hash(const ByteArray& value) {
+  return XxHash64(value.ptr, value.len);
+}
+
+uint64_t BloomFilter::Hash(const FLBA& value, uint32_t type_length) {
+  return XxHash64(value.ptr, type_length);
+}
+
+void BloomFilter::InsertHash(uint64_t hash) {
+  uint32_t num_blocks = num_bytes_ / kBytesPerBlock;
+  uint32_t block_index = static_cast<uint32_t>(((hash >> 32) * num_blocks) >> 32);
+  uint32_t key = static_cast<uint32_t>(hash);
+  uint32_t* block =
+      reinterpret_cast<uint32_t*>(data_->mutable_data()) + block_index * kWordsPerBlock;
+  for (int i = 0; i < kWordsPerBlock; ++i) {
+    block[i] |= 1U << ((key * SALT[i]) >> 27);
+  }
+}
+
+bool BloomFilter::FindHash(uint64_t hash) const {
+  uint32_t num_blocks = num_bytes_ / kBytesPerBlock;
+  uint32_t block_index = static_cast<uint32_t>(((hash >> 32) * num_blocks) >> 32);
+  uint32_t key = static_cast<uint32_t>(hash);
+  const uint32_t* block =
+      reinterpret_cast<const uint32_t*>(data_->data()) + block_index * kWordsPerBlock;
+  for (int i = 0; i < kWordsPerBlock; ++i) {
+    if ((block[i] & (1U << ((key * SALT[i]) >> 27))) == 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+void BloomFilter::WriteTo(OutputStream* sink) const {
+  format::BloomFilterHeader header;
+  header.__set_numBytes(static_cast<int32_t>(num_bytes_));
+  header.algorithm.__set_BLOCK(format::SplitBlockAlgorithm());
+  header.hash.__set_XXHASH(format::XxHash());
+  header.compression.__set_UNCOMPRESSED(format::Uncompressed());
+  SerializeThriftMsg(&header, sizeof(format::BloomFilterHeader), sink);
+  sink->Write(data_->data(), num_bytes_);
+}
+
+}  // namespace parquet
@@ -0,0 +1,78 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef PARQUET_BLOOM_FILTER_H
+#define PARQUET_BLOOM_FILTER_H
+
+#include <cstdint>
+#include <memory>
+
+#include "parquet/types.h"
+#include "parquet/util/memory.h"
+#include "parquet/util/visibility.h"
+
+namespace parquet {
+
+// Split block Bloom filter of a column chunk. The bitset is divided into 256
+// bit blocks, a hash sets one bit in each of the eight 32 bit words of the
+// block selected by its upper half. Values are hashed with 64 bit xxHash of
+// their plain encoding (without the length prefix for BYTE_ARRAY).
+class PARQUET_EXPORT BloomFilter {
+ public:
+  static constexpr uint32_t kMinimumBytes = 32;
+  static constexpr uint32_t kMaximumBytes = 128 * 1024 * 1024;
+
+  // An empty filter. num_bytes is rounded up to a power of two within
+  // [kMinimumBytes, kMaximumBytes].
+  explicit BloomFilter(uint32_t num_bytes,
+                       ::arrow::MemoryPool* pool = ::arrow::default_memory_pool());
+
+  // Number of bytes for a filter of ndv distinct values to have a false
+  // positive probability of at most fpp
+  static uint32_t OptimalNumOfBytes(uint32_t ndv, double fpp);
+
+  // Read the filter that starts at offset
+  static std::unique_ptr<BloomFilter> Deserialize(
+      RandomAccessSource* source, int64_t offset,
+      ::arrow::MemoryPool* pool = ::arrow::default_memory_pool());
+
+  static uint64_t Hash(int32_t value);
+  static uint64_t Hash(int64_t value);
+  static uint64_t Hash(float value);
+  static uint64_t Hash(double value);
+  static uint64_t Hash(const Int96& value);
+  static uint64_t Hash(const ByteArray& value);
+  static uint64_t Hash(const FLBA& value, uint32_t type_length);
+
+  void InsertHash(uint64_t hash);
+
+  // False if no value with this hash was inserted, true if it may have been
+  bool FindHash(uint64_t hash) const;
+
+  uint32_t num_bytes() const { return num_bytes_; }
+
+  // Serialize the BloomFilterHeader followed by the bitset
+  void WriteTo(OutputStream* sink) const;
+
+ private:
+  uint32_t num_bytes_;
+  std::shared_ptr<PoolBuffer> data_;
+};
+
+}  // namespace parquet
+
+#endif  // PARQUET_BLOOM_FILTER_H
@@ -26,6 +26,7 @@
 #include <memory>
 #include <string>
 
+#include "parquet/page_cache.h"
 #include "parquet/statistics.h"
 #include "parquet/types.h"
 #include "parquet/util/memory.h"
@@ -42,7 +43,7 @@ namespace parquet {
 class Page {
  public:
   Page(const std::shared_ptr<Buffer>& buffer, PageType::type type)
-      : buffer_(buffer), type_(type) {}
+      : buffer_(buffer), type_(type), buffer_shared_(false) {}
 
   PageType::type type() const { return type_; }
 
@@ -54,9 +55,17 @@ class Page {
   // @returns: the total size in bytes of the page's data buffer
   int32_t size() const { return static_cast<int32_t>(buffer_->size()); }
 
+  // True if buffer() shares ownership of the page's bytes, e.g. with a memory
+  // mapped file, so that slices of it remain valid after the following pages
+  // are read. Otherwise the bytes may be reused for the next page.
+  bool is_buffer_shared() const { return buffer_shared_; }
+
+  void set_buffer_shared(bool shared) { buffer_shared_ = shared; }
+
  private:
   std::shared_ptr<Buffer> buffer_;
   PageType::type type_;
+  bool buffer_shared_;
 };
 
 class DataPage : public Page {
@@ -95,15 +104,62 @@ class CompressedDataPage : public DataPage {
   CompressedDataPage(const std::shared_ptr<Buffer>& buffer, int32_t num_values,
                      Encoding::type encoding, Encoding::type definition_level_encoding,
                      Encoding::type repetition_level_encoding, int64_t uncompressed_size,
-                     const EncodedStatistics& statistics = EncodedStatistics())
+                     const EncodedStatistics& statistics = EncodedStatistics(),
+                     int64_t first_row_index = -1)
       : DataPage(buffer, num_values, encoding, definition_level_encoding,
                  repetition_level_encoding, statistics),
-        uncompressed_size_(uncompressed_size) {}
+        uncompressed_size_(uncompressed_size),
+        first_row_index_(first_row_index),
+        is_v2_(false),
+        num_nulls_(0),
+        num_rows_(0),
+        definition_levels_byte_length_(0),
+        repetition_levels_byte_length_(0),
+        is_compressed_(true) {}
 
   int64_t uncompressed_size() const { return uncompressed_size_; }
 
+  // Column chunk-relative index of the first row in the page, -1 if the page
+  // does not start at a row boundary
+  int64_t first_row_index() const { return first_row_index_; }
+
+  // Write the page as a DATA_PAGE_V2. The buffer starts with the uncompressed
+  // repetition and definition levels, without their length prefix.
+  void set_v2(int32_t num_nulls, int32_t num_rows, int32_t definition_levels_byte_length,
+              int32_t repetition_levels_byte_length) {
+    is_v2_ = true;
+    num_nulls_ = num_nulls;
+    num_rows_ = num_rows;
+    definition_levels_byte_length_ = definition_levels_byte_length;
+    repetition_levels_byte_length_ = repetition_levels_byte_length;
+  }
+
+  // False if the values of a V2 page are stored as they are
+  void set_is_compressed(bool is_compressed) { is_compressed_ = is_compressed; }
+
+  bool is_v2() const { return is_v2_; }
+
+  int32_t num_nulls() const { return num_nulls_; }
+
+  int32_t num_rows() const { return num_rows_; }
+
+  int32_t definition_levels_byte_length() const { return definition_levels_byte_length_; }
+
+  int32_t repetition_levels_byte_length() const { return repetition_levels_byte_length_; }
+
+  bool is_compressed() const { return is_compressed_; }
+
  private:
   int64_t uncompressed_size_;
+  int64_t first_row_index_;
+
+  // DATA_PAGE_V2 header fields
+  bool is_v2_;
+  int32_t num_nulls_;
+  int32_t num_rows_;
+  int32_t definition_levels_byte_length_;
+  int32_t repetition_levels_byte_length_;
+  bool is_compressed_;
 };
 
 class DataPageV2 : public Page {
@@ -111,7 +167,8 @@ class DataPageV2 : public Page {
   DataPageV2(const std::shared_ptr<Buffer>& buffer, int32_t num_values, int32_t num_nulls,
              int32_t num_rows, Encoding::type encoding,
              int32_t definition_levels_byte_length, int32_t repetition_levels_byte_length,
-             bool is_compressed = false)
+             bool is_compressed = false,
+             const EncodedStatistics& statistics = EncodedStatistics())
       : Page(buffer, PageType::DATA_PAGE_V2),
         num_values_(num_values),
         num_nulls_(num_nulls),
@@ -119,7 +176,8 @@ class DataPageV2 : public Page {
         encoding_(encoding),
         definition_levels_byte_length_(definition_levels_byte_length),
         repetition_levels_byte_length_(repetition_levels_byte_length),
-        is_compressed_(is_compressed) {}
+        is_compressed_(is_compressed),
+        statistics_(statistics) {}
 
   int32_t num_values() const { return num_values_; }
 
@@ -135,6 +193,8 @@ class DataPageV2 : public Page {
 
   bool is_compressed() const { return is_compressed_; }
 
+  const EncodedStatistics& statistics() const { return statistics_; }
+
  private:
   int32_t num_values_;
   int32_t num_nulls_;
@@ -143,8 +203,7 @@ class DataPageV2 : public Page {
   int32_t definition_levels_byte_length_;
   int32_t repetition_levels_byte_length_;
   bool is_compressed_;
-
-  // TODO(wesm): format::DataPageHeaderV2.statistics
+  EncodedStatistics statistics_;
 };
 
 class DictionaryPage : public Page {
@@ -154,7 +213,8 @@ class DictionaryPage : public Page {
       : Page(buffer, PageType::DICTIONARY_PAGE),
         num_values_(num_values),
         encoding_(encoding),
-        is_sorted_(is_sorted) {}
+        is_sorted_(is_sorted),
+        offset_(0) {}
 
   int32_t num_values() const { return num_values_; }
 
@@ -162,10 +222,34 @@ class DictionaryPage : public Page {
 
   bool is_sorted() const { return is_sorted_; }
 
+  // Share the decoded dictionary of this page, at offset of the file, through
+  // cache with the other readers of the column chunk
+  void set_page_cache(std::shared_ptr<PageCache> cache, const std::string& file_key,
+                      int64_t offset) {
+    page_cache_ = std::move(cache);
+    file_key_ = file_key;
+    offset_ = offset;
+  }
+
+  // Returns false if the page has no cache or its dictionary is not cached
+  bool GetDecodedDictionary(DecodedDictionary* out) const {
+    return page_cache_ != nullptr && page_cache_->GetDictionary(file_key_, offset_, out);
+  }
+
+  void PutDecodedDictionary(const DecodedDictionary& dictionary) const {
+    if (page_cache_ != nullptr) {
+      page_cache_->PutDictionary(file_key_, offset_, dictionary);
+    }
+  }
+
  private:
   int32_t num_values_;
   Encoding::type encoding_;
   bool is_sorted_;
+
+  std::shared_ptr<PageCache> page_cache_;
+  std::string file_key_;
+  int64_t offset_;
 };
 
 }  // namespace parquet
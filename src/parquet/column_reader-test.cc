@@ -323,6 +323,219 @@ TEST_F(TestPrimitiveReader, TestInt32FlatRequiredSkip) {
   reader_.reset();
 }
 
+TEST_F(TestPrimitiveReader, TestInt32FlatOptionalSelectedRows) {
+  int levels_per_page = 100;
+  int num_pages = 5;
+  int num_levels = levels_per_page * num_pages;
+  max_def_level_ = 1;
+  max_rep_level_ = 0;
+  NodePtr type = schema::Int32("b", Repetition::OPTIONAL);
+  const ColumnDescriptor descr(type, max_def_level_, max_rep_level_);
+
+  // Every third row, except for the second and third page that are skipped
+  vector<uint8_t> selection(BitUtil::BytesForBits(num_levels), 0);
+  vector<RowRange> ranges;
+  vector<int16_t> expected_def_levels;
+  vector<int32_t> expected_values;
+  for (Encoding::type encoding : {Encoding::PLAIN, Encoding::RLE_DICTIONARY}) {
+    MakePages<Int32Type>(&descr, num_pages, levels_per_page, def_levels_, rep_levels_,
+                         values_, data_buffer_, pages_, encoding);
+    ranges.clear();
+    expected_def_levels.clear();
+    expected_values.clear();
+    int value_index = 0;
+    for (int i = 0; i < num_levels; ++i) {
+      const bool selected =
+          i % 3 == 0 && (i < levels_per_page || i >= 3 * levels_per_page);
+      if (selected) {
+        BitUtil::SetBit(selection.data(), i);
+        ranges.push_back({i, i + 1});
+        expected_def_levels.push_back(def_levels_[i]);
+        if (def_levels_[i] == max_def_level_) {
+          expected_values.push_back(values_[value_index]);
+        }
+      }
+      if (def_levels_[i] == max_def_level_) {
+        ++value_index;
+      }
+    }
+
+    for (bool use_ranges : {false, true}) {
+      InitReader(&descr);
+      Int32Reader* reader = static_cast<Int32Reader*>(reader_.get());
+      vector<int16_t> dresult(num_levels, -1);
+      vector<int32_t> vresult(num_levels, -1);
+      int64_t values_read = 0;
+      int64_t levels_read =
+          use_ranges ? reader->ReadRowRanges(ranges, dresult.data(), nullptr,
+                                             vresult.data(), &values_read)
+                     : reader->ReadSelectedRows(num_levels, selection.data(), 0,
+                                                dresult.data(), nullptr,
+                                                vresult.data(), &values_read);
+      ASSERT_EQ(static_cast<int64_t>(expected_def_levels.size()), levels_read);
+      ASSERT_EQ(static_cast<int64_t>(expected_values.size()), values_read);
+      dresult.resize(levels_read);
+      vresult.resize(values_read);
+      ASSERT_TRUE(vector_equal(expected_def_levels, dresult));
+      ASSERT_TRUE(vector_equal(expected_values, vresult));
+    }
+    Clear();
+  }
+}
+
+TEST_F(TestPrimitiveReader, TestInt32FlatOptionalSelection) {
+  int levels_per_page = 100;
+  int num_pages = 5;
+  int num_levels = levels_per_page * num_pages;
+  max_def_level_ = 1;
+  max_rep_level_ = 0;
+  NodePtr type = schema::Int32("b", Repetition::OPTIONAL);
+  const ColumnDescriptor descr(type, max_def_level_, max_rep_level_);
+
+  for (Encoding::type encoding : {Encoding::PLAIN, Encoding::RLE_DICTIONARY}) {
+    MakePages<Int32Type>(&descr, num_pages, levels_per_page, def_levels_, rep_levels_,
+                         values_, data_buffer_, pages_, encoding);
+    const int32_t threshold = values_[values_.size() / 2];
+    vector<uint8_t> expected(num_levels, 0);
+    int64_t expected_selected = 0;
+    int value_index = 0;
+    for (int i = 0; i < num_levels; ++i) {
+      if (def_levels_[i] == max_def_level_) {
+        if (values_[value_index++] < threshold) {
+          expected[i] = 1;
+          ++expected_selected;
+        }
+      }
+    }
+
+    InitReader(&descr);
+    Int32Reader* reader = static_cast<Int32Reader*>(reader_.get());
+    reader->set_selection_predicate(
+        [threshold](const int32_t& value) { return value < threshold; });
+    // Read the selection in batches that do not line up with the pages
+    vector<uint8_t> selection(BitUtil::BytesForBits(num_levels), 0xFF);
+    int64_t num_selected = 0;
+    int64_t rows_read = 0;
+    while (rows_read < num_levels) {
+      int64_t batch_selected = 0;
+      const int64_t batch_rows =
+          reader->ReadSelection(std::min<int64_t>(73, num_levels - rows_read),
+                                selection.data(), rows_read, &batch_selected);
+      if (batch_rows == 0) break;
+      rows_read += batch_rows;
+      num_selected += batch_selected;
+    }
+    ASSERT_EQ(num_levels, rows_read);
+    ASSERT_EQ(expected_selected, num_selected);
+    for (int i = 0; i < num_levels; ++i) {
+      ASSERT_EQ(expected[i] == 1, BitUtil::GetBit(selection.data(), i)) << i;
+    }
+
+    // No dictionary entry matches
+    InitReader(&descr);
+    reader = static_cast<Int32Reader*>(reader_.get());
+    reader->set_selection_predicate([](const int32_t& value) { return false; });
+    std::fill(selection.begin(), selection.end(), 0xFF);
+    ASSERT_EQ(num_levels,
+              reader->ReadSelection(num_levels, selection.data(), 0, &num_selected));
+    ASSERT_EQ(0, num_selected);
+    for (int i = 0; i < num_levels; ++i) {
+      ASSERT_FALSE(BitUtil::GetBit(selection.data(), i)) << i;
+    }
+    ASSERT_FALSE(reader->HasNext());
+    Clear();
+  }
+}
+
+TEST_F(TestPrimitiveReader, TestInt32FlatOptionalDictionaryRuns) {
+  int levels_per_page = 100;
+  int num_pages = 5;
+  int num_levels = levels_per_page * num_pages;
+  max_def_level_ = 1;
+  max_rep_level_ = 0;
+  NodePtr type = schema::Int32("b", Repetition::OPTIONAL);
+  const ColumnDescriptor descr(type, max_def_level_, max_rep_level_);
+
+  MakePages<Int32Type>(&descr, num_pages, levels_per_page, def_levels_, rep_levels_,
+                       values_, data_buffer_, pages_, Encoding::RLE_DICTIONARY);
+  InitReader(&descr);
+  Int32Reader* reader = static_cast<Int32Reader*>(reader_.get());
+
+  // Few runs per call, so the indices of a call don't all fit
+  const int max_runs = 4;
+  int16_t levels[max_runs];
+  int32_t level_runs[max_runs];
+  int32_t indices[max_runs];
+  int32_t index_runs[max_runs];
+  vector<int16_t> dresult;
+  vector<int32_t> vresult;
+  int64_t rows_read = 0;
+  while (reader->HasDictionaryRuns()) {
+    int num_level_runs = 0;
+    int num_index_runs = 0;
+    rows_read += reader->ReadDictionaryRuns(73, max_runs, levels, level_runs,
+                                            &num_level_runs, indices, index_runs,
+                                            &num_index_runs);
+    int dictionary_length = 0;
+    const int32_t* dictionary = reader->dictionary(&dictionary_length);
+    ASSERT_NE(nullptr, dictionary);
+    for (int i = 0; i < num_level_runs; ++i) {
+      dresult.insert(dresult.end(), level_runs[i], levels[i]);
+    }
+    for (int i = 0; i < num_index_runs; ++i) {
+      ASSERT_LT(indices[i], dictionary_length);
+      vresult.insert(vresult.end(), index_runs[i], dictionary[indices[i]]);
+    }
+  }
+  ASSERT_EQ(num_levels, rows_read);
+  ASSERT_TRUE(vector_equal(def_levels_, dresult));
+  ASSERT_TRUE(vector_equal(values_, vresult));
+  ASSERT_FALSE(reader->HasNext());
+  Clear();
+
+  // Plain encoded pages are read with ReadBatch
+  MakePages<Int32Type>(&descr, num_pages, levels_per_page, def_levels_, rep_levels_,
+                       values_, data_buffer_, pages_, Encoding::PLAIN);
+  InitReader(&descr);
+  reader = static_cast<Int32Reader*>(reader_.get());
+  ASSERT_FALSE(reader->HasDictionaryRuns());
+  ASSERT_TRUE(reader->HasNext());
+  int num_level_runs = 0;
+  int num_index_runs = 0;
+  ASSERT_THROW(reader->ReadDictionaryRuns(73, max_runs, levels, level_runs,
+                                          &num_level_runs, indices, index_runs,
+                                          &num_index_runs),
+               ParquetException);
+  Clear();
+}
+
+TEST_F(TestPrimitiveReader, TestInt32FlatOptionalConstantPages) {
+  // A page of nulls only, then one that repeats the single entry of its
+  // dictionary
+  max_def_level_ = 1;
+  max_rep_level_ = 0;
+  NodePtr type = schema::Int32("b", Repetition::OPTIONAL);
+  const ColumnDescriptor descr(type, max_def_level_, max_rep_level_);
+  const int levels_per_page = 1000;
+  num_levels_ = 2 * levels_per_page;
+  num_values_ = levels_per_page;
+  for (bool spaced : {false, true}) {
+    def_levels_.assign(levels_per_page, 0);
+    def_levels_.resize(num_levels_, 1);
+    values_.assign(num_values_, 42);
+    PaginateDict<Int32Type>(&descr, values_, def_levels_, max_def_level_, rep_levels_,
+                            max_rep_level_, levels_per_page, {0, levels_per_page},
+                            pages_);
+    InitReader(&descr);
+    if (spaced) {
+      CheckResultsSpaced();
+    } else {
+      CheckResults();
+    }
+    Clear();
+  }
+}
+
 TEST_F(TestPrimitiveReader, TestDictionaryEncodedPages) {
   max_def_level_ = 0;
   max_rep_level_ = 0;
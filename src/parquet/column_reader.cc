@@ -18,8 +18,14 @@
 #include "parquet/column_reader.h"
 
 #include <algorithm>
+#include <condition_variable>
 #include <cstdint>
+#include <cstring>
+#include <deque>
+#include <exception>
 #include <memory>
+#include <mutex>
+#include <thread>
 
 #include <arrow/buffer.h>
 #include <arrow/memory_pool.h>
@@ -32,6 +38,8 @@
 #include "parquet/parquet_types.h"
 #include "parquet/properties.h"
 #include "parquet/thrift.h"
+#include "parquet/util/codec-pool.h"
+#include "parquet/util/rle-decoder.h"
 
 using arrow::MemoryPool;
 
@@ -52,7 +60,7 @@ int LevelDecoder::SetData(Encoding::type encoding, int16_t max_level,
       num_bytes = *reinterpret_cast<const int32_t*>(data);
       const uint8_t* decoder_data = data + sizeof(int32_t);
       if (!rle_decoder_) {
-        rle_decoder_.reset(new ::arrow::RleDecoder(decoder_data, num_bytes, bit_width_));
+        rle_decoder_.reset(new RleBitPackedDecoder(decoder_data, num_bytes, bit_width_));
       } else {
         rle_decoder_->Reset(decoder_data, num_bytes, bit_width_);
       }
@@ -74,6 +82,19 @@ int LevelDecoder::SetData(Encoding::type encoding, int16_t max_level,
   return -1;
 }
 
+void LevelDecoder::SetDataV2(int32_t num_bytes, int16_t max_level,
+                             int num_buffered_values, const uint8_t* data) {
+  // The levels of V2 pages are always RLE encoded
+  encoding_ = Encoding::RLE;
+  num_values_remaining_ = num_buffered_values;
+  bit_width_ = BitUtil::Log2(max_level + 1);
+  if (!rle_decoder_) {
+    rle_decoder_.reset(new RleBitPackedDecoder(data, num_bytes, bit_width_));
+  } else {
+    rle_decoder_->Reset(data, num_bytes, bit_width_);
+  }
+}
+
 int LevelDecoder::Decode(int batch_size, int16_t* levels) {
   int num_decoded = 0;
 
@@ -87,6 +108,69 @@ int LevelDecoder::Decode(int batch_size, int16_t* levels) {
   return num_decoded;
 }
 
+int LevelDecoder::DecodeBitmap(int batch_size, uint8_t* valid_bits,
+                               int64_t valid_bits_offset, int64_t* null_count) {
+  if (bit_width_ != 1) {
+    throw ParquetException("Only levels of bit width 1 can be decoded into a bitmap");
+  }
+  int num_decoded = 0;
+
+  int num_values = std::min(num_values_remaining_, batch_size);
+  if (encoding_ == Encoding::RLE) {
+    num_decoded = rle_decoder_->GetBatchBitmap(valid_bits, valid_bits_offset, num_values,
+                                               null_count);
+  } else {
+    uint8_t level;
+    while (num_decoded < num_values && bit_packed_decoder_->GetValue(1, &level)) {
+      BitUtil::SetBitTo(valid_bits, valid_bits_offset + num_decoded, level != 0);
+      *null_count += level != 0 ? 0 : 1;
+      ++num_decoded;
+    }
+  }
+  num_values_remaining_ -= num_decoded;
+  return num_decoded;
+}
+
+int LevelDecoder::DecodeRuns(int batch_size, int max_runs, int16_t* levels,
+                             int32_t* run_lengths, int* num_levels) {
+  int num_runs = 0;
+  int num_decoded = 0;
+
+  int num_values = std::min(num_values_remaining_, batch_size);
+  if (encoding_ == Encoding::RLE) {
+    num_runs =
+        rle_decoder_->GetRuns(levels, run_lengths, max_runs, num_values, &num_decoded);
+  } else {
+    // The levels can't be peeked at, so stop once the runs are full rather
+    // than consume a level that may start another one
+    int16_t level;
+    while (num_decoded < num_values && num_runs < max_runs &&
+           bit_packed_decoder_->GetValue(bit_width_, &level)) {
+      if (num_runs > 0 && levels[num_runs - 1] == level) {
+        ++run_lengths[num_runs - 1];
+      } else {
+        levels[num_runs] = level;
+        run_lengths[num_runs] = 1;
+        ++num_runs;
+      }
+      ++num_decoded;
+    }
+  }
+  num_values_remaining_ -= num_decoded;
+  *num_levels = num_decoded;
+  return num_runs;
+}
+
+int64_t LevelDecoder::RepeatedLevels(int16_t* level) {
+  if (encoding_ != Encoding::RLE || num_values_remaining_ == 0) {
+    return 0;
+  }
+  uint32_t value = 0;
+  const int64_t run_length = rle_decoder_->RepeatedRunLength(&value);
+  *level = static_cast<int16_t>(value);
+  return std::min<int64_t>(run_length, num_values_remaining_);
+}
+
 ReaderProperties default_reader_properties() {
   static ReaderProperties default_reader_properties;
   return default_reader_properties;
@@ -101,34 +185,96 @@ ReaderProperties default_reader_properties() {
 // and the page metadata.
 class SerializedPageReader : public PageReader {
  public:
+  // If reuse_decompression_buffer is false, every decompressed page owns its
+  // data and stays valid after later calls to NextPage
   SerializedPageReader(std::unique_ptr<InputStream> stream, int64_t total_num_rows,
-                       Compression::type codec, ::arrow::MemoryPool* pool)
+                       Compression::type codec, ::arrow::MemoryPool* pool,
+                       bool reuse_decompression_buffer = true)
       : stream_(std::move(stream)),
+        pool_(pool),
         decompression_buffer_(AllocateBuffer(pool, 0)),
+        reuse_decompression_buffer_(reuse_decompression_buffer),
+        stream_offset_(0),
+        has_page_header_(false),
+        seen_dictionary_page_(false),
         seen_num_rows_(0),
         total_num_rows_(total_num_rows) {
     max_page_header_size_ = kDefaultMaxPageHeaderSize;
-    decompressor_ = GetCodecFromArrow(codec);
+    decompressor_ = CodecPool::GetDefault()->Borrow(codec);
   }
 
   // Implement the PageReader interface
   std::shared_ptr<Page> NextPage() override;
 
+  int64_t SkipDataPages(int64_t num_values) override {
+    return SkipPages(num_values, false);
+  }
+
+  int64_t SkipDictionaryDataPages(int64_t num_values) override {
+    return SkipPages(num_values, true);
+  }
+
   void set_max_page_header_size(uint32_t size) override { max_page_header_size_ = size; }
 
+  void set_reuse_decompression_buffer(bool reuse) override {
+    reuse_decompression_buffer_ = reuse;
+  }
+
+  void set_page_cache(std::shared_ptr<PageCache> cache, const std::string& file_key,
+                      int64_t chunk_offset) override {
+    page_cache_ = std::move(cache);
+    file_key_ = file_key;
+    stream_offset_ = chunk_offset;
+  }
+
+  // Pages that are not decompressed into the reused buffer are owned by the
+  // caller
+  int64_t memory_usage() override { return decompression_buffer_->capacity(); }
+
  private:
+  // Deserialize the next page header into current_page_header_, unless it has
+  // been read already. Returns false at the end of the stream
+  bool ReadPageHeader();
+
+  // Ask the data page filter whether to skip the page of current_page_header_
+  bool SkipDataPage();
+
+  // Skip the following data pages as long as all their values fit into
+  // num_values and, if dictionary_encoded_only, they are dictionary encoded
+  int64_t SkipPages(int64_t num_values, bool dictionary_encoded_only);
+
+  // Add page, of current_page_header_, to read_counters_
+  void CountPage(const Page& page, int compressed_len);
+
   std::unique_ptr<InputStream> stream_;
 
+  // Reused for every page header, as is current_page_header_
+  ThriftStreamDeserializer header_deserializer_;
   format::PageHeader current_page_header_;
   std::shared_ptr<Page> current_page_;
 
-  // Compression codec to use.
-  std::unique_ptr<::arrow::Codec> decompressor_;
+  ::arrow::MemoryPool* pool_;
+
+  // Compression codec to use, given back to the codec pool with the reader
+  PooledCodec decompressor_;
   std::shared_ptr<PoolBuffer> decompression_buffer_;
+  bool reuse_decompression_buffer_;
+
+  // Cache of the decompressed pages, which are keyed on the file offset of
+  // their data. stream_offset_ is the file offset of the stream position
+  std::shared_ptr<PageCache> page_cache_;
+  std::string file_key_;
+  int64_t stream_offset_;
 
   // Maximum allowed page size
   uint32_t max_page_header_size_;
 
+  // True if current_page_header_ has been read but not its page
+  bool has_page_header_;
+
+  // True once the dictionary page of the column chunk was read
+  bool seen_dictionary_page_;
+
   // Number of rows read in data pages so far
   int64_t seen_num_rows_;
 
@@ -136,49 +282,172 @@ class SerializedPageReader : public PageReader {
   int64_t total_num_rows_;
 };
 
+static EncodedStatistics FromThrift(const format::Statistics& stats) {
+  EncodedStatistics page_statistics;
+  if (stats.__isset.max) {
+    page_statistics.set_max(stats.max);
+  }
+  if (stats.__isset.min) {
+    page_statistics.set_min(stats.min);
+  }
+  if (stats.__isset.null_count) {
+    page_statistics.set_null_count(stats.null_count);
+  }
+  if (stats.__isset.distinct_count) {
+    page_statistics.set_distinct_count(stats.distinct_count);
+  }
+  return page_statistics;
+}
+
+bool SerializedPageReader::SkipDataPage() {
+  EncodedStatistics page_statistics;
+  int32_t num_values;
+  int32_t num_rows;
+  if (current_page_header_.type == format::PageType::DATA_PAGE) {
+    const format::DataPageHeader& header = current_page_header_.data_page_header;
+    if (header.__isset.statistics) {
+      page_statistics = FromThrift(header.statistics);
+    }
+    num_values = header.num_values;
+    num_rows = -1;
+  } else {
+    const format::DataPageHeaderV2& header = current_page_header_.data_page_header_v2;
+    if (header.__isset.statistics) {
+      page_statistics = FromThrift(header.statistics);
+    }
+    num_values = header.num_values;
+    num_rows = header.num_rows;
+  }
+
+  if (!data_page_filter_(DataPageStats(&page_statistics, num_values, num_rows))) {
+    return false;
+  }
+  seen_num_rows_ += num_values;
+  return true;
+}
+
+bool SerializedPageReader::ReadPageHeader() {
+  if (has_page_header_) {
+    return true;
+  }
+  ScopedReadTimer timer(read_counters_.get(), &ColumnReadCounters::io_nanos);
+
+  // Page headers can be very large because of page statistics. The header is
+  // read from a window of the stream that grows, up to the maximum allowed
+  // header size, until it fits
+  const uint32_t header_size = header_deserializer_.Deserialize(
+      stream_.get(), kDefaultPageHeaderSize, max_page_header_size_,
+      &current_page_header_);
+  if (header_size == 0) {
+    return false;
+  }
+  // Advance the stream offset
+  stream_->Advance(header_size);
+  stream_offset_ += header_size;
+  has_page_header_ = true;
+  if (read_counters_ != nullptr) {
+    ColumnReadCounters::Add(&read_counters_->bytes_read, header_size);
+  }
+  return true;
+}
+
+static bool IsDictionaryEncoded(format::Encoding::type encoding) {
+  return encoding == format::Encoding::PLAIN_DICTIONARY ||
+         encoding == format::Encoding::RLE_DICTIONARY;
+}
+
+int64_t SerializedPageReader::SkipPages(int64_t num_values,
+                                        bool dictionary_encoded_only) {
+  int64_t values_skipped = 0;
+  while (seen_num_rows_ < total_num_rows_ && ReadPageHeader()) {
+    int64_t page_num_values = 0;
+    bool dictionary_encoded = false;
+    if (current_page_header_.type == format::PageType::DATA_PAGE) {
+      page_num_values = current_page_header_.data_page_header.num_values;
+      dictionary_encoded =
+          IsDictionaryEncoded(current_page_header_.data_page_header.encoding);
+    } else if (current_page_header_.type == format::PageType::DATA_PAGE_V2) {
+      page_num_values = current_page_header_.data_page_header_v2.num_values;
+      dictionary_encoded =
+          IsDictionaryEncoded(current_page_header_.data_page_header_v2.encoding);
+    } else if (current_page_header_.type == format::PageType::DICTIONARY_PAGE) {
+      // The dictionary is needed by the pages that follow
+      break;
+    }
+    if (values_skipped + page_num_values > num_values ||
+        (dictionary_encoded_only && !dictionary_encoded)) {
+      break;
+    }
+    stream_->Advance(current_page_header_.compressed_page_size);
+    stream_offset_ += current_page_header_.compressed_page_size;
+    has_page_header_ = false;
+    seen_num_rows_ += page_num_values;
+    values_skipped += page_num_values;
+  }
+  return values_skipped;
+}
+
 std::shared_ptr<Page> SerializedPageReader::NextPage() {
   // Loop here because there may be unhandled page types that we skip until
   // finding a page that we do know what to do with
   while (seen_num_rows_ < total_num_rows_) {
-    int64_t bytes_read = 0;
-    int64_t bytes_available = 0;
-    uint32_t header_size = 0;
-    const uint8_t* buffer;
-    uint32_t allowed_page_size = kDefaultPageHeaderSize;
-
-    // Page headers can be very large because of page statistics
-    // We try to deserialize a larger buffer progressively
-    // until a maximum allowed header limit
-    while (true) {
-      buffer = stream_->Peek(allowed_page_size, &bytes_available);
-      if (bytes_available == 0) {
-        return std::shared_ptr<Page>(nullptr);
-      }
-
-      // This gets used, then set by DeserializeThriftMsg
-      header_size = static_cast<uint32_t>(bytes_available);
-      try {
-        DeserializeThriftMsg(buffer, &header_size, &current_page_header_);
-        break;
-      } catch (std::exception& e) {
-        // Failed to deserialize. Double the allowed page header size and try again
-        std::stringstream ss;
-        ss << e.what();
-        allowed_page_size *= 2;
-        if (allowed_page_size > max_page_header_size_) {
-          ss << "Deserializing page header failed.\n";
-          throw ParquetException(ss.str());
-        }
-      }
+    if (!ReadPageHeader()) {
+      return std::shared_ptr<Page>(nullptr);
     }
-    // Advance the stream offset
-    stream_->Advance(header_size);
+    has_page_header_ = false;
 
+    int64_t bytes_read = 0;
+    const uint8_t* buffer = nullptr;
     int compressed_len = current_page_header_.compressed_page_size;
     int uncompressed_len = current_page_header_.uncompressed_page_size;
 
-    // Read the compressed data page.
-    buffer = stream_->Read(compressed_len, &bytes_read);
+    if (data_page_filter_ &&
+        (current_page_header_.type == format::PageType::DATA_PAGE ||
+         current_page_header_.type == format::PageType::DATA_PAGE_V2) &&
+        SkipDataPage()) {
+      stream_->Advance(compressed_len);
+      stream_offset_ += compressed_len;
+      continue;
+    }
+    const int64_t page_offset = stream_offset_;
+    stream_offset_ += compressed_len;
+
+    // The levels of V2 pages are not compressed, nor are their values if the
+    // writer did not compress them
+    int levels_len = 0;
+    bool decompress = decompressor_ != nullptr;
+    if (current_page_header_.type == format::PageType::DATA_PAGE_V2) {
+      const format::DataPageHeaderV2& header = current_page_header_.data_page_header_v2;
+      levels_len =
+          header.definition_levels_byte_length + header.repetition_levels_byte_length;
+      decompress = decompress && (!header.__isset.is_compressed || header.is_compressed);
+      if (levels_len < 0 || levels_len > compressed_len) {
+        throw ParquetException("Levels of the data page are larger than the page");
+      }
+    }
+
+    // Read the compressed data page. Uncompressed pages are not copied, which
+    // makes them share the bytes of memory mapped files
+    std::shared_ptr<Buffer> page_buffer;
+    bool buffer_shared = false;
+    const bool cache_page = page_cache_ != nullptr && decompress;
+    if (cache_page) {
+      page_buffer = page_cache_->GetPage(file_key_, page_offset);
+    }
+    {
+      ScopedReadTimer timer(read_counters_.get(), &ColumnReadCounters::io_nanos);
+      if (page_buffer != nullptr) {
+        // Decompressed by another reader
+        stream_->Advance(compressed_len);
+        bytes_read = compressed_len;
+        buffer_shared = true;
+      } else if (!decompress) {
+        page_buffer = stream_->ReadAsBuffer(compressed_len, &buffer_shared);
+        bytes_read = page_buffer->size();
+      } else {
+        buffer = stream_->Read(compressed_len, &bytes_read);
+      }
+    }
     if (bytes_read != compressed_len) {
       std::stringstream ss;
       ss << "Page was smaller (" << bytes_read << ") than expected (" << compressed_len
@@ -187,79 +456,258 @@ std::shared_ptr<Page> SerializedPageReader::NextPage() {
     }
 
     // Uncompress it if we need to
-    if (decompressor_ != nullptr) {
+    if (decompress && page_buffer == nullptr) {
+      ScopedReadTimer timer(read_counters_.get(), &ColumnReadCounters::decompress_nanos);
+      // Cached pages own their buffer
+      const bool reuse = reuse_decompression_buffer_ && !cache_page;
+      if (!reuse) {
+        decompression_buffer_ = AllocateBuffer(pool_, uncompressed_len);
+      }
       // Grow the uncompressed buffer if we need to.
       if (uncompressed_len > static_cast<int>(decompression_buffer_->size())) {
         PARQUET_THROW_NOT_OK(decompression_buffer_->Resize(uncompressed_len, false));
       }
-      PARQUET_THROW_NOT_OK(
-          decompressor_->Decompress(compressed_len, buffer, uncompressed_len,
-                                    decompression_buffer_->mutable_data()));
-      buffer = decompression_buffer_->data();
+      if (levels_len > 0) {
+        memcpy(decompression_buffer_->mutable_data(), buffer, levels_len);
+      }
+      PARQUET_THROW_NOT_OK(decompressor_->Decompress(
+          compressed_len - levels_len, buffer + levels_len, uncompressed_len - levels_len,
+          decompression_buffer_->mutable_data() + levels_len));
+      if (reuse) {
+        page_buffer =
+            std::make_shared<Buffer>(decompression_buffer_->data(), uncompressed_len);
+      } else {
+        page_buffer = ::arrow::SliceBuffer(decompression_buffer_, 0, uncompressed_len);
+        buffer_shared = true;
+      }
+      if (cache_page) {
+        page_cache_->PutPage(file_key_, page_offset, page_buffer);
+      }
     }
 
-    auto page_buffer = std::make_shared<Buffer>(buffer, uncompressed_len);
-
+    std::shared_ptr<Page> page;
     if (current_page_header_.type == format::PageType::DICTIONARY_PAGE) {
       const format::DictionaryPageHeader& dict_header =
           current_page_header_.dictionary_page_header;
 
       bool is_sorted = dict_header.__isset.is_sorted ? dict_header.is_sorted : false;
 
-      return std::make_shared<DictionaryPage>(page_buffer, dict_header.num_values,
-                                              FromThrift(dict_header.encoding),
-                                              is_sorted);
+      auto dictionary_page = std::make_shared<DictionaryPage>(
+          page_buffer, dict_header.num_values, FromThrift(dict_header.encoding),
+          is_sorted);
+      if (page_cache_ != nullptr) {
+        dictionary_page->set_page_cache(page_cache_, file_key_, page_offset);
+      }
+      page = dictionary_page;
+      seen_dictionary_page_ = true;
     } else if (current_page_header_.type == format::PageType::DATA_PAGE) {
       const format::DataPageHeader& header = current_page_header_.data_page_header;
 
       EncodedStatistics page_statistics;
       if (header.__isset.statistics) {
-        const format::Statistics& stats = header.statistics;
-        if (stats.__isset.max) {
-          page_statistics.set_max(stats.max);
-        }
-        if (stats.__isset.min) {
-          page_statistics.set_min(stats.min);
-        }
-        if (stats.__isset.null_count) {
-          page_statistics.set_null_count(stats.null_count);
-        }
-        if (stats.__isset.distinct_count) {
-          page_statistics.set_distinct_count(stats.distinct_count);
-        }
+        page_statistics = FromThrift(header.statistics);
       }
 
       seen_num_rows_ += header.num_values;
 
-      return std::make_shared<DataPage>(
+      page = std::make_shared<DataPage>(
           page_buffer, header.num_values, FromThrift(header.encoding),
           FromThrift(header.definition_level_encoding),
           FromThrift(header.repetition_level_encoding), page_statistics);
     } else if (current_page_header_.type == format::PageType::DATA_PAGE_V2) {
       const format::DataPageHeaderV2& header = current_page_header_.data_page_header_v2;
-      bool is_compressed = header.__isset.is_compressed ? header.is_compressed : false;
+      // is_compressed defaults to true
+      bool is_compressed = !header.__isset.is_compressed || header.is_compressed;
+
+      EncodedStatistics page_statistics;
+      if (header.__isset.statistics) {
+        page_statistics = FromThrift(header.statistics);
+      }
 
       seen_num_rows_ += header.num_values;
 
-      return std::make_shared<DataPageV2>(
+      page = std::make_shared<DataPageV2>(
           page_buffer, header.num_values, header.num_nulls, header.num_rows,
           FromThrift(header.encoding), header.definition_levels_byte_length,
-          header.repetition_levels_byte_length, is_compressed);
+          header.repetition_levels_byte_length, is_compressed, page_statistics);
     } else {
       // We don't know what this page type is. We're allowed to skip non-data
       // pages.
       continue;
     }
+    page->set_buffer_shared(buffer_shared);
+    if (read_counters_ != nullptr) {
+      CountPage(*page, compressed_len);
+    }
+    return page;
   }
   return std::shared_ptr<Page>(nullptr);
 }
 
+void SerializedPageReader::CountPage(const Page& page, int compressed_len) {
+  ColumnReadCounters::Add(&read_counters_->bytes_read, compressed_len);
+  if (page.type() == PageType::DICTIONARY_PAGE) {
+    ColumnReadCounters::Add(&read_counters_->num_dictionary_pages, 1);
+    return;
+  }
+  ColumnReadCounters::Add(&read_counters_->num_data_pages, 1);
+  const format::Encoding::type encoding =
+      current_page_header_.type == format::PageType::DATA_PAGE
+          ? current_page_header_.data_page_header.encoding
+          : current_page_header_.data_page_header_v2.encoding;
+  if (seen_dictionary_page_ && !IsDictionaryEncoded(encoding)) {
+    ColumnReadCounters::Add(&read_counters_->num_dictionary_fallback_pages, 1);
+  }
+}
+
+// ----------------------------------------------------------------------
+// ReadAheadPageReader pulls pages from another PageReader on a background
+// thread, keeping up to a fixed number of them in a queue. This overlaps the
+// I/O and decompression of the following pages with the decoding of the
+// current one. The wrapped reader must return pages that stay valid after
+// subsequent calls to NextPage.
+
+class ReadAheadPageReader : public PageReader {
+ public:
+  ReadAheadPageReader(std::unique_ptr<PageReader> source, int64_t num_pages)
+      : source_(std::move(source)),
+        capacity_(static_cast<size_t>(num_pages)),
+        started_(false),
+        finished_(false),
+        stopped_(false) {}
+
+  ~ReadAheadPageReader() override {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopped_ = true;
+    }
+    not_full_.notify_all();
+    if (worker_.joinable()) {
+      worker_.join();
+    }
+  }
+
+  std::shared_ptr<Page> NextPage() override {
+    if (!started_) {
+      started_ = true;
+      worker_ = std::thread([this]() { ReadPages(); });
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    not_empty_.wait(lock, [this]() { return !queue_.empty() || finished_; });
+    if (queue_.empty()) {
+      if (error_) {
+        std::rethrow_exception(error_);
+      }
+      return std::shared_ptr<Page>(nullptr);
+    }
+    std::shared_ptr<Page> page = queue_.front();
+    queue_.pop_front();
+    not_full_.notify_one();
+    return page;
+  }
+
+  // Pages can be skipped until the background thread starts reading them
+  int64_t SkipDataPages(int64_t num_values) override {
+    return started_ ? 0 : source_->SkipDataPages(num_values);
+  }
+
+  int64_t SkipDictionaryDataPages(int64_t num_values) override {
+    return started_ ? 0 : source_->SkipDictionaryDataPages(num_values);
+  }
+
+  // Must be called before the first call to NextPage
+  void set_max_page_header_size(uint32_t size) override {
+    DCHECK(!started_);
+    source_->set_max_page_header_size(size);
+  }
+
+  // Must be called before the first call to NextPage
+  void set_read_counters(std::shared_ptr<ColumnReadCounters> counters) override {
+    DCHECK(!started_);
+    source_->set_read_counters(counters);
+    read_counters_ = std::move(counters);
+  }
+
+  // Must be called before the first call to NextPage
+  void set_data_page_filter(DataPageFilter filter) override {
+    DCHECK(!started_);
+    source_->set_data_page_filter(std::move(filter));
+  }
+
+  // Must be called before the first call to NextPage
+  void set_page_cache(std::shared_ptr<PageCache> cache, const std::string& file_key,
+                      int64_t chunk_offset) override {
+    DCHECK(!started_);
+    source_->set_page_cache(std::move(cache), file_key, chunk_offset);
+  }
+
+  // The pages in the queue, the source reader owns no pages of its own
+  int64_t memory_usage() override {
+    std::lock_guard<std::mutex> lock(mutex_);
+    int64_t size = 0;
+    for (const auto& page : queue_) {
+      size += page->size();
+    }
+    return size;
+  }
+
+ private:
+  void ReadPages() {
+    try {
+      std::shared_ptr<Page> page;
+      do {
+        page = source_->NextPage();
+        std::unique_lock<std::mutex> lock(mutex_);
+        not_full_.wait(lock, [this]() { return stopped_ || queue_.size() < capacity_; });
+        if (stopped_) {
+          return;
+        }
+        if (page == nullptr) {
+          finished_ = true;
+        } else {
+          queue_.push_back(page);
+        }
+        not_empty_.notify_one();
+      } while (page != nullptr);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      error_ = std::current_exception();
+      finished_ = true;
+      not_empty_.notify_one();
+    }
+  }
+
+  std::unique_ptr<PageReader> source_;
+  const size_t capacity_;
+
+  std::thread worker_;
+  bool started_;
+
+  // Guard the state shared with the worker thread
+  std::mutex mutex_;
+  std::condition_variable not_empty_;
+  std::condition_variable not_full_;
+  std::deque<std::shared_ptr<Page>> queue_;
+  bool finished_;
+  bool stopped_;
+  std::exception_ptr error_;
+};
+
 std::unique_ptr<PageReader> PageReader::Open(std::unique_ptr<InputStream> stream,
                                              int64_t total_num_rows,
                                              Compression::type codec,
-                                             ::arrow::MemoryPool* pool) {
+                                             ::arrow::MemoryPool* pool,
+                                             int64_t read_ahead_pages) {
+  // Read-ahead only pays off when there is decompression work to hide
+  if (read_ahead_pages <= 0 || codec == Compression::UNCOMPRESSED) {
+    return std::unique_ptr<PageReader>(
+        new SerializedPageReader(std::move(stream), total_num_rows, codec, pool));
+  }
+  std::unique_ptr<PageReader> source(new SerializedPageReader(
+      std::move(stream), total_num_rows, codec, pool, false));
   return std::unique_ptr<PageReader>(
-      new SerializedPageReader(std::move(stream), total_num_rows, codec, pool));
+      new ReadAheadPageReader(std::move(source), read_ahead_pages));
 }
 
 // ----------------------------------------------------------------------
@@ -274,6 +722,27 @@ ColumnReader::ColumnReader(const ColumnDescriptor* descr,
 
 ColumnReader::~ColumnReader() {}
 
+int64_t ColumnReader::memory_usage() { return pager_->memory_usage(); }
+
+template <typename DType>
+int64_t TypedColumnReader<DType>::memory_usage() {
+  int64_t size = ColumnReader::memory_usage();
+  auto it = decoders_.find(static_cast<int>(Encoding::RLE_DICTIONARY));
+  if (it != decoders_.end()) {
+    // Shared with other readers if it is taken from the page cache
+    const DecodedDictionary& dictionary =
+        static_cast<DictionaryDecoder<DType>*>(it->second.get())->decoded_dictionary();
+    if (dictionary.values) {
+      size += dictionary.values->size();
+    }
+    if (dictionary.byte_array_data) {
+      size += dictionary.byte_array_data->size();
+    }
+  }
+  size += static_cast<int64_t>(dictionary_matches_.capacity());
+  return size;
+}
+
 template <typename DType>
 void TypedColumnReader<DType>::ConfigureDictionary(const DictionaryPage* page) {
   int encoding = static_cast<int>(page->encoding());
@@ -289,9 +758,6 @@ void TypedColumnReader<DType>::ConfigureDictionary(const DictionaryPage* page) {
 
   if (page->encoding() == Encoding::PLAIN_DICTIONARY ||
       page->encoding() == Encoding::PLAIN) {
-    PlainDecoder<DType> dictionary(descr_);
-    dictionary.SetData(page->num_values(), page->data(), page->size());
-
     // The dictionary is fully decoded during DictionaryDecoder::Init, so the
     // DictionaryPage buffer is no longer required after this step
     //
@@ -299,7 +765,15 @@ void TypedColumnReader<DType>::ConfigureDictionary(const DictionaryPage* page) {
     // dictionary makes sense and whether performance can be improved
 
     auto decoder = std::make_shared<DictionaryDecoder<DType>>(descr_, pool_);
-    decoder->SetDict(&dictionary);
+    DecodedDictionary cached;
+    if (page->GetDecodedDictionary(&cached)) {
+      decoder->SetDict(cached);
+    } else {
+      PlainDecoder<DType> dictionary(descr_);
+      dictionary.SetData(page->num_values(), page->data(), page->size());
+      decoder->SetDict(&dictionary);
+      page->PutDecodedDictionary(decoder->decoded_dictionary());
+    }
     decoders_[encoding] = decoder;
   } else {
     ParquetException::NYI("only plain dictionary encoding has been implemented");
@@ -318,6 +792,8 @@ template <typename DType>
 bool TypedColumnReader<DType>::ReadNewPage() {
   // Loop until we find the next data page.
   const uint8_t* buffer;
+  int64_t data_size;
+  Encoding::type encoding;
 
   while (true) {
     current_page_ = pager_->NextPage();
@@ -343,7 +819,7 @@ bool TypedColumnReader<DType>::ReadNewPage() {
       // If the data page includes repetition and definition levels, we
       // initialize the level decoder and subtract the encoded level bytes from
       // the page size to determine the number of bytes in the encoded data.
-      int64_t data_size = page->size();
+      data_size = page->size();
 
       // Data page Layout: Repetition Levels - Definition Levels - encoded values.
       // Levels are encoded as rle or bit-packed.
@@ -366,53 +842,291 @@ bool TypedColumnReader<DType>::ReadNewPage() {
         buffer += def_levels_bytes;
         data_size -= def_levels_bytes;
       }
+      encoding = page->encoding();
+    } else if (current_page_->type() == PageType::DATA_PAGE_V2) {
+      const DataPageV2* page = static_cast<const DataPageV2*>(current_page_.get());
 
-      // Get a decoder object for this page or create a new decoder if this is the
-      // first page with this encoding.
-      Encoding::type encoding = page->encoding();
+      num_buffered_values_ = page->num_values();
+      num_decoded_values_ = 0;
+      buffer = page->data();
+      data_size = page->size();
 
-      if (IsDictionaryIndexEncoding(encoding)) {
-        encoding = Encoding::RLE_DICTIONARY;
+      // Data page V2 layout: Repetition Levels - Definition Levels - encoded
+      // values. The levels are RLE encoded and have no length prefix.
+      if (page->repetition_levels_byte_length() + page->definition_levels_byte_length() >
+          data_size) {
+        throw ParquetException("Levels of the data page are larger than the page");
+      }
+      if (descr_->max_repetition_level() > 0) {
+        repetition_level_decoder_.SetDataV2(page->repetition_levels_byte_length(),
+                                            descr_->max_repetition_level(),
+                                            static_cast<int>(num_buffered_values_),
+                                            buffer);
       }
+      buffer += page->repetition_levels_byte_length();
+      data_size -= page->repetition_levels_byte_length();
 
-      auto it = decoders_.find(static_cast<int>(encoding));
-      if (it != decoders_.end()) {
-        if (encoding == Encoding::RLE_DICTIONARY) {
-          DCHECK(current_decoder_->encoding() == Encoding::RLE_DICTIONARY);
-        }
-        current_decoder_ = it->second.get();
-      } else {
-        switch (encoding) {
-          case Encoding::PLAIN: {
-            std::shared_ptr<DecoderType> decoder(new PlainDecoder<DType>(descr_));
-            decoders_[static_cast<int>(encoding)] = decoder;
-            current_decoder_ = decoder.get();
-            break;
-          }
-          case Encoding::RLE_DICTIONARY:
-            throw ParquetException("Dictionary page must be before data page.");
-
-          case Encoding::DELTA_BINARY_PACKED:
-          case Encoding::DELTA_LENGTH_BYTE_ARRAY:
-          case Encoding::DELTA_BYTE_ARRAY:
-            ParquetException::NYI("Unsupported encoding");
-
-          default:
-            throw ParquetException("Unknown encoding type.");
-        }
+      if (descr_->max_definition_level() > 0) {
+        definition_level_decoder_.SetDataV2(page->definition_levels_byte_length(),
+                                            descr_->max_definition_level(),
+                                            static_cast<int>(num_buffered_values_),
+                                            buffer);
       }
-      current_decoder_->SetData(static_cast<int>(num_buffered_values_), buffer,
-                                static_cast<int>(data_size));
-      return true;
+      buffer += page->definition_levels_byte_length();
+      data_size -= page->definition_levels_byte_length();
+      encoding = page->encoding();
     } else {
       // We don't know what this page type is. We're allowed to skip non-data
       // pages.
       continue;
     }
+
+    // Get a decoder object for this page or create a new decoder if this is the
+    // first page with this encoding.
+    if (IsDictionaryIndexEncoding(encoding)) {
+      encoding = Encoding::RLE_DICTIONARY;
+    }
+
+    auto it = decoders_.find(static_cast<int>(encoding));
+    if (it != decoders_.end()) {
+      if (encoding == Encoding::RLE_DICTIONARY) {
+        DCHECK(current_decoder_->encoding() == Encoding::RLE_DICTIONARY);
+      }
+      current_decoder_ = it->second.get();
+    } else {
+      switch (encoding) {
+        case Encoding::PLAIN: {
+          std::shared_ptr<DecoderType> decoder(new PlainDecoder<DType>(descr_));
+          decoders_[static_cast<int>(encoding)] = decoder;
+          current_decoder_ = decoder.get();
+          break;
+        }
+        case Encoding::RLE_DICTIONARY:
+          throw ParquetException("Dictionary page must be before data page.");
+
+        case Encoding::DELTA_BINARY_PACKED:
+        case Encoding::DELTA_LENGTH_BYTE_ARRAY:
+        case Encoding::DELTA_BYTE_ARRAY: {
+          std::shared_ptr<DecoderType> decoder =
+              MakeDeltaDecoder<DType>(encoding, descr_, this->pool_);
+          decoders_[static_cast<int>(encoding)] = decoder;
+          current_decoder_ = decoder.get();
+          break;
+        }
+        case Encoding::BYTE_STREAM_SPLIT: {
+          std::shared_ptr<DecoderType> decoder =
+              MakeByteStreamSplitDecoder<DType>(descr_);
+          decoders_[static_cast<int>(encoding)] = decoder;
+          current_decoder_ = decoder.get();
+          break;
+        }
+
+        default:
+          throw ParquetException("Unknown encoding type.");
+      }
+    }
+    current_decoder_->SetData(static_cast<int>(num_buffered_values_), buffer,
+                              static_cast<int>(data_size));
+    return true;
   }
   return true;
 }
 
+template <typename DType>
+void TypedColumnReader<DType>::ComputeDictionaryMatches() {
+  if (dictionary_matches_computed_) {
+    return;
+  }
+  auto it = decoders_.find(static_cast<int>(Encoding::RLE_DICTIONARY));
+  DCHECK(it != decoders_.end());
+  auto decoder = static_cast<DictionaryDecoder<DType>*>(it->second.get());
+  const T* dictionary = decoder->dictionary();
+  const int dictionary_length = decoder->dictionary_length();
+  dictionary_matches_.resize(dictionary_length);
+  num_dictionary_matches_ = 0;
+  for (int i = 0; i < dictionary_length; ++i) {
+    const bool match = selection_predicate_(dictionary[i]);
+    dictionary_matches_[i] = match;
+    num_dictionary_matches_ += match;
+  }
+  dictionary_matches_computed_ = true;
+}
+
+template <typename DType>
+int64_t TypedColumnReader<DType>::ReadSelection(int64_t num_rows, uint8_t* selection,
+                                                int64_t selection_offset,
+                                                int64_t* num_selected) {
+  if (descr_->max_repetition_level() > 0) {
+    ParquetException::NYI("Reading the selection of repeated columns");
+  }
+  if (!selection_predicate_) {
+    throw ParquetException("No selection predicate has been set");
+  }
+  static constexpr int64_t kBatchSize = 1024;
+  int16_t def_levels[kBatchSize];
+  int32_t indices[kBatchSize];
+  T values[kBatchSize];
+
+  const int16_t max_definition_level = descr_->max_definition_level();
+  ::arrow::internal::BitmapWriter selection_writer(selection, selection_offset,
+                                                   num_rows);
+  *num_selected = 0;
+  int64_t row = 0;
+  while (row < num_rows) {
+    if (num_decoded_values_ == num_buffered_values_ && dictionary_matches_computed_ &&
+        num_dictionary_matches_ == 0) {
+      // None of the rows of the following dictionary encoded pages can be
+      // selected, drop the pages before they are decompressed
+      const int64_t rows_skipped = pager_->SkipDictionaryDataPages(num_rows - row);
+      for (int64_t i = 0; i < rows_skipped; ++i) {
+        selection_writer.Clear();
+        selection_writer.Next();
+      }
+      row += rows_skipped;
+      if (row == num_rows) break;
+    }
+    if (!HasNext()) break;
+
+    const int64_t batch_size =
+        std::min(kBatchSize, std::min(num_rows - row, available_values_current_page()));
+    int64_t num_values = batch_size;
+    if (max_definition_level > 0) {
+      if (ReadDefinitionLevels(batch_size, def_levels) != batch_size) {
+        ParquetException::EofException();
+      }
+      num_values = 0;
+      for (int64_t i = 0; i < batch_size; ++i) {
+        num_values += def_levels[i] == max_definition_level;
+      }
+    }
+
+    const bool dictionary_encoded =
+        current_decoder_->encoding() == Encoding::RLE_DICTIONARY;
+    if (dictionary_encoded) {
+      ComputeDictionaryMatches();
+      auto decoder = static_cast<DictionaryDecoder<DType>*>(current_decoder_);
+      if (num_dictionary_matches_ == 0) {
+        if (decoder->Skip(static_cast<int>(num_values)) != num_values) {
+          ParquetException::EofException();
+        }
+      } else {
+        ScopedReadTimer timer(pager_->read_counters(),
+                              &ColumnReadCounters::value_decode_nanos);
+        decoder->DecodeIndices(indices, static_cast<int>(num_values));
+      }
+    } else if (ReadValues(num_values, values) != num_values) {
+      ParquetException::EofException();
+    }
+
+    int64_t value = 0;
+    for (int64_t i = 0; i < batch_size; ++i) {
+      bool match = false;
+      if (max_definition_level == 0 || def_levels[i] == max_definition_level) {
+        if (dictionary_encoded) {
+          match = num_dictionary_matches_ > 0 && dictionary_matches_[indices[value]];
+        } else {
+          match = selection_predicate_(values[value]);
+        }
+        ++value;
+      }
+      if (match) {
+        selection_writer.Set();
+        ++*num_selected;
+      } else {
+        selection_writer.Clear();
+      }
+      selection_writer.Next();
+    }
+    ConsumeBufferedValues(batch_size);
+    row += batch_size;
+  }
+  selection_writer.Finish();
+  return row;
+}
+
+template <typename DType>
+bool TypedColumnReader<DType>::HasDictionaryRuns() {
+  if (pending_run_values_ > 0) {
+    return true;
+  }
+  return HasNext() && current_decoder_->encoding() == Encoding::RLE_DICTIONARY;
+}
+
+template <typename DType>
+int64_t TypedColumnReader<DType>::ReadDictionaryRuns(
+    int64_t batch_size, int max_runs, int16_t* def_levels, int32_t* def_level_runs,
+    int* num_def_level_runs, int32_t* indices, int32_t* index_runs,
+    int* num_index_runs) {
+  if (descr_->max_repetition_level() > 0) {
+    ParquetException::NYI("Reading the runs of repeated columns");
+  }
+  DCHECK_GT(max_runs, 0);
+  *num_def_level_runs = 0;
+  *num_index_runs = 0;
+  int64_t rows_read = 0;
+  if (pending_run_values_ == 0) {
+    // HasNext invokes ReadNewPage
+    if (!HasNext()) {
+      return 0;
+    }
+    if (current_decoder_->encoding() != Encoding::RLE_DICTIONARY) {
+      throw ParquetException("Runs can only be read from dictionary encoded pages");
+    }
+    const int batch =
+        static_cast<int>(std::min(batch_size, available_values_current_page()));
+    const int16_t max_definition_level = descr_->max_definition_level();
+    if (max_definition_level > 0) {
+      ScopedReadTimer timer(pager_->read_counters(),
+                            &ColumnReadCounters::level_decode_nanos);
+      int num_levels = 0;
+      *num_def_level_runs = definition_level_decoder_.DecodeRuns(
+          batch, max_runs, def_levels, def_level_runs, &num_levels);
+      if (num_levels == 0 && batch > 0) {
+        ParquetException::EofException();
+      }
+      for (int i = 0; i < *num_def_level_runs; ++i) {
+        if (def_levels[i] == max_definition_level) {
+          pending_run_values_ += def_level_runs[i];
+        }
+      }
+      rows_read = num_levels;
+    } else {
+      pending_run_values_ = batch;
+      rows_read = batch;
+    }
+    pending_run_rows_ = rows_read;
+  }
+
+  if (pending_run_values_ > 0) {
+    ScopedReadTimer timer(pager_->read_counters(),
+                          &ColumnReadCounters::value_decode_nanos);
+    auto decoder = static_cast<DictionaryDecoder<DType>*>(current_decoder_);
+    int num_values = 0;
+    *num_index_runs =
+        decoder->DecodeIndexRuns(static_cast<int>(pending_run_values_), max_runs,
+                                 indices, index_runs, &num_values);
+    pending_run_values_ -= num_values;
+  }
+  if (pending_run_values_ == 0) {
+    ConsumeBufferedValues(pending_run_rows_);
+    pending_run_rows_ = 0;
+  }
+  return rows_read;
+}
+
+template <typename DType>
+const typename DType::c_type* TypedColumnReader<DType>::dictionary(
+    int* dictionary_length) const {
+  auto it = decoders_.find(static_cast<int>(Encoding::RLE_DICTIONARY));
+  if (it == decoders_.end()) {
+    *dictionary_length = 0;
+    return nullptr;
+  }
+  auto decoder = static_cast<const DictionaryDecoder<DType>*>(it->second.get());
+  *dictionary_length = decoder->dictionary_length();
+  return decoder->dictionary();
+}
+
 // ----------------------------------------------------------------------
 // Batch read APIs
 
@@ -420,6 +1134,7 @@ int64_t ColumnReader::ReadDefinitionLevels(int64_t batch_size, int16_t* levels)
   if (descr_->max_definition_level() == 0) {
     return 0;
   }
+  ScopedReadTimer timer(pager_->read_counters(), &ColumnReadCounters::level_decode_nanos);
   return definition_level_decoder_.Decode(static_cast<int>(batch_size), levels);
 }
 
@@ -427,6 +1142,7 @@ int64_t ColumnReader::ReadRepetitionLevels(int64_t batch_size, int16_t* levels)
   if (descr_->max_repetition_level() == 0) {
     return 0;
   }
+  ScopedReadTimer timer(pager_->read_counters(), &ColumnReadCounters::level_decode_nanos);
   return repetition_level_decoder_.Decode(static_cast<int>(batch_size), levels);
 }
 
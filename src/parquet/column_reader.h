@@ -22,8 +22,10 @@
 #include <climits>
 #include <cstdint>
 #include <cstring>
+#include <functional>
 #include <iostream>
 #include <memory>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
@@ -35,20 +37,23 @@
 #include "parquet/column_page.h"
 #include "parquet/encoding.h"
 #include "parquet/exception.h"
+#include "parquet/read_metrics.h"
 #include "parquet/schema.h"
 #include "parquet/types.h"
 #include "parquet/util/memory.h"
+#include "parquet/util/spacing.h"
 #include "parquet/util/visibility.h"
 
 namespace arrow {
 
 class BitReader;
-class RleDecoder;
 
 }  // namespace arrow
 
 namespace parquet {
 
+class RleBitPackedDecoder;
+
 // 16 MB is the default maximum page header size
 static constexpr uint32_t kDefaultMaxPageHeaderSize = 16 * 1024 * 1024;
 
@@ -67,33 +72,142 @@ class PARQUET_EXPORT LevelDecoder {
   int SetData(Encoding::type encoding, int16_t max_level, int num_buffered_values,
               const uint8_t* data);
 
+  // Initialize the LevelDecoder state with the num_bytes of RLE encoded levels
+  // of a DATA_PAGE_V2, which have no length prefix
+  void SetDataV2(int32_t num_bytes, int16_t max_level, int num_buffered_values,
+                 const uint8_t* data);
+
   // Decodes a batch of levels into an array and returns the number of levels decoded
   int Decode(int batch_size, int16_t* levels);
 
+  // Decodes a batch of levels of max_level 1 into the bits of valid_bits,
+  // starting at valid_bits_offset, and adds the number of levels of 0 to
+  // null_count. Returns the number of levels decoded
+  int DecodeBitmap(int batch_size, uint8_t* valid_bits, int64_t valid_bits_offset,
+                   int64_t* null_count);
+
+  // Decodes up to batch_size levels as up to max_runs runs of equal levels,
+  // levels[i] repeated run_lengths[i] times, and stores the number of levels
+  // decoded in num_levels. Returns the number of runs. Adjacent runs of
+  // bit-packed levels are only merged while there is room for another run
+  int DecodeRuns(int batch_size, int max_runs, int16_t* levels, int32_t* run_lengths,
+                 int* num_levels);
+
+  // Number of the following levels that all equal the one stored in level,
+  // without consuming them. 0 if the levels don't start with a repeated run
+  // of the RLE encoding, which lets callers handle them as one block
+  int64_t RepeatedLevels(int16_t* level);
+
  private:
   int bit_width_;
   int num_values_remaining_;
   Encoding::type encoding_;
-  std::unique_ptr<::arrow::RleDecoder> rle_decoder_;
+  std::unique_ptr<RleBitPackedDecoder> rle_decoder_;
   std::unique_ptr<::arrow::BitReader> bit_packed_decoder_;
 };
 
+// Header fields of a data page that a DataPageFilter sees before the page is
+// decompressed
+struct DataPageStats {
+  DataPageStats(const EncodedStatistics* encoded_statistics, int32_t num_values,
+                int32_t num_rows)
+      : encoded_statistics(encoded_statistics),
+        num_values(num_values),
+        num_rows(num_rows) {}
+
+  // Statistics of the page, none are set if the writer did not store them
+  const EncodedStatistics* encoded_statistics;
+
+  // Number of values in the page, including nulls
+  int32_t num_values;
+
+  // Number of rows in the page, -1 if the page header does not tell (DATA_PAGE).
+  // For columns that are not repeated this is num_values
+  int32_t num_rows;
+};
+
+// Returns true if the data page is to be skipped
+typedef std::function<bool(const DataPageStats&)> DataPageFilter;
+
+// The rows [begin, end) of a column
+struct RowRange {
+  int64_t begin;
+  int64_t end;
+};
+
 // Abstract page iterator interface. This way, we can feed column pages to the
 // ColumnReader through whatever mechanism we choose
 class PARQUET_EXPORT PageReader {
  public:
   virtual ~PageReader() = default;
 
+  // If read_ahead_pages is positive and the column chunk is compressed, up to
+  // that many pages are read and decompressed on a background thread while
+  // the caller decodes the current page
   static std::unique_ptr<PageReader> Open(
       std::unique_ptr<InputStream> stream, int64_t total_num_rows,
       Compression::type codec,
-      ::arrow::MemoryPool* pool = ::arrow::default_memory_pool());
+      ::arrow::MemoryPool* pool = ::arrow::default_memory_pool(),
+      int64_t read_ahead_pages = 0);
 
   // @returns: shared_ptr<Page>(nullptr) on EOS, std::shared_ptr<Page>
   // containing new Page otherwise
   virtual std::shared_ptr<Page> NextPage() = 0;
 
   virtual void set_max_page_header_size(uint32_t size) = 0;
+
+  // Skip the following data pages as long as all their values fit into
+  // num_values, without reading or decompressing them. Stops at a dictionary
+  // page. Returns the number of values skipped, readers that cannot skip
+  // pages return 0
+  virtual int64_t SkipDataPages(int64_t num_values) { return 0; }
+
+  // Like SkipDataPages, but stops at the first data page that is not
+  // dictionary encoded, for readers that know that none of the dictionary
+  // entries is of interest
+  virtual int64_t SkipDictionaryDataPages(int64_t num_values) { return 0; }
+
+  // If false, every page is decompressed into a buffer of its own rather than
+  // into one that is reused, at the cost of an allocation per page. The pages
+  // are then Page::is_buffer_shared, so their values can be handed out
+  // without copying them. Readers that always do so ignore it
+  virtual void set_reuse_decompression_buffer(bool reuse) {}
+
+  // Look up the decompressed pages in cache before reading them, and share
+  // the decoded dictionaries through it. The pages are identified by file_key
+  // and their file offset, the stream of the reader starts at chunk_offset.
+  // Must be called before the first call to NextPage. Readers that cannot
+  // cache pages ignore it
+  virtual void set_page_cache(std::shared_ptr<PageCache> cache,
+                              const std::string& file_key, int64_t chunk_offset) {}
+
+  // Data pages for which the filter returns true are not returned by NextPage,
+  // their bytes are skipped without decompressing them. Dictionary pages are
+  // always returned. When pages are read ahead the filter is called from the
+  // background thread and must be set before the first call to NextPage.
+  virtual void set_data_page_filter(DataPageFilter filter) {
+    data_page_filter_ = std::move(filter);
+  }
+
+  // Count the bytes and pages that are read and the time spent reading and
+  // decompressing them in counters, see ReaderProperties::set_read_metrics.
+  // The column readers of the pages add their decoding time to them. Must be
+  // set before the first call to NextPage
+  virtual void set_read_counters(std::shared_ptr<ColumnReadCounters> counters) {
+    read_counters_ = std::move(counters);
+  }
+
+  // nullptr unless set
+  ColumnReadCounters* read_counters() const { return read_counters_.get(); }
+
+  // Bytes the reader holds in memory, e.g. for decompressing pages or for
+  // the pages it has read ahead. The buffers of its stream are not counted,
+  // see ReaderProperties::memory_usage for those
+  virtual int64_t memory_usage() { return 0; }
+
+ protected:
+  DataPageFilter data_page_filter_;
+  std::shared_ptr<ColumnReadCounters> read_counters_;
 };
 
 class PARQUET_EXPORT ColumnReader {
@@ -122,6 +236,16 @@ class PARQUET_EXPORT ColumnReader {
 
   const ColumnDescriptor* descr() const { return descr_; }
 
+  // Skip the data pages for which the filter returns true, see
+  // PageReader::set_data_page_filter. Must be set before reading any values
+  void set_data_page_filter(DataPageFilter filter) {
+    pager_->set_data_page_filter(std::move(filter));
+  }
+
+  // Bytes the reader holds in memory: those of its PageReader and of the
+  // decoded dictionary of the column chunk
+  virtual int64_t memory_usage();
+
  protected:
   virtual bool ReadNewPage() = 0;
 
@@ -134,6 +258,12 @@ class PARQUET_EXPORT ColumnReader {
   // Returns the number of decoded repetition levels
   int64_t ReadRepetitionLevels(int64_t batch_size, int16_t* levels);
 
+  // Number of the following definition levels that all equal the one stored
+  // in level, without decoding them. 0 unless they start with a repeated run
+  int64_t RepeatedDefinitionLevels(int16_t* level) {
+    return definition_level_decoder_.RepeatedLevels(level);
+  }
+
   int64_t available_values_current_page() const {
     return num_buffered_values_ - num_decoded_values_;
   }
@@ -213,9 +343,17 @@ class PARQUET_EXPORT TypedColumnReader : public ColumnReader {
  public:
   typedef typename DType::c_type T;
 
+  // Condition on a single non-null value of the column
+  typedef std::function<bool(const T&)> ValuePredicate;
+
   TypedColumnReader(const ColumnDescriptor* schema, std::unique_ptr<PageReader> pager,
                     ::arrow::MemoryPool* pool = ::arrow::default_memory_pool())
-      : ColumnReader(schema, std::move(pager), pool), current_decoder_(nullptr) {}
+      : ColumnReader(schema, std::move(pager), pool),
+        current_decoder_(nullptr),
+        dictionary_matches_computed_(false),
+        num_dictionary_matches_(0),
+        pending_run_values_(0),
+        pending_run_rows_(0) {}
 
   // Read a batch of repetition levels, definition levels, and values from the
   // column.
@@ -280,9 +418,87 @@ class PARQUET_EXPORT TypedColumnReader : public ColumnReader {
   // Returns the number of levels skipped
   int64_t Skip(int64_t num_rows_to_skip);
 
+  // Read the levels and values of the rows selected among the next num_rows
+  // rows. Bit i of selection, counted from selection_offset, selects row i.
+  // Unselected rows are skipped without decoding their values, whole data
+  // pages and runs of dictionary indices at once. Only columns that are not
+  // repeated are supported, the output buffers must have room for the
+  // selected rows.
+  //
+  // @returns: the number of levels read (see values_read for number of values
+  // read)
+  int64_t ReadSelectedRows(int64_t num_rows, const uint8_t* selection,
+                           int64_t selection_offset, int16_t* def_levels,
+                           int16_t* rep_levels, T* values, int64_t* values_read);
+
+  // Like ReadSelectedRows, for the sorted, non-overlapping ranges of rows
+  // counted from the current position of the reader. The rows up to the end
+  // of the last range are consumed.
+  int64_t ReadRowRanges(const std::vector<RowRange>& ranges, int16_t* def_levels,
+                        int16_t* rep_levels, T* values, int64_t* values_read);
+
+  // Set the predicate that ReadSelection evaluates
+  void set_selection_predicate(ValuePredicate predicate) {
+    selection_predicate_ = std::move(predicate);
+    dictionary_matches_computed_ = false;
+  }
+
+  // Evaluate the selection predicate on the next num_rows rows and set bit i
+  // of selection, counted from selection_offset, if the value of row i
+  // satisfies it. Nulls never do. On dictionary encoded pages the predicate
+  // is evaluated once per dictionary entry and only the indices are decoded;
+  // if no entry matches, the dictionary encoded pages are skipped without
+  // decompressing them. The result can be passed to ReadSelectedRows of the
+  // readers of the other columns of the row group. Only columns that are not
+  // repeated are supported.
+  //
+  // @returns: the number of rows read, num_selected is set to the number of
+  // rows that satisfy the predicate
+  int64_t ReadSelection(int64_t num_rows, uint8_t* selection, int64_t selection_offset,
+                        int64_t* num_selected);
+
+  // Whether the next rows are read from a dictionary encoded data page, which
+  // ReadDictionaryRuns requires. Reads the next data page if the current one
+  // is exhausted
+  bool HasDictionaryRuns();
+
+  // Read up to batch_size rows of a non repeated column from a dictionary
+  // encoded data page as runs, for aggregations like sums, counts and
+  // group-bys that take one step per run instead of one per row. The
+  // definition levels of the rows are stored as up to max_runs runs in
+  // def_levels and def_level_runs, none for required columns, and the
+  // dictionary indices of their non-null values as up to max_runs runs in
+  // indices and index_runs. Indices that don't fit are returned by the
+  // following calls before the next rows are read, so the two only line up
+  // over all calls; read while HasDictionaryRuns, without other reads in
+  // between. Throws if the data page is not dictionary encoded.
+  //
+  // @returns: the number of rows whose definition levels were read
+  int64_t ReadDictionaryRuns(int64_t batch_size, int max_runs, int16_t* def_levels,
+                             int32_t* def_level_runs, int* num_def_level_runs,
+                             int32_t* indices, int32_t* index_runs, int* num_index_runs);
+
+  // Dictionary of the column chunk, which the indices of ReadDictionaryRuns
+  // refer to. nullptr if no dictionary page has been read
+  const T* dictionary(int* dictionary_length) const;
+
+  int64_t memory_usage() override;
+
  private:
   typedef Decoder<DType> DecoderType;
 
+  // Skip up to num_levels levels of the current data page and the values they
+  // refer to
+  //
+  // @returns: the number of levels skipped
+  int64_t SkipLevels(int64_t num_levels);
+
+  // Read num_rows rows with ReadBatch, across data pages
+  //
+  // @returns: the number of levels read
+  int64_t ReadRows(int64_t num_rows, int16_t* def_levels, int16_t* rep_levels,
+                   T* values, int64_t* values_read);
+
   // Advance to the next data page
   bool ReadNewPage() override;
 
@@ -307,7 +523,25 @@ class PARQUET_EXPORT TypedColumnReader : public ColumnReader {
 
   void ConfigureDictionary(const DictionaryPage* page);
 
+  // Evaluate the selection predicate on the entries of the dictionary of the
+  // column chunk, unless it has been already
+  void ComputeDictionaryMatches();
+
   DecoderType* current_decoder_;
+
+  ValuePredicate selection_predicate_;
+
+  // Whether the dictionary entry with the index i satisfies the selection
+  // predicate
+  std::vector<uint8_t> dictionary_matches_;
+  bool dictionary_matches_computed_;
+  int64_t num_dictionary_matches_;
+
+  // Non-null values of the rows returned by ReadDictionaryRuns whose indices
+  // have not been returned yet, and the number of those rows. The rows are
+  // consumed once all their indices are
+  int64_t pending_run_values_;
+  int64_t pending_run_rows_;
 };
 
 // ----------------------------------------------------------------------
@@ -315,6 +549,7 @@ class PARQUET_EXPORT TypedColumnReader : public ColumnReader {
 
 template <typename DType>
 inline int64_t TypedColumnReader<DType>::ReadValues(int64_t batch_size, T* out) {
+  ScopedReadTimer timer(pager_->read_counters(), &ColumnReadCounters::value_decode_nanos);
   int64_t num_decoded = current_decoder_->Decode(out, static_cast<int>(batch_size));
   return num_decoded;
 }
@@ -324,6 +559,7 @@ inline int64_t TypedColumnReader<DType>::ReadValuesSpaced(int64_t batch_size, T*
                                                           int64_t null_count,
                                                           uint8_t* valid_bits,
                                                           int64_t valid_bits_offset) {
+  ScopedReadTimer timer(pager_->read_counters(), &ColumnReadCounters::value_decode_nanos);
   return current_decoder_->DecodeSpaced(out, static_cast<int>(batch_size),
                                         static_cast<int>(null_count), valid_bits,
                                         valid_bits_offset);
@@ -351,12 +587,20 @@ inline int64_t TypedColumnReader<DType>::ReadBatch(int64_t batch_size,
 
   // If the field is required and non-repeated, there are no definition levels
   if (descr_->max_definition_level() > 0 && def_levels) {
+    // The levels of a batch within one repeated run, like those of an all-null
+    // page, need no tallying
+    int16_t run_level = 0;
+    const bool single_run = RepeatedDefinitionLevels(&run_level) >= batch_size;
     num_def_levels = ReadDefinitionLevels(batch_size, def_levels);
-    // TODO(wesm): this tallying of values-to-decode can be performed with better
-    // cache-efficiency if fused with the level decoding.
-    for (int64_t i = 0; i < num_def_levels; ++i) {
-      if (def_levels[i] == descr_->max_definition_level()) {
-        ++values_to_read;
+    if (single_run) {
+      values_to_read = run_level == descr_->max_definition_level() ? num_def_levels : 0;
+    } else {
+      // TODO(wesm): this tallying of values-to-decode can be performed with better
+      // cache-efficiency if fused with the level decoding.
+      for (int64_t i = 0; i < num_def_levels; ++i) {
+        if (def_levels[i] == descr_->max_definition_level()) {
+          ++values_to_read;
+        }
       }
     }
   } else {
@@ -422,6 +666,8 @@ inline int64_t TypedColumnReader<DType>::ReadBatchSpaced(
 
   // If the field is required and non-repeated, there are no definition levels
   if (descr_->max_definition_level() > 0) {
+    int16_t run_level = 0;
+    const bool single_run = RepeatedDefinitionLevels(&run_level) >= batch_size;
     int64_t num_def_levels = ReadDefinitionLevels(batch_size, def_levels);
 
     // Not present for non-repeated fields
@@ -436,23 +682,40 @@ inline int64_t TypedColumnReader<DType>::ReadBatchSpaced(
 
     int64_t null_count = 0;
     if (!has_spaced_values) {
-      int values_to_read = 0;
-      for (int64_t i = 0; i < num_def_levels; ++i) {
-        if (def_levels[i] == descr_->max_definition_level()) {
-          ++values_to_read;
+      int64_t values_to_read = 0;
+      if (single_run) {
+        values_to_read =
+            run_level == descr_->max_definition_level() ? num_def_levels : 0;
+      } else {
+        for (int64_t i = 0; i < num_def_levels; ++i) {
+          if (def_levels[i] == descr_->max_definition_level()) {
+            ++values_to_read;
+          }
         }
       }
       total_values = ReadValues(values_to_read, values);
-      for (int64_t i = 0; i < total_values; i++) {
-        ::arrow::BitUtil::SetBit(valid_bits, valid_bits_offset + i);
-      }
+      internal::SetBits(valid_bits, valid_bits_offset, total_values, true);
       *values_read = total_values;
     } else {
       int16_t max_definition_level = descr_->max_definition_level();
       int16_t max_repetition_level = descr_->max_repetition_level();
-      internal::DefinitionLevelsToBitmap(def_levels, num_def_levels, max_definition_level,
-                                         max_repetition_level, values_read, &null_count,
-                                         valid_bits, valid_bits_offset);
+      if (single_run && run_level <= max_definition_level) {
+        // All the levels are values, or all are nulls, or for repeated fields
+        // all are empty lists without a slot
+        const bool has_slots = run_level == max_definition_level ||
+                               max_repetition_level == 0 ||
+                               run_level == max_definition_level - 1;
+        *values_read = has_slots ? num_def_levels : 0;
+        if (run_level != max_definition_level) {
+          null_count = *values_read;
+        }
+        internal::SetBits(valid_bits, valid_bits_offset, *values_read,
+                          run_level == max_definition_level);
+      } else {
+        internal::DefinitionLevelsToBitmap(
+            def_levels, num_def_levels, max_definition_level, max_repetition_level,
+            values_read, &null_count, valid_bits, valid_bits_offset);
+      }
       total_values = ReadValuesSpaced(*values_read, values, static_cast<int>(null_count),
                                       valid_bits, valid_bits_offset);
     }
@@ -462,9 +725,7 @@ inline int64_t TypedColumnReader<DType>::ReadBatchSpaced(
   } else {
     // Required field, read all values
     total_values = ReadValues(batch_size, values);
-    for (int64_t i = 0; i < total_values; i++) {
-      ::arrow::BitUtil::SetBit(valid_bits, valid_bits_offset + i);
-    }
+    internal::SetBits(valid_bits, valid_bits_offset, total_values, true);
     *null_count_out = 0;
     *levels_read = total_values;
   }
@@ -476,39 +737,153 @@ inline int64_t TypedColumnReader<DType>::ReadBatchSpaced(
 template <typename DType>
 int64_t TypedColumnReader<DType>::Skip(int64_t num_rows_to_skip) {
   int64_t rows_to_skip = num_rows_to_skip;
-  while (HasNext() && rows_to_skip > 0) {
+  while (rows_to_skip > 0) {
+    if (num_decoded_values_ == num_buffered_values_) {
+      // Drop the following pages that are skipped entirely before they are
+      // decompressed
+      rows_to_skip -= pager_->SkipDataPages(rows_to_skip);
+      if (rows_to_skip == 0 || !HasNext()) break;
+    }
     // If the number of rows to skip is more than the number of undecoded values, skip the
     // Page.
-    if (rows_to_skip > (num_buffered_values_ - num_decoded_values_)) {
+    if (rows_to_skip >= (num_buffered_values_ - num_decoded_values_)) {
       rows_to_skip -= num_buffered_values_ - num_decoded_values_;
       num_decoded_values_ = num_buffered_values_;
     } else {
-      // We need to read this Page
       // Jump to the right offset in the Page
-      int64_t batch_size = 1024;  // ReadBatch with a smaller memory footprint
-      int64_t values_read = 0;
-
-      std::shared_ptr<PoolBuffer> vals = AllocateBuffer(
-          this->pool_, batch_size * type_traits<DType::type_num>::value_byte_size);
-      std::shared_ptr<PoolBuffer> def_levels =
-          AllocateBuffer(this->pool_, batch_size * sizeof(int16_t));
-
-      std::shared_ptr<PoolBuffer> rep_levels =
-          AllocateBuffer(this->pool_, batch_size * sizeof(int16_t));
-
-      do {
-        batch_size = std::min(batch_size, rows_to_skip);
-        values_read = ReadBatch(static_cast<int>(batch_size),
-                                reinterpret_cast<int16_t*>(def_levels->mutable_data()),
-                                reinterpret_cast<int16_t*>(rep_levels->mutable_data()),
-                                reinterpret_cast<T*>(vals->mutable_data()), &values_read);
-        rows_to_skip -= values_read;
-      } while (values_read > 0 && rows_to_skip > 0);
+      const int64_t levels_skipped = SkipLevels(rows_to_skip);
+      if (levels_skipped == 0) break;
+      rows_to_skip -= levels_skipped;
     }
   }
   return num_rows_to_skip - rows_to_skip;
 }
 
+template <typename DType>
+int64_t TypedColumnReader<DType>::SkipLevels(int64_t num_levels) {
+  num_levels = std::min(num_levels, available_values_current_page());
+
+  int64_t values_to_skip = num_levels;
+  if (descr_->max_definition_level() > 0) {
+    // Only the defined values are stored, count them in the definition levels
+    static constexpr int64_t kBatchSize = 1024;
+    int16_t def_levels[kBatchSize];
+    int16_t rep_levels[kBatchSize];
+    values_to_skip = 0;
+    int64_t levels_read = 0;
+    while (levels_read < num_levels) {
+      const int64_t batch_size = std::min(kBatchSize, num_levels - levels_read);
+      const int64_t num_def_levels = ReadDefinitionLevels(batch_size, def_levels);
+      if (descr_->max_repetition_level() > 0 &&
+          ReadRepetitionLevels(batch_size, rep_levels) != num_def_levels) {
+        throw ParquetException("Number of decoded rep / def levels did not match");
+      }
+      if (num_def_levels == 0) break;
+      for (int64_t i = 0; i < num_def_levels; ++i) {
+        if (def_levels[i] == descr_->max_definition_level()) {
+          ++values_to_skip;
+        }
+      }
+      levels_read += num_def_levels;
+    }
+    num_levels = levels_read;
+  }
+
+  if (current_decoder_->Skip(static_cast<int>(values_to_skip)) != values_to_skip) {
+    ParquetException::EofException();
+  }
+  ConsumeBufferedValues(num_levels);
+  return num_levels;
+}
+
+template <typename DType>
+int64_t TypedColumnReader<DType>::ReadRows(int64_t num_rows, int16_t* def_levels,
+                                           int16_t* rep_levels, T* values,
+                                           int64_t* values_read) {
+  int64_t total_levels = 0;
+  *values_read = 0;
+  while (total_levels < num_rows) {
+    int64_t batch_values = 0;
+    const int64_t levels_read = ReadBatch(
+        num_rows - total_levels, def_levels ? def_levels + total_levels : nullptr,
+        rep_levels ? rep_levels + total_levels : nullptr, values + *values_read,
+        &batch_values);
+    if (levels_read == 0) break;
+    total_levels += levels_read;
+    *values_read += batch_values;
+  }
+  return total_levels;
+}
+
+template <typename DType>
+int64_t TypedColumnReader<DType>::ReadSelectedRows(int64_t num_rows,
+                                                   const uint8_t* selection,
+                                                   int64_t selection_offset,
+                                                   int16_t* def_levels,
+                                                   int16_t* rep_levels, T* values,
+                                                   int64_t* values_read) {
+  if (descr_->max_repetition_level() > 0) {
+    ParquetException::NYI("Reading selected rows of repeated columns");
+  }
+  int64_t total_levels = 0;
+  *values_read = 0;
+  int64_t row = 0;
+  while (row < num_rows) {
+    // Handle the rows up to the next change of the selection at once
+    const bool selected = BitUtil::GetBit(selection, selection_offset + row);
+    int64_t run_end = row + 1;
+    while (run_end < num_rows &&
+           BitUtil::GetBit(selection, selection_offset + run_end) == selected) {
+      ++run_end;
+    }
+    const int64_t run_length = run_end - row;
+    if (selected) {
+      int64_t run_values = 0;
+      const int64_t levels_read =
+          ReadRows(run_length, def_levels ? def_levels + total_levels : nullptr,
+                   rep_levels ? rep_levels + total_levels : nullptr,
+                   values + *values_read, &run_values);
+      total_levels += levels_read;
+      *values_read += run_values;
+      if (levels_read < run_length) break;
+    } else if (Skip(run_length) < run_length) {
+      break;
+    }
+    row = run_end;
+  }
+  return total_levels;
+}
+
+template <typename DType>
+int64_t TypedColumnReader<DType>::ReadRowRanges(const std::vector<RowRange>& ranges,
+                                                int16_t* def_levels,
+                                                int16_t* rep_levels, T* values,
+                                                int64_t* values_read) {
+  if (descr_->max_repetition_level() > 0) {
+    ParquetException::NYI("Reading selected rows of repeated columns");
+  }
+  int64_t total_levels = 0;
+  *values_read = 0;
+  int64_t row = 0;
+  for (const RowRange& range : ranges) {
+    if (range.begin < row || range.end < range.begin) {
+      throw ParquetException("Row ranges must be sorted and must not overlap");
+    }
+    if (Skip(range.begin - row) < range.begin - row) break;
+    const int64_t num_rows = range.end - range.begin;
+    int64_t range_values = 0;
+    const int64_t levels_read =
+        ReadRows(num_rows, def_levels ? def_levels + total_levels : nullptr,
+                 rep_levels ? rep_levels + total_levels : nullptr,
+                 values + *values_read, &range_values);
+    total_levels += levels_read;
+    *values_read += range_values;
+    if (levels_read < num_rows) break;
+    row = range.end;
+  }
+  return total_levels;
+}
+
 // ----------------------------------------------------------------------
 // Template instantiations
 
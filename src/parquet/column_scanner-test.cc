@@ -83,6 +83,43 @@ class TestFlatScanner : public ::testing::Test {
     ASSERT_FALSE(scanner->Next(&val, &def_level, &rep_level, &is_null));
   }
 
+  // As CheckResults, through NextBatch after the first value
+  void CheckBatches(int batch_size, const ColumnDescriptor* d) {
+    TypedScanner<Type>* scanner = reinterpret_cast<TypedScanner<Type>*>(scanner_.get());
+    T val;
+    bool is_null = false;
+    int16_t def_level;
+    int16_t rep_level;
+    scanner->SetBatchSize(batch_size);
+    ASSERT_TRUE(scanner->Next(&val, &def_level, &rep_level, &is_null));
+    int i = 1;
+    int j = is_null ? 0 : 1;
+    typename TypedScanner<Type>::Batch batch;
+    while (scanner->NextBatch(&batch)) {
+      ASSERT_LE(batch.num_values, batch.num_levels);
+      for (int64_t k = 0; k < batch.num_values; k++) {
+        ASSERT_EQ(values_[j + k], batch.values[k]) << i << "V" << j + k;
+      }
+      for (int64_t k = 0; k < batch.num_levels; k++) {
+        if (d->max_definition_level() > 0) {
+          ASSERT_EQ(def_levels_[i + k], batch.def_levels[k]) << i + k << "D";
+        } else {
+          ASSERT_EQ(nullptr, batch.def_levels);
+        }
+        if (d->max_repetition_level() > 0) {
+          ASSERT_EQ(rep_levels_[i + k], batch.rep_levels[k]) << i + k << "R";
+        } else {
+          ASSERT_EQ(nullptr, batch.rep_levels);
+        }
+      }
+      i += static_cast<int>(batch.num_levels);
+      j += static_cast<int>(batch.num_values);
+    }
+    ASSERT_EQ(num_levels_, i);
+    ASSERT_EQ(num_values_, j);
+    ASSERT_FALSE(scanner->Next(&val, &def_level, &rep_level, &is_null));
+  }
+
   void Clear() {
     pages_.clear();
     values_.clear();
@@ -97,6 +134,8 @@ class TestFlatScanner : public ::testing::Test {
     num_levels_ = num_pages * levels_per_page;
     InitScanner(d);
     CheckResults(batch_size, d);
+    InitScanner(d);
+    CheckBatches(batch_size, d);
     Clear();
   }
 
@@ -193,6 +232,38 @@ TEST_F(TestFLBAFlatScanner, TestSmallBatch) {
   CheckResults(1, &d);
 }
 
+TEST_F(TestFLBAFlatScanner, TestRequiredFlatBatches) {
+  NodePtr type =
+      schema::PrimitiveNode::Make("c1", Repetition::REQUIRED, Type::FIXED_LEN_BYTE_ARRAY,
+                                  LogicalType::NONE, FLBA_LENGTH);
+  const ColumnDescriptor d(type, 0, 0);
+  num_values_ = MakePages<FLBAType>(&d, 3, 100, def_levels_, rep_levels_, values_,
+                                    data_buffer_, pages_);
+  InitScanner(&d);
+  auto scanner = reinterpret_cast<TypedScanner<FLBAType>*>(scanner_.get());
+  scanner->SetBatchSize(batch_size);
+  TypedScanner<FLBAType>::Batch batch;
+  int j = 0;
+  while (scanner->NextBatch<true>(&batch)) {
+    ASSERT_EQ(nullptr, batch.def_levels);
+    ASSERT_EQ(batch.num_values, batch.num_levels);
+    for (int64_t k = 0; k < batch.num_values; k++) {
+      ASSERT_EQ(values_[j++], batch.values[k]);
+    }
+  }
+  ASSERT_EQ(num_values_, j);
+
+  // Optional columns have levels
+  const ColumnDescriptor optional(
+      schema::PrimitiveNode::Make("c2", Repetition::OPTIONAL,
+                                  Type::FIXED_LEN_BYTE_ARRAY, LogicalType::NONE,
+                                  FLBA_LENGTH),
+      1, 0);
+  InitScanner(&optional);
+  scanner = reinterpret_cast<TypedScanner<FLBAType>*>(scanner_.get());
+  ASSERT_THROW(scanner->NextBatch<true>(&batch), ParquetException);
+}
+
 TEST_F(TestFLBAFlatScanner, TestDescriptorAPI) {
   NodePtr type =
       schema::PrimitiveNode::Make("c1", Repetition::OPTIONAL, Type::FIXED_LEN_BYTE_ARRAY,
@@ -102,6 +102,58 @@ class PARQUET_EXPORT TypedScanner : public Scanner {
 
   virtual ~TypedScanner() {}
 
+  // A run of levels and of the values of the non-null ones, valid until the
+  // next call on the scanner. The levels are nullptr if the column has none
+  struct Batch {
+    const int16_t* def_levels;
+    const int16_t* rep_levels;
+    const T* values;
+    int64_t num_levels;
+    int64_t num_values;
+  };
+
+  // Hands out the levels and values that are buffered but not yet consumed,
+  // reading the next batch first if there are none, and consumes them.
+  // Returns false at the end of the column. With kRequiredFlat, for columns
+  // without definition and repetition levels, the level handling is compiled
+  // out, i.e. a batch is num_values values
+  template <bool kRequiredFlat = false>
+  bool NextBatch(Batch* batch) {
+    if (level_offset_ == levels_buffered_) {
+      if (kRequiredFlat && (descr()->max_definition_level() > 0 ||
+                            descr()->max_repetition_level() > 0)) {
+        throw ParquetException("Column " + descr()->path()->ToDotString() +
+                               " is not required and flat");
+      }
+      levels_buffered_ = static_cast<int>(typed_reader_->ReadBatch(
+          static_cast<int>(batch_size_), kRequiredFlat ? nullptr : def_levels_.data(),
+          kRequiredFlat ? nullptr : rep_levels_.data(), values_, &values_buffered_));
+      value_offset_ = 0;
+      level_offset_ = 0;
+      if (!levels_buffered_) {
+        return false;
+      }
+    }
+    batch->values = values_ + value_offset_;
+    batch->num_values = values_buffered_ - value_offset_;
+    if (kRequiredFlat) {
+      batch->def_levels = nullptr;
+      batch->rep_levels = nullptr;
+      batch->num_levels = batch->num_values;
+    } else {
+      batch->def_levels = descr()->max_definition_level() > 0
+                              ? def_levels_.data() + level_offset_
+                              : nullptr;
+      batch->rep_levels = descr()->max_repetition_level() > 0
+                              ? rep_levels_.data() + level_offset_
+                              : nullptr;
+      batch->num_levels = levels_buffered_ - level_offset_;
+    }
+    level_offset_ = levels_buffered_;
+    value_offset_ = static_cast<int>(values_buffered_);
+    return true;
+  }
+
   bool NextLevels(int16_t* def_level, int16_t* rep_level) {
     if (level_offset_ == levels_buffered_) {
       levels_buffered_ = static_cast<int>(
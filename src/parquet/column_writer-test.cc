@@ -15,6 +15,8 @@
 // specific language governing permissions and limitations
 // under the License.
 
+#include <algorithm>
+
 #include <gtest/gtest.h>
 
 #include "parquet/column_reader.h"
@@ -25,6 +27,8 @@
 #include "parquet/types.h"
 #include "parquet/util/comparison.h"
 #include "parquet/util/memory.h"
+#include "parquet/util/thread-pool.h"
+#include "parquet/write_metrics.h"
 
 namespace parquet {
 
@@ -58,24 +62,32 @@ class TestPrimitiveWriter : public PrimitiveTypedTest<TestType> {
 
   Type::type type_num() { return TestType::type_num; }
 
-  void BuildReader(int64_t num_rows,
-                   Compression::type compression = Compression::UNCOMPRESSED) {
+  std::unique_ptr<PageReader> BuildPageReader(
+      int64_t num_rows, Compression::type compression = Compression::UNCOMPRESSED) {
     auto buffer = sink_->GetBuffer();
     std::unique_ptr<InMemoryInputStream> source(new InMemoryInputStream(buffer));
-    std::unique_ptr<PageReader> page_reader =
-        PageReader::Open(std::move(source), num_rows, compression);
-    reader_.reset(new TypedColumnReader<TestType>(this->descr_, std::move(page_reader)));
+    return PageReader::Open(std::move(source), num_rows, compression);
   }
 
+  void BuildReader(int64_t num_rows,
+                   Compression::type compression = Compression::UNCOMPRESSED) {
+    reader_.reset(new TypedColumnReader<TestType>(
+        this->descr_, BuildPageReader(num_rows, compression)));
+  }
+
+  // builder, if not nullptr, has the writer properties besides the encoding
   std::shared_ptr<TypedColumnWriter<TestType>> BuildWriter(
       int64_t output_size = SMALL_SIZE,
-      const ColumnProperties& column_properties = ColumnProperties()) {
+      const ColumnProperties& column_properties = ColumnProperties(),
+      WriterProperties::Builder* builder = nullptr) {
     sink_.reset(new InMemoryOutputStream());
     metadata_ = ColumnChunkMetaDataBuilder::Make(
         writer_properties_, this->descr_, reinterpret_cast<uint8_t*>(&thrift_metadata_));
     std::unique_ptr<PageWriter> pager =
         PageWriter::Open(sink_.get(), column_properties.codec, metadata_.get());
-    WriterProperties::Builder wp_builder;
+    WriterProperties::Builder default_builder;
+    WriterProperties::Builder& wp_builder =
+        builder != nullptr ? *builder : default_builder;
     if (column_properties.encoding == Encoding::PLAIN_DICTIONARY ||
         column_properties.encoding == Encoding::RLE_DICTIONARY) {
       wp_builder.enable_dictionary();
@@ -182,6 +194,9 @@ class TestPrimitiveWriter : public PrimitiveTypedTest<TestType> {
     return metadata_accessor->encodings();
   }
 
+  // Bytes written to the sink so far
+  int64_t sink_size() { return sink_->Tell(); }
+
  protected:
   int64_t values_read_;
   // Keep the reader alive as for ByteArray the lifetime of the ByteArray
@@ -292,22 +307,156 @@ TYPED_TEST(TestPrimitiveWriter, RequiredBitPacked) {
   this->TestRequiredWithEncoding(Encoding::BIT_PACKED);
 }
 
-TYPED_TEST(TestPrimitiveWriter, RequiredDeltaBinaryPacked) {
+TYPED_TEST(TestPrimitiveWriter, RequiredRLEDictionary) {
+  this->TestRequiredWithEncoding(Encoding::RLE_DICTIONARY);
+}
+*/
+
+template <typename TestType>
+class TestDeltaBinaryPackedWriter : public TestPrimitiveWriter<TestType> {};
+
+typedef ::testing::Types<Int32Type, Int64Type> DeltaBinaryPackedTypes;
+
+TYPED_TEST_CASE(TestDeltaBinaryPackedWriter, DeltaBinaryPackedTypes);
+
+TYPED_TEST(TestDeltaBinaryPackedWriter, Required) {
   this->TestRequiredWithEncoding(Encoding::DELTA_BINARY_PACKED);
 }
 
-TYPED_TEST(TestPrimitiveWriter, RequiredDeltaLengthByteArray) {
-  this->TestRequiredWithEncoding(Encoding::DELTA_LENGTH_BYTE_ARRAY);
+TYPED_TEST(TestDeltaBinaryPackedWriter, RequiredWithSnappyCompression) {
+  this->TestRequiredWithSettings(Encoding::DELTA_BINARY_PACKED, Compression::SNAPPY,
+                                 false, false, LARGE_SIZE);
 }
 
-TYPED_TEST(TestPrimitiveWriter, RequiredDeltaByteArray) {
-  this->TestRequiredWithEncoding(Encoding::DELTA_BYTE_ARRAY);
+using TestByteArrayValuesWriter = TestPrimitiveWriter<ByteArrayType>;
+
+TEST_F(TestByteArrayValuesWriter, RequiredDeltaLengthByteArray) {
+  this->TestRequiredWithSettings(Encoding::DELTA_LENGTH_BYTE_ARRAY,
+                                 Compression::UNCOMPRESSED, false, false, LARGE_SIZE);
 }
 
-TYPED_TEST(TestPrimitiveWriter, RequiredRLEDictionary) {
-  this->TestRequiredWithEncoding(Encoding::RLE_DICTIONARY);
+TEST_F(TestByteArrayValuesWriter, RequiredDeltaByteArray) {
+  this->TestRequiredWithSettings(Encoding::DELTA_BYTE_ARRAY, Compression::UNCOMPRESSED,
+                                 false, false, LARGE_SIZE);
+}
+
+TEST_F(TestByteArrayValuesWriter, DictionaryMemoryLimit) {
+  const int num_values = LARGE_SIZE;
+  const int batch_size = 100;
+  const int64_t memory_limit = 16 * 1024;
+  this->GenerateData(num_values);
+
+  auto metrics = std::make_shared<WriteMetrics>();
+  WriterProperties::Builder builder;
+  builder.dictionary_memory_limit(memory_limit)->write_metrics(metrics);
+  auto writer = this->BuildWriter(num_values, Encoding::PLAIN_DICTIONARY, &builder);
+  for (int i = 0; i < num_values; i += batch_size) {
+    writer->WriteBatch(batch_size, nullptr, nullptr, this->values_ptr_ + i);
+  }
+  writer->Close();
+
+  this->SetupValuesOut(num_values);
+  this->ReadColumnFully();
+  ASSERT_EQ(num_values, this->values_read_);
+  ASSERT_EQ(this->values_, this->values_out_);
+  std::vector<Encoding::type> encodings = this->metadata_encodings();
+  ASSERT_EQ(Encoding::PLAIN_DICTIONARY, encodings[0]);
+  ASSERT_EQ(Encoding::PLAIN, encodings[1]);
+
+  std::map<std::string, ColumnWriteMetrics> columns = metrics->Get();
+  const ColumnWriteMetrics& column = columns.begin()->second;
+  ASSERT_EQ(1, column.num_dictionary_fallbacks);
+  ASSERT_GT(column.peak_dictionary_memory_bytes, 0);
+}
+
+TEST_F(TestByteArrayValuesWriter, DictionaryAllocator) {
+  this->GenerateData(SMALL_SIZE);
+  ChunkedAllocator pool;
+  auto writer = this->BuildWriter(SMALL_SIZE, Encoding::PLAIN_DICTIONARY);
+  writer->SetDictionaryAllocator(&pool);
+  writer->WriteBatch(SMALL_SIZE, nullptr, nullptr, this->values_ptr_);
+  ASSERT_GT(pool.total_allocated_bytes(), 0);
+  ASSERT_THROW(writer->SetDictionaryAllocator(&pool), ParquetException);
+  writer->Close();
+  // Cleared for the next column chunk but the chunks are kept
+  ASSERT_EQ(0, pool.total_allocated_bytes());
+  ASSERT_GT(pool.total_reserved_bytes(), 0);
+
+  this->ReadColumn();
+  ASSERT_EQ(SMALL_SIZE, this->values_read_);
+  ASSERT_EQ(this->values_, this->values_out_);
+  pool.FreeAll();
+}
+
+TEST_F(TestByteArrayValuesWriter, OptionalBinary) {
+  this->SetUpSchema(Repetition::OPTIONAL);
+
+  std::vector<int16_t> definition_levels(SMALL_SIZE, 1);
+  std::vector<uint8_t> valid_bits(::arrow::BitUtil::BytesForBits(SMALL_SIZE), 255);
+  definition_levels[1] = 0;
+  ::arrow::BitUtil::ClearBit(valid_bits.data(), 1);
+
+  for (auto encoding : {Encoding::PLAIN, Encoding::PLAIN_DICTIONARY,
+                        Encoding::DELTA_LENGTH_BYTE_ARRAY}) {
+    // The values in Arrow's binary layout, the null one included
+    this->GenerateData(SMALL_SIZE);
+    std::vector<uint8_t> data;
+    std::vector<int32_t> offsets(1, 0);
+    for (const ByteArray& value : this->values_) {
+      data.insert(data.end(), value.ptr, value.ptr + value.len);
+      offsets.push_back(static_cast<int32_t>(data.size()));
+    }
+
+    auto writer = this->BuildWriter(SMALL_SIZE, ColumnProperties(encoding));
+    writer->WriteBatchBinary(SMALL_SIZE, definition_levels.data(), nullptr,
+                             valid_bits.data(), 0, offsets.data(), data.data());
+    writer->Close();
+    ASSERT_EQ(SMALL_SIZE, this->metadata_num_values());
+
+    this->ReadColumn();
+    ASSERT_EQ(SMALL_SIZE - 1, this->values_read_);
+    this->values_.erase(this->values_.begin() + 1);
+    this->values_out_.resize(SMALL_SIZE - 1);
+    ASSERT_EQ(this->values_, this->values_out_);
+  }
+}
+
+TEST_F(TestNullValuesWriter, OptionalDeltaBinaryPacked) {
+  this->SetUpSchema(Repetition::OPTIONAL);
+
+  this->GenerateData(SMALL_SIZE);
+  std::vector<int16_t> definition_levels(SMALL_SIZE, 1);
+  definition_levels[1] = 0;
+
+  ColumnProperties column_properties(Encoding::DELTA_BINARY_PACKED);
+  auto writer = this->BuildWriter(SMALL_SIZE, column_properties);
+  writer->WriteBatch(this->values_.size(), definition_levels.data(), nullptr,
+                     this->values_ptr_);
+  writer->Close();
+
+  this->ReadColumn();
+  ASSERT_EQ(99, this->values_read_);
+  this->values_out_.resize(99);
+  this->values_.resize(99);
+  ASSERT_EQ(this->values_, this->values_out_);
+}
+
+TEST(TestColumnWriter, DeltaBinaryPackedUnsupportedType) {
+  auto node = schema::PrimitiveNode::Make("dbl", Repetition::REQUIRED, Type::DOUBLE);
+  ColumnDescriptor descr(node, 0, 0);
+  InMemoryOutputStream sink;
+  WriterProperties::Builder builder;
+  builder.disable_dictionary()->encoding(Encoding::DELTA_BINARY_PACKED);
+  std::shared_ptr<WriterProperties> properties = builder.build();
+
+  format::ColumnChunk thrift_metadata;
+  auto metadata = ColumnChunkMetaDataBuilder::Make(
+      properties, &descr, reinterpret_cast<uint8_t*>(&thrift_metadata));
+  std::unique_ptr<PageWriter> pager =
+      PageWriter::Open(&sink, Compression::UNCOMPRESSED, metadata.get());
+  ASSERT_THROW(ColumnWriter::Make(metadata.get(), std::move(pager), properties.get()),
+               ParquetException);
 }
-*/
 
 TYPED_TEST(TestPrimitiveWriter, RequiredPlainWithSnappyCompression) {
   this->TestRequiredWithSettings(Encoding::PLAIN, Compression::SNAPPY, false, false,
@@ -418,6 +567,82 @@ TYPED_TEST(TestPrimitiveWriter, OptionalSpaced) {
   ASSERT_EQ(this->values_, this->values_out_);
 }
 
+TYPED_TEST(TestPrimitiveWriter, OptionalSpacedWithoutLevels) {
+  // The definition levels are taken from the validity bitmap
+  this->SetUpSchema(Repetition::OPTIONAL);
+
+  this->GenerateData(SMALL_SIZE);
+  std::vector<uint8_t> valid_bits(::arrow::BitUtil::BytesForBits(SMALL_SIZE), 255);
+  ::arrow::BitUtil::ClearBit(valid_bits.data(), 1);
+  ::arrow::BitUtil::ClearBit(valid_bits.data(), SMALL_SIZE - 1);
+
+  auto writer = this->BuildWriter();
+  writer->WriteBatchSpaced(this->values_.size(), nullptr, nullptr, valid_bits.data(), 0,
+                           this->values_ptr_);
+  writer->Close();
+
+  ASSERT_EQ(100, this->metadata_num_values());
+
+  this->ReadColumn();
+  ASSERT_EQ(98, this->values_read_);
+  for (int i = 0; i < SMALL_SIZE; i++) {
+    ASSERT_EQ((i == 1 || i == SMALL_SIZE - 1) ? 0 : 1, this->definition_levels_out_[i]);
+  }
+  this->values_out_.resize(98);
+  this->values_.resize(99);
+  this->values_.erase(this->values_.begin() + 1);
+  ASSERT_EQ(this->values_, this->values_out_);
+}
+
+TYPED_TEST(TestPrimitiveWriter, RepeatedWithoutLevels) {
+  this->SetUpSchema(Repetition::REPEATED);
+  this->GenerateData(SMALL_SIZE);
+
+  auto writer = this->BuildWriter();
+  ASSERT_THROW(writer->WriteBatch(this->values_.size(), nullptr, nullptr,
+                                  this->values_ptr_),
+               ParquetException);
+}
+
+TYPED_TEST(TestPrimitiveWriter, OptionalDictionaryIndices) {
+  this->SetUpSchema(Repetition::OPTIONAL);
+
+  const int dictionary_length = 10;
+  std::vector<int16_t> definition_levels(SMALL_SIZE, 1);
+  std::vector<uint8_t> valid_bits(::arrow::BitUtil::BytesForBits(SMALL_SIZE), 255);
+  std::vector<int32_t> indices(SMALL_SIZE);
+  for (int i = 0; i < SMALL_SIZE; i++) {
+    indices[i] = (i * 7) % dictionary_length;
+  }
+  definition_levels[1] = 0;
+  ::arrow::BitUtil::ClearBit(valid_bits.data(), 1);
+  // Indices of nulls are ignored
+  indices[1] = -1;
+
+  for (auto encoding : {Encoding::PLAIN, Encoding::PLAIN_DICTIONARY}) {
+    // The first values serve as the dictionary
+    this->GenerateData(SMALL_SIZE);
+    auto writer = this->BuildWriter(SMALL_SIZE, ColumnProperties(encoding));
+    writer->WriteBatchDictionary(SMALL_SIZE, definition_levels.data(), nullptr,
+                                 valid_bits.data(), 0, indices.data(), this->values_ptr_,
+                                 dictionary_length);
+    writer->Close();
+    ASSERT_EQ(SMALL_SIZE, this->metadata_num_values());
+
+    auto dictionary = this->values_;
+    this->values_.clear();
+    for (int i = 0; i < SMALL_SIZE; i++) {
+      if (i != 1) {
+        this->values_.push_back(dictionary[indices[i]]);
+      }
+    }
+    this->ReadColumn();
+    ASSERT_EQ(SMALL_SIZE - 1, this->values_read_);
+    this->values_out_.resize(SMALL_SIZE - 1);
+    ASSERT_EQ(this->values_, this->values_out_);
+  }
+}
+
 TYPED_TEST(TestPrimitiveWriter, Repeated) {
   // Optional and repeated, so definition and repetition levels
   this->SetUpSchema(Repetition::REPEATED);
@@ -439,6 +664,86 @@ TYPED_TEST(TestPrimitiveWriter, Repeated) {
   ASSERT_EQ(this->values_, this->values_out_);
 }
 
+// The levels of V2 pages are not compressed, their header counts the nulls
+// and rows
+TYPED_TEST(TestPrimitiveWriter, RepeatedDataPageV2) {
+  this->SetUpSchema(Repetition::REPEATED);
+
+  this->GenerateData(SMALL_SIZE);
+  std::vector<int16_t> definition_levels(SMALL_SIZE, 1);
+  std::vector<int16_t> repetition_levels(SMALL_SIZE, 1);
+  int64_t num_nulls = 0;
+  int64_t num_rows = 0;
+  for (int i = 0; i < SMALL_SIZE; i++) {
+    if (i % 10 == 1) {
+      definition_levels[i] = 0;
+      num_nulls++;
+    }
+    if (i % 3 == 0) {
+      repetition_levels[i] = 0;
+      num_rows++;
+    }
+  }
+
+  WriterProperties::Builder builder;
+  builder.data_page_version(ParquetDataPageVersion::V2)
+      ->write_batch_size(10)
+      ->data_pagesize(16);
+  auto writer = this->BuildWriter(
+      SMALL_SIZE, ColumnProperties(Encoding::PLAIN, Compression::SNAPPY), &builder);
+  writer->WriteBatch(this->values_.size(), definition_levels.data(),
+                     repetition_levels.data(), this->values_ptr_);
+  writer->Close();
+
+  std::unique_ptr<PageReader> pager =
+      this->BuildPageReader(SMALL_SIZE, Compression::SNAPPY);
+  int num_pages = 0;
+  int64_t pages_num_nulls = 0;
+  int64_t pages_num_rows = 0;
+  int64_t page_start = 0;
+  while (std::shared_ptr<Page> page = pager->NextPage()) {
+    ASSERT_EQ(PageType::DATA_PAGE_V2, page->type());
+    const DataPageV2* data_page = static_cast<const DataPageV2*>(page.get());
+    pages_num_nulls += data_page->num_nulls();
+    pages_num_rows += data_page->num_rows();
+    // Every page starts at a record, the batches of 10 levels do not
+    ASSERT_EQ(0, repetition_levels[page_start]);
+    const int64_t page_end = page_start + data_page->num_values();
+    ASSERT_EQ(std::count(repetition_levels.begin() + page_start,
+                         repetition_levels.begin() + page_end, 0),
+              data_page->num_rows());
+    page_start = page_end;
+    num_pages++;
+  }
+  ASSERT_GT(num_pages, 1);
+  ASSERT_EQ(num_nulls, pages_num_nulls);
+  ASSERT_EQ(num_rows, pages_num_rows);
+  ASSERT_EQ(SMALL_SIZE, page_start);
+
+  // ReadBatch stops at the end of a page
+  this->BuildReader(SMALL_SIZE, Compression::SNAPPY);
+  int64_t levels_read = 0;
+  this->values_read_ = 0;
+  while (levels_read < SMALL_SIZE) {
+    int64_t values_read_recently = 0;
+    int64_t levels_read_recently = this->reader_->ReadBatch(
+        static_cast<int>(SMALL_SIZE - levels_read),
+        this->definition_levels_out_.data() + levels_read,
+        this->repetition_levels_out_.data() + levels_read,
+        this->values_out_ptr_ + this->values_read_, &values_read_recently);
+    ASSERT_GT(levels_read_recently, 0);
+    levels_read += levels_read_recently;
+    this->values_read_ += values_read_recently;
+  }
+  this->SyncValuesOut();
+  ASSERT_EQ(SMALL_SIZE - num_nulls, this->values_read_);
+  ASSERT_EQ(definition_levels, this->definition_levels_out_);
+  ASSERT_EQ(repetition_levels, this->repetition_levels_out_);
+  this->values_out_.resize(SMALL_SIZE - num_nulls);
+  this->values_.resize(SMALL_SIZE - num_nulls);
+  ASSERT_EQ(this->values_, this->values_out_);
+}
+
 TYPED_TEST(TestPrimitiveWriter, RequiredLargeChunk) {
   this->GenerateData(LARGE_SIZE);
 
@@ -482,6 +787,274 @@ TYPED_TEST(TestPrimitiveWriter, RequiredVeryLargeChunk) {
   }
 }
 
+// Pages compressed on a thread pool are written in order
+TYPED_TEST(TestPrimitiveWriter, RequiredParallelPageCompression) {
+  this->GenerateData(VERY_LARGE_SIZE);
+
+  WriterProperties::Builder builder;
+  builder.data_pagesize(4096)
+      ->page_compression_parallelism(4)
+      ->compression_thread_pool(std::make_shared<ThreadPool>(2));
+  auto writer = this->BuildWriter(
+      VERY_LARGE_SIZE, ColumnProperties(Encoding::PLAIN, Compression::SNAPPY), &builder);
+  writer->WriteBatch(this->values_.size(), nullptr, nullptr, this->values_ptr_);
+  writer->Close();
+
+  this->SetupValuesOut(VERY_LARGE_SIZE);
+  this->ReadColumnFully(Compression::SNAPPY);
+  ASSERT_EQ(VERY_LARGE_SIZE, this->values_read_);
+  this->values_.resize(VERY_LARGE_SIZE);
+  ASSERT_EQ(this->values_, this->values_out_);
+}
+
+TYPED_TEST(TestPrimitiveWriter, RequiredParallelPageCompressionDataPageV2) {
+  this->GenerateData(LARGE_SIZE);
+
+  WriterProperties::Builder builder;
+  builder.data_pagesize(4096)
+      ->data_page_version(ParquetDataPageVersion::V2)
+      ->page_compression_parallelism(4)
+      ->compression_thread_pool(std::make_shared<ThreadPool>(2));
+  auto writer = this->BuildWriter(
+      LARGE_SIZE, ColumnProperties(Encoding::PLAIN, Compression::GZIP), &builder);
+  writer->WriteBatch(this->values_.size(), nullptr, nullptr, this->values_ptr_);
+  writer->Close();
+
+  this->SetupValuesOut(LARGE_SIZE);
+  this->ReadColumnFully(Compression::GZIP);
+  ASSERT_EQ(LARGE_SIZE, this->values_read_);
+  this->values_.resize(LARGE_SIZE);
+  ASSERT_EQ(this->values_, this->values_out_);
+}
+
+// The dictionary page is written once the buffered pages reach their limit,
+// later pages with new values fall back to PLAIN
+TYPED_TEST(TestPrimitiveWriter, RequiredVeryLargeChunkBufferedPagesLimit) {
+  this->GenerateData(VERY_LARGE_SIZE);
+
+  WriterProperties::Builder builder;
+  builder.dictionary_buffered_pages_limit(1);
+  auto writer =
+      this->BuildWriter(VERY_LARGE_SIZE, Encoding::PLAIN_DICTIONARY, &builder);
+  writer->WriteBatch(this->values_.size(), nullptr, nullptr, this->values_ptr_);
+  writer->Close();
+
+  this->SetupValuesOut(VERY_LARGE_SIZE);
+  this->ReadColumnFully();
+  ASSERT_EQ(VERY_LARGE_SIZE, this->values_read_);
+  this->values_.resize(VERY_LARGE_SIZE);
+  ASSERT_EQ(this->values_, this->values_out_);
+  if (this->type_num() != Type::BOOLEAN) {
+    std::vector<Encoding::type> encodings = this->metadata_encodings();
+    ASSERT_EQ(Encoding::PLAIN_DICTIONARY, encodings[0]);
+    ASSERT_EQ(Encoding::PLAIN, encodings[1]);
+  }
+}
+
+TEST_F(TestNullValuesWriter, DictionaryPagesStreamAfterLimit) {
+  const int num_values = LARGE_SIZE;
+  this->values_.resize(num_values);
+  for (int i = 0; i < num_values; i++) {
+    this->values_[i] = i % 16;
+  }
+  this->values_ptr_ = this->values_.data();
+
+  WriterProperties::Builder builder;
+  builder.data_pagesize(1024)->dictionary_buffered_pages_limit(4096);
+  auto writer = this->BuildWriter(num_values, Encoding::PLAIN_DICTIONARY, &builder);
+  writer->WriteBatch(num_values / 2, nullptr, nullptr, this->values_ptr_);
+  // The dictionary and the first pages are in the sink before the chunk is closed
+  ASSERT_GT(this->sink_size(), 4096);
+  writer->WriteBatch(num_values - num_values / 2, nullptr, nullptr,
+                     this->values_ptr_ + num_values / 2);
+  writer->Close();
+
+  this->SetupValuesOut(num_values);
+  this->ReadColumnFully();
+  ASSERT_EQ(num_values, this->values_read_);
+  ASSERT_EQ(this->values_, this->values_out_);
+  // No value was missing from the dictionary page
+  std::vector<Encoding::type> encodings = this->metadata_encodings();
+  ASSERT_EQ(2, encodings.size());
+  ASSERT_EQ(Encoding::PLAIN_DICTIONARY, encodings[0]);
+  ASSERT_EQ(Encoding::RLE, encodings[1]);
+}
+
+TEST_F(TestNullValuesWriter, OptionalSpacedStatisticsAcrossBlocks) {
+  // The values are encoded and added to the statistics in blocks, the nulls
+  // must not show up in the min and max of any of them
+  this->SetUpSchema(Repetition::OPTIONAL);
+  const int num_values = 5000;
+  this->values_.resize(num_values);
+  std::vector<uint8_t> valid_bits(::arrow::BitUtil::BytesForBits(num_values), 255);
+  int64_t null_count = 0;
+  for (int i = 0; i < num_values; i++) {
+    this->values_[i] = i - num_values / 2;
+    if (i % 3 == 0) {
+      this->values_[i] = (i % 2 == 0) ? -1000000 : 1000000;
+      ::arrow::BitUtil::ClearBit(valid_bits.data(), i);
+      ++null_count;
+    }
+  }
+
+  for (auto encoding : {Encoding::PLAIN, Encoding::PLAIN_DICTIONARY}) {
+    WriterProperties::Builder builder;
+    auto writer = this->BuildWriter(num_values, encoding, &builder);
+    writer->WriteBatchSpaced(num_values, nullptr, nullptr, valid_bits.data(), 0,
+                             this->values_.data());
+    writer->Close();
+
+    auto metadata = ColumnChunkMetaData::Make(
+        reinterpret_cast<const uint8_t*>(&this->thrift_metadata_), this->descr_);
+    ASSERT_TRUE(metadata->is_stats_set());
+    auto stats = std::static_pointer_cast<TypedRowGroupStatistics<Int32Type>>(
+        metadata->statistics());
+    ASSERT_EQ(null_count, stats->null_count());
+    ASSERT_EQ(1 - num_values / 2, stats->min());
+    ASSERT_EQ(num_values - 1 - num_values / 2, stats->max());
+
+    this->SetupValuesOut(num_values);
+    this->ReadColumnFully();
+    ASSERT_EQ(num_values - null_count, this->values_read_);
+  }
+}
+
+TEST_F(TestNullValuesWriter, DictionaryPagesStreamAtMemoryLimit) {
+  const int num_values = LARGE_SIZE;
+  this->values_.resize(num_values);
+  for (int i = 0; i < num_values; i++) {
+    this->values_[i] = i % 16;
+  }
+  this->values_ptr_ = this->values_.data();
+
+  // Without a limit, all pages are held until the chunk is closed
+  WriterProperties::Builder unlimited_builder;
+  unlimited_builder.data_pagesize(1024);
+  auto writer =
+      this->BuildWriter(num_values, Encoding::PLAIN_DICTIONARY, &unlimited_builder);
+  writer->WriteBatch(num_values, nullptr, nullptr, this->values_ptr_);
+  const int64_t unlimited_usage = writer->memory_usage();
+  ASSERT_EQ(0, this->sink_size());
+  writer->Close();
+  ASSERT_EQ(0, writer->memory_usage());
+
+  WriterProperties::Builder builder;
+  builder.data_pagesize(1024)->memory_limit(unlimited_usage / 2);
+  writer = this->BuildWriter(num_values, Encoding::PLAIN_DICTIONARY, &builder);
+  writer->WriteBatch(num_values, nullptr, nullptr, this->values_ptr_);
+  ASSERT_GT(this->sink_size(), 0);
+  ASSERT_LT(writer->memory_usage(), unlimited_usage);
+  writer->Close();
+
+  this->SetupValuesOut(num_values);
+  this->ReadColumnFully();
+  ASSERT_EQ(num_values, this->values_read_);
+  ASSERT_EQ(this->values_, this->values_out_);
+  std::vector<Encoding::type> encodings = this->metadata_encodings();
+  ASSERT_EQ(2, encodings.size());
+  ASSERT_EQ(Encoding::PLAIN_DICTIONARY, encodings[0]);
+}
+
+TEST_F(TestNullValuesWriter, DictionaryMinCompressionRatio) {
+  // Distinct values take more space dictionary encoded than PLAIN
+  const int num_values = LARGE_SIZE;
+  this->values_.resize(num_values);
+  for (int i = 0; i < num_values; i++) {
+    this->values_[i] = i * 7;
+  }
+  this->values_ptr_ = this->values_.data();
+
+  WriterProperties::Builder builder;
+  builder.data_pagesize(1024)->dictionary_min_compression_ratio(1.0);
+  auto writer = this->BuildWriter(num_values, Encoding::PLAIN_DICTIONARY, &builder);
+  writer->WriteBatch(num_values / 2, nullptr, nullptr, this->values_ptr_);
+  // Fell back after the first page, the pages are no longer buffered
+  ASSERT_GT(this->sink_size(), num_values);
+  writer->WriteBatch(num_values - num_values / 2, nullptr, nullptr,
+                     this->values_ptr_ + num_values / 2);
+  writer->Close();
+
+  this->SetupValuesOut(num_values);
+  this->ReadColumnFully();
+  ASSERT_EQ(num_values, this->values_read_);
+  ASSERT_EQ(this->values_, this->values_out_);
+  std::vector<Encoding::type> encodings = this->metadata_encodings();
+  ASSERT_EQ(Encoding::PLAIN_DICTIONARY, encodings[0]);
+  ASSERT_EQ(Encoding::PLAIN, encodings[1]);
+}
+
+TEST_F(TestNullValuesWriter, WriteMetrics) {
+  const int num_values = LARGE_SIZE;
+  this->values_.resize(num_values);
+  for (int i = 0; i < num_values; i++) {
+    this->values_[i] = i * 7;
+  }
+  this->values_ptr_ = this->values_.data();
+
+  auto metrics = std::make_shared<WriteMetrics>();
+  WriterProperties::Builder builder;
+  builder.data_pagesize(1024)->dictionary_min_compression_ratio(1.0)->write_metrics(
+      metrics);
+  auto writer = this->BuildWriter(num_values, Encoding::PLAIN_DICTIONARY, &builder);
+  writer->WriteBatch(num_values, nullptr, nullptr, this->values_ptr_);
+  writer->Close();
+
+  std::map<std::string, ColumnWriteMetrics> columns = metrics->Get();
+  ASSERT_EQ(1U, columns.size());
+  const ColumnWriteMetrics& column = columns.begin()->second;
+  ASSERT_EQ(num_values, column.values_written);
+  ASSERT_EQ(1, column.num_dictionary_pages);
+  ASSERT_GT(column.num_data_pages, 1);
+  // Uncompressed
+  ASSERT_GT(column.uncompressed_bytes, num_values);
+  ASSERT_EQ(column.uncompressed_bytes, column.compressed_bytes);
+  ASSERT_EQ(1, column.num_dictionary_fallbacks);
+  ASSERT_GT(column.fallback_dictionary_bytes, 0);
+  ASSERT_EQ(0, column.compress_nanos);
+}
+
+TEST_F(TestNullValuesWriter, AutoEncoding) {
+  const int num_values = LARGE_SIZE;
+  const int batch_size = 100;
+  this->values_.resize(num_values);
+  this->values_ptr_ = this->values_.data();
+
+  // Sorted distinct values are delta encoded, few distinct values that are far
+  // apart dictionary encoded
+  for (bool few_distinct : {false, true}) {
+    for (int i = 0; i < num_values; i++) {
+      this->values_[i] = few_distinct ? (i * 7) % 10 * 1000003 : i;
+    }
+    for (int64_t sample_size : {1000, 2 * num_values}) {
+      // The larger sample is decided on at the end of the first page
+      auto metrics = std::make_shared<WriteMetrics>();
+      WriterProperties::Builder builder;
+      builder.enable_auto_encoding(sample_size)->write_metrics(metrics);
+      auto writer = this->BuildWriter(num_values, Encoding::PLAIN, &builder);
+      for (int i = 0; i < num_values; i += batch_size) {
+        writer->WriteBatch(batch_size, nullptr, nullptr, this->values_ptr_ + i);
+      }
+      writer->Close();
+
+      this->SetupValuesOut(num_values);
+      this->ReadColumnFully();
+      ASSERT_EQ(num_values, this->values_read_);
+      ASSERT_EQ(this->values_, this->values_out_);
+      std::vector<Encoding::type> encodings = this->metadata_encodings();
+      ASSERT_EQ(few_distinct ? Encoding::PLAIN_DICTIONARY : Encoding::DELTA_BINARY_PACKED,
+                encodings[0]);
+
+      std::map<std::string, ColumnWriteMetrics> columns = metrics->Get();
+      const ColumnWriteMetrics& column = columns.begin()->second;
+      ASSERT_EQ(few_distinct ? 0 : 1, column.num_auto_delta);
+      ASSERT_EQ(few_distinct ? 1 : 0, column.num_auto_dictionary);
+      ASSERT_EQ(0, column.num_auto_plain);
+      ASSERT_EQ(0, column.num_dictionary_fallbacks);
+      ASSERT_EQ(few_distinct ? 1 : 0, column.num_dictionary_pages);
+    }
+  }
+}
+
 // PARQUET-719
 // Test case for NULL values
 TEST_F(TestNullValuesWriter, OptionalNullValueChunk) {
@@ -503,6 +1076,41 @@ TEST_F(TestNullValuesWriter, OptionalNullValueChunk) {
   ASSERT_EQ(0, this->values_read_);
 }
 
+using TestFloatValuesWriter = TestPrimitiveWriter<FloatType>;
+using TestDoubleValuesWriter = TestPrimitiveWriter<DoubleType>;
+
+TEST_F(TestFloatValuesWriter, RequiredByteStreamSplit) {
+  this->TestRequiredWithSettings(Encoding::BYTE_STREAM_SPLIT, Compression::ZSTD, false,
+                                 true, LARGE_SIZE);
+  ASSERT_EQ(Encoding::BYTE_STREAM_SPLIT, this->metadata_encodings()[0]);
+}
+
+TEST_F(TestDoubleValuesWriter, RequiredByteStreamSplit) {
+  this->TestRequiredWithSettings(Encoding::BYTE_STREAM_SPLIT, Compression::ZSTD, false,
+                                 true, LARGE_SIZE);
+  ASSERT_EQ(Encoding::BYTE_STREAM_SPLIT, this->metadata_encodings()[0]);
+}
+
+TEST_F(TestDoubleValuesWriter, OptionalByteStreamSplit) {
+  this->SetUpSchema(Repetition::OPTIONAL);
+
+  this->GenerateData(SMALL_SIZE);
+  std::vector<int16_t> definition_levels(SMALL_SIZE, 1);
+  definition_levels[1] = 0;
+
+  auto writer =
+      this->BuildWriter(SMALL_SIZE, ColumnProperties(Encoding::BYTE_STREAM_SPLIT));
+  writer->WriteBatch(this->values_.size(), definition_levels.data(), nullptr,
+                     this->values_ptr_);
+  writer->Close();
+
+  this->ReadColumn();
+  ASSERT_EQ(SMALL_SIZE - 1, this->values_read_);
+  this->values_out_.resize(SMALL_SIZE - 1);
+  this->values_.resize(SMALL_SIZE - 1);
+  ASSERT_EQ(this->values_, this->values_out_);
+}
+
 // PARQUET-764
 // Correct bitpacking for boolean write at non-byte boundaries
 using TestBooleanValuesWriter = TestPrimitiveWriter<BooleanType>;
@@ -520,6 +1128,35 @@ TEST_F(TestBooleanValuesWriter, AlternateBooleanValues) {
   }
 }
 
+TEST_F(TestBooleanValuesWriter, OptionalBitmap) {
+  this->SetUpSchema(Repetition::OPTIONAL);
+  this->GenerateData(SMALL_SIZE);
+
+  std::vector<int16_t> definition_levels(SMALL_SIZE, 1);
+  std::vector<uint8_t> valid_bits(::arrow::BitUtil::BytesForBits(SMALL_SIZE + 3), 255);
+  definition_levels[1] = 0;
+  ::arrow::BitUtil::ClearBit(valid_bits.data(), 3 + 1);
+
+  // The values as a bitmap from a bit offset on, the null one included
+  const int64_t values_offset = 5;
+  std::vector<uint8_t> values(::arrow::BitUtil::BytesForBits(SMALL_SIZE + 5), 0);
+  for (int i = 0; i < SMALL_SIZE; i++) {
+    ::arrow::BitUtil::SetBitTo(values.data(), values_offset + i, this->values_[i]);
+  }
+
+  auto writer = this->BuildWriter(SMALL_SIZE);
+  writer->WriteBatchBitmap(SMALL_SIZE, definition_levels.data(), nullptr,
+                           valid_bits.data(), 3, values.data(), values_offset);
+  writer->Close();
+  ASSERT_EQ(SMALL_SIZE, this->metadata_num_values());
+
+  this->ReadColumn();
+  ASSERT_EQ(SMALL_SIZE - 1, this->values_read_);
+  this->values_.erase(this->values_.begin() + 1);
+  this->values_out_.resize(SMALL_SIZE - 1);
+  ASSERT_EQ(this->values_, this->values_out_);
+}
+
 void GenerateLevels(int min_repeat_factor, int max_repeat_factor, int max_level,
                     std::vector<int16_t>& input_levels) {
   // for each repetition count upto max_repeat_factor
@@ -679,6 +1316,56 @@ TEST(TestLevels, TestLevelsDecodeMultipleSetData) {
   }
 }
 
+TEST(TestLevels, TestLevelsBitmap) {
+  // Bit-packed runs, then repeated runs
+  std::vector<int16_t> levels;
+  for (int i = 0; i < 1000; i++) {
+    levels.push_back(i % 7 == 0 ? 0 : 1);
+  }
+  levels.insert(levels.end(), 300, 1);
+  levels.insert(levels.end(), 100, 0);
+  const int num_levels = static_cast<int>(levels.size());
+
+  std::vector<uint8_t> valid_bits(::arrow::BitUtil::BytesForBits(num_levels), 0);
+  for (int i = 0; i < num_levels; i++) {
+    if (levels[i] == 1) {
+      ::arrow::BitUtil::SetBit(valid_bits.data(), i);
+    }
+  }
+
+  // Encoding the bitmap gives the encoding of the levels
+  std::vector<uint8_t> expected;
+  EncodeLevels(Encoding::RLE, 1, num_levels, levels.data(), expected);
+  std::vector<uint8_t> bytes(expected.size());
+  LevelEncoder encoder;
+  encoder.Init(Encoding::RLE, 1, num_levels, bytes.data() + sizeof(int32_t),
+               static_cast<int>(bytes.size() - sizeof(int32_t)));
+  ASSERT_EQ(num_levels, encoder.EncodeBitmap(num_levels, valid_bits.data(), 0));
+  reinterpret_cast<int32_t*>(bytes.data())[0] = encoder.len();
+  ASSERT_EQ(expected, bytes);
+
+  // Decode at a bit offset that is not byte aligned, with batches that end in
+  // the middle of runs
+  const int64_t offset = 3;
+  std::vector<uint8_t> decoded(::arrow::BitUtil::BytesForBits(offset + num_levels), 0);
+  LevelDecoder decoder;
+  decoder.SetData(Encoding::RLE, 1, num_levels, bytes.data());
+  int64_t null_count = 0;
+  int num_decoded = 0;
+  while (num_decoded < num_levels) {
+    const int batch_size = std::min(77, num_levels - num_decoded);
+    ASSERT_EQ(batch_size, decoder.DecodeBitmap(batch_size, decoded.data(),
+                                               offset + num_decoded, &null_count));
+    num_decoded += batch_size;
+  }
+  ASSERT_EQ(0, decoder.DecodeBitmap(1, decoded.data(), offset + num_levels, &null_count));
+
+  ASSERT_EQ(std::count(levels.begin(), levels.end(), 0), null_count);
+  for (int i = 0; i < num_levels; i++) {
+    ASSERT_EQ(levels[i] == 1, ::arrow::BitUtil::GetBit(decoded.data(), offset + i)) << i;
+  }
+}
+
 TEST(TestLevelEncoder, MinimumBufferSize) {
   // PARQUET-676, PARQUET-698
   const int kNumToEncode = 1024;
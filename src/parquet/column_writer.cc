@@ -17,19 +17,33 @@
 
 #include "parquet/column_writer.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <cstdint>
+#include <cstring>
+#include <exception>
+#include <future>
+#include <initializer_list>
+#include <limits>
 #include <memory>
+#include <utility>
+#include <vector>
 
 #include "arrow/util/bit-util.h"
 #include "arrow/util/compression.h"
 #include "arrow/util/rle-encoding.h"
 
 #include "parquet/encoding-internal.h"
+#include "parquet/page_index.h"
 #include "parquet/properties.h"
 #include "parquet/statistics.h"
 #include "parquet/thrift.h"
+#include "parquet/util/codec-pool.h"
 #include "parquet/util/logging.h"
 #include "parquet/util/memory.h"
+#include "parquet/util/thread-pool.h"
+#include "parquet/write_metrics.h"
 
 namespace parquet {
 
@@ -108,6 +122,41 @@ int LevelEncoder::Encode(int batch_size, const int16_t* levels) {
   return num_encoded;
 }
 
+int LevelEncoder::EncodeBitmap(int batch_size, const uint8_t* valid_bits,
+                               int64_t valid_bits_offset) {
+  int num_encoded = 0;
+  if (!rle_encoder_ && !bit_packed_encoder_) {
+    throw ParquetException("Level encoders are not initialized.");
+  }
+  if (bit_width_ != 1) {
+    throw ParquetException("Only levels of bit width 1 can be encoded from a bitmap");
+  }
+
+  ::arrow::internal::BitmapReader valid_bits_reader(valid_bits, valid_bits_offset,
+                                                    batch_size);
+  if (encoding_ == Encoding::RLE) {
+    for (int i = 0; i < batch_size; ++i) {
+      if (!rle_encoder_->Put(valid_bits_reader.IsSet() ? 1 : 0)) {
+        break;
+      }
+      valid_bits_reader.Next();
+      ++num_encoded;
+    }
+    rle_encoder_->Flush();
+    rle_length_ = rle_encoder_->len();
+  } else {
+    for (int i = 0; i < batch_size; ++i) {
+      if (!bit_packed_encoder_->PutValue(valid_bits_reader.IsSet() ? 1 : 0, 1)) {
+        break;
+      }
+      valid_bits_reader.Next();
+      ++num_encoded;
+    }
+    bit_packed_encoder_->Flush();
+  }
+  return num_encoded;
+}
+
 // ----------------------------------------------------------------------
 // PageWriter implementation
 
@@ -134,11 +183,14 @@ class SerializedPageWriter : public PageWriter {
         metadata_(metadata),
         pool_(pool),
         num_values_(0),
-        dictionary_page_offset_(0),
-        data_page_offset_(0),
+        dictionary_page_offset_(-1),
+        data_page_offset_(-1),
         total_uncompressed_size_(0),
-        total_compressed_size_(0) {
-    compressor_ = GetCodecFromArrow(codec);
+        total_compressed_size_(0),
+        codec_(codec) {
+    // Borrowing once checks the codec, the codec is then idle in the pool for
+    // the first Compress call
+    has_compressor_ = CodecPool::GetDefault()->Borrow(codec) != nullptr;
   }
 
   int64_t WriteDictionaryPage(const DictionaryPage& page) override {
@@ -166,7 +218,7 @@ class SerializedPageWriter : public PageWriter {
     // TODO(PARQUET-594) crc checksum
 
     int64_t start_pos = sink_->Tell();
-    if (dictionary_page_offset_ == 0) {
+    if (dictionary_page_offset_ < 0) {
       dictionary_page_offset_ = start_pos;
     }
     int64_t header_size =
@@ -175,63 +227,91 @@ class SerializedPageWriter : public PageWriter {
 
     total_uncompressed_size_ += uncompressed_size + header_size;
     total_compressed_size_ += compressed_data->size() + header_size;
+    if (write_counters_ != nullptr) {
+      CountPage(&write_counters_->num_dictionary_pages, uncompressed_size,
+                compressed_data->size());
+    }
 
     return sink_->Tell() - start_pos;
   }
 
   void Close(bool has_dictionary, bool fallback) override {
-    // index_page_offset = 0 since they are not supported
-    metadata_->Finish(num_values_, dictionary_page_offset_, 0, data_page_offset_,
-                      total_compressed_size_, total_uncompressed_size_, has_dictionary,
-                      fallback);
+    FinishMetadata(has_dictionary, fallback, 0);
 
     // Write metadata at end of column chunk
     metadata_->WriteTo(sink_);
+    metadata_->WriteBloomFilter(sink_);
+  }
+
+  // Commit the column chunk metadata. The page offsets are shifted by
+  // position_offset, which is non-zero if the pages were written to a
+  // temporary sink that is later appended to the file at that position.
+  void FinishMetadata(bool has_dictionary, bool fallback, int64_t position_offset) {
+    int64_t dictionary_page_offset =
+        dictionary_page_offset_ < 0 ? 0 : dictionary_page_offset_ + position_offset;
+    int64_t data_page_offset =
+        data_page_offset_ < 0 ? 0 : data_page_offset_ + position_offset;
+
+    metadata_->page_index()->Finish(position_offset);
+
+    // index_page_offset = 0 since they are not supported
+    metadata_->Finish(num_values_, dictionary_page_offset, 0, data_page_offset,
+                      total_compressed_size_, total_uncompressed_size_, has_dictionary,
+                      fallback);
   }
 
   /**
    * Compress a buffer.
    */
   void Compress(const Buffer& src_buffer, ResizableBuffer* dest_buffer) override {
-    DCHECK(compressor_ != nullptr);
-
-    // Compress the data
-    int64_t max_compressed_size =
-        compressor_->MaxCompressedLen(src_buffer.size(), src_buffer.data());
-
-    // Use Arrow::Buffer::shrink_to_fit = false
-    // underlying buffer only keeps growing. Resize to a smaller size does not reallocate.
-    PARQUET_THROW_NOT_OK(dest_buffer->Resize(max_compressed_size, false));
+    DCHECK(has_compressor_);
 
-    int64_t compressed_size;
-    PARQUET_THROW_NOT_OK(
-        compressor_->Compress(src_buffer.size(), src_buffer.data(), max_compressed_size,
-                              dest_buffer->mutable_data(), &compressed_size));
-    PARQUET_THROW_NOT_OK(dest_buffer->Resize(compressed_size, false));
+    // Not all codecs can compress several buffers at the same time, every
+    // call borrows a compressor that no other call is using
+    PooledCodec compressor = CodecPool::GetDefault()->Borrow(codec_);
+    ScopedWriteTimer timer(write_counters_.get(), &ColumnWriteCounters::compress_nanos);
+    PARQUET_THROW_NOT_OK(CompressWith(compressor.get(), src_buffer, dest_buffer));
   }
 
   int64_t WriteDataPage(const CompressedDataPage& page) override {
     int64_t uncompressed_size = page.uncompressed_size();
     std::shared_ptr<Buffer> compressed_data = page.buffer();
 
-    format::DataPageHeader data_page_header;
-    data_page_header.__set_num_values(page.num_values());
-    data_page_header.__set_encoding(ToThrift(page.encoding()));
-    data_page_header.__set_definition_level_encoding(
-        ToThrift(page.definition_level_encoding()));
-    data_page_header.__set_repetition_level_encoding(
-        ToThrift(page.repetition_level_encoding()));
-    data_page_header.__set_statistics(ToThrift(page.statistics()));
-
     format::PageHeader page_header;
-    page_header.__set_type(format::PageType::DATA_PAGE);
     page_header.__set_uncompressed_page_size(static_cast<int32_t>(uncompressed_size));
     page_header.__set_compressed_page_size(static_cast<int32_t>(compressed_data->size()));
-    page_header.__set_data_page_header(data_page_header);
+    if (page.is_v2()) {
+      format::DataPageHeaderV2 data_page_header;
+      data_page_header.__set_num_values(page.num_values());
+      data_page_header.__set_num_nulls(page.num_nulls());
+      data_page_header.__set_num_rows(page.num_rows());
+      data_page_header.__set_encoding(ToThrift(page.encoding()));
+      data_page_header.__set_definition_levels_byte_length(
+          page.definition_levels_byte_length());
+      data_page_header.__set_repetition_levels_byte_length(
+          page.repetition_levels_byte_length());
+      data_page_header.__set_is_compressed(page.is_compressed());
+      data_page_header.__set_statistics(ToThrift(page.statistics()));
+
+      page_header.__set_type(format::PageType::DATA_PAGE_V2);
+      page_header.__set_data_page_header_v2(data_page_header);
+    } else {
+      format::DataPageHeader data_page_header;
+      data_page_header.__set_num_values(page.num_values());
+      data_page_header.__set_encoding(ToThrift(page.encoding()));
+      data_page_header.__set_definition_level_encoding(
+          ToThrift(page.definition_level_encoding()));
+      data_page_header.__set_repetition_level_encoding(
+          ToThrift(page.repetition_level_encoding()));
+      data_page_header.__set_statistics(ToThrift(page.statistics()));
+
+      page_header.__set_type(format::PageType::DATA_PAGE);
+      page_header.__set_data_page_header(data_page_header);
+    }
     // TODO(PARQUET-594) crc checksum
 
     int64_t start_pos = sink_->Tell();
-    if (data_page_offset_ == 0) {
+    if (data_page_offset_ < 0) {
       data_page_offset_ = start_pos;
     }
 
@@ -242,11 +322,20 @@ class SerializedPageWriter : public PageWriter {
     total_uncompressed_size_ += uncompressed_size + header_size;
     total_compressed_size_ += compressed_data->size() + header_size;
     num_values_ += page.num_values();
+    if (write_counters_ != nullptr) {
+      CountPage(&write_counters_->num_data_pages, uncompressed_size,
+                compressed_data->size());
+      ColumnWriteCounters::Add(&write_counters_->values_written, page.num_values());
+    }
+
+    metadata_->page_index()->AddPage(page.statistics(), page.num_values(),
+                                     page.first_row_index(), start_pos,
+                                     sink_->Tell() - start_pos);
 
     return sink_->Tell() - start_pos;
   }
 
-  bool has_compressor() override { return (compressor_ != nullptr); }
+  bool has_compressor() override { return has_compressor_; }
 
  private:
   OutputStream* sink_;
@@ -259,12 +348,104 @@ class SerializedPageWriter : public PageWriter {
   int64_t total_compressed_size_;
 
   // Compression codec to use.
-  std::unique_ptr<::arrow::Codec> compressor_;
+  Compression::type codec_;
+  bool has_compressor_;
+
+  void CountPage(std::atomic<int64_t>* num_pages, int64_t uncompressed_size,
+                 int64_t compressed_size) {
+    ColumnWriteCounters::Add(num_pages, 1);
+    ColumnWriteCounters::Add(&write_counters_->uncompressed_bytes, uncompressed_size);
+    ColumnWriteCounters::Add(&write_counters_->compressed_bytes, compressed_size);
+  }
+
+  static ::arrow::Status CompressWith(::arrow::Codec* compressor,
+                                      const Buffer& src_buffer,
+                                      ResizableBuffer* dest_buffer) {
+    int64_t max_compressed_size =
+        compressor->MaxCompressedLen(src_buffer.size(), src_buffer.data());
+
+    // Use Arrow::Buffer::shrink_to_fit = false
+    // underlying buffer only keeps growing. Resize to a smaller size does not reallocate.
+    RETURN_NOT_OK(dest_buffer->Resize(max_compressed_size, false));
+
+    int64_t compressed_size;
+    RETURN_NOT_OK(compressor->Compress(src_buffer.size(), src_buffer.data(),
+                                       max_compressed_size, dest_buffer->mutable_data(),
+                                       &compressed_size));
+    return dest_buffer->Resize(compressed_size, false);
+  }
+};
+
+// This implementation of the PageWriter serializes the column chunk into
+// memory and only appends it to the final sink in Flush. Several columns of a
+// row group can thus be written and closed at the same time.
+class BufferedPageWriter : public PageWriter {
+ public:
+  BufferedPageWriter(OutputStream* sink, Compression::type codec,
+                     ColumnChunkMetaDataBuilder* metadata,
+                     ::arrow::MemoryPool* pool = ::arrow::default_memory_pool())
+      : final_sink_(sink),
+        metadata_(metadata),
+        in_memory_sink_(new ChainedOutputStream(pool)),
+        pager_(new SerializedPageWriter(in_memory_sink_.get(), codec, metadata, pool)),
+        has_dictionary_(false),
+        fallback_(false) {}
+
+  int64_t WriteDictionaryPage(const DictionaryPage& page) override {
+    return pager_->WriteDictionaryPage(page);
+  }
+
+  void Close(bool has_dictionary, bool fallback) override {
+    // The page offsets are only known once the chunk is placed in the sink
+    has_dictionary_ = has_dictionary;
+    fallback_ = fallback;
+  }
+
+  void Flush() override {
+    pager_->FinishMetadata(has_dictionary_, fallback_, final_sink_->Tell());
+
+    // Flush the pages to the final sink, followed by the metadata. They are
+    // passed on in the chunks they were buffered in, without concatenating them
+    in_memory_sink_->WriteTo(final_sink_);
+    in_memory_sink_->Clear();
+    metadata_->WriteTo(final_sink_);
+    metadata_->WriteBloomFilter(final_sink_);
+  }
+
+  int64_t WriteDataPage(const CompressedDataPage& page) override {
+    return pager_->WriteDataPage(page);
+  }
+
+  void Compress(const Buffer& src_buffer, ResizableBuffer* dest_buffer) override {
+    pager_->Compress(src_buffer, dest_buffer);
+  }
+
+  void set_write_counters(std::shared_ptr<ColumnWriteCounters> counters) override {
+    pager_->set_write_counters(counters);
+    write_counters_ = std::move(counters);
+  }
+
+  bool has_compressor() override { return pager_->has_compressor(); }
+
+  int64_t memory_usage() override { return in_memory_sink_->Tell(); }
+
+ private:
+  OutputStream* final_sink_;
+  ColumnChunkMetaDataBuilder* metadata_;
+  std::unique_ptr<ChainedOutputStream> in_memory_sink_;
+  std::unique_ptr<SerializedPageWriter> pager_;
+  bool has_dictionary_;
+  bool fallback_;
 };
 
 std::unique_ptr<PageWriter> PageWriter::Open(OutputStream* sink, Compression::type codec,
                                              ColumnChunkMetaDataBuilder* metadata,
-                                             ::arrow::MemoryPool* pool) {
+                                             ::arrow::MemoryPool* pool,
+                                             bool buffered_row_group) {
+  if (buffered_row_group) {
+    return std::unique_ptr<PageWriter>(
+        new BufferedPageWriter(sink, codec, metadata, pool));
+  }
   return std::unique_ptr<PageWriter>(
       new SerializedPageWriter(sink, codec, metadata, pool));
 }
@@ -278,6 +459,83 @@ std::shared_ptr<WriterProperties> default_writer_properties() {
   return default_writer_properties;
 }
 
+// Compresses the values of a DATA_PAGE_V2 in data into dest, behind the
+// levels_size bytes of levels that stay uncompressed. Returns false, with the
+// values copied as they are, if the compression does not make them smaller.
+static bool CompressDataPageV2(PageWriter* pager, const Buffer& data,
+                               int64_t levels_size, ResizableBuffer* dest) {
+  const int64_t values_size = data.size() - levels_size;
+  pager->Compress(Buffer(data.data() + levels_size, values_size), dest);
+  const int64_t compressed_size = dest->size();
+  if (compressed_size < values_size) {
+    PARQUET_THROW_NOT_OK(dest->Resize(levels_size + compressed_size, false));
+    memmove(dest->mutable_data() + levels_size, dest->data(), compressed_size);
+    memcpy(dest->mutable_data(), data.data(), levels_size);
+    return true;
+  }
+  PARQUET_THROW_NOT_OK(dest->Resize(data.size(), false));
+  memcpy(dest->mutable_data(), data.data(), data.size());
+  return false;
+}
+
+// A data page that is compressed on the thread pool. Whoever claims it first,
+// the pool or the writer that waits for it, compresses it, so that a writer
+// running on the pool itself does not wait for tasks queued behind it.
+struct ColumnWriter::PendingPage {
+  PendingPage(PageWriter* pager, const std::shared_ptr<ResizableBuffer>& data,
+              const std::shared_ptr<ResizableBuffer>& compressed_data,
+              CompressedDataPage page)
+      : pager(pager),
+        data(data),
+        compressed_data(compressed_data),
+        page(std::move(page)),
+        claimed(false),
+        done(promise.get_future()) {}
+
+  // Compresses the page unless it is claimed already
+  void Run() {
+    if (claimed.exchange(true)) {
+      return;
+    }
+    try {
+      if (page.is_v2()) {
+        page.set_is_compressed(CompressDataPageV2(
+            pager, *data,
+            page.definition_levels_byte_length() + page.repetition_levels_byte_length(),
+            compressed_data.get()));
+      } else {
+        pager->Compress(*data, compressed_data.get());
+      }
+      data.reset();
+      promise.set_value();
+    } catch (...) {
+      promise.set_exception(std::current_exception());
+    }
+  }
+
+  // Waits for the compression, rethrowing its error
+  void Wait() {
+    Run();
+    done.get();
+  }
+
+  // Skips the compression if it has not started, else waits for it
+  void Cancel() {
+    if (claimed.exchange(true) && done.valid()) {
+      done.wait();
+    }
+  }
+
+  PageWriter* pager;
+  std::shared_ptr<ResizableBuffer> data;
+  std::shared_ptr<ResizableBuffer> compressed_data;
+  // Refers to compressed_data
+  CompressedDataPage page;
+  std::atomic<bool> claimed;
+  std::promise<void> promise;
+  std::future<void> done;
+};
+
 ColumnWriter::ColumnWriter(ColumnChunkMetaDataBuilder* metadata,
                            std::unique_ptr<PageWriter> pager, bool has_dictionary,
                            Encoding::type encoding, const WriterProperties* properties)
@@ -289,14 +547,40 @@ ColumnWriter::ColumnWriter(ColumnChunkMetaDataBuilder* metadata,
       properties_(properties),
       allocator_(properties->memory_pool()),
       pool_(properties->memory_pool()),
+      dictionary_pool_(&pool_),
       num_buffered_values_(0),
       num_buffered_encoded_values_(0),
       rows_written_(0),
+      page_first_row_(0),
+      page_start_rows_written_(0),
+      record_aligned_pages_(properties->data_page_version() ==
+                                ParquetDataPageVersion::V2 &&
+                            descr_->max_repetition_level() > 0),
+      page_cut_pending_(false),
       total_bytes_written_(0),
       closed_(false),
-      fallback_(false) {
+      fallback_(false),
+      dictionary_written_(false),
+      auto_encoding_pending_(has_dictionary &&
+                             properties->column_properties(descr_).auto_encoding_enabled),
+      bloom_filter_enabled_(
+          properties->column_properties(descr_).bloom_filter_enabled &&
+          descr_->physical_type() != Type::BOOLEAN),
+      distinct_count_sketch_(
+          properties->column_properties(descr_).distinct_count_enabled &&
+                  descr_->physical_type() != Type::BOOLEAN
+              ? new HyperLogLog(
+                    properties->column_properties(descr_).distinct_count_precision)
+              : nullptr),
+      num_definition_level_bits_(0),
+      buffered_data_pages_size_(0),
+      pending_pages_size_(0),
+      num_distinct_hashes_(0) {
+  pool_.set_memory_limit(properties->dictionary_memory_limit());
   definition_levels_sink_.reset(new InMemoryOutputStream(allocator_));
   repetition_levels_sink_.reset(new InMemoryOutputStream(allocator_));
+  definition_level_bits_ =
+      std::static_pointer_cast<ResizableBuffer>(AllocateBuffer(allocator_, 0));
   definition_levels_rle_ =
       std::static_pointer_cast<ResizableBuffer>(AllocateBuffer(allocator_, 0));
   repetition_levels_rle_ =
@@ -307,17 +591,96 @@ ColumnWriter::ColumnWriter(ColumnChunkMetaDataBuilder* metadata,
     compressed_data_ =
         std::static_pointer_cast<ResizableBuffer>(AllocateBuffer(allocator_, 0));
   }
+  const std::shared_ptr<WriteMetrics>& metrics = properties->write_metrics();
+  if (metrics != nullptr) {
+    pager_->set_write_counters(metrics->column(descr_->path()->ToDotString()));
+  }
 }
 
 void ColumnWriter::InitSinks() {
   definition_levels_sink_->Clear();
   repetition_levels_sink_->Clear();
+  num_definition_level_bits_ = 0;
 }
 
 void ColumnWriter::WriteDefinitionLevels(int64_t num_levels, const int16_t* levels) {
   DCHECK(!closed_);
-  definition_levels_sink_->Write(reinterpret_cast<const uint8_t*>(levels),
-                                 sizeof(int16_t) * num_levels);
+  if (descr_->max_definition_level() != 1) {
+    definition_levels_sink_->Write(reinterpret_cast<const uint8_t*>(levels),
+                                   sizeof(int16_t) * num_levels);
+    return;
+  }
+  ReserveDefinitionLevelBits(num_levels);
+  ::arrow::internal::BitmapWriter bits_writer(definition_level_bits_->mutable_data(),
+                                              num_definition_level_bits_, num_levels);
+  for (int64_t i = 0; i < num_levels; ++i) {
+    if (levels[i] == 1) {
+      bits_writer.Set();
+    } else {
+      bits_writer.Clear();
+    }
+    bits_writer.Next();
+  }
+  bits_writer.Finish();
+  num_definition_level_bits_ += num_levels;
+}
+
+void ColumnWriter::WriteDefinitionLevelBits(int64_t num_levels, const uint8_t* valid_bits,
+                                            int64_t valid_bits_offset) {
+  DCHECK(!closed_);
+  DCHECK_EQ(1, descr_->max_definition_level());
+  ReserveDefinitionLevelBits(num_levels);
+  uint8_t* bits = definition_level_bits_->mutable_data();
+  if (valid_bits != nullptr && num_definition_level_bits_ % 8 == 0 &&
+      valid_bits_offset % 8 == 0) {
+    // The bits beyond num_levels in the last byte are overwritten by the next call
+    memcpy(bits + num_definition_level_bits_ / 8, valid_bits + valid_bits_offset / 8,
+           static_cast<size_t>(BitUtil::BytesForBits(num_levels)));
+  } else {
+    ::arrow::internal::BitmapWriter bits_writer(bits, num_definition_level_bits_,
+                                                num_levels);
+    if (valid_bits == nullptr) {
+      for (int64_t i = 0; i < num_levels; ++i) {
+        bits_writer.Set();
+        bits_writer.Next();
+      }
+    } else {
+      ::arrow::internal::BitmapReader valid_bits_reader(valid_bits, valid_bits_offset,
+                                                        num_levels);
+      for (int64_t i = 0; i < num_levels; ++i) {
+        if (valid_bits_reader.IsSet()) {
+          bits_writer.Set();
+        } else {
+          bits_writer.Clear();
+        }
+        valid_bits_reader.Next();
+        bits_writer.Next();
+      }
+    }
+    bits_writer.Finish();
+  }
+  num_definition_level_bits_ += num_levels;
+}
+
+void ColumnWriter::ReserveDefinitionLevelBits(int64_t num_levels) {
+  const int64_t old_size = definition_level_bits_->size();
+  const int64_t required =
+      BitUtil::BytesForBits(num_definition_level_bits_ + num_levels);
+  if (required > old_size) {
+    const int64_t new_size = std::max(required, 2 * old_size);
+    PARQUET_THROW_NOT_OK(definition_level_bits_->Resize(new_size, false));
+    // BitmapWriter reads the byte it starts in
+    memset(definition_level_bits_->mutable_data() + old_size, 0,
+           static_cast<size_t>(new_size - old_size));
+  }
+}
+
+void ColumnWriter::CheckOmittedDefinitionLevels() const {
+  if (descr_->max_definition_level() != 1 || descr_->max_repetition_level() > 0) {
+    throw ParquetException(
+        "Definition levels can only be omitted for columns that are not repeated "
+        "and have a maximum definition level of 1");
+  }
 }
 
 void ColumnWriter::WriteRepetitionLevels(int64_t num_levels, const int16_t* levels) {
@@ -326,6 +689,65 @@ void ColumnWriter::WriteRepetitionLevels(int64_t num_levels, const int16_t* leve
                                  sizeof(int16_t) * num_levels);
 }
 
+void ColumnWriter::WriteLevelsSpaced(int64_t num_levels, const int16_t* def_levels,
+                                     const int16_t* rep_levels, const uint8_t* valid_bits,
+                                     int64_t valid_bits_offset, int64_t* values_to_write,
+                                     int64_t* spaced_values_to_write) {
+  AddPendingDataPage(num_levels, rep_levels);
+  *values_to_write = 0;
+  *spaced_values_to_write = 0;
+  // If the field is required and non-repeated, there are no definition levels
+  if (descr_->max_definition_level() > 0 && def_levels == nullptr) {
+    // The levels are the validity bits of the values, which all have a slot
+    CheckOmittedDefinitionLevels();
+    *values_to_write =
+        valid_bits == nullptr
+            ? num_levels
+            : ::arrow::CountSetBits(valid_bits, valid_bits_offset, num_levels);
+    *spaced_values_to_write = num_levels;
+
+    WriteDefinitionLevelBits(num_levels, valid_bits, valid_bits_offset);
+  } else if (descr_->max_definition_level() > 0) {
+    // Minimal definition level for which spaced values are written
+    const int16_t min_spaced_def_level = descr_->repeated_ancestor_def_level();
+    for (int64_t i = 0; i < num_levels; ++i) {
+      if (def_levels[i] == descr_->max_definition_level()) {
+        ++*values_to_write;
+      }
+      if (def_levels[i] >= min_spaced_def_level) {
+        ++*spaced_values_to_write;
+      }
+    }
+
+    WriteDefinitionLevels(num_levels, def_levels);
+  } else {
+    // Required field, write all values
+    *values_to_write = num_levels;
+    *spaced_values_to_write = num_levels;
+  }
+
+  // Not present for non-repeated fields
+  if (descr_->max_repetition_level() > 0) {
+    // The offset index can only locate pages that start at a row boundary
+    if (num_buffered_values_ == 0 && num_levels > 0 && rep_levels[0] != 0) {
+      page_first_row_ = -1;
+    }
+
+    // A row could include more than one value
+    // Count the occasions where we start a new row
+    for (int64_t i = 0; i < num_levels; ++i) {
+      if (rep_levels[i] == 0) {
+        rows_written_++;
+      }
+    }
+
+    WriteRepetitionLevels(num_levels, rep_levels);
+  } else {
+    // Each value is exactly one row
+    rows_written_ += static_cast<int>(num_levels);
+  }
+}
+
 // return the size of the encoded buffer
 int64_t ColumnWriter::RleEncodeLevels(const Buffer& src_buffer,
                                       ResizableBuffer* dest_buffer, int16_t max_level) {
@@ -350,13 +772,45 @@ int64_t ColumnWriter::RleEncodeLevels(const Buffer& src_buffer,
   return encoded_size;
 }
 
+int64_t ColumnWriter::RleEncodeDefinitionLevelBits(ResizableBuffer* dest_buffer) {
+  DCHECK_EQ(num_definition_level_bits_, num_buffered_values_);
+  int64_t rle_size = LevelEncoder::MaxBufferSize(Encoding::RLE, 1,
+                                                 static_cast<int>(num_buffered_values_)) +
+                     sizeof(int32_t);
+  PARQUET_THROW_NOT_OK(dest_buffer->Resize(rle_size, false));
+
+  level_encoder_.Init(Encoding::RLE, 1, static_cast<int>(num_buffered_values_),
+                      dest_buffer->mutable_data() + sizeof(int32_t),
+                      static_cast<int>(dest_buffer->size() - sizeof(int32_t)));
+  int encoded = level_encoder_.EncodeBitmap(static_cast<int>(num_buffered_values_),
+                                            definition_level_bits_->data(), 0);
+  DCHECK_EQ(encoded, num_buffered_values_);
+  reinterpret_cast<int32_t*>(dest_buffer->mutable_data())[0] = level_encoder_.len();
+  return level_encoder_.len() + sizeof(int32_t);
+}
+
 void ColumnWriter::AddDataPage() {
+  // The first page is encoded with the chosen encoding
+  if (auto_encoding_pending_) {
+    ChooseEncoding();
+  }
+
   int64_t definition_levels_rle_size = 0;
   int64_t repetition_levels_rle_size = 0;
 
   std::shared_ptr<Buffer> values = GetValuesBuffer();
 
-  if (descr_->max_definition_level() > 0) {
+  // Only pages that are written right away are compressed in the background,
+  // the pages buffered for the dictionary are all compressed on this thread
+  const bool buffer_page = has_dictionary_ && !fallback_ && !dictionary_written_;
+  const bool compress_async = !buffer_page && pager_->has_compressor() &&
+                              properties_->page_compression_parallelism() > 1;
+  const bool v2 = properties_->data_page_version() == ParquetDataPageVersion::V2;
+
+  if (descr_->max_definition_level() == 1) {
+    definition_levels_rle_size =
+        RleEncodeDefinitionLevelBits(definition_levels_rle_.get());
+  } else if (descr_->max_definition_level() > 0) {
     definition_levels_rle_size =
         RleEncodeLevels(definition_levels_sink_->GetBufferRef(),
                         definition_levels_rle_.get(), descr_->max_definition_level());
@@ -368,152 +822,760 @@ void ColumnWriter::AddDataPage() {
                         repetition_levels_rle_.get(), descr_->max_repetition_level());
   }
 
+  const uint8_t* definition_levels = definition_levels_rle_->data();
+  const uint8_t* repetition_levels = repetition_levels_rle_->data();
+  if (v2) {
+    // The levels of V2 pages are stored without their length prefix
+    if (definition_levels_rle_size > 0) {
+      definition_levels += sizeof(int32_t);
+      definition_levels_rle_size -= sizeof(int32_t);
+    }
+    if (repetition_levels_rle_size > 0) {
+      repetition_levels += sizeof(int32_t);
+      repetition_levels_rle_size -= sizeof(int32_t);
+    }
+  }
+
   int64_t uncompressed_size =
       definition_levels_rle_size + repetition_levels_rle_size + values->size();
 
-  // Use Arrow::Buffer::shrink_to_fit = false
-  // underlying buffer only keeps growing. Resize to a smaller size does not reallocate.
-  PARQUET_THROW_NOT_OK(uncompressed_data_->Resize(uncompressed_size, false));
+  // The values of a page without levels are its data as they are. The
+  // encoders flush them into a buffer of their own, which buffered pages can
+  // keep without a copy
+  std::shared_ptr<Buffer> page_data = values;
+  std::shared_ptr<ResizableBuffer> uncompressed_data;
+  if (compress_async || uncompressed_size != values->size()) {
+    // A page compressed in the background needs a buffer of its own
+    uncompressed_data = uncompressed_data_;
+    if (compress_async) {
+      uncompressed_data = AllocateBuffer(allocator_, uncompressed_size);
+    }
 
-  // Concatenate data into a single buffer
-  uint8_t* uncompressed_ptr = uncompressed_data_->mutable_data();
-  memcpy(uncompressed_ptr, repetition_levels_rle_->data(), repetition_levels_rle_size);
-  uncompressed_ptr += repetition_levels_rle_size;
-  memcpy(uncompressed_ptr, definition_levels_rle_->data(), definition_levels_rle_size);
-  uncompressed_ptr += definition_levels_rle_size;
-  memcpy(uncompressed_ptr, values->data(), values->size());
+    // Use Arrow::Buffer::shrink_to_fit = false
+    // underlying buffer only keeps growing. Resize to a smaller size does not
+    // reallocate.
+    PARQUET_THROW_NOT_OK(uncompressed_data->Resize(uncompressed_size, false));
+
+    // Concatenate data into a single buffer
+    uint8_t* uncompressed_ptr = uncompressed_data->mutable_data();
+    memcpy(uncompressed_ptr, repetition_levels, repetition_levels_rle_size);
+    uncompressed_ptr += repetition_levels_rle_size;
+    memcpy(uncompressed_ptr, definition_levels, definition_levels_rle_size);
+    uncompressed_ptr += definition_levels_rle_size;
+    memcpy(uncompressed_ptr, values->data(), values->size());
+    page_data = uncompressed_data;
+  }
 
   EncodedStatistics page_stats = GetPageStatistics();
   ResetPageStatistics();
 
+  if (compress_async) {
+    // Written in order by WritePendingPages once compressed
+    CompressDataPageAsync(uncompressed_data, page_stats, definition_levels_rle_size,
+                          repetition_levels_rle_size);
+    FinishDataPage();
+    return;
+  }
+
   std::shared_ptr<Buffer> compressed_data;
-  if (pager_->has_compressor()) {
-    pager_->Compress(*(uncompressed_data_.get()), compressed_data_.get());
+  bool is_compressed = pager_->has_compressor();
+  if (is_compressed && v2) {
+    is_compressed =
+        CompressDataPageV2(pager_.get(), *page_data,
+                           definition_levels_rle_size + repetition_levels_rle_size,
+                           compressed_data_.get());
+    compressed_data = compressed_data_;
+  } else if (is_compressed) {
+    pager_->Compress(*page_data, compressed_data_.get());
     compressed_data = compressed_data_;
   } else {
-    compressed_data = uncompressed_data_;
-  }
-
-  // Write the page to OutputStream eagerly if there is no dictionary or
-  // if dictionary encoding has fallen back to PLAIN
-  if (has_dictionary_ && !fallback_) {  // Save pages until end of dictionary encoding
-    std::shared_ptr<Buffer> compressed_data_copy;
-    PARQUET_THROW_NOT_OK(compressed_data->Copy(0, compressed_data->size(), allocator_,
-                                               &compressed_data_copy));
-    CompressedDataPage page(compressed_data_copy,
-                            static_cast<int32_t>(num_buffered_values_), encoding_,
-                            Encoding::RLE, Encoding::RLE, uncompressed_size, page_stats);
+    compressed_data = page_data;
+  }
+
+  // Write the page to OutputStream eagerly if there is no dictionary, if
+  // dictionary encoding has fallen back to PLAIN or if the dictionary page is
+  // written already
+  if (buffer_page) {  // Save pages until end of dictionary encoding
+    // Only the buffers reused by every page need to be copied
+    std::shared_ptr<Buffer> compressed_data_copy = compressed_data;
+    if (compressed_data == uncompressed_data_ || compressed_data == compressed_data_) {
+      PARQUET_THROW_NOT_OK(compressed_data->Copy(0, compressed_data->size(), allocator_,
+                                                 &compressed_data_copy));
+    }
+    CompressedDataPage page =
+        MakeDataPage(compressed_data_copy, uncompressed_size, page_stats,
+                     definition_levels_rle_size, repetition_levels_rle_size);
+    page.set_is_compressed(is_compressed);
     data_pages_.push_back(std::move(page));
+    buffered_data_pages_size_ += compressed_data_copy->size();
   } else {  // Eagerly write pages
-    CompressedDataPage page(compressed_data, static_cast<int32_t>(num_buffered_values_),
-                            encoding_, Encoding::RLE, Encoding::RLE, uncompressed_size,
-                            page_stats);
+    CompressedDataPage page =
+        MakeDataPage(compressed_data, uncompressed_size, page_stats,
+                     definition_levels_rle_size, repetition_levels_rle_size);
+    page.set_is_compressed(is_compressed);
     WriteDataPage(page);
   }
+  FinishDataPage();
+}
+
+CompressedDataPage ColumnWriter::MakeDataPage(const std::shared_ptr<Buffer>& data,
+                                              int64_t uncompressed_size,
+                                              const EncodedStatistics& page_stats,
+                                              int64_t definition_levels_size,
+                                              int64_t repetition_levels_size) {
+  CompressedDataPage page(data, static_cast<int32_t>(num_buffered_values_), encoding_,
+                          Encoding::RLE, Encoding::RLE, uncompressed_size, page_stats,
+                          page_first_row_);
+  if (properties_->data_page_version() == ParquetDataPageVersion::V2) {
+    page.set_v2(static_cast<int32_t>(num_buffered_values_ - num_buffered_encoded_values_),
+                static_cast<int32_t>(rows_written_ - page_start_rows_written_),
+                static_cast<int32_t>(definition_levels_size),
+                static_cast<int32_t>(repetition_levels_size));
+  }
+  return page;
+}
 
+void ColumnWriter::FinishDataPage() {
   // Re-initialize the sinks for next Page.
   InitSinks();
   num_buffered_values_ = 0;
   num_buffered_encoded_values_ = 0;
+  page_first_row_ = rows_written_;
+  page_start_rows_written_ = rows_written_;
+  page_cut_pending_ = false;
+
+  if (has_dictionary_ && !fallback_) {
+    CheckDictionaryEncoding();
+  }
+}
+
+void ColumnWriter::CutDataPage() {
+  if (record_aligned_pages_) {
+    page_cut_pending_ = true;
+    return;
+  }
+  AddDataPage();
+}
+
+void ColumnWriter::AddPendingDataPage(int64_t num_levels, const int16_t* rep_levels) {
+  if (!page_cut_pending_ || num_levels == 0 || rep_levels[0] != 0) {
+    return;
+  }
+  AddDataPage();
+  // A dictionary past its limits falls back once its page is added
+  if (has_dictionary_ && !fallback_) {
+    CheckDictionarySizeLimit();
+  }
+}
+
+int64_t ColumnWriter::MiniBatchSize(int64_t offset, int64_t num_levels,
+                                    const int16_t* rep_levels) const {
+  int64_t end = std::min(num_levels, offset + properties_->write_batch_size());
+  if (record_aligned_pages_) {
+    while (end < num_levels && rep_levels[end] != 0) {
+      ++end;
+    }
+  }
+  return end - offset;
 }
 
 void ColumnWriter::WriteDataPage(const CompressedDataPage& page) {
+  // Keep the pages in order
+  WritePendingPages(0);
   total_bytes_written_ += pager_->WriteDataPage(page);
 }
 
+void ColumnWriter::CompressDataPageAsync(const std::shared_ptr<ResizableBuffer>& data,
+                                         const EncodedStatistics& page_stats,
+                                         int64_t definition_levels_size,
+                                         int64_t repetition_levels_size) {
+  auto compressed_data =
+      std::static_pointer_cast<ResizableBuffer>(AllocateBuffer(allocator_, 0));
+  CompressedDataPage page = MakeDataPage(compressed_data, data->size(), page_stats,
+                                         definition_levels_size, repetition_levels_size);
+  auto pending = std::make_shared<PendingPage>(pager_.get(), data, compressed_data,
+                                               std::move(page));
+  const std::shared_ptr<ThreadPool>& pool = properties_->compression_thread_pool();
+  (pool != nullptr ? pool : ThreadPool::GetDefault())->Spawn([pending]() {
+    pending->Run();
+  });
+  pending_pages_.push_back(std::move(pending));
+  pending_pages_size_ += data->size();
+
+  WritePendingPages(static_cast<size_t>(properties_->page_compression_parallelism()));
+}
+
+void ColumnWriter::WritePendingPages(size_t max_pending) {
+  while (!pending_pages_.empty()) {
+    const std::shared_ptr<PendingPage>& pending = pending_pages_.front();
+    if (pending_pages_.size() <= max_pending &&
+        pending->done.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+      break;
+    }
+    pending->Wait();
+    total_bytes_written_ += pager_->WriteDataPage(pending->page);
+    pending_pages_size_ -= pending->page.uncompressed_size();
+    pending_pages_.pop_front();
+  }
+}
+
+ColumnWriter::~ColumnWriter() {
+  // The tasks refer to pager_
+  for (const auto& pending : pending_pages_) {
+    pending->Cancel();
+  }
+}
+
 int64_t ColumnWriter::Close() {
   if (!closed_) {
     closed_ = true;
-    if (has_dictionary_ && !fallback_) {
+    // The last page is buffered too, unless the dictionary page is written
+    // already
+    if (num_buffered_values_ > 0) {
+      AddDataPage();
+    }
+    WritePendingPages(0);
+    if (has_dictionary_ && !fallback_ && !dictionary_written_) {
       WriteDictionaryPage();
     }
-
-    FlushBufferedDataPages();
+    WriteBufferedDataPages();
+    if (has_dictionary_) {
+      if (!fallback_ && properties_->column_properties(descr_).dictionary_reuse_enabled) {
+        closed_dictionary_ = CopyDictionary();
+      }
+      // Release the values of the dictionary
+      ReleaseDictionaryMemory();
+    }
 
     EncodedStatistics chunk_statistics = GetChunkStatistics();
+    if (distinct_count_sketch_ != nullptr) {
+      chunk_statistics.set_distinct_count(distinct_count_sketch_->Estimate());
+      metadata_->SetDistinctCountSketch(*distinct_count_sketch_);
+    }
     if (chunk_statistics.is_set()) {
       metadata_->SetStatistics(SortOrder::SIGNED == descr_->sort_order(),
                                chunk_statistics);
     }
+    if (bloom_filter_enabled_) {
+      metadata_->SetBloomFilter(BuildBloomFilter());
+    }
     pager_->Close(has_dictionary_, fallback_);
   }
 
   return total_bytes_written_;
 }
 
+int64_t ColumnWriter::EstimatedSize() {
+  if (closed_) {
+    return total_bytes_written_;
+  }
+  return total_bytes_written_ + buffered_data_pages_size_ + pending_pages_size_ +
+         EstimatedValuesSize();
+}
+
+int64_t ColumnWriter::memory_usage() {
+  int64_t size = pager_->memory_usage();
+  if (closed_) {
+    return size;
+  }
+  size += buffered_data_pages_size_ + pending_pages_size_ + EncoderMemoryUsage();
+  size += definition_levels_sink_->capacity() + repetition_levels_sink_->capacity();
+  for (ResizableBuffer* buffer :
+       {definition_level_bits_.get(), definition_levels_rle_.get(),
+        repetition_levels_rle_.get(), uncompressed_data_.get(), compressed_data_.get()}) {
+    if (buffer != nullptr) {
+      size += buffer->capacity();
+    }
+  }
+  size += static_cast<int64_t>(bloom_filter_hashes_.capacity() * sizeof(uint64_t));
+  return size;
+}
+
+void ColumnWriter::ReleaseDictionaryMemory() {
+  ColumnWriteCounters* counters = pager_->write_counters();
+  if (counters != nullptr) {
+    ColumnWriteCounters::Max(&counters->peak_dictionary_memory_bytes,
+                             dictionary_pool_->total_reserved_bytes());
+  }
+  if (dictionary_pool_ == &pool_) {
+    pool_.FreeAll();
+  } else {
+    dictionary_pool_->Clear();
+  }
+}
+
+void ColumnWriter::AddValueHash(uint64_t hash) {
+  if (distinct_count_sketch_ != nullptr) {
+    distinct_count_sketch_->InsertHash(hash);
+  }
+  if (!bloom_filter_enabled_) {
+    return;
+  }
+  bloom_filter_hashes_.push_back(hash);
+  // Drop duplicates once in a while so that low cardinality columns only keep
+  // about as many hashes as they have distinct values
+  if (bloom_filter_hashes_.size() >= 2 * num_distinct_hashes_ + 1024) {
+    CompactBloomFilterHashes();
+  }
+}
+
+void ColumnWriter::CompactBloomFilterHashes() {
+  std::sort(bloom_filter_hashes_.begin(), bloom_filter_hashes_.end());
+  bloom_filter_hashes_.erase(
+      std::unique(bloom_filter_hashes_.begin(), bloom_filter_hashes_.end()),
+      bloom_filter_hashes_.end());
+  num_distinct_hashes_ = bloom_filter_hashes_.size();
+}
+
+std::unique_ptr<BloomFilter> ColumnWriter::BuildBloomFilter() {
+  // The filter is sized for the number of distinct values actually written
+  CompactBloomFilterHashes();
+  uint32_t ndv = static_cast<uint32_t>(
+      std::min<size_t>(num_distinct_hashes_, std::numeric_limits<uint32_t>::max()));
+  const double fpp = properties_->column_properties(descr_).bloom_filter_fpp;
+  std::unique_ptr<BloomFilter> bloom_filter(
+      new BloomFilter(BloomFilter::OptimalNumOfBytes(ndv, fpp), allocator_));
+  for (uint64_t hash : bloom_filter_hashes_) {
+    bloom_filter->InsertHash(hash);
+  }
+  std::vector<uint64_t>().swap(bloom_filter_hashes_);
+  return bloom_filter;
+}
+
 void ColumnWriter::FlushBufferedDataPages() {
   // Write all outstanding data to a new page
   if (num_buffered_values_ > 0) {
     AddDataPage();
   }
+  WriteBufferedDataPages();
+}
+
+void ColumnWriter::WriteBufferedDataPages() {
   for (size_t i = 0; i < data_pages_.size(); i++) {
     WriteDataPage(data_pages_[i]);
   }
   data_pages_.clear();
+  buffered_data_pages_size_ = 0;
 }
 
 // ----------------------------------------------------------------------
 // TypedColumnWriter
 
-template <typename Type>
-TypedColumnWriter<Type>::TypedColumnWriter(ColumnChunkMetaDataBuilder* metadata,
-                                           std::unique_ptr<PageWriter> pager,
-                                           Encoding::type encoding,
-                                           const WriterProperties* properties)
-    : ColumnWriter(metadata, std::move(pager),
-                   (encoding == Encoding::PLAIN_DICTIONARY ||
-                    encoding == Encoding::RLE_DICTIONARY),
-                   encoding, properties) {
-  switch (encoding) {
-    case Encoding::PLAIN:
-      current_encoder_.reset(new PlainEncoder<Type>(descr_, properties->memory_pool()));
-      break;
-    case Encoding::PLAIN_DICTIONARY:
-    case Encoding::RLE_DICTIONARY:
-      current_encoder_.reset(
-          new DictEncoder<Type>(descr_, &pool_, properties->memory_pool()));
-      break;
-    default:
-      ParquetException::NYI("Selected encoding is not supported");
+template <typename DType>
+inline uint64_t BloomFilterHash(const typename DType::c_type& value,
+                                const ColumnDescriptor* descr) {
+  return BloomFilter::Hash(value);
+}
+
+template <>
+inline uint64_t BloomFilterHash<FLBAType>(const FLBA& value,
+                                          const ColumnDescriptor* descr) {
+  return BloomFilter::Hash(value, static_cast<uint32_t>(descr->type_length()));
+}
+
+template <>
+inline uint64_t BloomFilterHash<BooleanType>(const bool& value,
+                                             const ColumnDescriptor* descr) {
+  // BOOLEAN columns do not have a Bloom filter or a distinct count sketch
+  return 0;
+}
+
+// Number of values TypedColumnWriter::EncodeValuesFused encodes, adds to the
+// statistics and hashes at once, small enough for the values to stay in L1
+static constexpr int64_t kFusedBlockSize = 512;
+
+// Forwards to the virtual methods of the encoders that have no devirtualized
+// EncodeValuesFused kernel. Their PutSpaced may copy the values, so they are
+// put in a single block.
+template <typename DType>
+class VirtualEncoder {
+ public:
+  typedef typename DType::c_type T;
+
+  explicit VirtualEncoder(Encoder<DType>* encoder) : encoder_(encoder) {}
+
+  void Put(const T* src, int num_values) { encoder_->Put(src, num_values); }
+
+  void PutSpaced(const T* src, int num_values, const uint8_t* valid_bits,
+                 int64_t valid_bits_offset) {
+    encoder_->PutSpaced(src, num_values, valid_bits, valid_bits_offset);
   }
 
-  if (properties->statistics_enabled(descr_->path()) &&
+  int64_t EstimatedDataEncodedSize() { return encoder_->EstimatedDataEncodedSize(); }
+
+ private:
+  Encoder<DType>* encoder_;
+};
+
+template <typename Type>
+TypedColumnWriter<Type>::TypedColumnWriter(ColumnChunkMetaDataBuilder* metadata,
+                                           std::unique_ptr<PageWriter> pager,
+                                           Encoding::type encoding,
+                                           const WriterProperties* properties)
+    : ColumnWriter(metadata, std::move(pager),
+                   (encoding == Encoding::PLAIN_DICTIONARY ||
+                    encoding == Encoding::RLE_DICTIONARY),
+                   encoding, properties),
+      num_dictionary_entries_written_(0),
+      dictionary_plain_size_(0),
+      dictionary_indices_size_(0),
+      dictionary_values_(0, properties->memory_pool()) {
+  current_encoder_ = MakeEncoder(encoding);
+
+  const ColumnProperties& column_properties = properties->column_properties(descr_);
+  if (column_properties.statistics_enabled &&
       (SortOrder::UNKNOWN != descr_->sort_order())) {
     page_statistics_ = std::unique_ptr<TypedStats>(new TypedStats(descr_, allocator_));
     chunk_statistics_ = std::unique_ptr<TypedStats>(new TypedStats(descr_, allocator_));
+    const int64_t truncate_length = column_properties.statistics_truncate_length;
+    page_statistics_->SetTruncateLength(truncate_length);
+    chunk_statistics_->SetTruncateLength(truncate_length);
+  }
+}
+
+template <typename Type>
+std::unique_ptr<Encoder<Type>> TypedColumnWriter<Type>::MakeEncoder(
+    Encoding::type encoding) {
+  ::arrow::MemoryPool* memory_pool = properties_->memory_pool();
+  switch (encoding) {
+    case Encoding::PLAIN:
+      return std::unique_ptr<EncoderType>(new PlainEncoder<Type>(descr_, memory_pool));
+    case Encoding::PLAIN_DICTIONARY:
+    case Encoding::RLE_DICTIONARY:
+      return std::unique_ptr<EncoderType>(
+          new DictEncoder<Type>(descr_, &pool_, memory_pool));
+    case Encoding::DELTA_BINARY_PACKED:
+    case Encoding::DELTA_LENGTH_BYTE_ARRAY:
+    case Encoding::DELTA_BYTE_ARRAY:
+      return MakeDeltaEncoder<Type>(encoding, descr_, memory_pool);
+    case Encoding::BYTE_STREAM_SPLIT:
+      return MakeByteStreamSplitEncoder<Type>(descr_, memory_pool);
+    default:
+      ParquetException::NYI("Selected encoding is not supported");
+  }
+  return nullptr;
+}
+
+template <typename Type>
+std::shared_ptr<Buffer> TypedColumnWriter<Type>::GetValuesBuffer() {
+  if (!has_dictionary_ || fallback_) {
+    return current_encoder_->FlushValues();
+  }
+  auto dict_encoder = static_cast<DictEncoder<Type>*>(current_encoder_.get());
+  if (dictionary_written_ &&
+      dict_encoder->num_entries() > num_dictionary_entries_written_) {
+    // Values the dictionary page lacks, this page and the following ones are
+    // PLAIN encoded
+    std::unique_ptr<EncoderType> plain_encoder(
+        new PlainEncoder<Type>(descr_, properties_->memory_pool()));
+    dict_encoder->PutBufferedValues(plain_encoder.get());
+    FallBackToPlain();
+    current_encoder_ = std::move(plain_encoder);
+    return current_encoder_->FlushValues();
   }
+  dictionary_plain_size_ += dict_encoder->PlainEncodedSize();
+  std::shared_ptr<Buffer> indices = dict_encoder->FlushValues();
+  dictionary_indices_size_ += indices->size();
+  return indices;
 }
 
 // Only one Dictionary Page is written.
 // Fallback to PLAIN if dictionary page limit is reached.
 template <typename Type>
 void TypedColumnWriter<Type>::CheckDictionarySizeLimit() {
+  // A dictionary that grows past the written dictionary page falls back at
+  // the end of the page
+  if (dictionary_written_) return;
   auto dict_encoder = static_cast<DictEncoder<Type>*>(current_encoder_.get());
-  if (dict_encoder->dict_encoded_size() >= properties_->dictionary_pagesize_limit()) {
-    WriteDictionaryPage();
+  const bool limit_reached =
+      dict_encoder->dict_encoded_size() >= properties_->dictionary_pagesize_limit() ||
+      dictionary_pool_->memory_limit_reached();
+  if (auto_encoding_pending_ &&
+      (limit_reached || num_buffered_encoded_values_ >=
+                            properties_->column_properties(descr_)
+                                .auto_encoding_sample_size)) {
+    ChooseEncoding();
+    if (!has_dictionary_) return;
+  }
+  if (limit_reached) {
     // Serialize the buffered Dictionary Indicies
-    FlushBufferedDataPages();
-    fallback_ = true;
-    // Only PLAIN encoding is supported for fallback in V1
-    current_encoder_.reset(new PlainEncoder<Type>(descr_, properties_->memory_pool()));
-    encoding_ = Encoding::PLAIN;
+    if (num_buffered_values_ > 0) {
+      CutDataPage();
+      // Falls back once the pending page is added
+      if (page_cut_pending_) return;
+    }
+    if (!fallback_) {
+      FallBackToPlain();
+    }
   }
 }
 
+template <typename Type>
+void TypedColumnWriter<Type>::CheckDictionaryEncoding() {
+  auto dict_encoder = static_cast<DictEncoder<Type>*>(current_encoder_.get());
+  const double min_ratio = properties_->dictionary_min_compression_ratio();
+  if (min_ratio > 0 &&
+      static_cast<double>(dictionary_plain_size_) <
+          min_ratio * static_cast<double>(dictionary_indices_size_ +
+                                          dict_encoder->dict_encoded_size())) {
+    FallBackToPlain();
+    return;
+  }
+  const int64_t limit = properties_->dictionary_buffered_pages_limit();
+  // The pages that a buffered pager keeps are not released by writing them
+  const int64_t memory_limit = properties_->memory_limit();
+  if (!dictionary_written_ &&
+      ((limit > 0 && buffered_data_pages_size_ >= limit) ||
+       (memory_limit > 0 && memory_usage() - pager_->memory_usage() >= memory_limit))) {
+    WriteDictionaryPage();
+    WriteBufferedDataPages();
+    dictionary_written_ = true;
+    num_dictionary_entries_written_ = dict_encoder->num_entries();
+  }
+}
+
+namespace {
+
+// The sampled encodings besides dictionary encoding
+std::vector<Encoding::type> AutoEncodingCandidates(Type::type physical_type) {
+  switch (physical_type) {
+    case Type::INT32:
+    case Type::INT64:
+      return {Encoding::PLAIN, Encoding::DELTA_BINARY_PACKED};
+    case Type::FLOAT:
+    case Type::DOUBLE:
+      return {Encoding::PLAIN, Encoding::BYTE_STREAM_SPLIT};
+    case Type::BYTE_ARRAY:
+      return {Encoding::PLAIN, Encoding::DELTA_LENGTH_BYTE_ARRAY,
+              Encoding::DELTA_BYTE_ARRAY};
+    default:
+      return {Encoding::PLAIN};
+  }
+}
+
+// Size of the sample in encoding plus its decode cost, as the bytes per value
+// that an encoding has to save over one that decodes faster to be chosen
+double AutoEncodingCost(Encoding::type encoding, int64_t size, int num_values) {
+  double bytes_per_value;
+  switch (encoding) {
+    case Encoding::PLAIN:
+      bytes_per_value = 0.0;
+      break;
+    case Encoding::PLAIN_DICTIONARY:
+    case Encoding::RLE_DICTIONARY:
+    case Encoding::BYTE_STREAM_SPLIT:
+      bytes_per_value = 0.125;
+      break;
+    case Encoding::DELTA_BINARY_PACKED:
+    case Encoding::DELTA_LENGTH_BYTE_ARRAY:
+      bytes_per_value = 0.25;
+      break;
+    default:
+      bytes_per_value = 0.5;
+      break;
+  }
+  return static_cast<double>(size) + bytes_per_value * num_values;
+}
+
+std::atomic<int64_t>* AutoEncodingCounter(ColumnWriteCounters* counters,
+                                          Encoding::type encoding) {
+  switch (encoding) {
+    case Encoding::PLAIN:
+      return &counters->num_auto_plain;
+    case Encoding::PLAIN_DICTIONARY:
+    case Encoding::RLE_DICTIONARY:
+      return &counters->num_auto_dictionary;
+    case Encoding::BYTE_STREAM_SPLIT:
+      return &counters->num_auto_byte_stream_split;
+    default:
+      return &counters->num_auto_delta;
+  }
+}
+
+}  // namespace
+
+template <typename Type>
+void TypedColumnWriter<Type>::ChooseEncoding() {
+  auto_encoding_pending_ = false;
+  auto dict_encoder = static_cast<DictEncoder<Type>*>(current_encoder_.get());
+  const int num_values = dict_encoder->num_buffered_values();
+  if (num_values == 0) {
+    return;
+  }
+  ColumnWriteCounters* counters = pager_->write_counters();
+  ScopedWriteTimer timer(counters, &ColumnWriteCounters::auto_encoding_nanos);
+
+  // The size a page of the encoded values is stored with
+  auto compressed =
+      std::static_pointer_cast<ResizableBuffer>(AllocateBuffer(allocator_, 0));
+  auto stored_size = [&](const Buffer& encoded) -> int64_t {
+    if (!pager_->has_compressor()) {
+      return encoded.size();
+    }
+    pager_->Compress(encoded, compressed.get());
+    return compressed->size();
+  };
+
+  // A dictionary past its limits would fall back right away
+  Encoding::type chosen = encoding_;
+  double chosen_cost = std::numeric_limits<double>::infinity();
+  if (dict_encoder->dict_encoded_size() < properties_->dictionary_pagesize_limit() &&
+      !dictionary_pool_->memory_limit_reached()) {
+    // Writing the indices clears them, they are put back if they are kept
+    const std::vector<int> indices = dict_encoder->buffered_indices();
+    std::shared_ptr<PoolBuffer> indices_buffer =
+        AllocateBuffer(allocator_, dict_encoder->EstimatedDataEncodedSize());
+    const int indices_size = dict_encoder->WriteIndices(
+        indices_buffer->mutable_data(), static_cast<int>(indices_buffer->size()));
+    PARQUET_THROW_NOT_OK(indices_buffer->Resize(indices_size, false));
+    dict_encoder->PutIndices(indices.data(), num_values);
+    std::shared_ptr<PoolBuffer> dictionary_buffer =
+        AllocateBuffer(allocator_, dict_encoder->dict_encoded_size());
+    dict_encoder->WriteDict(dictionary_buffer->mutable_data());
+    chosen_cost =
+        AutoEncodingCost(encoding_, stored_size(*indices_buffer) +
+                                        stored_size(*dictionary_buffer),
+                         num_values);
+  }
+
+  std::unique_ptr<T[]> sample(new T[num_values]);
+  dict_encoder->GetBufferedValues(sample.get());
+  for (Encoding::type encoding : AutoEncodingCandidates(descr_->physical_type())) {
+    std::unique_ptr<EncoderType> encoder = MakeEncoder(encoding);
+    encoder->Put(sample.get(), num_values);
+    const double cost =
+        AutoEncodingCost(encoding, stored_size(*encoder->FlushValues()), num_values);
+    if (cost < chosen_cost) {
+      chosen = encoding;
+      chosen_cost = cost;
+    }
+  }
+  if (counters != nullptr) {
+    ColumnWriteCounters::Add(AutoEncodingCounter(counters, chosen), 1);
+  }
+  if (chosen == encoding_) {
+    return;
+  }
+
+  // The copied values are only valid until the dictionary memory is released
+  std::unique_ptr<EncoderType> encoder = MakeEncoder(chosen);
+  dict_encoder->PutBufferedValues(encoder.get());
+  current_encoder_ = std::move(encoder);
+  has_dictionary_ = false;
+  encoding_ = chosen;
+  ReleaseDictionaryMemory();
+  metadata_->SetEncodings({chosen, Encoding::RLE});
+}
+
+template <typename Type>
+int64_t TypedColumnWriter<Type>::EstimatedValuesSize() {
+  int64_t size = current_encoder_->EstimatedDataEncodedSize();
+  if (has_dictionary_ && !fallback_ && !dictionary_written_) {
+    size += static_cast<DictEncoder<Type>*>(current_encoder_.get())->dict_encoded_size();
+  }
+  return size;
+}
+
+template <typename Type>
+int64_t TypedColumnWriter<Type>::EncoderMemoryUsage() {
+  int64_t size = current_encoder_->EstimatedDataEncodedSize();
+  if (has_dictionary_ && !fallback_) {
+    size += static_cast<DictEncoder<Type>*>(current_encoder_.get())->memory_usage();
+    size += dictionary_pool_->total_reserved_bytes();
+  }
+  return size;
+}
+
+template <typename Type>
+void TypedColumnWriter<Type>::FallBackToPlain() {
+  ColumnWriteCounters* counters = pager_->write_counters();
+  if (counters != nullptr) {
+    auto dict_encoder = static_cast<DictEncoder<Type>*>(current_encoder_.get());
+    ColumnWriteCounters::Add(&counters->num_dictionary_fallbacks, 1);
+    ColumnWriteCounters::Add(&counters->fallback_dictionary_bytes,
+                             dict_encoder->dict_encoded_size());
+  }
+  if (!dictionary_written_) {
+    WriteDictionaryPage();
+    WriteBufferedDataPages();
+  }
+  fallback_ = true;
+  // Only PLAIN encoding is supported for fallback in V1
+  current_encoder_.reset(new PlainEncoder<Type>(descr_, properties_->memory_pool()));
+  encoding_ = Encoding::PLAIN;
+  ReleaseDictionaryMemory();
+}
+
 template <typename Type>
 void TypedColumnWriter<Type>::WriteDictionaryPage() {
   auto dict_encoder = static_cast<DictEncoder<Type>*>(current_encoder_.get());
   std::shared_ptr<PoolBuffer> buffer =
       AllocateBuffer(properties_->memory_pool(), dict_encoder->dict_encoded_size());
   dict_encoder->WriteDict(buffer->mutable_data());
-  // TODO Get rid of this deep call
-  dict_encoder->mem_pool()->FreeAll();
 
   DictionaryPage page(buffer, dict_encoder->num_entries(),
                       properties_->dictionary_index_encoding());
   total_bytes_written_ += pager_->WriteDictionaryPage(page);
 }
 
+namespace {
+
+template <typename DType>
+class TypedColumnDictionary : public ColumnDictionary {
+ public:
+  TypedColumnDictionary(const ColumnDescriptor* descr, ::arrow::MemoryPool* pool)
+      : values_pool_(pool), encoder_(descr, &values_pool_, pool) {}
+
+  DictEncoder<DType>* encoder() { return &encoder_; }
+  const DictEncoder<DType>& encoder() const { return encoder_; }
+
+ private:
+  // Holds the BYTE_ARRAY and FIXED_LEN_BYTE_ARRAY entries of encoder_
+  ChunkedAllocator values_pool_;
+  DictEncoder<DType> encoder_;
+};
+
+}  // namespace
+
+template <typename Type>
+std::shared_ptr<ColumnDictionary> TypedColumnWriter<Type>::CopyDictionary() {
+  auto dictionary = std::make_shared<TypedColumnDictionary<Type>>(
+      descr_, properties_->memory_pool());
+  dictionary->encoder()->CopyDictionary(
+      *static_cast<DictEncoder<Type>*>(current_encoder_.get()));
+  return dictionary;
+}
+
+template <typename Type>
+void TypedColumnWriter<Type>::SeedDictionary(const ColumnDictionary& dictionary) {
+  if (!has_dictionary_ || fallback_) {
+    return;
+  }
+  if (num_buffered_values_ > 0 || rows_written_ > 0) {
+    throw ParquetException("The dictionary must be seeded before writing values");
+  }
+  static_cast<DictEncoder<Type>*>(current_encoder_.get())
+      ->CopyDictionary(
+          static_cast<const TypedColumnDictionary<Type>&>(dictionary).encoder());
+}
+
+template <typename Type>
+void TypedColumnWriter<Type>::SetDictionaryAllocator(ChunkedAllocator* pool) {
+  if (num_buffered_values_ > 0 || rows_written_ > 0) {
+    throw ParquetException("The dictionary allocator must be set before writing values");
+  }
+  pool->Clear();
+  pool->set_memory_limit(properties_->dictionary_memory_limit());
+  dictionary_pool_ = pool;
+  if (has_dictionary_ && !fallback_) {
+    auto dict_encoder = static_cast<DictEncoder<Type>*>(current_encoder_.get());
+    if (dict_encoder->num_entries() > 0) {
+      throw ParquetException("The dictionary allocator must be set before seeding");
+    }
+    dict_encoder->set_mem_pool(pool);
+  }
+}
+
 template <typename Type>
 EncodedStatistics TypedColumnWriter<Type>::GetPageStatistics() {
   EncodedStatistics result;
@@ -543,8 +1605,10 @@ std::shared_ptr<ColumnWriter> ColumnWriter::Make(ColumnChunkMetaDataBuilder* met
                                                  std::unique_ptr<PageWriter> pager,
                                                  const WriterProperties* properties) {
   const ColumnDescriptor* descr = metadata->descr();
-  Encoding::type encoding = properties->encoding(descr->path());
-  if (properties->dictionary_enabled(descr->path()) &&
+  const ColumnProperties& column_properties = properties->column_properties(descr);
+  Encoding::type encoding = column_properties.encoding;
+  // Auto encoded chunks start dictionary encoded until the sample is buffered
+  if ((column_properties.dictionary_enabled || column_properties.auto_encoding_enabled) &&
       descr->physical_type() != Type::BOOLEAN) {
     encoding = properties->dictionary_page_encoding();
   }
@@ -583,14 +1647,25 @@ std::shared_ptr<ColumnWriter> ColumnWriter::Make(ColumnChunkMetaDataBuilder* met
 // ----------------------------------------------------------------------
 // Instantiate templated classes
 
+// The levels of the mini batch at offset, omitted levels stay omitted
+static inline const int16_t* LevelsAt(const int16_t* levels, int64_t offset) {
+  return levels == nullptr ? nullptr : levels + offset;
+}
+
 template <typename DType>
 inline int64_t TypedColumnWriter<DType>::WriteMiniBatch(int64_t num_values,
                                                         const int16_t* def_levels,
                                                         const int16_t* rep_levels,
                                                         const T* values) {
+  AddPendingDataPage(num_values, rep_levels);
   int64_t values_to_write = 0;
   // If the field is required and non-repeated, there are no definition levels
-  if (descr_->max_definition_level() > 0) {
+  if (descr_->max_definition_level() > 0 && def_levels == nullptr) {
+    // Omitted levels, all values are present
+    CheckOmittedDefinitionLevels();
+    values_to_write = num_values;
+    WriteDefinitionLevelBits(num_values, nullptr, 0);
+  } else if (descr_->max_definition_level() > 0) {
     for (int64_t i = 0; i < num_values; ++i) {
       if (def_levels[i] == descr_->max_definition_level()) {
         ++values_to_write;
@@ -605,6 +1680,11 @@ inline int64_t TypedColumnWriter<DType>::WriteMiniBatch(int64_t num_values,
 
   // Not present for non-repeated fields
   if (descr_->max_repetition_level() > 0) {
+    // The offset index can only locate pages that start at a row boundary
+    if (num_buffered_values_ == 0 && num_values > 0 && rep_levels[0] != 0) {
+      page_first_row_ = -1;
+    }
+
     // A row could include more than one value
     // Count the occasions where we start a new row
     for (int64_t i = 0; i < num_values; ++i) {
@@ -624,17 +1704,14 @@ inline int64_t TypedColumnWriter<DType>::WriteMiniBatch(int64_t num_values,
     DCHECK(nullptr != values) << "Values ptr cannot be NULL";
   }
 
-  WriteValues(values_to_write, values);
-
-  if (page_statistics_ != nullptr) {
-    page_statistics_->Update(values, values_to_write, num_values - values_to_write);
-  }
+  const int64_t encoded_size =
+      EncodeValues(values_to_write, num_values - values_to_write, nullptr, 0, values);
 
   num_buffered_values_ += num_values;
   num_buffered_encoded_values_ += values_to_write;
 
-  if (current_encoder_->EstimatedDataEncodedSize() >= properties_->data_pagesize()) {
-    AddDataPage();
+  if (encoded_size >= properties_->data_pagesize()) {
+    CutDataPage();
   }
   if (has_dictionary_ && !fallback_) {
     CheckDictionarySizeLimit();
@@ -650,62 +1727,24 @@ inline int64_t TypedColumnWriter<DType>::WriteMiniBatchSpaced(
     int64_t* num_spaced_written) {
   int64_t values_to_write = 0;
   int64_t spaced_values_to_write = 0;
-  // If the field is required and non-repeated, there are no definition levels
-  if (descr_->max_definition_level() > 0) {
-    // Minimal definition level for which spaced values are written
-    int16_t min_spaced_def_level = descr_->max_definition_level();
-    if (descr_->schema_node()->is_optional()) {
-      min_spaced_def_level--;
-    }
-    for (int64_t i = 0; i < num_values; ++i) {
-      if (def_levels[i] == descr_->max_definition_level()) {
-        ++values_to_write;
-      }
-      if (def_levels[i] >= min_spaced_def_level) {
-        ++spaced_values_to_write;
-      }
-    }
-
-    WriteDefinitionLevels(num_values, def_levels);
-  } else {
-    // Required field, write all values
-    values_to_write = num_values;
-    spaced_values_to_write = num_values;
-  }
-
-  // Not present for non-repeated fields
-  if (descr_->max_repetition_level() > 0) {
-    // A row could include more than one value
-    // Count the occasions where we start a new row
-    for (int64_t i = 0; i < num_values; ++i) {
-      if (rep_levels[i] == 0) {
-        rows_written_++;
-      }
-    }
-
-    WriteRepetitionLevels(num_values, rep_levels);
-  } else {
-    // Each value is exactly one row
-    rows_written_ += static_cast<int>(num_values);
-  }
-
-  if (descr_->schema_node()->is_optional()) {
-    WriteValuesSpaced(spaced_values_to_write, valid_bits, valid_bits_offset, values);
+  WriteLevelsSpaced(num_values, def_levels, rep_levels, valid_bits, valid_bits_offset,
+                    &values_to_write, &spaced_values_to_write);
+
+  const int64_t null_count = num_values - values_to_write;
+  int64_t encoded_size;
+  if (HasSpacedValues()) {
+    encoded_size = EncodeValues(spaced_values_to_write, null_count, valid_bits,
+                                valid_bits_offset, values);
   } else {
-    WriteValues(values_to_write, values);
+    encoded_size = EncodeValues(values_to_write, null_count, nullptr, 0, values);
   }
   *num_spaced_written = spaced_values_to_write;
 
-  if (page_statistics_ != nullptr) {
-    page_statistics_->UpdateSpaced(values, valid_bits, valid_bits_offset, values_to_write,
-                                   num_values - values_to_write);
-  }
-
   num_buffered_values_ += num_values;
   num_buffered_encoded_values_ += values_to_write;
 
-  if (current_encoder_->EstimatedDataEncodedSize() >= properties_->data_pagesize()) {
-    AddDataPage();
+  if (encoded_size >= properties_->data_pagesize()) {
+    CutDataPage();
   }
   if (has_dictionary_ && !fallback_) {
     CheckDictionarySizeLimit();
@@ -722,20 +1761,14 @@ void TypedColumnWriter<DType>::WriteBatch(int64_t num_values, const int16_t* def
   // The purpose of this chunking is to bound this. Even if a user writes large number
   // of values, the chunking will ensure the AddDataPage() is called at a reasonable
   // pagesize limit
-  int64_t write_batch_size = properties_->write_batch_size();
-  int num_batches = static_cast<int>(num_values / write_batch_size);
-  int64_t num_remaining = num_values % write_batch_size;
+  int64_t offset = 0;
   int64_t value_offset = 0;
-  for (int round = 0; round < num_batches; round++) {
-    int64_t offset = round * write_batch_size;
-    int64_t num_values = WriteMiniBatch(write_batch_size, &def_levels[offset],
-                                        &rep_levels[offset], &values[value_offset]);
-    value_offset += num_values;
-  }
-  // Write the remaining values
-  int64_t offset = num_batches * write_batch_size;
-  WriteMiniBatch(num_remaining, &def_levels[offset], &rep_levels[offset],
-                 &values[value_offset]);
+  do {
+    const int64_t batch_size = MiniBatchSize(offset, num_values, rep_levels);
+    value_offset += WriteMiniBatch(batch_size, LevelsAt(def_levels, offset),
+                                   LevelsAt(rep_levels, offset), &values[value_offset]);
+    offset += batch_size;
+  } while (offset < num_values);
 }
 
 template <typename DType>
@@ -747,27 +1780,297 @@ void TypedColumnWriter<DType>::WriteBatchSpaced(
   // The purpose of this chunking is to bound this. Even if a user writes large number
   // of values, the chunking will ensure the AddDataPage() is called at a reasonable
   // pagesize limit
-  int64_t write_batch_size = properties_->write_batch_size();
-  int num_batches = static_cast<int>(num_values / write_batch_size);
-  int64_t num_remaining = num_values % write_batch_size;
   int64_t num_spaced_written = 0;
+  int64_t offset = 0;
   int64_t values_offset = 0;
-  for (int round = 0; round < num_batches; round++) {
-    int64_t offset = round * write_batch_size;
-    WriteMiniBatchSpaced(write_batch_size, &def_levels[offset], &rep_levels[offset],
-                         valid_bits, valid_bits_offset + values_offset,
-                         values + values_offset, &num_spaced_written);
+  do {
+    const int64_t batch_size = MiniBatchSize(offset, num_values, rep_levels);
+    WriteMiniBatchSpaced(batch_size, LevelsAt(def_levels, offset),
+                         LevelsAt(rep_levels, offset), valid_bits,
+                         valid_bits_offset + values_offset, values + values_offset,
+                         &num_spaced_written);
+    offset += batch_size;
     values_offset += num_spaced_written;
+  } while (offset < num_values);
+}
+
+template <typename DType>
+int64_t TypedColumnWriter<DType>::WriteMiniBatchDictionary(
+    int64_t num_values, const int16_t* def_levels, const int16_t* rep_levels,
+    const uint8_t* valid_bits, int64_t valid_bits_offset, const int32_t* indices,
+    const T* dictionary, int64_t dictionary_length, int64_t* num_spaced_written) {
+  int64_t values_to_write = 0;
+  int64_t spaced_values_to_write = 0;
+  WriteLevelsSpaced(num_values, def_levels, rep_levels, valid_bits, valid_bits_offset,
+                    &values_to_write, &spaced_values_to_write);
+  *num_spaced_written = spaced_values_to_write;
+
+  // Collect the indices of the present values
+  dictionary_indices_.clear();
+  if (valid_bits == nullptr || !HasSpacedValues()) {
+    dictionary_indices_.assign(indices, indices + values_to_write);
+  } else {
+    ::arrow::internal::BitmapReader valid_bits_reader(valid_bits, valid_bits_offset,
+                                                      spaced_values_to_write);
+    for (int64_t i = 0; i < spaced_values_to_write; ++i) {
+      if (valid_bits_reader.IsSet()) {
+        dictionary_indices_.push_back(indices[i]);
+      }
+      valid_bits_reader.Next();
+    }
+  }
+  for (int32_t index : dictionary_indices_) {
+    if (index < 0 || index >= dictionary_length) {
+      throw ParquetException("Dictionary index out of range");
+    }
   }
-  // Write the remaining values
-  int64_t offset = num_batches * write_batch_size;
-  WriteMiniBatchSpaced(num_remaining, &def_levels[offset], &rep_levels[offset],
-                       valid_bits, valid_bits_offset + values_offset,
-                       values + values_offset, &num_spaced_written);
+  const auto num_present = static_cast<int>(dictionary_indices_.size());
+
+  const bool dictionary_encoded = has_dictionary_ && !fallback_;
+  if (!dictionary_encoded || page_statistics_ != nullptr) {
+    dictionary_values_.Resize(num_present);
+    for (int i = 0; i < num_present; ++i) {
+      dictionary_values_[i] = dictionary[dictionary_indices_[i]];
+    }
+  }
+  if (page_statistics_ != nullptr) {
+    ScopedWriteTimer timer(pager_->write_counters(),
+                           &ColumnWriteCounters::statistics_nanos);
+    page_statistics_->Update(dictionary_values_.data(), num_present,
+                             num_values - values_to_write);
+  }
+  if (hashes_values()) {
+    if (dictionary_hashes_.empty()) {
+      dictionary_hashes_.resize(dictionary_length);
+      for (int64_t i = 0; i < dictionary_length; ++i) {
+        dictionary_hashes_[i] = BloomFilterHash<DType>(dictionary[i], descr_);
+      }
+    }
+    for (int32_t index : dictionary_indices_) {
+      AddValueHash(dictionary_hashes_[index]);
+    }
+  }
+
+  if (dictionary_encoded) {
+    ScopedWriteTimer timer(pager_->write_counters(), encode_counter());
+    auto dict_encoder = static_cast<DictEncoder<DType>*>(current_encoder_.get());
+    if (dictionary_map_.empty()) {
+      dictionary_map_.resize(dictionary_length);
+      dict_encoder->PutDictionary(dictionary, static_cast<int>(dictionary_length),
+                                  dictionary_map_.data());
+    }
+    for (int32_t& index : dictionary_indices_) {
+      index = dictionary_map_[index];
+    }
+    dict_encoder->PutIndices(dictionary_indices_.data(), num_present);
+  } else {
+    WriteValues(num_present, dictionary_values_.data());
+  }
+
+  num_buffered_values_ += num_values;
+  num_buffered_encoded_values_ += values_to_write;
+
+  if (current_encoder_->EstimatedDataEncodedSize() >= properties_->data_pagesize()) {
+    CutDataPage();
+  }
+  if (has_dictionary_ && !fallback_) {
+    CheckDictionarySizeLimit();
+  }
+
+  return values_to_write;
+}
+
+template <typename DType>
+void TypedColumnWriter<DType>::WriteBatchDictionary(
+    int64_t num_values, const int16_t* def_levels, const int16_t* rep_levels,
+    const uint8_t* valid_bits, int64_t valid_bits_offset, const int32_t* indices,
+    const T* dictionary, int64_t dictionary_length) {
+  // The dictionary of the previous call may differ
+  dictionary_map_.clear();
+  dictionary_hashes_.clear();
+
+  // Mini batches as in WriteBatchSpaced, so that the page and dictionary size
+  // limits are checked at a reasonable rate
+  int64_t num_spaced_written = 0;
+  int64_t offset = 0;
+  int64_t values_offset = 0;
+  do {
+    const int64_t batch_size = MiniBatchSize(offset, num_values, rep_levels);
+    WriteMiniBatchDictionary(batch_size, LevelsAt(def_levels, offset),
+                             LevelsAt(rep_levels, offset), valid_bits,
+                             valid_bits_offset + values_offset, indices + values_offset,
+                             dictionary, dictionary_length, &num_spaced_written);
+    offset += batch_size;
+    values_offset += num_spaced_written;
+  } while (offset < num_values);
+}
+
+template <>
+int64_t TypedColumnWriter<ByteArrayType>::WriteMiniBatchBinary(
+    int64_t num_values, const int16_t* def_levels, const int16_t* rep_levels,
+    const uint8_t* valid_bits, int64_t valid_bits_offset, const int32_t* offsets,
+    const uint8_t* data, int64_t* num_spaced_written) {
+  int64_t values_to_write = 0;
+  int64_t spaced_values_to_write = 0;
+  WriteLevelsSpaced(num_values, def_levels, rep_levels, valid_bits, valid_bits_offset,
+                    &values_to_write, &spaced_values_to_write);
+  *num_spaced_written = spaced_values_to_write;
+
+  // Without spaced values all the values are present
+  if (!HasSpacedValues()) {
+    valid_bits = nullptr;
+  }
+  const auto num_offsets = static_cast<int>(spaced_values_to_write);
+
+  if (has_dictionary_ && !fallback_) {
+    ScopedWriteTimer timer(pager_->write_counters(), encode_counter());
+    auto dict_encoder = static_cast<DictEncoder<ByteArrayType>*>(current_encoder_.get());
+    dict_encoder->PutBinary(offsets, data, num_offsets, valid_bits, valid_bits_offset);
+  } else if (current_encoder_->encoding() == Encoding::PLAIN) {
+    ScopedWriteTimer timer(pager_->write_counters(), encode_counter());
+    auto plain_encoder =
+        static_cast<PlainEncoder<ByteArrayType>*>(current_encoder_.get());
+    plain_encoder->PutBinary(offsets, data, num_offsets, valid_bits, valid_bits_offset);
+  } else {
+    // The delta encoders work on ByteArray values
+    std::vector<ByteArray> values(num_offsets);
+    for (int i = 0; i < num_offsets; ++i) {
+      values[i].len = static_cast<uint32_t>(offsets[i + 1] - offsets[i]);
+      values[i].ptr = data + offsets[i];
+    }
+    if (valid_bits == nullptr) {
+      WriteValues(num_offsets, values.data());
+    } else {
+      WriteValuesSpaced(num_offsets, valid_bits, valid_bits_offset, values.data());
+    }
+  }
+
+  if (page_statistics_ != nullptr) {
+    ScopedWriteTimer timer(pager_->write_counters(),
+                           &ColumnWriteCounters::statistics_nanos);
+    page_statistics_->UpdateBinary(offsets, data, valid_bits, valid_bits_offset,
+                                   num_offsets, values_to_write,
+                                   num_values - values_to_write);
+  }
+  if (hashes_values()) {
+    for (int i = 0; i < num_offsets; ++i) {
+      if (valid_bits == nullptr || BitUtil::GetBit(valid_bits, valid_bits_offset + i)) {
+        const ByteArray value(static_cast<uint32_t>(offsets[i + 1] - offsets[i]),
+                              data + offsets[i]);
+        AddValueHash(BloomFilterHash<ByteArrayType>(value, descr_));
+      }
+    }
+  }
+
+  num_buffered_values_ += num_values;
+  num_buffered_encoded_values_ += values_to_write;
+
+  if (current_encoder_->EstimatedDataEncodedSize() >= properties_->data_pagesize()) {
+    CutDataPage();
+  }
+  if (has_dictionary_ && !fallback_) {
+    CheckDictionarySizeLimit();
+  }
+
+  return values_to_write;
+}
+
+template <>
+void TypedColumnWriter<ByteArrayType>::WriteBatchBinary(
+    int64_t num_values, const int16_t* def_levels, const int16_t* rep_levels,
+    const uint8_t* valid_bits, int64_t valid_bits_offset, const int32_t* offsets,
+    const uint8_t* data) {
+  // Mini batches as in WriteBatchSpaced
+  int64_t num_spaced_written = 0;
+  int64_t offset = 0;
+  int64_t values_offset = 0;
+  do {
+    const int64_t batch_size = MiniBatchSize(offset, num_values, rep_levels);
+    WriteMiniBatchBinary(batch_size, LevelsAt(def_levels, offset),
+                         LevelsAt(rep_levels, offset), valid_bits,
+                         valid_bits_offset + values_offset, offsets + values_offset, data,
+                         &num_spaced_written);
+    offset += batch_size;
+    values_offset += num_spaced_written;
+  } while (offset < num_values);
+}
+
+template <>
+int64_t TypedColumnWriter<BooleanType>::WriteMiniBatchBitmap(
+    int64_t num_values, const int16_t* def_levels, const int16_t* rep_levels,
+    const uint8_t* valid_bits, int64_t valid_bits_offset, const uint8_t* values,
+    int64_t values_offset, int64_t* num_spaced_written) {
+  int64_t values_to_write = 0;
+  int64_t spaced_values_to_write = 0;
+  WriteLevelsSpaced(num_values, def_levels, rep_levels, valid_bits, valid_bits_offset,
+                    &values_to_write, &spaced_values_to_write);
+  *num_spaced_written = spaced_values_to_write;
+
+  // Without spaced values all the values are present
+  if (!HasSpacedValues()) {
+    valid_bits = nullptr;
+  }
+  const auto num_slots = static_cast<int>(spaced_values_to_write);
+
+  if (current_encoder_->encoding() == Encoding::PLAIN) {
+    ScopedWriteTimer timer(pager_->write_counters(), encode_counter());
+    auto plain_encoder = static_cast<PlainEncoder<BooleanType>*>(current_encoder_.get());
+    plain_encoder->PutBitmap(values, values_offset, num_slots, valid_bits,
+                             valid_bits_offset);
+  } else {
+    // The other encoders work on bool values
+    std::unique_ptr<bool[]> unpacked(new bool[num_slots]);
+    for (int i = 0; i < num_slots; ++i) {
+      unpacked[i] = BitUtil::GetBit(values, values_offset + i);
+    }
+    if (valid_bits == nullptr) {
+      WriteValues(num_slots, unpacked.get());
+    } else {
+      WriteValuesSpaced(num_slots, valid_bits, valid_bits_offset, unpacked.get());
+    }
+  }
+
+  if (page_statistics_ != nullptr) {
+    ScopedWriteTimer timer(pager_->write_counters(),
+                           &ColumnWriteCounters::statistics_nanos);
+    page_statistics_->UpdateBitmap(values, values_offset, valid_bits, valid_bits_offset,
+                                   num_slots, values_to_write,
+                                   num_values - values_to_write);
+  }
+
+  num_buffered_values_ += num_values;
+  num_buffered_encoded_values_ += values_to_write;
+
+  if (current_encoder_->EstimatedDataEncodedSize() >= properties_->data_pagesize()) {
+    CutDataPage();
+  }
+
+  return values_to_write;
+}
+
+template <>
+void TypedColumnWriter<BooleanType>::WriteBatchBitmap(
+    int64_t num_values, const int16_t* def_levels, const int16_t* rep_levels,
+    const uint8_t* valid_bits, int64_t valid_bits_offset, const uint8_t* values,
+    int64_t values_offset) {
+  // Mini batches as in WriteBatchSpaced
+  int64_t num_spaced_written = 0;
+  int64_t offset = 0;
+  int64_t slots_offset = 0;
+  do {
+    const int64_t batch_size = MiniBatchSize(offset, num_values, rep_levels);
+    WriteMiniBatchBitmap(batch_size, LevelsAt(def_levels, offset),
+                         LevelsAt(rep_levels, offset), valid_bits,
+                         valid_bits_offset + slots_offset, values,
+                         values_offset + slots_offset, &num_spaced_written);
+    offset += batch_size;
+    slots_offset += num_spaced_written;
+  } while (offset < num_values);
 }
 
 template <typename DType>
 void TypedColumnWriter<DType>::WriteValues(int64_t num_values, const T* values) {
+  ScopedWriteTimer timer(pager_->write_counters(), encode_counter());
   current_encoder_->Put(values, static_cast<int>(num_values));
 }
 
@@ -776,10 +2079,85 @@ void TypedColumnWriter<DType>::WriteValuesSpaced(int64_t num_values,
                                                  const uint8_t* valid_bits,
                                                  int64_t valid_bits_offset,
                                                  const T* values) {
+  ScopedWriteTimer timer(pager_->write_counters(), encode_counter());
   current_encoder_->PutSpaced(values, static_cast<int>(num_values), valid_bits,
                               valid_bits_offset);
 }
 
+template <typename DType>
+int64_t TypedColumnWriter<DType>::EncodeValues(int64_t num_values, int64_t null_count,
+                                               const uint8_t* valid_bits,
+                                               int64_t valid_bits_offset,
+                                               const T* values) {
+  if (has_dictionary_ && !fallback_) {
+    return EncodeValuesFused(static_cast<DictEncoder<DType>*>(current_encoder_.get()),
+                             kFusedBlockSize, num_values, null_count, valid_bits,
+                             valid_bits_offset, values);
+  } else if (current_encoder_->encoding() == Encoding::PLAIN) {
+    return EncodeValuesFused(static_cast<PlainEncoder<DType>*>(current_encoder_.get()),
+                             kFusedBlockSize, num_values, null_count, valid_bits,
+                             valid_bits_offset, values);
+  }
+  VirtualEncoder<DType> encoder(current_encoder_.get());
+  return EncodeValuesFused(&encoder, std::max<int64_t>(num_values, 1), num_values,
+                           null_count, valid_bits, valid_bits_offset, values);
+}
+
+template <typename DType>
+template <typename EncoderClass>
+int64_t TypedColumnWriter<DType>::EncodeValuesFused(
+    EncoderClass* encoder, int64_t block_size, int64_t num_values, int64_t null_count,
+    const uint8_t* valid_bits, int64_t valid_bits_offset, const T* values) {
+  ColumnWriteCounters* counters = pager_->write_counters();
+  const ScopedWriteTimer::Counter encode_nanos = encode_counter();
+  const bool hashes = hashes_values();
+  for (int64_t start = 0; start < num_values; start += block_size) {
+    const T* block = values + start;
+    const int length = static_cast<int>(std::min(block_size, num_values - start));
+    const int64_t offset = valid_bits_offset + start;
+    {
+      ScopedWriteTimer timer(counters, encode_nanos);
+      if (valid_bits == nullptr) {
+        encoder->EncoderClass::Put(block, length);
+      } else {
+        encoder->EncoderClass::PutSpaced(block, length, valid_bits, offset);
+      }
+    }
+    if (page_statistics_ != nullptr) {
+      ScopedWriteTimer timer(counters, &ColumnWriteCounters::statistics_nanos);
+      if (valid_bits == nullptr) {
+        page_statistics_->Update(block, length, 0);
+      } else {
+        const int64_t num_present = ::arrow::CountSetBits(valid_bits, offset, length);
+        page_statistics_->UpdateSpaced(block, valid_bits, offset, num_present,
+                                       length - num_present);
+        null_count -= length - num_present;
+      }
+    }
+    if (!hashes) {
+      continue;
+    }
+    if (valid_bits == nullptr) {
+      for (int i = 0; i < length; ++i) {
+        AddValueHash(BloomFilterHash<DType>(block[i], descr_));
+      }
+    } else {
+      ::arrow::internal::BitmapReader valid_bits_reader(valid_bits, offset, length);
+      for (int i = 0; i < length; ++i) {
+        if (valid_bits_reader.IsSet()) {
+          AddValueHash(BloomFilterHash<DType>(block[i], descr_));
+        }
+        valid_bits_reader.Next();
+      }
+    }
+  }
+  // The nulls of the levels that have no slot in values
+  if (page_statistics_ != nullptr) {
+    page_statistics_->Update(values, 0, null_count);
+  }
+  return encoder->EncoderClass::EstimatedDataEncodedSize();
+}
+
 template class PARQUET_TEMPLATE_EXPORT TypedColumnWriter<BooleanType>;
 template class PARQUET_TEMPLATE_EXPORT TypedColumnWriter<Int32Type>;
 template class PARQUET_TEMPLATE_EXPORT TypedColumnWriter<Int64Type>;
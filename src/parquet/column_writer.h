@@ -18,8 +18,13 @@
 #ifndef PARQUET_COLUMN_WRITER_H
 #define PARQUET_COLUMN_WRITER_H
 
+#include <deque>
+#include <memory>
+#include <utility>
 #include <vector>
 
+#include "parquet/bloom_filter.h"
+#include "parquet/hyperloglog.h"
 #include "parquet/column_page.h"
 #include "parquet/encoding.h"
 #include "parquet/metadata.h"
@@ -29,6 +34,7 @@
 #include "parquet/types.h"
 #include "parquet/util/memory.h"
 #include "parquet/util/visibility.h"
+#include "parquet/write_metrics.h"
 
 namespace arrow {
 
@@ -54,6 +60,10 @@ class PARQUET_EXPORT LevelEncoder {
   // Encodes a batch of levels from an array and returns the number of levels encoded
   int Encode(int batch_size, const int16_t* levels);
 
+  // Encodes a batch of levels of bit width 1 from the bits of a bitmap, a set bit
+  // is a level of 1, and returns the number of levels encoded
+  int EncodeBitmap(int batch_size, const uint8_t* valid_bits, int64_t valid_bits_offset);
+
   int32_t len() {
     if (encoding_ != Encoding::RLE) {
       throw ParquetException("Only implemented for RLE encoding");
@@ -73,22 +83,53 @@ class PageWriter {
  public:
   virtual ~PageWriter() {}
 
+  // If buffered_row_group is true, the pages are kept in memory and are only
+  // written to the sink, together with the column chunk metadata, on Flush
   static std::unique_ptr<PageWriter> Open(
       OutputStream* sink, Compression::type codec, ColumnChunkMetaDataBuilder* metadata,
-      ::arrow::MemoryPool* pool = ::arrow::default_memory_pool());
+      ::arrow::MemoryPool* pool = ::arrow::default_memory_pool(),
+      bool buffered_row_group = false);
 
   // The Column Writer decides if dictionary encoding is used if set and
   // if the dictionary encoding has fallen back to default encoding on reaching dictionary
   // page limit
   virtual void Close(bool has_dictionary, bool fallback) = 0;
 
+  // Append the pages kept in memory to the sink. Only buffered PageWriters
+  // defer writing, this must be called after Close for them.
+  virtual void Flush() {}
+
   virtual int64_t WriteDataPage(const CompressedDataPage& page) = 0;
 
   virtual int64_t WriteDictionaryPage(const DictionaryPage& page) = 0;
 
   virtual bool has_compressor() = 0;
 
+  // Bytes of the written pages that are kept in memory, 0 unless buffered
+  virtual int64_t memory_usage() { return 0; }
+
+  // May be called from several threads at the same time
   virtual void Compress(const Buffer& src_buffer, ResizableBuffer* dest_buffer) = 0;
+
+  // Count the pages that are written and the time spent compressing them in
+  // counters, see WriterProperties::write_metrics. The column writer of the
+  // pages adds its encoding time to them
+  virtual void set_write_counters(std::shared_ptr<ColumnWriteCounters> counters) {
+    write_counters_ = std::move(counters);
+  }
+
+  // nullptr unless set
+  ColumnWriteCounters* write_counters() const { return write_counters_.get(); }
+
+ protected:
+  std::shared_ptr<ColumnWriteCounters> write_counters_;
+};
+
+// The dictionary of a column chunk that the chunk of the same column in the
+// next row group starts from, see WriterProperties::dictionary_reuse_enabled
+class PARQUET_EXPORT ColumnDictionary {
+ public:
+  virtual ~ColumnDictionary() = default;
 };
 
 static constexpr int WRITE_BATCH_SIZE = 1000;
@@ -98,7 +139,8 @@ class PARQUET_EXPORT ColumnWriter {
                bool has_dictionary, Encoding::type encoding,
                const WriterProperties* properties);
 
-  virtual ~ColumnWriter() = default;
+  // Waits for the compression of the pages that is still running
+  virtual ~ColumnWriter();
 
   static std::shared_ptr<ColumnWriter> Make(ColumnChunkMetaDataBuilder*,
                                             std::unique_ptr<PageWriter>,
@@ -117,20 +159,73 @@ class PARQUET_EXPORT ColumnWriter {
 
   int64_t rows_written() const { return rows_written_; }
 
+  /// Start the dictionary with the entries of dictionary, which was taken
+  /// from a writer of the same column. Must be called before any value is
+  /// written, does nothing unless the column is dictionary encoded.
+  virtual void SeedDictionary(const ColumnDictionary& dictionary) = 0;
+
+  /// Keep the BYTE_ARRAY and FIXED_LEN_BYTE_ARRAY values of the dictionary in
+  /// pool instead of memory of this writer, e.g. to reuse the chunks of the
+  /// previous row group's writer of the column. The pool is cleared when the
+  /// writer is done with the dictionary, but keeps its chunks. Must be called
+  /// before the dictionary is seeded and before any value is written.
+  virtual void SetDictionaryAllocator(ChunkedAllocator* pool) = 0;
+
+  /// The dictionary of the closed column chunk if dictionary reuse is
+  /// enabled for the column and the chunk did not fall back to PLAIN,
+  /// nullptr otherwise
+  const std::shared_ptr<ColumnDictionary>& dictionary() const {
+    return closed_dictionary_;
+  }
+
+  /// Estimated size in bytes of the column chunk so far: the pages written to
+  /// the pager, the pages buffered for dictionary encoding and the encoded
+  /// values of the current page. The levels of the current page are not
+  /// counted.
+  int64_t EstimatedSize();
+
+  /// Bytes the writer holds in memory: the data pages buffered for
+  /// dictionary encoding or being compressed, the levels and values of the
+  /// current page, the dictionary and the scratch buffers, and the written
+  /// pages of a buffered row group. See WriterProperties::memory_limit
+  int64_t memory_usage();
+
   const WriterProperties* properties() { return properties_; }
 
  protected:
   virtual std::shared_ptr<Buffer> GetValuesBuffer() = 0;
 
+  // Estimated size of the values of the current page and of the dictionary
+  // page if it is not written yet
+  virtual int64_t EstimatedValuesSize() = 0;
+
+  // Bytes held by the encoder of the current page and by the dictionary
+  virtual int64_t EncoderMemoryUsage() = 0;
+
   // Serializes Dictionary Page if enabled
   virtual void WriteDictionaryPage() = 0;
 
+  // Copy of the entries of the dictionary, taken on Close
+  virtual std::shared_ptr<ColumnDictionary> CopyDictionary() = 0;
+
   // Checks if the Dictionary Page size limit is reached
   // If the limit is reached, the Dictionary and Data Pages are serialized
   // The encoding is switched to PLAIN
 
   virtual void CheckDictionarySizeLimit() = 0;
 
+  // Called at the end of every data page while dictionary encoding. Falls back
+  // to PLAIN if the dictionary does not pay off, or writes the dictionary page
+  // and the buffered pages once these reach
+  // WriterProperties::dictionary_buffered_pages_limit()
+  virtual void CheckDictionaryEncoding() = 0;
+
+  // Called while the encoding of a column chunk is still to be chosen from its
+  // first values (see WriterProperties::Builder::enable_auto_encoding), once
+  // the sample is buffered or before the first page is added. Keeps the
+  // dictionary encoding or encodes the buffered values with the chosen one
+  virtual void ChooseEncoding() = 0;
+
   // Plain-encoded statistics of the current page
   virtual EncodedStatistics GetPageStatistics() = 0;
 
@@ -144,22 +239,115 @@ class PARQUET_EXPORT ColumnWriter {
   // Serializes the Data Pages in other encoding modes
   void AddDataPage();
 
+  // Reset the levels and counts of the current page after AddDataPage
+  void FinishDataPage();
+
+  // Adds the current page once it reached the page size. The V2 pages of
+  // repeated columns must start at a record, their pages are added by
+  // AddPendingDataPage before the next value that starts one.
+  void CutDataPage();
+
+  // Adds the page that CutDataPage left pending if the mini batch of the
+  // levels starts a record
+  void AddPendingDataPage(int64_t num_levels, const int16_t* rep_levels);
+
+  // Number of the num_levels - offset levels from offset on to write in one
+  // mini batch, write_batch_size() levels extended to the next record start if
+  // the pages must start at one
+  int64_t MiniBatchSize(int64_t offset, int64_t num_levels,
+                        const int16_t* rep_levels) const;
+
+  // Header of the current page, whose data is data. The level sizes are only
+  // used by V2 pages (see WriterProperties::data_page_version)
+  CompressedDataPage MakeDataPage(const std::shared_ptr<Buffer>& data,
+                                  int64_t uncompressed_size,
+                                  const EncodedStatistics& page_stats,
+                                  int64_t definition_levels_size,
+                                  int64_t repetition_levels_size);
+
   // Serializes Data Pages
   void WriteDataPage(const CompressedDataPage& page);
 
   // Write multiple definition levels
   void WriteDefinitionLevels(int64_t num_levels, const int16_t* levels);
 
+  // Write the definition levels of a column with max_definition_level == 1 from
+  // the bits of valid_bits, a nullptr valid_bits writes levels of 1
+  void WriteDefinitionLevelBits(int64_t num_levels, const uint8_t* valid_bits,
+                                int64_t valid_bits_offset);
+
   // Write multiple repetition levels
   void WriteRepetitionLevels(int64_t num_levels, const int16_t* levels);
 
+  // Write the levels of a spaced batch (see WriteBatchSpaced) and count the
+  // present values and the values including the nulls of the lowest level. If
+  // def_levels is nullptr, the definition levels are taken from valid_bits.
+  void WriteLevelsSpaced(int64_t num_levels, const int16_t* def_levels,
+                         const int16_t* rep_levels, const uint8_t* valid_bits,
+                         int64_t valid_bits_offset, int64_t* values_to_write,
+                         int64_t* spaced_values_to_write);
+
+  // Make room for num_levels more bits in definition_level_bits_
+  void ReserveDefinitionLevelBits(int64_t num_levels);
+
+  // Throws unless the definition levels may be omitted, i.e. the column has a
+  // max_definition_level of 1 and is not repeated
+  void CheckOmittedDefinitionLevels() const;
+
+  // Whether the spaced values may have slots for nulls, i.e. the leaf or a
+  // group below its innermost repeated ancestor is optional
+  bool HasSpacedValues() const {
+    return descr_->repeated_ancestor_def_level() < descr_->max_definition_level();
+  }
+
+  // The counter of the time spent encoding values with the current encoder,
+  // which is mostly hashing while dictionary encoding
+  ScopedWriteTimer::Counter encode_counter() const {
+    return has_dictionary_ && !fallback_ ? &ColumnWriteCounters::dictionary_nanos
+                                         : &ColumnWriteCounters::encode_nanos;
+  }
+
   // RLE encode the src_buffer into dest_buffer and return the encoded size
   int64_t RleEncodeLevels(const Buffer& src_buffer, ResizableBuffer* dest_buffer,
                           int16_t max_level);
 
+  // RLE encode the definition levels in definition_level_bits_ into dest_buffer
+  // and return the encoded size
+  int64_t RleEncodeDefinitionLevelBits(ResizableBuffer* dest_buffer);
+
   // Serialize the buffered Data Pages
   void FlushBufferedDataPages();
 
+  // Serialize the Data Pages in data_pages_, without adding the current one
+  void WriteBufferedDataPages();
+
+  // Compress the page in data on the compression thread pool, see
+  // WriterProperties::page_compression_parallelism
+  void CompressDataPageAsync(const std::shared_ptr<ResizableBuffer>& data,
+                             const EncodedStatistics& page_stats,
+                             int64_t definition_levels_size,
+                             int64_t repetition_levels_size);
+
+  // Write the pages whose compression is done in the order they were
+  // started, waiting for the next one while more than max_pending are left
+  void WritePendingPages(size_t max_pending);
+
+  // Free or, if it is not owned by this writer, clear the memory of the
+  // dictionary values once the dictionary encoder is dropped
+  void ReleaseDictionaryMemory();
+
+  // Record the hash of a written value for the Bloom filter and the distinct
+  // count sketch
+  void AddValueHash(uint64_t hash);
+
+  // Whether the written values are hashed, see AddValueHash
+  bool hashes_values() const {
+    return bloom_filter_enabled_ || distinct_count_sketch_ != nullptr;
+  }
+
+  // Bloom filter of all hashes recorded with AddValueHash
+  std::unique_ptr<BloomFilter> BuildBloomFilter();
+
   ColumnChunkMetaDataBuilder* metadata_;
   const ColumnDescriptor* descr_;
 
@@ -173,6 +361,8 @@ class PARQUET_EXPORT ColumnWriter {
 
   ::arrow::MemoryPool* allocator_;
   ChunkedAllocator pool_;
+  // Holds the dictionary values, pool_ unless set with SetDictionaryAllocator
+  ChunkedAllocator* dictionary_pool_;
 
   // The total number of values stored in the data page. This is the maximum of
   // the number of encoded definition levels or encoded values. For
@@ -189,6 +379,20 @@ class PARQUET_EXPORT ColumnWriter {
   // Total number of rows written with this ColumnWriter
   int rows_written_;
 
+  // Index of the first row of the buffered page, -1 if the page started in
+  // the middle of a row
+  int64_t page_first_row_;
+
+  // rows_written_ at the start of the buffered page
+  int64_t page_start_rows_written_;
+
+  // Whether the pages are DATA_PAGE_V2 pages of a repeated column, which are
+  // only cut where a record starts
+  const bool record_aligned_pages_;
+
+  // Whether the buffered page reached its size in the middle of a record
+  bool page_cut_pending_;
+
   // Records the total number of bytes written by the serializer
   int64_t total_bytes_written_;
 
@@ -198,9 +402,28 @@ class PARQUET_EXPORT ColumnWriter {
   // Flag to infer if dictionary encoding has fallen back to PLAIN
   bool fallback_;
 
+  // Flag to check if the dictionary page was written before the chunk was
+  // closed, the data pages then are no longer buffered
+  bool dictionary_written_;
+
+  // Flag to check if the dictionary encoded values are a sample that
+  // ChooseEncoding has not decided on yet
+  bool auto_encoding_pending_;
+
+  // Flag to check if a Bloom filter of the values is written
+  bool bloom_filter_enabled_;
+
+  // Estimates the distinct values, nullptr unless enabled for the column
+  std::unique_ptr<HyperLogLog> distinct_count_sketch_;
+
   std::unique_ptr<InMemoryOutputStream> definition_levels_sink_;
   std::unique_ptr<InMemoryOutputStream> repetition_levels_sink_;
 
+  // The definition levels of columns with max_definition_level == 1 are
+  // buffered as one bit per level instead of in definition_levels_sink_
+  std::shared_ptr<ResizableBuffer> definition_level_bits_;
+  int64_t num_definition_level_bits_;
+
   std::shared_ptr<ResizableBuffer> definition_levels_rle_;
   std::shared_ptr<ResizableBuffer> repetition_levels_rle_;
 
@@ -208,9 +431,26 @@ class PARQUET_EXPORT ColumnWriter {
   std::shared_ptr<ResizableBuffer> compressed_data_;
 
   std::vector<CompressedDataPage> data_pages_;
+  // Compressed size of data_pages_
+  int64_t buffered_data_pages_size_;
+
+  // Pages that are being compressed on the thread pool, oldest first
+  struct PendingPage;
+  std::deque<std::shared_ptr<PendingPage>> pending_pages_;
+  // Uncompressed size of pending_pages_
+  int64_t pending_pages_size_;
+
+  // Hashes of the values written so far, the first num_distinct_hashes_ are
+  // sorted and unique
+  std::vector<uint64_t> bloom_filter_hashes_;
+  size_t num_distinct_hashes_;
+
+  std::shared_ptr<ColumnDictionary> closed_dictionary_;
 
  private:
   void InitSinks();
+
+  void CompactBloomFilterHashes();
 };
 
 // API to write values to a single column. This is the main client facing API.
@@ -224,7 +464,8 @@ class PARQUET_EXPORT TypedColumnWriter : public ColumnWriter {
                     const WriterProperties* properties);
 
   // Write a batch of repetition levels, definition levels, and values to the
-  // column.
+  // column. For columns with max_definition_level == 1 that are not repeated,
+  // a nullptr def_levels writes all values as present.
   void WriteBatch(int64_t num_values, const int16_t* def_levels,
                   const int16_t* rep_levels, const T* values);
 
@@ -244,6 +485,14 @@ class PARQUET_EXPORT TypedColumnWriter : public ColumnWriter {
   /// inner-most schema node is optional, the _number of rows in the lowest nesting level_
   /// also includes all values with definition_level == (max_definition_level - 1).
   ///
+  /// If optional groups lie between the leaf and its innermost repeated ancestor, as
+  /// for the fields of a nullable struct, the rows also include the entries of their
+  /// nulls. In general all entries with a definition level of at least
+  /// ColumnDescriptor::repeated_ancestor_def_level() are rows on the lowest level.
+  ///
+  /// For columns with max_definition_level == 1 that are not repeated, def_levels
+  /// may be nullptr, the definition levels are then the bits of valid_bits.
+  ///
   /// @param num_values number of levels to write.
   /// @param def_levels The Parquet definiton levels, length is num_values
   /// @param rep_levels The Parquet repetition levels, length is num_values
@@ -258,12 +507,55 @@ class PARQUET_EXPORT TypedColumnWriter : public ColumnWriter {
                         const int16_t* rep_levels, const uint8_t* valid_bits,
                         int64_t valid_bits_offset, const T* values);
 
+  /// Write a batch of values that are given as indices into a dictionary, e.g.
+  /// the indices and the dictionary of an arrow::DictionaryArray.
+  ///
+  /// The levels, valid_bits and indices follow the conventions of
+  /// WriteBatchSpaced, a nullptr valid_bits marks all values as present. While
+  /// the column is dictionary encoded, the entries of the dictionary are added
+  /// to the dictionary page once per call and the indices are written without
+  /// hashing any value.
+  void WriteBatchDictionary(int64_t num_values, const int16_t* def_levels,
+                            const int16_t* rep_levels, const uint8_t* valid_bits,
+                            int64_t valid_bits_offset, const int32_t* indices,
+                            const T* dictionary, int64_t dictionary_length);
+
+  /// BYTE_ARRAY only: write a batch of values that are given in Arrow's binary
+  /// layout, i.e. value i is data[offsets[i]:offsets[i + 1]].
+  ///
+  /// The levels, valid_bits and offsets follow the conventions of
+  /// WriteBatchSpaced, a nullptr valid_bits marks all values as present. The
+  /// encoders and statistics read the values from data, no array of ByteArray
+  /// is built for them.
+  void WriteBatchBinary(int64_t num_values, const int16_t* def_levels,
+                        const int16_t* rep_levels, const uint8_t* valid_bits,
+                        int64_t valid_bits_offset, const int32_t* offsets,
+                        const uint8_t* data);
+
+  /// BOOLEAN only: write a batch of values that are given as a bitmap, as in
+  /// Arrow's layout, from bit values_offset of values on.
+  ///
+  /// The levels and valid_bits follow the conventions of WriteBatchSpaced, a
+  /// nullptr valid_bits marks all values as present. The PLAIN encoder and the
+  /// statistics read the values from the bitmap, no array of bool is built for
+  /// them.
+  void WriteBatchBitmap(int64_t num_values, const int16_t* def_levels,
+                        const int16_t* rep_levels, const uint8_t* valid_bits,
+                        int64_t valid_bits_offset, const uint8_t* values,
+                        int64_t values_offset);
+
+  void SeedDictionary(const ColumnDictionary& dictionary) override;
+  void SetDictionaryAllocator(ChunkedAllocator* pool) override;
+
  protected:
-  std::shared_ptr<Buffer> GetValuesBuffer() override {
-    return current_encoder_->FlushValues();
-  }
+  std::shared_ptr<Buffer> GetValuesBuffer() override;
+  int64_t EstimatedValuesSize() override;
+  int64_t EncoderMemoryUsage() override;
   void WriteDictionaryPage() override;
+  std::shared_ptr<ColumnDictionary> CopyDictionary() override;
   void CheckDictionarySizeLimit() override;
+  void CheckDictionaryEncoding() override;
+  void ChooseEncoding() override;
   EncodedStatistics GetPageStatistics() override;
   EncodedStatistics GetChunkStatistics() override;
   void ResetPageStatistics() override;
@@ -277,14 +569,72 @@ class PARQUET_EXPORT TypedColumnWriter : public ColumnWriter {
                                int64_t valid_bits_offset, const T* values,
                                int64_t* num_spaced_written);
 
+  int64_t WriteMiniBatchDictionary(int64_t num_values, const int16_t* def_levels,
+                                   const int16_t* rep_levels, const uint8_t* valid_bits,
+                                   int64_t valid_bits_offset, const int32_t* indices,
+                                   const T* dictionary, int64_t dictionary_length,
+                                   int64_t* num_spaced_written);
+
+  int64_t WriteMiniBatchBinary(int64_t num_values, const int16_t* def_levels,
+                               const int16_t* rep_levels, const uint8_t* valid_bits,
+                               int64_t valid_bits_offset, const int32_t* offsets,
+                               const uint8_t* data, int64_t* num_spaced_written);
+
+  int64_t WriteMiniBatchBitmap(int64_t num_values, const int16_t* def_levels,
+                               const int16_t* rep_levels, const uint8_t* valid_bits,
+                               int64_t valid_bits_offset, const uint8_t* values,
+                               int64_t values_offset, int64_t* num_spaced_written);
+
   typedef Encoder<DType> EncoderType;
 
   // Write values to a temporary buffer before they are encoded into pages
   void WriteValues(int64_t num_values, const T* values);
   void WriteValuesSpaced(int64_t num_values, const uint8_t* valid_bits,
                          int64_t valid_bits_offset, const T* values);
+
+  // Encode num_values values, update the page statistics with them and hash
+  // them for the Bloom filter and the distinct count sketch. The values are
+  // spaced if valid_bits is not nullptr, null_count is the number of nulls of
+  // the levels. Returns the estimated size of the encoded values.
+  int64_t EncodeValues(int64_t num_values, int64_t null_count, const uint8_t* valid_bits,
+                       int64_t valid_bits_offset, const T* values);
+
+  // The single pass of EncodeValues for the class of current_encoder_, whose
+  // methods are called without going through the vtable. The steps run block
+  // by block, so that the values are read from memory once and stay cached
+  // for the statistics and the hashes.
+  template <typename EncoderClass>
+  int64_t EncodeValuesFused(EncoderClass* encoder, int64_t block_size,
+                            int64_t num_values, int64_t null_count,
+                            const uint8_t* valid_bits, int64_t valid_bits_offset,
+                            const T* values);
+
   std::unique_ptr<EncoderType> current_encoder_;
 
+  // A new encoder of the values in encoding
+  std::unique_ptr<EncoderType> MakeEncoder(Encoding::type encoding);
+
+  // Write the dictionary page and the buffered pages unless done already, and
+  // encode the following values with PLAIN
+  void FallBackToPlain();
+
+  // Number of entries of the dictionary page if it was written before the
+  // chunk was closed
+  int num_dictionary_entries_written_;
+
+  // PLAIN size of the values of the dictionary encoded pages and the size of
+  // their indices
+  int64_t dictionary_plain_size_;
+  int64_t dictionary_indices_size_;
+
+  // State of WriteBatchDictionary: the index of every entry of the dictionary
+  // in the dictionary page and their value hashes, both computed on
+  // first use, and the present values of the current mini batch
+  std::vector<int32_t> dictionary_map_;
+  std::vector<uint64_t> dictionary_hashes_;
+  std::vector<int32_t> dictionary_indices_;
+  Vector<T> dictionary_values_;
+
   typedef TypedRowGroupStatistics<DType> TypedStats;
   std::unique_ptr<TypedStats> page_statistics_;
   std::unique_ptr<TypedStats> chunk_statistics_;
@@ -299,6 +649,30 @@ typedef TypedColumnWriter<DoubleType> DoubleWriter;
 typedef TypedColumnWriter<ByteArrayType> ByteArrayWriter;
 typedef TypedColumnWriter<FLBAType> FixedLenByteArrayWriter;
 
+template <>
+void TypedColumnWriter<ByteArrayType>::WriteBatchBinary(
+    int64_t num_values, const int16_t* def_levels, const int16_t* rep_levels,
+    const uint8_t* valid_bits, int64_t valid_bits_offset, const int32_t* offsets,
+    const uint8_t* data);
+
+template <>
+int64_t TypedColumnWriter<ByteArrayType>::WriteMiniBatchBinary(
+    int64_t num_values, const int16_t* def_levels, const int16_t* rep_levels,
+    const uint8_t* valid_bits, int64_t valid_bits_offset, const int32_t* offsets,
+    const uint8_t* data, int64_t* num_spaced_written);
+
+template <>
+void TypedColumnWriter<BooleanType>::WriteBatchBitmap(
+    int64_t num_values, const int16_t* def_levels, const int16_t* rep_levels,
+    const uint8_t* valid_bits, int64_t valid_bits_offset, const uint8_t* values,
+    int64_t values_offset);
+
+template <>
+int64_t TypedColumnWriter<BooleanType>::WriteMiniBatchBitmap(
+    int64_t num_values, const int16_t* def_levels, const int16_t* rep_levels,
+    const uint8_t* valid_bits, int64_t valid_bits_offset, const uint8_t* values,
+    int64_t values_offset, int64_t* num_spaced_written);
+
 extern template class PARQUET_EXPORT TypedColumnWriter<BooleanType>;
 extern template class PARQUET_EXPORT TypedColumnWriter<Int32Type>;
 extern template class PARQUET_EXPORT TypedColumnWriter<Int64Type>;
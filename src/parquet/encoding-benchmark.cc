@@ -15,10 +15,13 @@
 // specific language governing permissions and limitations
 // under the License.
 
+#include <random>
+
 #include "benchmark/benchmark.h"
 
 #include "parquet/encoding-internal.h"
 #include "parquet/util/memory.h"
+#include "parquet/util/spacing.h"
 
 using arrow::MemoryPool;
 using arrow::default_memory_pool;
@@ -161,6 +164,83 @@ static void BM_DictDecodingInt64_literals(::benchmark::State& state) {
 
 BENCHMARK(BM_DictDecodingInt64_literals)->Range(1024, 65536);
 
+// Validity bitmap of num_values values of which null_percent percent are null
+static std::vector<uint8_t> MakeValidBits(int num_values, int null_percent,
+                                          int* null_count) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> percent(0, 99);
+  std::vector<uint8_t> valid_bits(::arrow::BitUtil::BytesForBits(num_values), 0);
+  *null_count = 0;
+  for (int i = 0; i < num_values; ++i) {
+    if (percent(gen) < null_percent) {
+      ++*null_count;
+    } else {
+      ::arrow::BitUtil::SetBit(valid_bits.data(), i);
+    }
+  }
+  return valid_bits;
+}
+
+// Arguments are the number of values and the percentage of nulls
+static void SpacedArguments(::benchmark::internal::Benchmark* b) {
+  for (int null_percent : {1, 10, 50, 90}) {
+    b->Args({65536, null_percent});
+  }
+}
+
+template <typename Type>
+static void BM_PlainDecodingSpaced(::benchmark::State& state) {
+  typedef typename Type::c_type T;
+  const auto num_values = static_cast<int>(state.range(0));
+  int null_count;
+  std::vector<uint8_t> valid_bits =
+      MakeValidBits(num_values, static_cast<int>(state.range(1)), &null_count);
+  std::vector<T> values(num_values - null_count, static_cast<T>(64));
+  PlainEncoder<Type> encoder(nullptr);
+  encoder.Put(values.data(), static_cast<int>(values.size()));
+  std::shared_ptr<Buffer> buf = encoder.FlushValues();
+
+  std::vector<T> output(num_values);
+  while (state.KeepRunning()) {
+    PlainDecoder<Type> decoder(nullptr);
+    decoder.SetData(static_cast<int>(values.size()), buf->data(),
+                    static_cast<int>(buf->size()));
+    decoder.DecodeSpaced(output.data(), num_values, null_count, valid_bits.data(), 0);
+  }
+  state.SetBytesProcessed(state.iterations() * num_values * sizeof(T));
+}
+
+BENCHMARK_TEMPLATE(BM_PlainDecodingSpaced, Int32Type)->Apply(SpacedArguments);
+BENCHMARK_TEMPLATE(BM_PlainDecodingSpaced, Int64Type)->Apply(SpacedArguments);
+BENCHMARK_TEMPLATE(BM_PlainDecodingSpaced, DoubleType)->Apply(SpacedArguments);
+
+// Spacing alone, with and without the SIMD kernels
+template <typename T, bool scalar>
+static void BM_SpaceValues(::benchmark::State& state) {
+  const auto num_values = static_cast<int>(state.range(0));
+  int null_count;
+  std::vector<uint8_t> valid_bits =
+      MakeValidBits(num_values, static_cast<int>(state.range(1)), &null_count);
+  std::vector<T> buffer(num_values, static_cast<T>(64));
+  auto data = reinterpret_cast<uint8_t*>(buffer.data());
+
+  while (state.KeepRunning()) {
+    if (scalar) {
+      internal::SpaceValuesScalar(data, static_cast<int>(sizeof(T)), num_values,
+                                  null_count, valid_bits.data(), 0);
+    } else {
+      internal::SpaceValues(buffer.data(), num_values, null_count, valid_bits.data(), 0);
+    }
+    ::benchmark::DoNotOptimize(buffer.data());
+  }
+  state.SetBytesProcessed(state.iterations() * num_values * sizeof(T));
+}
+
+BENCHMARK_TEMPLATE2(BM_SpaceValues, int32_t, true)->Apply(SpacedArguments);
+BENCHMARK_TEMPLATE2(BM_SpaceValues, int32_t, false)->Apply(SpacedArguments);
+BENCHMARK_TEMPLATE2(BM_SpaceValues, int64_t, true)->Apply(SpacedArguments);
+BENCHMARK_TEMPLATE2(BM_SpaceValues, int64_t, false)->Apply(SpacedArguments);
+
 }  // namespace benchmark
 
 }  // namespace parquet
@@ -20,8 +20,10 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <limits>
 #include <memory>
+#include <type_traits>
 #include <vector>
 
 #include "arrow/util/bit-stream-utils.h"
@@ -35,7 +37,10 @@
 #include "parquet/exception.h"
 #include "parquet/schema.h"
 #include "parquet/types.h"
+#include "parquet/util/byte-stream-split.h"
 #include "parquet/util/memory.h"
+#include "parquet/util/rle-decoder.h"
+#include "parquet/util/spacing.h"
 
 namespace parquet {
 
@@ -70,6 +75,22 @@ class PlainDecoder : public Decoder<DType> {
 
   virtual int Decode(T* buffer, int max_values);
 
+  int Skip(int num_values) override;
+
+  // BYTE_ARRAY only: decode up to max_values values into Arrow's binary
+  // layout. offsets[0] is the end offset of the previous value, the end offsets
+  // of the decoded values are written after it. out must have room for
+  // bytes_left() bytes.
+  int DecodeBinary(int max_values, int32_t* offsets, uint8_t* out);
+
+  // Number of bytes of the page that have not been decoded yet
+  int bytes_left() const { return len_; }
+
+  // The bytes of the next value in the page. For fixed-width physical types
+  // other than BOOLEAN, the values that are left are stored here contiguously
+  // in their in-memory representation
+  const uint8_t* data() const { return data_; }
+
  private:
   using Decoder<DType>::descr_;
   const uint8_t* data_;
@@ -136,6 +157,71 @@ inline int PlainDecoder<DType>::Decode(T* buffer, int max_values) {
   return max_values;
 }
 
+template <typename DType>
+inline int PlainDecoder<DType>::Skip(int num_values) {
+  num_values = std::min(num_values, num_values_);
+  const int num_bytes = num_values * static_cast<int>(sizeof(T));
+  if (len_ < num_bytes) ParquetException::EofException();
+  data_ += num_bytes;
+  len_ -= num_bytes;
+  num_values_ -= num_values;
+  return num_values;
+}
+
+template <>
+inline int PlainDecoder<ByteArrayType>::Skip(int num_values) {
+  num_values = std::min(num_values, num_values_);
+  for (int i = 0; i < num_values; ++i) {
+    if (len_ < static_cast<int>(sizeof(uint32_t))) ParquetException::EofException();
+    uint32_t len;
+    memcpy(&len, data_, sizeof(uint32_t));
+    if (len > static_cast<uint32_t>(len_) - sizeof(uint32_t)) {
+      ParquetException::EofException();
+    }
+    const int increment = static_cast<int>(sizeof(uint32_t) + len);
+    data_ += increment;
+    len_ -= increment;
+  }
+  num_values_ -= num_values;
+  return num_values;
+}
+
+template <>
+inline int PlainDecoder<FLBAType>::Skip(int num_values) {
+  num_values = std::min(num_values, num_values_);
+  const int num_bytes = num_values * type_length_;
+  if (len_ < num_bytes) ParquetException::EofException();
+  data_ += num_bytes;
+  len_ -= num_bytes;
+  num_values_ -= num_values;
+  return num_values;
+}
+
+template <>
+inline int PlainDecoder<ByteArrayType>::DecodeBinary(int max_values, int32_t* offsets,
+                                                     uint8_t* out) {
+  max_values = std::min(max_values, num_values_);
+  int32_t offset = offsets[0];
+  for (int i = 0; i < max_values; ++i) {
+    if (len_ < static_cast<int>(sizeof(uint32_t))) ParquetException::EofException();
+    uint32_t len;
+    memcpy(&len, data_, sizeof(uint32_t));
+    if (len > static_cast<uint32_t>(len_) - sizeof(uint32_t)) {
+      ParquetException::EofException();
+    }
+    memcpy(out, data_ + sizeof(uint32_t), len);
+    out += len;
+    offset += static_cast<int32_t>(len);
+    offsets[i + 1] = offset;
+
+    const int increment = static_cast<int>(sizeof(uint32_t) + len);
+    data_ += increment;
+    len_ -= increment;
+  }
+  num_values_ -= max_values;
+  return max_values;
+}
+
 template <>
 class PlainDecoder<BooleanType> : public Decoder<BooleanType> {
  public:
@@ -144,21 +230,15 @@ class PlainDecoder<BooleanType> : public Decoder<BooleanType> {
 
   virtual void SetData(int num_values, const uint8_t* data, int len) {
     num_values_ = num_values;
+    data_ = data;
+    len_ = len;
+    bit_offset_ = 0;
     bit_reader_ = ::arrow::BitReader(data, len);
   }
 
   // Two flavors of bool decoding
   int Decode(uint8_t* buffer, int max_values) {
-    max_values = std::min(max_values, num_values_);
-    bool val;
-    for (int i = 0; i < max_values; ++i) {
-      if (!bit_reader_.GetValue(1, &val)) {
-        ParquetException::EofException();
-      }
-      BitUtil::SetArrayBit(buffer, i, val);
-    }
-    num_values_ -= max_values;
-    return max_values;
+    return DecodeBitmap(buffer, 0, max_values);
   }
 
   virtual int Decode(bool* buffer, int max_values) {
@@ -167,10 +247,67 @@ class PlainDecoder<BooleanType> : public Decoder<BooleanType> {
       ParquetException::EofException();
     }
     num_values_ -= max_values;
+    bit_offset_ += max_values;
     return max_values;
   }
 
+  // Decode up to max_values values into the bits of bitmap from bit
+  // bitmap_offset on. The packed values are copied, not unpacked.
+  int DecodeBitmap(uint8_t* bitmap, int64_t bitmap_offset, int max_values) {
+    max_values = std::min(max_values, num_values_);
+    CheckBitsLeft(max_values);
+    internal::CopyBits(data_, bit_offset_, max_values, bitmap, bitmap_offset);
+    Advance(max_values);
+    return max_values;
+  }
+
+  // As DecodeBitmap, the num_values - null_count values go to the bits whose
+  // bit in valid_bits is set, see internal::SpaceBits. The bits of nulls are
+  // cleared.
+  int DecodeBitmapSpaced(uint8_t* bitmap, int64_t bitmap_offset, int num_values,
+                         int null_count, const uint8_t* valid_bits,
+                         int64_t valid_bits_offset) {
+    const int values_to_read = num_values - null_count;
+    if (values_to_read > num_values_) {
+      ParquetException::EofException();
+    }
+    CheckBitsLeft(values_to_read);
+    internal::SpaceBits(data_, bit_offset_, num_values, valid_bits, valid_bits_offset,
+                        bitmap, bitmap_offset);
+    Advance(values_to_read);
+    return num_values;
+  }
+
+  int Skip(int num_values) override {
+    num_values = std::min(num_values, num_values_);
+    CheckBitsLeft(num_values);
+    Advance(num_values);
+    return num_values;
+  }
+
  private:
+  void CheckBitsLeft(int num_bits) const {
+    if (bit_offset_ + num_bits > static_cast<int64_t>(len_) * 8) {
+      ParquetException::EofException();
+    }
+  }
+
+  // Consume num_bits bits without bit_reader_, which is then moved past them
+  void Advance(int num_bits) {
+    num_values_ -= num_bits;
+    bit_offset_ += num_bits;
+    const int byte_offset = static_cast<int>(bit_offset_ / 8);
+    bit_reader_ = ::arrow::BitReader(data_ + byte_offset, len_ - byte_offset);
+    bool unused;
+    for (int i = 0; i < static_cast<int>(bit_offset_ % 8); ++i) {
+      bit_reader_.GetValue(1, &unused);
+    }
+  }
+
+  const uint8_t* data_ = nullptr;
+  int len_ = 0;
+  // Position of the next value in data_
+  int64_t bit_offset_ = 0;
   ::arrow::BitReader bit_reader_;
 };
 
@@ -192,6 +329,16 @@ class PlainEncoder : public Encoder<DType> {
 
   std::shared_ptr<Buffer> FlushValues() override;
   void Put(const T* src, int num_values) override;
+  // Puts the runs of present values as they are instead of copying them to a
+  // temporary buffer first
+  void PutSpaced(const T* src, int num_values, const uint8_t* valid_bits,
+                 int64_t valid_bits_offset) override;
+
+  // BYTE_ARRAY only: encode num_values values in Arrow's binary layout, value i
+  // is data[offsets[i]:offsets[i + 1]]. The values whose bit in valid_bits is
+  // not set are skipped, a nullptr valid_bits marks all of them as present.
+  void PutBinary(const int32_t* offsets, const uint8_t* data, int num_values,
+                 const uint8_t* valid_bits, int64_t valid_bits_offset);
 
  protected:
   std::unique_ptr<InMemoryOutputStream> values_sink_;
@@ -268,6 +415,28 @@ class PlainEncoder<BooleanType> : public Encoder<BooleanType> {
   PLAINDECODER_BOOLEAN_PUT(const bool*, override)
   PLAINDECODER_BOOLEAN_PUT(const std::vector<bool>&, )
 
+  // Put the num_values values of the bitmap bits from bit bits_offset on. As in
+  // PutSpaced, the values whose bit in valid_bits is not set are skipped, a
+  // nullptr valid_bits marks all of them as present.
+  void PutBitmap(const uint8_t* bits, int64_t bits_offset, int num_values,
+                 const uint8_t* valid_bits, int64_t valid_bits_offset) {
+    ::arrow::internal::BitmapReader bits_reader(bits, bits_offset, num_values);
+    for (int i = 0; i < num_values; i++, bits_reader.Next()) {
+      if (valid_bits != nullptr && !BitUtil::GetBit(valid_bits, valid_bits_offset + i)) {
+        continue;
+      }
+      if (bits_available_ == 0) {
+        bits_available_ = static_cast<int>(bits_buffer_->size()) * 8;
+      }
+      bit_writer_->PutValue(bits_reader.IsSet(), 1);
+      if (--bits_available_ == 0) {
+        bit_writer_->Flush();
+        values_sink_->Write(bit_writer_->buffer(), bit_writer_->bytes_written());
+        bit_writer_->Clear();
+      }
+    }
+  }
+
  protected:
   int bits_available_;
   std::unique_ptr<::arrow::BitWriter> bit_writer_;
@@ -299,6 +468,21 @@ inline void PlainEncoder<ByteArrayType>::Put(const ByteArray* src, int num_value
   }
 }
 
+template <>
+inline void PlainEncoder<ByteArrayType>::PutBinary(const int32_t* offsets,
+                                                   const uint8_t* data, int num_values,
+                                                   const uint8_t* valid_bits,
+                                                   int64_t valid_bits_offset) {
+  for (int i = 0; i < num_values; ++i) {
+    if (valid_bits != nullptr && !BitUtil::GetBit(valid_bits, valid_bits_offset + i)) {
+      continue;
+    }
+    const auto len = static_cast<uint32_t>(offsets[i + 1] - offsets[i]);
+    values_sink_->Write(reinterpret_cast<const uint8_t*>(&len), sizeof(uint32_t));
+    values_sink_->Write(data + offsets[i], len);
+  }
+}
+
 template <>
 inline void PlainEncoder<FLBAType>::Put(const FixedLenByteArray* src, int num_values) {
   for (int i = 0; i < num_values; ++i) {
@@ -311,6 +495,164 @@ inline void PlainEncoder<FLBAType>::Put(const FixedLenByteArray* src, int num_va
   }
 }
 
+template <typename DType>
+inline void PlainEncoder<DType>::PutSpaced(const T* src, int num_values,
+                                           const uint8_t* valid_bits,
+                                           int64_t valid_bits_offset) {
+  ::arrow::internal::BitmapReader valid_bits_reader(valid_bits, valid_bits_offset,
+                                                    num_values);
+  int run_start = 0;
+  for (int i = 0; i < num_values; i++) {
+    if (!valid_bits_reader.IsSet()) {
+      if (i > run_start) {
+        PlainEncoder<DType>::Put(src + run_start, i - run_start);
+      }
+      run_start = i + 1;
+    }
+    valid_bits_reader.Next();
+  }
+  if (num_values > run_start) {
+    PlainEncoder<DType>::Put(src + run_start, num_values - run_start);
+  }
+}
+
+// ----------------------------------------------------------------------
+// Encoding::BYTE_STREAM_SPLIT encoder and decoder implementations
+//
+// Byte k of every value of a page is stored in stream k, the streams of the
+// sizeof(T) bytes follow each other. The bytes within a stream are more alike
+// than the values, e.g. the sign and exponent bytes of floating point data,
+// which helps the compression of the page.
+
+template <typename DType>
+class ByteStreamSplitEncoder : public Encoder<DType> {
+ public:
+  typedef typename DType::c_type T;
+
+  explicit ByteStreamSplitEncoder(
+      const ColumnDescriptor* descr,
+      ::arrow::MemoryPool* pool = ::arrow::default_memory_pool())
+      : Encoder<DType>(descr, Encoding::BYTE_STREAM_SPLIT, pool),
+        values_sink_(new InMemoryOutputStream(pool)) {}
+
+  int64_t EstimatedDataEncodedSize() override { return values_sink_->Tell(); }
+
+  // The values are buffered as they are and are only split here
+  std::shared_ptr<Buffer> FlushValues() override {
+    std::shared_ptr<Buffer> values = values_sink_->GetBuffer();
+    values_sink_.reset(new InMemoryOutputStream(this->pool_));
+    std::shared_ptr<PoolBuffer> buffer = AllocateBuffer(this->pool_, values->size());
+    internal::ByteStreamSplitEncode(values->data(), static_cast<int>(sizeof(T)),
+                                    values->size() / static_cast<int64_t>(sizeof(T)),
+                                    buffer->mutable_data());
+    return buffer;
+  }
+
+  void Put(const T* src, int num_values) override {
+    values_sink_->Write(reinterpret_cast<const uint8_t*>(src), num_values * sizeof(T));
+  }
+
+ private:
+  std::unique_ptr<InMemoryOutputStream> values_sink_;
+};
+
+template <typename DType>
+class ByteStreamSplitDecoder : public Decoder<DType> {
+ public:
+  typedef typename DType::c_type T;
+  using Decoder<DType>::num_values_;
+
+  explicit ByteStreamSplitDecoder(const ColumnDescriptor* descr)
+      : Decoder<DType>(descr, Encoding::BYTE_STREAM_SPLIT),
+        data_(nullptr),
+        num_encoded_values_(0),
+        num_decoded_values_(0) {}
+
+  void SetData(int num_values, const uint8_t* data, int len) override {
+    num_values_ = num_values;
+    data_ = data;
+    // num_values includes the nulls of the page, the streams are as long as
+    // the number of values that are stored
+    num_encoded_values_ = len / static_cast<int>(sizeof(T));
+    num_decoded_values_ = 0;
+  }
+
+  int Decode(T* buffer, int max_values) override {
+    max_values = NumValuesToRead(max_values);
+    internal::ByteStreamSplitDecode(data_ + num_decoded_values_,
+                                    static_cast<int>(sizeof(T)), max_values,
+                                    num_encoded_values_,
+                                    reinterpret_cast<uint8_t*>(buffer));
+    num_decoded_values_ += max_values;
+    num_values_ -= max_values;
+    return max_values;
+  }
+
+  int Skip(int num_values) override {
+    num_values = NumValuesToRead(num_values);
+    num_decoded_values_ += num_values;
+    num_values_ -= num_values;
+    return num_values;
+  }
+
+ private:
+  int NumValuesToRead(int num_values) const {
+    num_values = std::min(num_values, num_values_);
+    if (num_values > num_encoded_values_ - num_decoded_values_) {
+      ParquetException::EofException();
+    }
+    return num_values;
+  }
+
+  const uint8_t* data_;
+  int num_encoded_values_;
+  int num_decoded_values_;
+};
+
+// BYTE_STREAM_SPLIT is defined for FLOAT and DOUBLE
+
+template <typename DType>
+inline std::unique_ptr<Encoder<DType>> MakeByteStreamSplitEncoder(
+    const ColumnDescriptor* descr, ::arrow::MemoryPool* pool) {
+  throw ParquetException("BYTE_STREAM_SPLIT encoding is only supported for FLOAT "
+                         "and DOUBLE");
+}
+
+template <>
+inline std::unique_ptr<Encoder<FloatType>> MakeByteStreamSplitEncoder<FloatType>(
+    const ColumnDescriptor* descr, ::arrow::MemoryPool* pool) {
+  return std::unique_ptr<Encoder<FloatType>>(
+      new ByteStreamSplitEncoder<FloatType>(descr, pool));
+}
+
+template <>
+inline std::unique_ptr<Encoder<DoubleType>> MakeByteStreamSplitEncoder<DoubleType>(
+    const ColumnDescriptor* descr, ::arrow::MemoryPool* pool) {
+  return std::unique_ptr<Encoder<DoubleType>>(
+      new ByteStreamSplitEncoder<DoubleType>(descr, pool));
+}
+
+template <typename DType>
+inline std::unique_ptr<Decoder<DType>> MakeByteStreamSplitDecoder(
+    const ColumnDescriptor* descr) {
+  throw ParquetException("BYTE_STREAM_SPLIT encoding is only supported for FLOAT "
+                         "and DOUBLE");
+}
+
+template <>
+inline std::unique_ptr<Decoder<FloatType>> MakeByteStreamSplitDecoder<FloatType>(
+    const ColumnDescriptor* descr) {
+  return std::unique_ptr<Decoder<FloatType>>(
+      new ByteStreamSplitDecoder<FloatType>(descr));
+}
+
+template <>
+inline std::unique_ptr<Decoder<DoubleType>> MakeByteStreamSplitDecoder<DoubleType>(
+    const ColumnDescriptor* descr) {
+  return std::unique_ptr<Decoder<DoubleType>>(
+      new ByteStreamSplitDecoder<DoubleType>(descr));
+}
+
 // ----------------------------------------------------------------------
 // Dictionary encoding and decoding
 
@@ -325,61 +667,135 @@ class DictionaryDecoder : public Decoder<Type> {
   explicit DictionaryDecoder(const ColumnDescriptor* descr,
                              ::arrow::MemoryPool* pool = ::arrow::default_memory_pool())
       : Decoder<Type>(descr, Encoding::RLE_DICTIONARY),
-        dictionary_(0, pool),
-        byte_array_data_(AllocateBuffer(pool, 0)) {}
+        pool_(pool),
+        dictionary_(nullptr),
+        dictionary_length_(0) {}
 
   // Perform type-specific initiatialization
   void SetDict(Decoder<Type>* dictionary);
 
+  // Use a dictionary that has been decoded before, e.g. by another reader of
+  // the same column chunk. The buffers are shared rather than copied
+  void SetDict(const DecodedDictionary& dictionary) {
+    decoded_dictionary_ = dictionary;
+    dictionary_ = reinterpret_cast<const T*>(dictionary.values->data());
+    dictionary_length_ = dictionary.num_values;
+  }
+
+  const DecodedDictionary& decoded_dictionary() const { return decoded_dictionary_; }
+
   void SetData(int num_values, const uint8_t* data, int len) override {
     num_values_ = num_values;
     if (len == 0) return;
     uint8_t bit_width = *data;
     ++data;
     --len;
-    idx_decoder_ = ::arrow::RleDecoder(data, len, bit_width);
+    idx_decoder_.Reset(data, len, bit_width);
   }
 
   int Decode(T* buffer, int max_values) override {
     max_values = std::min(max_values, num_values_);
-    int decoded_values =
-        idx_decoder_.GetBatchWithDict(dictionary_.data(), buffer, max_values);
+    int decoded_values = 0;
+    if (dictionary_length_ == 1) {
+      // All the valid indices are 0, the values are filled without lookups
+      decoded_values = idx_decoder_.SkipEqual(0, max_values);
+      std::fill(buffer, buffer + decoded_values, dictionary_[0]);
+    }
+    decoded_values += idx_decoder_.GetBatchWithDict(dictionary_, dictionary_length_,
+                                                    buffer + decoded_values,
+                                                    max_values - decoded_values);
+    if (decoded_values != max_values) {
+      ParquetException::EofException();
+    }
+    num_values_ -= max_values;
+    return max_values;
+  }
+
+  // Skips the indices without looking them up, whole runs of repeated
+  // indices at once
+  int Skip(int num_values) override {
+    num_values = std::min(num_values, num_values_);
+    if (idx_decoder_.Skip(num_values) != num_values) {
+      ParquetException::EofException();
+    }
+    num_values_ -= num_values;
+    return num_values;
+  }
+
+  // Decode up to max_values dictionary indices without looking them up, for
+  // readers that pass the dictionary through
+  int DecodeIndices(int32_t* indices, int max_values) {
+    max_values = std::min(max_values, num_values_);
+    int decoded_values = idx_decoder_.GetBatch(indices, max_values);
     if (decoded_values != max_values) {
       ParquetException::EofException();
     }
+    for (int i = 0; i < max_values; ++i) {
+      if (indices[i] < 0 || indices[i] >= dictionary_length_) {
+        throw ParquetException("Dictionary index out of bounds");
+      }
+    }
     num_values_ -= max_values;
     return max_values;
   }
 
-  int DecodeSpaced(T* buffer, int num_values, int null_count, const uint8_t* valid_bits,
-                   int64_t valid_bits_offset) override {
-    int decoded_values =
-        idx_decoder_.GetBatchWithDictSpaced(dictionary_.data(), buffer, num_values,
-                                            null_count, valid_bits, valid_bits_offset);
-    if (decoded_values != num_values) {
+  // Decode up to max_values dictionary indices as up to max_runs runs of
+  // equal indices, indices[i] repeated run_lengths[i] times, for aggregations
+  // that take one step per run. Stores the number of values decoded in
+  // num_values and returns the number of runs
+  int DecodeIndexRuns(int max_values, int max_runs, int32_t* indices,
+                      int32_t* run_lengths, int* num_values) {
+    max_values = std::min(max_values, num_values_);
+    const int num_runs =
+        idx_decoder_.GetRuns(indices, run_lengths, max_runs, max_values, num_values);
+    if (*num_values != max_values && num_runs < max_runs) {
       ParquetException::EofException();
     }
-    return decoded_values;
+    for (int i = 0; i < num_runs; ++i) {
+      if (indices[i] < 0 || indices[i] >= dictionary_length_) {
+        throw ParquetException("Dictionary index out of bounds");
+      }
+    }
+    num_values_ -= *num_values;
+    return num_runs;
   }
 
+  const T* dictionary() const { return dictionary_; }
+  int dictionary_length() const { return dictionary_length_; }
+
  private:
   using Decoder<Type>::num_values_;
+  using Decoder<Type>::descr_;
+
+  // Decode the values of dictionary into a new buffer
+  T* DecodeValues(Decoder<Type>* dictionary) {
+    const int num_dictionary_values = dictionary->values_left();
+    std::shared_ptr<PoolBuffer> values =
+        AllocateBuffer(pool_, num_dictionary_values * sizeof(T));
+    T* result = reinterpret_cast<T*>(values->mutable_data());
+    dictionary->Decode(result, num_dictionary_values);
+    decoded_dictionary_.values = values;
+    decoded_dictionary_.byte_array_data = nullptr;
+    decoded_dictionary_.num_values = num_dictionary_values;
+    dictionary_ = result;
+    dictionary_length_ = num_dictionary_values;
+    return result;
+  }
 
-  // Only one is set.
-  Vector<T> dictionary_;
+  ::arrow::MemoryPool* pool_;
 
-  // Data that contains the byte array data (byte_array_dictionary_ just has the
-  // pointers).
-  std::shared_ptr<PoolBuffer> byte_array_data_;
+  // The values buffer holds the dictionary, the byte_array_data buffer the
+  // bytes of BYTE_ARRAY and FIXED_LEN_BYTE_ARRAY values that it points to
+  DecodedDictionary decoded_dictionary_;
+  const T* dictionary_;
+  int dictionary_length_;
 
-  ::arrow::RleDecoder idx_decoder_;
+  RleBitPackedDecoder idx_decoder_;
 };
 
 template <typename Type>
 inline void DictionaryDecoder<Type>::SetDict(Decoder<Type>* dictionary) {
-  int num_dictionary_values = dictionary->values_left();
-  dictionary_.Resize(num_dictionary_values);
-  dictionary->Decode(&dictionary_[0], num_dictionary_values);
+  DecodeValues(dictionary);
 }
 
 template <>
@@ -390,40 +806,40 @@ inline void DictionaryDecoder<BooleanType>::SetDict(Decoder<BooleanType>* dictio
 template <>
 inline void DictionaryDecoder<ByteArrayType>::SetDict(
     Decoder<ByteArrayType>* dictionary) {
-  int num_dictionary_values = dictionary->values_left();
-  dictionary_.Resize(num_dictionary_values);
-  dictionary->Decode(&dictionary_[0], num_dictionary_values);
+  ByteArray* values = DecodeValues(dictionary);
+  const int num_dictionary_values = dictionary_length_;
 
   int total_size = 0;
   for (int i = 0; i < num_dictionary_values; ++i) {
-    total_size += dictionary_[i].len;
+    total_size += values[i].len;
   }
-  PARQUET_THROW_NOT_OK(byte_array_data_->Resize(total_size, false));
+  std::shared_ptr<PoolBuffer> byte_array_data = AllocateBuffer(pool_, total_size);
   int offset = 0;
 
-  uint8_t* bytes_data = byte_array_data_->mutable_data();
+  uint8_t* bytes_data = byte_array_data->mutable_data();
   for (int i = 0; i < num_dictionary_values; ++i) {
-    memcpy(bytes_data + offset, dictionary_[i].ptr, dictionary_[i].len);
-    dictionary_[i].ptr = bytes_data + offset;
-    offset += dictionary_[i].len;
+    memcpy(bytes_data + offset, values[i].ptr, values[i].len);
+    values[i].ptr = bytes_data + offset;
+    offset += values[i].len;
   }
+  decoded_dictionary_.byte_array_data = byte_array_data;
 }
 
 template <>
 inline void DictionaryDecoder<FLBAType>::SetDict(Decoder<FLBAType>* dictionary) {
-  int num_dictionary_values = dictionary->values_left();
-  dictionary_.Resize(num_dictionary_values);
-  dictionary->Decode(&dictionary_[0], num_dictionary_values);
+  FixedLenByteArray* values = DecodeValues(dictionary);
+  const int num_dictionary_values = dictionary_length_;
 
   int fixed_len = descr_->type_length();
   int total_size = num_dictionary_values * fixed_len;
 
-  PARQUET_THROW_NOT_OK(byte_array_data_->Resize(total_size, false));
-  uint8_t* bytes_data = byte_array_data_->mutable_data();
+  std::shared_ptr<PoolBuffer> byte_array_data = AllocateBuffer(pool_, total_size);
+  uint8_t* bytes_data = byte_array_data->mutable_data();
   for (int32_t i = 0, offset = 0; i < num_dictionary_values; ++i, offset += fixed_len) {
-    memcpy(bytes_data + offset, dictionary_[i].ptr, fixed_len);
-    dictionary_[i].ptr = bytes_data + offset;
+    memcpy(bytes_data + offset, values[i].ptr, fixed_len);
+    values[i].ptr = bytes_data + offset;
   }
+  decoded_dictionary_.byte_array_data = byte_array_data;
 }
 
 // ----------------------------------------------------------------------
@@ -438,6 +854,15 @@ static constexpr int INITIAL_HASH_TABLE_SIZE = 1 << 10;
 typedef int32_t hash_slot_t;
 static constexpr hash_slot_t HASH_SLOT_EMPTY = std::numeric_limits<int32_t>::max();
 
+// A slot of the hash table holds the index of a dictionary entry in its lower
+// 32 bits and the hash of the entry in its upper 32 bits, so that most
+// mismatches are rejected without comparing the values.
+typedef int64_t hash_tagged_slot_t;
+static constexpr hash_tagged_slot_t HASH_TAGGED_SLOT_EMPTY = HASH_SLOT_EMPTY;
+
+// Number of values hashed at once before they are looked up
+static constexpr int HASH_BATCH_SIZE = 256;
+
 // The maximum load factor for the hash table before resizing.
 static constexpr double MAX_HASH_LOAD = 0.7;
 
@@ -461,7 +886,7 @@ class DictEncoder : public Encoder<DType> {
         hash_slots_(0, allocator),
         dict_encoded_size_(0),
         type_length_(desc->type_length()) {
-    hash_slots_.Assign(hash_table_size_, HASH_SLOT_EMPTY);
+    hash_slots_.Assign(hash_table_size_, HASH_TAGGED_SLOT_EMPTY);
     if (!::arrow::CpuInfo::initialized()) {
       ::arrow::CpuInfo::Init();
     }
@@ -503,13 +928,80 @@ class DictEncoder : public Encoder<DType> {
   int WriteIndices(uint8_t* buffer, int buffer_len);
 
   int hash_table_size() { return hash_table_size_; }
+
+  /// Bytes held by the hash table, the unique values and the buffered
+  /// indices. The data of variable-length values lives in the ChunkedAllocator
+  /// and is not included.
+  int64_t memory_usage() const {
+    return static_cast<int64_t>(hash_table_size_) *
+               static_cast<int64_t>(sizeof(hash_tagged_slot_t)) +
+           static_cast<int64_t>(uniques_.capacity() * sizeof(T)) +
+           static_cast<int64_t>(buffered_indices_.capacity() * sizeof(int));
+  }
+
+  /// Grows the hash table so that num_entries dictionary entries fit in it
+  /// without rehashing, e.g. when the cardinality of the values is known.
+  void Reserve(int num_entries);
+
+  /// Starts the dictionary with the entries of other, in the same order, e.g.
+  /// those of the previous column chunk. The hash table is copied rather than
+  /// rebuilt, so the entries are not hashed again. Must be called before any
+  /// value is put.
+  void CopyDictionary(const DictEncoder<DType>& other);
+
   int dict_encoded_size() { return dict_encoded_size_; }
   /// Clears all the indices (but leaves the dictionary).
   void ClearIndices() { buffered_indices_.clear(); }
 
   /// Encode value. Note that this does not actually write any data, just
   /// buffers the value's index to be written later.
-  void Put(const T& value);
+  void Put(const T& value) { buffered_indices_.push_back(GetOrInsert(value)); }
+
+  /// Adds the values that are not in the dictionary yet and stores the index of
+  /// values[i] in the dictionary in indices[i]. Does not buffer any index.
+  void PutDictionary(const T* values, int num_values, int32_t* indices) {
+    Reserve(num_entries() + num_values);
+    int hashes[HASH_BATCH_SIZE];
+    for (int offset = 0; offset < num_values; offset += HASH_BATCH_SIZE) {
+      const int batch_size = std::min(HASH_BATCH_SIZE, num_values - offset);
+      HashBatch(values + offset, batch_size, hashes);
+      for (int i = 0; i < batch_size; i++) {
+        indices[offset + i] = GetOrInsert(values[offset + i], hashes[i]);
+      }
+    }
+  }
+
+  /// Buffers indices into the dictionary, e.g. the ones returned by
+  /// PutDictionary, without looking up any value.
+  void PutIndices(const int32_t* indices, int num_values) {
+    buffered_indices_.insert(buffered_indices_.end(), indices, indices + num_values);
+  }
+
+  /// The size the values of the buffered indices take up in PLAIN encoding.
+  int64_t PlainEncodedSize() const;
+
+  int num_buffered_values() const { return static_cast<int>(buffered_indices_.size()); }
+
+  const std::vector<int>& buffered_indices() const { return buffered_indices_; }
+
+  /// Copies the values of the buffered indices to out, which has room for
+  /// num_buffered_values(). BYTE_ARRAY and FIXED_LEN_BYTE_ARRAY values point
+  /// into the dictionary.
+  void GetBufferedValues(T* out) const {
+    for (size_t i = 0; i < buffered_indices_.size(); i++) {
+      out[i] = uniques_[buffered_indices_[i]];
+    }
+  }
+
+  /// Puts the values of the buffered indices into encoder and clears them,
+  /// e.g. to write them in another encoding.
+  void PutBufferedValues(Encoder<DType>* encoder) {
+    const int num_values = num_buffered_values();
+    std::unique_ptr<T[]> values(new T[num_values]);
+    GetBufferedValues(values.get());
+    encoder->Put(values.get(), num_values);
+    ClearIndices();
+  }
 
   std::shared_ptr<Buffer> FlushValues() override {
     std::shared_ptr<PoolBuffer> buffer =
@@ -522,8 +1014,13 @@ class DictEncoder : public Encoder<DType> {
   }
 
   void Put(const T* values, int num_values) override {
-    for (int i = 0; i < num_values; i++) {
-      Put(values[i]);
+    int hashes[HASH_BATCH_SIZE];
+    for (int offset = 0; offset < num_values; offset += HASH_BATCH_SIZE) {
+      const int batch_size = std::min(HASH_BATCH_SIZE, num_values - offset);
+      HashBatch(values + offset, batch_size, hashes);
+      for (int i = 0; i < batch_size; i++) {
+        buffered_indices_.push_back(GetOrInsert(values[offset + i], hashes[i]));
+      }
     }
   }
 
@@ -539,6 +1036,11 @@ class DictEncoder : public Encoder<DType> {
     }
   }
 
+  /// BYTE_ARRAY only: encode values in Arrow's binary layout, see
+  /// PlainEncoder::PutBinary. The values are hashed in place.
+  void PutBinary(const int32_t* offsets, const uint8_t* data, int num_values,
+                 const uint8_t* valid_bits, int64_t valid_bits_offset);
+
   /// Writes out the encoded dictionary to buffer. buffer must be preallocated to
   /// dict_encoded_size() bytes.
   void WriteDict(uint8_t* buffer);
@@ -563,8 +1065,9 @@ class DictEncoder : public Encoder<DType> {
 
   // We use a fixed-size hash table with linear probing
   //
-  // These values correspond to the uniques_ array
-  Vector<hash_slot_t> hash_slots_;
+  // The indices in these slots correspond to the uniques_ array, see
+  // hash_tagged_slot_t
+  Vector<hash_tagged_slot_t> hash_slots_;
 
   /// Indices that have not yet be written out by WriteIndices().
   std::vector<int> buffered_indices_;
@@ -584,6 +1087,32 @@ class DictEncoder : public Encoder<DType> {
   /// Hash function for mapping a value to a bucket.
   inline int Hash(const T& value) const;
 
+  /// Hashes all values up front so that hashing does not wait on the probes
+  void HashBatch(const T* values, int num_values, int* hashes) const {
+    for (int i = 0; i < num_values; i++) {
+      hashes[i] = Hash(values[i]);
+    }
+  }
+
+  static hash_tagged_slot_t MakeSlot(hash_slot_t index, int hash) {
+    return static_cast<hash_tagged_slot_t>(
+        (static_cast<uint64_t>(static_cast<uint32_t>(hash)) << 32) |
+        static_cast<uint32_t>(index));
+  }
+  static hash_slot_t SlotIndex(hash_tagged_slot_t slot) {
+    return static_cast<hash_slot_t>(static_cast<uint64_t>(slot) & 0xFFFFFFFF);
+  }
+  static int SlotHash(hash_tagged_slot_t slot) {
+    return static_cast<int>(static_cast<uint32_t>(static_cast<uint64_t>(slot) >> 32));
+  }
+
+  /// Index of value in the dictionary, adds it if it is not present yet
+  hash_slot_t GetOrInsert(const T& value) { return GetOrInsert(value, Hash(value)); }
+  inline hash_slot_t GetOrInsert(const T& value, int hash);
+
+  /// Rehashes the entries into a table of new_size slots
+  void ResizeTable(int new_size);
+
   /// Adds value to the hash table and updates dict_encoded_size_
   void AddDictKey(const T& value);
 };
@@ -615,6 +1144,13 @@ inline bool DictEncoder<DType>::SlotDifferent(const typename DType::c_type& v,
   return v != uniques_[slot];
 }
 
+template <>
+inline bool DictEncoder<ByteArrayType>::SlotDifferent(const ByteArray& v,
+                                                      hash_slot_t slot) {
+  const ByteArray& unique = uniques_[slot];
+  return v.len != unique.len || (v.len > 0 && 0 != memcmp(v.ptr, unique.ptr, v.len));
+}
+
 template <>
 inline bool DictEncoder<FLBAType>::SlotDifferent(const FixedLenByteArray& v,
                                                  hash_slot_t slot) {
@@ -622,66 +1158,91 @@ inline bool DictEncoder<FLBAType>::SlotDifferent(const FixedLenByteArray& v,
 }
 
 template <typename DType>
-inline void DictEncoder<DType>::Put(const typename DType::c_type& v) {
-  int j = Hash(v) & mod_bitmask_;
-  hash_slot_t index = hash_slots_[j];
-
-  // Find an empty slot
-  while (HASH_SLOT_EMPTY != index && SlotDifferent(v, index)) {
+inline hash_slot_t DictEncoder<DType>::GetOrInsert(const typename DType::c_type& v,
+                                                   int hash) {
+  int j = hash & mod_bitmask_;
+  hash_tagged_slot_t slot = hash_slots_[j];
+
+  // Find an empty slot, only the values with the same hash are compared
+  while (HASH_TAGGED_SLOT_EMPTY != slot &&
+         (SlotHash(slot) != hash || SlotDifferent(v, SlotIndex(slot)))) {
     // Linear probing
     ++j;
     if (j == hash_table_size_) j = 0;
-    index = hash_slots_[j];
+    slot = hash_slots_[j];
   }
 
-  if (index == HASH_SLOT_EMPTY) {
-    // Not in the hash table, so we insert it now
-    index = static_cast<hash_slot_t>(uniques_.size());
-    hash_slots_[j] = index;
-    AddDictKey(v);
-
-    if (ARROW_PREDICT_FALSE(static_cast<int>(uniques_.size()) >
-                            hash_table_size_ * MAX_HASH_LOAD)) {
-      DoubleTableSize();
-    }
+  if (slot != HASH_TAGGED_SLOT_EMPTY) {
+    return SlotIndex(slot);
   }
 
-  buffered_indices_.push_back(index);
+  // Not in the hash table, so we insert it now
+  const auto index = static_cast<hash_slot_t>(uniques_.size());
+  hash_slots_[j] = MakeSlot(index, hash);
+  AddDictKey(v);
+
+  if (ARROW_PREDICT_FALSE(static_cast<int>(uniques_.size()) >
+                          hash_table_size_ * MAX_HASH_LOAD)) {
+    DoubleTableSize();
+  }
+  return index;
 }
 
 template <typename DType>
 inline void DictEncoder<DType>::DoubleTableSize() {
-  int new_size = hash_table_size_ * 2;
-  Vector<hash_slot_t> new_hash_slots(0, allocator_);
-  new_hash_slots.Assign(new_size, HASH_SLOT_EMPTY);
-  hash_slot_t index, slot;
-  int j;
-  for (int i = 0; i < hash_table_size_; ++i) {
-    index = hash_slots_[i];
+  ResizeTable(hash_table_size_ * 2);
+}
+
+template <typename DType>
+inline void DictEncoder<DType>::Reserve(int num_entries) {
+  int new_size = hash_table_size_;
+  while (num_entries > new_size * MAX_HASH_LOAD) {
+    new_size *= 2;
+  }
+  if (new_size != hash_table_size_) {
+    ResizeTable(new_size);
+  }
+  uniques_.reserve(num_entries);
+}
 
-    if (index == HASH_SLOT_EMPTY) {
+template <typename DType>
+inline void DictEncoder<DType>::CopyDictionary(const DictEncoder<DType>& other) {
+  DCHECK_EQ(0, num_entries());
+  DCHECK(buffered_indices_.empty());
+  hash_table_size_ = other.hash_table_size_;
+  mod_bitmask_ = other.mod_bitmask_;
+  hash_slots_.Resize(other.hash_slots_.size());
+  std::copy(other.hash_slots_.data(),
+            other.hash_slots_.data() + other.hash_slots_.size(), &hash_slots_[0]);
+  uniques_.reserve(other.uniques_.size());
+  for (const T& value : other.uniques_) {
+    AddDictKey(value);
+  }
+}
+
+template <typename DType>
+inline void DictEncoder<DType>::ResizeTable(int new_size) {
+  Vector<hash_tagged_slot_t> new_hash_slots(0, allocator_);
+  new_hash_slots.Assign(new_size, HASH_TAGGED_SLOT_EMPTY);
+  const int new_mod_bitmask = new_size - 1;
+  for (int i = 0; i < hash_table_size_; ++i) {
+    const hash_tagged_slot_t slot = hash_slots_[i];
+    if (slot == HASH_TAGGED_SLOT_EMPTY) {
       continue;
     }
 
-    // Compute the hash value mod the new table size to start looking for an
-    // empty slot
-    const typename DType::c_type& v = uniques_[index];
-
-    // Find an empty slot in the new hash table
-    j = Hash(v) & (new_size - 1);
-    slot = new_hash_slots[j];
-    while (HASH_SLOT_EMPTY != slot && SlotDifferent(v, slot)) {
+    // The entries are distinct and their hash is in the slot, so neither
+    // the values are hashed again nor compared
+    int j = SlotHash(slot) & new_mod_bitmask;
+    while (HASH_TAGGED_SLOT_EMPTY != new_hash_slots[j]) {
       ++j;
       if (j == new_size) j = 0;
-      slot = new_hash_slots[j];
     }
-
-    // Copy the old slot index to the new hash table
-    new_hash_slots[j] = index;
+    new_hash_slots[j] = slot;
   }
 
   hash_table_size_ = new_size;
-  mod_bitmask_ = new_size - 1;
+  mod_bitmask_ = new_mod_bitmask;
 
   hash_slots_.Swap(new_hash_slots);
 }
@@ -730,6 +1291,30 @@ inline void DictEncoder<BooleanType>::WriteDict(uint8_t* buffer) {
   }
 }
 
+template <typename DType>
+inline int64_t DictEncoder<DType>::PlainEncodedSize() const {
+  return static_cast<int64_t>(buffered_indices_.size() * sizeof(T));
+}
+
+template <>
+inline int64_t DictEncoder<BooleanType>::PlainEncodedSize() const {
+  return ::arrow::BitUtil::BytesForBits(static_cast<int64_t>(buffered_indices_.size()));
+}
+
+template <>
+inline int64_t DictEncoder<ByteArrayType>::PlainEncodedSize() const {
+  int64_t size = 0;
+  for (int index : buffered_indices_) {
+    size += sizeof(uint32_t) + uniques_[index].len;
+  }
+  return size;
+}
+
+template <>
+inline int64_t DictEncoder<FLBAType>::PlainEncodedSize() const {
+  return static_cast<int64_t>(buffered_indices_.size()) * type_length_;
+}
+
 // ByteArray and FLBA already have the dictionary encoded in their data heaps
 template <>
 inline void DictEncoder<ByteArrayType>::WriteDict(uint8_t* buffer) {
@@ -755,6 +1340,28 @@ inline void DictEncoder<FLBAType>::WriteDict(uint8_t* buffer) {
   }
 }
 
+template <>
+inline void DictEncoder<ByteArrayType>::PutBinary(const int32_t* offsets,
+                                                  const uint8_t* data, int num_values,
+                                                  const uint8_t* valid_bits,
+                                                  int64_t valid_bits_offset) {
+  // Gather the present values so that they are hashed in batches
+  ByteArray values[HASH_BATCH_SIZE];
+  int batch_size = 0;
+  for (int i = 0; i < num_values; ++i) {
+    if (valid_bits != nullptr && !BitUtil::GetBit(valid_bits, valid_bits_offset + i)) {
+      continue;
+    }
+    values[batch_size++] =
+        ByteArray(static_cast<uint32_t>(offsets[i + 1] - offsets[i]), data + offsets[i]);
+    if (batch_size == HASH_BATCH_SIZE) {
+      Put(values, batch_size);
+      batch_size = 0;
+    }
+  }
+  Put(values, batch_size);
+}
+
 template <typename DType>
 inline int DictEncoder<DType>::WriteIndices(uint8_t* buffer, int buffer_len) {
   // Write bit width in first byte
@@ -773,105 +1380,394 @@ inline int DictEncoder<DType>::WriteIndices(uint8_t* buffer, int buffer_len) {
 }
 
 // ----------------------------------------------------------------------
-// DeltaBitPackDecoder
+// DELTA_BINARY_PACKED encoding and decoding
+//
+// A page starts with the header <block size in values> <number of miniblocks
+// in a block> <total value count> <first value>, followed by the blocks. Each
+// block consists of <min delta> <bit width of each miniblock> <miniblocks>,
+// the miniblocks hold the bit-packed deltas minus the min delta. The header
+// fields and the min delta are ULEB128 varints, the first value and the min
+// delta are zigzag encoded. See Encodings.md in parquet-format.
+
+namespace internal {
+
+// Same block layout as parquet-mr
+static constexpr int kDeltaBlockSize = 128;
+static constexpr int kDeltaMiniBlocksPerBlock = 4;
+
+// Upper bound for the encoded size of a 64-bit ULEB128 varint
+static constexpr int kMaxVlqByteLength = 10;
+
+inline bool GetVlqInt(const uint8_t** data, const uint8_t* end, uint64_t* out) {
+  uint64_t result = 0;
+  for (int shift = 0; shift < 64; shift += 7) {
+    if (*data >= end) return false;
+    const uint8_t byte = *(*data)++;
+    result |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) {
+      *out = result;
+      return true;
+    }
+  }
+  return false;
+}
+
+// Returns the number of bytes written to out
+inline int PutVlqInt(uint64_t value, uint8_t* out) {
+  int length = 0;
+  while (value >= 0x80) {
+    out[length++] = static_cast<uint8_t>((value & 0x7F) | 0x80);
+    value >>= 7;
+  }
+  out[length++] = static_cast<uint8_t>(value);
+  return length;
+}
+
+inline uint64_t ZigZagEncode(int64_t value) {
+  return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+inline int64_t ZigZagDecode(uint64_t value) {
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+// Number of bits needed to represent value
+inline int BitWidth(uint64_t value) {
+  int width = 0;
+  while (value != 0) {
+    ++width;
+    value >>= 1;
+  }
+  return width;
+}
+
+// Unpack num_values integers of bit_width bits each, least significant bit
+// first. data must hold at least num_values * bit_width bits.
+template <typename UT>
+inline void UnpackBits(const uint8_t* data, int bit_width, int num_values, UT* out) {
+  if (bit_width == 0) {
+    std::fill(out, out + num_values, static_cast<UT>(0));
+    return;
+  }
+  const uint64_t mask = bit_width == 64 ? ~static_cast<uint64_t>(0)
+                                        : (static_cast<uint64_t>(1) << bit_width) - 1;
+  int64_t bit_offset = 0;
+  for (int i = 0; i < num_values; ++i) {
+    const uint8_t* byte = data + (bit_offset >> 3);
+    const int shift = static_cast<int>(bit_offset & 7);
+    uint64_t value = static_cast<uint64_t>(*byte++) >> shift;
+    int bits_read = 8 - shift;
+    while (bits_read < bit_width) {
+      value |= static_cast<uint64_t>(*byte++) << bits_read;
+      bits_read += 8;
+    }
+    out[i] = static_cast<UT>(value & mask);
+    bit_offset += bit_width;
+  }
+}
+
+// Inverse of UnpackBits, out must hold num_values * bit_width bits
+template <typename UT>
+inline void PackBits(const UT* values, int num_values, int bit_width, uint8_t* out) {
+  memset(out, 0, (static_cast<int64_t>(num_values) * bit_width + 7) / 8);
+  int64_t bit_offset = 0;
+  for (int i = 0; i < num_values; ++i) {
+    uint64_t value = static_cast<uint64_t>(values[i]);
+    int bits_left = bit_width;
+    while (bits_left > 0) {
+      const int shift = static_cast<int>(bit_offset & 7);
+      const int num_bits = std::min(8 - shift, bits_left);
+      uint8_t* byte = out + (bit_offset >> 3);
+      *byte = static_cast<uint8_t>(*byte | ((value & ((1U << num_bits) - 1)) << shift));
+      value >>= num_bits;
+      bit_offset += num_bits;
+      bits_left -= num_bits;
+    }
+  }
+}
+
+inline std::shared_ptr<Buffer> ConcatenateBuffers(::arrow::MemoryPool* pool,
+                                                  const Buffer& first,
+                                                  const Buffer& second) {
+  std::shared_ptr<PoolBuffer> result = AllocateBuffer(pool, first.size() + second.size());
+  if (first.size() > 0) {
+    memcpy(result->mutable_data(), first.data(), first.size());
+  }
+  if (second.size() > 0) {
+    memcpy(result->mutable_data() + first.size(), second.data(), second.size());
+  }
+  return result;
+}
+
+}  // namespace internal
 
 template <typename DType>
 class DeltaBitPackDecoder : public Decoder<DType> {
  public:
   typedef typename DType::c_type T;
+  // Deltas are computed with wrap-around in the width of the physical type
+  typedef typename std::make_unsigned<T>::type UT;
+
+  static_assert(DType::type_num == Type::INT32 || DType::type_num == Type::INT64,
+                "Delta bit pack encoding should only be for integer data.");
 
   explicit DeltaBitPackDecoder(const ColumnDescriptor* descr,
                                ::arrow::MemoryPool* pool = ::arrow::default_memory_pool())
       : Decoder<DType>(descr, Encoding::DELTA_BINARY_PACKED),
-        delta_bit_widths_(new PoolBuffer(pool)) {
-    if (DType::type_num != Type::INT32 && DType::type_num != Type::INT64) {
-      throw ParquetException("Delta bit pack encoding should only be for integer data.");
-    }
-  }
+        data_(nullptr),
+        end_(nullptr),
+        mini_blocks_per_block_(0),
+        values_per_mini_block_(0),
+        mini_block_idx_(0),
+        values_left_in_mini_block_(0),
+        first_value_read_(false),
+        min_delta_(0),
+        last_value_(0) {}
 
-  virtual void SetData(int num_values, const uint8_t* data, int len) {
-    num_values_ = num_values;
-    decoder_ = ::arrow::BitReader(data, len);
-    values_current_block_ = 0;
-    values_current_mini_block_ = 0;
+  void SetData(int num_values, const uint8_t* data, int len) override {
+    data_ = data;
+    end_ = data + len;
+    // The actual number of values, i.e. without nulls, is stored in the header
+    num_values_ = 0;
+    if (len == 0) return;
+    InitHeader();
   }
 
-  virtual int Decode(T* buffer, int max_values) {
-    return GetInternal(buffer, max_values);
+  int Decode(T* buffer, int max_values) override {
+    max_values = std::min(max_values, num_values_);
+    int i = 0;
+    if (max_values > 0 && !first_value_read_) {
+      buffer[i++] = static_cast<T>(last_value_);
+      first_value_read_ = true;
+    }
+    while (i < max_values) {
+      if (values_left_in_mini_block_ == 0) {
+        if (mini_block_idx_ == mini_blocks_per_block_) {
+          InitBlock();
+        }
+        InitMiniBlock();
+      }
+      const int batch_size = std::min(max_values - i, values_left_in_mini_block_);
+      const UT* deltas =
+          deltas_.data() + (values_per_mini_block_ - values_left_in_mini_block_);
+      for (int j = 0; j < batch_size; ++j) {
+        last_value_ = static_cast<UT>(last_value_ + min_delta_ + deltas[j]);
+        buffer[i + j] = static_cast<T>(last_value_);
+      }
+      i += batch_size;
+      values_left_in_mini_block_ -= batch_size;
+    }
+    num_values_ -= max_values;
+    return max_values;
   }
 
+  // The position after the encoded values. Data that is stored after the
+  // encoded values starts here once all values have been decoded.
+  const uint8_t* position() const { return data_; }
+
  private:
   using Decoder<DType>::num_values_;
 
-  void InitBlock() {
-    int32_t block_size;
-    if (!decoder_.GetVlqInt(&block_size)) ParquetException::EofException();
-    if (!decoder_.GetVlqInt(&num_mini_blocks_)) ParquetException::EofException();
-    if (!decoder_.GetVlqInt(&values_current_block_)) {
+  void InitHeader() {
+    uint64_t block_size, mini_blocks_per_block, total_value_count, first_value;
+    if (!internal::GetVlqInt(&data_, end_, &block_size) ||
+        !internal::GetVlqInt(&data_, end_, &mini_blocks_per_block) ||
+        !internal::GetVlqInt(&data_, end_, &total_value_count) ||
+        !internal::GetVlqInt(&data_, end_, &first_value)) {
       ParquetException::EofException();
     }
-    if (!decoder_.GetZigZagVlqInt(&last_value_)) ParquetException::EofException();
-    PARQUET_THROW_NOT_OK(delta_bit_widths_->Resize(num_mini_blocks_, false));
+    // Miniblocks must be byte-aligned, parquet-format requires a multiple of 32
+    // values per miniblock
+    if (mini_blocks_per_block == 0 || block_size % mini_blocks_per_block != 0 ||
+        (block_size / mini_blocks_per_block) % 8 != 0 ||
+        block_size > static_cast<uint64_t>(std::numeric_limits<int>::max())) {
+      throw ParquetException("Invalid DELTA_BINARY_PACKED block layout");
+    }
+    if (total_value_count > static_cast<uint64_t>(std::numeric_limits<int>::max())) {
+      throw ParquetException("Too many values in DELTA_BINARY_PACKED page");
+    }
 
-    uint8_t* bit_width_data = delta_bit_widths_->mutable_data();
+    num_values_ = static_cast<int>(total_value_count);
+    mini_blocks_per_block_ = static_cast<int>(mini_blocks_per_block);
+    values_per_mini_block_ = static_cast<int>(block_size / mini_blocks_per_block);
+    bit_widths_.resize(mini_blocks_per_block_);
+    deltas_.resize(values_per_mini_block_);
 
-    if (!decoder_.GetZigZagVlqInt(&min_delta_)) ParquetException::EofException();
-    for (int i = 0; i < num_mini_blocks_; ++i) {
-      if (!decoder_.GetAligned<uint8_t>(1, bit_width_data + i)) {
-        ParquetException::EofException();
-      }
+    mini_block_idx_ = mini_blocks_per_block_;
+    values_left_in_mini_block_ = 0;
+    first_value_read_ = false;
+    last_value_ = static_cast<UT>(internal::ZigZagDecode(first_value));
+  }
+
+  void InitBlock() {
+    uint64_t min_delta;
+    if (!internal::GetVlqInt(&data_, end_, &min_delta)) {
+      ParquetException::EofException();
     }
-    values_per_mini_block_ = block_size / num_mini_blocks_;
+    min_delta_ = static_cast<UT>(internal::ZigZagDecode(min_delta));
+
+    if (end_ - data_ < mini_blocks_per_block_) {
+      ParquetException::EofException();
+    }
+    std::copy(data_, data_ + mini_blocks_per_block_, bit_widths_.begin());
+    data_ += mini_blocks_per_block_;
     mini_block_idx_ = 0;
-    delta_bit_width_ = bit_width_data[0];
-    values_current_mini_block_ = values_per_mini_block_;
   }
 
-  template <typename T>
-  int GetInternal(T* buffer, int max_values) {
-    max_values = std::min(max_values, num_values_);
-    const uint8_t* bit_width_data = delta_bit_widths_->data();
-    for (int i = 0; i < max_values; ++i) {
-      if (ARROW_PREDICT_FALSE(values_current_mini_block_ == 0)) {
-        ++mini_block_idx_;
-        if (mini_block_idx_ < static_cast<size_t>(delta_bit_widths_->size())) {
-          delta_bit_width_ = bit_width_data[mini_block_idx_];
-          values_current_mini_block_ = values_per_mini_block_;
-        } else {
-          InitBlock();
-          buffer[i] = last_value_;
-          continue;
-        }
-      }
+  void InitMiniBlock() {
+    const int bit_width = bit_widths_[mini_block_idx_++];
+    if (bit_width > static_cast<int>(sizeof(T) * 8)) {
+      throw ParquetException("Invalid DELTA_BINARY_PACKED bit width");
+    }
+    // Miniblocks are always padded to their full size
+    const int64_t num_bytes =
+        static_cast<int64_t>(values_per_mini_block_) * bit_width / 8;
+    if (end_ - data_ < num_bytes) {
+      ParquetException::EofException();
+    }
+    internal::UnpackBits(data_, bit_width, values_per_mini_block_, deltas_.data());
+    data_ += num_bytes;
+    values_left_in_mini_block_ = values_per_mini_block_;
+  }
+
+  const uint8_t* data_;
+  const uint8_t* end_;
+
+  int mini_blocks_per_block_;
+  int values_per_mini_block_;
+  std::vector<uint8_t> bit_widths_;
+
+  int mini_block_idx_;
+  int values_left_in_mini_block_;
+  // Unpacked deltas of the current miniblock, relative to min_delta_
+  std::vector<UT> deltas_;
 
-      // TODO: the key to this algorithm is to decode the entire miniblock at once.
-      int64_t delta;
-      if (!decoder_.GetValue(delta_bit_width_, &delta)) ParquetException::EofException();
-      delta += min_delta_;
-      last_value_ += static_cast<int32_t>(delta);
-      buffer[i] = last_value_;
-      --values_current_mini_block_;
+  bool first_value_read_;
+  UT min_delta_;
+  UT last_value_;
+};
+
+template <typename DType>
+class DeltaBitPackEncoder : public Encoder<DType> {
+ public:
+  typedef typename DType::c_type T;
+  typedef typename std::make_unsigned<T>::type UT;
+
+  static_assert(DType::type_num == Type::INT32 || DType::type_num == Type::INT64,
+                "Delta bit pack encoding should only be for integer data.");
+
+  explicit DeltaBitPackEncoder(const ColumnDescriptor* descr,
+                               ::arrow::MemoryPool* pool = ::arrow::default_memory_pool())
+      : Encoder<DType>(descr, Encoding::DELTA_BINARY_PACKED, pool),
+        values_sink_(new InMemoryOutputStream(pool)),
+        deltas_(internal::kDeltaBlockSize),
+        packed_(kValuesPerMiniBlock * sizeof(UT)),
+        num_deltas_(0),
+        total_value_count_(0),
+        first_value_(0),
+        last_value_(0) {}
+
+  int64_t EstimatedDataEncodedSize() override {
+    return kMaxHeaderSize + values_sink_->Tell() +
+           static_cast<int64_t>(num_deltas_ * sizeof(T));
+  }
+
+  std::shared_ptr<Buffer> FlushValues() override {
+    if (num_deltas_ > 0) {
+      FlushBlock();
     }
-    num_values_ -= max_values;
-    return max_values;
+
+    uint8_t header[kMaxHeaderSize];
+    int header_size = internal::PutVlqInt(internal::kDeltaBlockSize, header);
+    header_size += internal::PutVlqInt(internal::kDeltaMiniBlocksPerBlock,
+                                       header + header_size);
+    header_size += internal::PutVlqInt(total_value_count_, header + header_size);
+    header_size += internal::PutVlqInt(
+        internal::ZigZagEncode(static_cast<T>(first_value_)), header + header_size);
+
+    std::shared_ptr<Buffer> buffer = internal::ConcatenateBuffers(
+        this->pool_, Buffer(header, header_size), *values_sink_->GetBuffer());
+    values_sink_.reset(new InMemoryOutputStream(this->pool_));
+    total_value_count_ = 0;
+    return buffer;
+  }
+
+  void Put(const T* src, int num_values) override {
+    int i = 0;
+    if (total_value_count_ == 0 && num_values > 0) {
+      first_value_ = last_value_ = static_cast<UT>(src[0]);
+      i = 1;
+    }
+    for (; i < num_values; ++i) {
+      const UT value = static_cast<UT>(src[i]);
+      deltas_[num_deltas_++] = static_cast<UT>(value - last_value_);
+      last_value_ = value;
+      if (num_deltas_ == internal::kDeltaBlockSize) {
+        FlushBlock();
+      }
+    }
+    total_value_count_ += num_values;
   }
 
-  ::arrow::BitReader decoder_;
-  int32_t values_current_block_;
-  int32_t num_mini_blocks_;
-  uint64_t values_per_mini_block_;
-  uint64_t values_current_mini_block_;
+ private:
+  static constexpr int kValuesPerMiniBlock =
+      internal::kDeltaBlockSize / internal::kDeltaMiniBlocksPerBlock;
+  static constexpr int kMaxHeaderSize = 4 * internal::kMaxVlqByteLength;
+
+  void FlushBlock() {
+    // The min delta is signed, the packed values are the offsets from it
+    T min_delta = static_cast<T>(deltas_[0]);
+    for (int i = 1; i < num_deltas_; ++i) {
+      min_delta = std::min(min_delta, static_cast<T>(deltas_[i]));
+    }
+    const UT unsigned_min_delta = static_cast<UT>(min_delta);
+
+    uint8_t
+        block_header[internal::kMaxVlqByteLength + internal::kDeltaMiniBlocksPerBlock];
+    int block_header_size =
+        internal::PutVlqInt(internal::ZigZagEncode(min_delta), block_header);
+    uint8_t* bit_widths = block_header + block_header_size;
+    block_header_size += internal::kDeltaMiniBlocksPerBlock;
+
+    for (int i = 0; i < internal::kDeltaMiniBlocksPerBlock; ++i) {
+      const int start = i * kValuesPerMiniBlock;
+      const int end = std::min(start + kValuesPerMiniBlock, num_deltas_);
+      UT max_delta = 0;
+      for (int j = start; j < end; ++j) {
+        deltas_[j] = static_cast<UT>(deltas_[j] - unsigned_min_delta);
+        max_delta = std::max(max_delta, deltas_[j]);
+      }
+      // Pad the last miniblock, unused miniblocks get a bit width of 0
+      for (int j = std::max(start, end); j < start + kValuesPerMiniBlock; ++j) {
+        deltas_[j] = 0;
+      }
+      bit_widths[i] = static_cast<uint8_t>(internal::BitWidth(max_delta));
+    }
+    values_sink_->Write(block_header, block_header_size);
 
-  int32_t min_delta_;
-  size_t mini_block_idx_;
-  std::unique_ptr<PoolBuffer> delta_bit_widths_;
-  int delta_bit_width_;
+    // Only the miniblocks that contain values are written
+    for (int i = 0; i * kValuesPerMiniBlock < num_deltas_; ++i) {
+      internal::PackBits(deltas_.data() + i * kValuesPerMiniBlock, kValuesPerMiniBlock,
+                         bit_widths[i], packed_.data());
+      values_sink_->Write(packed_.data(), kValuesPerMiniBlock * bit_widths[i] / 8);
+    }
+    num_deltas_ = 0;
+  }
 
-  int32_t last_value_;
+  std::unique_ptr<InMemoryOutputStream> values_sink_;
+  std::vector<UT> deltas_;
+  std::vector<uint8_t> packed_;
+  int num_deltas_;
+  uint64_t total_value_count_;
+  UT first_value_;
+  UT last_value_;
 };
 
 // ----------------------------------------------------------------------
 // DELTA_LENGTH_BYTE_ARRAY
+//
+// The lengths of all values, encoded with DELTA_BINARY_PACKED, followed by
+// the concatenated values.
 
 class DeltaLengthByteArrayDecoder : public Decoder<ByteArrayType> {
  public:
@@ -879,27 +1775,38 @@ class DeltaLengthByteArrayDecoder : public Decoder<ByteArrayType> {
       const ColumnDescriptor* descr,
       ::arrow::MemoryPool* pool = ::arrow::default_memory_pool())
       : Decoder<ByteArrayType>(descr, Encoding::DELTA_LENGTH_BYTE_ARRAY),
-        len_decoder_(nullptr, pool) {}
+        len_decoder_(nullptr, pool),
+        length_idx_(0),
+        data_(nullptr),
+        len_(0) {}
 
-  virtual void SetData(int num_values, const uint8_t* data, int len) {
-    num_values_ = num_values;
+  void SetData(int num_values, const uint8_t* data, int len) override {
+    num_values_ = 0;
     if (len == 0) return;
-    int total_lengths_len = *reinterpret_cast<const int*>(data);
-    data += 4;
-    len_decoder_.SetData(num_values, data, total_lengths_len);
-    data_ = data + total_lengths_len;
-    len_ = len - 4 - total_lengths_len;
+    len_decoder_.SetData(num_values, data, len);
+
+    // The lengths need to be decoded entirely to find the start of the values
+    const int num_lengths = len_decoder_.values_left();
+    lengths_.resize(num_lengths);
+    len_decoder_.Decode(lengths_.data(), num_lengths);
+    length_idx_ = 0;
+
+    data_ = len_decoder_.position();
+    len_ = static_cast<int>(data + len - data_);
+    num_values_ = num_lengths;
   }
 
-  virtual int Decode(ByteArray* buffer, int max_values) {
+  int Decode(ByteArray* buffer, int max_values) override {
     max_values = std::min(max_values, num_values_);
-    std::vector<int> lengths(max_values);
-    len_decoder_.Decode(lengths.data(), max_values);
     for (int i = 0; i < max_values; ++i) {
-      buffer[i].len = lengths[i];
+      const int32_t value_len = lengths_[length_idx_++];
+      if (ARROW_PREDICT_FALSE(value_len < 0 || value_len > len_)) {
+        ParquetException::EofException();
+      }
+      buffer[i].len = static_cast<uint32_t>(value_len);
       buffer[i].ptr = data_;
-      data_ += lengths[i];
-      len_ -= lengths[i];
+      data_ += value_len;
+      len_ -= value_len;
     }
     num_values_ -= max_values;
     return max_values;
@@ -908,12 +1815,55 @@ class DeltaLengthByteArrayDecoder : public Decoder<ByteArrayType> {
  private:
   using Decoder<ByteArrayType>::num_values_;
   DeltaBitPackDecoder<Int32Type> len_decoder_;
+  std::vector<int32_t> lengths_;
+  int length_idx_;
   const uint8_t* data_;
   int len_;
 };
 
+class DeltaLengthByteArrayEncoder : public Encoder<ByteArrayType> {
+ public:
+  explicit DeltaLengthByteArrayEncoder(
+      const ColumnDescriptor* descr,
+      ::arrow::MemoryPool* pool = ::arrow::default_memory_pool())
+      : Encoder<ByteArrayType>(descr, Encoding::DELTA_LENGTH_BYTE_ARRAY, pool),
+        len_encoder_(nullptr, pool),
+        values_sink_(new InMemoryOutputStream(pool)) {}
+
+  int64_t EstimatedDataEncodedSize() override {
+    return len_encoder_.EstimatedDataEncodedSize() + values_sink_->Tell();
+  }
+
+  std::shared_ptr<Buffer> FlushValues() override {
+    std::shared_ptr<Buffer> lengths = len_encoder_.FlushValues();
+    std::shared_ptr<Buffer> buffer =
+        internal::ConcatenateBuffers(this->pool_, *lengths, *values_sink_->GetBuffer());
+    values_sink_.reset(new InMemoryOutputStream(this->pool_));
+    return buffer;
+  }
+
+  void Put(const ByteArray* src, int num_values) override {
+    lengths_.resize(num_values);
+    for (int i = 0; i < num_values; ++i) {
+      lengths_[i] = static_cast<int32_t>(src[i].len);
+      values_sink_->Write(src[i].ptr, src[i].len);
+    }
+    len_encoder_.Put(lengths_.data(), num_values);
+  }
+
+ private:
+  DeltaBitPackEncoder<Int32Type> len_encoder_;
+  std::unique_ptr<InMemoryOutputStream> values_sink_;
+  // Scratch space for the lengths of a batch
+  std::vector<int32_t> lengths_;
+};
+
 // ----------------------------------------------------------------------
 // DELTA_BYTE_ARRAY
+//
+// The lengths of the prefixes shared with the previous value, encoded with
+// DELTA_BINARY_PACKED, followed by the remaining suffixes encoded with
+// DELTA_LENGTH_BYTE_ARRAY.
 
 class DeltaByteArrayDecoder : public Decoder<ByteArrayType> {
  public:
@@ -923,36 +1873,51 @@ class DeltaByteArrayDecoder : public Decoder<ByteArrayType> {
       : Decoder<ByteArrayType>(descr, Encoding::DELTA_BYTE_ARRAY),
         prefix_len_decoder_(nullptr, pool),
         suffix_decoder_(nullptr, pool),
-        last_value_(0, nullptr) {}
+        prefix_len_idx_(0),
+        values_pool_(pool) {}
 
-  virtual void SetData(int num_values, const uint8_t* data, int len) {
-    num_values_ = num_values;
+  ~DeltaByteArrayDecoder() override { values_pool_.FreeAll(); }
+
+  void SetData(int num_values, const uint8_t* data, int len) override {
+    num_values_ = 0;
+    last_value_ = ByteArray();
+    // The reconstructed values of the previous page are no longer referenced
+    values_pool_.Clear();
     if (len == 0) return;
-    int prefix_len_length = *reinterpret_cast<const int*>(data);
-    data += 4;
-    len -= 4;
-    prefix_len_decoder_.SetData(num_values, data, prefix_len_length);
-    data += prefix_len_length;
-    len -= prefix_len_length;
-    suffix_decoder_.SetData(num_values, data, len);
-  }
-
-  // TODO: this doesn't work and requires memory management. We need to allocate
-  // new strings to store the results.
-  virtual int Decode(ByteArray* buffer, int max_values) {
-    max_values = std::min(max_values, num_values_);
-    for (int i = 0; i < max_values; ++i) {
-      int prefix_len = 0;
-      prefix_len_decoder_.Decode(&prefix_len, 1);
-      ByteArray suffix = {0, nullptr};
-      suffix_decoder_.Decode(&suffix, 1);
-      buffer[i].len = prefix_len + suffix.len;
 
-      uint8_t* result = reinterpret_cast<uint8_t*>(malloc(buffer[i].len));
-      memcpy(result, last_value_.ptr, prefix_len);
-      memcpy(result + prefix_len, suffix.ptr, suffix.len);
+    prefix_len_decoder_.SetData(num_values, data, len);
+    const int num_prefix_lengths = prefix_len_decoder_.values_left();
+    prefix_lengths_.resize(num_prefix_lengths);
+    prefix_len_decoder_.Decode(prefix_lengths_.data(), num_prefix_lengths);
+    prefix_len_idx_ = 0;
+
+    const uint8_t* suffixes = prefix_len_decoder_.position();
+    suffix_decoder_.SetData(num_values, suffixes,
+                            static_cast<int>(data + len - suffixes));
+    if (suffix_decoder_.values_left() != num_prefix_lengths) {
+      throw ParquetException("DELTA_BYTE_ARRAY prefix and suffix counts differ");
+    }
+    num_values_ = num_prefix_lengths;
+  }
 
-      buffer[i].ptr = result;
+  int Decode(ByteArray* buffer, int max_values) override {
+    max_values = suffix_decoder_.Decode(buffer, std::min(max_values, num_values_));
+    for (int i = 0; i < max_values; ++i) {
+      const int32_t prefix_len = prefix_lengths_[prefix_len_idx_++];
+      if (ARROW_PREDICT_FALSE(prefix_len < 0 ||
+                              prefix_len > static_cast<int32_t>(last_value_.len))) {
+        throw ParquetException("Invalid DELTA_BYTE_ARRAY prefix length");
+      }
+      // Values without a shared prefix can reference the page directly
+      if (prefix_len > 0) {
+        const uint32_t value_len = static_cast<uint32_t>(prefix_len) + buffer[i].len;
+        uint8_t* value = values_pool_.Allocate(static_cast<int>(value_len));
+        memcpy(value, last_value_.ptr, prefix_len);
+        if (buffer[i].len > 0) {
+          memcpy(value + prefix_len, buffer[i].ptr, buffer[i].len);
+        }
+        buffer[i] = ByteArray(value_len, value);
+      }
       last_value_ = buffer[i];
     }
     num_values_ -= max_values;
@@ -964,9 +1929,158 @@ class DeltaByteArrayDecoder : public Decoder<ByteArrayType> {
 
   DeltaBitPackDecoder<Int32Type> prefix_len_decoder_;
   DeltaLengthByteArrayDecoder suffix_decoder_;
+  std::vector<int32_t> prefix_lengths_;
+  int prefix_len_idx_;
   ByteArray last_value_;
+  // Storage of the values that are prefixed, valid until the next SetData
+  ChunkedAllocator values_pool_;
+};
+
+class DeltaByteArrayEncoder : public Encoder<ByteArrayType> {
+ public:
+  explicit DeltaByteArrayEncoder(
+      const ColumnDescriptor* descr,
+      ::arrow::MemoryPool* pool = ::arrow::default_memory_pool())
+      : Encoder<ByteArrayType>(descr, Encoding::DELTA_BYTE_ARRAY, pool),
+        prefix_len_encoder_(nullptr, pool),
+        suffix_encoder_(nullptr, pool) {}
+
+  int64_t EstimatedDataEncodedSize() override {
+    return prefix_len_encoder_.EstimatedDataEncodedSize() +
+           suffix_encoder_.EstimatedDataEncodedSize();
+  }
+
+  std::shared_ptr<Buffer> FlushValues() override {
+    std::shared_ptr<Buffer> prefix_lengths = prefix_len_encoder_.FlushValues();
+    std::shared_ptr<Buffer> suffixes = suffix_encoder_.FlushValues();
+    // Every page starts without a previous value
+    last_value_.clear();
+    return internal::ConcatenateBuffers(this->pool_, *prefix_lengths, *suffixes);
+  }
+
+  void Put(const ByteArray* src, int num_values) override {
+    for (int i = 0; i < num_values; ++i) {
+      const uint32_t max_prefix_len =
+          std::min(src[i].len, static_cast<uint32_t>(last_value_.size()));
+      uint32_t prefix_len = 0;
+      while (prefix_len < max_prefix_len &&
+             src[i].ptr[prefix_len] == last_value_[prefix_len]) {
+        ++prefix_len;
+      }
+      const int32_t encoded_prefix_len = static_cast<int32_t>(prefix_len);
+      prefix_len_encoder_.Put(&encoded_prefix_len, 1);
+
+      const ByteArray suffix(src[i].len - prefix_len, src[i].ptr + prefix_len);
+      suffix_encoder_.Put(&suffix, 1);
+
+      last_value_.assign(src[i].ptr, src[i].ptr + src[i].len);
+    }
+  }
+
+ private:
+  DeltaBitPackEncoder<Int32Type> prefix_len_encoder_;
+  DeltaLengthByteArrayEncoder suffix_encoder_;
+  // Copy of the previous value, the input is only valid during Put
+  std::vector<uint8_t> last_value_;
 };
 
+// ----------------------------------------------------------------------
+// The DELTA_* encodings only apply to some physical types. These factories
+// are specialized for the supported types so that the typed column reader
+// and writer can refer to them for every type.
+
+template <typename DType>
+inline std::unique_ptr<Decoder<DType>> MakeDeltaDecoder(Encoding::type encoding,
+                                                        const ColumnDescriptor* descr,
+                                                        ::arrow::MemoryPool* pool) {
+  throw ParquetException(EncodingToString(encoding) +
+                         " encoding is not supported for this physical type");
+}
+
+template <>
+inline std::unique_ptr<Decoder<Int32Type>> MakeDeltaDecoder<Int32Type>(
+    Encoding::type encoding, const ColumnDescriptor* descr, ::arrow::MemoryPool* pool) {
+  if (encoding != Encoding::DELTA_BINARY_PACKED) {
+    throw ParquetException(EncodingToString(encoding) +
+                           " encoding is not supported for INT32");
+  }
+  return std::unique_ptr<Decoder<Int32Type>>(
+      new DeltaBitPackDecoder<Int32Type>(descr, pool));
+}
+
+template <>
+inline std::unique_ptr<Decoder<Int64Type>> MakeDeltaDecoder<Int64Type>(
+    Encoding::type encoding, const ColumnDescriptor* descr, ::arrow::MemoryPool* pool) {
+  if (encoding != Encoding::DELTA_BINARY_PACKED) {
+    throw ParquetException(EncodingToString(encoding) +
+                           " encoding is not supported for INT64");
+  }
+  return std::unique_ptr<Decoder<Int64Type>>(
+      new DeltaBitPackDecoder<Int64Type>(descr, pool));
+}
+
+template <>
+inline std::unique_ptr<Decoder<ByteArrayType>> MakeDeltaDecoder<ByteArrayType>(
+    Encoding::type encoding, const ColumnDescriptor* descr, ::arrow::MemoryPool* pool) {
+  switch (encoding) {
+    case Encoding::DELTA_LENGTH_BYTE_ARRAY:
+      return std::unique_ptr<Decoder<ByteArrayType>>(
+          new DeltaLengthByteArrayDecoder(descr, pool));
+    case Encoding::DELTA_BYTE_ARRAY:
+      return std::unique_ptr<Decoder<ByteArrayType>>(
+          new DeltaByteArrayDecoder(descr, pool));
+    default:
+      throw ParquetException(EncodingToString(encoding) +
+                             " encoding is not supported for BYTE_ARRAY");
+  }
+}
+
+template <typename DType>
+inline std::unique_ptr<Encoder<DType>> MakeDeltaEncoder(Encoding::type encoding,
+                                                        const ColumnDescriptor* descr,
+                                                        ::arrow::MemoryPool* pool) {
+  throw ParquetException(EncodingToString(encoding) +
+                         " encoding is not supported for this physical type");
+}
+
+template <>
+inline std::unique_ptr<Encoder<Int32Type>> MakeDeltaEncoder<Int32Type>(
+    Encoding::type encoding, const ColumnDescriptor* descr, ::arrow::MemoryPool* pool) {
+  if (encoding != Encoding::DELTA_BINARY_PACKED) {
+    throw ParquetException(EncodingToString(encoding) +
+                           " encoding is not supported for INT32");
+  }
+  return std::unique_ptr<Encoder<Int32Type>>(
+      new DeltaBitPackEncoder<Int32Type>(descr, pool));
+}
+
+template <>
+inline std::unique_ptr<Encoder<Int64Type>> MakeDeltaEncoder<Int64Type>(
+    Encoding::type encoding, const ColumnDescriptor* descr, ::arrow::MemoryPool* pool) {
+  if (encoding != Encoding::DELTA_BINARY_PACKED) {
+    throw ParquetException(EncodingToString(encoding) +
+                           " encoding is not supported for INT64");
+  }
+  return std::unique_ptr<Encoder<Int64Type>>(
+      new DeltaBitPackEncoder<Int64Type>(descr, pool));
+}
+
+template <>
+inline std::unique_ptr<Encoder<ByteArrayType>> MakeDeltaEncoder<ByteArrayType>(
+    Encoding::type encoding, const ColumnDescriptor* descr, ::arrow::MemoryPool* pool) {
+  switch (encoding) {
+    case Encoding::DELTA_LENGTH_BYTE_ARRAY:
+      return std::unique_ptr<Encoder<ByteArrayType>>(
+          new DeltaLengthByteArrayEncoder(descr, pool));
+    case Encoding::DELTA_BYTE_ARRAY:
+      return std::unique_ptr<Encoder<ByteArrayType>>(
+          new DeltaByteArrayEncoder(descr, pool));
+    default:
+      throw ParquetException(EncodingToString(encoding) +
+                             " encoding is not supported for BYTE_ARRAY");
+  }
+}
+
 }  // namespace parquet
 
 #endif  // PARQUET_ENCODING_INTERNAL_H
@@ -16,6 +16,7 @@
 // under the License.
 
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
@@ -69,6 +70,55 @@ TEST(VectorBooleanTest, TestEncodeDecode) {
   }
 }
 
+TEST(VectorBooleanTest, TestDecodeBitmap) {
+  int nvalues = 1000;
+  vector<bool> draws = flip_coins_seed(nvalues, 0.5, 0);
+
+  PlainEncoder<BooleanType> encoder(nullptr);
+  encoder.Put(draws, nvalues);
+  std::shared_ptr<Buffer> encode_buffer = encoder.FlushValues();
+
+  PlainDecoder<BooleanType> decoder(nullptr);
+  decoder.SetData(nvalues, encode_buffer->data(),
+                  static_cast<int>(encode_buffer->size()));
+
+  // The flavors, bool values included, can be mixed at any bit offset
+  vector<uint8_t> bitmap(nvalues, 0);
+  ASSERT_EQ(3, decoder.DecodeBitmap(bitmap.data(), 5, 3));
+  bool values[10];
+  ASSERT_EQ(10, decoder.Decode(values, 10));
+  ASSERT_EQ(7, decoder.Skip(7));
+  ASSERT_EQ(500, decoder.DecodeBitmap(bitmap.data(), 8, 500));
+  for (int i = 0; i < 3; ++i) {
+    ASSERT_EQ(draws[i], BitUtil::GetBit(bitmap.data(), 5 + i)) << i;
+  }
+  for (int i = 0; i < 10; ++i) {
+    ASSERT_EQ(draws[3 + i], values[i]) << i;
+  }
+  for (int i = 0; i < 500; ++i) {
+    ASSERT_EQ(draws[20 + i], BitUtil::GetBit(bitmap.data(), 8 + i)) << i;
+  }
+
+  // Every third slot is null
+  const int num_slots = 300;
+  vector<uint8_t> valid_bits(num_slots / 8 + 1, 0);
+  int null_count = 0;
+  for (int i = 0; i < num_slots; ++i) {
+    if (i % 3 == 0) {
+      ++null_count;
+    } else {
+      BitUtil::SetBit(valid_bits.data(), i);
+    }
+  }
+  ASSERT_EQ(num_slots, decoder.DecodeBitmapSpaced(bitmap.data(), 3, num_slots,
+                                                  null_count, valid_bits.data(), 0));
+  for (int i = 0, value = 520; i < num_slots; ++i) {
+    const bool expected = i % 3 == 0 ? false : static_cast<bool>(draws[value++]);
+    ASSERT_EQ(expected, BitUtil::GetBit(bitmap.data(), 3 + i)) << i;
+  }
+  ASSERT_EQ(nvalues - 520 - (num_slots - null_count), decoder.values_left());
+}
+
 // ----------------------------------------------------------------------
 // test data generation
 
@@ -264,6 +314,16 @@ class TestDictionaryEncoding : public TestEncodingBase<Type> {
     std::shared_ptr<Buffer> indices_from_spaced = spaced_encoder.FlushValues();
     ASSERT_TRUE(indices_from_spaced->Equals(*indices));
 
+    // Reserving the dictionary up front should lead to the same results
+    DictEncoder<Type> reserved_encoder(descr_.get(), &pool_);
+    reserved_encoder.Reserve(num_values_);
+    ASSERT_LE(num_values_, reserved_encoder.hash_table_size() * MAX_HASH_LOAD);
+    const int reserved_table_size = reserved_encoder.hash_table_size();
+    ASSERT_NO_THROW(reserved_encoder.Put(draws_, num_values_));
+    ASSERT_EQ(reserved_table_size, reserved_encoder.hash_table_size());
+    ASSERT_EQ(encoder.num_entries(), reserved_encoder.num_entries());
+    ASSERT_TRUE(reserved_encoder.FlushValues()->Equals(*indices));
+
     PlainDecoder<Type> dict_decoder(descr_.get());
     dict_decoder.SetData(encoder.num_entries(), dict_buffer_->data(),
                          static_cast<int>(dict_buffer_->size()));
@@ -304,6 +364,215 @@ TEST(TestDictionaryEncoding, CannotDictDecodeBoolean) {
   ASSERT_THROW(decoder.SetDict(&dict_decoder), ParquetException);
 }
 
+// ----------------------------------------------------------------------
+// BYTE_STREAM_SPLIT encoding tests
+
+typedef ::testing::Types<FloatType, DoubleType> ByteStreamSplitTypes;
+
+template <typename Type>
+class TestByteStreamSplitEncoding : public TestEncodingBase<Type> {
+ public:
+  typedef typename Type::c_type T;
+  static constexpr int TYPE = Type::type_num;
+
+  void CheckRoundtrip() {
+    ByteStreamSplitEncoder<Type> encoder(descr_.get());
+    ByteStreamSplitDecoder<Type> decoder(descr_.get());
+    encoder.Put(draws_, num_values_);
+    ASSERT_EQ(num_values_ * static_cast<int64_t>(sizeof(T)),
+              encoder.EstimatedDataEncodedSize());
+    encode_buffer_ = encoder.FlushValues();
+    ASSERT_EQ(num_values_ * static_cast<int64_t>(sizeof(T)), encode_buffer_->size());
+
+    // Decode in batches that do not line up with the SIMD blocks and skip a
+    // few values in between
+    decoder.SetData(num_values_, encode_buffer_->data(),
+                    static_cast<int>(encode_buffer_->size()));
+    int values_decoded = 0;
+    for (int batch = 0; values_decoded < num_values_; ++batch) {
+      int batch_size;
+      if (batch % 3 == 0) {
+        batch_size = decoder.Skip(5);
+        std::copy(draws_ + values_decoded, draws_ + values_decoded + batch_size,
+                  decode_buf_ + values_decoded);
+      } else {
+        batch_size = decoder.Decode(decode_buf_ + values_decoded, 37);
+      }
+      ASSERT_GT(batch_size, 0);
+      values_decoded += batch_size;
+    }
+    ASSERT_EQ(num_values_, values_decoded);
+    ASSERT_EQ(0, decoder.Decode(decode_buf_, 1));
+    VerifyResults<T>(decode_buf_, draws_, num_values_);
+  }
+
+ protected:
+  USING_BASE_MEMBERS();
+};
+
+TYPED_TEST_CASE(TestByteStreamSplitEncoding, ByteStreamSplitTypes);
+
+TYPED_TEST(TestByteStreamSplitEncoding, BasicRoundTrip) { this->Execute(10000, 1); }
+
+TYPED_TEST(TestByteStreamSplitEncoding, SmallPages) {
+  for (int nvalues : {0, 1, 15, 16, 17, 100}) {
+    this->Execute(nvalues, 1);
+  }
+}
+
+TEST(TestByteStreamSplitEncoding, TruncatedInput) {
+  auto descr = ExampleDescr<DoubleType>();
+  ByteStreamSplitDecoder<DoubleType> decoder(descr.get());
+  std::vector<uint8_t> data(3 * sizeof(double));
+  decoder.SetData(4, data.data(), static_cast<int>(data.size()));
+  double values[4];
+  ASSERT_THROW(decoder.Decode(values, 4), ParquetException);
+}
+
+TEST(TestByteStreamSplitEncoding, UnsupportedType) {
+  auto descr = ExampleDescr<Int32Type>();
+  ASSERT_THROW(MakeByteStreamSplitEncoder<Int32Type>(descr.get(), default_memory_pool()),
+               ParquetException);
+  ASSERT_THROW(MakeByteStreamSplitDecoder<Int32Type>(descr.get()), ParquetException);
+}
+
+// ----------------------------------------------------------------------
+// Delta encoding tests
+
+typedef ::testing::Types<Int32Type, Int64Type> DeltaBitPackTypes;
+
+template <typename Type>
+class TestDeltaBitPackEncoding : public TestEncodingBase<Type> {
+ public:
+  typedef typename Type::c_type T;
+  static constexpr int TYPE = Type::type_num;
+
+  void CheckRoundtrip() {
+    DeltaBitPackEncoder<Type> encoder(descr_.get());
+    DeltaBitPackDecoder<Type> decoder(descr_.get());
+    encoder.Put(draws_, num_values_);
+    encode_buffer_ = encoder.FlushValues();
+
+    // Decode in batches that do not line up with the miniblocks
+    decoder.SetData(num_values_, encode_buffer_->data(),
+                    static_cast<int>(encode_buffer_->size()));
+    int values_decoded = 0;
+    while (values_decoded < num_values_) {
+      int batch_size = decoder.Decode(decode_buf_ + values_decoded, 37);
+      ASSERT_GT(batch_size, 0);
+      values_decoded += batch_size;
+    }
+    ASSERT_EQ(num_values_, values_decoded);
+    ASSERT_EQ(0, decoder.Decode(decode_buf_, 1));
+    VerifyResults<T>(decode_buf_, draws_, num_values_);
+  }
+
+  void ExecuteSorted(int nvalues) {
+    this->InitData(nvalues, 1);
+    std::sort(draws_, draws_ + num_values_);
+    CheckRoundtrip();
+  }
+
+ protected:
+  USING_BASE_MEMBERS();
+};
+
+TYPED_TEST_CASE(TestDeltaBitPackEncoding, DeltaBitPackTypes);
+
+TYPED_TEST(TestDeltaBitPackEncoding, BasicRoundTrip) { this->Execute(10000, 1); }
+
+TYPED_TEST(TestDeltaBitPackEncoding, SortedRoundTrip) { this->ExecuteSorted(10000); }
+
+TYPED_TEST(TestDeltaBitPackEncoding, BlockBoundaries) {
+  for (int nvalues : {0, 1, 2, 32, 33, 128, 129, 130, 257}) {
+    this->Execute(nvalues, 1);
+  }
+}
+
+TEST(TestDeltaBitPackEncoding, SpecExample) {
+  // Example 1 of the parquet-format encoding documentation
+  std::vector<int32_t> values = {1, 2, 3, 4, 5};
+  DeltaBitPackEncoder<Int32Type> encoder(nullptr);
+  encoder.Put(values.data(), static_cast<int>(values.size()));
+  std::shared_ptr<Buffer> buffer = encoder.FlushValues();
+
+  // Block size 128, 4 miniblocks, 5 values, first value 1, min delta 1 and no
+  // miniblock data as all bit widths are 0
+  std::vector<uint8_t> expected = {0x80, 0x01, 0x04, 0x05, 0x02, 0x02, 0, 0, 0, 0};
+  ASSERT_EQ(static_cast<int64_t>(expected.size()), buffer->size());
+  ASSERT_EQ(0, memcmp(expected.data(), buffer->data(), expected.size()));
+
+  DeltaBitPackDecoder<Int32Type> decoder(nullptr);
+  decoder.SetData(5, buffer->data(), static_cast<int>(buffer->size()));
+  std::vector<int32_t> decoded(5);
+  ASSERT_EQ(5, decoder.Decode(decoded.data(), 5));
+  ASSERT_EQ(values, decoded);
+  ASSERT_EQ(buffer->data() + buffer->size(), decoder.position());
+}
+
+TEST(TestDeltaBitPackEncoding, TruncatedInput) {
+  std::vector<int64_t> values(1000);
+  for (size_t i = 0; i < values.size(); ++i) {
+    values[i] = static_cast<int64_t>(i * i);
+  }
+  DeltaBitPackEncoder<Int64Type> encoder(nullptr);
+  encoder.Put(values.data(), static_cast<int>(values.size()));
+  std::shared_ptr<Buffer> buffer = encoder.FlushValues();
+
+  DeltaBitPackDecoder<Int64Type> decoder(nullptr);
+  decoder.SetData(1000, buffer->data(), static_cast<int>(buffer->size() / 2));
+  ASSERT_THROW(decoder.Decode(values.data(), 1000), ParquetException);
+}
+
+template <typename EncoderType, typename DecoderType>
+void CheckByteArrayRoundtrip(const std::vector<std::string>& strings) {
+  std::vector<ByteArray> values;
+  for (const std::string& s : strings) {
+    values.push_back(ByteArray(static_cast<uint32_t>(s.size()),
+                               reinterpret_cast<const uint8_t*>(s.data())));
+  }
+
+  EncoderType encoder(nullptr);
+  DecoderType decoder(nullptr);
+  encoder.Put(values.data(), static_cast<int>(values.size()));
+  std::shared_ptr<Buffer> buffer = encoder.FlushValues();
+
+  int num_values = static_cast<int>(values.size());
+  decoder.SetData(num_values, buffer->data(), static_cast<int>(buffer->size()));
+  std::vector<ByteArray> decoded(values.size());
+  int values_decoded = 0;
+  while (values_decoded < num_values) {
+    int batch_size = decoder.Decode(decoded.data() + values_decoded, 3);
+    ASSERT_GT(batch_size, 0);
+    values_decoded += batch_size;
+  }
+  for (int i = 0; i < num_values; ++i) {
+    ASSERT_EQ(values[i], decoded[i]) << i;
+  }
+}
+
+std::vector<std::string> DeltaByteArrayExampleStrings() {
+  std::vector<std::string> strings = {"",        "myxa",    "myxophyta", "myxopod",
+                                      "nab",     "nabbed",  "nabbing",   "nabit",
+                                      "nabk",    "nabob",   "nacarat",   "nacelle",
+                                      "nacelle", "",        "z"};
+  // Enough values for several delta blocks
+  for (int i = 0; i < 1000; ++i) {
+    strings.push_back("prefix-" + std::to_string(i % 100) + "-" + std::to_string(i));
+  }
+  return strings;
+}
+
+TEST(TestDeltaLengthByteArrayEncoding, BasicRoundTrip) {
+  CheckByteArrayRoundtrip<DeltaLengthByteArrayEncoder, DeltaLengthByteArrayDecoder>(
+      DeltaByteArrayExampleStrings());
+}
+
+TEST(TestDeltaByteArrayEncoding, BasicRoundTrip) {
+  CheckByteArrayRoundtrip<DeltaByteArrayEncoder, DeltaByteArrayDecoder>(
+      DeltaByteArrayExampleStrings());
+}
+
 }  // namespace test
 
 }  // namespace parquet
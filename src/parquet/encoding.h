@@ -18,6 +18,7 @@
 #ifndef PARQUET_ENCODING_H
 #define PARQUET_ENCODING_H
 
+#include <algorithm>
 #include <cstdint>
 #include <memory>
 #include <sstream>
@@ -29,6 +30,7 @@
 #include "parquet/schema.h"
 #include "parquet/types.h"
 #include "parquet/util/memory.h"
+#include "parquet/util/spacing.h"
 
 namespace parquet {
 
@@ -84,6 +86,16 @@ class Encoder {
   ::arrow::MemoryPool* pool_;
 };
 
+// The values of a dictionary page, decoded into an array of the column's
+// c_type. The ByteArray / FixedLenByteArray values point into byte_array_data
+struct DecodedDictionary {
+  DecodedDictionary() : num_values(0) {}
+
+  std::shared_ptr<Buffer> values;
+  std::shared_ptr<Buffer> byte_array_data;
+  int num_values;
+};
+
 // The Decoder template is parameterized on parquet::DataType subclasses
 template <typename DType>
 class Decoder {
@@ -119,16 +131,27 @@ class Decoder {
     memset(buffer + values_read, 0, (num_values - values_read) * sizeof(T));
 
     // Add spacing for null entries. As we have filled the buffer from the front,
-    // we need to add the spacing from the back.
-    int values_to_move = values_read;
-    for (int i = num_values - 1; i >= 0; i--) {
-      if (::arrow::BitUtil::GetBit(valid_bits, valid_bits_offset + i)) {
-        buffer[i] = buffer[--values_to_move];
-      }
-    }
+    // the values are moved to their slots from the back.
+    internal::SpaceValues(buffer, num_values, null_count, valid_bits, valid_bits_offset);
     return num_values;
   }
 
+  // Skip up to num_values values of this data page, returns the number of
+  // values skipped. Decoders that can advance without decoding the values
+  // override this.
+  virtual int Skip(int num_values) {
+    static constexpr int kBatchSize = 256;
+    T scratch[kBatchSize];
+    int values_skipped = 0;
+    while (values_skipped < num_values) {
+      const int batch_size = std::min(kBatchSize, num_values - values_skipped);
+      const int values_decoded = Decode(scratch, batch_size);
+      if (values_decoded == 0) break;
+      values_skipped += values_decoded;
+    }
+    return values_skipped;
+  }
+
   // Returns the number of values left (for the last call to SetData()). This is
   // the number of values left in this page.
   int values_left() const { return num_values_; }
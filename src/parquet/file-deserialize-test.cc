@@ -69,11 +69,13 @@ class TestPageSerde : public ::testing::Test {
   }
 
   void InitSerializedPageReader(int64_t num_rows,
-                                Compression::type codec = Compression::UNCOMPRESSED) {
+                                Compression::type codec = Compression::UNCOMPRESSED,
+                                int64_t read_ahead_pages = 0) {
     EndStream();
     std::unique_ptr<InputStream> stream;
     stream.reset(new InMemoryInputStream(out_buffer_));
-    page_reader_ = PageReader::Open(std::move(stream), num_rows, codec);
+    page_reader_ = PageReader::Open(std::move(stream), num_rows, codec,
+                                    ::arrow::default_memory_pool(), read_ahead_pages);
   }
 
   void WriteDataPageHeader(int max_serialized_len = 1024, int32_t uncompressed_size = 0,
@@ -177,6 +179,27 @@ TEST_F(TestPageSerde, TestFailLargePageHeaders) {
   ASSERT_THROW(page_reader_->NextPage(), ParquetException);
 }
 
+TEST_F(TestPageSerde, TestPageHeadersOfMixedSizes) {
+  // Small headers around ones that do not fit into the first window of
+  // kDefaultPageHeaderSize bytes, all read by the same page reader
+  const std::vector<int> stats_sizes = {16, 64 * 1024, 16, 16 * 1024, 32, 200 * 1024, 8};
+  std::vector<format::DataPageHeader> headers;
+  for (size_t i = 0; i < stats_sizes.size(); ++i) {
+    AddDummyStats(stats_sizes[i], data_page_header_);
+    data_page_header_.num_values = static_cast<int32_t>(i + 1);
+    WriteDataPageHeader(512 * 1024);
+    headers.push_back(data_page_header_);
+  }
+
+  InitSerializedPageReader(static_cast<int64_t>(stats_sizes.size() * 10));
+  for (const format::DataPageHeader& header : headers) {
+    std::shared_ptr<Page> current_page = page_reader_->NextPage();
+    ASSERT_NE(nullptr, current_page);
+    CheckDataPageHeader(header, current_page.get());
+  }
+  ASSERT_EQ(nullptr, page_reader_->NextPage());
+}
+
 TEST_F(TestPageSerde, Compression) {
   Compression::type codec_types[5] = {Compression::GZIP, Compression::SNAPPY,
                                       Compression::BROTLI, Compression::LZ4,
@@ -229,6 +252,226 @@ TEST_F(TestPageSerde, Compression) {
   }
 }
 
+TEST_F(TestPageSerde, CompressionReadAhead) {
+  const int32_t num_rows = 32;  // dummy value
+  data_page_header_.num_values = num_rows;
+
+  const int num_pages = 10;
+  std::unique_ptr<::arrow::Codec> codec = GetCodecFromArrow(Compression::SNAPPY);
+
+  std::vector<std::vector<uint8_t>> faux_data(num_pages);
+  std::vector<uint8_t> buffer;
+  for (int i = 0; i < num_pages; ++i) {
+    int data_size = (i + 1) * 64;
+    test::random_bytes(data_size, i, &faux_data[i]);
+    const uint8_t* data = faux_data[i].data();
+
+    int64_t max_compressed_size = codec->MaxCompressedLen(data_size, data);
+    buffer.resize(max_compressed_size);
+
+    int64_t actual_size;
+    ASSERT_OK(
+        codec->Compress(data_size, data, max_compressed_size, &buffer[0], &actual_size));
+
+    WriteDataPageHeader(1024, data_size, static_cast<int32_t>(actual_size));
+    out_stream_->Write(buffer.data(), actual_size);
+  }
+
+  InitSerializedPageReader(num_rows * num_pages, Compression::SNAPPY, 3);
+
+  // Read-ahead pages own their data, so they remain valid after the
+  // following pages have been read
+  std::vector<std::shared_ptr<Page>> pages;
+  for (int i = 0; i < num_pages; ++i) {
+    pages.push_back(page_reader_->NextPage());
+    ASSERT_NE(nullptr, pages.back());
+  }
+  ASSERT_EQ(nullptr, page_reader_->NextPage());
+  ASSERT_EQ(nullptr, page_reader_->NextPage());
+
+  for (int i = 0; i < num_pages; ++i) {
+    int data_size = static_cast<int>(faux_data[i].size());
+    const DataPage* data_page = static_cast<const DataPage*>(pages[i].get());
+    ASSERT_EQ(data_size, data_page->size());
+    ASSERT_EQ(0, memcmp(faux_data[i].data(), data_page->data(), data_size));
+  }
+}
+
+TEST_F(TestPageSerde, SharedPageBuffers) {
+  const int32_t num_rows = 32;  // dummy value
+  data_page_header_.num_values = num_rows;
+
+  const int num_pages = 4;
+  std::unique_ptr<::arrow::Codec> codec = GetCodecFromArrow(Compression::SNAPPY);
+
+  std::vector<std::vector<uint8_t>> faux_data(num_pages);
+  std::vector<uint8_t> buffer;
+  for (int i = 0; i < num_pages; ++i) {
+    int data_size = (i + 1) * 64;
+    test::random_bytes(data_size, i, &faux_data[i]);
+    const uint8_t* data = faux_data[i].data();
+
+    int64_t max_compressed_size = codec->MaxCompressedLen(data_size, data);
+    buffer.resize(max_compressed_size);
+
+    int64_t actual_size;
+    ASSERT_OK(
+        codec->Compress(data_size, data, max_compressed_size, &buffer[0], &actual_size));
+
+    WriteDataPageHeader(1024, data_size, static_cast<int32_t>(actual_size));
+    out_stream_->Write(buffer.data(), actual_size);
+  }
+
+  InitSerializedPageReader(num_rows * num_pages, Compression::SNAPPY);
+  // The decompression buffer is reused by default
+  std::shared_ptr<Page> page = page_reader_->NextPage();
+  ASSERT_FALSE(page->is_buffer_shared());
+
+  page_reader_->set_reuse_decompression_buffer(false);
+  std::vector<std::shared_ptr<Page>> pages;
+  for (int i = 1; i < num_pages; ++i) {
+    pages.push_back(page_reader_->NextPage());
+    ASSERT_TRUE(pages.back()->is_buffer_shared());
+  }
+  for (int i = 1; i < num_pages; ++i) {
+    int data_size = static_cast<int>(faux_data[i].size());
+    const Page* data_page = pages[i - 1].get();
+    ASSERT_EQ(data_size, data_page->size());
+    ASSERT_EQ(0, memcmp(faux_data[i].data(), data_page->data(), data_size));
+  }
+
+  // Uncompressed pages are slices of the stream's buffer
+  ResetStream();
+  WriteDataPageHeader(1024, 64, 64);
+  out_stream_->Write(faux_data[0].data(), 64);
+  InitSerializedPageReader(num_rows);
+  page = page_reader_->NextPage();
+  ASSERT_TRUE(page->is_buffer_shared());
+  ASSERT_EQ(0, memcmp(faux_data[0].data(), page->data(), 64));
+}
+
+TEST_F(TestPageSerde, DataPageFilter) {
+  const int num_pages = 4;
+  const int32_t num_values = 32;
+  data_page_header_.num_values = num_values;
+  data_page_header_.__isset.statistics = true;
+
+  std::unique_ptr<::arrow::Codec> codec = GetCodecFromArrow(Compression::SNAPPY);
+
+  std::vector<std::vector<uint8_t>> faux_data(num_pages);
+  std::vector<uint8_t> buffer;
+  for (int i = 0; i < num_pages; ++i) {
+    int data_size = (i + 1) * 64;
+    test::random_bytes(data_size, i, &faux_data[i]);
+    const uint8_t* data = faux_data[i].data();
+
+    int64_t max_compressed_size = codec->MaxCompressedLen(data_size, data);
+    buffer.resize(max_compressed_size);
+
+    int64_t actual_size;
+    ASSERT_OK(
+        codec->Compress(data_size, data, max_compressed_size, &buffer[0], &actual_size));
+
+    data_page_header_.statistics.__set_max(std::to_string(i));
+    WriteDataPageHeader(1024, data_size, static_cast<int32_t>(actual_size));
+    out_stream_->Write(buffer.data(), actual_size);
+  }
+
+  for (int64_t read_ahead_pages : {0, 2}) {
+    InitSerializedPageReader(num_values * num_pages, Compression::SNAPPY,
+                             read_ahead_pages);
+
+    // Skip the pages in the middle
+    std::vector<std::string> seen_stats;
+    page_reader_->set_data_page_filter([&](const DataPageStats& stats) {
+      EXPECT_EQ(num_values, stats.num_values);
+      EXPECT_EQ(-1, stats.num_rows);
+      seen_stats.push_back(stats.encoded_statistics->max());
+      return stats.encoded_statistics->max() == "1" ||
+             stats.encoded_statistics->max() == "2";
+    });
+
+    for (int i : {0, 3}) {
+      std::shared_ptr<Page> page = page_reader_->NextPage();
+      ASSERT_NE(nullptr, page);
+      const DataPage* data_page = static_cast<const DataPage*>(page.get());
+      int data_size = static_cast<int>(faux_data[i].size());
+      ASSERT_EQ(std::to_string(i), data_page->statistics().max());
+      ASSERT_EQ(data_size, data_page->size());
+      ASSERT_EQ(0, memcmp(faux_data[i].data(), data_page->data(), data_size));
+    }
+    ASSERT_EQ(nullptr, page_reader_->NextPage());
+    ASSERT_EQ(std::vector<std::string>({"0", "1", "2", "3"}), seen_stats);
+  }
+}
+
+TEST_F(TestPageSerde, SkipDataPages) {
+  const int num_pages = 4;
+  const int32_t num_values = 32;
+  data_page_header_.num_values = num_values;
+
+  std::unique_ptr<::arrow::Codec> codec = GetCodecFromArrow(Compression::SNAPPY);
+
+  std::vector<uint8_t> faux_data;
+  std::vector<uint8_t> buffer;
+  for (int i = 0; i < num_pages; ++i) {
+    int data_size = (i + 1) * 64;
+    faux_data.clear();
+    test::random_bytes(data_size, i, &faux_data);
+    int64_t max_compressed_size = codec->MaxCompressedLen(data_size, faux_data.data());
+    buffer.resize(max_compressed_size);
+
+    int64_t actual_size;
+    ASSERT_OK(codec->Compress(data_size, faux_data.data(), max_compressed_size,
+                              &buffer[0], &actual_size));
+    WriteDataPageHeader(1024, data_size, static_cast<int32_t>(actual_size));
+    out_stream_->Write(buffer.data(), actual_size);
+  }
+
+  for (int64_t read_ahead_pages : {0, 2}) {
+    InitSerializedPageReader(num_values * num_pages, Compression::SNAPPY,
+                             read_ahead_pages);
+
+    // Only the pages that fit entirely are skipped
+    ASSERT_EQ(2 * num_values, page_reader_->SkipDataPages(3 * num_values - 1));
+    ASSERT_EQ(0, page_reader_->SkipDataPages(num_values - 1));
+
+    std::shared_ptr<Page> page = page_reader_->NextPage();
+    ASSERT_NE(nullptr, page);
+    ASSERT_EQ(3 * 64, static_cast<const DataPage*>(page.get())->size());
+    page = page_reader_->NextPage();
+    ASSERT_NE(nullptr, page);
+    ASSERT_EQ(4 * 64, static_cast<const DataPage*>(page.get())->size());
+    ASSERT_EQ(nullptr, page_reader_->NextPage());
+  }
+}
+
+TEST_F(TestPageSerde, SkipDictionaryDataPages) {
+  const int num_pages = 4;
+  const int32_t num_values = 32;
+  data_page_header_.num_values = num_values;
+
+  // The first two pages are dictionary encoded, the others fell back to PLAIN
+  std::vector<uint8_t> faux_data;
+  for (int i = 0; i < num_pages; ++i) {
+    int data_size = (i + 1) * 64;
+    faux_data.clear();
+    test::random_bytes(data_size, i, &faux_data);
+    data_page_header_.encoding =
+        i < 2 ? format::Encoding::RLE_DICTIONARY : format::Encoding::PLAIN;
+    WriteDataPageHeader(1024, data_size, data_size);
+    out_stream_->Write(faux_data.data(), data_size);
+  }
+
+  InitSerializedPageReader(num_values * num_pages, Compression::UNCOMPRESSED);
+  ASSERT_EQ(2 * num_values, page_reader_->SkipDictionaryDataPages(4 * num_values));
+  ASSERT_EQ(0, page_reader_->SkipDictionaryDataPages(4 * num_values));
+
+  std::shared_ptr<Page> page = page_reader_->NextPage();
+  ASSERT_NE(nullptr, page);
+  ASSERT_EQ(3 * 64, static_cast<const DataPage*>(page.get())->size());
+}
+
 TEST_F(TestPageSerde, LZONotSupported) {
   // Must await PARQUET-530
   int data_size = 1024;
@@ -21,10 +21,13 @@
 #include "parquet/column_writer.h"
 #include "parquet/file_reader.h"
 #include "parquet/file_writer.h"
+#include "parquet/read_metrics.h"
+#include "parquet/sorted_search.h"
 #include "parquet/test-specialization.h"
 #include "parquet/test-util.h"
 #include "parquet/types.h"
 #include "parquet/util/memory.h"
+#include "parquet/util/thread-pool.h"
 
 namespace parquet {
 
@@ -51,11 +54,16 @@ class TestSerialize : public PrimitiveTypedTest<TestType> {
   int num_rowgroups_;
   int rows_per_rowgroup_;
 
-  void FileSerializeTest(Compression::type codec_type) {
+  void FileSerializeTest(Compression::type codec_type, bool buffered = false,
+                         bool async_write = false) {
     std::shared_ptr<InMemoryOutputStream> sink(new InMemoryOutputStream());
     auto gnode = std::static_pointer_cast<GroupNode>(this->node_);
 
     WriterProperties::Builder prop_builder;
+    if (async_write) {
+      // Small blocks so that the writer waits for the background thread
+      prop_builder.async_write_budget(256)->async_write_block_size(64);
+    }
 
     for (int i = 0; i < num_columns_; ++i) {
       prop_builder.compression(this->schema_.Column(i)->name(), codec_type);
@@ -65,14 +73,26 @@ class TestSerialize : public PrimitiveTypedTest<TestType> {
     auto file_writer = ParquetFileWriter::Open(sink, gnode, writer_properties);
     for (int rg = 0; rg < num_rowgroups_; ++rg) {
       RowGroupWriter* row_group_writer;
-      row_group_writer = file_writer->AppendRowGroup();
       this->GenerateData(rows_per_rowgroup_);
-      for (int col = 0; col < num_columns_; ++col) {
-        auto column_writer =
-            static_cast<TypedColumnWriter<TestType>*>(row_group_writer->NextColumn());
-        column_writer->WriteBatch(rows_per_rowgroup_, this->def_levels_.data(), nullptr,
-                                  this->values_ptr_);
-        column_writer->Close();
+      if (buffered) {
+        row_group_writer = file_writer->AppendBufferedRowGroup();
+        // The columns of a buffered row group can be written in any order,
+        // they are stored in schema order
+        for (int col = num_columns_ - 1; col >= 0; --col) {
+          auto column_writer =
+              static_cast<TypedColumnWriter<TestType>*>(row_group_writer->column(col));
+          column_writer->WriteBatch(rows_per_rowgroup_, this->def_levels_.data(),
+                                    nullptr, this->values_ptr_);
+        }
+      } else {
+        row_group_writer = file_writer->AppendRowGroup();
+        for (int col = 0; col < num_columns_; ++col) {
+          auto column_writer =
+              static_cast<TypedColumnWriter<TestType>*>(row_group_writer->NextColumn());
+          column_writer->WriteBatch(rows_per_rowgroup_, this->def_levels_.data(),
+                                    nullptr, this->values_ptr_);
+          column_writer->Close();
+        }
       }
 
       row_group_writer->Close();
@@ -113,7 +133,8 @@ class TestSerialize : public PrimitiveTypedTest<TestType> {
     }
   }
 
-  void UnequalNumRows(int64_t max_rows, const std::vector<int64_t> rows_per_column) {
+  void UnequalNumRows(int64_t max_rows, const std::vector<int64_t> rows_per_column,
+                      bool buffered = false) {
     std::shared_ptr<InMemoryOutputStream> sink(new InMemoryOutputStream());
     auto gnode = std::static_pointer_cast<GroupNode>(this->node_);
 
@@ -122,20 +143,49 @@ class TestSerialize : public PrimitiveTypedTest<TestType> {
     auto file_writer = ParquetFileWriter::Open(sink, gnode, props);
 
     RowGroupWriter* row_group_writer;
-    row_group_writer = file_writer->AppendRowGroup();
+    row_group_writer =
+        buffered ? file_writer->AppendBufferedRowGroup() : file_writer->AppendRowGroup();
 
     this->GenerateData(max_rows);
     for (int col = 0; col < num_columns_; ++col) {
-      auto column_writer =
-          static_cast<TypedColumnWriter<TestType>*>(row_group_writer->NextColumn());
+      auto column_writer = static_cast<TypedColumnWriter<TestType>*>(
+          buffered ? row_group_writer->column(col) : row_group_writer->NextColumn());
       column_writer->WriteBatch(rows_per_column[col], this->def_levels_.data(), nullptr,
                                 this->values_ptr_);
-      column_writer->Close();
+      if (!buffered) {
+        column_writer->Close();
+      }
     }
     row_group_writer->Close();
     file_writer->Close();
   }
 
+  void BufferedNumRowsWhileWriting() {
+    std::shared_ptr<InMemoryOutputStream> sink(new InMemoryOutputStream());
+    auto gnode = std::static_pointer_cast<GroupNode>(this->node_);
+    auto file_writer =
+        ParquetFileWriter::Open(sink, gnode, WriterProperties::Builder().build());
+    RowGroupWriter* row_group_writer = file_writer->AppendBufferedRowGroup();
+
+    // The columns are filled one after the other, their counts differ until
+    // the last one is written
+    this->GenerateData(rows_per_rowgroup_);
+    for (int col = 0; col < num_columns_; ++col) {
+      auto column_writer =
+          static_cast<TypedColumnWriter<TestType>*>(row_group_writer->column(col));
+      column_writer->WriteBatch(rows_per_rowgroup_, this->def_levels_.data(), nullptr,
+                                this->values_ptr_);
+      ASSERT_EQ(rows_per_rowgroup_, row_group_writer->num_rows());
+    }
+    ASSERT_NO_THROW(row_group_writer->Close());
+    ASSERT_EQ(rows_per_rowgroup_, row_group_writer->num_rows());
+    file_writer->Close();
+
+    auto source = std::make_shared<::arrow::io::BufferReader>(sink->GetBuffer());
+    auto file_reader = ParquetFileReader::Open(source);
+    ASSERT_EQ(rows_per_rowgroup_, file_reader->metadata()->num_rows());
+  }
+
   void RepeatedUnequalRows() {
     // Optional and repeated, so definition and repetition levels
     this->SetUpSchema(Repetition::REPEATED);
@@ -197,6 +247,15 @@ TYPED_TEST(TestSerialize, TooManyRows) {
   ASSERT_THROW(this->UnequalNumRows(101, num_rows), ParquetException);
 }
 
+TYPED_TEST(TestSerialize, BufferedTooFewRows) {
+  std::vector<int64_t> num_rows = {100, 100, 100, 99};
+  ASSERT_THROW(this->UnequalNumRows(100, num_rows, true), ParquetException);
+}
+
+TYPED_TEST(TestSerialize, BufferedNumRowsWhileWriting) {
+  this->BufferedNumRowsWhileWriting();
+}
+
 TYPED_TEST(TestSerialize, RepeatedTooFewRows) {
   ASSERT_THROW(this->RepeatedUnequalRows(), ParquetException);
 }
@@ -215,6 +274,509 @@ TYPED_TEST(TestSerialize, SmallFileLz4) { this->FileSerializeTest(Compression::L
 
 TYPED_TEST(TestSerialize, SmallFileZstd) { this->FileSerializeTest(Compression::ZSTD); }
 
+TYPED_TEST(TestSerialize, SmallFileBufferedUncompressed) {
+  this->FileSerializeTest(Compression::UNCOMPRESSED, true);
+}
+
+TYPED_TEST(TestSerialize, SmallFileBufferedSnappy) {
+  this->FileSerializeTest(Compression::SNAPPY, true);
+}
+
+TYPED_TEST(TestSerialize, SmallFileAsyncWrite) {
+  this->FileSerializeTest(Compression::UNCOMPRESSED, false, true);
+  this->FileSerializeTest(Compression::SNAPPY, true, true);
+}
+
+// Write two INT64 columns holding the row index, one PLAIN and one dictionary
+// encoded, in pages of a few dozen rows each
+static std::shared_ptr<Buffer> WritePagedFile(bool buffered, int64_t num_rows) {
+  std::shared_ptr<InMemoryOutputStream> sink(new InMemoryOutputStream());
+  auto gnode = std::static_pointer_cast<GroupNode>(GroupNode::Make(
+      "schema", Repetition::REQUIRED,
+      {schema::Int64("plain", Repetition::REQUIRED),
+       schema::Int64("dict", Repetition::REQUIRED)}));
+  std::shared_ptr<WriterProperties> properties = WriterProperties::Builder()
+                                                     .disable_dictionary("plain")
+                                                     ->data_pagesize(256)
+                                                     ->write_batch_size(10)
+                                                     ->build();
+
+  std::vector<int64_t> values(num_rows);
+  for (int64_t i = 0; i < num_rows; ++i) {
+    values[i] = i;
+  }
+
+  auto file_writer = ParquetFileWriter::Open(sink, gnode, properties);
+  RowGroupWriter* row_group_writer =
+      buffered ? file_writer->AppendBufferedRowGroup() : file_writer->AppendRowGroup();
+  for (int col = 0; col < 2; ++col) {
+    auto column_writer = static_cast<Int64Writer*>(
+        buffered ? row_group_writer->column(col) : row_group_writer->NextColumn());
+    column_writer->WriteBatch(num_rows, nullptr, nullptr, values.data());
+  }
+  row_group_writer->Close();
+  file_writer->Close();
+  return sink->GetBuffer();
+}
+
+TEST(TestPageIndex, SeekToRow) {
+  const int64_t num_rows = 1000;
+  for (bool buffered : {false, true}) {
+    auto source =
+        std::make_shared<::arrow::io::BufferReader>(WritePagedFile(buffered, num_rows));
+    auto file_reader = ParquetFileReader::Open(source);
+    auto rg_reader = file_reader->RowGroup(0);
+
+    for (int col = 0; col < 2; ++col) {
+      std::unique_ptr<OffsetIndex> offset_index = rg_reader->GetOffsetIndex(col);
+      std::unique_ptr<ColumnIndex> column_index = rg_reader->GetColumnIndex(col);
+      ASSERT_NE(nullptr, offset_index);
+      ASSERT_NE(nullptr, column_index);
+      ASSERT_GT(offset_index->num_pages(), 2);
+      ASSERT_EQ(offset_index->num_pages(), column_index->num_pages());
+      ASSERT_TRUE(column_index->has_null_counts());
+
+      const std::vector<PageLocation>& pages = offset_index->page_locations();
+      ASSERT_EQ(0, pages[0].first_row_index);
+      for (int i = 0; i < offset_index->num_pages(); ++i) {
+        int64_t last_row =
+            i + 1 < offset_index->num_pages() ? pages[i + 1].first_row_index : num_rows;
+        int64_t min_value, max_value;
+        ASSERT_EQ(sizeof(int64_t), column_index->encoded_min_values()[i].size());
+        memcpy(&min_value, column_index->encoded_min_values()[i].data(), sizeof(int64_t));
+        memcpy(&max_value, column_index->encoded_max_values()[i].data(), sizeof(int64_t));
+        ASSERT_FALSE(column_index->null_pages()[i]);
+        ASSERT_EQ(0, column_index->null_counts()[i]);
+        ASSERT_EQ(pages[i].first_row_index, min_value);
+        ASSERT_EQ(last_row - 1, max_value);
+        ASSERT_EQ(i, offset_index->FindPage(pages[i].first_row_index));
+        ASSERT_EQ(i, offset_index->FindPage(last_row - 1));
+      }
+
+      // Only the pages covering rows [500, 510) are read
+      int64_t first_row_index;
+      std::unique_ptr<PageReader> pager =
+          rg_reader->GetColumnPageReader(col, 500, 510, &first_row_index);
+      int page = offset_index->FindPage(500);
+      ASSERT_EQ(pages[page].first_row_index, first_row_index);
+
+      auto column_reader = std::static_pointer_cast<Int64Reader>(ColumnReader::Make(
+          file_reader->metadata()->schema()->Column(col), std::move(pager)));
+      ASSERT_EQ(500 - first_row_index, column_reader->Skip(500 - first_row_index));
+      std::vector<int64_t> values(10);
+      int64_t values_read;
+      ASSERT_EQ(10, column_reader->ReadBatch(10, nullptr, nullptr, values.data(),
+                                             &values_read));
+      for (int64_t i = 0; i < 10; ++i) {
+        ASSERT_EQ(500 + i, values[i]);
+      }
+      // The reader stops after the last page covering the range
+      int64_t rows_left = 0;
+      while (column_reader->HasNext()) {
+        rows_left += column_reader->Skip(num_rows);
+      }
+      ASSERT_LT(rows_left, num_rows - 510);
+    }
+  }
+}
+
+// Write a BYTE_ARRAY column with a row group per entry of row_groups
+static std::shared_ptr<Buffer> WriteStringRowGroups(
+    bool buffered, bool reuse_dictionary,
+    const std::vector<std::vector<std::string>>& row_groups,
+    std::shared_ptr<FileMetaData>* metadata = nullptr,
+    const std::string& created_by = DEFAULT_CREATED_BY) {
+  std::shared_ptr<InMemoryOutputStream> sink(new InMemoryOutputStream());
+  auto gnode = std::static_pointer_cast<GroupNode>(GroupNode::Make(
+      "schema", Repetition::REQUIRED,
+      {schema::ByteArray("s", Repetition::REQUIRED)}));
+  WriterProperties::Builder builder;
+  builder.created_by(created_by);
+  if (reuse_dictionary) {
+    builder.enable_dictionary_reuse();
+  }
+
+  auto file_writer = ParquetFileWriter::Open(sink, gnode, builder.build());
+  for (const std::vector<std::string>& strings : row_groups) {
+    std::vector<ByteArray> values;
+    for (const std::string& value : strings) {
+      values.push_back(ByteArray(static_cast<uint32_t>(value.size()),
+                                 reinterpret_cast<const uint8_t*>(value.data())));
+    }
+    RowGroupWriter* row_group_writer =
+        buffered ? file_writer->AppendBufferedRowGroup() : file_writer->AppendRowGroup();
+    auto column_writer = static_cast<ByteArrayWriter*>(
+        buffered ? row_group_writer->column(0) : row_group_writer->NextColumn());
+    column_writer->WriteBatch(static_cast<int64_t>(values.size()), nullptr, nullptr,
+                              values.data());
+    row_group_writer->Close();
+  }
+  file_writer->Close();
+  if (metadata) {
+    *metadata = file_writer->metadata();
+  }
+  return sink->GetBuffer();
+}
+
+TEST(TestDictionaryReuse, SeedsNextRowGroup) {
+  const std::vector<std::vector<std::string>> row_groups = {
+      {"a", "b", "c", "a", "b"}, {"c", "a", "c"}, {"d", "a"}};
+  for (bool buffered : {false, true}) {
+    for (bool reuse_dictionary : {false, true}) {
+      auto source = std::make_shared<::arrow::io::BufferReader>(
+          WriteStringRowGroups(buffered, reuse_dictionary, row_groups));
+      auto file_reader = ParquetFileReader::Open(source);
+      ASSERT_EQ(3, file_reader->metadata()->num_row_groups());
+
+      std::vector<std::string> dictionary_pages;
+      std::vector<int32_t> dictionary_sizes;
+      for (int rg = 0; rg < 3; ++rg) {
+        auto rg_reader = file_reader->RowGroup(rg);
+        std::unique_ptr<PageReader> pager = rg_reader->GetColumnPageReader(0);
+        std::shared_ptr<Page> page = pager->NextPage();
+        ASSERT_EQ(PageType::DICTIONARY_PAGE, page->type());
+        dictionary_pages.push_back(
+            std::string(reinterpret_cast<const char*>(page->data()), page->size()));
+        dictionary_sizes.push_back(
+            static_cast<const DictionaryPage*>(page.get())->num_values());
+
+        auto column_reader =
+            std::static_pointer_cast<ByteArrayReader>(rg_reader->Column(0));
+        std::vector<ByteArray> values(row_groups[rg].size());
+        int64_t values_read;
+        column_reader->ReadBatch(static_cast<int64_t>(values.size()), nullptr, nullptr,
+                                 values.data(), &values_read);
+        ASSERT_EQ(static_cast<int64_t>(values.size()), values_read);
+        for (size_t i = 0; i < values.size(); ++i) {
+          ASSERT_EQ(row_groups[rg][i],
+                    std::string(reinterpret_cast<const char*>(values[i].ptr),
+                                values[i].len));
+        }
+      }
+
+      if (reuse_dictionary) {
+        // The second row group has no new values and the third adds one
+        ASSERT_EQ(std::vector<int32_t>({3, 3, 4}), dictionary_sizes);
+        ASSERT_EQ(dictionary_pages[0], dictionary_pages[1]);
+        ASSERT_EQ(dictionary_pages[1],
+                  dictionary_pages[2].substr(0, dictionary_pages[1].size()));
+      } else {
+        ASSERT_EQ(std::vector<int32_t>({3, 2, 2}), dictionary_sizes);
+        ASSERT_NE(dictionary_pages[0], dictionary_pages[1]);
+      }
+    }
+  }
+}
+
+TEST(TestReadMetrics, CountsColumnReads) {
+  const std::vector<std::vector<std::string>> row_groups = {
+      {"a", "b", "c", "a", "b"}, {"c", "a", "c"}, {"d", "a"}};
+  auto source = std::make_shared<::arrow::io::BufferReader>(
+      WriteStringRowGroups(false, false, row_groups));
+  ReaderProperties properties = default_reader_properties();
+  auto metrics = std::make_shared<ReadMetrics>();
+  properties.set_read_metrics(metrics);
+  auto file_reader = ParquetFileReader::Open(source, properties);
+
+  int64_t total_compressed_size = 0;
+  for (int rg = 0; rg < 3; ++rg) {
+    auto rg_reader = file_reader->RowGroup(rg);
+    total_compressed_size +=
+        rg_reader->metadata()->ColumnChunk(0)->total_compressed_size();
+    auto column_reader = std::static_pointer_cast<ByteArrayReader>(rg_reader->Column(0));
+    std::vector<ByteArray> values(row_groups[rg].size());
+    int64_t values_read;
+    column_reader->ReadBatch(static_cast<int64_t>(values.size()), nullptr, nullptr,
+                             values.data(), &values_read);
+    ASSERT_EQ(static_cast<int64_t>(values.size()), values_read);
+    ASSERT_FALSE(column_reader->HasNext());
+  }
+
+  std::map<std::string, ColumnReadMetrics> columns = metrics->Get();
+  ASSERT_EQ(1U, columns.size());
+  const ColumnReadMetrics& column = columns["s"];
+  ASSERT_EQ(total_compressed_size, column.bytes_read);
+  ASSERT_EQ(3, column.num_dictionary_pages);
+  ASSERT_EQ(3, column.num_data_pages);
+  ASSERT_EQ(0, column.num_dictionary_fallback_pages);
+  ASSERT_GE(column.io_nanos, 0);
+  ASSERT_GE(column.value_decode_nanos, 0);
+}
+
+TEST(TestScanFileContents, Parallel) {
+  const std::vector<std::vector<std::string>> row_groups = {
+      {"a", "b", "c", "a", "b"}, {"c", "a", "c"}, {}, {"d", "a"}};
+  auto source = std::make_shared<::arrow::io::BufferReader>(
+      WriteStringRowGroups(false, false, row_groups));
+  auto file_reader = ParquetFileReader::Open(source);
+  ThreadPool pool(2);
+  ASSERT_EQ(10, ScanFileContents({}, 2, file_reader.get()));
+  ASSERT_EQ(10, ScanFileContents({}, 2, file_reader.get(), 4, &pool));
+  ASSERT_EQ(10, ScanFileContents({0}, 3, file_reader.get(), 1));
+}
+
+TEST(TestMetaDataFile, CombinesFiles) {
+  std::shared_ptr<FileMetaData> a_metadata, b_metadata;
+  WriteStringRowGroups(false, false, {{"a", "b"}, {"c"}}, &a_metadata);
+  auto b = WriteStringRowGroups(false, false, {{"d", "e", "f"}}, &b_metadata);
+  ASSERT_EQ(2, a_metadata->num_row_groups());
+  // The metadata kept by the writer is the footer of the file
+  auto b_footer = ReadMetaData(std::make_shared<::arrow::io::BufferReader>(b));
+  ASSERT_EQ(b_footer->size(), b_metadata->size());
+  ASSERT_EQ(b_footer->RowGroup(0)->ColumnChunk(0)->data_page_offset(),
+            b_metadata->RowGroup(0)->ColumnChunk(0)->data_page_offset());
+
+  // Lazily decoded metadata, e.g. from a cache, is combined the same way
+  InMemoryOutputStream a_footer;
+  a_metadata->WriteTo(&a_footer);
+  std::shared_ptr<Buffer> a_serialized = a_footer.GetBuffer();
+  uint32_t a_len = static_cast<uint32_t>(a_serialized->size());
+  auto a_lazy = FileMetaData::Make(a_serialized->data(), &a_len, true);
+
+  for (const std::shared_ptr<FileMetaData>& a : {a_metadata, a_lazy}) {
+    auto summary = FileMetaData::Combine({a, b_metadata}, {"part-0", "part-1"});
+    InMemoryOutputStream sink;
+    WriteMetaDataFile(*summary, &sink);
+    auto metadata = ReadMetaData(std::make_shared<::arrow::io::BufferReader>(
+        sink.GetBuffer()));
+
+    ASSERT_EQ(6, metadata->num_rows());
+    ASSERT_EQ(3, metadata->num_row_groups());
+    ASSERT_TRUE(metadata->schema()->Equals(*b_metadata->schema()));
+    const std::vector<std::string> paths = {"part-0", "part-0", "part-1"};
+    const std::vector<int64_t> num_rows = {2, 1, 3};
+    for (int rg = 0; rg < 3; ++rg) {
+      auto row_group = metadata->RowGroup(rg);
+      ASSERT_EQ(num_rows[rg], row_group->num_rows());
+      ASSERT_EQ(paths[rg], row_group->ColumnChunk(0)->file_path());
+    }
+    // The offsets of the column chunks are those in the referenced files
+    ASSERT_EQ(b_metadata->RowGroup(0)->ColumnChunk(0)->data_page_offset(),
+              metadata->RowGroup(2)->ColumnChunk(0)->data_page_offset());
+  }
+
+  ASSERT_THROW(FileMetaData::Combine({}, {}), ParquetException);
+  ASSERT_THROW(FileMetaData::Combine({a_metadata}, {}), ParquetException);
+}
+
+// Returns the values of the row groups of a file with a BYTE_ARRAY column
+static std::vector<std::vector<std::string>> ReadStringRowGroups(
+    const std::shared_ptr<Buffer>& buffer) {
+  auto file_reader =
+      ParquetFileReader::Open(std::make_shared<::arrow::io::BufferReader>(buffer));
+  std::vector<std::vector<std::string>> row_groups;
+  for (int rg = 0; rg < file_reader->metadata()->num_row_groups(); ++rg) {
+    auto rg_reader = file_reader->RowGroup(rg);
+    auto column_reader = std::static_pointer_cast<ByteArrayReader>(rg_reader->Column(0));
+    std::vector<ByteArray> values(static_cast<size_t>(rg_reader->metadata()->num_rows()));
+    int64_t values_read;
+    column_reader->ReadBatch(static_cast<int64_t>(values.size()), nullptr, nullptr,
+                             values.data(), &values_read);
+    std::vector<std::string> strings;
+    for (int64_t i = 0; i < values_read; ++i) {
+      strings.push_back(
+          std::string(reinterpret_cast<const char*>(values[i].ptr), values[i].len));
+    }
+    row_groups.push_back(strings);
+  }
+  return row_groups;
+}
+
+TEST(TestAppendRowGroups, CopiesColumnChunks) {
+  std::shared_ptr<FileMetaData> a_metadata, b_metadata;
+  auto a = WriteStringRowGroups(false, false, {{"a", "b", "a"}, {"c"}}, &a_metadata);
+  auto b = WriteStringRowGroups(false, false, {{"d", "e"}, {"f", "f"}}, &b_metadata);
+
+  std::shared_ptr<InMemoryOutputStream> sink(new InMemoryOutputStream());
+  auto gnode = std::static_pointer_cast<GroupNode>(a_metadata->schema()->schema_root());
+  auto file_writer = ParquetFileWriter::Open(sink, gnode);
+  ArrowInputFile a_source(std::make_shared<::arrow::io::BufferReader>(a));
+  ArrowInputFile b_source(std::make_shared<::arrow::io::BufferReader>(b));
+  file_writer->AppendRowGroups(&a_source, *a_metadata);
+  file_writer->AppendRowGroups(&b_source, *b_metadata, {1});
+  // Row groups written by the writer itself can follow the copied ones
+  auto column_writer =
+      static_cast<ByteArrayWriter*>(file_writer->AppendRowGroup()->NextColumn());
+  ByteArray value(1, reinterpret_cast<const uint8_t*>("g"));
+  column_writer->WriteBatch(1, nullptr, nullptr, &value);
+  file_writer->Close();
+
+  std::shared_ptr<Buffer> buffer = sink->GetBuffer();
+  ASSERT_EQ(std::vector<std::vector<std::string>>({{"a", "b", "a"}, {"c"}, {"f", "f"},
+                                                   {"g"}}),
+            ReadStringRowGroups(buffer));
+
+  auto metadata = ReadMetaData(std::make_shared<::arrow::io::BufferReader>(buffer));
+  ASSERT_EQ(7, metadata->num_rows());
+  ASSERT_EQ(4, metadata->num_row_groups());
+  // Statistics and encodings are carried over
+  auto copied = metadata->RowGroup(2)->ColumnChunk(0);
+  auto original = b_metadata->RowGroup(1)->ColumnChunk(0);
+  ASSERT_TRUE(copied->is_stats_set());
+  ASSERT_EQ(original->statistics()->EncodeMin(), copied->statistics()->EncodeMin());
+  ASSERT_EQ(original->statistics()->EncodeMax(), copied->statistics()->EncodeMax());
+  ASSERT_EQ(original->encodings(), copied->encodings());
+  ASSERT_EQ(original->total_compressed_size(), copied->total_compressed_size());
+
+  // Files with another schema are rejected
+  auto other = ParquetFileWriter::Open(
+      std::make_shared<InMemoryOutputStream>(),
+      std::static_pointer_cast<GroupNode>(GroupNode::Make(
+          "schema", Repetition::REQUIRED, {schema::Int32("i", Repetition::REQUIRED)})));
+  ASSERT_THROW(other->AppendRowGroups(&a_source, *a_metadata), ParquetException);
+}
+
+TEST(TestAppendRowGroups, DropsUntrustedStatistics) {
+  // This parquet-mr version compared byte arrays as signed bytes
+  std::shared_ptr<FileMetaData> source_metadata;
+  auto source = WriteStringRowGroups(false, false, {{"a", "\xff"}}, &source_metadata,
+                                     "parquet-mr version 1.2.8");
+  ASSERT_FALSE(source_metadata->RowGroup(0)->ColumnChunk(0)->is_stats_set());
+
+  std::shared_ptr<InMemoryOutputStream> sink(new InMemoryOutputStream());
+  auto gnode =
+      std::static_pointer_cast<GroupNode>(source_metadata->schema()->schema_root());
+  auto file_writer = ParquetFileWriter::Open(sink, gnode);
+  ArrowInputFile input(std::make_shared<::arrow::io::BufferReader>(source));
+  file_writer->AppendRowGroups(&input, *source_metadata);
+  file_writer->Close();
+
+  std::shared_ptr<Buffer> buffer = sink->GetBuffer();
+  ASSERT_EQ(std::vector<std::vector<std::string>>({{"a", "\xff"}}),
+            ReadStringRowGroups(buffer));
+  // The file is written by this version, whose statistics readers trust
+  auto metadata = ReadMetaData(std::make_shared<::arrow::io::BufferReader>(buffer));
+  ASSERT_FALSE(metadata->RowGroup(0)->ColumnChunk(0)->is_stats_set());
+}
+
+TEST(TestTranscodeRowGroups, Recompresses) {
+  const std::vector<std::vector<std::string>> row_groups = {
+      {"a", "b", "a", "a"}, {"c"}, {"d", "d"}};
+  std::shared_ptr<FileMetaData> source_metadata;
+  auto source = WriteStringRowGroups(false, false, row_groups, &source_metadata);
+  auto gnode =
+      std::static_pointer_cast<GroupNode>(source_metadata->schema()->schema_root());
+
+  std::shared_ptr<Buffer> buffer = source;
+  for (Compression::type codec : {Compression::SNAPPY, Compression::UNCOMPRESSED}) {
+    auto reader =
+        ParquetFileReader::Open(std::make_shared<::arrow::io::BufferReader>(buffer));
+    std::shared_ptr<InMemoryOutputStream> sink(new InMemoryOutputStream());
+    auto file_writer = ParquetFileWriter::Open(
+        sink, gnode, WriterProperties::Builder().compression(codec)->build());
+    file_writer->TranscodeRowGroups(reader.get());
+    file_writer->Close();
+    buffer = sink->GetBuffer();
+
+    ASSERT_EQ(row_groups, ReadStringRowGroups(buffer));
+    auto metadata = ReadMetaData(std::make_shared<::arrow::io::BufferReader>(buffer));
+    ASSERT_EQ(3, metadata->num_row_groups());
+    for (int rg = 0; rg < 3; ++rg) {
+      auto column = metadata->RowGroup(rg)->ColumnChunk(0);
+      auto original = source_metadata->RowGroup(rg)->ColumnChunk(0);
+      ASSERT_EQ(codec, column->compression());
+      ASSERT_TRUE(column->has_dictionary_page());
+      ASSERT_EQ(original->encodings(), column->encodings());
+      ASSERT_EQ(original->num_values(), column->num_values());
+      ASSERT_EQ(original->statistics()->EncodeMin(), column->statistics()->EncodeMin());
+    }
+  }
+}
+
+// Write row groups of a sorted INT64 column, in pages of a few dozen rows each
+static std::shared_ptr<Buffer> WriteSortedRowGroups(
+    const std::vector<std::vector<int64_t>>& row_groups, bool descending,
+    bool validate = true) {
+  std::shared_ptr<InMemoryOutputStream> sink(new InMemoryOutputStream());
+  auto gnode = std::static_pointer_cast<GroupNode>(
+      GroupNode::Make("schema", Repetition::REQUIRED,
+                      {schema::Int64("key", Repetition::REQUIRED)}));
+  WriterProperties::Builder builder;
+  builder.disable_dictionary()
+      ->data_pagesize(256)
+      ->write_batch_size(10)
+      ->sorting_columns({{0, descending, false}});
+  if (validate) {
+    builder.enable_sorting_validation();
+  }
+  std::shared_ptr<WriterProperties> properties = builder.build();
+
+  auto file_writer = ParquetFileWriter::Open(sink, gnode, properties);
+  for (const auto& values : row_groups) {
+    RowGroupWriter* row_group_writer = file_writer->AppendRowGroup();
+    auto column_writer = static_cast<Int64Writer*>(row_group_writer->NextColumn());
+    column_writer->WriteBatch(static_cast<int64_t>(values.size()), nullptr, nullptr,
+                              values.data());
+    row_group_writer->Close();
+  }
+  file_writer->Close();
+  return sink->GetBuffer();
+}
+
+TEST(TestSortedSearch, FindsRowGroupsAndRows) {
+  // Row group rg holds the values [1000 * rg, 1000 * rg + 1000)
+  std::vector<std::vector<int64_t>> row_groups(4);
+  for (int rg = 0; rg < 4; ++rg) {
+    for (int64_t i = 0; i < 1000; ++i) {
+      row_groups[rg].push_back(1000 * rg + i);
+    }
+  }
+  auto file_reader = ParquetFileReader::Open(std::make_shared<::arrow::io::BufferReader>(
+      WriteSortedRowGroups(row_groups, false)));
+  std::shared_ptr<FileMetaData> metadata = file_reader->metadata();
+
+  std::vector<SortingColumn> sorting_columns = metadata->RowGroup(0)->sorting_columns();
+  ASSERT_EQ(1, sorting_columns.size());
+  ASSERT_EQ(0, sorting_columns[0].column_idx);
+  ASSERT_FALSE(sorting_columns[0].descending);
+
+  using sorted_search::FindRowGroups;
+  ASSERT_EQ(std::make_pair(1, 3), FindRowGroups<Int64Type>(*metadata, 0, 1500, 2500));
+  ASSERT_EQ(std::make_pair(2, 3), FindRowGroups<Int64Type>(*metadata, 0, 2000, 2999));
+  ASSERT_EQ(std::make_pair(0, 0), FindRowGroups<Int64Type>(*metadata, 0, -10, -1));
+  ASSERT_EQ(std::make_pair(4, 4), FindRowGroups<Int64Type>(*metadata, 0, 4000, 5000));
+  ASSERT_THROW(FindRowGroups<Int32Type>(*metadata, 0, 0, 1), ParquetException);
+
+  auto rg_reader = file_reader->RowGroup(2);
+  std::unique_ptr<OffsetIndex> offset_index = rg_reader->GetOffsetIndex(0);
+  ASSERT_GT(offset_index->num_pages(), 2);
+  ASSERT_EQ(BoundaryOrder::ASCENDING, rg_reader->GetColumnIndex(0)->boundary_order());
+  const std::vector<PageLocation>& pages = offset_index->page_locations();
+  std::pair<int64_t, int64_t> rows =
+      sorted_search::FindRows<Int64Type>(rg_reader.get(), 0, 2500, 2509);
+  ASSERT_EQ(pages[offset_index->FindPage(500)].first_row_index, rows.first);
+  int last_page = offset_index->FindPage(509);
+  ASSERT_EQ(last_page + 1 < offset_index->num_pages()
+                ? pages[last_page + 1].first_row_index
+                : 1000,
+            rows.second);
+  ASSERT_EQ(std::make_pair(static_cast<int64_t>(1000), static_cast<int64_t>(1000)),
+            sorted_search::FindRows<Int64Type>(rg_reader.get(), 0, 3000, 3100));
+}
+
+TEST(TestSortedSearch, ScansUnorderedRowGroups) {
+  // The rows of each row group are sorted, the row groups are not
+  std::vector<std::vector<int64_t>> row_groups({{10, 11, 12}, {0, 1, 2}, {20, 21}});
+  auto file_reader = ParquetFileReader::Open(std::make_shared<::arrow::io::BufferReader>(
+      WriteSortedRowGroups(row_groups, false, false)));
+  std::shared_ptr<FileMetaData> metadata = file_reader->metadata();
+
+  using sorted_search::FindRowGroups;
+  ASSERT_EQ(std::make_pair(1, 2), FindRowGroups<Int64Type>(*metadata, 0, 1, 2));
+  ASSERT_EQ(std::make_pair(0, 1), FindRowGroups<Int64Type>(*metadata, 0, 11, 11));
+  ASSERT_EQ(std::make_pair(0, 3), FindRowGroups<Int64Type>(*metadata, 0, 12, 20));
+  ASSERT_EQ(std::make_pair(0, 0), FindRowGroups<Int64Type>(*metadata, 0, 3, 9));
+}
+
+TEST(TestSortedSearch, ValidatesSortOrder) {
+  // Descending row groups
+  ASSERT_NO_THROW(WriteSortedRowGroups({{9, 8, 7}, {6, 5}, {5, 1}}, true));
+  ASSERT_THROW(WriteSortedRowGroups({{9, 8, 7}, {6, 8}}, true), ParquetException);
+  // Ascending row groups that overlap
+  ASSERT_THROW(WriteSortedRowGroups({{1, 2, 3}, {3, 4}, {2, 5}}, false),
+               ParquetException);
+}
+
 }  // namespace test
 
 }  // namespace parquet
@@ -20,24 +20,36 @@
 #include <algorithm>
 #include <cstdint>
 #include <cstdio>
+#include <future>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <sstream>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include <sys/stat.h>
+#include <sys/types.h>
+
 #include "arrow/io/file.h"
 
+#include "parquet/block_cache.h"
 #include "parquet/column_page.h"
 #include "parquet/column_reader.h"
 #include "parquet/column_scanner.h"
 #include "parquet/exception.h"
 #include "parquet/metadata.h"
+#include "parquet/metadata_cache.h"
+#include "parquet/page_cache.h"
 #include "parquet/parquet_types.h"
+#include "parquet/predicate.h"
 #include "parquet/properties.h"
+#include "parquet/read_metrics.h"
 #include "parquet/types.h"
 #include "parquet/util/logging.h"
 #include "parquet/util/memory.h"
+#include "parquet/util/thread-pool.h"
 
 using std::string;
 
@@ -49,14 +61,15 @@ class Codec;
 
 namespace parquet {
 
-// PARQUET-978: Minimize footer reads by reading 64 KB from the end of the file
-static constexpr int64_t DEFAULT_FOOTER_READ_SIZE = 64 * 1024;
 static constexpr uint32_t FOOTER_SIZE = 8;
 static constexpr uint8_t PARQUET_MAGIC[4] = {'P', 'A', 'R', '1'};
 
 // For PARQUET-816
 static constexpr int64_t kMaxDictHeaderSize = 100;
 
+// Upper bound on the number of reads PreBuffer keeps in flight
+static constexpr size_t kMaxPreBufferReadsInFlight = 16;
+
 // ----------------------------------------------------------------------
 // RowGroupReader public API
 
@@ -82,15 +95,114 @@ std::unique_ptr<PageReader> RowGroupReader::GetColumnPageReader(int i) {
   return contents_->GetColumnPageReader(i);
 }
 
+std::unique_ptr<ColumnIndex> RowGroupReader::GetColumnIndex(int i) {
+  DCHECK(i < metadata()->num_columns())
+      << "The RowGroup only has " << metadata()->num_columns()
+      << "columns, requested column: " << i;
+  return contents_->GetColumnIndex(i);
+}
+
+std::unique_ptr<OffsetIndex> RowGroupReader::GetOffsetIndex(int i) {
+  DCHECK(i < metadata()->num_columns())
+      << "The RowGroup only has " << metadata()->num_columns()
+      << "columns, requested column: " << i;
+  return contents_->GetOffsetIndex(i);
+}
+
+std::unique_ptr<BloomFilter> RowGroupReader::GetBloomFilter(int i) {
+  DCHECK(i < metadata()->num_columns())
+      << "The RowGroup only has " << metadata()->num_columns()
+      << "columns, requested column: " << i;
+  return contents_->GetBloomFilter(i);
+}
+
+std::unique_ptr<PageReader> RowGroupReader::GetColumnPageReader(
+    int i, int64_t row_begin, int64_t row_end, int64_t* first_row_index) {
+  DCHECK(i < metadata()->num_columns())
+      << "The RowGroup only has " << metadata()->num_columns()
+      << "columns, requested column: " << i;
+  return contents_->GetColumnPageReaderForRows(i, row_begin, row_end, first_row_index);
+}
+
 // Returns the rowgroup metadata
 const RowGroupMetaData* RowGroupReader::metadata() const { return contents_->metadata(); }
 
+// Byte range of a column chunk in the file, including the dictionary page
+static ReadRange ComputeColumnChunkRange(const FileMetaData& file_metadata,
+                                         const ColumnChunkMetaData& col,
+                                         RandomAccessSource* source) {
+  int64_t col_start = col.data_page_offset();
+  if (col.has_dictionary_page() && col_start > col.dictionary_page_offset()) {
+    col_start = col.dictionary_page_offset();
+  }
+
+  int64_t col_length = col.total_compressed_size();
+
+  // PARQUET-816 workaround for old files created by older parquet-mr
+  const ApplicationVersion& version = file_metadata.writer_version();
+  if (version.VersionLt(ApplicationVersion::PARQUET_816_FIXED_VERSION)) {
+    // The Parquet MR writer had a bug in 1.2.8 and below where it didn't include the
+    // dictionary page header size in total_compressed_size and total_uncompressed_size
+    // (see IMPALA-694). We add padding to compensate.
+    int64_t bytes_remaining = source->Size() - (col_start + col_length);
+    int64_t padding = std::min<int64_t>(kMaxDictHeaderSize, bytes_remaining);
+    col_length += padding;
+  }
+
+  return {col_start, col_length};
+}
+
+// Read the serialized page index structure at [offset, offset + length)
+static std::shared_ptr<Buffer> ReadPageIndex(RandomAccessSource* source, int64_t offset,
+                                             int32_t length) {
+  std::shared_ptr<Buffer> buffer = source->ReadAt(offset, length);
+  if (buffer->size() != length) {
+    throw ParquetException("Unable to read page index");
+  }
+  return buffer;
+}
+
+// Column chunk data read ahead of time by ParquetFileReader::PreBuffer. Row
+// group readers may be created and used from several threads, so access is
+// synchronized.
+class PreBufferedColumnChunks {
+ public:
+  void Put(int row_group, int column, const std::shared_ptr<Buffer>& buffer) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    chunks_[std::make_pair(row_group, column)] = buffer;
+  }
+
+  // Returns nullptr if the chunk was not pre-buffered. The buffer is handed
+  // over to the caller so that its memory is released once consumed.
+  std::shared_ptr<Buffer> Take(int row_group, int column) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = chunks_.find(std::make_pair(row_group, column));
+    if (it == chunks_.end()) {
+      return nullptr;
+    }
+    std::shared_ptr<Buffer> result = it->second;
+    chunks_.erase(it);
+    return result;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::map<std::pair<int, int>, std::shared_ptr<Buffer>> chunks_;
+};
+
 // RowGroupReader::Contents implementation for the Parquet file specification
 class SerializedRowGroup : public RowGroupReader::Contents {
  public:
   SerializedRowGroup(RandomAccessSource* source, FileMetaData* file_metadata,
+                     PreBufferedColumnChunks* pre_buffered,
+                     const std::shared_ptr<ReadAheadBudget>& read_ahead_budget,
                      int row_group_number, const ReaderProperties& props)
-      : source_(source), file_metadata_(file_metadata), properties_(props) {
+      : source_(source),
+        file_metadata_(file_metadata),
+        pre_buffered_(pre_buffered),
+        read_ahead_budget_(read_ahead_budget),
+        row_group_number_(row_group_number),
+        properties_(props) {
     row_group_metadata_ = file_metadata->RowGroup(row_group_number);
   }
 
@@ -102,38 +214,175 @@ class SerializedRowGroup : public RowGroupReader::Contents {
     // Read column chunk from the file
     auto col = row_group_metadata_->ColumnChunk(i);
 
-    int64_t col_start = col->data_page_offset();
-    if (col->has_dictionary_page() && col_start > col->dictionary_page_offset()) {
-      col_start = col->dictionary_page_offset();
+    std::unique_ptr<InputStream> stream;
+    std::shared_ptr<Buffer> buffer = pre_buffered_->Take(row_group_number_, i);
+    ReadRange range = ComputeColumnChunkRange(*file_metadata_, *col, source_);
+    if (buffer != nullptr) {
+      stream.reset(new InMemoryInputStream(buffer));
+    } else {
+      stream = properties_.GetStream(source_, range.offset, range.length,
+                                     read_ahead_budget_);
+    }
+
+    std::unique_ptr<PageReader> pager =
+        PageReader::Open(std::move(stream), col->num_values(), col->compression(),
+                         properties_.memory_pool(), properties_.page_read_ahead());
+    SetPageCache(pager.get(), range.offset);
+    pager->set_read_counters(GetReadCounters(*col));
+    return pager;
+  }
+
+  std::unique_ptr<ColumnIndex> GetColumnIndex(int i) override {
+    auto col = row_group_metadata_->ColumnChunk(i);
+    if (!col->has_column_index()) {
+      return nullptr;
+    }
+    std::shared_ptr<Buffer> buffer =
+        ReadPageIndex(source_, col->column_index_offset(), col->column_index_length());
+    uint32_t length = static_cast<uint32_t>(buffer->size());
+    return ColumnIndex::Make(buffer->data(), &length);
+  }
+
+  std::unique_ptr<OffsetIndex> GetOffsetIndex(int i) override {
+    auto col = row_group_metadata_->ColumnChunk(i);
+    if (!col->has_offset_index()) {
+      return nullptr;
     }
+    std::shared_ptr<Buffer> buffer =
+        ReadPageIndex(source_, col->offset_index_offset(), col->offset_index_length());
+    uint32_t length = static_cast<uint32_t>(buffer->size());
+    return OffsetIndex::Make(buffer->data(), &length);
+  }
 
-    int64_t col_length = col->total_compressed_size();
-    std::unique_ptr<InputStream> stream;
+  std::unique_ptr<BloomFilter> GetBloomFilter(int i) override {
+    auto col = row_group_metadata_->ColumnChunk(i);
+    if (!col->has_bloom_filter()) {
+      return nullptr;
+    }
+    return BloomFilter::Deserialize(source_, col->bloom_filter_offset(),
+                                    properties_.memory_pool());
+  }
 
-    // PARQUET-816 workaround for old files created by older parquet-mr
-    const ApplicationVersion& version = file_metadata_->writer_version();
-    if (version.VersionLt(ApplicationVersion::PARQUET_816_FIXED_VERSION)) {
-      // The Parquet MR writer had a bug in 1.2.8 and below where it didn't include the
-      // dictionary page header size in total_compressed_size and total_uncompressed_size
-      // (see IMPALA-694). We add padding to compensate.
-      int64_t bytes_remaining = source_->Size() - (col_start + col_length);
-      int64_t padding = std::min<int64_t>(kMaxDictHeaderSize, bytes_remaining);
-      col_length += padding;
+  std::unique_ptr<PageReader> GetColumnPageReaderForRows(
+      int i, int64_t row_begin, int64_t row_end, int64_t* first_row_index) override {
+    std::unique_ptr<OffsetIndex> offset_index = GetOffsetIndex(i);
+    if (offset_index == nullptr || offset_index->num_pages() == 0) {
+      *first_row_index = 0;
+      return GetColumnPageReader(i);
     }
+    auto col = row_group_metadata_->ColumnChunk(i);
 
-    stream = properties_.GetStream(source_, col_start, col_length);
+    const std::vector<PageLocation>& pages = offset_index->page_locations();
+    int first_page = std::max(offset_index->FindPage(row_begin), 0);
+    int last_page = std::max(offset_index->FindPage(row_end - 1), first_page);
+    int64_t data_start = pages[first_page].offset;
+    int64_t data_length =
+        pages[last_page].offset + pages[last_page].compressed_page_size - data_start;
+    *first_row_index = pages[first_page].first_row_index;
+
+    std::unique_ptr<InputStream> stream;
+    std::shared_ptr<ColumnReadCounters> read_counters = GetReadCounters(*col);
+    const bool with_dictionary =
+        col->has_dictionary_page() && col->dictionary_page_offset() < pages[0].offset;
+    if (with_dictionary) {
+      ScopedReadTimer timer(read_counters.get(), &ColumnReadCounters::io_nanos);
+      // The dictionary page precedes the data pages, read it together with the
+      // selected data pages into a single buffer
+      int64_t dictionary_start = col->dictionary_page_offset();
+      int64_t dictionary_length = pages[0].offset - dictionary_start;
+      std::shared_ptr<PoolBuffer> buffer =
+          AllocateBuffer(properties_.memory_pool(), dictionary_length + data_length);
+      if (source_->ReadAt(dictionary_start, dictionary_length, buffer->mutable_data()) !=
+              dictionary_length ||
+          source_->ReadAt(data_start, data_length,
+                          buffer->mutable_data() + dictionary_length) != data_length) {
+        throw ParquetException("Unable to read column chunk data");
+      }
+      stream.reset(new InMemoryInputStream(buffer));
+    } else {
+      stream =
+          properties_.GetStream(source_, data_start, data_length, read_ahead_budget_);
+    }
 
-    return PageReader::Open(std::move(stream), col->num_values(), col->compression(),
-                            properties_.memory_pool());
+    std::unique_ptr<PageReader> pager =
+        PageReader::Open(std::move(stream), col->num_values(), col->compression(),
+                         properties_.memory_pool(), properties_.page_read_ahead());
+    // The file offsets of the pages in the combined buffer are not contiguous
+    if (!with_dictionary) {
+      SetPageCache(pager.get(), data_start);
+    }
+    pager->set_read_counters(std::move(read_counters));
+    return pager;
   }
 
  private:
+  // nullptr unless the reader properties collect read metrics
+  std::shared_ptr<ColumnReadCounters> GetReadCounters(const ColumnChunkMetaData& col) {
+    const std::shared_ptr<ReadMetrics>& metrics = properties_.read_metrics();
+    if (metrics == nullptr) {
+      return nullptr;
+    }
+    return metrics->column(col.path_in_schema()->ToDotString());
+  }
+
+  // The stream of pager starts at stream_offset of the file
+  void SetPageCache(PageReader* pager, int64_t stream_offset) {
+    const std::shared_ptr<PageCache>& cache = properties_.page_cache();
+    if (cache == nullptr) {
+      return;
+    }
+    const std::string file_key = source_->cache_key();
+    if (!file_key.empty()) {
+      pager->set_page_cache(cache, file_key, stream_offset);
+    }
+  }
+
   RandomAccessSource* source_;
   FileMetaData* file_metadata_;
+  PreBufferedColumnChunks* pre_buffered_;
+  std::shared_ptr<ReadAheadBudget> read_ahead_budget_;
+  int row_group_number_;
   std::unique_ptr<RowGroupMetaData> row_group_metadata_;
   ReaderProperties properties_;
 };
 
+// Upper bound on the size of the first read of a file that is grown to fit the
+// footers of recently opened files
+static constexpr int64_t kMaxAdaptiveFooterReadSize = 16 * 1024 * 1024;
+
+// Sizes of the footers (metadata and the 8 trailing bytes) of the files opened
+// most recently in this process
+class RecentFooterSizes {
+ public:
+  RecentFooterSizes() : next_(0) { std::fill(sizes_, sizes_ + kNumSizes, 0); }
+
+  void Add(int64_t footer_size) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    sizes_[next_] = footer_size;
+    next_ = (next_ + 1) % kNumSizes;
+  }
+
+  // Read size that fits each of the recent footers, with some slack for
+  // files of the same shape that grew a bit
+  int64_t ReadSize() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    const int64_t largest = *std::max_element(sizes_, sizes_ + kNumSizes);
+    return std::min(largest + largest / 8, kMaxAdaptiveFooterReadSize);
+  }
+
+ private:
+  static constexpr int kNumSizes = 16;
+
+  mutable std::mutex mutex_;
+  int64_t sizes_[kNumSizes];
+  int next_;
+};
+
+static RecentFooterSizes* recent_footer_sizes() {
+  static RecentFooterSizes sizes;
+  return &sizes;
+}
+
 // ----------------------------------------------------------------------
 // SerializedFile: An implementation of ParquetFileReader::Contents that deals
 // with the Parquet file structure, Thrift deserialization, and other internal
@@ -144,7 +393,10 @@ class SerializedFile : public ParquetFileReader::Contents {
  public:
   SerializedFile(std::unique_ptr<RandomAccessSource> source,
                  const ReaderProperties& props = default_reader_properties())
-      : source_(std::move(source)), properties_(props) {}
+      : source_(std::move(source)),
+        properties_(props),
+        read_ahead_budget_(
+            std::make_shared<ReadAheadBudget>(props.stream_read_ahead_budget())) {}
 
   ~SerializedFile() override {
     try {
@@ -157,12 +409,68 @@ class SerializedFile : public ParquetFileReader::Contents {
 
   std::shared_ptr<RowGroupReader> GetRowGroup(int i) override {
     std::unique_ptr<SerializedRowGroup> contents(
-        new SerializedRowGroup(source_.get(), file_metadata_.get(), i, properties_));
+        new SerializedRowGroup(source_.get(), file_metadata_.get(), &pre_buffered_,
+                               read_ahead_budget_, i, properties_));
     return std::make_shared<RowGroupReader>(std::move(contents));
   }
 
   std::shared_ptr<FileMetaData> metadata() const override { return file_metadata_; }
 
+  void PreBuffer(const std::vector<int>& row_groups,
+                 const std::vector<int>& column_indices) override {
+    if (!properties_.is_pre_buffer_enabled()) {
+      return;
+    }
+
+    // Byte range of every requested column chunk, in request order
+    std::vector<ReadRange> chunk_ranges;
+    for (int row_group : row_groups) {
+      auto row_group_metadata = file_metadata_->RowGroup(row_group);
+      for (int column : column_indices) {
+        auto col = row_group_metadata->ColumnChunk(column);
+        chunk_ranges.push_back(
+            ComputeColumnChunkRange(*file_metadata_, *col, source_.get()));
+      }
+    }
+
+    std::vector<ReadRange> read_ranges =
+        CoalesceReadRanges(chunk_ranges, properties_.pre_buffer_hole_size_limit());
+    if (read_ranges.empty()) {
+      return;
+    }
+
+    const size_t num_reads = read_ranges.size();
+    std::vector<std::shared_ptr<Buffer>> buffers(num_reads);
+    for (size_t begin = 0; begin < num_reads; begin += kMaxPreBufferReadsInFlight) {
+      const size_t end = std::min(num_reads, begin + kMaxPreBufferReadsInFlight);
+      std::vector<std::future<std::shared_ptr<Buffer>>> reads = source_->ReadRangesAsync(
+          std::vector<ReadRange>(read_ranges.begin() + begin, read_ranges.begin() + end));
+      for (size_t i = begin; i < end; ++i) {
+        buffers[i] = reads[i - begin].get();
+        if (buffers[i]->size() < read_ranges[i].length) {
+          throw ParquetException("Unable to read column chunk data");
+        }
+      }
+    }
+
+    // Hand out zero-copy slices of the merged reads to the individual chunks
+    size_t chunk_index = 0;
+    for (int row_group : row_groups) {
+      for (int column : column_indices) {
+        const ReadRange& chunk = chunk_ranges[chunk_index++];
+        auto it = std::upper_bound(
+            read_ranges.begin(), read_ranges.end(), chunk.offset,
+            [](int64_t offset, const ReadRange& range) { return offset < range.offset; });
+        DCHECK(it != read_ranges.begin());
+        --it;
+        const auto read_index = static_cast<size_t>(it - read_ranges.begin());
+        pre_buffered_.Put(row_group, column,
+                          ::arrow::SliceBuffer(buffers[read_index],
+                                               chunk.offset - it->offset, chunk.length));
+      }
+    }
+  }
+
   void set_metadata(const std::shared_ptr<FileMetaData>& metadata) {
     file_metadata_ = metadata;
   }
@@ -174,49 +482,55 @@ class SerializedFile : public ParquetFileReader::Contents {
       throw ParquetException("Corrupted file, smaller than file footer");
     }
 
-    uint8_t footer_buffer[DEFAULT_FOOTER_READ_SIZE];
-    int64_t footer_read_size = std::min(file_size, DEFAULT_FOOTER_READ_SIZE);
-    int64_t bytes_read =
-        source_->ReadAt(file_size - footer_read_size, footer_read_size, footer_buffer);
+    int64_t footer_read_size = properties_.footer_read_size();
+    if (properties_.is_adaptive_footer_read_size_enabled()) {
+      footer_read_size = std::max(footer_read_size, recent_footer_sizes()->ReadSize());
+    }
+    footer_read_size = std::max(footer_read_size, static_cast<int64_t>(FOOTER_SIZE));
+    footer_read_size = std::min(file_size, footer_read_size);
+    std::shared_ptr<Buffer> footer_buffer =
+        source_->ReadAt(file_size - footer_read_size, footer_read_size);
+    const uint8_t* footer_data = footer_buffer->data();
 
     // Check if all bytes are read. Check if last 4 bytes read have the magic bits
-    if (bytes_read != footer_read_size ||
-        memcmp(footer_buffer + footer_read_size - 4, PARQUET_MAGIC, 4) != 0) {
+    if (footer_buffer->size() != footer_read_size ||
+        memcmp(footer_data + footer_read_size - 4, PARQUET_MAGIC, 4) != 0) {
       throw ParquetException("Invalid parquet file. Corrupt footer.");
     }
 
     uint32_t metadata_len =
-        *reinterpret_cast<uint32_t*>(footer_buffer + footer_read_size - FOOTER_SIZE);
+        *reinterpret_cast<const uint32_t*>(footer_data + footer_read_size - FOOTER_SIZE);
     int64_t metadata_start = file_size - FOOTER_SIZE - metadata_len;
     if (FOOTER_SIZE + metadata_len > file_size) {
       throw ParquetException(
           "Invalid parquet file. File is less than "
           "file metadata size.");
     }
-
-    std::shared_ptr<PoolBuffer> metadata_buffer =
-        AllocateBuffer(properties_.memory_pool(), metadata_len);
+    recent_footer_sizes()->Add(FOOTER_SIZE + metadata_len);
 
     // Check if the footer_buffer contains the entire metadata
+    std::shared_ptr<Buffer> metadata_buffer;
     if (footer_read_size >= (metadata_len + FOOTER_SIZE)) {
-      memcpy(metadata_buffer->mutable_data(),
-             footer_buffer + (footer_read_size - metadata_len - FOOTER_SIZE),
-             metadata_len);
+      metadata_buffer = ::arrow::SliceBuffer(
+          footer_buffer, footer_read_size - metadata_len - FOOTER_SIZE, metadata_len);
     } else {
-      bytes_read =
-          source_->ReadAt(metadata_start, metadata_len, metadata_buffer->mutable_data());
-      if (bytes_read != metadata_len) {
+      metadata_buffer = source_->ReadAt(metadata_start, metadata_len);
+      if (metadata_buffer->size() != metadata_len) {
         throw ParquetException("Invalid parquet file. Could not read metadata bytes.");
       }
     }
 
-    file_metadata_ = FileMetaData::Make(metadata_buffer->data(), &metadata_len);
+    file_metadata_ = FileMetaData::Make(metadata_buffer->data(), &metadata_len,
+                                        properties_.is_lazy_metadata_enabled());
   }
 
  private:
   std::unique_ptr<RandomAccessSource> source_;
   std::shared_ptr<FileMetaData> file_metadata_;
   ReaderProperties properties_;
+  PreBufferedColumnChunks pre_buffered_;
+  // Shared by the windowed streams of all column readers of the file
+  std::shared_ptr<ReadAheadBudget> read_ahead_budget_;
 };
 
 // ----------------------------------------------------------------------
@@ -262,12 +576,36 @@ std::unique_ptr<ParquetFileReader> ParquetFileReader::Open(
 std::unique_ptr<ParquetFileReader> ParquetFileReader::Open(
     std::unique_ptr<RandomAccessSource> source, const ReaderProperties& props,
     const std::shared_ptr<FileMetaData>& metadata) {
+  if (props.block_cache() != nullptr && !source->cache_key().empty()) {
+    source.reset(new CachingRandomAccessSource(std::move(source), props.block_cache(),
+                                               props.memory_pool()));
+  }
   auto contents = SerializedFile::Open(std::move(source), props, metadata);
   std::unique_ptr<ParquetFileReader> result(new ParquetFileReader());
   result->Open(std::move(contents));
   return result;
 }
 
+// Size and modification time of the file at path, or false if they cannot
+// be determined
+static bool GetFileIdentity(const std::string& path, int64_t* file_size,
+                            int64_t* modification_time) {
+#ifdef _WIN32
+  struct _stat64 file_stat;
+  if (_stat64(path.c_str(), &file_stat) != 0) {
+    return false;
+  }
+#else
+  struct stat file_stat;
+  if (stat(path.c_str(), &file_stat) != 0) {
+    return false;
+  }
+#endif
+  *file_size = static_cast<int64_t>(file_stat.st_size);
+  *modification_time = static_cast<int64_t>(file_stat.st_mtime);
+  return true;
+}
+
 std::unique_ptr<ParquetFileReader> ParquetFileReader::OpenFile(
     const std::string& path, bool memory_map, const ReaderProperties& props,
     const std::shared_ptr<FileMetaData>& metadata) {
@@ -284,7 +622,41 @@ std::unique_ptr<ParquetFileReader> ParquetFileReader::OpenFile(
     source = handle;
   }
 
-  return Open(source, props, metadata);
+  // The size and modification time identify the version of the file in the
+  // metadata, block and page caches
+  FileMetaDataCache* cache = props.metadata_cache().get();
+  int64_t file_size = 0;
+  int64_t modification_time = 0;
+  const bool needs_identity = cache != nullptr || props.block_cache() != nullptr ||
+                              props.page_cache() != nullptr;
+  const bool has_identity =
+      needs_identity && GetFileIdentity(path, &file_size, &modification_time);
+  std::string cache_key;
+  if (has_identity) {
+    std::stringstream ss;
+    ss << path << ':' << file_size << ':' << modification_time;
+    cache_key = ss.str();
+  }
+  auto open = [&](const std::shared_ptr<FileMetaData>& file_metadata)
+      -> std::unique_ptr<ParquetFileReader> {
+    std::unique_ptr<RandomAccessSource> io_wrapper(new ArrowInputFile(source, cache_key));
+    return Open(std::move(io_wrapper), props, file_metadata);
+  };
+
+  const bool use_cache = metadata == nullptr && cache != nullptr && has_identity;
+  if (use_cache) {
+    std::shared_ptr<FileMetaData> cached =
+        cache->Get(path, file_size, modification_time);
+    if (cached != nullptr) {
+      return open(cached);
+    }
+  }
+
+  std::unique_ptr<ParquetFileReader> result = open(metadata);
+  if (use_cache) {
+    cache->Put(path, file_size, modification_time, result->metadata());
+  }
+  return result;
 }
 
 void ParquetFileReader::Open(std::unique_ptr<ParquetFileReader::Contents> contents) {
@@ -301,6 +673,11 @@ std::shared_ptr<FileMetaData> ParquetFileReader::metadata() const {
   return contents_->metadata();
 }
 
+void ParquetFileReader::PreBuffer(const std::vector<int>& row_groups,
+                                  const std::vector<int>& column_indices) {
+  contents_->PreBuffer(row_groups, column_indices);
+}
+
 std::shared_ptr<RowGroupReader> ParquetFileReader::RowGroup(int i) {
   DCHECK(i < metadata()->num_row_groups())
       << "The file only has " << metadata()->num_row_groups()
@@ -308,6 +685,128 @@ std::shared_ptr<RowGroupReader> ParquetFileReader::RowGroup(int i) {
   return contents_->GetRowGroup(i);
 }
 
+// ----------------------------------------------------------------------
+// Aggregates from the metadata
+
+namespace {
+
+constexpr int64_t kAggregateBatchSize = 1024;
+
+// Whether the statistics of the column chunk hold its null count and, unless
+// all of its values are null, its min and max
+bool HasUsableStatistics(const ColumnChunkMetaData& column_chunk) {
+  if (!column_chunk.is_null_count_set()) {
+    return false;
+  }
+  std::shared_ptr<RowGroupStatistics> statistics = column_chunk.statistics();
+  return statistics->HasMinMax() || statistics->num_values() == 0;
+}
+
+// Count the values and nulls of the column chunk and, unless statistics is
+// nullptr, update it with the values
+template <typename DType>
+void DecodeColumnAggregate(RowGroupReader* row_group, int column,
+                           TypedRowGroupStatistics<DType>* statistics,
+                           ColumnAggregate* out) {
+  typedef typename DType::c_type T;
+  auto reader =
+      std::static_pointer_cast<TypedColumnReader<DType>>(row_group->Column(column));
+  std::vector<int16_t> def_levels(kAggregateBatchSize);
+  std::vector<int16_t> rep_levels(kAggregateBatchSize);
+  std::unique_ptr<T[]> values(new T[kAggregateBatchSize]);
+  while (reader->HasNext()) {
+    int64_t values_read = 0;
+    const int64_t levels_read =
+        reader->ReadBatch(kAggregateBatchSize, def_levels.data(), rep_levels.data(),
+                          values.get(), &values_read);
+    const int64_t null_count = levels_read - values_read;
+    out->num_values += values_read;
+    out->null_count += null_count;
+    if (statistics != nullptr) {
+      statistics->Update(values.get(), values_read, null_count);
+    }
+  }
+}
+
+template <typename DType>
+ColumnAggregate AggregateColumn(ParquetFileReader* reader,
+                                const std::vector<int>& row_groups, int column) {
+  const FileMetaData& metadata = *reader->metadata();
+  const ColumnDescriptor* descr = metadata.schema()->Column(column);
+  ColumnAggregate result;
+  std::shared_ptr<TypedRowGroupStatistics<DType>> statistics;
+  if (descr->sort_order() != SortOrder::UNKNOWN) {
+    statistics = std::make_shared<TypedRowGroupStatistics<DType>>(descr);
+    result.statistics = statistics;
+  }
+  for (int i : row_groups) {
+    std::unique_ptr<RowGroupMetaData> row_group = metadata.RowGroup(i);
+    std::unique_ptr<ColumnChunkMetaData> column_chunk = row_group->ColumnChunk(column);
+    if (statistics == nullptr || !HasUsableStatistics(*column_chunk)) {
+      DecodeColumnAggregate<DType>(reader->RowGroup(i).get(), column, statistics.get(),
+                                   &result);
+      ++result.num_decoded_chunks;
+      continue;
+    }
+    std::shared_ptr<RowGroupStatistics> chunk_statistics = column_chunk->statistics();
+    result.num_values += chunk_statistics->num_values();
+    result.null_count += chunk_statistics->null_count();
+    statistics->Merge(
+        static_cast<const TypedRowGroupStatistics<DType>&>(*chunk_statistics));
+  }
+  return result;
+}
+
+}  // namespace
+
+FileAggregates ParquetFileReader::ComputeAggregates(
+    const std::vector<int>& column_indices, const std::shared_ptr<Predicate>& filter) {
+  std::shared_ptr<FileMetaData> file_metadata = metadata();
+  FileAggregates result;
+  for (int i = 0; i < file_metadata->num_row_groups(); i++) {
+    std::unique_ptr<RowGroupMetaData> row_group = file_metadata->RowGroup(i);
+    if (filter == nullptr || filter->CanMatch(*row_group)) {
+      result.row_groups.push_back(i);
+      result.num_rows += row_group->num_rows();
+    }
+  }
+
+  for (int column : column_indices) {
+    if (column < 0 || column >= file_metadata->num_columns()) {
+      throw ParquetException("Column index out of range");
+    }
+    const std::vector<int>& row_groups = result.row_groups;
+    switch (file_metadata->schema()->Column(column)->physical_type()) {
+      case Type::BOOLEAN:
+        result.columns.push_back(AggregateColumn<BooleanType>(this, row_groups, column));
+        break;
+      case Type::INT32:
+        result.columns.push_back(AggregateColumn<Int32Type>(this, row_groups, column));
+        break;
+      case Type::INT64:
+        result.columns.push_back(AggregateColumn<Int64Type>(this, row_groups, column));
+        break;
+      case Type::INT96:
+        result.columns.push_back(AggregateColumn<Int96Type>(this, row_groups, column));
+        break;
+      case Type::FLOAT:
+        result.columns.push_back(AggregateColumn<FloatType>(this, row_groups, column));
+        break;
+      case Type::DOUBLE:
+        result.columns.push_back(AggregateColumn<DoubleType>(this, row_groups, column));
+        break;
+      case Type::BYTE_ARRAY:
+        result.columns.push_back(
+            AggregateColumn<ByteArrayType>(this, row_groups, column));
+        break;
+      case Type::FIXED_LEN_BYTE_ARRAY:
+        result.columns.push_back(AggregateColumn<FLBAType>(this, row_groups, column));
+        break;
+    }
+  }
+  return result;
+}
+
 // ----------------------------------------------------------------------
 // File metadata helpers
 
@@ -319,49 +818,83 @@ std::shared_ptr<FileMetaData> ReadMetaData(
 // ----------------------------------------------------------------------
 // File scanner for performance testing
 
-int64_t ScanFileContents(std::vector<int> columns, const int32_t column_batch_size,
-                         ParquetFileReader* reader) {
+// Returns the number of rows of the column chunk
+static int64_t ScanColumnChunk(RowGroupReader* group_reader, int column,
+                               int32_t column_batch_size) {
   std::vector<int16_t> rep_levels(column_batch_size);
   std::vector<int16_t> def_levels(column_batch_size);
+  std::shared_ptr<ColumnReader> col_reader = group_reader->Column(column);
+  size_t value_byte_size = GetTypeByteSize(col_reader->descr()->physical_type());
+  std::vector<uint8_t> values(column_batch_size * value_byte_size);
+
+  int64_t rows = 0;
+  int64_t values_read = 0;
+  while (col_reader->HasNext()) {
+    rows += ScanAllValues(column_batch_size, def_levels.data(), rep_levels.data(),
+                          values.data(), &values_read, col_reader.get());
+  }
+  return rows;
+}
 
-  int num_columns = static_cast<int>(columns.size());
+// columns are not specified explicitly. Add all columns
+static void AddAllColumns(ParquetFileReader* reader, std::vector<int>* columns) {
+  if (columns->empty()) {
+    columns->resize(reader->metadata()->num_columns());
+    for (size_t i = 0; i < columns->size(); i++) {
+      (*columns)[i] = static_cast<int>(i);
+    }
+  }
+}
 
-  // columns are not specified explicitly. Add all columns
-  if (columns.size() == 0) {
-    num_columns = reader->metadata()->num_columns();
-    columns.resize(num_columns);
-    for (int i = 0; i < num_columns; i++) {
-      columns[i] = i;
+static int64_t CheckTotalRows(const std::vector<int64_t>& total_rows) {
+  for (size_t i = 1; i < total_rows.size(); ++i) {
+    if (total_rows[0] != total_rows[i]) {
+      throw ParquetException("Parquet error: Total rows among columns do not match");
     }
   }
+  return total_rows.empty() ? 0 : total_rows[0];
+}
 
-  std::vector<int64_t> total_rows(num_columns, 0);
+int64_t ScanFileContents(std::vector<int> columns, const int32_t column_batch_size,
+                         ParquetFileReader* reader) {
+  AddAllColumns(reader, &columns);
+  std::vector<int64_t> total_rows(columns.size(), 0);
 
   for (int r = 0; r < reader->metadata()->num_row_groups(); ++r) {
     auto group_reader = reader->RowGroup(r);
-    int col = 0;
-    for (auto i : columns) {
-      std::shared_ptr<ColumnReader> col_reader = group_reader->Column(i);
-      size_t value_byte_size = GetTypeByteSize(col_reader->descr()->physical_type());
-      std::vector<uint8_t> values(column_batch_size * value_byte_size);
-
-      int64_t values_read = 0;
-      while (col_reader->HasNext()) {
-        total_rows[col] +=
-            ScanAllValues(column_batch_size, def_levels.data(), rep_levels.data(),
-                          values.data(), &values_read, col_reader.get());
-      }
-      col++;
+    for (size_t col = 0; col < columns.size(); col++) {
+      total_rows[col] += ScanColumnChunk(group_reader.get(), columns[col],
+                                         column_batch_size);
     }
   }
+  return CheckTotalRows(total_rows);
+}
 
-  for (int i = 1; i < num_columns; ++i) {
-    if (total_rows[0] != total_rows[i]) {
-      throw ParquetException("Parquet error: Total rows among columns do not match");
-    }
+int64_t ScanFileContents(std::vector<int> columns, const int32_t column_batch_size,
+                         ParquetFileReader* reader, int parallelism, ThreadPool* pool) {
+  AddAllColumns(reader, &columns);
+  if (pool == nullptr) {
+    pool = ThreadPool::GetDefault().get();
   }
 
-  return total_rows[0];
+  const int num_columns = static_cast<int>(columns.size());
+  std::vector<std::shared_ptr<RowGroupReader>> group_readers;
+  for (int r = 0; r < reader->metadata()->num_row_groups(); ++r) {
+    group_readers.push_back(reader->RowGroup(r));
+  }
+
+  // A task per column chunk, each with buffers of its own
+  std::vector<int64_t> chunk_rows(group_readers.size() * columns.size(), 0);
+  pool->ParallelFor(parallelism, static_cast<int>(chunk_rows.size()), [&](int task) {
+    chunk_rows[task] = ScanColumnChunk(group_readers[task / num_columns].get(),
+                                       columns[task % num_columns], column_batch_size);
+  });
+
+  std::vector<int64_t> total_rows(columns.size(), 0);
+  for (size_t task = 0; task < chunk_rows.size(); task++) {
+    total_rows[task % num_columns] += chunk_rows[task];
+  }
+  return CheckTotalRows(total_rows);
 }
 
 }  // namespace parquet
@@ -25,8 +25,10 @@
 #include <string>
 #include <vector>
 
+#include "parquet/bloom_filter.h"
 #include "parquet/column_reader.h"
 #include "parquet/metadata.h"
+#include "parquet/page_index.h"
 #include "parquet/properties.h"
 #include "parquet/schema.h"
 #include "parquet/statistics.h"
@@ -36,6 +38,8 @@
 namespace parquet {
 
 class ColumnReader;
+class Predicate;
+class ThreadPool;
 
 class PARQUET_EXPORT RowGroupReader {
  public:
@@ -47,6 +51,15 @@ class PARQUET_EXPORT RowGroupReader {
     virtual std::unique_ptr<PageReader> GetColumnPageReader(int i) = 0;
     virtual const RowGroupMetaData* metadata() const = 0;
     virtual const ReaderProperties* properties() const = 0;
+    // Implementations without page indexes read the whole column chunk
+    virtual std::unique_ptr<ColumnIndex> GetColumnIndex(int i) { return nullptr; }
+    virtual std::unique_ptr<OffsetIndex> GetOffsetIndex(int i) { return nullptr; }
+    virtual std::unique_ptr<BloomFilter> GetBloomFilter(int i) { return nullptr; }
+    virtual std::unique_ptr<PageReader> GetColumnPageReaderForRows(
+        int i, int64_t row_begin, int64_t row_end, int64_t* first_row_index) {
+      *first_row_index = 0;
+      return GetColumnPageReader(i);
+    }
   };
 
   explicit RowGroupReader(std::unique_ptr<Contents> contents);
@@ -60,11 +73,55 @@ class PARQUET_EXPORT RowGroupReader {
 
   std::unique_ptr<PageReader> GetColumnPageReader(int i);
 
+  // Read the page index of the indicated column chunk. Returns nullptr if the
+  // file does not have one for the chunk.
+  std::unique_ptr<ColumnIndex> GetColumnIndex(int i);
+  std::unique_ptr<OffsetIndex> GetOffsetIndex(int i);
+
+  // Read the Bloom filter of the indicated column chunk without opening the
+  // chunk itself. Returns nullptr if it was written without one.
+  std::unique_ptr<BloomFilter> GetBloomFilter(int i);
+
+  // Page reader over only the data pages that contain the rows [row_begin,
+  // row_end) of the row group, preceded by the dictionary page if any. The
+  // pages are located with the offset index, falling back to the whole column
+  // chunk without one. On return, first_row_index is the index of the first
+  // row of the first data page; the rows before row_begin still have to be
+  // skipped.
+  std::unique_ptr<PageReader> GetColumnPageReader(int i, int64_t row_begin,
+                                                  int64_t row_end,
+                                                  int64_t* first_row_index);
+
  private:
   // Holds a pointer to an instance of Contents implementation
   std::unique_ptr<Contents> contents_;
 };
 
+/// \brief Aggregates of a leaf column over row groups, see
+/// ParquetFileReader::ComputeAggregates
+struct PARQUET_EXPORT ColumnAggregate {
+  /// Number of values that are not null and number of nulls
+  int64_t num_values = 0;
+  int64_t null_count = 0;
+  /// Min and max of the values in the TypedRowGroupStatistics of the physical
+  /// type, HasMinMax() is false if all values are null. nullptr for columns
+  /// with an unknown sort order, e.g. INT96
+  std::shared_ptr<RowGroupStatistics> statistics;
+  /// Column chunks that were decoded as their metadata lacks usable statistics
+  int num_decoded_chunks = 0;
+};
+
+/// \brief COUNT(*) and the aggregates of leaf columns, see
+/// ParquetFileReader::ComputeAggregates
+struct PARQUET_EXPORT FileAggregates {
+  /// Number of rows of the aggregated row groups
+  int64_t num_rows = 0;
+  /// The row groups that were aggregated
+  std::vector<int> row_groups;
+  /// The aggregates of the columns in the order they were requested
+  std::vector<ColumnAggregate> columns;
+};
+
 class PARQUET_EXPORT ParquetFileReader {
  public:
   // Forward declare a virtual class 'Contents' to aid dependency injection and more
@@ -81,6 +138,10 @@ class PARQUET_EXPORT ParquetFileReader {
     virtual void Close() = 0;
     virtual std::shared_ptr<RowGroupReader> GetRowGroup(int i) = 0;
     virtual std::shared_ptr<FileMetaData> metadata() const = 0;
+    // Read the indicated column chunks ahead of time. Implementations that do
+    // not support pre-buffering may ignore this
+    virtual void PreBuffer(const std::vector<int>& row_groups,
+                           const std::vector<int>& column_indices) {}
   };
 
   ParquetFileReader();
@@ -119,6 +180,34 @@ class PARQUET_EXPORT ParquetFileReader {
   // Returns the file metadata. Only one instance is ever created
   std::shared_ptr<FileMetaData> metadata() const;
 
+  /// \brief Fetch the given column chunks of the given row groups before they
+  /// are decoded
+  ///
+  /// The byte ranges of all requested column chunks are merged where they are
+  /// adjacent or separated by at most ReaderProperties::pre_buffer_hole_size_limit
+  /// bytes, and the merged ranges are read concurrently. Column readers
+  /// subsequently created for these chunks are served from memory. Each
+  /// pre-buffered chunk is released once its page reader has been created.
+  ///
+  /// This is a no-op unless ReaderProperties::enable_pre_buffer was called.
+  void PreBuffer(const std::vector<int>& row_groups,
+                 const std::vector<int>& column_indices);
+
+  /// \brief Count the rows, and the values and nulls and find the min and
+  /// max of the indicated leaf columns
+  ///
+  /// The row groups are those that filter does not rule out (see
+  /// Predicate::CanMatch), all of them if it is nullptr; their rows are not
+  /// filtered. The aggregates are taken from the metadata. Only the column
+  /// chunks without usable statistics are decoded: those whose statistics
+  /// are missing, lack the null count or the min and max, or are not trusted
+  /// for the column's sort order in files of the writer version (see
+  /// ApplicationVersion::HasCorrectStatistics). The BYTE_ARRAY min and max of
+  /// files written with WriterProperties::Builder::statistics_truncate_length
+  /// are bounds of the values.
+  FileAggregates ComputeAggregates(const std::vector<int>& column_indices,
+                                   const std::shared_ptr<Predicate>& filter = nullptr);
+
  private:
   // Holds a pointer to an instance of Contents implementation
   std::unique_ptr<Contents> contents_;
@@ -137,6 +226,16 @@ PARQUET_EXPORT
 int64_t ScanFileContents(std::vector<int> columns, const int32_t column_batch_size,
                          ParquetFileReader* reader);
 
+/// \brief Scan all values as above, reading up to parallelism of the column
+///     chunks at the same time on pool, ThreadPool::GetDefault() if nullptr
+/// \param[in] parallelism maximum number of column chunks read at a time
+/// \param[in] pool the pool the column chunks are read on
+/// \return number of semantic rows in file
+PARQUET_EXPORT
+int64_t ScanFileContents(std::vector<int> columns, const int32_t column_batch_size,
+                         ParquetFileReader* reader, int parallelism,
+                         ThreadPool* pool = nullptr);
+
 }  // namespace parquet
 
 #endif  // PARQUET_FILE_READER_H
@@ -17,7 +17,15 @@
 
 #include "parquet/file_writer.h"
 
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "parquet/column_page.h"
+#include "parquet/column_reader.h"
 #include "parquet/column_writer.h"
+#include "parquet/file_reader.h"
+#include "parquet/hyperloglog.h"
 #include "parquet/schema-internal.h"
 #include "parquet/schema.h"
 #include "parquet/thrift.h"
@@ -47,31 +55,60 @@ void RowGroupWriter::Close() {
 
 ColumnWriter* RowGroupWriter::NextColumn() { return contents_->NextColumn(); }
 
+ColumnWriter* RowGroupWriter::column(int i) { return contents_->column(i); }
+
+bool RowGroupWriter::buffered() const { return contents_->buffered(); }
+
 int RowGroupWriter::current_column() { return contents_->current_column(); }
 
 int RowGroupWriter::num_columns() const { return contents_->num_columns(); }
 
 int64_t RowGroupWriter::num_rows() const { return contents_->num_rows(); }
 
+int64_t RowGroupWriter::EstimatedSize() { return contents_->EstimatedSize(); }
+
+int64_t RowGroupWriter::memory_usage() { return contents_->memory_usage(); }
+
 // ----------------------------------------------------------------------
 // RowGroupSerializer
 
 // RowGroupWriter::Contents implementation for the Parquet file specification
 class RowGroupSerializer : public RowGroupWriter::Contents {
  public:
-  RowGroupSerializer(OutputStream* sink, RowGroupMetaDataBuilder* metadata,
-                     const WriterProperties* properties)
+  // column_dictionaries holds the dictionaries of the previous row group to
+  // start those of this row group with, see ColumnWriter::SeedDictionary, and
+  // receives the dictionaries of this row group. dictionary_pools holds the
+  // allocators of the dictionary values of the columns, which are created on
+  // first use and kept for the next row group, see
+  // ColumnWriter::SetDictionaryAllocator
+  RowGroupSerializer(
+      OutputStream* sink, RowGroupMetaDataBuilder* metadata,
+      const WriterProperties* properties, bool buffered_row_group = false,
+      std::vector<std::shared_ptr<ColumnDictionary>>* column_dictionaries = nullptr,
+      std::vector<std::unique_ptr<ChunkedAllocator>>* dictionary_pools = nullptr)
       : sink_(sink),
         metadata_(metadata),
         properties_(properties),
         total_bytes_written_(0),
         closed_(false),
         current_column_index_(0),
-        num_rows_(-1) {}
+        num_rows_(-1),
+        buffered_row_group_(buffered_row_group),
+        column_dictionaries_(column_dictionaries),
+        dictionary_pools_(dictionary_pools) {
+    if (buffered_row_group_) {
+      InitColumns();
+    }
+  }
 
   int num_columns() const override { return metadata_->num_columns(); }
 
   int64_t num_rows() const override {
+    if (buffered_row_group_ && !column_writers_.empty()) {
+      // The columns may be filled one after the other, they are only checked
+      // to have the same number of rows on Close()
+      return column_writers_[0]->rows_written();
+    }
     if (current_column_writer_) {
       CheckRowsWritten();
     }
@@ -79,6 +116,10 @@ class RowGroupSerializer : public RowGroupWriter::Contents {
   }
 
   ColumnWriter* NextColumn() override {
+    if (buffered_row_group_) {
+      throw ParquetException("NextColumn() is not supported on a buffered RowGroup");
+    }
+
     if (current_column_writer_) {
       CheckRowsWritten();
     }
@@ -88,20 +129,58 @@ class RowGroupSerializer : public RowGroupWriter::Contents {
 
     if (current_column_writer_) {
       total_bytes_written_ += current_column_writer_->Close();
+      KeepDictionary(current_column_index_ - 1, *current_column_writer_);
     }
 
     ++current_column_index_;
 
-    const ColumnDescriptor* column_descr = col_meta->descr();
-    std::unique_ptr<PageWriter> pager =
-        PageWriter::Open(sink_, properties_->compression(column_descr->path()), col_meta,
-                         properties_->memory_pool());
+    const ColumnProperties& column_properties =
+        properties_->column_properties(col_meta->descr());
+    std::unique_ptr<PageWriter> pager = PageWriter::Open(
+        sink_, column_properties.codec, col_meta, properties_->memory_pool());
     current_column_writer_ = ColumnWriter::Make(col_meta, std::move(pager), properties_);
+    SeedDictionary(current_column_index_ - 1, current_column_writer_.get());
     return current_column_writer_.get();
   }
 
+  ColumnWriter* column(int i) override {
+    if (!buffered_row_group_) {
+      throw ParquetException("column() is only supported on a buffered RowGroup");
+    }
+
+    if (i >= 0 && i < static_cast<int>(column_writers_.size())) {
+      return column_writers_[i].get();
+    }
+    return nullptr;
+  }
+
   int current_column() const override { return metadata_->current_column(); }
 
+  bool buffered() const override { return buffered_row_group_; }
+
+  int64_t EstimatedSize() override {
+    // The previous columns of an unbuffered row group are closed already
+    int64_t size = total_bytes_written_;
+    if (current_column_writer_) {
+      size += current_column_writer_->EstimatedSize();
+    }
+    for (const auto& column_writer : column_writers_) {
+      size += column_writer->EstimatedSize();
+    }
+    return size;
+  }
+
+  int64_t memory_usage() override {
+    int64_t size = 0;
+    if (current_column_writer_) {
+      size += current_column_writer_->memory_usage();
+    }
+    for (const auto& column_writer : column_writers_) {
+      size += column_writer->memory_usage();
+    }
+    return size;
+  }
+
   void Close() override {
     if (!closed_) {
       closed_ = true;
@@ -109,9 +188,22 @@ class RowGroupSerializer : public RowGroupWriter::Contents {
       if (current_column_writer_) {
         CheckRowsWritten();
         total_bytes_written_ += current_column_writer_->Close();
+        KeepDictionary(current_column_index_ - 1, *current_column_writer_);
         current_column_writer_.reset();
       }
 
+      if (buffered_row_group_) {
+        CheckRowsWritten();
+        // Appends the buffered column chunks to the sink in schema order
+        for (size_t i = 0; i < column_writers_.size(); i++) {
+          total_bytes_written_ += column_writers_[i]->Close();
+          KeepDictionary(static_cast<int>(i), *column_writers_[i]);
+          buffered_pagers_[i]->Flush();
+        }
+        column_writers_.clear();
+        buffered_pagers_.clear();
+      }
+
       // Ensures all columns have been written
       metadata_->Finish(total_bytes_written_);
     }
@@ -125,23 +217,175 @@ class RowGroupSerializer : public RowGroupWriter::Contents {
   bool closed_;
   int current_column_index_;
   mutable int64_t num_rows_;
+  bool buffered_row_group_;
+  std::vector<std::shared_ptr<ColumnDictionary>>* column_dictionaries_;
+  std::vector<std::unique_ptr<ChunkedAllocator>>* dictionary_pools_;
+
+  void SeedDictionary(int column_index, ColumnWriter* column_writer) {
+    if (dictionary_pools_ != nullptr) {
+      std::unique_ptr<ChunkedAllocator>& pool = (*dictionary_pools_)[column_index];
+      if (!pool) {
+        pool.reset(new ChunkedAllocator(properties_->memory_pool()));
+      }
+      column_writer->SetDictionaryAllocator(pool.get());
+    }
+    if (column_dictionaries_ != nullptr && (*column_dictionaries_)[column_index]) {
+      column_writer->SeedDictionary(*(*column_dictionaries_)[column_index]);
+    }
+  }
+
+  void KeepDictionary(int column_index, const ColumnWriter& column_writer) {
+    if (column_dictionaries_ != nullptr) {
+      (*column_dictionaries_)[column_index] = column_writer.dictionary();
+    }
+  }
 
   void CheckRowsWritten() const {
-    int64_t current_rows = current_column_writer_->rows_written();
+    if (buffered_row_group_) {
+      // All columns are being written at the same time, check all of them
+      for (size_t i = 0; i < column_writers_.size(); i++) {
+        CheckRowsWritten(static_cast<int>(i), column_writers_[i]->rows_written());
+      }
+    } else {
+      CheckRowsWritten(current_column_index_, current_column_writer_->rows_written());
+    }
+  }
+
+  void CheckRowsWritten(int column_index, int64_t current_rows) const {
     if (num_rows_ < 0) {
       num_rows_ = current_rows;
       metadata_->set_num_rows(current_rows);
     } else if (num_rows_ != current_rows) {
       std::stringstream ss;
-      ss << "Column " << current_column_index_ << " had " << current_rows
+      ss << "Column " << column_index << " had " << current_rows
          << " while previous column had " << num_rows_;
       throw ParquetException(ss.str());
     }
   }
 
+  void InitColumns() {
+    for (int i = 0; i < num_columns(); i++) {
+      auto col_meta = metadata_->NextColumnChunk();
+      const ColumnProperties& column_properties =
+          properties_->column_properties(col_meta->descr());
+      std::unique_ptr<PageWriter> pager = PageWriter::Open(
+          sink_, column_properties.codec, col_meta, properties_->memory_pool(),
+          buffered_row_group_);
+      // Owned by the ColumnWriter
+      buffered_pagers_.push_back(pager.get());
+      column_writers_.push_back(
+          ColumnWriter::Make(col_meta, std::move(pager), properties_));
+      SeedDictionary(i, column_writers_.back().get());
+    }
+  }
+
   std::shared_ptr<ColumnWriter> current_column_writer_;
+  std::vector<std::shared_ptr<ColumnWriter>> column_writers_;
+  std::vector<PageWriter*> buffered_pagers_;
 };
 
+// ----------------------------------------------------------------------
+// Transcoding of column chunks
+
+// Compresses data with the codec of pager, or returns it as it is if the
+// writer does not compress
+static std::shared_ptr<Buffer> CompressPage(PageWriter* pager,
+                                            const std::shared_ptr<Buffer>& data,
+                                            MemoryPool* pool) {
+  if (!pager->has_compressor()) {
+    return data;
+  }
+  std::shared_ptr<ResizableBuffer> compressed = AllocateBuffer(pool, 0);
+  pager->Compress(*data, compressed.get());
+  return compressed;
+}
+
+// Writes the pages of a column chunk through pager, recompressed with its
+// codec. The pages are only decompressed, their values, levels and
+// dictionaries are never decoded. Returns the size of the written pages
+static int64_t TranscodeColumnChunk(const ColumnChunkMetaData& source,
+                                    PageReader* pages, PageWriter* pager,
+                                    ColumnChunkMetaDataBuilder* metadata,
+                                    MemoryPool* pool) {
+  const ColumnDescriptor* descr = metadata->descr();
+  std::unique_ptr<HyperLogLog> sketch = source.distinct_count_sketch();
+  if (source.is_stats_set()) {
+    EncodedStatistics statistics = source.statistics()->Encode();
+    if (sketch != nullptr) {
+      statistics.set_distinct_count(sketch->Estimate());
+    }
+    metadata->SetStatistics(SortOrder::SIGNED == descr->sort_order(), statistics);
+  }
+  if (sketch != nullptr) {
+    metadata->SetDistinctCountSketch(*sketch);
+  }
+  metadata->SetEncodings(source.encodings());
+
+  int64_t total_bytes_written = 0;
+  bool has_dictionary = false;
+  // Index of the first row of the next page. The pages of repeated columns
+  // only tell their number of rows in DATA_PAGE_V2 headers, -1 once unknown
+  const bool repeated = descr->max_repetition_level() > 0;
+  int64_t first_row_index = 0;
+  std::shared_ptr<Page> page;
+  while ((page = pages->NextPage()) != nullptr) {
+    if (page->type() == PageType::DICTIONARY_PAGE) {
+      // The page writer compresses dictionary pages itself
+      total_bytes_written +=
+          pager->WriteDictionaryPage(static_cast<const DictionaryPage&>(*page));
+      has_dictionary = true;
+    } else if (page->type() == PageType::DATA_PAGE) {
+      const DataPage& data_page = static_cast<const DataPage&>(*page);
+      if (repeated) {
+        first_row_index = -1;
+      }
+      CompressedDataPage out(CompressPage(pager, page->buffer(), pool),
+                             data_page.num_values(), data_page.encoding(),
+                             data_page.definition_level_encoding(),
+                             data_page.repetition_level_encoding(), page->size(),
+                             data_page.statistics(), first_row_index);
+      total_bytes_written += pager->WriteDataPage(out);
+      if (first_row_index >= 0) {
+        first_row_index += data_page.num_values();
+      }
+    } else if (page->type() == PageType::DATA_PAGE_V2) {
+      const DataPageV2& data_page = static_cast<const DataPageV2&>(*page);
+      // The levels stay uncompressed, the values are only stored compressed
+      // if that makes them smaller
+      const int64_t levels_size = data_page.definition_levels_byte_length() +
+                                  data_page.repetition_levels_byte_length();
+      std::shared_ptr<Buffer> data = page->buffer();
+      bool is_compressed = false;
+      if (pager->has_compressor()) {
+        std::shared_ptr<Buffer> values = CompressPage(
+            pager, ::arrow::SliceBuffer(data, levels_size, data->size() - levels_size),
+            pool);
+        if (values->size() < data->size() - levels_size) {
+          std::shared_ptr<ResizableBuffer> buffer =
+              AllocateBuffer(pool, levels_size + values->size());
+          memcpy(buffer->mutable_data(), data->data(), levels_size);
+          memcpy(buffer->mutable_data() + levels_size, values->data(), values->size());
+          data = buffer;
+          is_compressed = true;
+        }
+      }
+      CompressedDataPage out(data, data_page.num_values(), data_page.encoding(),
+                             Encoding::RLE, Encoding::RLE, page->size(),
+                             data_page.statistics(), first_row_index);
+      out.set_v2(data_page.num_nulls(), data_page.num_rows(),
+                 data_page.definition_levels_byte_length(),
+                 data_page.repetition_levels_byte_length());
+      out.set_is_compressed(is_compressed);
+      total_bytes_written += pager->WriteDataPage(out);
+      if (first_row_index >= 0) {
+        first_row_index += data_page.num_rows();
+      }
+    }
+  }
+  pager->Close(has_dictionary, false);
+  return total_bytes_written;
+}
+
 // ----------------------------------------------------------------------
 // FileSerializer
 
@@ -163,16 +407,19 @@ class FileSerializer : public ParquetFileWriter::Contents {
   void Close() override {
     if (is_open_) {
       if (row_group_writer_) {
-        num_rows_ += row_group_writer_->num_rows();
         row_group_writer_->Close();
+        num_rows_ += row_group_writer_->num_rows();
       }
       row_group_writer_.reset();
+      FreeDictionaryPools();
 
       // Write magic bytes and metadata
       WriteMetaData();
 
-      sink_->Close();
+      // Not retried by the destructor if closing the sink throws, e.g. with
+      // the error of an asynchronous write
       is_open_ = false;
+      sink_->Close();
     }
   }
 
@@ -186,23 +433,93 @@ class FileSerializer : public ParquetFileWriter::Contents {
     return properties_;
   }
 
-  RowGroupWriter* AppendRowGroup() override {
+  RowGroupWriter* AppendRowGroup(bool buffered_row_group) {
     if (row_group_writer_) {
       row_group_writer_->Close();
     }
     num_row_groups_++;
     auto rg_metadata = metadata_->AppendRowGroup();
     std::unique_ptr<RowGroupWriter::Contents> contents(
-        new RowGroupSerializer(sink_.get(), rg_metadata, properties_.get()));
+        new RowGroupSerializer(
+            sink_.get(), rg_metadata, properties_.get(), buffered_row_group,
+            &column_dictionaries_,
+            properties_->dictionary_memory_reuse_enabled() ? &dictionary_pools_
+                                                           : nullptr));
     row_group_writer_.reset(new RowGroupWriter(std::move(contents)));
     return row_group_writer_.get();
   }
 
+  RowGroupWriter* AppendRowGroup() override { return AppendRowGroup(false); }
+
+  RowGroupWriter* AppendBufferedRowGroup() override { return AppendRowGroup(true); }
+
+  void AppendRowGroups(RandomAccessSource* source, const FileMetaData& metadata,
+                       const std::vector<int>& row_groups) override {
+    for (int i : StartAppendingRowGroups(metadata, row_groups)) {
+      std::unique_ptr<RowGroupMetaData> row_group = metadata.RowGroup(i);
+      std::vector<std::unique_ptr<ColumnChunkMetaData>> columns;
+      for (int column = 0; column < row_group->num_columns(); ++column) {
+        columns.push_back(row_group->ColumnChunk(column));
+        if (!columns.back()->file_path().empty()) {
+          throw ParquetException("Cannot copy column chunks stored in another file");
+        }
+      }
+
+      RowGroupMetaDataBuilder* rg_metadata = metadata_->AppendRowGroup();
+      int64_t total_bytes_written = 0;
+      for (const auto& column : columns) {
+        int64_t start = column->data_page_offset();
+        if (column->has_dictionary_page()) {
+          start = std::min(start, column->dictionary_page_offset());
+        }
+        rg_metadata->NextColumnChunk()->CopyFrom(*column, sink_->Tell());
+        CopyBytes(source, start, column->total_compressed_size());
+        total_bytes_written += column->total_compressed_size();
+      }
+      rg_metadata->set_num_rows(row_group->num_rows());
+      rg_metadata->set_sorting_columns(row_group->sorting_columns());
+      rg_metadata->Finish(total_bytes_written);
+      num_row_groups_++;
+      num_rows_ += row_group->num_rows();
+    }
+    // The dictionaries of the copied chunks are not known to the writer
+    std::fill(column_dictionaries_.begin(), column_dictionaries_.end(), nullptr);
+  }
+
+  void TranscodeRowGroups(ParquetFileReader* reader,
+                          const std::vector<int>& row_groups) override {
+    std::shared_ptr<FileMetaData> metadata = reader->metadata();
+    for (int i : StartAppendingRowGroups(*metadata, row_groups)) {
+      std::shared_ptr<RowGroupReader> row_group = reader->RowGroup(i);
+      RowGroupMetaDataBuilder* rg_metadata = metadata_->AppendRowGroup();
+      int64_t total_bytes_written = 0;
+      for (int column = 0; column < num_columns(); ++column) {
+        ColumnChunkMetaDataBuilder* col_meta = rg_metadata->NextColumnChunk();
+        const ColumnProperties& column_properties =
+            properties_->column_properties(col_meta->descr());
+        std::unique_ptr<PageWriter> pager = PageWriter::Open(
+            sink_.get(), column_properties.codec, col_meta, properties_->memory_pool());
+        std::unique_ptr<PageReader> pages = row_group->GetColumnPageReader(column);
+        total_bytes_written +=
+            TranscodeColumnChunk(*row_group->metadata()->ColumnChunk(column),
+                                 pages.get(), pager.get(), col_meta,
+                                 properties_->memory_pool());
+      }
+      rg_metadata->set_num_rows(row_group->metadata()->num_rows());
+      rg_metadata->set_sorting_columns(row_group->metadata()->sorting_columns());
+      rg_metadata->Finish(total_bytes_written);
+      num_row_groups_++;
+      num_rows_ += row_group->metadata()->num_rows();
+    }
+    std::fill(column_dictionaries_.begin(), column_dictionaries_.end(), nullptr);
+  }
+
   ~FileSerializer() override {
     try {
       Close();
     } catch (...) {
     }
+    FreeDictionaryPools();
   }
 
  private:
@@ -213,10 +530,17 @@ class FileSerializer : public ParquetFileWriter::Contents {
       : ParquetFileWriter::Contents(schema, key_value_metadata),
         sink_(sink),
         is_open_(true),
-        properties_(properties),
+        properties_(properties->ResolveColumns(&schema_)),
         num_row_groups_(0),
         num_rows_(0),
-        metadata_(FileMetaDataBuilder::Make(&schema_, properties, key_value_metadata)) {
+        metadata_(FileMetaDataBuilder::Make(&schema_, properties_, key_value_metadata)),
+        column_dictionaries_(schema_.num_columns()),
+        dictionary_pools_(schema_.num_columns()) {
+    if (properties_->async_write_budget() > 0) {
+      sink_ = std::make_shared<AsyncOutputStream>(
+          sink_, properties_->async_write_block_size(),
+          properties_->async_write_budget(), properties_->memory_pool());
+    }
     StartFile();
   }
 
@@ -226,20 +550,76 @@ class FileSerializer : public ParquetFileWriter::Contents {
   int num_row_groups_;
   int64_t num_rows_;
   std::unique_ptr<FileMetaDataBuilder> metadata_;
+  // Dictionaries of the column chunks of the last row group, see
+  // WriterProperties::dictionary_reuse_enabled
+  std::vector<std::shared_ptr<ColumnDictionary>> column_dictionaries_;
+  // Allocators of the dictionary values of the columns that are reused across
+  // row groups, see WriterProperties::dictionary_memory_reuse_enabled
+  std::vector<std::unique_ptr<ChunkedAllocator>> dictionary_pools_;
   std::unique_ptr<RowGroupWriter> row_group_writer_;
 
+  void FreeDictionaryPools() {
+    for (auto& pool : dictionary_pools_) {
+      if (pool) {
+        pool->FreeAll();
+      }
+    }
+  }
+
+  // Checks that row groups of a file with the given metadata can be appended
+  // and closes the current row group. Returns the indices of the row groups
+  // to append, all of them if row_groups is empty
+  std::vector<int> StartAppendingRowGroups(const FileMetaData& metadata,
+                                           const std::vector<int>& row_groups) {
+    if (!metadata.schema()->Equals(schema_)) {
+      throw ParquetException("Cannot append row groups of a file with another schema");
+    }
+    if (row_group_writer_) {
+      row_group_writer_->Close();
+      num_rows_ += row_group_writer_->num_rows();
+      row_group_writer_.reset();
+    }
+
+    std::vector<int> indices = row_groups;
+    if (indices.empty()) {
+      for (int i = 0; i < metadata.num_row_groups(); ++i) {
+        indices.push_back(i);
+      }
+    }
+    return indices;
+  }
+
+  // Size of the reads when copying column chunks
+  static constexpr int64_t kCopyBlockSize = 1 << 22;
+
+  void CopyBytes(RandomAccessSource* source, int64_t position, int64_t length) {
+    while (length > 0) {
+      const int64_t nbytes = std::min(length, kCopyBlockSize);
+      std::shared_ptr<Buffer> block = source->ReadAt(position, nbytes);
+      if (block->size() != nbytes) {
+        throw ParquetException("Column chunk extends past the end of the file");
+      }
+      sink_->Write(block->data(), nbytes);
+      position += nbytes;
+      length -= nbytes;
+    }
+  }
+
   void StartFile() {
     // Parquet files always start with PAR1
     sink_->Write(PARQUET_MAGIC, 4);
   }
 
   void WriteMetaData() {
+    // The page indexes of all row groups precede the footer
+    metadata_->WritePageIndex(sink_.get());
+
     // Write MetaData
     uint32_t metadata_len = static_cast<uint32_t>(sink_->Tell());
 
     // Get a FileMetaData
-    auto metadata = metadata_->Finish();
-    metadata->WriteTo(sink_.get());
+    file_metadata_ = metadata_->Finish();
+    file_metadata_->WriteTo(sink_.get());
     metadata_len = static_cast<uint32_t>(sink_->Tell()) - metadata_len;
 
     // Write Footer
@@ -248,6 +628,8 @@ class FileSerializer : public ParquetFileWriter::Contents {
   }
 };
 
+constexpr int64_t FileSerializer::kCopyBlockSize;
+
 // ----------------------------------------------------------------------
 // ParquetFileWriter public API
 
@@ -304,6 +686,7 @@ void ParquetFileWriter::Open(std::unique_ptr<ParquetFileWriter::Contents> conten
 void ParquetFileWriter::Close() {
   if (contents_) {
     contents_->Close();
+    file_metadata_ = contents_->metadata();
     contents_.reset();
   }
 }
@@ -312,6 +695,21 @@ RowGroupWriter* ParquetFileWriter::AppendRowGroup() {
   return contents_->AppendRowGroup();
 }
 
+RowGroupWriter* ParquetFileWriter::AppendBufferedRowGroup() {
+  return contents_->AppendBufferedRowGroup();
+}
+
+void ParquetFileWriter::AppendRowGroups(RandomAccessSource* source,
+                                        const FileMetaData& metadata,
+                                        const std::vector<int>& row_groups) {
+  contents_->AppendRowGroups(source, metadata, row_groups);
+}
+
+void ParquetFileWriter::TranscodeRowGroups(ParquetFileReader* reader,
+                                           const std::vector<int>& row_groups) {
+  contents_->TranscodeRowGroups(reader, row_groups);
+}
+
 RowGroupWriter* ParquetFileWriter::AppendRowGroup(int64_t num_rows) {
   return AppendRowGroup();
 }
@@ -320,4 +718,17 @@ const std::shared_ptr<WriterProperties>& ParquetFileWriter::properties() const {
   return contents_->properties();
 }
 
+const std::shared_ptr<FileMetaData>& ParquetFileWriter::metadata() const {
+  return file_metadata_;
+}
+
+void WriteMetaDataFile(const FileMetaData& metadata, OutputStream* sink) {
+  sink->Write(PARQUET_MAGIC, 4);
+  int64_t position = sink->Tell();
+  metadata.WriteTo(sink);
+  uint32_t metadata_len = static_cast<uint32_t>(sink->Tell() - position);
+  sink->Write(reinterpret_cast<uint8_t*>(&metadata_len), 4);
+  sink->Write(PARQUET_MAGIC, 4);
+}
+
 }  // namespace parquet
@@ -20,6 +20,9 @@
 
 #include <cstdint>
 #include <memory>
+#include <vector>
+
+#include "parquet/exception.h"
 
 #include "parquet/metadata.h"
 #include "parquet/properties.h"
@@ -32,6 +35,7 @@ namespace parquet {
 class ColumnWriter;
 class PageWriter;
 class OutputStream;
+class ParquetFileReader;
 
 namespace schema {
 
@@ -50,8 +54,14 @@ class PARQUET_EXPORT RowGroupWriter {
     virtual int64_t num_rows() const = 0;
 
     virtual ColumnWriter* NextColumn() = 0;
+    virtual ColumnWriter* column(int i) = 0;
     virtual int current_column() const = 0;
     virtual void Close() = 0;
+
+    virtual bool buffered() const = 0;
+
+    virtual int64_t EstimatedSize() = 0;
+    virtual int64_t memory_usage() = 0;
   };
 
   explicit RowGroupWriter(std::unique_ptr<Contents> contents);
@@ -67,13 +77,41 @@ class PARQUET_EXPORT RowGroupWriter {
   int current_column();
   void Close();
 
+  /// Return the ColumnWriter of the indicated column of a buffered row group.
+  ///
+  /// Ownership is solely within the RowGroupWriter. All ColumnWriters of a
+  /// buffered row group are valid until Close, and different columns may be
+  /// written and closed from different threads. The columns are appended to
+  /// the sink in schema order on Close.
+  ColumnWriter* column(int i);
+
+  /// True if this row group was started with ParquetFileWriter::AppendBufferedRowGroup
+  bool buffered() const;
+
   int num_columns() const;
 
   /**
    * Number of rows that shall be written as part of this RowGroup.
+   *
+   * Until a buffered RowGroup is closed this is the number of rows written to
+   * its first column, the columns are checked to agree on Close().
    */
   int64_t num_rows() const;
 
+  /// Estimated size in bytes of the row group so far, see
+  /// ColumnWriter::EstimatedSize and WriterProperties::max_row_group_bytes.
+  ///
+  /// The columns of a buffered row group must not be written concurrently
+  /// with this call.
+  int64_t EstimatedSize();
+
+  /// Bytes the column writers of the row group hold in memory, see
+  /// ColumnWriter::memory_usage and WriterProperties::memory_limit.
+  ///
+  /// The columns of a buffered row group must not be written concurrently
+  /// with this call.
+  int64_t memory_usage();
+
  private:
   // Holds a pointer to an instance of Contents implementation
   std::unique_ptr<Contents> contents_;
@@ -98,6 +136,16 @@ class PARQUET_EXPORT ParquetFileWriter {
     RowGroupWriter* AppendRowGroup(int64_t num_rows);
 
     virtual RowGroupWriter* AppendRowGroup() = 0;
+    virtual RowGroupWriter* AppendBufferedRowGroup() = 0;
+    // Implementations that only write through ColumnWriters may leave this out
+    virtual void AppendRowGroups(RandomAccessSource* source, const FileMetaData& metadata,
+                                 const std::vector<int>& row_groups) {
+      throw ParquetException("Copying row groups is not supported by this writer");
+    }
+    virtual void TranscodeRowGroups(ParquetFileReader* reader,
+                                    const std::vector<int>& row_groups) {
+      throw ParquetException("Transcoding row groups is not supported by this writer");
+    }
 
     virtual int64_t num_rows() const = 0;
     virtual int num_columns() const = 0;
@@ -112,10 +160,15 @@ class PARQUET_EXPORT ParquetFileWriter {
     // Return const-pointer to make it clear that this object is not to be copied
     const SchemaDescriptor* schema() const { return &schema_; }
 
+    // The metadata of the file, set on Close
+    const std::shared_ptr<FileMetaData>& metadata() const { return file_metadata_; }
+
     SchemaDescriptor schema_;
 
     /// This should be the only place this is stored. Everything else is a const reference
     std::shared_ptr<const KeyValueMetadata> key_value_metadata_;
+
+    std::shared_ptr<FileMetaData> file_metadata_;
   };
 
   ParquetFileWriter();
@@ -151,6 +204,42 @@ class PARQUET_EXPORT ParquetFileWriter {
   /// until the next call to AppendRowGroup or Close.
   RowGroupWriter* AppendRowGroup();
 
+  /// Construct a RowGroupWriter whose columns are buffered in memory.
+  ///
+  /// All columns can be written at the same time, e.g. on several threads,
+  /// through RowGroupWriter::column. The buffered column chunks are written
+  /// to the sink when the row group is closed, so the whole row group must
+  /// fit in memory. Ownership is solely within the ParquetFileWriter. The
+  /// RowGroupWriter is only valid until the next call to AppendRowGroup,
+  /// AppendBufferedRowGroup or Close.
+  RowGroupWriter* AppendBufferedRowGroup();
+
+  /// Append row groups of another file by copying their column chunks as they
+  /// are, without decoding and re-encoding the pages.
+  ///
+  /// The file must have the same schema. Statistics, encodings and codecs of
+  /// the column chunks are carried over, their page indexes and Bloom filters
+  /// are dropped. Closes the current RowGroupWriter, if any.
+  /// \param[in] source the file that metadata was read from
+  /// \param[in] metadata the metadata of source
+  /// \param[in] row_groups the row groups to append, all if empty
+  void AppendRowGroups(RandomAccessSource* source, const FileMetaData& metadata,
+                       const std::vector<int>& row_groups = {});
+
+  /// Append row groups of another file whose pages are recompressed with the
+  /// codecs of this writer's properties, e.g. to move a file from SNAPPY to
+  /// ZSTD.
+  ///
+  /// The pages are only decompressed, their values, levels and dictionaries
+  /// are never decoded. Page headers and column chunk metadata are rewritten
+  /// for the new sizes; encodings and statistics are carried over and the
+  /// page index is rebuilt. The file must have the same schema. Closes the
+  /// current RowGroupWriter, if any.
+  /// \param[in] reader the file to read the pages from
+  /// \param[in] row_groups the row groups to append, all if empty
+  void TranscodeRowGroups(ParquetFileReader* reader,
+                          const std::vector<int>& row_groups = {});
+
   /// Number of columns.
   ///
   /// This number is fixed during the lifetime of the writer as it is determined via
@@ -177,11 +266,30 @@ class PARQUET_EXPORT ParquetFileWriter {
   /// Returns the file custom metadata
   const std::shared_ptr<const KeyValueMetadata>& key_value_metadata() const;
 
+  /// Returns the metadata of the written file, only available after Close.
+  ///
+  /// The metadata of several files can be combined with FileMetaData::Combine
+  /// and written to a summary file with WriteMetaDataFile.
+  const std::shared_ptr<FileMetaData>& metadata() const;
+
  private:
   // Holds a pointer to an instance of Contents implementation
   std::unique_ptr<Contents> contents_;
+  std::shared_ptr<FileMetaData> file_metadata_;
 };
 
+/// \brief Write a file that only holds the metadata, e.g. the _metadata
+/// summary file of a dataset.
+///
+/// The file has the layout of a Parquet file without any column chunks, so it
+/// can be opened with ReadMetaData or ParquetFileReader to inspect the
+/// metadata. The reader ignores ColumnChunk.file_path, though: reading column
+/// data through a ParquetFileReader of the summary file would read the summary
+/// file itself, so the data has to be read from the files that file_path
+/// names.
+PARQUET_EXPORT
+void WriteMetaDataFile(const FileMetaData& metadata, OutputStream* sink);
+
 }  // namespace parquet
 
 #endif  // PARQUET_FILE_WRITER_H
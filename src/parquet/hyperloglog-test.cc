@@ -0,0 +1,154 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "arrow/io/memory.h"
+
+#include "parquet/bloom_filter.h"
+#include "parquet/column_writer.h"
+#include "parquet/file_reader.h"
+#include "parquet/file_writer.h"
+#include "parquet/hyperloglog.h"
+#include "parquet/schema.h"
+#include "parquet/util/memory.h"
+
+namespace parquet {
+
+using schema::GroupNode;
+
+namespace test {
+
+// Whether estimate is within tolerance of the actual count
+static ::testing::AssertionResult Near(int64_t actual, int64_t estimate,
+                                       double tolerance) {
+  if (std::abs(static_cast<double>(estimate - actual)) <= tolerance * actual) {
+    return ::testing::AssertionSuccess();
+  }
+  return ::testing::AssertionFailure()
+         << "estimate " << estimate << " of " << actual << " distinct values";
+}
+
+TEST(TestHyperLogLog, Estimate) {
+  HyperLogLog sketch(11);
+  ASSERT_EQ(0, sketch.Estimate());
+
+  // Duplicates do not count
+  for (int repeat = 0; repeat < 3; ++repeat) {
+    for (int64_t i = 0; i < 100; ++i) {
+      sketch.InsertHash(BloomFilter::Hash(i));
+    }
+  }
+  ASSERT_TRUE(Near(100, sketch.Estimate(), 0.05));
+
+  for (int64_t i = 100; i < 100000; ++i) {
+    sketch.InsertHash(BloomFilter::Hash(i));
+  }
+  ASSERT_TRUE(Near(100000, sketch.Estimate(), 0.08));
+
+  ASSERT_THROW(HyperLogLog(3), ParquetException);
+  ASSERT_THROW(HyperLogLog(17), ParquetException);
+}
+
+TEST(TestHyperLogLog, MergeAndSerialize) {
+  HyperLogLog a(10);
+  HyperLogLog b(10);
+  for (int64_t i = 0; i < 6000; ++i) {
+    a.InsertHash(BloomFilter::Hash(i));
+    b.InsertHash(BloomFilter::Hash(i + 4000));
+  }
+  a.Merge(b);
+  ASSERT_TRUE(Near(10000, a.Estimate(), 0.1));
+  ASSERT_THROW(a.Merge(HyperLogLog(11)), ParquetException);
+
+  std::unique_ptr<HyperLogLog> result = HyperLogLog::Deserialize(a.Serialize());
+  ASSERT_EQ(10, result->precision());
+  ASSERT_EQ(a.Estimate(), result->Estimate());
+  ASSERT_EQ(a.Serialize(), result->Serialize());
+
+  // The footer cost of a sketch per column chunk
+  ASSERT_EQ(257U, HyperLogLog(DEFAULT_DISTINCT_COUNT_PRECISION).Serialize().size());
+
+  ASSERT_THROW(HyperLogLog::Deserialize(""), ParquetException);
+  ASSERT_THROW(HyperLogLog::Deserialize(a.Serialize().substr(1)), ParquetException);
+}
+
+TEST(TestHyperLogLog, ColumnChunk) {
+  const int num_rows = 5000;
+  auto gnode = std::static_pointer_cast<GroupNode>(GroupNode::Make(
+      "schema", Repetition::REQUIRED,
+      {schema::Int64("id", Repetition::REQUIRED),
+       schema::Int32("plain", Repetition::REQUIRED)}));
+  std::shared_ptr<WriterProperties> properties = WriterProperties::Builder()
+                                                     .enable_distinct_count("id", 11)
+                                                     ->build();
+
+  // Each row group holds 1000 distinct ids, half of them shared with the
+  // previous row group
+  std::shared_ptr<InMemoryOutputStream> sink(new InMemoryOutputStream());
+  auto file_writer = ParquetFileWriter::Open(sink, gnode, properties);
+  for (int rg = 0; rg < 3; ++rg) {
+    std::vector<int64_t> ids(num_rows);
+    std::vector<int32_t> plain(num_rows);
+    for (int i = 0; i < num_rows; ++i) {
+      ids[i] = rg * 500 + i % 1000;
+      plain[i] = i;
+    }
+    RowGroupWriter* row_group_writer = file_writer->AppendRowGroup();
+    static_cast<Int64Writer*>(row_group_writer->NextColumn())
+        ->WriteBatch(num_rows, nullptr, nullptr, ids.data());
+    static_cast<Int32Writer*>(row_group_writer->NextColumn())
+        ->WriteBatch(num_rows, nullptr, nullptr, plain.data());
+    row_group_writer->Close();
+  }
+  file_writer->Close();
+
+  auto file_reader = ParquetFileReader::Open(
+      std::make_shared<::arrow::io::BufferReader>(sink->GetBuffer()));
+  std::shared_ptr<FileMetaData> metadata = file_reader->metadata();
+  std::unique_ptr<HyperLogLog> merged;
+  for (int rg = 0; rg < 3; ++rg) {
+    std::unique_ptr<ColumnChunkMetaData> id_column =
+        metadata->RowGroup(rg)->ColumnChunk(0);
+    ASSERT_TRUE(Near(1000, id_column->statistics()->distinct_count(), 0.05));
+    std::unique_ptr<HyperLogLog> sketch = id_column->distinct_count_sketch();
+    ASSERT_NE(nullptr, sketch);
+    ASSERT_EQ(11, sketch->precision());
+    ASSERT_EQ(id_column->statistics()->distinct_count(), sketch->Estimate());
+    if (merged == nullptr) {
+      merged = std::move(sketch);
+    } else {
+      merged->Merge(*sketch);
+    }
+
+    std::unique_ptr<ColumnChunkMetaData> plain_column =
+        metadata->RowGroup(rg)->ColumnChunk(1);
+    ASSERT_EQ(nullptr, plain_column->distinct_count_sketch());
+    ASSERT_EQ(0, plain_column->statistics()->distinct_count());
+  }
+  ASSERT_TRUE(Near(2000, merged->Estimate(), 0.05));
+}
+
+}  // namespace test
+
+}  // namespace parquet
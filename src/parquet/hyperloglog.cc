@@ -0,0 +1,151 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "parquet/hyperloglog.h"
+
+#include <cmath>
+#include <sstream>
+
+#if defined(_MSC_VER) && defined(_M_X64)
+#include <intrin.h>
+#endif
+
+#include "parquet/exception.h"
+
+namespace parquet {
+
+constexpr int HyperLogLog::kMinimumPrecision;
+constexpr int HyperLogLog::kMaximumPrecision;
+
+static void CheckPrecision(int precision) {
+  if (precision < HyperLogLog::kMinimumPrecision ||
+      precision > HyperLogLog::kMaximumPrecision) {
+    std::stringstream ss;
+    ss << "HyperLogLog precision must be in [" << HyperLogLog::kMinimumPrecision << ", "
+       << HyperLogLog::kMaximumPrecision << "], got " << precision;
+    throw ParquetException(ss.str());
+  }
+}
+
+HyperLogLog::HyperLogLog(int precision) : precision_(precision) {
+  CheckPrecision(precision);
+  registers_.resize(static_cast<size_t>(1) << precision, 0);
+}
+
+std::unique_ptr<HyperLogLog> HyperLogLog::Deserialize(const std::string& data) {
+  if (data.empty()) {
+    throw ParquetException("Empty HyperLogLog sketch");
+  }
+  const int precision = static_cast<uint8_t>(data[0]);
+  CheckPrecision(precision);
+  std::unique_ptr<HyperLogLog> sketch(new HyperLogLog(precision));
+  if (data.size() != sketch->registers_.size() + 1) {
+    throw ParquetException("HyperLogLog sketch does not match its precision");
+  }
+  const int max_rank = 64 - precision + 1;
+  for (size_t i = 0; i < sketch->registers_.size(); ++i) {
+    const uint8_t rank = static_cast<uint8_t>(data[i + 1]);
+    if (rank > max_rank) {
+      throw ParquetException("Invalid HyperLogLog register");
+    }
+    sketch->registers_[i] = rank;
+  }
+  return sketch;
+}
+
+// Number of leading zero bits of a non-zero value
+static inline int CountLeadingZeros(uint64_t value) {
+#if defined(__GNUC__)
+  return __builtin_clzll(value);
+#elif defined(_MSC_VER) && defined(_M_X64)
+  unsigned long index;
+  _BitScanReverse64(&index, value);
+  return 63 - static_cast<int>(index);
+#else
+  int count = 0;
+  for (uint64_t bit = static_cast<uint64_t>(1) << 63; (value & bit) == 0; bit >>= 1) {
+    ++count;
+  }
+  return count;
+#endif
+}
+
+void HyperLogLog::InsertHash(uint64_t hash) {
+  const uint64_t index = hash >> (64 - precision_);
+  // The set guard bit bounds the rank by 64 - precision + 1
+  const uint64_t rest =
+      (hash << precision_) | (static_cast<uint64_t>(1) << (precision_ - 1));
+  const uint8_t rank = static_cast<uint8_t>(CountLeadingZeros(rest) + 1);
+  if (rank > registers_[index]) {
+    registers_[index] = rank;
+  }
+}
+
+void HyperLogLog::Merge(const HyperLogLog& other) {
+  if (other.precision_ != precision_) {
+    throw ParquetException("Cannot merge HyperLogLog sketches of different precision");
+  }
+  for (size_t i = 0; i < registers_.size(); ++i) {
+    if (other.registers_[i] > registers_[i]) {
+      registers_[i] = other.registers_[i];
+    }
+  }
+}
+
+int64_t HyperLogLog::Estimate() const {
+  const double m = static_cast<double>(registers_.size());
+  double sum = 0;
+  int zeros = 0;
+  for (uint8_t rank : registers_) {
+    sum += std::ldexp(1.0, -rank);
+    zeros += rank == 0;
+  }
+
+  double alpha;
+  switch (precision_) {
+    case 4:
+      alpha = 0.673;
+      break;
+    case 5:
+      alpha = 0.697;
+      break;
+    case 6:
+      alpha = 0.709;
+      break;
+    default:
+      alpha = 0.7213 / (1 + 1.079 / m);
+      break;
+  }
+  double estimate = alpha * m * m / sum;
+  // Linear counting is more accurate while many registers are empty. With 64
+  // bit hashes no correction is needed for large cardinalities.
+  if (estimate <= 2.5 * m && zeros > 0) {
+    estimate = m * std::log(m / zeros);
+  }
+  return static_cast<int64_t>(std::llround(estimate));
+}
+
+std::string HyperLogLog::Serialize() const {
+  std::string data(registers_.size() + 1, '\0');
+  data[0] = static_cast<char>(precision_);
+  for (size_t i = 0; i < registers_.size(); ++i) {
+    data[i + 1] = static_cast<char>(registers_[i]);
+  }
+  return data;
+}
+
+}  // namespace parquet
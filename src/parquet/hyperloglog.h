@@ -0,0 +1,70 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef PARQUET_HYPERLOGLOG_H
+#define PARQUET_HYPERLOGLOG_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "parquet/util/visibility.h"
+
+namespace parquet {
+
+// HyperLogLog sketch of the distinct values of a column chunk, fed with the
+// same 64 bit hashes as the Bloom filter, see BloomFilter::Hash. The first
+// precision bits of a hash select one of 2^precision registers, which keeps
+// the longest run of leading zeros in the remaining bits. The relative error
+// of the estimate is about 1.04 / sqrt(2^precision).
+//
+// Sketches of the same precision can be merged, e.g. the sketches of all
+// column chunks of a column to estimate its distinct values in a file.
+class PARQUET_EXPORT HyperLogLog {
+ public:
+  static constexpr int kMinimumPrecision = 4;
+  static constexpr int kMaximumPrecision = 16;
+
+  // An empty sketch of 2^precision registers
+  explicit HyperLogLog(int precision);
+
+  // Read a sketch written by Serialize, throws ParquetException if it is
+  // malformed
+  static std::unique_ptr<HyperLogLog> Deserialize(const std::string& data);
+
+  void InsertHash(uint64_t hash);
+
+  // Add the values of other, which must have the same precision
+  void Merge(const HyperLogLog& other);
+
+  // Estimated number of distinct hashes inserted
+  int64_t Estimate() const;
+
+  int precision() const { return precision_; }
+
+  // One byte of precision followed by one byte per register
+  std::string Serialize() const;
+
+ private:
+  int precision_;
+  std::vector<uint8_t> registers_;
+};
+
+}  // namespace parquet
+
+#endif  // PARQUET_HYPERLOGLOG_H
@@ -17,6 +17,8 @@
 
 #include "parquet/metadata.h"
 #include <gtest/gtest.h>
+#include <string>
+#include "parquet/metadata_cache.h"
 #include "parquet/schema.h"
 #include "parquet/statistics.h"
 #include "parquet/types.h"
@@ -185,6 +187,134 @@ TEST(Metadata, TestV1Version) {
   ASSERT_EQ(ParquetVersion::PARQUET_1_0, f_accessor->version());
 }
 
+TEST(Metadata, TestLazyColumnChunks) {
+  parquet::schema::NodeVector fields;
+  parquet::SchemaDescriptor schema;
+
+  std::shared_ptr<WriterProperties> props = WriterProperties::Builder().build();
+
+  const int num_columns = 20;
+  for (int i = 0; i < num_columns; ++i) {
+    fields.push_back(
+        parquet::schema::Int64("col" + std::to_string(i), Repetition::OPTIONAL));
+  }
+  schema.Init(parquet::schema::GroupNode::Make("schema", Repetition::REQUIRED, fields));
+
+  int64_t min = 7, max = 42;
+  EncodedStatistics stats;
+  stats.set_null_count(3)
+      .set_min(std::string(reinterpret_cast<const char*>(&min), 8))
+      .set_max(std::string(reinterpret_cast<const char*>(&max), 8));
+
+  auto f_builder = FileMetaDataBuilder::Make(&schema, props);
+  for (int rg = 0; rg < 3; ++rg) {
+    auto rg_builder = f_builder->AppendRowGroup();
+    for (int i = 0; i < num_columns; ++i) {
+      auto col_builder = rg_builder->NextColumnChunk();
+      col_builder->SetStatistics(true, stats);
+      col_builder->Finish(100, 0, 0, 1000 * rg + 10 * i + 4, 10, 20, false, false);
+    }
+    rg_builder->set_num_rows(100 + rg);
+    rg_builder->Finish(1024);
+  }
+  InMemoryOutputStream sink;
+  f_builder->Finish()->WriteTo(&sink);
+  std::shared_ptr<Buffer> serialized = sink.GetBuffer();
+
+  uint32_t eager_len = static_cast<uint32_t>(serialized->size());
+  auto eager = FileMetaData::Make(serialized->data(), &eager_len);
+  uint32_t lazy_len = static_cast<uint32_t>(serialized->size());
+  auto lazy = FileMetaData::Make(serialized->data(), &lazy_len, true);
+
+  ASSERT_EQ(eager_len, lazy_len);
+  ASSERT_EQ(eager->num_rows(), lazy->num_rows());
+  ASSERT_EQ(3, lazy->num_row_groups());
+  ASSERT_EQ(num_columns, lazy->num_columns());
+  ASSERT_EQ(eager->created_by(), lazy->created_by());
+  ASSERT_TRUE(eager->schema()->Equals(*lazy->schema()));
+
+  for (int rg : {2, 0}) {
+    auto rg_accessor = lazy->RowGroup(rg);
+    ASSERT_EQ(num_columns, rg_accessor->num_columns());
+    ASSERT_EQ(100 + rg, rg_accessor->num_rows());
+    ASSERT_EQ(1024, rg_accessor->total_byte_size());
+    for (int i : {13, 0, 13, num_columns - 1}) {
+      auto column = rg_accessor->ColumnChunk(i);
+      ASSERT_EQ(1000 * rg + 10 * i + 4, column->data_page_offset());
+      ASSERT_EQ(100, column->num_values());
+      ASSERT_EQ(schema.Column(i)->path()->ToDotString(),
+                column->path_in_schema()->ToDotString());
+      ASSERT_EQ(stats.min(), column->statistics()->EncodeMin());
+      ASSERT_EQ(stats.max(), column->statistics()->EncodeMax());
+      ASSERT_EQ(3, column->statistics()->null_count());
+    }
+    ASSERT_THROW(rg_accessor->ColumnChunk(num_columns), ParquetException);
+  }
+
+  // The footer is written back unchanged
+  InMemoryOutputStream lazy_sink;
+  lazy->WriteTo(&lazy_sink);
+  ASSERT_TRUE(serialized->Equals(*lazy_sink.GetBuffer()));
+}
+
+static std::shared_ptr<FileMetaData> MakeFileMetaData(int num_columns) {
+  parquet::schema::NodeVector fields;
+  for (int i = 0; i < num_columns; ++i) {
+    fields.push_back(
+        parquet::schema::Int32("col" + std::to_string(i), Repetition::REQUIRED));
+  }
+  parquet::SchemaDescriptor schema;
+  schema.Init(parquet::schema::GroupNode::Make("schema", Repetition::REQUIRED, fields));
+
+  auto f_builder =
+      FileMetaDataBuilder::Make(&schema, WriterProperties::Builder().build());
+  InMemoryOutputStream sink;
+  f_builder->Finish()->WriteTo(&sink);
+  std::shared_ptr<Buffer> serialized = sink.GetBuffer();
+  uint32_t len = static_cast<uint32_t>(serialized->size());
+  return FileMetaData::Make(serialized->data(), &len);
+}
+
+TEST(FileMetaDataCache, LeastRecentlyUsedEviction) {
+  std::shared_ptr<FileMetaData> a = MakeFileMetaData(1);
+  std::shared_ptr<FileMetaData> b = MakeFileMetaData(2);
+  std::shared_ptr<FileMetaData> c = MakeFileMetaData(3);
+  const int64_t size_a = static_cast<int64_t>(a->size());
+  const int64_t size_b = static_cast<int64_t>(b->size());
+  const int64_t size_c = static_cast<int64_t>(c->size());
+
+  // Room for any two of them
+  FileMetaDataCache cache(size_a + size_b + size_c - 1);
+  ASSERT_EQ(nullptr, cache.Get("a", 100, 1));
+  cache.Put("a", 100, 1, a);
+  cache.Put("b", 200, 1, b);
+  ASSERT_EQ(a, cache.Get("a", 100, 1));
+  ASSERT_EQ(size_a + size_b, cache.size());
+
+  // A rewritten file is another key
+  ASSERT_EQ(nullptr, cache.Get("a", 100, 2));
+  ASSERT_EQ(nullptr, cache.Get("a", 101, 1));
+
+  // b is the least recently used
+  cache.Put("c", 300, 1, c);
+  ASSERT_EQ(2, cache.num_entries());
+  ASSERT_EQ(nullptr, cache.Get("b", 200, 1));
+  ASSERT_EQ(a, cache.Get("a", 100, 1));
+  ASSERT_EQ(c, cache.Get("c", 300, 1));
+  ASSERT_EQ(size_a + size_c, cache.size());
+  ASSERT_EQ(3, cache.hits());
+  ASSERT_EQ(4, cache.misses());
+
+  // Too large to be cached at all
+  FileMetaDataCache small_cache(size_a - 1);
+  small_cache.Put("a", 100, 1, a);
+  ASSERT_EQ(0, small_cache.num_entries());
+
+  cache.Clear();
+  ASSERT_EQ(0, cache.num_entries());
+  ASSERT_EQ(0, cache.size());
+}
+
 TEST(ApplicationVersion, Basics) {
   ApplicationVersion version("parquet-mr version 1.7.9");
   ApplicationVersion version1("parquet-mr version 1.8.0");
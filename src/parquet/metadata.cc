@@ -16,13 +16,20 @@
 // under the License.
 
 #include <algorithm>
+#include <mutex>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
+#include "parquet/bloom_filter.h"
 #include "parquet/exception.h"
+#include "parquet/hyperloglog.h"
 #include "parquet/metadata.h"
+#include "parquet/page_index.h"
 #include "parquet/schema-internal.h"
 #include "parquet/schema.h"
+#include "parquet/sorted_search.h"
 #include "parquet/thrift.h"
 #include "parquet/util/memory.h"
 
@@ -38,6 +45,10 @@ const ApplicationVersion ApplicationVersion::PARQUET_816_FIXED_VERSION =
 const ApplicationVersion ApplicationVersion::PARQUET_CPP_FIXED_STATS_VERSION =
     ApplicationVersion("parquet-cpp version 1.3.0");
 
+// Key of the serialized HyperLogLog sketch in the column chunk's key-value
+// metadata
+static const char kDistinctCountSketchKey[] = "parquet.distinct_count.hll";
+
 template <typename DType>
 static std::shared_ptr<RowGroupStatistics> MakeTypedColumnStats(
     const format::ColumnMetaData& metadata, const ColumnDescriptor* descr) {
@@ -120,6 +131,10 @@ class ColumnChunkMetaData::ColumnChunkMetaDataImpl {
            writer_version_->HasCorrectStatistics(type(), descr_->sort_order());
   }
 
+  inline bool is_null_count_set() const {
+    return is_stats_set() && column_->meta_data.statistics.__isset.null_count;
+  }
+
   inline std::shared_ptr<RowGroupStatistics> statistics() const {
     if (stats_ == nullptr && is_stats_set()) {
       stats_ = MakeColumnStats(column_->meta_data, descr_);
@@ -133,6 +148,8 @@ class ColumnChunkMetaData::ColumnChunkMetaDataImpl {
 
   const std::vector<Encoding::type>& encodings() const { return encodings_; }
 
+  const format::ColumnChunk* column_chunk() const { return column_; }
+
   inline int64_t has_dictionary_page() const {
     return column_->meta_data.__isset.dictionary_page_offset;
   }
@@ -147,6 +164,23 @@ class ColumnChunkMetaData::ColumnChunkMetaDataImpl {
     return column_->meta_data.index_page_offset;
   }
 
+  inline bool has_bloom_filter() const {
+    return column_->meta_data.__isset.bloom_filter_offset;
+  }
+
+  inline int64_t bloom_filter_offset() const {
+    return column_->meta_data.bloom_filter_offset;
+  }
+
+  std::unique_ptr<HyperLogLog> distinct_count_sketch() const {
+    for (const format::KeyValue& kv : column_->meta_data.key_value_metadata) {
+      if (kv.key == kDistinctCountSketchKey && kv.__isset.value) {
+        return HyperLogLog::Deserialize(kv.value);
+      }
+    }
+    return nullptr;
+  }
+
   inline int64_t total_compressed_size() const {
     return column_->meta_data.total_compressed_size;
   }
@@ -155,6 +189,18 @@ class ColumnChunkMetaData::ColumnChunkMetaDataImpl {
     return column_->meta_data.total_uncompressed_size;
   }
 
+  inline bool has_column_index() const { return column_->__isset.column_index_offset; }
+
+  inline int64_t column_index_offset() const { return column_->column_index_offset; }
+
+  inline int32_t column_index_length() const { return column_->column_index_length; }
+
+  inline bool has_offset_index() const { return column_->__isset.offset_index_offset; }
+
+  inline int64_t offset_index_offset() const { return column_->offset_index_offset; }
+
+  inline int32_t offset_index_length() const { return column_->offset_index_length; }
+
  private:
   mutable std::shared_ptr<RowGroupStatistics> stats_;
   std::vector<Encoding::type> encodings_;
@@ -198,6 +244,10 @@ std::shared_ptr<RowGroupStatistics> ColumnChunkMetaData::statistics() const {
 
 bool ColumnChunkMetaData::is_stats_set() const { return impl_->is_stats_set(); }
 
+bool ColumnChunkMetaData::is_null_count_set() const {
+  return impl_->is_null_count_set();
+}
+
 int64_t ColumnChunkMetaData::has_dictionary_page() const {
   return impl_->has_dictionary_page();
 }
@@ -214,6 +264,16 @@ int64_t ColumnChunkMetaData::index_page_offset() const {
   return impl_->index_page_offset();
 }
 
+bool ColumnChunkMetaData::has_bloom_filter() const { return impl_->has_bloom_filter(); }
+
+int64_t ColumnChunkMetaData::bloom_filter_offset() const {
+  return impl_->bloom_filter_offset();
+}
+
+std::unique_ptr<HyperLogLog> ColumnChunkMetaData::distinct_count_sketch() const {
+  return impl_->distinct_count_sketch();
+}
+
 Compression::type ColumnChunkMetaData::compression() const {
   return impl_->compression();
 }
@@ -230,16 +290,49 @@ int64_t ColumnChunkMetaData::total_compressed_size() const {
   return impl_->total_compressed_size();
 }
 
+bool ColumnChunkMetaData::has_column_index() const { return impl_->has_column_index(); }
+
+int64_t ColumnChunkMetaData::column_index_offset() const {
+  return impl_->column_index_offset();
+}
+
+int32_t ColumnChunkMetaData::column_index_length() const {
+  return impl_->column_index_length();
+}
+
+bool ColumnChunkMetaData::has_offset_index() const { return impl_->has_offset_index(); }
+
+int64_t ColumnChunkMetaData::offset_index_offset() const {
+  return impl_->offset_index_offset();
+}
+
+int32_t ColumnChunkMetaData::offset_index_length() const {
+  return impl_->offset_index_length();
+}
+
 // row-group metadata
 class RowGroupMetaData::RowGroupMetaDataImpl {
  public:
   explicit RowGroupMetaDataImpl(const format::RowGroup* row_group,
                                 const SchemaDescriptor* schema,
                                 const ApplicationVersion* writer_version)
-      : row_group_(row_group), schema_(schema), writer_version_(writer_version) {}
+      : row_group_(row_group),
+        schema_(schema),
+        writer_version_(writer_version),
+        num_columns_(static_cast<int>(row_group->columns.size())) {}
+
+  RowGroupMetaDataImpl(const format::RowGroup* row_group, const SchemaDescriptor* schema,
+                       const ApplicationVersion* writer_version, int num_columns,
+                       RowGroupMetaData::ColumnChunkResolver column_chunk)
+      : row_group_(row_group),
+        schema_(schema),
+        writer_version_(writer_version),
+        num_columns_(num_columns),
+        column_chunk_(std::move(column_chunk)) {}
+
   ~RowGroupMetaDataImpl() {}
 
-  inline int num_columns() const { return static_cast<int>(row_group_->columns.size()); }
+  inline int num_columns() const { return num_columns_; }
 
   inline int64_t num_rows() const { return row_group_->num_rows; }
 
@@ -254,15 +347,28 @@ class RowGroupMetaData::RowGroupMetaDataImpl {
          << " columns, requested metadata for column: " << i;
       throw ParquetException(ss.str());
     }
-    return ColumnChunkMetaData::Make(
-        reinterpret_cast<const uint8_t*>(&row_group_->columns[i]), schema_->Column(i),
-        writer_version_);
+    const uint8_t* column_chunk =
+        column_chunk_ ? column_chunk_(i)
+                      : reinterpret_cast<const uint8_t*>(&row_group_->columns[i]);
+    return ColumnChunkMetaData::Make(column_chunk, schema_->Column(i), writer_version_);
+  }
+
+  std::vector<SortingColumn> sorting_columns() const {
+    std::vector<SortingColumn> sorting_columns;
+    for (const format::SortingColumn& column : row_group_->sorting_columns) {
+      sorting_columns.push_back(
+          {column.column_idx, column.descending, column.nulls_first});
+    }
+    return sorting_columns;
   }
 
  private:
   const format::RowGroup* row_group_;
   const SchemaDescriptor* schema_;
   const ApplicationVersion* writer_version_;
+  int num_columns_;
+  // Only set if the column chunks are decoded on first access
+  RowGroupMetaData::ColumnChunkResolver column_chunk_;
 };
 
 std::unique_ptr<RowGroupMetaData> RowGroupMetaData::Make(
@@ -278,6 +384,15 @@ RowGroupMetaData::RowGroupMetaData(const uint8_t* metadata,
     : impl_{std::unique_ptr<RowGroupMetaDataImpl>(new RowGroupMetaDataImpl(
           reinterpret_cast<const format::RowGroup*>(metadata), schema, writer_version))} {
 }
+
+RowGroupMetaData::RowGroupMetaData(const uint8_t* metadata,
+                                   const SchemaDescriptor* schema,
+                                   const ApplicationVersion* writer_version,
+                                   int num_columns, ColumnChunkResolver column_chunk)
+    : impl_{std::unique_ptr<RowGroupMetaDataImpl>(new RowGroupMetaDataImpl(
+          reinterpret_cast<const format::RowGroup*>(metadata), schema, writer_version,
+          num_columns, std::move(column_chunk)))} {}
+
 RowGroupMetaData::~RowGroupMetaData() {}
 
 int RowGroupMetaData::num_columns() const { return impl_->num_columns(); }
@@ -292,15 +407,23 @@ std::unique_ptr<ColumnChunkMetaData> RowGroupMetaData::ColumnChunk(int i) const
   return impl_->ColumnChunk(i);
 }
 
+std::vector<SortingColumn> RowGroupMetaData::sorting_columns() const {
+  return impl_->sorting_columns();
+}
+
 // file metadata
 class FileMetaData::FileMetaDataImpl {
  public:
   FileMetaDataImpl() : metadata_len_(0) {}
 
-  explicit FileMetaDataImpl(const uint8_t* metadata, uint32_t* metadata_len)
+  explicit FileMetaDataImpl(const uint8_t* metadata, uint32_t* metadata_len, bool lazy)
       : metadata_len_(0) {
     metadata_.reset(new format::FileMetaData);
-    DeserializeThriftMsg(metadata, metadata_len, metadata_.get());
+    if (lazy) {
+      DeserializeLazy(metadata, metadata_len);
+    } else {
+      DeserializeThriftMsg(metadata, metadata_len, metadata_.get());
+    }
     metadata_len_ = *metadata_len;
 
     if (metadata_->__isset.created_by) {
@@ -329,7 +452,26 @@ class FileMetaData::FileMetaDataImpl {
 
   const ApplicationVersion& writer_version() const { return writer_version_; }
 
-  void WriteTo(OutputStream* dst) { SerializeThriftMsg(metadata_.get(), 1024, dst); }
+  void WriteTo(OutputStream* dst) const {
+    if (lazy_row_groups_.empty()) {
+      SerializeThriftMsg(metadata_.get(), 1024, dst);
+    } else {
+      // The row groups are not fully decoded, write the original footer
+      dst->Write(reinterpret_cast<const uint8_t*>(serialized_metadata_.data()),
+                 metadata_len_);
+    }
+  }
+
+  // Copy of the metadata with all row groups decoded
+  void CopyTo(format::FileMetaData* out) const {
+    if (lazy_row_groups_.empty()) {
+      *out = *metadata_;
+    } else {
+      uint32_t len = metadata_len_;
+      DeserializeThriftMsg(reinterpret_cast<const uint8_t*>(serialized_metadata_.data()),
+                           &len, out);
+    }
+  }
 
   std::unique_ptr<RowGroupMetaData> RowGroup(int i) {
     if (!(i < num_row_groups())) {
@@ -338,9 +480,14 @@ class FileMetaData::FileMetaDataImpl {
          << " row groups, requested metadata for row group: " << i;
       throw ParquetException(ss.str());
     }
-    return RowGroupMetaData::Make(
-        reinterpret_cast<const uint8_t*>(&metadata_->row_groups[i]), &schema_,
-        &writer_version_);
+    const uint8_t* row_group =
+        reinterpret_cast<const uint8_t*>(&metadata_->row_groups[i]);
+    if (lazy_row_groups_.empty()) {
+      return RowGroupMetaData::Make(row_group, &schema_, &writer_version_);
+    }
+    return std::unique_ptr<RowGroupMetaData>(new RowGroupMetaData(
+        row_group, &schema_, &writer_version_, lazy_row_groups_[i].num_columns,
+        [this, i](int column) { return LazyColumnChunk(i, column); }));
   }
 
   const SchemaDescriptor* schema() const { return &schema_; }
@@ -390,17 +537,139 @@ class FileMetaData::FileMetaDataImpl {
   }
 
   std::shared_ptr<const KeyValueMetadata> key_value_metadata_;
+
+  // Field ids of FileMetaData.row_groups and RowGroup.columns in parquet.thrift
+  static constexpr int16_t kRowGroupsFieldId = 4;
+  static constexpr int16_t kColumnsFieldId = 1;
+
+  // Column chunks of a row group that are decoded on first access
+  struct LazyRowGroup {
+    // Range of RowGroup.columns in serialized_metadata_
+    ThriftByteRange columns;
+    int num_columns;
+    // Ranges of the column chunks relative to columns.begin, found on the
+    // first access to a column chunk
+    std::vector<ThriftByteRange> column_chunks;
+    std::unordered_map<int, std::unique_ptr<format::ColumnChunk>> decoded;
+  };
+
+  // Copy of the footer that the lazily decoded column chunks are read from
+  std::string serialized_metadata_;
+  std::vector<LazyRowGroup> lazy_row_groups_;
+  // Guards lazy_row_groups_, row groups can be read from several threads
+  std::mutex lazy_mutex_;
+
+  // Decode everything but the column chunks, which are only located
+  void DeserializeLazy(const uint8_t* metadata, uint32_t* metadata_len) {
+    serialized_metadata_.assign(reinterpret_cast<const char*>(metadata), *metadata_len);
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(serialized_metadata_.data());
+
+    ThriftByteRange row_groups_list;
+    std::vector<ThriftByteRange> row_groups;
+    FindThriftListField(data, *metadata_len, kRowGroupsFieldId, &row_groups_list,
+                        &row_groups);
+    const std::string file_metadata =
+        WithoutThriftListElements(data, *metadata_len, row_groups_list);
+    uint32_t file_metadata_len = static_cast<uint32_t>(file_metadata.size());
+    DeserializeThriftMsg(reinterpret_cast<const uint8_t*>(file_metadata.data()),
+                         &file_metadata_len, metadata_.get());
+    // Length of the footer including the elements that were left out
+    *metadata_len =
+        file_metadata_len + (row_groups_list.end - row_groups_list.begin - 1);
+
+    metadata_->row_groups.resize(row_groups.size());
+    lazy_row_groups_.resize(row_groups.size());
+    for (size_t i = 0; i < row_groups.size(); ++i) {
+      const uint8_t* row_group_data = data + row_groups[i].begin;
+      const uint32_t row_group_len = row_groups[i].end - row_groups[i].begin;
+      LazyRowGroup& lazy_row_group = lazy_row_groups_[i];
+      lazy_row_group.num_columns = static_cast<int>(FindThriftListField(
+          row_group_data, row_group_len, kColumnsFieldId, &lazy_row_group.columns,
+          nullptr));
+      const std::string row_group = WithoutThriftListElements(
+          row_group_data, row_group_len, lazy_row_group.columns);
+      uint32_t len = static_cast<uint32_t>(row_group.size());
+      DeserializeThriftMsg(reinterpret_cast<const uint8_t*>(row_group.data()), &len,
+                           &metadata_->row_groups[i]);
+      lazy_row_group.columns.begin += row_groups[i].begin;
+      lazy_row_group.columns.end += row_groups[i].begin;
+    }
+  }
+
+  const uint8_t* LazyColumnChunk(int row_group, int column) {
+    std::lock_guard<std::mutex> lock(lazy_mutex_);
+    LazyRowGroup& lazy_row_group = lazy_row_groups_[row_group];
+    auto it = lazy_row_group.decoded.find(column);
+    if (it == lazy_row_group.decoded.end()) {
+      const uint8_t* columns_data =
+          reinterpret_cast<const uint8_t*>(serialized_metadata_.data()) +
+          lazy_row_group.columns.begin;
+      if (lazy_row_group.column_chunks.empty()) {
+        FindThriftListElements(
+            columns_data, lazy_row_group.columns.end - lazy_row_group.columns.begin,
+            &lazy_row_group.column_chunks);
+      }
+      const ThriftByteRange& range = lazy_row_group.column_chunks[column];
+      std::unique_ptr<format::ColumnChunk> column_chunk(new format::ColumnChunk);
+      uint32_t len = range.end - range.begin;
+      DeserializeThriftMsg(columns_data + range.begin, &len, column_chunk.get());
+      it = lazy_row_group.decoded.emplace(column, std::move(column_chunk)).first;
+    }
+    return reinterpret_cast<const uint8_t*>(it->second.get());
+  }
 };
 
+constexpr int16_t FileMetaData::FileMetaDataImpl::kRowGroupsFieldId;
+constexpr int16_t FileMetaData::FileMetaDataImpl::kColumnsFieldId;
+
 std::shared_ptr<FileMetaData> FileMetaData::Make(const uint8_t* metadata,
-                                                 uint32_t* metadata_len) {
+                                                 uint32_t* metadata_len, bool lazy) {
   // This FileMetaData ctor is private, not compatible with std::make_shared
-  return std::shared_ptr<FileMetaData>(new FileMetaData(metadata, metadata_len));
+  return std::shared_ptr<FileMetaData>(new FileMetaData(metadata, metadata_len, lazy));
+}
+
+std::shared_ptr<FileMetaData> FileMetaData::Combine(
+    const std::vector<std::shared_ptr<FileMetaData>>& files,
+    const std::vector<std::string>& paths) {
+  if (files.empty()) {
+    throw ParquetException("Cannot combine the metadata of zero files");
+  }
+  if (files.size() != paths.size()) {
+    throw ParquetException("Expected a path for the metadata of each file");
+  }
+  format::FileMetaData combined;
+  files[0]->impl_->CopyTo(&combined);
+  combined.row_groups.clear();
+  combined.num_rows = 0;
+  for (size_t i = 0; i < files.size(); ++i) {
+    if (!files[i]->schema()->Equals(*files[0]->schema())) {
+      std::stringstream ss;
+      ss << "The schema of " << paths[i] << " differs from the schema of " << paths[0];
+      throw ParquetException(ss.str());
+    }
+    format::FileMetaData metadata;
+    files[i]->impl_->CopyTo(&metadata);
+    for (format::RowGroup& row_group : metadata.row_groups) {
+      for (format::ColumnChunk& column_chunk : row_group.columns) {
+        column_chunk.__set_file_path(paths[i]);
+      }
+      combined.row_groups.push_back(std::move(row_group));
+    }
+    combined.num_rows += metadata.num_rows;
+  }
+
+  // Go through the serialized form so that the accessors are initialized the
+  // same way as for a footer that was read from a file
+  InMemoryOutputStream serialized;
+  SerializeThriftMsg(&combined, 1024, &serialized);
+  std::shared_ptr<Buffer> buffer = serialized.GetBuffer();
+  uint32_t len = static_cast<uint32_t>(buffer->size());
+  return Make(buffer->data(), &len);
 }
 
-FileMetaData::FileMetaData(const uint8_t* metadata, uint32_t* metadata_len)
+FileMetaData::FileMetaData(const uint8_t* metadata, uint32_t* metadata_len, bool lazy)
     : impl_{std::unique_ptr<FileMetaDataImpl>(
-          new FileMetaDataImpl(metadata, metadata_len))} {}
+          new FileMetaDataImpl(metadata, metadata_len, lazy))} {}
 
 FileMetaData::FileMetaData()
     : impl_{std::unique_ptr<FileMetaDataImpl>(new FileMetaDataImpl())} {}
@@ -446,7 +715,7 @@ std::shared_ptr<const KeyValueMetadata> FileMetaData::key_value_metadata() const
   return impl_->key_value_metadata();
 }
 
-void FileMetaData::WriteTo(OutputStream* dst) { return impl_->WriteTo(dst); }
+void FileMetaData::WriteTo(OutputStream* dst) const { return impl_->WriteTo(dst); }
 
 ApplicationVersion::ApplicationVersion(const std::string& created_by) {
   boost::regex app_regex{ApplicationVersion::APPLICATION_FORMAT};
@@ -553,7 +822,7 @@ class ColumnChunkMetaDataBuilder::ColumnChunkMetaDataBuilderImpl {
     column_chunk_->meta_data.__set_type(ToThrift(column->physical_type()));
     column_chunk_->meta_data.__set_path_in_schema(column->path()->ToDotVector());
     column_chunk_->meta_data.__set_codec(
-        ToThrift(properties_->compression(column->path())));
+        ToThrift(properties_->column_properties(column).codec));
   }
   ~ColumnChunkMetaDataBuilderImpl() {}
 
@@ -599,6 +868,10 @@ class ColumnChunkMetaDataBuilder::ColumnChunkMetaDataBuilderImpl {
     column_chunk_->meta_data.__set_data_page_offset(data_page_offset);
     column_chunk_->meta_data.__set_total_uncompressed_size(uncompressed_size);
     column_chunk_->meta_data.__set_total_compressed_size(compressed_size);
+    if (!encodings_.empty()) {
+      column_chunk_->meta_data.__set_encodings(encodings_);
+      return;
+    }
     std::vector<format::Encoding::type> thrift_encodings;
     if (has_dictionary) {
       thrift_encodings.push_back(ToThrift(properties_->dictionary_index_encoding()));
@@ -608,7 +881,8 @@ class ColumnChunkMetaDataBuilder::ColumnChunkMetaDataBuilderImpl {
         thrift_encodings.push_back(ToThrift(properties_->dictionary_page_encoding()));
       }
     } else {  // Dictionary not enabled
-      thrift_encodings.push_back(ToThrift(properties_->encoding(column_->path())));
+      thrift_encodings.push_back(
+          ToThrift(properties_->column_properties(column_).encoding));
     }
     thrift_encodings.push_back(ToThrift(Encoding::RLE));
     // Only PLAIN encoding is supported for fallback in V1
@@ -619,16 +893,111 @@ class ColumnChunkMetaDataBuilder::ColumnChunkMetaDataBuilderImpl {
     column_chunk_->meta_data.__set_encodings(thrift_encodings);
   }
 
+  void SetEncodings(const std::vector<Encoding::type>& encodings) {
+    encodings_.clear();
+    for (Encoding::type encoding : encodings) {
+      encodings_.push_back(ToThrift(encoding));
+    }
+  }
+
+  void CopyFrom(const format::ColumnChunk& source, int64_t offset,
+                bool copy_statistics) {
+    int64_t start = source.meta_data.data_page_offset;
+    if (source.meta_data.__isset.dictionary_page_offset) {
+      start = std::min(start, source.meta_data.dictionary_page_offset);
+    }
+    const int64_t delta = offset - start;
+
+    *column_chunk_ = source;
+    format::ColumnMetaData* meta_data = &column_chunk_->meta_data;
+    column_chunk_->file_path.clear();
+    column_chunk_->__isset.file_path = false;
+    column_chunk_->__set_file_offset(source.file_offset + delta);
+    meta_data->__set_data_page_offset(meta_data->data_page_offset + delta);
+    if (meta_data->__isset.dictionary_page_offset) {
+      meta_data->__set_dictionary_page_offset(meta_data->dictionary_page_offset + delta);
+    }
+    if (meta_data->__isset.index_page_offset && meta_data->index_page_offset > 0) {
+      meta_data->__set_index_page_offset(meta_data->index_page_offset + delta);
+    }
+    // The file is written with the version of this writer, which readers
+    // trust, so statistics the source's writer got wrong are dropped
+    if (!copy_statistics) {
+      meta_data->statistics = format::Statistics();
+      meta_data->__isset.statistics = false;
+    }
+    // Only the pages are copied
+    meta_data->__isset.bloom_filter_offset = false;
+    column_chunk_->__isset.column_index_offset = false;
+    column_chunk_->__isset.column_index_length = false;
+    column_chunk_->__isset.offset_index_offset = false;
+    column_chunk_->__isset.offset_index_length = false;
+  }
+
   void WriteTo(OutputStream* sink) {
     SerializeThriftMsg(column_chunk_, sizeof(format::ColumnChunk), sink);
   }
 
+  PageIndexBuilder* page_index() { return &page_index_; }
+
+  void SetBloomFilter(std::unique_ptr<BloomFilter> bloom_filter) {
+    bloom_filter_ = std::move(bloom_filter);
+  }
+
+  void WriteBloomFilter(OutputStream* sink) {
+    if (bloom_filter_) {
+      column_chunk_->meta_data.__set_bloom_filter_offset(sink->Tell());
+      bloom_filter_->WriteTo(sink);
+      // Only the offset is kept until the file is closed
+      bloom_filter_.reset();
+    }
+  }
+
+  void SetDistinctCountSketch(const HyperLogLog& sketch) {
+    std::vector<format::KeyValue>& key_value_metadata =
+        column_chunk_->meta_data.key_value_metadata;
+    format::KeyValue kv_pair;
+    kv_pair.__set_key(kDistinctCountSketchKey);
+    kv_pair.__set_value(sketch.Serialize());
+    auto it = std::find_if(
+        key_value_metadata.begin(), key_value_metadata.end(),
+        [](const format::KeyValue& kv) { return kv.key == kDistinctCountSketchKey; });
+    if (it != key_value_metadata.end()) {
+      *it = kv_pair;
+    } else {
+      key_value_metadata.push_back(kv_pair);
+    }
+    column_chunk_->meta_data.__isset.key_value_metadata = true;
+  }
+
+  void WriteColumnIndex(OutputStream* sink) {
+    if (page_index_.has_column_index()) {
+      int64_t offset = sink->Tell();
+      int64_t length = page_index_.WriteColumnIndex(sink);
+      column_chunk_->__set_column_index_offset(offset);
+      column_chunk_->__set_column_index_length(static_cast<int32_t>(length));
+    }
+  }
+
+  void WriteOffsetIndex(OutputStream* sink) {
+    if (page_index_.has_offset_index()) {
+      int64_t offset = sink->Tell();
+      int64_t length = page_index_.WriteOffsetIndex(sink);
+      column_chunk_->__set_offset_index_offset(offset);
+      column_chunk_->__set_offset_index_length(static_cast<int32_t>(length));
+    }
+  }
+
   const ColumnDescriptor* descr() const { return column_; }
 
  private:
   format::ColumnChunk* column_chunk_;
   const std::shared_ptr<WriterProperties> properties_;
   const ColumnDescriptor* column_;
+  PageIndexBuilder page_index_;
+  std::unique_ptr<BloomFilter> bloom_filter_;
+  // Set by SetEncodings
+  std::vector<format::Encoding::type> encodings_;
 };
 
 std::unique_ptr<ColumnChunkMetaDataBuilder> ColumnChunkMetaDataBuilder::Make(
@@ -660,8 +1029,41 @@ void ColumnChunkMetaDataBuilder::Finish(int64_t num_values,
                 compressed_size, uncompressed_size, has_dictionary, dictionary_fallback);
 }
 
+void ColumnChunkMetaDataBuilder::SetEncodings(
+    const std::vector<Encoding::type>& encodings) {
+  impl_->SetEncodings(encodings);
+}
+
+void ColumnChunkMetaDataBuilder::CopyFrom(const ColumnChunkMetaData& source,
+                                          int64_t offset) {
+  impl_->CopyFrom(*source.impl_->column_chunk(), offset, source.is_stats_set());
+}
+
 void ColumnChunkMetaDataBuilder::WriteTo(OutputStream* sink) { impl_->WriteTo(sink); }
 
+PageIndexBuilder* ColumnChunkMetaDataBuilder::page_index() { return impl_->page_index(); }
+
+void ColumnChunkMetaDataBuilder::SetBloomFilter(
+    std::unique_ptr<BloomFilter> bloom_filter) {
+  impl_->SetBloomFilter(std::move(bloom_filter));
+}
+
+void ColumnChunkMetaDataBuilder::WriteBloomFilter(OutputStream* sink) {
+  impl_->WriteBloomFilter(sink);
+}
+
+void ColumnChunkMetaDataBuilder::SetDistinctCountSketch(const HyperLogLog& sketch) {
+  impl_->SetDistinctCountSketch(sketch);
+}
+
+void ColumnChunkMetaDataBuilder::WriteColumnIndex(OutputStream* sink) {
+  impl_->WriteColumnIndex(sink);
+}
+
+void ColumnChunkMetaDataBuilder::WriteOffsetIndex(OutputStream* sink) {
+  impl_->WriteOffsetIndex(sink);
+}
+
 const ColumnDescriptor* ColumnChunkMetaDataBuilder::descr() const {
   return impl_->descr();
 }
@@ -673,9 +1075,14 @@ void ColumnChunkMetaDataBuilder::SetStatistics(bool is_signed,
 
 class RowGroupMetaDataBuilder::RowGroupMetaDataBuilderImpl {
  public:
-  explicit RowGroupMetaDataBuilderImpl(const std::shared_ptr<WriterProperties>& props,
-                                       const SchemaDescriptor* schema, uint8_t* contents)
-      : properties_(props), schema_(schema), current_column_(0) {
+  RowGroupMetaDataBuilderImpl(const std::shared_ptr<WriterProperties>& props,
+                              const SchemaDescriptor* schema, uint8_t* contents,
+                              const uint8_t* previous)
+      : properties_(props),
+        schema_(schema),
+        previous_(reinterpret_cast<const format::RowGroup*>(previous)),
+        sorting_columns_(props->sorting_columns()),
+        current_column_(0) {
     row_group_ = reinterpret_cast<format::RowGroup*>(contents);
     InitializeColumns(schema->num_columns());
   }
@@ -720,10 +1127,47 @@ class RowGroupMetaDataBuilder::RowGroupMetaDataBuilderImpl {
         << "Total bytes in this RowGroup does not match with compressed sizes of columns";
 
     row_group_->__set_total_byte_size(total_byte_size);
+
+    if (sorting_columns_.empty()) {
+      return;
+    }
+    std::vector<format::SortingColumn> sorting_columns;
+    for (const SortingColumn& column : sorting_columns_) {
+      if (column.column_idx < 0 || column.column_idx >= schema_->num_columns()) {
+        std::stringstream ss;
+        ss << "Sorting column " << column.column_idx << " is not in the schema";
+        throw ParquetException(ss.str());
+      }
+      format::SortingColumn sorting_column;
+      sorting_column.__set_column_idx(column.column_idx);
+      sorting_column.__set_descending(column.descending);
+      sorting_column.__set_nulls_first(column.nulls_first);
+      sorting_columns.push_back(sorting_column);
+    }
+    row_group_->__set_sorting_columns(sorting_columns);
+    if (properties_->sorting_validation_enabled()) {
+      ValidateSortOrder(sorting_columns_[0]);
+    }
+  }
+
+  void WriteColumnIndex(OutputStream* sink) {
+    for (auto& column_builder : column_builders_) {
+      column_builder->WriteColumnIndex(sink);
+    }
+  }
+
+  void WriteOffsetIndex(OutputStream* sink) {
+    for (auto& column_builder : column_builders_) {
+      column_builder->WriteOffsetIndex(sink);
+    }
   }
 
   void set_num_rows(int64_t num_rows) { row_group_->num_rows = num_rows; }
 
+  void set_sorting_columns(const std::vector<SortingColumn>& sorting_columns) {
+    sorting_columns_ = sorting_columns;
+  }
+
   int num_columns() { return static_cast<int>(row_group_->columns.size()); }
 
   int64_t num_rows() { return row_group_->num_rows; }
@@ -731,25 +1175,100 @@ class RowGroupMetaDataBuilder::RowGroupMetaDataBuilderImpl {
  private:
   void InitializeColumns(int ncols) { row_group_->columns.resize(ncols); }
 
+  struct ValueBounds {
+    bool null_only;
+    std::string min;
+    std::string max;
+  };
+
+  // Check that the pages of the column chunk and this row group follow the
+  // previous ones in the order of the column, by their statistics
+  void ValidateSortOrder(const SortingColumn& sorting_column) {
+    const int i = sorting_column.column_idx;
+    const ColumnDescriptor* descr = schema_->Column(i);
+    if (descr->sort_order() == SortOrder::UNKNOWN) {
+      return;
+    }
+
+    if (i < static_cast<int>(column_builders_.size()) &&
+        column_builders_[i]->page_index()->has_column_index()) {
+      PageIndexBuilder* page_index = column_builders_[i]->page_index();
+      const std::vector<bool>& null_pages = page_index->null_pages();
+      const std::vector<std::string>& min_values = page_index->encoded_min_values();
+      const std::vector<std::string>& max_values = page_index->encoded_max_values();
+      for (size_t page = 1; page < null_pages.size(); ++page) {
+        ValueBounds prev = {null_pages[page - 1], min_values[page - 1],
+                            max_values[page - 1]};
+        ValueBounds next = {null_pages[page], min_values[page], max_values[page]};
+        if (!InSortOrder(descr, sorting_column, prev, next)) {
+          std::stringstream ss;
+          ss << "Page " << page << " of sorting column " << i << " is out of order";
+          throw ParquetException(ss.str());
+        }
+      }
+      page_index->set_boundary_order(sorting_column.descending
+                                         ? BoundaryOrder::DESCENDING
+                                         : BoundaryOrder::ASCENDING);
+    }
+
+    ValueBounds prev;
+    ValueBounds next;
+    if (previous_ != nullptr && GetBounds(previous_->columns[i], &prev) &&
+        GetBounds(row_group_->columns[i], &next) &&
+        !InSortOrder(descr, sorting_column, prev, next)) {
+      std::stringstream ss;
+      ss << "The row group is out of order of sorting column " << i;
+      throw ParquetException(ss.str());
+    }
+  }
+
+  // Returns false if the column chunk has no statistics
+  static bool GetBounds(const format::ColumnChunk& column_chunk, ValueBounds* bounds) {
+    const format::ColumnMetaData& meta_data = column_chunk.meta_data;
+    const format::Statistics& stats = meta_data.statistics;
+    if (!meta_data.__isset.statistics) {
+      return false;
+    }
+    bounds->null_only = stats.__isset.null_count && stats.null_count > 0 &&
+                        stats.null_count == meta_data.num_values;
+    bounds->min = stats.min_value;
+    bounds->max = stats.max_value;
+    return bounds->null_only || (stats.__isset.min_value && stats.__isset.max_value);
+  }
+
+  // Whether the values of b can follow those of a
+  static bool InSortOrder(const ColumnDescriptor* descr,
+                          const SortingColumn& sorting_column, const ValueBounds& a,
+                          const ValueBounds& b) {
+    if (a.null_only || b.null_only) {
+      return sorting_column.nulls_first ? a.null_only : b.null_only;
+    }
+    return sorting_column.descending
+               ? internal::EncodedValuesInOrder(descr, b.max, a.min)
+               : internal::EncodedValuesInOrder(descr, a.max, b.min);
+  }
+
   format::RowGroup* row_group_;
   const std::shared_ptr<WriterProperties> properties_;
   const SchemaDescriptor* schema_;
+  const format::RowGroup* previous_;
+  std::vector<SortingColumn> sorting_columns_;
   std::vector<std::unique_ptr<ColumnChunkMetaDataBuilder>> column_builders_;
   int current_column_;
 };
 
 std::unique_ptr<RowGroupMetaDataBuilder> RowGroupMetaDataBuilder::Make(
     const std::shared_ptr<WriterProperties>& props, const SchemaDescriptor* schema_,
-    uint8_t* contents) {
+    uint8_t* contents, const uint8_t* previous) {
   return std::unique_ptr<RowGroupMetaDataBuilder>(
-      new RowGroupMetaDataBuilder(props, schema_, contents));
+      new RowGroupMetaDataBuilder(props, schema_, contents, previous));
 }
 
 RowGroupMetaDataBuilder::RowGroupMetaDataBuilder(
     const std::shared_ptr<WriterProperties>& props, const SchemaDescriptor* schema_,
-    uint8_t* contents)
+    uint8_t* contents, const uint8_t* previous)
     : impl_{std::unique_ptr<RowGroupMetaDataBuilderImpl>(
-          new RowGroupMetaDataBuilderImpl(props, schema_, contents))} {}
+          new RowGroupMetaDataBuilderImpl(props, schema_, contents, previous))} {}
 
 RowGroupMetaDataBuilder::~RowGroupMetaDataBuilder() {}
 
@@ -767,10 +1286,23 @@ void RowGroupMetaDataBuilder::set_num_rows(int64_t num_rows) {
   impl_->set_num_rows(num_rows);
 }
 
+void RowGroupMetaDataBuilder::set_sorting_columns(
+    const std::vector<SortingColumn>& sorting_columns) {
+  impl_->set_sorting_columns(sorting_columns);
+}
+
 void RowGroupMetaDataBuilder::Finish(int64_t total_bytes_written) {
   impl_->Finish(total_bytes_written);
 }
 
+void RowGroupMetaDataBuilder::WriteColumnIndex(OutputStream* sink) {
+  impl_->WriteColumnIndex(sink);
+}
+
+void RowGroupMetaDataBuilder::WriteOffsetIndex(OutputStream* sink) {
+  impl_->WriteOffsetIndex(sink);
+}
+
 // file metadata
 // TODO(PARQUET-595) Support key_value_metadata
 class FileMetaDataBuilder::FileMetaDataBuilderImpl {
@@ -785,14 +1317,26 @@ class FileMetaDataBuilder::FileMetaDataBuilderImpl {
 
   RowGroupMetaDataBuilder* AppendRowGroup() {
     auto row_group = std::unique_ptr<format::RowGroup>(new format::RowGroup());
+    const uint8_t* previous =
+        row_groups_.empty() ? nullptr
+                            : reinterpret_cast<const uint8_t*>(row_groups_.back().get());
     auto row_group_builder = RowGroupMetaDataBuilder::Make(
-        properties_, schema_, reinterpret_cast<uint8_t*>(row_group.get()));
+        properties_, schema_, reinterpret_cast<uint8_t*>(row_group.get()), previous);
     RowGroupMetaDataBuilder* row_group_ptr = row_group_builder.get();
     row_group_builders_.push_back(std::move(row_group_builder));
     row_groups_.push_back(std::move(row_group));
     return row_group_ptr;
   }
 
+  void WritePageIndex(OutputStream* sink) {
+    for (auto& row_group_builder : row_group_builders_) {
+      row_group_builder->WriteColumnIndex(sink);
+    }
+    for (auto& row_group_builder : row_group_builders_) {
+      row_group_builder->WriteOffsetIndex(sink);
+    }
+  }
+
   std::unique_ptr<FileMetaData> Finish() {
     int64_t total_rows = 0;
     std::vector<format::RowGroup> row_groups;
@@ -883,6 +1427,10 @@ RowGroupMetaDataBuilder* FileMetaDataBuilder::AppendRowGroup() {
   return impl_->AppendRowGroup();
 }
 
+void FileMetaDataBuilder::WritePageIndex(OutputStream* sink) {
+  impl_->WritePageIndex(sink);
+}
+
 std::unique_ptr<FileMetaData> FileMetaDataBuilder::Finish() { return impl_->Finish(); }
 
 }  // namespace parquet
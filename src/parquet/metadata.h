@@ -18,6 +18,8 @@
 #ifndef PARQUET_FILE_METADATA_H
 #define PARQUET_FILE_METADATA_H
 
+#include <functional>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -35,6 +37,10 @@ namespace parquet {
 
 using KeyValueMetadata = ::arrow::KeyValueMetadata;
 
+class BloomFilter;
+class HyperLogLog;
+class PageIndexBuilder;
+
 class ApplicationVersion {
  public:
   // Known Versions with Issues
@@ -104,6 +110,8 @@ class PARQUET_EXPORT ColumnChunkMetaData {
   int64_t num_values() const;
   std::shared_ptr<schema::ColumnPath> path_in_schema() const;
   bool is_stats_set() const;
+  // Whether the statistics hold the null count, files of some writers lack it
+  bool is_null_count_set() const;
   std::shared_ptr<RowGroupStatistics> statistics() const;
   Compression::type compression() const;
   const std::vector<Encoding::type>& encodings() const;
@@ -111,10 +119,24 @@ class PARQUET_EXPORT ColumnChunkMetaData {
   int64_t dictionary_page_offset() const;
   int64_t data_page_offset() const;
   int64_t index_page_offset() const;
+  bool has_bloom_filter() const;
+  int64_t bloom_filter_offset() const;
+  // Sketch of the distinct values, nullptr unless the writer estimated the
+  // distinct count, see WriterProperties::Builder::enable_distinct_count.
+  // The sketches of a column can be merged across row groups and files.
+  std::unique_ptr<HyperLogLog> distinct_count_sketch() const;
   int64_t total_compressed_size() const;
   int64_t total_uncompressed_size() const;
+  // page index, written after the row groups
+  bool has_column_index() const;
+  int64_t column_index_offset() const;
+  int32_t column_index_length() const;
+  bool has_offset_index() const;
+  int64_t offset_index_offset() const;
+  int32_t offset_index_length() const;
 
  private:
+  friend class ColumnChunkMetaDataBuilder;
   explicit ColumnChunkMetaData(const uint8_t* metadata, const ColumnDescriptor* descr,
                                const ApplicationVersion* writer_version = nullptr);
   // PIMPL Idiom
@@ -138,10 +160,20 @@ class PARQUET_EXPORT RowGroupMetaData {
   // Return const-pointer to make it clear that this object is not to be copied
   const SchemaDescriptor* schema() const;
   std::unique_ptr<ColumnChunkMetaData> ColumnChunk(int i) const;
+  // The columns the rows are sorted by, empty if the writer did not record any
+  std::vector<SortingColumn> sorting_columns() const;
 
  private:
+  friend class FileMetaData;
+  // Returns the metadata of column chunk i, for row groups whose column chunks
+  // are decoded on first access
+  typedef std::function<const uint8_t*(int)> ColumnChunkResolver;
+
   explicit RowGroupMetaData(const uint8_t* metadata, const SchemaDescriptor* schema,
                             const ApplicationVersion* writer_version = nullptr);
+  RowGroupMetaData(const uint8_t* metadata, const SchemaDescriptor* schema,
+                   const ApplicationVersion* writer_version, int num_columns,
+                   ColumnChunkResolver column_chunk);
   // PIMPL Idiom
   class RowGroupMetaDataImpl;
   std::unique_ptr<RowGroupMetaDataImpl> impl_;
@@ -152,8 +184,22 @@ class FileMetaDataBuilder;
 class PARQUET_EXPORT FileMetaData {
  public:
   // API convenience to get a MetaData accessor
+  //
+  // If lazy is true only the schema, the key-value metadata and the row group
+  // headers are decoded here. The column chunk metadata of a row group is
+  // decoded when it is first accessed, for the accessed columns only
   static std::shared_ptr<FileMetaData> Make(const uint8_t* serialized_metadata,
-                                            uint32_t* metadata_len);
+                                            uint32_t* metadata_len, bool lazy = false);
+
+  // Combine the metadata of files with the same schema into the metadata of a
+  // summary file such as _metadata. Its row groups are the row groups of all
+  // files, in order, and the column chunks of the row groups of files[i] have
+  // their file_path set to paths[i], relative to the summary file. The schema,
+  // the key-value metadata and created_by are those of files[0]. The reader
+  // does not follow file_path, the data is read from the files themselves
+  static std::shared_ptr<FileMetaData> Combine(
+      const std::vector<std::shared_ptr<FileMetaData>>& files,
+      const std::vector<std::string>& paths);
 
   ~FileMetaData();
 
@@ -169,7 +215,7 @@ class PARQUET_EXPORT FileMetaData {
 
   const ApplicationVersion& writer_version() const;
 
-  void WriteTo(OutputStream* dst);
+  void WriteTo(OutputStream* dst) const;
 
   // Return const-pointer to make it clear that this object is not to be copied
   const SchemaDescriptor* schema() const;
@@ -178,7 +224,8 @@ class PARQUET_EXPORT FileMetaData {
 
  private:
   friend FileMetaDataBuilder;
-  explicit FileMetaData(const uint8_t* serialized_metadata, uint32_t* metadata_len);
+  explicit FileMetaData(const uint8_t* serialized_metadata, uint32_t* metadata_len,
+                        bool lazy = false);
 
   // PIMPL Idiom
   FileMetaData();
@@ -201,6 +248,9 @@ class PARQUET_EXPORT ColumnChunkMetaDataBuilder {
   void set_file_path(const std::string& path);
   // column metadata
   void SetStatistics(bool is_signed, const EncodedStatistics& stats);
+  // Encodings to record on Finish instead of the ones implied by the writer
+  // properties, e.g. for pages that were encoded by another writer
+  void SetEncodings(const std::vector<Encoding::type>& encodings);
   // get the column descriptor
   const ColumnDescriptor* descr() const;
   // commit the metadata
@@ -208,10 +258,26 @@ class PARQUET_EXPORT ColumnChunkMetaDataBuilder {
               int64_t index_page_offset, int64_t data_page_offset,
               int64_t compressed_size, int64_t uncompressed_size, bool has_dictionary,
               bool dictionary_fallback);
+  // Commit the metadata of a column chunk that is copied unchanged from
+  // another file, its bytes starting at offset in this file. Encodings and
+  // codec are carried over, and so are the statistics if source.is_stats_set();
+  // the page index and the Bloom filter of the source chunk are not.
+  void CopyFrom(const ColumnChunkMetaData& source, int64_t offset);
 
   // For writing metadata at end of column chunk
   void WriteTo(OutputStream* sink);
 
+  // Collects the locations and statistics of the data pages
+  PageIndexBuilder* page_index();
+  // Bloom filter of the column chunk values, written after the chunk
+  void SetBloomFilter(std::unique_ptr<BloomFilter> bloom_filter);
+  void WriteBloomFilter(OutputStream* sink);
+  // Keep the sketch the distinct count was estimated with in the metadata
+  void SetDistinctCountSketch(const HyperLogLog& sketch);
+  // Serialize the page index, if any, and record its location in the metadata
+  void WriteColumnIndex(OutputStream* sink);
+  void WriteOffsetIndex(OutputStream* sink);
+
  private:
   explicit ColumnChunkMetaDataBuilder(const std::shared_ptr<WriterProperties>& props,
                                       const ColumnDescriptor* column, uint8_t* contents);
@@ -223,9 +289,13 @@ class PARQUET_EXPORT ColumnChunkMetaDataBuilder {
 class PARQUET_EXPORT RowGroupMetaDataBuilder {
  public:
   // API convenience to get a MetaData reader
+  //
+  // previous is the row group written before this one, if any. It is only
+  // used to check the order of sorted row groups, see
+  // WriterProperties::Builder::enable_sorting_validation.
   static std::unique_ptr<RowGroupMetaDataBuilder> Make(
       const std::shared_ptr<WriterProperties>& props, const SchemaDescriptor* schema_,
-      uint8_t* contents);
+      uint8_t* contents, const uint8_t* previous = nullptr);
 
   ~RowGroupMetaDataBuilder();
 
@@ -235,13 +305,20 @@ class PARQUET_EXPORT RowGroupMetaDataBuilder {
   int current_column() const;
 
   void set_num_rows(int64_t num_rows);
+  // Defaults to WriterProperties::sorting_columns
+  void set_sorting_columns(const std::vector<SortingColumn>& sorting_columns);
 
   // commit the metadata
   void Finish(int64_t total_bytes_written);
 
+  // Serialize the page indexes of all column chunks
+  void WriteColumnIndex(OutputStream* sink);
+  void WriteOffsetIndex(OutputStream* sink);
+
  private:
-  explicit RowGroupMetaDataBuilder(const std::shared_ptr<WriterProperties>& props,
-                                   const SchemaDescriptor* schema_, uint8_t* contents);
+  RowGroupMetaDataBuilder(const std::shared_ptr<WriterProperties>& props,
+                          const SchemaDescriptor* schema_, uint8_t* contents,
+                          const uint8_t* previous);
   // PIMPL Idiom
   class RowGroupMetaDataBuilderImpl;
   std::unique_ptr<RowGroupMetaDataBuilderImpl> impl_;
@@ -258,6 +335,10 @@ class PARQUET_EXPORT FileMetaDataBuilder {
 
   RowGroupMetaDataBuilder* AppendRowGroup();
 
+  // Serialize the column indexes, then the offset indexes, of all row groups.
+  // Must be called before Finish for their locations to be recorded.
+  void WritePageIndex(OutputStream* sink);
+
   // commit the metadata
   std::unique_ptr<FileMetaData> Finish();
 
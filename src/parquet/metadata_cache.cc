@@ -0,0 +1,83 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "parquet/metadata_cache.h"
+
+namespace parquet {
+
+// Paths cannot contain NUL characters, which keeps the keys unambiguous
+static std::string MakeKey(const std::string& path, int64_t file_size,
+                           int64_t modification_time) {
+  std::string key = path;
+  key.push_back('\0');
+  key += std::to_string(file_size);
+  key.push_back('\0');
+  key += std::to_string(modification_time);
+  return key;
+}
+
+FileMetaDataCache::FileMetaDataCache(int64_t capacity)
+    : entries_(capacity), hits_(0), misses_(0) {}
+
+std::shared_ptr<FileMetaData> FileMetaDataCache::Get(const std::string& path,
+                                                     int64_t file_size,
+                                                     int64_t modification_time) {
+  const std::string key = MakeKey(path, file_size, modification_time);
+  std::lock_guard<std::mutex> lock(mutex_);
+  const std::shared_ptr<FileMetaData>* metadata = entries_.Get(key);
+  if (metadata == nullptr) {
+    ++misses_;
+    return nullptr;
+  }
+  ++hits_;
+  return *metadata;
+}
+
+void FileMetaDataCache::Put(const std::string& path, int64_t file_size,
+                            int64_t modification_time,
+                            std::shared_ptr<FileMetaData> metadata) {
+  std::string key = MakeKey(path, file_size, modification_time);
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.Put(std::move(key), std::move(metadata));
+}
+
+void FileMetaDataCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.Clear();
+}
+
+int64_t FileMetaDataCache::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_.size();
+}
+
+int64_t FileMetaDataCache::num_entries() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_.num_entries();
+}
+
+int64_t FileMetaDataCache::hits() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return hits_;
+}
+
+int64_t FileMetaDataCache::misses() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return misses_;
+}
+
+}  // namespace parquet
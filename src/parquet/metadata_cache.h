@@ -0,0 +1,78 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef PARQUET_METADATA_CACHE_H
+#define PARQUET_METADATA_CACHE_H
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "parquet/metadata.h"
+#include "parquet/util/lru-cache.h"
+#include "parquet/util/visibility.h"
+
+namespace parquet {
+
+// Thread-safe LRU cache of parsed file metadata, keyed on the path, the size
+// and the modification time of the file so that a rewritten file is parsed
+// again. Set one on ReaderProperties to share it between the readers opened
+// with ParquetFileReader::OpenFile.
+//
+// The cache is bounded by the total serialized size of the cached footers,
+// the least recently used ones are evicted first.
+class PARQUET_EXPORT FileMetaDataCache {
+ public:
+  explicit FileMetaDataCache(int64_t capacity);
+
+  // Returns nullptr if the metadata of this version of the file is not cached
+  std::shared_ptr<FileMetaData> Get(const std::string& path, int64_t file_size,
+                                    int64_t modification_time);
+
+  // Metadata larger than the capacity is not cached
+  void Put(const std::string& path, int64_t file_size, int64_t modification_time,
+           std::shared_ptr<FileMetaData> metadata);
+
+  void Clear();
+
+  int64_t capacity() const { return entries_.capacity(); }
+
+  // Total serialized size of the cached footers
+  int64_t size() const;
+  int64_t num_entries() const;
+
+  // Number of calls to Get that found / did not find the metadata
+  int64_t hits() const;
+  int64_t misses() const;
+
+ private:
+  struct MetaDataSize {
+    int64_t operator()(const std::shared_ptr<FileMetaData>& metadata) const {
+      return static_cast<int64_t>(metadata->size());
+    }
+  };
+
+  mutable std::mutex mutex_;
+  internal::LruCache<std::string, std::shared_ptr<FileMetaData>, MetaDataSize> entries_;
+  int64_t hits_;
+  int64_t misses_;
+};
+
+}  // namespace parquet
+
+#endif  // PARQUET_METADATA_CACHE_H
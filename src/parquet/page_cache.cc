@@ -0,0 +1,114 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "parquet/page_cache.h"
+
+namespace parquet {
+
+// The kind of entry separates a dictionary page from its decoded dictionary
+static std::string MakeKey(char kind, const std::string& file_key, int64_t offset) {
+  std::string key(1, kind);
+  key += std::to_string(offset);
+  key.push_back('\0');
+  key += file_key;
+  return key;
+}
+
+int64_t PageCache::EntrySize::operator()(const Entry& entry) const {
+  if (entry.page != nullptr) {
+    return entry.page->size();
+  }
+  int64_t size = entry.dictionary.values->size();
+  if (entry.dictionary.byte_array_data != nullptr) {
+    size += entry.dictionary.byte_array_data->size();
+  }
+  return size;
+}
+
+PageCache::PageCache(int64_t capacity)
+    : entries_(capacity), hits_(0), misses_(0) {}
+
+std::shared_ptr<Buffer> PageCache::GetPage(const std::string& file_key,
+                                           int64_t offset) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const Entry* entry = Get(MakeKey('p', file_key, offset));
+  return entry != nullptr ? entry->page : nullptr;
+}
+
+void PageCache::PutPage(const std::string& file_key, int64_t offset,
+                        std::shared_ptr<Buffer> page) {
+  Entry entry;
+  entry.page = std::move(page);
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.Put(MakeKey('p', file_key, offset), std::move(entry));
+}
+
+bool PageCache::GetDictionary(const std::string& file_key, int64_t offset,
+                              DecodedDictionary* out) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  const Entry* entry = Get(MakeKey('d', file_key, offset));
+  if (entry == nullptr) {
+    return false;
+  }
+  *out = entry->dictionary;
+  return true;
+}
+
+void PageCache::PutDictionary(const std::string& file_key, int64_t offset,
+                              const DecodedDictionary& dictionary) {
+  Entry entry;
+  entry.dictionary = dictionary;
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.Put(MakeKey('d', file_key, offset), std::move(entry));
+}
+
+const PageCache::Entry* PageCache::Get(const std::string& key) {
+  const Entry* entry = entries_.Get(key);
+  if (entry == nullptr) {
+    ++misses_;
+  } else {
+    ++hits_;
+  }
+  return entry;
+}
+
+void PageCache::Clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  entries_.Clear();
+}
+
+int64_t PageCache::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_.size();
+}
+
+int64_t PageCache::num_entries() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_.num_entries();
+}
+
+int64_t PageCache::hits() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return hits_;
+}
+
+int64_t PageCache::misses() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return misses_;
+}
+
+}  // namespace parquet
@@ -0,0 +1,94 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef PARQUET_PAGE_CACHE_H
+#define PARQUET_PAGE_CACHE_H
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "parquet/encoding.h"
+#include "parquet/util/lru-cache.h"
+#include "parquet/util/memory.h"
+#include "parquet/util/visibility.h"
+
+namespace parquet {
+
+// Thread-safe LRU cache of decompressed pages and decoded dictionaries, keyed
+// on the cache key of the file (see RandomAccessSource::cache_key) and the
+// file offset of the page. Set one on ReaderProperties to share them between
+// the readers of the same column chunks, which then skip decompressing the
+// pages and decoding the dictionaries again.
+//
+// The cache is bounded by the total size of the cached buffers, the least
+// recently used entries are evicted first.
+class PARQUET_EXPORT PageCache {
+ public:
+  explicit PageCache(int64_t capacity);
+
+  // Returns nullptr if the page is not cached
+  std::shared_ptr<Buffer> GetPage(const std::string& file_key, int64_t offset);
+
+  void PutPage(const std::string& file_key, int64_t offset,
+               std::shared_ptr<Buffer> page);
+
+  // Returns false if the dictionary of the dictionary page at offset is not
+  // cached
+  bool GetDictionary(const std::string& file_key, int64_t offset,
+                     DecodedDictionary* out);
+
+  void PutDictionary(const std::string& file_key, int64_t offset,
+                     const DecodedDictionary& dictionary);
+
+  void Clear();
+
+  int64_t capacity() const { return entries_.capacity(); }
+
+  // Total size of the cached buffers
+  int64_t size() const;
+  int64_t num_entries() const;
+
+  // Number of lookups that found / did not find the page or dictionary
+  int64_t hits() const;
+  int64_t misses() const;
+
+ private:
+  // A decompressed page or a decoded dictionary, the kind of entry is part of
+  // its key
+  struct Entry {
+    std::shared_ptr<Buffer> page;
+    DecodedDictionary dictionary;
+  };
+
+  struct EntrySize {
+    int64_t operator()(const Entry& entry) const;
+  };
+
+  // Look up the entry and count the hit or miss, mutex_ must be held
+  const Entry* Get(const std::string& key);
+
+  mutable std::mutex mutex_;
+  internal::LruCache<std::string, Entry, EntrySize> entries_;
+  int64_t hits_;
+  int64_t misses_;
+};
+
+}  // namespace parquet
+
+#endif  // PARQUET_PAGE_CACHE_H
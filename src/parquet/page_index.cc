@@ -0,0 +1,216 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "parquet/page_index.h"
+
+#include <algorithm>
+#include <utility>
+
+#include "parquet/exception.h"
+#include "parquet/parquet_types.h"
+#include "parquet/thrift.h"
+
+namespace parquet {
+
+// ----------------------------------------------------------------------
+// OffsetIndex
+
+OffsetIndex::OffsetIndex(std::vector<PageLocation> page_locations)
+    : page_locations_(std::move(page_locations)) {}
+
+std::unique_ptr<OffsetIndex> OffsetIndex::Make(const uint8_t* serialized_index,
+                                               uint32_t* len) {
+  format::OffsetIndex index;
+  DeserializeThriftMsg(serialized_index, len, &index);
+
+  std::vector<PageLocation> page_locations;
+  page_locations.reserve(index.page_locations.size());
+  for (const format::PageLocation& location : index.page_locations) {
+    page_locations.push_back(
+        {location.offset, location.compressed_page_size, location.first_row_index});
+  }
+  return std::unique_ptr<OffsetIndex>(new OffsetIndex(std::move(page_locations)));
+}
+
+int OffsetIndex::FindPage(int64_t row_index) const {
+  // First page that starts after the row, the row is in the one before it
+  auto it = std::upper_bound(
+      page_locations_.begin(), page_locations_.end(), row_index,
+      [](int64_t row, const PageLocation& page) { return row < page.first_row_index; });
+  return static_cast<int>(it - page_locations_.begin()) - 1;
+}
+
+// ----------------------------------------------------------------------
+// ColumnIndex
+
+std::unique_ptr<ColumnIndex> ColumnIndex::Make(const uint8_t* serialized_index,
+                                               uint32_t* len) {
+  format::ColumnIndex index;
+  DeserializeThriftMsg(serialized_index, len, &index);
+
+  size_t num_pages = index.null_pages.size();
+  if (index.min_values.size() != num_pages || index.max_values.size() != num_pages ||
+      (index.__isset.null_counts && index.null_counts.size() != num_pages)) {
+    throw ParquetException("Corrupted column index: list lengths do not match");
+  }
+
+  std::unique_ptr<ColumnIndex> result(new ColumnIndex());
+  result->null_pages_ = std::move(index.null_pages);
+  result->min_values_ = std::move(index.min_values);
+  result->max_values_ = std::move(index.max_values);
+  result->boundary_order_ = static_cast<BoundaryOrder::type>(index.boundary_order);
+  if (index.__isset.null_counts) {
+    result->null_counts_ = std::move(index.null_counts);
+  }
+  return result;
+}
+
+// ----------------------------------------------------------------------
+// PageIndexBuilder
+
+class PageIndexBuilder::PageIndexBuilderImpl {
+ public:
+  PageIndexBuilderImpl() : has_column_index_(true), has_offset_index_(true) {
+    column_index_.__set_boundary_order(format::BoundaryOrder::UNORDERED);
+    column_index_.__isset.null_counts = true;
+  }
+
+  void AddPage(const EncodedStatistics& stats, int32_t num_values,
+               int64_t first_row_index, int64_t offset, int64_t page_size) {
+    const std::vector<format::PageLocation>& locations = offset_index_.page_locations;
+    if (first_row_index < 0 ||
+        (!locations.empty() && first_row_index <= locations.back().first_row_index)) {
+      has_offset_index_ = false;
+    }
+    format::PageLocation location;
+    location.__set_offset(offset);
+    location.__set_compressed_page_size(static_cast<int32_t>(page_size));
+    location.__set_first_row_index(first_row_index);
+    offset_index_.page_locations.push_back(location);
+
+    if (!has_column_index_) {
+      return;
+    }
+    if (stats.has_min && stats.has_max) {
+      column_index_.null_pages.push_back(false);
+      column_index_.min_values.push_back(stats.min());
+      column_index_.max_values.push_back(stats.max());
+    } else if (stats.has_null_count && stats.null_count == num_values) {
+      column_index_.null_pages.push_back(true);
+      column_index_.min_values.push_back("");
+      column_index_.max_values.push_back("");
+    } else {
+      has_column_index_ = false;
+      return;
+    }
+    if (stats.has_null_count) {
+      column_index_.null_counts.push_back(stats.null_count);
+    } else {
+      column_index_.__isset.null_counts = false;
+    }
+  }
+
+  void Finish(int64_t position_offset) {
+    for (format::PageLocation& location : offset_index_.page_locations) {
+      location.offset += position_offset;
+    }
+    if (!column_index_.__isset.null_counts) {
+      column_index_.null_counts.clear();
+    }
+  }
+
+  // The column index refers to the pages by their position in the offset
+  // index, both are written or neither
+  bool has_offset_index() const {
+    return has_offset_index_ && !offset_index_.page_locations.empty();
+  }
+
+  bool has_column_index() const { return has_column_index_ && has_offset_index(); }
+
+  const std::vector<bool>& null_pages() const { return column_index_.null_pages; }
+
+  const std::vector<std::string>& encoded_min_values() const {
+    return column_index_.min_values;
+  }
+
+  const std::vector<std::string>& encoded_max_values() const {
+    return column_index_.max_values;
+  }
+
+  void set_boundary_order(BoundaryOrder::type boundary_order) {
+    column_index_.__set_boundary_order(
+        static_cast<format::BoundaryOrder::type>(boundary_order));
+  }
+
+  int64_t WriteColumnIndex(OutputStream* sink) {
+    return SerializeThriftMsg(&column_index_, sizeof(format::ColumnIndex), sink);
+  }
+
+  int64_t WriteOffsetIndex(OutputStream* sink) {
+    return SerializeThriftMsg(&offset_index_, sizeof(format::OffsetIndex), sink);
+  }
+
+ private:
+  bool has_column_index_;
+  bool has_offset_index_;
+  format::ColumnIndex column_index_;
+  format::OffsetIndex offset_index_;
+};
+
+PageIndexBuilder::PageIndexBuilder() : impl_(new PageIndexBuilderImpl()) {}
+
+PageIndexBuilder::~PageIndexBuilder() {}
+
+void PageIndexBuilder::AddPage(const EncodedStatistics& stats, int32_t num_values,
+                               int64_t first_row_index, int64_t offset,
+                               int64_t page_size) {
+  impl_->AddPage(stats, num_values, first_row_index, offset, page_size);
+}
+
+void PageIndexBuilder::Finish(int64_t position_offset) {
+  impl_->Finish(position_offset);
+}
+
+bool PageIndexBuilder::has_column_index() const { return impl_->has_column_index(); }
+
+bool PageIndexBuilder::has_offset_index() const { return impl_->has_offset_index(); }
+
+const std::vector<bool>& PageIndexBuilder::null_pages() const {
+  return impl_->null_pages();
+}
+
+const std::vector<std::string>& PageIndexBuilder::encoded_min_values() const {
+  return impl_->encoded_min_values();
+}
+
+const std::vector<std::string>& PageIndexBuilder::encoded_max_values() const {
+  return impl_->encoded_max_values();
+}
+
+void PageIndexBuilder::set_boundary_order(BoundaryOrder::type boundary_order) {
+  impl_->set_boundary_order(boundary_order);
+}
+
+int64_t PageIndexBuilder::WriteColumnIndex(OutputStream* sink) {
+  return impl_->WriteColumnIndex(sink);
+}
+
+int64_t PageIndexBuilder::WriteOffsetIndex(OutputStream* sink) {
+  return impl_->WriteOffsetIndex(sink);
+}
+
+}  // namespace parquet
@@ -0,0 +1,139 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef PARQUET_PAGE_INDEX_H
+#define PARQUET_PAGE_INDEX_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "parquet/statistics.h"
+#include "parquet/util/memory.h"
+#include "parquet/util/visibility.h"
+
+namespace parquet {
+
+struct BoundaryOrder {
+  enum type { UNORDERED = 0, ASCENDING = 1, DESCENDING = 2 };
+};
+
+struct PageLocation {
+  // Offset of the page header in the file
+  int64_t offset;
+  // Size of the page, including the header
+  int32_t compressed_page_size;
+  // Row group-relative index of the first row of the page
+  int64_t first_row_index;
+};
+
+// The location of each data page of a column chunk. Lets readers seek to the
+// page containing a given row without walking the page headers.
+class PARQUET_EXPORT OffsetIndex {
+ public:
+  // Deserialize from the bytes at ColumnChunkMetaData::offset_index_offset
+  static std::unique_ptr<OffsetIndex> Make(const uint8_t* serialized_index,
+                                           uint32_t* len);
+
+  int num_pages() const { return static_cast<int>(page_locations_.size()); }
+
+  const std::vector<PageLocation>& page_locations() const { return page_locations_; }
+
+  // Index of the page that contains the given row, found by binary search.
+  // Returns -1 if the row precedes the first page.
+  int FindPage(int64_t row_index) const;
+
+ private:
+  explicit OffsetIndex(std::vector<PageLocation> page_locations);
+
+  std::vector<PageLocation> page_locations_;
+};
+
+// Per-page statistics of a column chunk, the i-th entry of each list refers
+// to the page at OffsetIndex::page_locations()[i]
+class PARQUET_EXPORT ColumnIndex {
+ public:
+  // Deserialize from the bytes at ColumnChunkMetaData::column_index_offset
+  static std::unique_ptr<ColumnIndex> Make(const uint8_t* serialized_index,
+                                           uint32_t* len);
+
+  int num_pages() const { return static_cast<int>(null_pages_.size()); }
+
+  // True if the page only contains nulls, its min / max values are then empty
+  const std::vector<bool>& null_pages() const { return null_pages_; }
+
+  // Plain-encoded bounds of each page, see EncodedStatistics
+  const std::vector<std::string>& encoded_min_values() const { return min_values_; }
+  const std::vector<std::string>& encoded_max_values() const { return max_values_; }
+
+  BoundaryOrder::type boundary_order() const { return boundary_order_; }
+
+  bool has_null_counts() const { return !null_counts_.empty(); }
+  const std::vector<int64_t>& null_counts() const { return null_counts_; }
+
+ private:
+  ColumnIndex() = default;
+
+  std::vector<bool> null_pages_;
+  std::vector<std::string> min_values_;
+  std::vector<std::string> max_values_;
+  BoundaryOrder::type boundary_order_;
+  std::vector<int64_t> null_counts_;
+};
+
+// Collects the page index of a column chunk while its pages are written. The
+// serialized indexes are placed after all row groups, before the footer.
+class PARQUET_EXPORT PageIndexBuilder {
+ public:
+  PageIndexBuilder();
+  ~PageIndexBuilder();
+
+  // first_row_index is -1 if the page does not start at a row boundary, no
+  // index is written for the column chunk then. The column index is only
+  // written if all pages have statistics.
+  void AddPage(const EncodedStatistics& stats, int32_t num_values,
+               int64_t first_row_index, int64_t offset, int64_t page_size);
+
+  // Shift the page offsets by position_offset, for pages that were written to
+  // a temporary sink that is later appended to the file at that position
+  void Finish(int64_t position_offset);
+
+  bool has_column_index() const;
+  bool has_offset_index() const;
+
+  // The column index collected so far, only valid if has_column_index()
+  const std::vector<bool>& null_pages() const;
+  const std::vector<std::string>& encoded_min_values() const;
+  const std::vector<std::string>& encoded_max_values() const;
+
+  // UNORDERED unless the writer checked the order of the page values
+  void set_boundary_order(BoundaryOrder::type boundary_order);
+
+  // Return the number of bytes written
+  int64_t WriteColumnIndex(OutputStream* sink);
+  int64_t WriteOffsetIndex(OutputStream* sink);
+
+ private:
+  // PIMPL Idiom
+  class PageIndexBuilderImpl;
+  std::unique_ptr<PageIndexBuilderImpl> impl_;
+};
+
+}  // namespace parquet
+
+#endif  // PARQUET_PAGE_INDEX_H
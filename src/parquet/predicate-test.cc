@@ -0,0 +1,183 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <gtest/gtest.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "parquet/exception.h"
+#include "parquet/metadata.h"
+#include "parquet/predicate.h"
+#include "parquet/schema.h"
+#include "parquet/statistics.h"
+#include "parquet/types.h"
+
+namespace parquet {
+
+namespace test {
+
+static std::string EncodeInt32(int32_t value) {
+  return std::string(reinterpret_cast<const char*>(&value), sizeof(int32_t));
+}
+
+// Four row groups of 100 rows with the statistics
+//
+//   int_col (required)  str_col (optional, UTF8)
+// 0 [100, 200]          ["b", "d"], 5 nulls
+// 1 [300, 300]          only nulls
+// 2 no statistics       no statistics
+// 3 [100, 200]          ["b", "d"], no null count
+class TestPredicate : public ::testing::Test {
+ public:
+  void SetUp() override {
+    schema::NodeVector fields;
+    fields.push_back(schema::Int32("int_col", Repetition::REQUIRED));
+    fields.push_back(schema::PrimitiveNode::Make("str_col", Repetition::OPTIONAL,
+                                                 Type::BYTE_ARRAY, LogicalType::UTF8));
+    schema_.Init(schema::GroupNode::Make("schema", Repetition::REQUIRED, fields));
+
+    auto file_builder = FileMetaDataBuilder::Make(&schema_, default_writer_properties());
+
+    EncodedStatistics int_stats, str_stats;
+    int_stats.set_null_count(0).set_min(EncodeInt32(100)).set_max(EncodeInt32(200));
+    str_stats.set_null_count(5).set_min("b").set_max("d");
+    AppendRowGroup(file_builder.get(), &int_stats, &str_stats);
+
+    int_stats.set_min(EncodeInt32(300)).set_max(EncodeInt32(300));
+    EncodedStatistics null_stats;
+    null_stats.set_null_count(kNumRows);
+    AppendRowGroup(file_builder.get(), &int_stats, &null_stats);
+
+    AppendRowGroup(file_builder.get(), nullptr, nullptr);
+
+    int_stats.set_min(EncodeInt32(100)).set_max(EncodeInt32(200));
+    EncodedStatistics no_null_count_stats;
+    no_null_count_stats.set_min("b").set_max("d");
+    AppendRowGroup(file_builder.get(), &int_stats, &no_null_count_stats);
+
+    metadata_ = file_builder->Finish();
+  }
+
+  // Whether the predicate can match each of the row groups
+  std::vector<bool> CanMatch(const std::shared_ptr<Predicate>& predicate) {
+    std::vector<bool> result;
+    for (int i = 0; i < metadata_->num_row_groups(); i++) {
+      result.push_back(predicate->CanMatch(*metadata_->RowGroup(i)));
+    }
+    return result;
+  }
+
+ protected:
+  static constexpr int64_t kNumRows = 100;
+
+  void AppendRowGroup(FileMetaDataBuilder* file_builder, const EncodedStatistics* stats1,
+                      const EncodedStatistics* stats2) {
+    auto row_group_builder = file_builder->AppendRowGroup();
+    const EncodedStatistics* stats[] = {stats1, stats2};
+    for (const EncodedStatistics* column_stats : stats) {
+      auto column_builder = row_group_builder->NextColumnChunk();
+      if (column_stats != nullptr) {
+        column_builder->SetStatistics(true, *column_stats);
+      }
+      column_builder->Finish(kNumRows, 0, 0, 4, 512, 600, false, false);
+    }
+    row_group_builder->set_num_rows(kNumRows);
+    row_group_builder->Finish(1024);
+  }
+
+  SchemaDescriptor schema_;
+  std::shared_ptr<FileMetaData> metadata_;
+};
+
+constexpr int64_t TestPredicate::kNumRows;
+
+TEST_F(TestPredicate, Comparisons) {
+  using predicate::Equal;
+
+  ASSERT_EQ(std::vector<bool>({true, false, true, true}),
+            CanMatch(Equal<Int32Type>(0, 150)));
+  ASSERT_EQ(std::vector<bool>({false, true, true, false}),
+            CanMatch(Equal<Int32Type>(0, 300)));
+  ASSERT_EQ(std::vector<bool>({false, false, true, false}),
+            CanMatch(Equal<Int32Type>(0, 50)));
+  ASSERT_EQ(std::vector<bool>({true, false, true, true}),
+            CanMatch(predicate::NotEqual<Int32Type>(0, 300)));
+  ASSERT_EQ(std::vector<bool>({false, false, true, false}),
+            CanMatch(predicate::Less<Int32Type>(0, 100)));
+  ASSERT_EQ(std::vector<bool>({true, false, true, true}),
+            CanMatch(predicate::LessEqual<Int32Type>(0, 100)));
+  ASSERT_EQ(std::vector<bool>({false, true, true, false}),
+            CanMatch(predicate::Greater<Int32Type>(0, 200)));
+  ASSERT_EQ(std::vector<bool>({true, true, true, true}),
+            CanMatch(predicate::GreaterEqual<Int32Type>(0, 200)));
+
+  // Only nulls compare with no value
+  ASSERT_EQ(std::vector<bool>({true, false, true, true}),
+            CanMatch(Equal<ByteArrayType>(1, "c")));
+  ASSERT_EQ(std::vector<bool>({false, false, true, false}),
+            CanMatch(Equal<ByteArrayType>(1, "e")));
+  ASSERT_EQ(std::vector<bool>({false, false, true, false}),
+            CanMatch(predicate::Less<ByteArrayType>(1, "b")));
+}
+
+TEST_F(TestPredicate, In) {
+  ASSERT_EQ(std::vector<bool>({false, false, true, false}),
+            CanMatch(predicate::In<Int32Type>(0, {50, 250})));
+  ASSERT_EQ(std::vector<bool>({true, true, true, true}),
+            CanMatch(predicate::In<Int32Type>(0, {150, 300})));
+  ASSERT_EQ(std::vector<bool>({false, false, true, false}),
+            CanMatch(predicate::In<Int32Type>(0, {})));
+  ASSERT_EQ(std::vector<bool>({true, false, true, true}),
+            CanMatch(predicate::In<ByteArrayType>(1, {"a", "bb"})));
+}
+
+TEST_F(TestPredicate, Nulls) {
+  ASSERT_EQ(std::vector<bool>({false, false, false, false}),
+            CanMatch(predicate::IsNull(0)));
+  ASSERT_EQ(std::vector<bool>({true, true, true, true}),
+            CanMatch(predicate::IsNotNull(0)));
+  // The nulls of row group 3 are not counted
+  ASSERT_EQ(std::vector<bool>({true, true, true, true}), CanMatch(predicate::IsNull(1)));
+  ASSERT_EQ(std::vector<bool>({true, false, true, true}),
+            CanMatch(predicate::IsNotNull(1)));
+}
+
+TEST_F(TestPredicate, AndOr) {
+  auto in_first = predicate::Less<Int32Type>(0, 250);
+  auto in_second = predicate::IsNull(1);
+  auto no_match = predicate::Equal<ByteArrayType>(1, "z");
+
+  ASSERT_EQ(std::vector<bool>({true, false, true, true}),
+            CanMatch(predicate::And({in_first, in_second})));
+  ASSERT_EQ(std::vector<bool>({false, false, true, false}),
+            CanMatch(predicate::And({in_first, no_match})));
+  ASSERT_EQ(std::vector<bool>({true, false, true, true}),
+            CanMatch(predicate::Or({in_first, no_match})));
+  ASSERT_EQ(std::vector<bool>({false, false, true, false}),
+            CanMatch(predicate::Or({no_match, predicate::IsNull(0)})));
+}
+
+TEST_F(TestPredicate, TypeMismatch) {
+  ASSERT_THROW(CanMatch(predicate::Equal<Int64Type>(0, 150)), ParquetException);
+}
+
+}  // namespace test
+
+}  // namespace parquet
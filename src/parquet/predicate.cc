@@ -0,0 +1,263 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "parquet/predicate.h"
+
+#include <cmath>
+#include <sstream>
+
+#include "parquet/exception.h"
+#include "parquet/metadata.h"
+#include "parquet/schema.h"
+#include "parquet/statistics.h"
+#include "parquet/util/comparison.h"
+
+namespace parquet {
+
+// Statistics of the column chunk, nullptr if there are none that can be trusted.
+// Their null_count() is 0 if the writer did not set it, null_count_set tells.
+static std::shared_ptr<RowGroupStatistics> ColumnChunkStatistics(
+    const RowGroupMetaData& row_group, int column_index, bool* null_count_set) {
+  std::unique_ptr<ColumnChunkMetaData> column_chunk = row_group.ColumnChunk(column_index);
+  if (!column_chunk->is_stats_set()) {
+    return nullptr;
+  }
+  *null_count_set = column_chunk->is_null_count_set();
+  return column_chunk->statistics();
+}
+
+// Min / max of floating point columns do not bound NaNs
+template <typename T>
+static inline bool IsNaN(const T& value) {
+  return false;
+}
+
+template <>
+inline bool IsNaN<float>(const float& value) {
+  return std::isnan(value);
+}
+
+template <>
+inline bool IsNaN<double>(const double& value) {
+  return std::isnan(value);
+}
+
+template <typename DType>
+struct PhysicalValue {
+  using V = typename PredicateValue<DType>::type;
+
+  static bool IsValid(const V& value, const ColumnDescriptor* descr) { return true; }
+  static typename DType::c_type Get(const V& value) { return value; }
+};
+
+template <>
+struct PhysicalValue<ByteArrayType> {
+  static bool IsValid(const std::string& value, const ColumnDescriptor* descr) {
+    return true;
+  }
+  static ByteArray Get(const std::string& value) {
+    return ByteArray(static_cast<uint32_t>(value.size()),
+                     reinterpret_cast<const uint8_t*>(value.data()));
+  }
+};
+
+template <>
+struct PhysicalValue<FLBAType> {
+  static bool IsValid(const std::string& value, const ColumnDescriptor* descr) {
+    return static_cast<int>(value.size()) == descr->type_length();
+  }
+  static FLBA Get(const std::string& value) {
+    return FLBA(reinterpret_cast<const uint8_t*>(value.data()));
+  }
+};
+
+// Checks "column op value" for one of the values
+template <typename DType>
+class ComparisonPredicate : public Predicate {
+ public:
+  using T = typename DType::c_type;
+  using V = typename PredicateValue<DType>::type;
+
+  ComparisonPredicate(int column_index, CompareOperator::type op,
+                      const std::vector<V>& values)
+      : column_index_(column_index), op_(op), values_(values) {}
+
+  bool CanMatch(const RowGroupMetaData& row_group) const override {
+    const ColumnDescriptor* descr = row_group.schema()->Column(column_index_);
+    if (descr->physical_type() != DType::type_num) {
+      std::stringstream ss;
+      ss << "Predicate on column " << column_index_ << " compares with "
+         << TypeToString(DType::type_num) << " values, the column is "
+         << TypeToString(descr->physical_type());
+      throw ParquetException(ss.str());
+    }
+
+    bool null_count_set = false;
+    std::shared_ptr<RowGroupStatistics> stats =
+        ColumnChunkStatistics(row_group, column_index_, &null_count_set);
+    if (stats == nullptr) {
+      return true;
+    }
+    if (null_count_set && stats->num_values() == 0) {
+      // Only nulls, which compare with no value
+      return false;
+    }
+    if (!stats->HasMinMax() || descr->sort_order() == SortOrder::UNKNOWN) {
+      return true;
+    }
+
+    const auto& typed_stats = static_cast<const TypedRowGroupStatistics<DType>&>(*stats);
+    const T& min = typed_stats.min();
+    const T& max = typed_stats.max();
+    if (IsNaN(min) || IsNaN(max)) {
+      return true;
+    }
+
+    auto comparator =
+        std::static_pointer_cast<CompareDefault<DType>>(Comparator::Make(descr));
+    for (const V& value : values_) {
+      if (!PhysicalValue<DType>::IsValid(value, descr) ||
+          RangeCanMatch(*comparator, min, max, PhysicalValue<DType>::Get(value))) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+ private:
+  // Whether a value in [min, max] can satisfy the comparison with value
+  bool RangeCanMatch(CompareDefault<DType>& less, const T& min, const T& max,
+                     const T& value) const {
+    switch (op_) {
+      case CompareOperator::EQUAL:
+        return !less(value, min) && !less(max, value);
+      case CompareOperator::NOT_EQUAL:
+        return less(min, value) || less(value, max);
+      case CompareOperator::LESS:
+        return less(min, value);
+      case CompareOperator::LESS_EQUAL:
+        return !less(value, min);
+      case CompareOperator::GREATER:
+        return less(value, max);
+      case CompareOperator::GREATER_EQUAL:
+        return !less(max, value);
+    }
+    return true;
+  }
+
+  int column_index_;
+  CompareOperator::type op_;
+  std::vector<V> values_;
+};
+
+class NullPredicate : public Predicate {
+ public:
+  NullPredicate(int column_index, bool is_null)
+      : column_index_(column_index), is_null_(is_null) {}
+
+  bool CanMatch(const RowGroupMetaData& row_group) const override {
+    const ColumnDescriptor* descr = row_group.schema()->Column(column_index_);
+    if (descr->max_definition_level() == 0) {
+      // Required values are never null
+      return !is_null_;
+    }
+
+    bool null_count_set = false;
+    std::shared_ptr<RowGroupStatistics> stats =
+        ColumnChunkStatistics(row_group, column_index_, &null_count_set);
+    if (stats == nullptr || !null_count_set) {
+      return true;
+    }
+    return is_null_ ? stats->null_count() > 0 : stats->num_values() > 0;
+  }
+
+ private:
+  int column_index_;
+  bool is_null_;
+};
+
+class LogicalPredicate : public Predicate {
+ public:
+  LogicalPredicate(const std::vector<std::shared_ptr<Predicate>>& children, bool is_and)
+      : children_(children), is_and_(is_and) {}
+
+  bool CanMatch(const RowGroupMetaData& row_group) const override {
+    for (const auto& child : children_) {
+      if (child->CanMatch(row_group) != is_and_) {
+        return !is_and_;
+      }
+    }
+    return is_and_;
+  }
+
+ private:
+  std::vector<std::shared_ptr<Predicate>> children_;
+  bool is_and_;
+};
+
+namespace predicate {
+
+template <typename DType>
+std::shared_ptr<Predicate> Compare(int column_index, CompareOperator::type op,
+                                   const typename PredicateValue<DType>::type& value) {
+  return std::make_shared<ComparisonPredicate<DType>>(
+      column_index, op, std::vector<typename PredicateValue<DType>::type>{value});
+}
+
+template <typename DType>
+std::shared_ptr<Predicate> In(
+    int column_index, const std::vector<typename PredicateValue<DType>::type>& values) {
+  return std::make_shared<ComparisonPredicate<DType>>(column_index,
+                                                      CompareOperator::EQUAL, values);
+}
+
+std::shared_ptr<Predicate> IsNull(int column_index) {
+  return std::make_shared<NullPredicate>(column_index, true);
+}
+
+std::shared_ptr<Predicate> IsNotNull(int column_index) {
+  return std::make_shared<NullPredicate>(column_index, false);
+}
+
+std::shared_ptr<Predicate> And(const std::vector<std::shared_ptr<Predicate>>& children) {
+  return std::make_shared<LogicalPredicate>(children, true);
+}
+
+std::shared_ptr<Predicate> Or(const std::vector<std::shared_ptr<Predicate>>& children) {
+  return std::make_shared<LogicalPredicate>(children, false);
+}
+
+#define PREDICATE_INSTANTIATE(DType)                                    \
+  template std::shared_ptr<Predicate> Compare<DType>(                   \
+      int, CompareOperator::type, const PredicateValue<DType>::type&); \
+  template std::shared_ptr<Predicate> In<DType>(                        \
+      int, const std::vector<PredicateValue<DType>::type>&)
+
+PREDICATE_INSTANTIATE(BooleanType);
+PREDICATE_INSTANTIATE(Int32Type);
+PREDICATE_INSTANTIATE(Int64Type);
+PREDICATE_INSTANTIATE(Int96Type);
+PREDICATE_INSTANTIATE(FloatType);
+PREDICATE_INSTANTIATE(DoubleType);
+PREDICATE_INSTANTIATE(ByteArrayType);
+PREDICATE_INSTANTIATE(FLBAType);
+
+#undef PREDICATE_INSTANTIATE
+
+}  // namespace predicate
+
+}  // namespace parquet
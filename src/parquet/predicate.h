@@ -0,0 +1,131 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef PARQUET_PREDICATE_H
+#define PARQUET_PREDICATE_H
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "parquet/types.h"
+#include "parquet/util/visibility.h"
+
+namespace parquet {
+
+class RowGroupMetaData;
+
+struct CompareOperator {
+  enum type { EQUAL, NOT_EQUAL, LESS, LESS_EQUAL, GREATER, GREATER_EQUAL };
+};
+
+// Filter expression on leaf columns that is checked against the column chunk
+// statistics of row groups, so that readers can skip the row groups in which no
+// row satisfies it. Comparisons follow SQL semantics, a null is neither equal nor
+// unequal to any value.
+class PARQUET_EXPORT Predicate {
+ public:
+  virtual ~Predicate() {}
+
+  // Return false if the statistics of the row group rule out that any of its
+  // rows satisfies the predicate. Columns without usable statistics can always
+  // match.
+  virtual bool CanMatch(const RowGroupMetaData& row_group) const = 0;
+};
+
+// Type of the values that predicates on columns of the physical type DType
+// compare with. BYTE_ARRAY and FIXED_LEN_BYTE_ARRAY values are held as strings.
+template <typename DType>
+struct PredicateValue {
+  using type = typename DType::c_type;
+};
+
+template <>
+struct PredicateValue<ByteArrayType> {
+  using type = std::string;
+};
+
+template <>
+struct PredicateValue<FLBAType> {
+  using type = std::string;
+};
+
+namespace predicate {
+
+// Predicate factories. column_index refers to the leaf columns of the file schema,
+// DType must be the physical type of that column; the values are in the column's
+// sort order, e.g. unsigned for UINT_32 columns.
+
+template <typename DType>
+PARQUET_EXPORT std::shared_ptr<Predicate> Compare(
+    int column_index, CompareOperator::type op,
+    const typename PredicateValue<DType>::type& value);
+
+template <typename DType>
+std::shared_ptr<Predicate> Equal(int column_index,
+                                 const typename PredicateValue<DType>::type& value) {
+  return Compare<DType>(column_index, CompareOperator::EQUAL, value);
+}
+
+template <typename DType>
+std::shared_ptr<Predicate> NotEqual(int column_index,
+                                    const typename PredicateValue<DType>::type& value) {
+  return Compare<DType>(column_index, CompareOperator::NOT_EQUAL, value);
+}
+
+template <typename DType>
+std::shared_ptr<Predicate> Less(int column_index,
+                                const typename PredicateValue<DType>::type& value) {
+  return Compare<DType>(column_index, CompareOperator::LESS, value);
+}
+
+template <typename DType>
+std::shared_ptr<Predicate> LessEqual(int column_index,
+                                     const typename PredicateValue<DType>::type& value) {
+  return Compare<DType>(column_index, CompareOperator::LESS_EQUAL, value);
+}
+
+template <typename DType>
+std::shared_ptr<Predicate> Greater(int column_index,
+                                   const typename PredicateValue<DType>::type& value) {
+  return Compare<DType>(column_index, CompareOperator::GREATER, value);
+}
+
+template <typename DType>
+std::shared_ptr<Predicate> GreaterEqual(
+    int column_index, const typename PredicateValue<DType>::type& value) {
+  return Compare<DType>(column_index, CompareOperator::GREATER_EQUAL, value);
+}
+
+// The column value equals any of values
+template <typename DType>
+PARQUET_EXPORT std::shared_ptr<Predicate> In(
+    int column_index, const std::vector<typename PredicateValue<DType>::type>& values);
+
+PARQUET_EXPORT std::shared_ptr<Predicate> IsNull(int column_index);
+PARQUET_EXPORT std::shared_ptr<Predicate> IsNotNull(int column_index);
+
+PARQUET_EXPORT std::shared_ptr<Predicate> And(
+    const std::vector<std::shared_ptr<Predicate>>& children);
+PARQUET_EXPORT std::shared_ptr<Predicate> Or(
+    const std::vector<std::shared_ptr<Predicate>>& children);
+
+}  // namespace predicate
+
+}  // namespace parquet
+
+#endif  // PARQUET_PREDICATE_H
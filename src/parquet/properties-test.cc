@@ -33,6 +33,32 @@ TEST(TestReaderProperties, Basics) {
 
   ASSERT_EQ(DEFAULT_BUFFER_SIZE, props.buffer_size());
   ASSERT_EQ(DEFAULT_USE_BUFFERED_STREAM, props.is_buffered_stream_enabled());
+  ASSERT_EQ(DEFAULT_USE_DOUBLE_BUFFERED_STREAM,
+            props.is_double_buffered_stream_enabled());
+  ASSERT_EQ(DEFAULT_FOOTER_READ_SIZE, props.footer_read_size());
+}
+
+TEST(TestReaderProperties, MemoryLimit) {
+  ReaderProperties props;
+  ASSERT_EQ(0, props.memory_limit());
+  ASSERT_EQ(::arrow::default_memory_pool(), props.memory_pool());
+
+  props.set_memory_limit(1 << 20);
+  ASSERT_EQ(1 << 20, props.memory_limit());
+  ASSERT_NE(::arrow::default_memory_pool(), props.memory_pool());
+  ASSERT_EQ(0, props.memory_usage());
+
+  // Copies of the properties share the budget
+  ReaderProperties copy = props;
+  std::shared_ptr<PoolBuffer> buffer = AllocateBuffer(copy.memory_pool(), 1000);
+  ASSERT_EQ(1000, props.memory_usage());
+  ASSERT_FALSE(buffer->Resize(2 << 20).ok());
+  buffer.reset();
+  ASSERT_EQ(0, props.memory_usage());
+
+  ASSERT_THROW(props.set_memory_limit(-1), ParquetException);
+  props.set_memory_limit(0);
+  ASSERT_EQ(::arrow::default_memory_pool(), props.memory_pool());
 }
 
 TEST(TestWriterProperties, Basics) {
@@ -41,6 +67,9 @@ TEST(TestWriterProperties, Basics) {
   ASSERT_EQ(DEFAULT_PAGE_SIZE, props->data_pagesize());
   ASSERT_EQ(DEFAULT_DICTIONARY_PAGE_SIZE_LIMIT, props->dictionary_pagesize_limit());
   ASSERT_EQ(DEFAULT_WRITER_VERSION, props->version());
+  ASSERT_EQ(DEFAULT_MAX_ROW_GROUP_BYTES, props->max_row_group_bytes());
+  ASSERT_EQ(DEFAULT_WRITER_MEMORY_LIMIT, props->memory_limit());
+  ASSERT_EQ(DEFAULT_DATA_PAGE_VERSION, props->data_page_version());
 }
 
 TEST(TestWriterProperties, AdvancedHandling) {
@@ -62,5 +91,53 @@ TEST(TestWriterProperties, AdvancedHandling) {
             props->encoding(ColumnPath::FromDotString("delta-length")));
 }
 
+TEST(TestWriterProperties, AutoEncoding) {
+  WriterProperties::Builder builder;
+  builder.enable_auto_encoding(1000)->disable_auto_encoding("fixed");
+  builder.enable_auto_encoding("small", 10);
+  std::shared_ptr<WriterProperties> props = builder.build();
+
+  ASSERT_TRUE(props->auto_encoding_enabled(ColumnPath::FromDotString("any")));
+  ASSERT_EQ(1000, props->auto_encoding_sample_size(ColumnPath::FromDotString("any")));
+  ASSERT_FALSE(props->auto_encoding_enabled(ColumnPath::FromDotString("fixed")));
+  ASSERT_EQ(10, props->auto_encoding_sample_size(ColumnPath::FromDotString("small")));
+
+  props = WriterProperties::Builder().build();
+  ASSERT_FALSE(props->auto_encoding_enabled(ColumnPath::FromDotString("any")));
+  ASSERT_EQ(DEFAULT_AUTO_ENCODING_SAMPLE_SIZE,
+            props->auto_encoding_sample_size(ColumnPath::FromDotString("any")));
+  ASSERT_THROW(WriterProperties::Builder().enable_auto_encoding(0), ParquetException);
+}
+
+TEST(TestWriterProperties, ResolveColumns) {
+  schema::NodeVector fields;
+  fields.push_back(schema::Int32("gzip"));
+  fields.push_back(schema::Int32("plain"));
+  SchemaDescriptor schema;
+  schema.Init(schema::GroupNode::Make("schema", Repetition::REQUIRED, fields));
+
+  WriterProperties::Builder builder;
+  builder.compression("gzip", Compression::GZIP)->compression(Compression::SNAPPY);
+  builder.disable_dictionary("plain");
+  std::shared_ptr<WriterProperties> props = builder.build();
+  std::shared_ptr<WriterProperties> resolved = props->ResolveColumns(&schema);
+
+  for (int i = 0; i < schema.num_columns(); i++) {
+    const ColumnDescriptor* descr = schema.Column(i);
+    ASSERT_EQ(i, descr->column_index());
+    ASSERT_EQ(props->compression(descr->path()),
+              resolved->column_properties(descr).codec);
+    ASSERT_EQ(props->dictionary_enabled(descr->path()),
+              resolved->column_properties(descr).dictionary_enabled);
+  }
+  ASSERT_EQ(Compression::GZIP, resolved->column_properties(schema.Column(0)).codec);
+  ASSERT_FALSE(resolved->column_properties(schema.Column(1)).dictionary_enabled);
+
+  // Descriptors of other schemas fall back to the lookup by path
+  ColumnDescriptor other(schema::Int32("gzip"), 1, 0);
+  ASSERT_EQ(Compression::GZIP, resolved->column_properties(&other).codec);
+  ASSERT_EQ(Compression::GZIP, props->column_properties(schema.Column(0)).codec);
+}
+
 }  // namespace test
 }  // namespace parquet
@@ -21,8 +21,11 @@
 #include <memory>
 #include <string>
 #include <unordered_map>
+#include <utility>
+#include <vector>
 
 #include "parquet/exception.h"
+#include "parquet/hyperloglog.h"
 #include "parquet/parquet_version.h"
 #include "parquet/schema.h"
 #include "parquet/types.h"
@@ -31,12 +34,36 @@
 
 namespace parquet {
 
+class BlockCache;
+class FileMetaDataCache;
+class PageCache;
+class ReadMetrics;
+class ThreadPool;
+class WriteMetrics;
+
 struct ParquetVersion {
   enum type { PARQUET_1_0, PARQUET_2_0 };
 };
 
+// Format of the data pages. The levels of V2 pages are not compressed and
+// their header holds the number of nulls and rows of the page.
+struct ParquetDataPageVersion {
+  enum type { V1, V2 };
+};
+
 static int64_t DEFAULT_BUFFER_SIZE = 0;
 static bool DEFAULT_USE_BUFFERED_STREAM = false;
+static bool DEFAULT_USE_DOUBLE_BUFFERED_STREAM = false;
+static bool DEFAULT_USE_PRE_BUFFER = false;
+static int64_t DEFAULT_PRE_BUFFER_HOLE_SIZE_LIMIT = 8 * 1024;
+static int64_t DEFAULT_PAGE_READ_AHEAD = 0;
+static bool DEFAULT_USE_LAZY_METADATA = false;
+// PARQUET-978: Minimize footer reads by reading 64 KB from the end of the file
+static int64_t DEFAULT_FOOTER_READ_SIZE = 64 * 1024;
+static bool DEFAULT_USE_ADAPTIVE_FOOTER_READ_SIZE = false;
+static bool DEFAULT_USE_WINDOWED_STREAM = false;
+static int64_t DEFAULT_STREAM_WINDOW_SIZE = 1024 * 1024;
+static int64_t DEFAULT_STREAM_READ_AHEAD_BUDGET = 64 * 1024 * 1024;
 
 class PARQUET_EXPORT ReaderProperties {
  public:
@@ -44,16 +71,62 @@ class PARQUET_EXPORT ReaderProperties {
       : pool_(pool) {
     buffered_stream_enabled_ = DEFAULT_USE_BUFFERED_STREAM;
     buffer_size_ = DEFAULT_BUFFER_SIZE;
+    double_buffered_stream_enabled_ = DEFAULT_USE_DOUBLE_BUFFERED_STREAM;
+    pre_buffer_enabled_ = DEFAULT_USE_PRE_BUFFER;
+    pre_buffer_hole_size_limit_ = DEFAULT_PRE_BUFFER_HOLE_SIZE_LIMIT;
+    page_read_ahead_ = DEFAULT_PAGE_READ_AHEAD;
+    lazy_metadata_enabled_ = DEFAULT_USE_LAZY_METADATA;
+    footer_read_size_ = DEFAULT_FOOTER_READ_SIZE;
+    adaptive_footer_read_size_enabled_ = DEFAULT_USE_ADAPTIVE_FOOTER_READ_SIZE;
+    windowed_stream_enabled_ = DEFAULT_USE_WINDOWED_STREAM;
+    stream_window_size_ = DEFAULT_STREAM_WINDOW_SIZE;
+    stream_read_ahead_budget_ = DEFAULT_STREAM_READ_AHEAD_BUDGET;
   }
 
-  ::arrow::MemoryPool* memory_pool() const { return pool_; }
+  // The pool that the readers allocate from: the limited pool if a memory
+  // limit is set, the pool of the constructor otherwise
+  ::arrow::MemoryPool* memory_pool() const {
+    return limited_pool_ ? limited_pool_.get() : pool_;
+  }
 
-  std::unique_ptr<InputStream> GetStream(RandomAccessSource* source, int64_t start,
-                                         int64_t num_bytes) {
+  // Limit the bytes that the readers of these properties may allocate from the
+  // pool at a time, e.g. for decompressed pages, dictionaries and stream
+  // buffers. Reads that would exceed the limit fail with an out of memory
+  // error instead. The copies of the properties share the limit, so the
+  // readers of all files opened with them share the budget, which must
+  // outlive the pages they put into a page cache. 0, the default, sets no
+  // limit
+  void set_memory_limit(int64_t limit) {
+    if (limit < 0) {
+      throw ParquetException("Memory limit must not be negative");
+    }
+    if (limit == 0) {
+      limited_pool_.reset();
+    } else {
+      limited_pool_ = std::make_shared<LimitedMemoryPool>(pool_, limit);
+    }
+  }
+
+  int64_t memory_limit() const { return limited_pool_ ? limited_pool_->limit() : 0; }
+
+  // Bytes allocated by the readers of these properties, if a memory limit is
+  // set, of the whole pool otherwise
+  int64_t memory_usage() const { return memory_pool()->bytes_allocated(); }
+
+  // The read ahead of windowed streams is taken from budget, if given
+  std::unique_ptr<InputStream> GetStream(
+      RandomAccessSource* source, int64_t start, int64_t num_bytes,
+      const std::shared_ptr<ReadAheadBudget>& budget = nullptr) {
     std::unique_ptr<InputStream> stream;
-    if (buffered_stream_enabled_) {
-      stream.reset(
-          new BufferedInputStream(pool_, buffer_size_, source, start, num_bytes));
+    if (windowed_stream_enabled_) {
+      stream.reset(new WindowedInputStream(memory_pool(), stream_window_size_, source,
+                                           start, num_bytes, budget));
+    } else if (buffered_stream_enabled_ && double_buffered_stream_enabled_) {
+      stream.reset(new DoubleBufferedInputStream(memory_pool(), buffer_size_, source,
+                                                 start, num_bytes));
+    } else if (buffered_stream_enabled_) {
+      stream.reset(new BufferedInputStream(memory_pool(), buffer_size_, source, start,
+                                           num_bytes));
     } else {
       stream.reset(new InMemoryInputStream(source, start, num_bytes));
     }
@@ -70,23 +143,188 @@ class PARQUET_EXPORT ReaderProperties {
 
   int64_t buffer_size() const { return buffer_size_; }
 
+  // When enabled together with the buffered stream, the buffered streams read
+  // the next buffer_size() bytes in the background while the current ones are
+  // consumed instead of stalling the reader on every refill
+  bool is_double_buffered_stream_enabled() const {
+    return double_buffered_stream_enabled_;
+  }
+
+  void enable_double_buffered_stream() { double_buffered_stream_enabled_ = true; }
+
+  void disable_double_buffered_stream() { double_buffered_stream_enabled_ = false; }
+
+  // When enabled, column chunks are read through a WindowedInputStream: each
+  // column reader holds a window of stream_window_size() bytes of its chunk
+  // and reads the next window in the background, instead of reading the whole
+  // chunk up front. Takes precedence over the buffered stream
+  bool is_windowed_stream_enabled() const { return windowed_stream_enabled_; }
+
+  void enable_windowed_stream() { windowed_stream_enabled_ = true; }
+
+  void disable_windowed_stream() { windowed_stream_enabled_ = false; }
+
+  void set_stream_window_size(int64_t window_size) { stream_window_size_ = window_size; }
+
+  int64_t stream_window_size() const { return stream_window_size_; }
+
+  // Bytes that the windowed streams of all column readers of a file may read
+  // ahead in total. Streams that find the budget used up read their next
+  // window when they reach it
+  void set_stream_read_ahead_budget(int64_t budget) {
+    stream_read_ahead_budget_ = budget;
+  }
+
+  int64_t stream_read_ahead_budget() const { return stream_read_ahead_budget_; }
+
+  // When enabled, ParquetFileReader::PreBuffer reads the column chunks of a
+  // row group up front with a few large, concurrent reads instead of one read
+  // per column at the time the column is opened
+  bool is_pre_buffer_enabled() const { return pre_buffer_enabled_; }
+
+  void enable_pre_buffer() { pre_buffer_enabled_ = true; }
+
+  void disable_pre_buffer() { pre_buffer_enabled_ = false; }
+
+  // Column chunks separated by at most this many bytes are fetched with a
+  // single read when pre-buffering
+  void set_pre_buffer_hole_size_limit(int64_t hole_size_limit) {
+    pre_buffer_hole_size_limit_ = hole_size_limit;
+  }
+
+  int64_t pre_buffer_hole_size_limit() const { return pre_buffer_hole_size_limit_; }
+
+  // Number of pages of a compressed column chunk that are read and
+  // decompressed on a background thread ahead of decoding. 0 disables
+  // read-ahead
+  void set_page_read_ahead(int64_t num_pages) { page_read_ahead_ = num_pages; }
+
+  int64_t page_read_ahead() const { return page_read_ahead_; }
+
+  // When enabled, opening a file only decodes the schema and the row group
+  // headers of the footer. The metadata of a column chunk is decoded the
+  // first time it is accessed, which pays off for files with many columns of
+  // which few are read
+  bool is_lazy_metadata_enabled() const { return lazy_metadata_enabled_; }
+
+  void enable_lazy_metadata() { lazy_metadata_enabled_ = true; }
+
+  void disable_lazy_metadata() { lazy_metadata_enabled_ = false; }
+
+  // Number of bytes read from the end of the file in the first read when
+  // opening it. The metadata is read with a second read if it is larger
+  void set_footer_read_size(int64_t size) { footer_read_size_ = size; }
+
+  int64_t footer_read_size() const { return footer_read_size_; }
+
+  // When enabled, the first read when opening a file is grown to fit the
+  // largest footer of the files opened recently in this process, so that a
+  // series of files with similar schemas is opened with a single read
+  bool is_adaptive_footer_read_size_enabled() const {
+    return adaptive_footer_read_size_enabled_;
+  }
+
+  void enable_adaptive_footer_read_size() { adaptive_footer_read_size_enabled_ = true; }
+
+  void disable_adaptive_footer_read_size() {
+    adaptive_footer_read_size_enabled_ = false;
+  }
+
+  // ParquetFileReader::OpenFile looks up the metadata of the file in this
+  // cache before parsing the footer, and stores it there afterwards. Share
+  // one cache between the properties of all readers to reuse the metadata of
+  // files that are opened repeatedly. nullptr, the default, disables caching
+  void set_metadata_cache(std::shared_ptr<FileMetaDataCache> cache) {
+    metadata_cache_ = std::move(cache);
+  }
+
+  const std::shared_ptr<FileMetaDataCache>& metadata_cache() const {
+    return metadata_cache_;
+  }
+
+  // ParquetFileReader::Open serves the reads of sources with a cache key from
+  // the blocks of this cache; the files opened with OpenFile are keyed on
+  // their path, size and modification time. Share one cache between the
+  // properties of all readers. nullptr, the default, disables caching
+  void set_block_cache(std::shared_ptr<BlockCache> cache) {
+    block_cache_ = std::move(cache);
+  }
+
+  const std::shared_ptr<BlockCache>& block_cache() const { return block_cache_; }
+
+  // The column readers of sources with a cache key look up decompressed pages
+  // and decoded dictionaries in this cache before decompressing and decoding
+  // them again. Share one cache between the properties of all readers.
+  // nullptr, the default, disables caching
+  void set_page_cache(std::shared_ptr<PageCache> cache) {
+    page_cache_ = std::move(cache);
+  }
+
+  const std::shared_ptr<PageCache>& page_cache() const { return page_cache_; }
+
+  // The page and column readers of the columns add the bytes and pages they
+  // read and the time they spend on I/O, decompression and decoding to these
+  // metrics. Share them between the properties of all readers to collect the
+  // metrics of a process. nullptr, the default, disables the metrics
+  void set_read_metrics(std::shared_ptr<ReadMetrics> metrics) {
+    read_metrics_ = std::move(metrics);
+  }
+
+  const std::shared_ptr<ReadMetrics>& read_metrics() const { return read_metrics_; }
+
  private:
   ::arrow::MemoryPool* pool_;
+  // Allocates from pool_, see set_memory_limit
+  std::shared_ptr<LimitedMemoryPool> limited_pool_;
   int64_t buffer_size_;
   bool buffered_stream_enabled_;
+  bool double_buffered_stream_enabled_;
+  bool pre_buffer_enabled_;
+  int64_t pre_buffer_hole_size_limit_;
+  int64_t page_read_ahead_;
+  bool lazy_metadata_enabled_;
+  int64_t footer_read_size_;
+  bool adaptive_footer_read_size_enabled_;
+  bool windowed_stream_enabled_;
+  int64_t stream_window_size_;
+  int64_t stream_read_ahead_budget_;
+  std::shared_ptr<FileMetaDataCache> metadata_cache_;
+  std::shared_ptr<BlockCache> block_cache_;
+  std::shared_ptr<PageCache> page_cache_;
+  std::shared_ptr<ReadMetrics> read_metrics_;
 };
 
 ReaderProperties PARQUET_EXPORT default_reader_properties();
 
 static constexpr int64_t DEFAULT_PAGE_SIZE = 1024 * 1024;
 static constexpr bool DEFAULT_IS_DICTIONARY_ENABLED = true;
+static constexpr bool DEFAULT_IS_DICTIONARY_REUSE_ENABLED = false;
 static constexpr int64_t DEFAULT_DICTIONARY_PAGE_SIZE_LIMIT = DEFAULT_PAGE_SIZE;
+static constexpr int64_t DEFAULT_DICTIONARY_BUFFERED_PAGES_LIMIT = 0;
+static constexpr double DEFAULT_DICTIONARY_MIN_COMPRESSION_RATIO = 0.0;
+static constexpr int64_t DEFAULT_DICTIONARY_MEMORY_LIMIT = 0;
+static constexpr bool DEFAULT_IS_DICTIONARY_MEMORY_REUSE_ENABLED = false;
 static constexpr int64_t DEFAULT_WRITE_BATCH_SIZE = 1024;
 static constexpr int64_t DEFAULT_MAX_ROW_GROUP_LENGTH = 64 * 1024 * 1024;
+static constexpr int64_t DEFAULT_MAX_ROW_GROUP_BYTES = 0;
+static constexpr int64_t DEFAULT_WRITER_MEMORY_LIMIT = 0;
+static constexpr int DEFAULT_PAGE_COMPRESSION_PARALLELISM = 1;
+static constexpr int64_t DEFAULT_ASYNC_WRITE_BUDGET = 0;
+static constexpr int64_t DEFAULT_ASYNC_WRITE_BLOCK_SIZE = 1024 * 1024;
+static constexpr bool DEFAULT_IS_SORTING_VALIDATION_ENABLED = false;
 static constexpr bool DEFAULT_ARE_STATISTICS_ENABLED = true;
+static constexpr bool DEFAULT_IS_BLOOM_FILTER_ENABLED = false;
+static constexpr double DEFAULT_BLOOM_FILTER_FPP = 0.01;
+static constexpr bool DEFAULT_IS_DISTINCT_COUNT_ENABLED = false;
+static constexpr int DEFAULT_DISTINCT_COUNT_PRECISION = 8;
+static constexpr bool DEFAULT_IS_AUTO_ENCODING_ENABLED = false;
+static constexpr int64_t DEFAULT_AUTO_ENCODING_SAMPLE_SIZE = 4096;
+static constexpr int64_t DEFAULT_STATISTICS_TRUNCATE_LENGTH = 0;
 static constexpr Encoding::type DEFAULT_ENCODING = Encoding::PLAIN;
 static constexpr ParquetVersion::type DEFAULT_WRITER_VERSION =
     ParquetVersion::PARQUET_1_0;
+static constexpr ParquetDataPageVersion::type DEFAULT_DATA_PAGE_VERSION =
+    ParquetDataPageVersion::V1;
 static const char DEFAULT_CREATED_BY[] = CREATED_BY_VERSION;
 static constexpr Compression::type DEFAULT_COMPRESSION_TYPE = Compression::UNCOMPRESSED;
 
@@ -95,16 +333,49 @@ class PARQUET_EXPORT ColumnProperties {
   ColumnProperties(Encoding::type encoding = DEFAULT_ENCODING,
                    Compression::type codec = DEFAULT_COMPRESSION_TYPE,
                    bool dictionary_enabled = DEFAULT_IS_DICTIONARY_ENABLED,
-                   bool statistics_enabled = DEFAULT_ARE_STATISTICS_ENABLED)
+                   bool statistics_enabled = DEFAULT_ARE_STATISTICS_ENABLED,
+                   bool bloom_filter_enabled = DEFAULT_IS_BLOOM_FILTER_ENABLED,
+                   double bloom_filter_fpp = DEFAULT_BLOOM_FILTER_FPP,
+                   int64_t statistics_truncate_length =
+                       DEFAULT_STATISTICS_TRUNCATE_LENGTH,
+                   bool dictionary_reuse_enabled = DEFAULT_IS_DICTIONARY_REUSE_ENABLED,
+                   bool distinct_count_enabled = DEFAULT_IS_DISTINCT_COUNT_ENABLED,
+                   int distinct_count_precision = DEFAULT_DISTINCT_COUNT_PRECISION,
+                   bool auto_encoding_enabled = DEFAULT_IS_AUTO_ENCODING_ENABLED,
+                   int64_t auto_encoding_sample_size = DEFAULT_AUTO_ENCODING_SAMPLE_SIZE)
       : encoding(encoding),
         codec(codec),
         dictionary_enabled(dictionary_enabled),
-        statistics_enabled(statistics_enabled) {}
+        statistics_enabled(statistics_enabled),
+        bloom_filter_enabled(bloom_filter_enabled),
+        bloom_filter_fpp(bloom_filter_fpp),
+        statistics_truncate_length(statistics_truncate_length),
+        dictionary_reuse_enabled(dictionary_reuse_enabled),
+        distinct_count_enabled(distinct_count_enabled),
+        distinct_count_precision(distinct_count_precision),
+        auto_encoding_enabled(auto_encoding_enabled),
+        auto_encoding_sample_size(auto_encoding_sample_size) {}
 
   Encoding::type encoding;
   Compression::type codec;
   bool dictionary_enabled;
   bool statistics_enabled;
+  bool bloom_filter_enabled;
+  // False positive probability the Bloom filter is sized for
+  double bloom_filter_fpp;
+  // Longest min/max of BYTE_ARRAY statistics, 0 keeps the whole values
+  int64_t statistics_truncate_length;
+  // Start the dictionary of a column chunk with the entries of the previous
+  // row group's chunk
+  bool dictionary_reuse_enabled;
+  bool distinct_count_enabled;
+  // Precision of the HyperLogLog sketch the distinct count is estimated with
+  int distinct_count_precision;
+  // Choose the encoding of each column chunk from its first values instead of
+  // encoding and dictionary_enabled
+  bool auto_encoding_enabled;
+  // Number of values the encoding is chosen from
+  int64_t auto_encoding_sample_size;
 };
 
 class PARQUET_EXPORT WriterProperties {
@@ -114,10 +385,21 @@ class PARQUET_EXPORT WriterProperties {
     Builder()
         : pool_(::arrow::default_memory_pool()),
           dictionary_pagesize_limit_(DEFAULT_DICTIONARY_PAGE_SIZE_LIMIT),
+          dictionary_buffered_pages_limit_(DEFAULT_DICTIONARY_BUFFERED_PAGES_LIMIT),
+          dictionary_min_compression_ratio_(DEFAULT_DICTIONARY_MIN_COMPRESSION_RATIO),
+          dictionary_memory_limit_(DEFAULT_DICTIONARY_MEMORY_LIMIT),
+          dictionary_memory_reuse_enabled_(DEFAULT_IS_DICTIONARY_MEMORY_REUSE_ENABLED),
           write_batch_size_(DEFAULT_WRITE_BATCH_SIZE),
           max_row_group_length_(DEFAULT_MAX_ROW_GROUP_LENGTH),
+          max_row_group_bytes_(DEFAULT_MAX_ROW_GROUP_BYTES),
+          memory_limit_(DEFAULT_WRITER_MEMORY_LIMIT),
           pagesize_(DEFAULT_PAGE_SIZE),
+          page_compression_parallelism_(DEFAULT_PAGE_COMPRESSION_PARALLELISM),
+          async_write_budget_(DEFAULT_ASYNC_WRITE_BUDGET),
+          async_write_block_size_(DEFAULT_ASYNC_WRITE_BLOCK_SIZE),
+          sorting_validation_enabled_(DEFAULT_IS_SORTING_VALIDATION_ENABLED),
           version_(DEFAULT_WRITER_VERSION),
+          data_page_version_(DEFAULT_DATA_PAGE_VERSION),
           created_by_(DEFAULT_CREATED_BY) {}
     virtual ~Builder() {}
 
@@ -154,11 +436,92 @@ class PARQUET_EXPORT WriterProperties {
       return this->disable_dictionary(path->ToDotString());
     }
 
+    // Start the dictionary of every column chunk with the entries of the
+    // dictionary of the same column in the previous row group, unless that
+    // chunk fell back to PLAIN. The entries are not hashed again, and the
+    // dictionary pages of consecutive row groups are identical as long as no
+    // new values show up, which suits columns of few distinct values. The
+    // dictionary then only grows, up to dictionary_pagesize_limit
+    Builder* enable_dictionary_reuse() {
+      default_column_properties_.dictionary_reuse_enabled = true;
+      return this;
+    }
+
+    Builder* disable_dictionary_reuse() {
+      default_column_properties_.dictionary_reuse_enabled = false;
+      return this;
+    }
+
+    Builder* enable_dictionary_reuse(const std::string& path) {
+      dictionary_reuse_enabled_[path] = true;
+      return this;
+    }
+
+    Builder* enable_dictionary_reuse(const std::shared_ptr<schema::ColumnPath>& path) {
+      return this->enable_dictionary_reuse(path->ToDotString());
+    }
+
+    Builder* disable_dictionary_reuse(const std::string& path) {
+      dictionary_reuse_enabled_[path] = false;
+      return this;
+    }
+
+    Builder* disable_dictionary_reuse(const std::shared_ptr<schema::ColumnPath>& path) {
+      return this->disable_dictionary_reuse(path->ToDotString());
+    }
+
     Builder* dictionary_pagesize_limit(int64_t dictionary_psize_limit) {
       dictionary_pagesize_limit_ = dictionary_psize_limit;
       return this;
     }
 
+    // The dictionary page precedes the data pages of a column chunk, so the
+    // dictionary encoded pages are kept in memory until the chunk is closed or
+    // falls back to PLAIN. Once they take up limit bytes, the dictionary page
+    // is written instead and the pages that follow go straight to the sink. A
+    // page with values the written dictionary lacks falls back to PLAIN. 0
+    // buffers the whole chunk.
+    Builder* dictionary_buffered_pages_limit(int64_t limit) {
+      dictionary_buffered_pages_limit_ = limit;
+      return this;
+    }
+
+    // Fall back to PLAIN once the PLAIN size of the dictionary encoded values
+    // is less than ratio times the size of their indices plus the dictionary,
+    // checked at the end of every data page. 0 never falls back for this
+    // reason.
+    Builder* dictionary_min_compression_ratio(double ratio) {
+      dictionary_min_compression_ratio_ = ratio;
+      return this;
+    }
+
+    // Fall back to PLAIN once the BYTE_ARRAY or FIXED_LEN_BYTE_ARRAY values of
+    // the dictionary of a column chunk take up limit bytes of memory, checked
+    // after every write batch. The chunks of the dictionary memory do not grow
+    // past the limit, at most one batch of new values goes over it. 0 only
+    // limits the size of the dictionary page, see dictionary_pagesize_limit.
+    Builder* dictionary_memory_limit(int64_t limit) {
+      if (limit < 0) {
+        throw ParquetException("Dictionary memory limit must not be negative");
+      }
+      dictionary_memory_limit_ = limit;
+      return this;
+    }
+
+    // Keep the memory of the dictionary values of each column when its chunk
+    // is closed and reuse it for the chunk of the next row group, instead of
+    // freeing and allocating it again for every row group. The memory is only
+    // released when the file is closed.
+    Builder* enable_dictionary_memory_reuse() {
+      dictionary_memory_reuse_enabled_ = true;
+      return this;
+    }
+
+    Builder* disable_dictionary_memory_reuse() {
+      dictionary_memory_reuse_enabled_ = false;
+      return this;
+    }
+
     Builder* write_batch_size(int64_t write_batch_size) {
       write_batch_size_ = write_batch_size;
       return this;
@@ -169,16 +532,119 @@ class PARQUET_EXPORT WriterProperties {
       return this;
     }
 
+    // Target size of a row group in bytes, estimated from the encoded and
+    // buffered sizes of its column chunks. The Arrow writer starts a new row
+    // group once the target is reached. 0 only limits the number of rows.
+    Builder* max_row_group_bytes(int64_t max_row_group_bytes) {
+      if (max_row_group_bytes < 0) {
+        throw ParquetException("Row group size target must not be negative");
+      }
+      max_row_group_bytes_ = max_row_group_bytes;
+      return this;
+    }
+
+    // Soft limit of the bytes that a row group holds in memory while it is
+    // written, see RowGroupWriter::memory_usage. Column writers that reach it
+    // write the data pages they buffer for dictionary encoding without
+    // waiting for the dictionary to be complete, and the Arrow writer starts
+    // a new row group once the row group reaches it. 0 sets no limit.
+    Builder* memory_limit(int64_t memory_limit) {
+      if (memory_limit < 0) {
+        throw ParquetException("Memory limit must not be negative");
+      }
+      memory_limit_ = memory_limit;
+      return this;
+    }
+
     Builder* data_pagesize(int64_t pg_size) {
       pagesize_ = pg_size;
       return this;
     }
 
+    // Number of data pages of a column chunk that may be compressed at the
+    // same time. With more than 1, the pages are compressed on
+    // compression_thread_pool() while the next pages are encoded, and are
+    // written in order once compressed. 1 compresses on the writing thread.
+    Builder* page_compression_parallelism(int parallelism) {
+      if (parallelism < 1) {
+        throw ParquetException("Page compression parallelism must be at least 1");
+      }
+      page_compression_parallelism_ = parallelism;
+      return this;
+    }
+
+    // Pool the pages are compressed on, ThreadPool::GetDefault() if not set
+    Builder* compression_thread_pool(const std::shared_ptr<ThreadPool>& pool) {
+      compression_thread_pool_ = pool;
+      return this;
+    }
+
+    // Bytes of writes to the file that may wait to be written. With more than
+    // 0, the writes are coalesced into blocks of async_write_block_size bytes
+    // that are written from a background thread, see AsyncOutputStream, and
+    // errors of the sink are thrown at the latest by ParquetFileWriter::Close.
+    // 0 writes synchronously.
+    Builder* async_write_budget(int64_t budget) {
+      if (budget < 0) {
+        throw ParquetException("Async write budget must not be negative");
+      }
+      async_write_budget_ = budget;
+      return this;
+    }
+
+    Builder* async_write_block_size(int64_t block_size) {
+      if (block_size < 1) {
+        throw ParquetException("Async write block size must be at least 1");
+      }
+      async_write_block_size_ = block_size;
+      return this;
+    }
+
+    // Record in the metadata of every row group that its rows are sorted by
+    // these columns, see RowGroupMetaData::sorting_columns. The writer trusts
+    // the caller unless sorting validation is enabled.
+    Builder* sorting_columns(const std::vector<SortingColumn>& sorting_columns) {
+      sorting_columns_ = sorting_columns;
+      return this;
+    }
+
+    // Check that the pages of each column chunk and the row groups of the file
+    // follow each other in the order of the first sorting column, which is
+    // what the search over sorted row groups relies on, see sorted_search.h.
+    // The check uses the page and column chunk statistics, the order of the
+    // values within a page is not checked. Throws ParquetException when a row
+    // group is closed out of order.
+    Builder* enable_sorting_validation() {
+      sorting_validation_enabled_ = true;
+      return this;
+    }
+
+    Builder* disable_sorting_validation() {
+      sorting_validation_enabled_ = false;
+      return this;
+    }
+
+    // Per-column counters of the values, pages and bytes that are written and
+    // of the time spent on statistics, encoding and compression, see
+    // WriteMetrics. Not collected if not set
+    Builder* write_metrics(const std::shared_ptr<WriteMetrics>& metrics) {
+      write_metrics_ = metrics;
+      return this;
+    }
+
     Builder* version(ParquetVersion::type version) {
       version_ = version;
       return this;
     }
 
+    // With V2, the values of a page are only stored compressed if the
+    // compression makes them smaller. The V2 pages of repeated columns start
+    // at a record, so they can exceed data_pagesize by up to one record.
+    Builder* data_page_version(ParquetDataPageVersion::type data_page_version) {
+      data_page_version_ = data_page_version;
+      return this;
+    }
+
     Builder* created_by(const std::string& created_by) {
       created_by_ = created_by;
       return this;
@@ -270,6 +736,152 @@ class PARQUET_EXPORT WriterProperties {
       return this->disable_statistics(path->ToDotString());
     }
 
+    // Write the min and max of BYTE_ARRAY columns with an unsigned sort order
+    // as bounds of at most length bytes: a prefix of the min and a prefix of
+    // the max whose last byte is incremented. 0 writes the whole values.
+    Builder* statistics_truncate_length(int64_t length) {
+      CheckStatisticsTruncateLength(length);
+      default_column_properties_.statistics_truncate_length = length;
+      return this;
+    }
+
+    Builder* statistics_truncate_length(const std::string& path, int64_t length) {
+      CheckStatisticsTruncateLength(length);
+      statistics_truncate_length_[path] = length;
+      return this;
+    }
+
+    Builder* statistics_truncate_length(const std::shared_ptr<schema::ColumnPath>& path,
+                                        int64_t length) {
+      return this->statistics_truncate_length(path->ToDotString(), length);
+    }
+
+    // Build a Bloom filter of the values of each column chunk, sized for the
+    // given false positive probability. BOOLEAN columns never get one.
+    Builder* enable_bloom_filter(double fpp = DEFAULT_BLOOM_FILTER_FPP) {
+      CheckBloomFilterFpp(fpp);
+      default_column_properties_.bloom_filter_enabled = true;
+      default_column_properties_.bloom_filter_fpp = fpp;
+      return this;
+    }
+
+    Builder* disable_bloom_filter() {
+      default_column_properties_.bloom_filter_enabled = false;
+      return this;
+    }
+
+    Builder* enable_bloom_filter(const std::string& path,
+                                 double fpp = DEFAULT_BLOOM_FILTER_FPP) {
+      CheckBloomFilterFpp(fpp);
+      bloom_filter_enabled_[path] = true;
+      bloom_filter_fpp_[path] = fpp;
+      return this;
+    }
+
+    Builder* enable_bloom_filter(const std::shared_ptr<schema::ColumnPath>& path,
+                                 double fpp = DEFAULT_BLOOM_FILTER_FPP) {
+      return this->enable_bloom_filter(path->ToDotString(), fpp);
+    }
+
+    Builder* disable_bloom_filter(const std::string& path) {
+      bloom_filter_enabled_[path] = false;
+      return this;
+    }
+
+    Builder* disable_bloom_filter(const std::shared_ptr<schema::ColumnPath>& path) {
+      return this->disable_bloom_filter(path->ToDotString());
+    }
+
+    // Estimate the distinct values of each column chunk with a HyperLogLog
+    // sketch of the given precision. The estimate is written as the
+    // distinct_count of the chunk statistics and the sketch is kept in the
+    // chunk metadata, see ColumnChunkMetaData::distinct_count_sketch. BOOLEAN
+    // columns never get one.
+    //
+    // The sketch adds 2^precision + 1 bytes to the footer for every chunk,
+    // which every reader of the file parses. The default of 8 costs 257 bytes
+    // per chunk for an error of about 6.5%, each further bit of precision
+    // doubles the size and divides the error by sqrt(2).
+    Builder* enable_distinct_count(int precision = DEFAULT_DISTINCT_COUNT_PRECISION) {
+      CheckDistinctCountPrecision(precision);
+      default_column_properties_.distinct_count_enabled = true;
+      default_column_properties_.distinct_count_precision = precision;
+      return this;
+    }
+
+    Builder* disable_distinct_count() {
+      default_column_properties_.distinct_count_enabled = false;
+      return this;
+    }
+
+    Builder* enable_distinct_count(const std::string& path,
+                                   int precision = DEFAULT_DISTINCT_COUNT_PRECISION) {
+      CheckDistinctCountPrecision(precision);
+      distinct_count_enabled_[path] = true;
+      distinct_count_precision_[path] = precision;
+      return this;
+    }
+
+    Builder* enable_distinct_count(const std::shared_ptr<schema::ColumnPath>& path,
+                                   int precision = DEFAULT_DISTINCT_COUNT_PRECISION) {
+      return this->enable_distinct_count(path->ToDotString(), precision);
+    }
+
+    Builder* disable_distinct_count(const std::string& path) {
+      distinct_count_enabled_[path] = false;
+      return this;
+    }
+
+    Builder* disable_distinct_count(const std::shared_ptr<schema::ColumnPath>& path) {
+      return this->disable_distinct_count(path->ToDotString());
+    }
+
+    // Choose the encoding of each column chunk once sample_size values are
+    // buffered, or at the end of its first page if that is earlier. The
+    // values are encoded in each of PLAIN, dictionary, DELTA_BINARY_PACKED
+    // (INT32 and INT64), DELTA_LENGTH_BYTE_ARRAY and DELTA_BYTE_ARRAY
+    // (BYTE_ARRAY) and BYTE_STREAM_SPLIT (FLOAT and DOUBLE), compressed with
+    // the codec of the column, and the encoding of the smallest result after a
+    // penalty for slower decoding is kept. Overrides encoding() and
+    // enable_dictionary() of the column, BOOLEAN columns are not sampled.
+    // The choices are counted in the write metrics.
+    Builder* enable_auto_encoding(
+        int64_t sample_size = DEFAULT_AUTO_ENCODING_SAMPLE_SIZE) {
+      CheckAutoEncodingSampleSize(sample_size);
+      default_column_properties_.auto_encoding_enabled = true;
+      default_column_properties_.auto_encoding_sample_size = sample_size;
+      return this;
+    }
+
+    Builder* disable_auto_encoding() {
+      default_column_properties_.auto_encoding_enabled = false;
+      return this;
+    }
+
+    Builder* enable_auto_encoding(
+        const std::string& path,
+        int64_t sample_size = DEFAULT_AUTO_ENCODING_SAMPLE_SIZE) {
+      CheckAutoEncodingSampleSize(sample_size);
+      auto_encoding_enabled_[path] = true;
+      auto_encoding_sample_size_[path] = sample_size;
+      return this;
+    }
+
+    Builder* enable_auto_encoding(
+        const std::shared_ptr<schema::ColumnPath>& path,
+        int64_t sample_size = DEFAULT_AUTO_ENCODING_SAMPLE_SIZE) {
+      return this->enable_auto_encoding(path->ToDotString(), sample_size);
+    }
+
+    Builder* disable_auto_encoding(const std::string& path) {
+      auto_encoding_enabled_[path] = false;
+      return this;
+    }
+
+    Builder* disable_auto_encoding(const std::shared_ptr<schema::ColumnPath>& path) {
+      return this->disable_auto_encoding(path->ToDotString());
+    }
+
     std::shared_ptr<WriterProperties> build() {
       std::unordered_map<std::string, ColumnProperties> column_properties;
       auto get = [&](const std::string& key) -> ColumnProperties& {
@@ -284,22 +896,61 @@ class PARQUET_EXPORT WriterProperties {
       for (const auto& item : codecs_) get(item.first).codec = item.second;
       for (const auto& item : dictionary_enabled_)
         get(item.first).dictionary_enabled = item.second;
+      for (const auto& item : dictionary_reuse_enabled_)
+        get(item.first).dictionary_reuse_enabled = item.second;
       for (const auto& item : statistics_enabled_)
         get(item.first).statistics_enabled = item.second;
+      for (const auto& item : bloom_filter_enabled_)
+        get(item.first).bloom_filter_enabled = item.second;
+      for (const auto& item : bloom_filter_fpp_)
+        get(item.first).bloom_filter_fpp = item.second;
+      for (const auto& item : distinct_count_enabled_)
+        get(item.first).distinct_count_enabled = item.second;
+      for (const auto& item : distinct_count_precision_)
+        get(item.first).distinct_count_precision = item.second;
+      for (const auto& item : auto_encoding_enabled_)
+        get(item.first).auto_encoding_enabled = item.second;
+      for (const auto& item : auto_encoding_sample_size_)
+        get(item.first).auto_encoding_sample_size = item.second;
+      for (const auto& item : statistics_truncate_length_)
+        get(item.first).statistics_truncate_length = item.second;
 
       return std::shared_ptr<WriterProperties>(
-          new WriterProperties(pool_, dictionary_pagesize_limit_, write_batch_size_,
-                               max_row_group_length_, pagesize_, version_, created_by_,
+          new WriterProperties(pool_, dictionary_pagesize_limit_,
+                               dictionary_buffered_pages_limit_,
+                               dictionary_min_compression_ratio_,
+                               dictionary_memory_limit_, dictionary_memory_reuse_enabled_,
+                               write_batch_size_,
+                               max_row_group_length_, max_row_group_bytes_,
+                               memory_limit_, pagesize_,
+                               page_compression_parallelism_, compression_thread_pool_,
+                               async_write_budget_, async_write_block_size_,
+                               sorting_columns_, sorting_validation_enabled_,
+                               write_metrics_, version_, data_page_version_, created_by_,
                                default_column_properties_, column_properties));
     }
 
    private:
     ::arrow::MemoryPool* pool_;
     int64_t dictionary_pagesize_limit_;
+    int64_t dictionary_buffered_pages_limit_;
+    double dictionary_min_compression_ratio_;
+    int64_t dictionary_memory_limit_;
+    bool dictionary_memory_reuse_enabled_;
     int64_t write_batch_size_;
     int64_t max_row_group_length_;
+    int64_t max_row_group_bytes_;
+    int64_t memory_limit_;
     int64_t pagesize_;
+    int page_compression_parallelism_;
+    std::shared_ptr<ThreadPool> compression_thread_pool_;
+    int64_t async_write_budget_;
+    int64_t async_write_block_size_;
+    std::vector<SortingColumn> sorting_columns_;
+    bool sorting_validation_enabled_;
+    std::shared_ptr<WriteMetrics> write_metrics_;
     ParquetVersion::type version_;
+    ParquetDataPageVersion::type data_page_version_;
     std::string created_by_;
 
     // Settings used for each column unless overridden in any of the maps below
@@ -307,21 +958,97 @@ class PARQUET_EXPORT WriterProperties {
     std::unordered_map<std::string, Encoding::type> encodings_;
     std::unordered_map<std::string, Compression::type> codecs_;
     std::unordered_map<std::string, bool> dictionary_enabled_;
+    std::unordered_map<std::string, bool> dictionary_reuse_enabled_;
     std::unordered_map<std::string, bool> statistics_enabled_;
+    std::unordered_map<std::string, bool> bloom_filter_enabled_;
+    std::unordered_map<std::string, double> bloom_filter_fpp_;
+    std::unordered_map<std::string, bool> distinct_count_enabled_;
+    std::unordered_map<std::string, int> distinct_count_precision_;
+    std::unordered_map<std::string, bool> auto_encoding_enabled_;
+    std::unordered_map<std::string, int64_t> auto_encoding_sample_size_;
+    std::unordered_map<std::string, int64_t> statistics_truncate_length_;
+
+    static void CheckBloomFilterFpp(double fpp) {
+      if (!(fpp > 0.0 && fpp < 1.0)) {
+        throw ParquetException(
+            "Bloom filter false positive probability must be in (0, 1)");
+      }
+    }
+
+    static void CheckDistinctCountPrecision(int precision) {
+      if (precision < HyperLogLog::kMinimumPrecision ||
+          precision > HyperLogLog::kMaximumPrecision) {
+        throw ParquetException("Distinct count precision must be in [4, 16]");
+      }
+    }
+
+    static void CheckAutoEncodingSampleSize(int64_t sample_size) {
+      if (sample_size <= 0) {
+        throw ParquetException("Auto encoding sample size must be positive");
+      }
+    }
+
+    static void CheckStatisticsTruncateLength(int64_t length) {
+      if (length < 0) {
+        throw ParquetException("Statistics truncate length must not be negative");
+      }
+    }
   };
 
   inline ::arrow::MemoryPool* memory_pool() const { return pool_; }
 
   inline int64_t dictionary_pagesize_limit() const { return dictionary_pagesize_limit_; }
 
+  inline int64_t dictionary_buffered_pages_limit() const {
+    return dictionary_buffered_pages_limit_;
+  }
+
+  inline double dictionary_min_compression_ratio() const {
+    return dictionary_min_compression_ratio_;
+  }
+
+  inline int64_t dictionary_memory_limit() const { return dictionary_memory_limit_; }
+
+  inline bool dictionary_memory_reuse_enabled() const {
+    return dictionary_memory_reuse_enabled_;
+  }
+
   inline int64_t write_batch_size() const { return write_batch_size_; }
 
   inline int64_t max_row_group_length() const { return max_row_group_length_; }
 
+  inline int64_t max_row_group_bytes() const { return max_row_group_bytes_; }
+
+  inline int64_t memory_limit() const { return memory_limit_; }
+
   inline int64_t data_pagesize() const { return pagesize_; }
 
+  inline int page_compression_parallelism() const {
+    return page_compression_parallelism_;
+  }
+
+  // nullptr if the default pool is used
+  const std::shared_ptr<ThreadPool>& compression_thread_pool() const {
+    return compression_thread_pool_;
+  }
+
+  inline int64_t async_write_budget() const { return async_write_budget_; }
+
+  inline int64_t async_write_block_size() const { return async_write_block_size_; }
+
+  const std::vector<SortingColumn>& sorting_columns() const { return sorting_columns_; }
+
+  inline bool sorting_validation_enabled() const { return sorting_validation_enabled_; }
+
+  // nullptr unless set
+  const std::shared_ptr<WriteMetrics>& write_metrics() const { return write_metrics_; }
+
   inline ParquetVersion::type version() const { return parquet_version_; }
 
+  inline ParquetDataPageVersion::type data_page_version() const {
+    return data_page_version_;
+  }
+
   inline std::string created_by() const { return parquet_created_by_; }
 
   inline Encoding::type dictionary_index_encoding() const {
@@ -347,6 +1074,32 @@ class PARQUET_EXPORT WriterProperties {
     return default_column_properties_;
   }
 
+  // Returns a copy of these properties with the settings of every column of
+  // schema resolved up front, so that column_properties(descr) of its columns
+  // is an index into a vector rather than a lookup by the dotted path. The
+  // file writer does this when it opens, as the per-column settings are
+  // queried for each column of each row group
+  std::shared_ptr<WriterProperties> ResolveColumns(const SchemaDescriptor* schema) const {
+    std::shared_ptr<WriterProperties> resolved(new WriterProperties(*this));
+    resolved->resolved_schema_ = schema;
+    resolved->resolved_column_properties_.clear();
+    resolved->resolved_column_properties_.reserve(schema->num_columns());
+    for (int i = 0; i < schema->num_columns(); i++) {
+      resolved->resolved_column_properties_.push_back(
+          column_properties(schema->Column(i)->path()));
+    }
+    return resolved;
+  }
+
+  const ColumnProperties& column_properties(const ColumnDescriptor* descr) const {
+    const int i = descr->column_index();
+    if (descr->schema_descr() == resolved_schema_ && resolved_schema_ != nullptr &&
+        i >= 0 && i < static_cast<int>(resolved_column_properties_.size())) {
+      return resolved_column_properties_[i];
+    }
+    return column_properties(descr->path());
+  }
+
   Encoding::type encoding(const std::shared_ptr<schema::ColumnPath>& path) const {
     return column_properties(path).encoding;
   }
@@ -359,36 +1112,110 @@ class PARQUET_EXPORT WriterProperties {
     return column_properties(path).dictionary_enabled;
   }
 
+  bool dictionary_reuse_enabled(const std::shared_ptr<schema::ColumnPath>& path) const {
+    return column_properties(path).dictionary_reuse_enabled;
+  }
+
   bool statistics_enabled(const std::shared_ptr<schema::ColumnPath>& path) const {
     return column_properties(path).statistics_enabled;
   }
 
+  bool bloom_filter_enabled(const std::shared_ptr<schema::ColumnPath>& path) const {
+    return column_properties(path).bloom_filter_enabled;
+  }
+
+  double bloom_filter_fpp(const std::shared_ptr<schema::ColumnPath>& path) const {
+    return column_properties(path).bloom_filter_fpp;
+  }
+
+  bool distinct_count_enabled(const std::shared_ptr<schema::ColumnPath>& path) const {
+    return column_properties(path).distinct_count_enabled;
+  }
+
+  int distinct_count_precision(const std::shared_ptr<schema::ColumnPath>& path) const {
+    return column_properties(path).distinct_count_precision;
+  }
+
+  bool auto_encoding_enabled(const std::shared_ptr<schema::ColumnPath>& path) const {
+    return column_properties(path).auto_encoding_enabled;
+  }
+
+  int64_t auto_encoding_sample_size(
+      const std::shared_ptr<schema::ColumnPath>& path) const {
+    return column_properties(path).auto_encoding_sample_size;
+  }
+
+  int64_t statistics_truncate_length(
+      const std::shared_ptr<schema::ColumnPath>& path) const {
+    return column_properties(path).statistics_truncate_length;
+  }
+
  private:
   explicit WriterProperties(
       ::arrow::MemoryPool* pool, int64_t dictionary_pagesize_limit,
-      int64_t write_batch_size, int64_t max_row_group_length, int64_t pagesize,
-      ParquetVersion::type version, const std::string& created_by,
-      const ColumnProperties& default_column_properties,
+      int64_t dictionary_buffered_pages_limit, double dictionary_min_compression_ratio,
+      int64_t dictionary_memory_limit, bool dictionary_memory_reuse_enabled,
+      int64_t write_batch_size, int64_t max_row_group_length,
+      int64_t max_row_group_bytes, int64_t memory_limit, int64_t pagesize,
+      int page_compression_parallelism,
+      const std::shared_ptr<ThreadPool>& compression_thread_pool,
+      int64_t async_write_budget, int64_t async_write_block_size,
+      const std::vector<SortingColumn>& sorting_columns, bool sorting_validation_enabled,
+      const std::shared_ptr<WriteMetrics>& write_metrics, ParquetVersion::type version,
+      ParquetDataPageVersion::type data_page_version,
+      const std::string& created_by, const ColumnProperties& default_column_properties,
       const std::unordered_map<std::string, ColumnProperties>& column_properties)
       : pool_(pool),
         dictionary_pagesize_limit_(dictionary_pagesize_limit),
+        dictionary_buffered_pages_limit_(dictionary_buffered_pages_limit),
+        dictionary_min_compression_ratio_(dictionary_min_compression_ratio),
+        dictionary_memory_limit_(dictionary_memory_limit),
+        dictionary_memory_reuse_enabled_(dictionary_memory_reuse_enabled),
         write_batch_size_(write_batch_size),
         max_row_group_length_(max_row_group_length),
+        max_row_group_bytes_(max_row_group_bytes),
+        memory_limit_(memory_limit),
         pagesize_(pagesize),
+        page_compression_parallelism_(page_compression_parallelism),
+        compression_thread_pool_(compression_thread_pool),
+        async_write_budget_(async_write_budget),
+        async_write_block_size_(async_write_block_size),
+        sorting_columns_(sorting_columns),
+        sorting_validation_enabled_(sorting_validation_enabled),
+        write_metrics_(write_metrics),
         parquet_version_(version),
+        data_page_version_(data_page_version),
         parquet_created_by_(created_by),
         default_column_properties_(default_column_properties),
-        column_properties_(column_properties) {}
+        column_properties_(column_properties),
+        resolved_schema_(nullptr) {}
 
   ::arrow::MemoryPool* pool_;
   int64_t dictionary_pagesize_limit_;
+  int64_t dictionary_buffered_pages_limit_;
+  double dictionary_min_compression_ratio_;
+  int64_t dictionary_memory_limit_;
+  bool dictionary_memory_reuse_enabled_;
   int64_t write_batch_size_;
   int64_t max_row_group_length_;
+  int64_t max_row_group_bytes_;
+  int64_t memory_limit_;
   int64_t pagesize_;
+  int page_compression_parallelism_;
+  std::shared_ptr<ThreadPool> compression_thread_pool_;
+  int64_t async_write_budget_;
+  int64_t async_write_block_size_;
+  std::vector<SortingColumn> sorting_columns_;
+  bool sorting_validation_enabled_;
+  std::shared_ptr<WriteMetrics> write_metrics_;
   ParquetVersion::type parquet_version_;
+  ParquetDataPageVersion::type data_page_version_;
   std::string parquet_created_by_;
   ColumnProperties default_column_properties_;
   std::unordered_map<std::string, ColumnProperties> column_properties_;
+  // See ResolveColumns
+  const SchemaDescriptor* resolved_schema_;
+  std::vector<ColumnProperties> resolved_column_properties_;
 };
 
 std::shared_ptr<WriterProperties> PARQUET_EXPORT default_writer_properties();
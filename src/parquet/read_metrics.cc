@@ -0,0 +1,54 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "parquet/read_metrics.h"
+
+namespace parquet {
+
+ColumnReadMetrics ColumnReadCounters::Get() const {
+  ColumnReadMetrics result;
+  result.bytes_read = bytes_read.load(std::memory_order_relaxed);
+  result.num_data_pages = num_data_pages.load(std::memory_order_relaxed);
+  result.num_dictionary_pages = num_dictionary_pages.load(std::memory_order_relaxed);
+  result.num_dictionary_fallback_pages =
+      num_dictionary_fallback_pages.load(std::memory_order_relaxed);
+  result.io_nanos = io_nanos.load(std::memory_order_relaxed);
+  result.decompress_nanos = decompress_nanos.load(std::memory_order_relaxed);
+  result.level_decode_nanos = level_decode_nanos.load(std::memory_order_relaxed);
+  result.value_decode_nanos = value_decode_nanos.load(std::memory_order_relaxed);
+  return result;
+}
+
+std::shared_ptr<ColumnReadCounters> ReadMetrics::column(const std::string& path) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::shared_ptr<ColumnReadCounters>& counters = columns_[path];
+  if (counters == nullptr) {
+    counters = std::make_shared<ColumnReadCounters>();
+  }
+  return counters;
+}
+
+std::map<std::string, ColumnReadMetrics> ReadMetrics::Get() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::map<std::string, ColumnReadMetrics> result;
+  for (const auto& column : columns_) {
+    result[column.first] = column.second->Get();
+  }
+  return result;
+}
+
+}  // namespace parquet
@@ -0,0 +1,100 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef PARQUET_READ_METRICS_H
+#define PARQUET_READ_METRICS_H
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "parquet/util/stopwatch.h"
+#include "parquet/util/visibility.h"
+
+namespace parquet {
+
+// Totals of the reads of a leaf column, see ReadMetrics
+struct PARQUET_EXPORT ColumnReadMetrics {
+  ColumnReadMetrics()
+      : bytes_read(0),
+        num_data_pages(0),
+        num_dictionary_pages(0),
+        num_dictionary_fallback_pages(0),
+        io_nanos(0),
+        decompress_nanos(0),
+        level_decode_nanos(0),
+        value_decode_nanos(0) {}
+
+  // Bytes of the page headers and pages that were read, as stored in the file
+  int64_t bytes_read;
+  int64_t num_data_pages;
+  int64_t num_dictionary_pages;
+  // Data pages that are not dictionary encoded in column chunks with a
+  // dictionary page, i.e. the writer fell back to another encoding
+  int64_t num_dictionary_fallback_pages;
+
+  // Time spent reading the page headers and pages from the input stream,
+  // decompressing the pages, and decoding the levels and the values
+  int64_t io_nanos;
+  int64_t decompress_nanos;
+  int64_t level_decode_nanos;
+  int64_t value_decode_nanos;
+};
+
+// The counters of a column that its readers add to, possibly concurrently
+struct PARQUET_EXPORT ColumnReadCounters {
+  std::atomic<int64_t> bytes_read{0};
+  std::atomic<int64_t> num_data_pages{0};
+  std::atomic<int64_t> num_dictionary_pages{0};
+  std::atomic<int64_t> num_dictionary_fallback_pages{0};
+  std::atomic<int64_t> io_nanos{0};
+  std::atomic<int64_t> decompress_nanos{0};
+  std::atomic<int64_t> level_decode_nanos{0};
+  std::atomic<int64_t> value_decode_nanos{0};
+
+  static void Add(std::atomic<int64_t>* counter, int64_t value) {
+    counter->fetch_add(value, std::memory_order_relaxed);
+  }
+
+  ColumnReadMetrics Get() const;
+};
+
+typedef ScopedCounterTimer<ColumnReadCounters> ScopedReadTimer;
+
+// Thread-safe per column metrics of the page and column readers of files that
+// are opened with these ReaderProperties, keyed on the dot path of the
+// column. The readers only count when a ReadMetrics is set, the cost is a few
+// clock reads and atomic additions per page and per batch that is read.
+class PARQUET_EXPORT ReadMetrics {
+ public:
+  // The counters of the column, created on first use
+  std::shared_ptr<ColumnReadCounters> column(const std::string& path);
+
+  // The totals so far of every column that was read
+  std::map<std::string, ColumnReadMetrics> Get() const;
+
+ private:
+  mutable std::mutex mutex_;
+  std::map<std::string, std::shared_ptr<ColumnReadCounters>> columns_;
+};
+
+}  // namespace parquet
+
+#endif  // PARQUET_READ_METRICS_H
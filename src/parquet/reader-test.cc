@@ -22,12 +22,15 @@
 #include <iostream>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "arrow/io/file.h"
 
+#include "parquet/block_cache.h"
 #include "parquet/column_reader.h"
 #include "parquet/column_scanner.h"
 #include "parquet/file_reader.h"
+#include "parquet/page_cache.h"
 #include "parquet/printer.h"
 #include "parquet/util/memory.h"
 
@@ -47,6 +50,13 @@ std::string alltypes_plain() {
   return ss.str();
 }
 
+std::string data_file(const char* name) {
+  std::string dir_string(data_dir);
+  std::stringstream ss;
+  ss << dir_string << "/" << name;
+  return ss.str();
+}
+
 std::string nation_dict_truncated_data_page() {
   std::string dir_string(data_dir);
   std::stringstream ss;
@@ -211,6 +221,47 @@ TEST_F(TestLocalFile, FileClosedOnDestruction) {
   ASSERT_TRUE(close_called);
 }
 
+class HelperFileCountReads : public ArrowInputFile {
+ public:
+  explicit HelperFileCountReads(
+      const std::shared_ptr<::arrow::io::ReadableFileInterface>& file, int* num_reads)
+      : ArrowInputFile(file), num_reads_(num_reads) {}
+
+  std::shared_ptr<Buffer> ReadAt(int64_t position, int64_t nbytes) override {
+    ++*num_reads_;
+    return ArrowInputFile::ReadAt(position, nbytes);
+  }
+
+  int64_t ReadAt(int64_t position, int64_t nbytes, uint8_t* out) override {
+    ++*num_reads_;
+    return ArrowInputFile::ReadAt(position, nbytes, out);
+  }
+
+ private:
+  int* num_reads_;
+};
+
+TEST_F(TestLocalFile, AdaptiveFooterReadSize) {
+  ReaderProperties props;
+  // Smaller than the footer of the file
+  props.set_footer_read_size(16);
+
+  int num_reads = 0;
+  auto contents = ParquetFileReader::Contents::Open(
+      std::unique_ptr<RandomAccessSource>(new HelperFileCountReads(handle, &num_reads)),
+      props);
+  ASSERT_EQ(2, num_reads);
+
+  // The size of the footer that was opened last is remembered
+  props.enable_adaptive_footer_read_size();
+  num_reads = 0;
+  auto adaptive_contents = ParquetFileReader::Contents::Open(
+      std::unique_ptr<RandomAccessSource>(new HelperFileCountReads(handle, &num_reads)),
+      props);
+  ASSERT_EQ(1, num_reads);
+  ASSERT_EQ(contents->metadata()->size(), adaptive_contents->metadata()->size());
+}
+
 TEST_F(TestLocalFile, OpenWithMetadata) {
   // PARQUET-808
   std::stringstream ss;
@@ -233,6 +284,95 @@ TEST_F(TestLocalFile, OpenWithMetadata) {
   ASSERT_EQ(metadata.get(), reader2->metadata().get());
 }
 
+TEST(TestFileReaderAdHoc, PreBuffer) {
+  std::list<int> columns = {0, 5, 9, 10};
+  std::vector<int> column_indices(columns.begin(), columns.end());
+
+  auto reader = ParquetFileReader::OpenFile(alltypes_plain(), false);
+  std::stringstream expected;
+  ParquetFilePrinter printer1(reader.get());
+  printer1.DebugPrint(expected, columns, true);
+
+  ReaderProperties props;
+  props.enable_pre_buffer();
+  // Ensure that some, but not all, of the column chunks are merged
+  props.set_pre_buffer_hole_size_limit(100);
+
+  reader = ParquetFileReader::OpenFile(alltypes_plain(), false, props);
+  reader->PreBuffer({0}, column_indices);
+  std::stringstream actual;
+  ParquetFilePrinter printer2(reader.get());
+  printer2.DebugPrint(actual, columns, true);
+
+  ASSERT_EQ(expected.str(), actual.str());
+}
+
+TEST(TestFileReaderAdHoc, BlockCache) {
+  std::list<int> columns = {0, 5, 9, 10};
+
+  auto reader = ParquetFileReader::OpenFile(alltypes_plain(), false);
+  std::stringstream expected;
+  ParquetFilePrinter printer1(reader.get());
+  printer1.DebugPrint(expected, columns, true);
+
+  // Small blocks so that reads span several of them
+  auto cache = std::make_shared<BlockCache>(1024 * 1024, 256, 4);
+  ReaderProperties props;
+  props.set_block_cache(cache);
+  for (int i = 0; i < 2; ++i) {
+    const int64_t misses = cache->misses();
+    reader = ParquetFileReader::OpenFile(alltypes_plain(), false, props);
+    std::stringstream actual;
+    ParquetFilePrinter printer2(reader.get());
+    printer2.DebugPrint(actual, columns, true);
+    ASSERT_EQ(expected.str(), actual.str());
+    if (i == 0) {
+      ASSERT_GT(cache->misses(), misses);
+    } else {
+      // The second reader finds all of the blocks in the cache
+      ASSERT_EQ(misses, cache->misses());
+    }
+  }
+  ASSERT_GT(cache->hits(), 0);
+  ASSERT_GT(cache->num_entries(), 0);
+  ASSERT_LE(cache->size(), cache->capacity());
+
+  // Sources without a cache key are read directly
+  std::shared_ptr<ReadableFile> handle;
+  PARQUET_THROW_NOT_OK(ReadableFile::Open(alltypes_plain(), &handle));
+  const int64_t accesses = cache->hits() + cache->misses();
+  reader = ParquetFileReader::Open(handle, props);
+  ASSERT_EQ(accesses, cache->hits() + cache->misses());
+}
+
+TEST(TestFileReaderAdHoc, PageCache) {
+  std::list<int> columns = {0, 1, 5, 9, 10};
+
+  // Snappy compressed pages and dictionary encoded columns
+  for (const char* name :
+       {"alltypes_plain.snappy.parquet", "alltypes_dictionary.parquet"}) {
+    auto reader = ParquetFileReader::OpenFile(data_file(name), false);
+    std::stringstream expected;
+    ParquetFilePrinter printer1(reader.get());
+    printer1.DebugPrint(expected, columns, true);
+
+    auto cache = std::make_shared<PageCache>(1024 * 1024);
+    ReaderProperties props;
+    props.set_page_cache(cache);
+    for (int i = 0; i < 2; ++i) {
+      reader = ParquetFileReader::OpenFile(data_file(name), false, props);
+      std::stringstream actual;
+      ParquetFilePrinter printer2(reader.get());
+      printer2.DebugPrint(actual, columns, true);
+      ASSERT_EQ(expected.str(), actual.str());
+      ASSERT_GT(cache->num_entries(), 0) << name;
+    }
+    // The second reader found what the first one decompressed or decoded
+    ASSERT_GT(cache->hits(), 0) << name;
+    ASSERT_LE(cache->size(), cache->capacity());
+  }
+}
+
 TEST(TestFileReaderAdHoc, NationDictTruncatedDataPage) {
   // PARQUET-816. Some files generated by older Parquet implementations may
   // contain malformed data page metadata, and we can successfully decode them
@@ -681,11 +681,14 @@ TEST_F(TestSchemaDescriptor, BuildTree) {
   //     repeated int32 item3    3    2
   int16_t ex_max_def_levels[6] = {0, 1, 1, 2, 3, 3};
   int16_t ex_max_rep_levels[6] = {0, 0, 1, 1, 1, 2};
+  int16_t ex_repeated_ancestor_def_levels[6] = {0, 0, 1, 2, 2, 3};
 
   for (int i = 0; i < nleaves; ++i) {
     const ColumnDescriptor* col = descr_.Column(i);
     EXPECT_EQ(ex_max_def_levels[i], col->max_definition_level()) << i;
     EXPECT_EQ(ex_max_rep_levels[i], col->max_repetition_level()) << i;
+    EXPECT_EQ(ex_repeated_ancestor_def_levels[i], col->repeated_ancestor_def_level())
+        << i;
   }
 
   ASSERT_EQ(descr_.Column(0)->path()->ToDotString(), "a");
@@ -698,7 +701,11 @@ TEST_F(TestSchemaDescriptor, BuildTree) {
   for (int i = 0; i < nleaves; ++i) {
     auto col = descr_.Column(i);
     ASSERT_EQ(i, descr_.ColumnIndex(*col->schema_node()));
+    ASSERT_EQ(i, descr_.ColumnIndex(col->path()->ToDotString()));
+    // The path is built once per column
+    ASSERT_EQ(col->path().get(), col->path().get());
   }
+  ASSERT_EQ(-1, descr_.ColumnIndex("bag.records"));
 
   // Test non-column nodes find
   NodePtr non_column_alien = Int32("alien", Repetition::REQUIRED);  // other path
@@ -638,6 +638,9 @@ void SchemaDescriptor::Init(const NodePtr& schema) {
 
   group_node_ = static_cast<const GroupNode*>(schema_.get());
   leaves_.clear();
+  leaf_to_base_.clear();
+  leaf_to_idx_.clear();
+  node_to_leaf_idx_.clear();
 
   for (int i = 0; i < group_node_->field_count(); ++i) {
     BuildTree(group_node_->field(i), 0, 0, group_node_->field(i));
@@ -677,25 +680,43 @@ void SchemaDescriptor::BuildTree(const NodePtr& node, int16_t max_def_level,
     }
   } else {
     // Primitive node, append to leaves
-    leaves_.push_back(ColumnDescriptor(node, max_def_level, max_rep_level, this));
-    leaf_to_base_.emplace(static_cast<int>(leaves_.size()) - 1, base);
-    leaf_to_idx_.emplace(node->path()->ToDotString(),
-                         static_cast<int>(leaves_.size()) - 1);
+    leaves_.push_back(ColumnDescriptor(node, max_def_level, max_rep_level, this,
+                                       static_cast<int>(leaves_.size())));
+    const int idx = static_cast<int>(leaves_.size()) - 1;
+    leaf_to_base_.emplace(idx, base);
+    leaf_to_idx_.emplace(leaves_.back().path()->ToDotString(), idx);
+    node_to_leaf_idx_.emplace(node.get(), idx);
   }
 }
 
 ColumnDescriptor::ColumnDescriptor(const schema::NodePtr& node,
                                    int16_t max_definition_level,
                                    int16_t max_repetition_level,
-                                   const SchemaDescriptor* schema_descr)
+                                   const SchemaDescriptor* schema_descr,
+                                   int column_index)
     : node_(node),
       max_definition_level_(max_definition_level),
       max_repetition_level_(max_repetition_level),
-      schema_descr_(schema_descr) {
+      schema_descr_(schema_descr),
+      column_index_(column_index) {
   if (!node_->is_primitive()) {
     throw ParquetException("Must be a primitive type");
   }
   primitive_node_ = static_cast<const PrimitiveNode*>(node_.get());
+  // The tree of a schema does not change anymore, so its paths are built once
+  if (schema_descr_ != nullptr) {
+    path_ = primitive_node_->path();
+  }
+
+  // Every optional node below the innermost repeated one adds a level, the
+  // root of the schema does not count
+  repeated_ancestor_def_level_ = max_definition_level_;
+  for (const Node* node = node_.get(); node != nullptr && !node->is_repeated();
+       node = node->parent()) {
+    if (node->is_optional() && (node == node_.get() || node->parent() != nullptr)) {
+      --repeated_ancestor_def_level_;
+    }
+  }
 }
 
 bool ColumnDescriptor::Equals(const ColumnDescriptor& other) const {
@@ -719,14 +740,12 @@ int SchemaDescriptor::ColumnIndex(const std::string& node_path) const {
 }
 
 int SchemaDescriptor::ColumnIndex(const Node& node) const {
-  auto search = leaf_to_idx_.equal_range(node.path()->ToDotString());
-  for (auto it = search.first; it != search.second; ++it) {
-    const int idx = it->second;
-    if (&node == Column(idx)->schema_node().get()) {
-      return idx;
-    }
+  auto search = node_to_leaf_idx_.find(&node);
+  if (search == node_to_leaf_idx_.end()) {
+    // Not found
+    return -1;
   }
-  return -1;
+  return search->second;
 }
 
 const schema::Node* SchemaDescriptor::GetColumnRoot(int i) const {
@@ -751,6 +770,9 @@ int ColumnDescriptor::type_precision() const {
 int ColumnDescriptor::type_length() const { return primitive_node_->type_length(); }
 
 const std::shared_ptr<ColumnPath> ColumnDescriptor::path() const {
+  if (path_) {
+    return path_;
+  }
   return primitive_node_->path();
 }
 
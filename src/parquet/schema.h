@@ -333,7 +333,8 @@ class PARQUET_EXPORT ColumnDescriptor {
  public:
   ColumnDescriptor(const schema::NodePtr& node, int16_t max_definition_level,
                    int16_t max_repetition_level,
-                   const SchemaDescriptor* schema_descr = nullptr);
+                   const SchemaDescriptor* schema_descr = nullptr,
+                   int column_index = -1);
 
   bool Equals(const ColumnDescriptor& other) const;
 
@@ -341,6 +342,11 @@ class PARQUET_EXPORT ColumnDescriptor {
 
   int16_t max_repetition_level() const { return max_repetition_level_; }
 
+  // Definition level of the innermost repeated node of the path, 0 if there is
+  // none. The entries at or above it have a slot in the leaf values of
+  // a nested (e.g. Arrow) array, also the null ones.
+  int16_t repeated_ancestor_def_level() const { return repeated_ancestor_def_level_; }
+
   Type::type physical_type() const { return primitive_node_->physical_type(); }
 
   LogicalType::type logical_type() const { return primitive_node_->logical_type(); }
@@ -363,17 +369,28 @@ class PARQUET_EXPORT ColumnDescriptor {
 
   int type_scale() const;
 
+  // The SchemaDescriptor this column belongs to and its index in it, nullptr
+  // and -1 for descriptors that are not part of a schema
+  const SchemaDescriptor* schema_descr() const { return schema_descr_; }
+
+  int column_index() const { return column_index_; }
+
  private:
   schema::NodePtr node_;
   const schema::PrimitiveNode* primitive_node_;
 
   int16_t max_definition_level_;
   int16_t max_repetition_level_;
+  int16_t repeated_ancestor_def_level_;
 
   // When this descriptor is part of a real schema (and not being used for
   // testing purposes), maintain a link back to the parent SchemaDescriptor to
   // enable reverse graph traversals
   const SchemaDescriptor* schema_descr_;
+  int column_index_;
+
+  // The path of a column of a schema, shared by the callers of path()
+  std::shared_ptr<schema::ColumnPath> path_;
 };
 
 // Container for the converted Parquet schema with a computed information from
@@ -450,6 +467,9 @@ class PARQUET_EXPORT SchemaDescriptor {
 
   // Mapping between ColumnPath DotString to the leaf index
   std::unordered_multimap<std::string, int> leaf_to_idx_;
+
+  // Mapping between leaf nodes and their index
+  std::unordered_map<const schema::Node*, int> node_to_leaf_idx_;
 };
 
 }  // namespace parquet
@@ -0,0 +1,380 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "parquet/sorted_search.h"
+
+#include <functional>
+#include <memory>
+#include <sstream>
+#include <vector>
+
+#include "parquet/exception.h"
+#include "parquet/file_reader.h"
+#include "parquet/metadata.h"
+#include "parquet/page_index.h"
+#include "parquet/schema.h"
+#include "parquet/statistics.h"
+#include "parquet/util/comparison.h"
+
+namespace parquet {
+
+namespace {
+
+// Plain encoding of a value, as in the statistics
+template <typename DType>
+struct EncodedValue {
+  static std::string Get(const ColumnDescriptor* descr,
+                         const typename PredicateValue<DType>::type& value) {
+    return std::string(reinterpret_cast<const char*>(&value), sizeof(value));
+  }
+};
+
+template <>
+struct EncodedValue<ByteArrayType> {
+  static std::string Get(const ColumnDescriptor* descr, const std::string& value) {
+    return value;
+  }
+};
+
+template <>
+struct EncodedValue<FLBAType> {
+  static std::string Get(const ColumnDescriptor* descr, const std::string& value) {
+    if (static_cast<int>(value.size()) != descr->type_length()) {
+      throw ParquetException("Value does not have the length of the column type");
+    }
+    return value;
+  }
+};
+
+template <typename DType>
+bool TypedEncodedValuesInOrder(const ColumnDescriptor* descr, const std::string& a,
+                               const std::string& b) {
+  // Decodes a as the minimum and b as the maximum
+  TypedRowGroupStatistics<DType> values(descr, a, b, 0, 0, 0, true);
+  auto less = std::static_pointer_cast<CompareDefault<DType>>(Comparator::Make(descr));
+  return !(*less)(values.max(), values.min());
+}
+
+// Values of a row group or page
+struct Bounds {
+  bool null_only;
+  std::string min;
+  std::string max;
+};
+
+// Whether the plain-encoded value a sorts before b in the sort order of the
+// column
+bool EncodedLess(const ColumnDescriptor* descr, const std::string& a,
+                 const std::string& b) {
+  return !internal::EncodedValuesInOrder(descr, b, a);
+}
+
+// Where row groups or pages sorted by a column are relative to the values in
+// [lower, upper]
+class SortedRange {
+ public:
+  SortedRange(const ColumnDescriptor* descr, const SortingColumn& sorting_column,
+              const std::string& lower, const std::string& upper)
+      : descr_(descr), sorting_column_(sorting_column), lower_(lower), upper_(upper) {}
+
+  // -1 if all values precede the range, 1 if they all follow it, else 0
+  int Position(const Bounds& bounds) const {
+    if (bounds.null_only) {
+      return sorting_column_.nulls_first ? -1 : 1;
+    }
+    const bool below = Less(bounds.max, lower_);
+    const bool above = Less(upper_, bounds.min);
+    if (sorting_column_.descending) {
+      return above ? -1 : (below ? 1 : 0);
+    }
+    return below ? -1 : (above ? 1 : 0);
+  }
+
+ private:
+  bool Less(const std::string& a, const std::string& b) const {
+    return EncodedLess(descr_, a, b);
+  }
+
+  const ColumnDescriptor* descr_;
+  SortingColumn sorting_column_;
+  std::string lower_;
+  std::string upper_;
+};
+
+// Returns false if the bounds of item i are not known
+typedef std::function<bool(int, Bounds*)> BoundsGetter;
+
+// The items in [first, last) of the sorted items whose values can be in the
+// range, all of them if the bounds of an item on the search path are not known
+std::pair<int, int> Search(int num_items, const BoundsGetter& get_bounds,
+                           const SortedRange& range) {
+  Bounds bounds;
+  // First item that does not precede the range
+  int lo = 0;
+  int hi = num_items;
+  while (lo < hi) {
+    const int mid = lo + (hi - lo) / 2;
+    if (!get_bounds(mid, &bounds)) {
+      return std::make_pair(0, num_items);
+    }
+    if (range.Position(bounds) < 0) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  const int first = lo;
+  // First item that follows the range
+  hi = num_items;
+  while (lo < hi) {
+    const int mid = lo + (hi - lo) / 2;
+    if (!get_bounds(mid, &bounds)) {
+      return std::make_pair(0, num_items);
+    }
+    if (range.Position(bounds) <= 0) {
+      lo = mid + 1;
+    } else {
+      hi = mid;
+    }
+  }
+  return std::make_pair(first, lo);
+}
+
+template <typename DType>
+void CheckPhysicalType(const ColumnDescriptor* descr, int column_index) {
+  if (descr->physical_type() != DType::type_num) {
+    std::stringstream ss;
+    ss << "Search on column " << column_index << " compares with "
+       << TypeToString(DType::type_num) << " values, the column is "
+       << TypeToString(descr->physical_type());
+    throw ParquetException(ss.str());
+  }
+}
+
+// Whether the items follow each other in the order of the sorting column,
+// with the items that hold only nulls before or after all others
+bool BoundsInOrder(const ColumnDescriptor* descr, const SortingColumn& sorting_column,
+                   const std::vector<Bounds>& items) {
+  const Bounds* previous = nullptr;
+  bool trailing_nulls = false;
+  for (const Bounds& bounds : items) {
+    if (bounds.null_only) {
+      if (sorting_column.nulls_first && previous != nullptr) {
+        return false;
+      }
+      trailing_nulls = !sorting_column.nulls_first;
+      continue;
+    }
+    if (trailing_nulls) {
+      return false;
+    }
+    if (previous != nullptr && (sorting_column.descending
+                                    ? EncodedLess(descr, previous->min, bounds.max)
+                                    : EncodedLess(descr, bounds.min, previous->max))) {
+      return false;
+    }
+    previous = &bounds;
+  }
+  return true;
+}
+
+// Bounds of the column chunk of a row group, false if they are not known
+bool GetRowGroupBounds(const RowGroupMetaData& row_group, int column_index,
+                       Bounds* bounds) {
+  std::unique_ptr<ColumnChunkMetaData> column_chunk = row_group.ColumnChunk(column_index);
+  if (!column_chunk->is_stats_set()) {
+    return false;
+  }
+  std::shared_ptr<RowGroupStatistics> stats = column_chunk->statistics();
+  bounds->null_only = column_chunk->is_null_count_set() && stats->num_values() == 0 &&
+                      stats->null_count() > 0;
+  if (bounds->null_only) {
+    return true;
+  }
+  if (!stats->HasMinMax()) {
+    return false;
+  }
+  bounds->min = stats->EncodeMin();
+  bounds->max = stats->EncodeMax();
+  return true;
+}
+
+SortingColumn FirstSortingColumn(const RowGroupMetaData& row_group, int column_index) {
+  const std::vector<SortingColumn> sorting_columns = row_group.sorting_columns();
+  if (sorting_columns.empty() || sorting_columns[0].column_idx != column_index) {
+    std::stringstream ss;
+    ss << "The rows are not sorted by column " << column_index;
+    throw ParquetException(ss.str());
+  }
+  return sorting_columns[0];
+}
+
+}  // namespace
+
+namespace internal {
+
+bool EncodedValuesInOrder(const ColumnDescriptor* descr, const std::string& a,
+                          const std::string& b) {
+  switch (descr->physical_type()) {
+    case Type::BOOLEAN:
+      return TypedEncodedValuesInOrder<BooleanType>(descr, a, b);
+    case Type::INT32:
+      return TypedEncodedValuesInOrder<Int32Type>(descr, a, b);
+    case Type::INT64:
+      return TypedEncodedValuesInOrder<Int64Type>(descr, a, b);
+    case Type::INT96:
+      return TypedEncodedValuesInOrder<Int96Type>(descr, a, b);
+    case Type::FLOAT:
+      return TypedEncodedValuesInOrder<FloatType>(descr, a, b);
+    case Type::DOUBLE:
+      return TypedEncodedValuesInOrder<DoubleType>(descr, a, b);
+    case Type::BYTE_ARRAY:
+      return TypedEncodedValuesInOrder<ByteArrayType>(descr, a, b);
+    case Type::FIXED_LEN_BYTE_ARRAY:
+      return TypedEncodedValuesInOrder<FLBAType>(descr, a, b);
+  }
+  throw ParquetException("Can't compare values of the selected column type");
+}
+
+}  // namespace internal
+
+namespace sorted_search {
+
+template <typename DType>
+std::pair<int, int> FindRowGroups(const FileMetaData& metadata, int column_index,
+                                  const typename PredicateValue<DType>::type& lower,
+                                  const typename PredicateValue<DType>::type& upper) {
+  const int num_row_groups = metadata.num_row_groups();
+  if (num_row_groups == 0) {
+    return std::make_pair(0, 0);
+  }
+  const ColumnDescriptor* descr = metadata.schema()->Column(column_index);
+  CheckPhysicalType<DType>(descr, column_index);
+  const SortingColumn sorting_column =
+      FirstSortingColumn(*metadata.RowGroup(0), column_index);
+  if (descr->sort_order() == SortOrder::UNKNOWN) {
+    return std::make_pair(0, num_row_groups);
+  }
+
+  // The row groups can only be searched if they are all sorted by the column
+  // and follow each other in its order; files of other writers, or built with
+  // ParquetFileWriter::AppendRowGroups, may only sort the rows of each one
+  std::vector<Bounds> bounds(num_row_groups);
+  std::vector<bool> bounds_known(num_row_groups);
+  bool searchable = true;
+  for (int i = 0; i < num_row_groups; ++i) {
+    std::unique_ptr<RowGroupMetaData> row_group = metadata.RowGroup(i);
+    const std::vector<SortingColumn> sorting_columns = row_group->sorting_columns();
+    if (sorting_columns.empty() || sorting_columns[0].column_idx != column_index ||
+        sorting_columns[0].descending != sorting_column.descending ||
+        sorting_columns[0].nulls_first != sorting_column.nulls_first) {
+      searchable = false;
+    }
+    bounds_known[i] = GetRowGroupBounds(*row_group, column_index, &bounds[i]);
+    if (!bounds_known[i]) {
+      searchable = false;
+    }
+  }
+  searchable = searchable && BoundsInOrder(descr, sorting_column, bounds);
+
+  SortedRange range(descr, sorting_column, EncodedValue<DType>::Get(descr, lower),
+                    EncodedValue<DType>::Get(descr, upper));
+  if (searchable) {
+    auto get_bounds = [&bounds](int i, Bounds* out) {
+      *out = bounds[i];
+      return true;
+    };
+    return Search(num_row_groups, get_bounds, range);
+  }
+
+  // Scan all row groups for the first and last one that can hold values in
+  // the range
+  int first = -1;
+  int last = -1;
+  for (int i = 0; i < num_row_groups; ++i) {
+    if (!bounds_known[i] || range.Position(bounds[i]) == 0) {
+      if (first < 0) {
+        first = i;
+      }
+      last = i;
+    }
+  }
+  if (first < 0) {
+    return std::make_pair(0, 0);
+  }
+  return std::make_pair(first, last + 1);
+}
+
+template <typename DType>
+std::pair<int64_t, int64_t> FindRows(RowGroupReader* row_group, int column_index,
+                                     const typename PredicateValue<DType>::type& lower,
+                                     const typename PredicateValue<DType>::type& upper) {
+  const RowGroupMetaData* metadata = row_group->metadata();
+  const int64_t num_rows = metadata->num_rows();
+  const ColumnDescriptor* descr = metadata->schema()->Column(column_index);
+  CheckPhysicalType<DType>(descr, column_index);
+  const SortingColumn sorting_column = FirstSortingColumn(*metadata, column_index);
+
+  std::unique_ptr<ColumnIndex> pages = row_group->GetColumnIndex(column_index);
+  std::unique_ptr<OffsetIndex> offset_index = row_group->GetOffsetIndex(column_index);
+  if (pages == nullptr || offset_index == nullptr ||
+      pages->num_pages() != offset_index->num_pages() ||
+      descr->sort_order() == SortOrder::UNKNOWN) {
+    return std::make_pair(static_cast<int64_t>(0), num_rows);
+  }
+
+  SortedRange range(descr, sorting_column, EncodedValue<DType>::Get(descr, lower),
+                    EncodedValue<DType>::Get(descr, upper));
+  const ColumnIndex& column_index_ref = *pages;
+  auto get_bounds = [&column_index_ref](int i, Bounds* bounds) {
+    bounds->null_only = column_index_ref.null_pages()[i];
+    bounds->min = column_index_ref.encoded_min_values()[i];
+    bounds->max = column_index_ref.encoded_max_values()[i];
+    return true;
+  };
+  const std::pair<int, int> found = Search(pages->num_pages(), get_bounds, range);
+
+  const std::vector<PageLocation>& locations = offset_index->page_locations();
+  auto first_row = [&locations, num_rows](int page) {
+    return page < static_cast<int>(locations.size()) ? locations[page].first_row_index
+                                                     : num_rows;
+  };
+  return std::make_pair(first_row(found.first), first_row(found.second));
+}
+
+#define SORTED_SEARCH_INSTANTIATE(DType)                                       \
+  template std::pair<int, int> FindRowGroups<DType>(                           \
+      const FileMetaData&, int, const PredicateValue<DType>::type&,            \
+      const PredicateValue<DType>::type&);                                     \
+  template std::pair<int64_t, int64_t> FindRows<DType>(                        \
+      RowGroupReader*, int, const PredicateValue<DType>::type&,                \
+      const PredicateValue<DType>::type&)
+
+SORTED_SEARCH_INSTANTIATE(BooleanType);
+SORTED_SEARCH_INSTANTIATE(Int32Type);
+SORTED_SEARCH_INSTANTIATE(Int64Type);
+SORTED_SEARCH_INSTANTIATE(Int96Type);
+SORTED_SEARCH_INSTANTIATE(FloatType);
+SORTED_SEARCH_INSTANTIATE(DoubleType);
+SORTED_SEARCH_INSTANTIATE(ByteArrayType);
+SORTED_SEARCH_INSTANTIATE(FLBAType);
+
+#undef SORTED_SEARCH_INSTANTIATE
+
+}  // namespace sorted_search
+
+}  // namespace parquet
@@ -0,0 +1,86 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef PARQUET_SORTED_SEARCH_H
+#define PARQUET_SORTED_SEARCH_H
+
+#include <cstdint>
+#include <string>
+#include <utility>
+
+#include "parquet/predicate.h"
+#include "parquet/types.h"
+#include "parquet/util/visibility.h"
+
+namespace parquet {
+
+class ColumnDescriptor;
+class FileMetaData;
+class RowGroupReader;
+
+// Search for a range of values of a column that the rows are sorted by,
+// see RowGroupMetaData::sorting_columns. Instead of checking the statistics
+// of every row group or page, as Predicate does, the row groups and pages
+// are found by binary search over their statistics.
+//
+// The values are in the column's sort order, DType must be the physical type
+// of the column, see PredicateValue. Nulls are never in the range.
+namespace sorted_search {
+
+/// \brief Row groups that can hold values of the column in [lower, upper].
+///
+/// The column must be the first sorting column of the first row group. The
+/// row groups are binary searched if they all declare it and their statistics
+/// show that they follow each other in its order, as checked by the writer
+/// with WriterProperties::Builder::enable_sorting_validation. Otherwise the
+/// statistics of every row group are checked.
+/// \return the range [first, last) of row group indices that includes every
+/// row group that can hold values in the range
+template <typename DType>
+PARQUET_EXPORT std::pair<int, int> FindRowGroups(
+    const FileMetaData& metadata, int column_index,
+    const typename PredicateValue<DType>::type& lower,
+    const typename PredicateValue<DType>::type& upper);
+
+/// \brief Rows of a row group sorted by the column that can hold values in
+/// [lower, upper], found with the page index of the column chunk.
+///
+/// The rows can be read with RowGroupReader::GetColumnPageReader(i, begin,
+/// end, ...); rows at the beginning and the end of the range may still hold
+/// values outside of it.
+/// \return the range [begin, end) of row group-relative rows, all rows if the
+/// column chunk has no page index
+template <typename DType>
+PARQUET_EXPORT std::pair<int64_t, int64_t> FindRows(
+    RowGroupReader* row_group, int column_index,
+    const typename PredicateValue<DType>::type& lower,
+    const typename PredicateValue<DType>::type& upper);
+
+}  // namespace sorted_search
+
+namespace internal {
+
+// Whether the plain-encoded value a sorts before b or is equal to it in the
+// sort order of the column
+PARQUET_EXPORT bool EncodedValuesInOrder(const ColumnDescriptor* descr,
+                                         const std::string& a, const std::string& b);
+
+}  // namespace internal
+
+}  // namespace parquet
+
+#endif  // PARQUET_SORTED_SEARCH_H
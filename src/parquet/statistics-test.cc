@@ -22,6 +22,7 @@
 #include <cstdint>
 #include <cstring>
 #include <memory>
+#include <string>
 #include <vector>
 
 #include "parquet/column_reader.h"
@@ -778,5 +779,85 @@ TEST(TestStatisticsDoubleNaN, NaNValues) {
   ASSERT_EQ(min, -3.0);
   ASSERT_EQ(max, 4.0);
 }
+
+TEST(TestStatisticsByteArray, UpdateBinary) {
+  NodePtr node = PrimitiveNode::Make("string", Repetition::OPTIONAL, Type::BYTE_ARRAY,
+                                     LogicalType::UTF8);
+  ColumnDescriptor descr(node, 1, 0);
+  // "c", "a", null, "b", "d", the null entry has a value that is not counted
+  const std::string data = "cazzzbd";
+  const int32_t offsets[] = {0, 1, 2, 5, 6, 7};
+  std::vector<uint8_t> valid_bits(1, 255);
+  BitUtil::ClearBit(valid_bits.data(), 2);
+
+  TypedRowGroupStatistics<ByteArrayType> stats(&descr);
+  stats.UpdateBinary(offsets, reinterpret_cast<const uint8_t*>(data.data()),
+                     valid_bits.data(), 0, 5, 4, 1);
+  ASSERT_TRUE(stats.HasMinMax());
+  ASSERT_EQ("a", ByteArrayToString(stats.min()));
+  ASSERT_EQ("d", ByteArrayToString(stats.max()));
+  ASSERT_EQ(1, stats.null_count());
+  ASSERT_EQ(4, stats.num_values());
+
+  // All the values are present without a bitmap
+  TypedRowGroupStatistics<ByteArrayType> dense_stats(&descr);
+  dense_stats.UpdateBinary(offsets, reinterpret_cast<const uint8_t*>(data.data()),
+                           nullptr, 0, 5, 5, 0);
+  ASSERT_EQ("zzz", ByteArrayToString(dense_stats.max()));
+}
+
+// Statistics of BYTE_ARRAY values that point into strings
+static void UpdateWithStrings(const std::vector<std::string>& strings,
+                              TypedRowGroupStatistics<ByteArrayType>* stats) {
+  std::vector<ByteArray> values;
+  for (const auto& string : strings) {
+    values.emplace_back(static_cast<uint32_t>(string.size()),
+                        reinterpret_cast<const uint8_t*>(string.data()));
+  }
+  stats->Update(values.data(), static_cast<int64_t>(values.size()), 0);
+}
+
+TEST(TestStatisticsByteArray, TruncateMinMax) {
+  NodePtr node = PrimitiveNode::Make("url", Repetition::REQUIRED, Type::BYTE_ARRAY,
+                                     LogicalType::UTF8);
+  ColumnDescriptor descr(node, 0, 0);
+  const std::vector<std::string> urls = {"http://z.example.com/\xff", "https",
+                                         "http://a.example.com/first"};
+  TypedRowGroupStatistics<ByteArrayType> stats(&descr);
+  stats.SetTruncateLength(8);
+  UpdateWithStrings(urls, &stats);
+  // The values are kept whole, only their encoding is truncated
+  ASSERT_EQ(urls[2], ByteArrayToString(stats.min()));
+  ASSERT_EQ(urls[0], ByteArrayToString(stats.max()));
+  ASSERT_EQ("http://a", stats.EncodeMin());
+  ASSERT_EQ("http://{", stats.EncodeMax());
+
+  // Short values and a prefix of 0xFF bytes are not truncated
+  const std::vector<std::string> all_ff = {"ab", std::string(10, '\xff')};
+  TypedRowGroupStatistics<ByteArrayType> ff_stats(&descr);
+  ff_stats.SetTruncateLength(4);
+  UpdateWithStrings(all_ff, &ff_stats);
+  ASSERT_EQ("ab", ff_stats.EncodeMin());
+  ASSERT_EQ(all_ff[1], ff_stats.EncodeMax());
+
+  // The last byte of the prefix that is not 0xFF is incremented
+  const std::vector<std::string> carry = {"ab\xff\xff\xffz"};
+  TypedRowGroupStatistics<ByteArrayType> carry_stats(&descr);
+  carry_stats.SetTruncateLength(4);
+  UpdateWithStrings(carry, &carry_stats);
+  ASSERT_EQ("ab\xff\xff", carry_stats.EncodeMin());
+  ASSERT_EQ("ac", carry_stats.EncodeMax());
+
+  // The bytes are compared as unsigned, a batch that does not move the bounds
+  // leaves them as they are
+  const std::vector<std::string> bytes = {"\x80", "a", ""};
+  const std::vector<std::string> inner = {"b"};
+  TypedRowGroupStatistics<ByteArrayType> unsigned_stats(&descr);
+  UpdateWithStrings(bytes, &unsigned_stats);
+  UpdateWithStrings(inner, &unsigned_stats);
+  ASSERT_EQ("", ByteArrayToString(unsigned_stats.min()));
+  ASSERT_EQ("\x80", ByteArrayToString(unsigned_stats.max()));
+}
+
 }  // namespace test
 }  // namespace parquet
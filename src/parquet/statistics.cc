@@ -23,6 +23,7 @@
 #include "parquet/exception.h"
 #include "parquet/statistics.h"
 #include "parquet/util/memory.h"
+#include "parquet/util/minmax.h"
 
 using arrow::MemoryPool;
 using arrow::default_memory_pool;
@@ -89,6 +90,7 @@ template <typename DType>
 void TypedRowGroupStatistics<DType>::SetComparator() {
   comparator_ =
       std::static_pointer_cast<CompareDefault<DType> >(Comparator::Make(descr_));
+  unsigned_order_ = descr_->sort_order() == SortOrder::UNSIGNED;
 }
 
 template <typename DType>
@@ -97,6 +99,45 @@ void TypedRowGroupStatistics<DType>::Reset() {
   has_min_max_ = false;
 }
 
+// Order of the values of a column, through its comparator
+template <typename DType>
+struct StatsLess {
+  typedef typename DType::c_type T;
+
+  StatsLess(CompareDefault<DType>* comparator, bool is_unsigned)
+      : comparator(comparator) {}
+
+  bool operator()(const T& a, const T& b) const { return (*comparator)(a, b); }
+
+  CompareDefault<DType>* comparator;
+};
+
+// BYTE_ARRAY values are compared inline rather than with a virtual call per
+// comparison
+template <>
+struct StatsLess<ByteArrayType> {
+  StatsLess(CompareDefault<ByteArrayType>* comparator, bool is_unsigned)
+      : is_unsigned(is_unsigned) {}
+
+  bool operator()(const ByteArray& a, const ByteArray& b) const {
+    const uint32_t length = std::min(a.len, b.len);
+    if (is_unsigned) {
+      const int cmp = length == 0 ? 0 : memcmp(a.ptr, b.ptr, length);
+      return cmp < 0 || (cmp == 0 && a.len < b.len);
+    }
+    for (uint32_t i = 0; i < length; ++i) {
+      const int8_t a_byte = static_cast<int8_t>(a.ptr[i]);
+      const int8_t b_byte = static_cast<int8_t>(b.ptr[i]);
+      if (a_byte != b_byte) {
+        return a_byte < b_byte;
+      }
+    }
+    return a.len < b.len;
+  }
+
+  bool is_unsigned;
+};
+
 template <typename DType>
 inline void TypedRowGroupStatistics<DType>::SetMinMax(const T& min, const T& max) {
   if (!has_min_max_) {
@@ -104,8 +145,15 @@ inline void TypedRowGroupStatistics<DType>::SetMinMax(const T& min, const T& max
     Copy(min, &min_, min_buffer_.get());
     Copy(max, &max_, max_buffer_.get());
   } else {
-    Copy(std::min(min_, min, std::ref(*(this->comparator_))), &min_, min_buffer_.get());
-    Copy(std::max(max_, max, std::ref(*(this->comparator_))), &max_, max_buffer_.get());
+    // The batch's candidates still point into it, they are only copied if
+    // they move the bounds
+    StatsLess<DType> less(comparator_.get(), unsigned_order_);
+    if (less(min, min_)) {
+      Copy(min, &min_, min_buffer_.get());
+    }
+    if (less(max_, max)) {
+      Copy(max, &max_, max_buffer_.get());
+    }
   }
 }
 
@@ -143,6 +191,30 @@ struct StatsHelper<T, typename std::enable_if<std::is_floating_point<T>::value>:
   inline bool IsNaN(const T value) { return std::isnan(value); }
 };
 
+// INT32, INT64, FLOAT and DOUBLE values go through the kernels of
+// util/minmax.h instead of the comparator
+template <typename T, typename Enable = void>
+struct MinMaxKernel {
+  static constexpr bool enabled = false;
+
+  static bool MinMax(const T* values, int64_t length, const uint8_t* valid_bits,
+                     int64_t valid_bits_offset, bool is_unsigned, T* min, T* max) {
+    return false;
+  }
+};
+
+template <typename T>
+struct MinMaxKernel<T, typename std::enable_if<std::is_arithmetic<T>::value &&
+                                               !std::is_same<T, bool>::value>::type> {
+  static constexpr bool enabled = true;
+
+  static bool MinMax(const T* values, int64_t length, const uint8_t* valid_bits,
+                     int64_t valid_bits_offset, bool is_unsigned, T* min, T* max) {
+    return internal::MinMax(values, length, valid_bits, valid_bits_offset, is_unsigned,
+                            min, max);
+  }
+};
+
 template <typename T>
 void SetNaN(T* value) {
   // no-op
@@ -158,6 +230,23 @@ void SetNaN<double>(double* value) {
   *value = std::nan("");
 }
 
+template <typename DType>
+void TypedRowGroupStatistics<DType>::UpdateWithKernel(const T* values, int64_t length,
+                                                      const uint8_t* valid_bits,
+                                                      int64_t valid_bits_offset) {
+  T min = T();
+  T max = T();
+  if (MinMaxKernel<T>::MinMax(values, length, valid_bits, valid_bits_offset,
+                              unsigned_order_, &min, &max)) {
+    SetMinMax(min, max);
+  } else if (!has_min_max_) {
+    // PARQUET-1225: all values are NaN. Don't set has_min_max flag since
+    // these values must be over-written by valid stats later
+    SetNaN(&min_);
+    SetNaN(&max_);
+  }
+}
+
 template <typename DType>
 void TypedRowGroupStatistics<DType>::Update(const T* values, int64_t num_not_null,
                                             int64_t num_null) {
@@ -169,6 +258,11 @@ void TypedRowGroupStatistics<DType>::Update(const T* values, int64_t num_not_nul
   // TODO: support distinct count?
   if (num_not_null == 0) return;
 
+  if (MinMaxKernel<T>::enabled) {
+    UpdateWithKernel(values, num_not_null, nullptr, 0);
+    return;
+  }
+
   // PARQUET-1225: Handle NaNs
   // The problem arises only if the starting/ending value(s)
   // of the values-buffer contain NaN
@@ -188,8 +282,9 @@ void TypedRowGroupStatistics<DType>::Update(const T* values, int64_t num_not_nul
     return;
   }
 
-  auto batch_minmax = std::minmax_element(values + begin_offset, values + end_offset,
-                                          std::ref(*(this->comparator_)));
+  auto batch_minmax =
+      std::minmax_element(values + begin_offset, values + end_offset,
+                          StatsLess<DType>(comparator_.get(), unsigned_order_));
 
   SetMinMax(*batch_minmax.first, *batch_minmax.second);
 }
@@ -208,6 +303,11 @@ void TypedRowGroupStatistics<DType>::UpdateSpaced(const T* values,
   // TODO: support distinct count?
   if (num_not_null == 0) return;
 
+  if (MinMaxKernel<T>::enabled) {
+    UpdateWithKernel(values, num_null + num_not_null, valid_bits, valid_bits_offset);
+    return;
+  }
+
   // Find first valid entry and use that for min/max
   // As (num_not_null != 0) there must be one
   int64_t length = num_null + num_not_null;
@@ -234,13 +334,14 @@ void TypedRowGroupStatistics<DType>::UpdateSpaced(const T* values,
     return;
   }
 
+  StatsLess<DType> less(comparator_.get(), unsigned_order_);
   T min = values[i];
   T max = values[i];
   for (; i < length; i++) {
     if (valid_bits_reader.IsSet()) {
-      if ((std::ref(*(this->comparator_)))(values[i], min)) {
+      if (less(values[i], min)) {
         min = values[i];
-      } else if ((std::ref(*(this->comparator_)))(max, values[i])) {
+      } else if (less(max, values[i])) {
         max = values[i];
       }
     }
@@ -250,6 +351,72 @@ void TypedRowGroupStatistics<DType>::UpdateSpaced(const T* values,
   SetMinMax(min, max);
 }
 
+template <>
+void TypedRowGroupStatistics<ByteArrayType>::UpdateBinary(
+    const int32_t* offsets, const uint8_t* data, const uint8_t* valid_bits,
+    int64_t valid_bits_offset, int64_t length, int64_t num_not_null, int64_t num_null) {
+  DCHECK(num_not_null >= 0);
+  DCHECK(num_null >= 0);
+
+  IncrementNullCount(num_null);
+  IncrementNumValues(num_not_null);
+  if (num_not_null == 0) return;
+
+  StatsLess<ByteArrayType> less(comparator_.get(), unsigned_order_);
+  bool has_value = false;
+  ByteArray min, max;
+  for (int64_t i = 0; i < length; i++) {
+    if (valid_bits != nullptr && !BitUtil::GetBit(valid_bits, valid_bits_offset + i)) {
+      continue;
+    }
+    // The values are compared in place
+    const ByteArray value(static_cast<uint32_t>(offsets[i + 1] - offsets[i]),
+                          data + offsets[i]);
+    if (!has_value) {
+      has_value = true;
+      min = value;
+      max = value;
+    } else if (less(value, min)) {
+      min = value;
+    } else if (less(max, value)) {
+      max = value;
+    }
+  }
+  if (has_value) {
+    SetMinMax(min, max);
+  }
+}
+
+template <>
+void TypedRowGroupStatistics<BooleanType>::UpdateBitmap(
+    const uint8_t* bits, int64_t bits_offset, const uint8_t* valid_bits,
+    int64_t valid_bits_offset, int64_t length, int64_t num_not_null, int64_t num_null) {
+  DCHECK(num_not_null >= 0);
+  DCHECK(num_null >= 0);
+
+  IncrementNullCount(num_null);
+  IncrementNumValues(num_not_null);
+  if (num_not_null == 0) return;
+
+  // There are only two values, stop at the first occurrence of both
+  bool has_false = false;
+  bool has_true = false;
+  ::arrow::internal::BitmapReader bits_reader(bits, bits_offset, length);
+  for (int64_t i = 0; i < length && !(has_false && has_true); i++, bits_reader.Next()) {
+    if (valid_bits != nullptr && !BitUtil::GetBit(valid_bits, valid_bits_offset + i)) {
+      continue;
+    }
+    if (bits_reader.IsSet()) {
+      has_true = true;
+    } else {
+      has_false = true;
+    }
+  }
+  if (has_false || has_true) {
+    SetMinMax(!has_false, has_true);
+  }
+}
+
 template <typename DType>
 const typename DType::c_type& TypedRowGroupStatistics<DType>::min() const {
   return min_;
@@ -269,10 +436,19 @@ void TypedRowGroupStatistics<DType>::Merge(const TypedRowGroupStatistics<DType>&
   SetMinMax(other.min_, other.max_);
 }
 
+template <typename DType>
+bool TypedRowGroupStatistics<DType>::TruncatesMinMax() const {
+  return DType::type_num == Type::BYTE_ARRAY && truncate_length_ > 0 && unsigned_order_;
+}
+
 template <typename DType>
 std::string TypedRowGroupStatistics<DType>::EncodeMin() {
   std::string s;
   if (HasMinMax()) this->PlainEncode(min_, &s);
+  // A prefix is never greater than the value
+  if (TruncatesMinMax() && static_cast<int64_t>(s.size()) > truncate_length_) {
+    s.resize(static_cast<size_t>(truncate_length_));
+  }
   return s;
 }
 
@@ -280,6 +456,18 @@ template <typename DType>
 std::string TypedRowGroupStatistics<DType>::EncodeMax() {
   std::string s;
   if (HasMinMax()) this->PlainEncode(max_, &s);
+  if (TruncatesMinMax() && static_cast<int64_t>(s.size()) > truncate_length_) {
+    // The prefix with its last byte below 0xFF incremented is greater than the
+    // value. A prefix of only 0xFF bytes has no such bound and is kept whole.
+    for (auto i = static_cast<size_t>(truncate_length_); i > 0; --i) {
+      const auto byte = static_cast<uint8_t>(s[i - 1]);
+      if (byte != 0xFF) {
+        s[i - 1] = static_cast<char>(byte + 1);
+        s.resize(i);
+        break;
+      }
+    }
+  }
   return s;
 }
 
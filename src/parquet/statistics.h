@@ -159,7 +159,22 @@ class TypedRowGroupStatistics : public RowGroupStatistics {
   void Update(const T* values, int64_t num_not_null, int64_t num_null);
   void UpdateSpaced(const T* values, const uint8_t* valid_bits, int64_t valid_bits_spaced,
                     int64_t num_not_null, int64_t num_null);
+  // BYTE_ARRAY only: update with length values in Arrow's binary layout, value
+  // i is data[offsets[i]:offsets[i + 1]]. A nullptr valid_bits marks all of
+  // them as present.
+  void UpdateBinary(const int32_t* offsets, const uint8_t* data,
+                    const uint8_t* valid_bits, int64_t valid_bits_offset, int64_t length,
+                    int64_t num_not_null, int64_t num_null);
+  // BOOLEAN only: update with the length values of the bitmap bits from bit
+  // bits_offset on. A nullptr valid_bits marks all of them as present.
+  void UpdateBitmap(const uint8_t* bits, int64_t bits_offset, const uint8_t* valid_bits,
+                    int64_t valid_bits_offset, int64_t length, int64_t num_not_null,
+                    int64_t num_null);
   void SetMinMax(const T& min, const T& max);
+  // BYTE_ARRAY with an unsigned sort order only: encode the min and max as
+  // bounds of at most length bytes, 0 encodes the whole values. min() and
+  // max() keep the whole values.
+  void SetTruncateLength(int64_t length) { truncate_length_ = length; }
 
   const T& min() const;
   const T& max() const;
@@ -174,7 +189,15 @@ class TypedRowGroupStatistics : public RowGroupStatistics {
   T max_;
   ::arrow::MemoryPool* pool_;
   std::shared_ptr<CompareDefault<DType> > comparator_;
-
+  // The column's sort order is UNSIGNED, used by the numeric min/max kernels
+  bool unsigned_order_ = false;
+  int64_t truncate_length_ = 0;
+
+  // Update min and max with the kernels of util/minmax.h, only used for the
+  // numeric types
+  void UpdateWithKernel(const T* values, int64_t length, const uint8_t* valid_bits,
+                        int64_t valid_bits_offset);
+  bool TruncatesMinMax() const;
   void PlainEncode(const T& src, std::string* dst);
   void PlainDecode(const std::string& src, T* dst);
   void Copy(const T& src, T* dst, PoolBuffer* buffer);
@@ -213,6 +236,16 @@ void TypedRowGroupStatistics<ByteArrayType>::PlainEncode(const T& src, std::stri
 template <>
 void TypedRowGroupStatistics<ByteArrayType>::PlainDecode(const std::string& src, T* dst);
 
+template <>
+void TypedRowGroupStatistics<ByteArrayType>::UpdateBinary(
+    const int32_t* offsets, const uint8_t* data, const uint8_t* valid_bits,
+    int64_t valid_bits_offset, int64_t length, int64_t num_not_null, int64_t num_null);
+
+template <>
+void TypedRowGroupStatistics<BooleanType>::UpdateBitmap(
+    const uint8_t* bits, int64_t bits_offset, const uint8_t* valid_bits,
+    int64_t valid_bits_offset, int64_t length, int64_t num_not_null, int64_t num_null);
+
 typedef TypedRowGroupStatistics<BooleanType> BoolStatistics;
 typedef TypedRowGroupStatistics<Int32Type> Int32Statistics;
 typedef TypedRowGroupStatistics<Int64Type> Int64Statistics;
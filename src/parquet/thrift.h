@@ -18,7 +18,10 @@
 #ifndef PARQUET_THRIFT_UTIL_H
 #define PARQUET_THRIFT_UTIL_H
 
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
+#include <memory>
 // Check if thrift version < 0.11.0
 // or if FORCE_BOOST_SMART_PTR is defined. Ref: https://thrift.apache.org/lib/cpp
 #if defined(PARQUET_THRIFT_USE_BOOST) || defined(FORCE_BOOST_SMART_PTR)
@@ -36,7 +39,10 @@
 
 #include <thrift/protocol/TBinaryProtocol.h>
 #include <thrift/transport/TBufferTransports.h>
+#include <thrift/transport/TVirtualTransport.h>
 #include <sstream>
+#include <string>
+#include <vector>
 
 #include "parquet/exception.h"
 #include "parquet/parquet_types.h"
@@ -126,6 +132,222 @@ inline void DeserializeThriftMsg(const uint8_t* buf, uint32_t* len, T* deseriali
   *len = *len - bytes_left;
 }
 
+// Range [begin, end) of the bytes of a serialized thrift message
+struct ThriftByteRange {
+  uint32_t begin;
+  uint32_t end;
+};
+
+typedef apache::thrift::protocol::TCompactProtocolT<
+    apache::thrift::transport::TMemoryBuffer>
+    ThriftCompactProtocol;
+
+// Read the header of a list and skip its elements, appending their ranges to
+// elements if it is not null. Returns the number of elements.
+inline uint32_t SkipThriftList(ThriftCompactProtocol* tproto,
+                               apache::thrift::transport::TMemoryBuffer* tmem_transport,
+                               uint32_t len, std::vector<ThriftByteRange>* elements) {
+  apache::thrift::protocol::TType element_type;
+  uint32_t size;
+  tproto->readListBegin(element_type, size);
+  for (uint32_t i = 0; i < size; ++i) {
+    const uint32_t begin = len - tmem_transport->available_read();
+    apache::thrift::protocol::skip(*tproto, element_type);
+    if (elements != nullptr) {
+      elements->push_back({begin, len - tmem_transport->available_read()});
+    }
+  }
+  tproto->readListEnd();
+  return size;
+}
+
+// Locate the list in field field_id of the thrift struct serialized in
+// buf/len without deserializing the struct. list is set to the range of the
+// list including its header, the ranges of its elements are appended to
+// elements if it is not null. Returns the number of elements.
+inline uint32_t FindThriftListField(const uint8_t* buf, uint32_t len, int16_t field_id,
+                                    ThriftByteRange* list,
+                                    std::vector<ThriftByteRange>* elements) {
+  shared_ptr<apache::thrift::transport::TMemoryBuffer> tmem_transport(
+      new apache::thrift::transport::TMemoryBuffer(const_cast<uint8_t*>(buf), len));
+  ThriftCompactProtocol tproto(tmem_transport);
+  try {
+    std::string name;
+    apache::thrift::protocol::TType field_type;
+    int16_t id;
+    tproto.readStructBegin(name);
+    while (true) {
+      tproto.readFieldBegin(name, field_type, id);
+      if (field_type == apache::thrift::protocol::T_STOP) {
+        break;
+      }
+      if (id == field_id && field_type == apache::thrift::protocol::T_LIST) {
+        list->begin = len - tmem_transport->available_read();
+        uint32_t size = SkipThriftList(&tproto, tmem_transport.get(), len, elements);
+        list->end = len - tmem_transport->available_read();
+        return size;
+      }
+      apache::thrift::protocol::skip(tproto, field_type);
+      tproto.readFieldEnd();
+    }
+  } catch (std::exception& e) {
+    std::stringstream ss;
+    ss << "Couldn't deserialize thrift: " << e.what() << "\n";
+    throw ParquetException(ss.str());
+  }
+  std::stringstream ss;
+  ss << "Couldn't deserialize thrift: no list in field " << field_id << "\n";
+  throw ParquetException(ss.str());
+}
+
+// Append the ranges of the elements of the thrift list serialized in buf/len
+// to elements. Returns the number of elements.
+inline uint32_t FindThriftListElements(const uint8_t* buf, uint32_t len,
+                                       std::vector<ThriftByteRange>* elements) {
+  shared_ptr<apache::thrift::transport::TMemoryBuffer> tmem_transport(
+      new apache::thrift::transport::TMemoryBuffer(const_cast<uint8_t*>(buf), len));
+  ThriftCompactProtocol tproto(tmem_transport);
+  try {
+    return SkipThriftList(&tproto, tmem_transport.get(), len, elements);
+  } catch (std::exception& e) {
+    std::stringstream ss;
+    ss << "Couldn't deserialize thrift: " << e.what() << "\n";
+    throw ParquetException(ss.str());
+  }
+}
+
+// Copy of the message serialized in buf/len in which the list of structs in
+// range list is replaced by an empty list, for deserializing the message
+// without the elements of that list
+inline std::string WithoutThriftListElements(const uint8_t* buf, uint32_t len,
+                                             ThriftByteRange list) {
+  std::string result(reinterpret_cast<const char*>(buf), list.begin);
+  // Compact protocol list header with a size of 0 and struct elements
+  result.push_back(static_cast<char>(0x0C));
+  result.append(reinterpret_cast<const char*>(buf) + list.end, len - list.end);
+  return result;
+}
+
+// Thrift transport over the bytes at the position of an InputStream, which is
+// not advanced. The bytes are peeked at in a window that doubles, up to a
+// maximum size, whenever the message being read does not fit into it.
+class ThriftPeekTransport
+    : public apache::thrift::transport::TVirtualTransport<ThriftPeekTransport> {
+ public:
+  // Start reading at the position of stream. Returns false at its end
+  bool Reset(InputStream* stream, uint32_t peek_size, uint32_t max_size) {
+    stream_ = stream;
+    max_size_ = max_size;
+    peek_size_ = std::min(peek_size, max_size);
+    position_ = 0;
+    exceeded_max_size_ = false;
+    Peek();
+    return available_ > 0;
+  }
+
+  uint32_t read(uint8_t* buf, uint32_t len) {
+    if (!Fill(len)) {
+      throw apache::thrift::transport::TTransportException(
+          apache::thrift::transport::TTransportException::END_OF_FILE,
+          exceeded_max_size_ ? "Message exceeds the maximum size"
+                             : "No more data to read");
+    }
+    memcpy(buf, data_ + position_, len);
+    position_ += len;
+    return len;
+  }
+
+  const uint8_t* borrow(uint8_t* buf, uint32_t* len) {
+    if (!Fill(*len)) {
+      return nullptr;
+    }
+    *len = available_ - position_;
+    return data_ + position_;
+  }
+
+  void consume(uint32_t len) { position_ += len; }
+
+  // Number of bytes read so far
+  uint32_t position() const { return position_; }
+
+  // True if the message did not fit into the maximum size
+  bool exceeded_max_size() const { return exceeded_max_size_; }
+
+ private:
+  void Peek() {
+    int64_t bytes_available = 0;
+    data_ = stream_->Peek(peek_size_, &bytes_available);
+    available_ = static_cast<uint32_t>(bytes_available);
+  }
+
+  // Grow the window until len bytes from position_ on are in it. False at the
+  // end of the stream or at the maximum size
+  bool Fill(uint32_t len) {
+    while (static_cast<uint64_t>(position_) + len > available_) {
+      if (available_ < peek_size_) {
+        return false;
+      }
+      if (peek_size_ >= max_size_) {
+        exceeded_max_size_ = true;
+        return false;
+      }
+      peek_size_ = peek_size_ > max_size_ / 2 ? max_size_ : peek_size_ * 2;
+      Peek();
+    }
+    return true;
+  }
+
+  InputStream* stream_ = nullptr;
+  const uint8_t* data_ = nullptr;
+  uint32_t available_ = 0;
+  uint32_t peek_size_ = 0;
+  uint32_t max_size_ = 0;
+  uint32_t position_ = 0;
+  bool exceeded_max_size_ = false;
+};
+
+// Deserializes thrift messages straight from an InputStream. The transport
+// and protocol are kept across messages, so there is no allocation per message
+// besides the ones of the message itself.
+class ThriftStreamDeserializer {
+ public:
+  ThriftStreamDeserializer() : transport_(new ThriftPeekTransport()) { ResetProtocol(); }
+
+  // Deserialize the message at the position of stream into msg, peeking at
+  // peek_size bytes at first and at up to max_size bytes if it is larger.
+  // Returns the size of the message, 0 at the end of the stream. The stream
+  // is not advanced.
+  template <class T>
+  uint32_t Deserialize(InputStream* stream, uint32_t peek_size, uint32_t max_size,
+                       T* msg) {
+    if (!transport_->Reset(stream, peek_size, max_size)) {
+      return 0;
+    }
+    try {
+      msg->read(protocol_.get());
+    } catch (std::exception& e) {
+      // The protocol may be left in the middle of a struct
+      ResetProtocol();
+      std::stringstream ss;
+      ss << "Couldn't deserialize thrift: " << e.what() << "\n";
+      if (transport_->exceeded_max_size()) {
+        ss << "The message is larger than " << max_size << " bytes.\n";
+      }
+      throw ParquetException(ss.str());
+    }
+    return transport_->position();
+  }
+
+ private:
+  typedef apache::thrift::protocol::TCompactProtocolT<ThriftPeekTransport>
+      ProtocolType;
+
+  void ResetProtocol() { protocol_.reset(new ProtocolType(transport_)); }
+
+  shared_ptr<ThriftPeekTransport> transport_;
+  std::unique_ptr<ProtocolType> protocol_;
+};
+
 // Serialize obj into a buffer. The result is returned as a string.
 // The arguments are the object to be serialized and
 // the expected size of the serialized object
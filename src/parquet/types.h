@@ -103,7 +103,8 @@ struct Encoding {
     DELTA_BINARY_PACKED = 5,
     DELTA_LENGTH_BYTE_ARRAY = 6,
     DELTA_BYTE_ARRAY = 7,
-    RLE_DICTIONARY = 8
+    RLE_DICTIONARY = 8,
+    BYTE_STREAM_SPLIT = 9
   };
 };
 
@@ -130,6 +131,16 @@ struct SortOrder {
   enum type { SIGNED, UNSIGNED, UNKNOWN };
 };
 
+// A column the rows of a row group are sorted by. column_idx refers to the
+// leaf columns of the schema; a list of them sorts lexicographically, by the
+// first column and then by the next ones for equal values.
+struct SortingColumn {
+  int column_idx;
+  bool descending;
+  // Whether nulls come before the non-null values
+  bool nulls_first;
+};
+
 class ColumnOrder {
  public:
   enum type { UNDEFINED, TYPE_DEFINED_ORDER };
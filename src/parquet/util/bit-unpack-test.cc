@@ -0,0 +1,294 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include "arrow/util/rle-encoding.h"
+
+#include "parquet/exception.h"
+#include "parquet/util/bit-unpack.h"
+#include "parquet/util/rle-decoder.h"
+
+namespace parquet {
+
+namespace test {
+
+// Straightforward LSB-first bit packing used as reference
+static std::vector<uint8_t> PackBits(const std::vector<uint32_t>& values,
+                                     int bit_width) {
+  std::vector<uint8_t> out((values.size() * bit_width + 7) / 8, 0);
+  int64_t bit = 0;
+  for (uint32_t value : values) {
+    for (int b = 0; b < bit_width; ++b, ++bit) {
+      if ((value >> b) & 1) {
+        out[bit / 8] = static_cast<uint8_t>(out[bit / 8] | (1 << (bit % 8)));
+      }
+    }
+  }
+  return out;
+}
+
+static std::vector<uint32_t> RandomValues(int num_values, int bit_width, uint32_t seed) {
+  std::mt19937 gen(seed);
+  std::vector<uint32_t> values(num_values);
+  const uint64_t max_value = (static_cast<uint64_t>(1) << bit_width) - 1;
+  std::uniform_int_distribution<uint64_t> dist(0, max_value);
+  for (auto& value : values) {
+    value = static_cast<uint32_t>(dist(gen));
+  }
+  return values;
+}
+
+TEST(TestUnpackBits32, AllWidths) {
+  // Lengths that are not a multiple of 8 exercise the scalar tail of the
+  // vectorized kernel
+  for (int bit_width = 0; bit_width <= 32; ++bit_width) {
+    for (int num_values : {0, 1, 7, 8, 9, 63, 64, 257, 1000}) {
+      auto values = RandomValues(num_values, bit_width, bit_width * 1000 + num_values);
+      auto packed = PackBits(values, bit_width);
+
+      std::vector<uint32_t> scalar(num_values + 1, 0xDEADBEEF);
+      std::vector<uint32_t> dispatched(num_values + 1, 0xDEADBEEF);
+      internal::UnpackBits32Scalar(packed.data(), packed.size(), num_values, bit_width,
+                                   scalar.data());
+      internal::UnpackBits32(packed.data(), packed.size(), num_values, bit_width,
+                             dispatched.data());
+      for (int i = 0; i < num_values; ++i) {
+        ASSERT_EQ(values[i], scalar[i]) << "width " << bit_width << " index " << i;
+        ASSERT_EQ(values[i], dispatched[i]) << "width " << bit_width << " index " << i;
+      }
+      // Nothing is written past the requested values
+      ASSERT_EQ(0xDEADBEEF, scalar[num_values]);
+      ASSERT_EQ(0xDEADBEEF, dispatched[num_values]);
+    }
+  }
+}
+
+static std::vector<uint8_t> RleEncode(const std::vector<uint32_t>& values,
+                                      int bit_width) {
+  const int num_values = static_cast<int>(values.size());
+  std::vector<uint8_t> buffer(::arrow::RleEncoder::MaxBufferSize(bit_width, num_values) +
+                              ::arrow::RleEncoder::MinBufferSize(bit_width));
+  ::arrow::RleEncoder encoder(buffer.data(), static_cast<int>(buffer.size()), bit_width);
+  for (uint32_t value : values) {
+    EXPECT_TRUE(encoder.Put(value));
+  }
+  buffer.resize(encoder.Flush());
+  return buffer;
+}
+
+// Mix of long repeated runs and random literal runs
+static std::vector<uint32_t> RunValues(int num_values, int bit_width, uint32_t seed) {
+  std::mt19937 gen(seed);
+  auto random = RandomValues(num_values, bit_width, seed);
+  std::vector<uint32_t> values;
+  while (static_cast<int>(values.size()) < num_values) {
+    const int length = static_cast<int>(gen() % 100) + 1;
+    const bool repeated = gen() % 2 == 0;
+    for (int i = 0; i < length && static_cast<int>(values.size()) < num_values; ++i) {
+      values.push_back(repeated ? random[0] : random[values.size()]);
+    }
+  }
+  return values;
+}
+
+TEST(TestRleBitPackedDecoder, GetBatch) {
+  for (int bit_width : {1, 3, 8, 13, 16, 20, 31, 32}) {
+    auto values = RunValues(5000, bit_width, bit_width);
+    auto encoded = RleEncode(values, bit_width);
+
+    // Odd batch sizes cross run and block boundaries
+    for (int batch_size : {1, 7, 100, 1031, 5000}) {
+      RleBitPackedDecoder decoder(encoded.data(), static_cast<int>(encoded.size()),
+                                  bit_width);
+      std::vector<uint32_t> decoded(values.size());
+      int num_decoded = 0;
+      while (num_decoded < static_cast<int>(values.size())) {
+        int n = decoder.GetBatch(decoded.data() + num_decoded,
+                                 std::min(batch_size, 5000 - num_decoded));
+        ASSERT_GT(n, 0);
+        num_decoded += n;
+      }
+      ASSERT_EQ(values, decoded) << "width " << bit_width << " batch " << batch_size;
+    }
+  }
+}
+
+TEST(TestRleBitPackedDecoder, Levels) {
+  std::vector<uint32_t> values = RunValues(1000, 2, 42);
+  auto encoded = RleEncode(values, 2);
+  RleBitPackedDecoder decoder(encoded.data(), static_cast<int>(encoded.size()), 2);
+  std::vector<int16_t> levels(values.size());
+  ASSERT_EQ(1000, decoder.GetBatch(levels.data(), 1000));
+  for (size_t i = 0; i < values.size(); ++i) {
+    ASSERT_EQ(static_cast<int16_t>(values[i]), levels[i]);
+  }
+  // The end of the data is reached
+  ASSERT_EQ(0, decoder.GetBatch(levels.data(), 1));
+}
+
+TEST(TestRleBitPackedDecoder, GetBatchWithDict) {
+  std::vector<double> dictionary = {0.5, 1.5, 2.5, 3.5, 4.5};
+  std::vector<uint32_t> indices = RunValues(2000, 2, 7);
+  indices[1234] = 4;
+  auto encoded = RleEncode(indices, 3);
+
+  RleBitPackedDecoder decoder(encoded.data(), static_cast<int>(encoded.size()), 3);
+  std::vector<double> decoded(indices.size());
+  ASSERT_EQ(2000, decoder.GetBatchWithDict(dictionary.data(), 5, decoded.data(), 2000));
+  for (size_t i = 0; i < indices.size(); ++i) {
+    ASSERT_EQ(dictionary[indices[i]], decoded[i]);
+  }
+}
+
+TEST(TestRleBitPackedDecoder, DictIndexOutOfBounds) {
+  std::vector<int32_t> dictionary = {10, 20};
+  for (bool repeated : {true, false}) {
+    std::vector<uint32_t> indices = {0, 1, 0, 1, 0, 1, 0, 1, 0, 1};
+    if (repeated) indices = std::vector<uint32_t>(20, 2);
+    indices.push_back(2);
+    auto encoded = RleEncode(indices, 2);
+
+    RleBitPackedDecoder decoder(encoded.data(), static_cast<int>(encoded.size()), 2);
+    std::vector<int32_t> decoded(indices.size());
+    ASSERT_THROW(decoder.GetBatchWithDict(dictionary.data(), 2, decoded.data(),
+                                          static_cast<int>(indices.size())),
+                 ParquetException);
+  }
+}
+
+TEST(TestRleBitPackedDecoder, TruncatedLiteralRun) {
+  // Header for a bit-packed run of 16 values but only 8 values of width 8
+  std::vector<uint8_t> data = {(2 << 1) | 1, 1, 2, 3, 4, 5, 6, 7, 8};
+  RleBitPackedDecoder decoder(data.data(), static_cast<int>(data.size()), 8);
+  std::vector<int32_t> decoded(16);
+  ASSERT_EQ(8, decoder.GetBatch(decoded.data(), 16));
+  for (int i = 0; i < 8; ++i) {
+    ASSERT_EQ(i + 1, decoded[i]);
+  }
+}
+
+TEST(TestRleBitPackedDecoder, SkipEqual) {
+  // Zeros interrupted by other values at 29 and 37
+  std::vector<uint32_t> values(100, 0);
+  values[29] = 1;
+  values[37] = 3;
+  auto encoded = RleEncode(values, 2);
+
+  RleBitPackedDecoder decoder(encoded.data(), static_cast<int>(encoded.size()), 2);
+  ASSERT_EQ(10, decoder.SkipEqual(0, 10));
+  ASSERT_EQ(19, decoder.SkipEqual(0, 100));
+  ASSERT_EQ(0, decoder.SkipEqual(0, 1));
+  ASSERT_EQ(1, decoder.SkipEqual(1, 10));
+  ASSERT_EQ(7, decoder.SkipEqual(0, 100));
+  std::vector<int32_t> decoded(63);
+  ASSERT_EQ(63, decoder.GetBatch(decoded.data(), 63));
+  ASSERT_EQ(3, decoded[0]);
+  ASSERT_EQ(0, decoder.SkipEqual(0, 1));
+}
+
+TEST(TestRleBitPackedDecoder, RepeatedRunLength) {
+  // Runs aligned to groups of 8 so the encoder's choice of runs is known
+  std::vector<uint32_t> values(300, 3);
+  std::fill(values.begin(), values.begin() + 96, 1);
+  for (int i = 96; i < 104; ++i) {
+    values[i] = static_cast<uint32_t>(i % 3);
+  }
+  auto encoded = RleEncode(values, 2);
+
+  RleBitPackedDecoder decoder(encoded.data(), static_cast<int>(encoded.size()), 2);
+  uint32_t value = 0;
+  ASSERT_EQ(96, decoder.RepeatedRunLength(&value));
+  ASSERT_EQ(1u, value);
+  std::vector<int32_t> decoded(300);
+  ASSERT_EQ(40, decoder.GetBatch(decoded.data(), 40));
+  ASSERT_EQ(56, decoder.RepeatedRunLength(&value));
+  ASSERT_EQ(56, decoder.GetBatch(decoded.data(), 56));
+  // The bit-packed run
+  ASSERT_EQ(0, decoder.RepeatedRunLength(&value));
+  ASSERT_EQ(8, decoder.GetBatch(decoded.data(), 8));
+  ASSERT_EQ(196, decoder.RepeatedRunLength(&value));
+  ASSERT_EQ(3u, value);
+  ASSERT_EQ(196, decoder.GetBatch(decoded.data(), 300));
+  ASSERT_EQ(0, decoder.RepeatedRunLength(&value));
+}
+
+TEST(TestRleBitPackedDecoder, GetRuns) {
+  // The same runs as in RepeatedRunLength: 96 ones, 8 bit-packed values and
+  // 196 threes
+  std::vector<uint32_t> values(300, 3);
+  std::fill(values.begin(), values.begin() + 96, 1);
+  for (int i = 96; i < 104; ++i) {
+    values[i] = static_cast<uint32_t>(i % 3);
+  }
+  auto encoded = RleEncode(values, 2);
+
+  RleBitPackedDecoder decoder(encoded.data(), static_cast<int>(encoded.size()), 2);
+  std::vector<int16_t> run_values(10);
+  std::vector<int32_t> run_lengths(10);
+  int num_values = 0;
+  ASSERT_EQ(4, decoder.GetRuns(run_values.data(), run_lengths.data(), 4, 300,
+                               &num_values));
+  ASSERT_EQ(99, num_values);
+  ASSERT_EQ(std::vector<int16_t>({1, 0, 1, 2}),
+            std::vector<int16_t>(run_values.begin(), run_values.begin() + 4));
+  ASSERT_EQ(std::vector<int32_t>({96, 1, 1, 1}),
+            std::vector<int32_t>(run_lengths.begin(), run_lengths.begin() + 4));
+  ASSERT_EQ(6, decoder.GetRuns(run_values.data(), run_lengths.data(), 10, 300,
+                               &num_values));
+  ASSERT_EQ(201, num_values);
+  ASSERT_EQ(3, run_values[5]);
+  ASSERT_EQ(196, run_lengths[5]);
+  ASSERT_EQ(0, decoder.GetRuns(run_values.data(), run_lengths.data(), 10, 300,
+                               &num_values));
+  ASSERT_EQ(0, num_values);
+}
+
+TEST(TestRleBitPackedDecoder, GetRunsMatchesGetBatch) {
+  // Few distinct values, so bit-packed values are merged with their neighbours
+  auto values = RunValues(5000, 2, 7);
+  auto encoded = RleEncode(values, 2);
+
+  for (int max_runs : {1, 3, 100}) {
+    RleBitPackedDecoder decoder(encoded.data(), static_cast<int>(encoded.size()), 2);
+    std::vector<uint32_t> run_values(max_runs);
+    std::vector<int32_t> run_lengths(max_runs);
+    std::vector<uint32_t> expanded;
+    int num_values = 0;
+    int num_runs = 0;
+    while ((num_runs = decoder.GetRuns(run_values.data(), run_lengths.data(), max_runs,
+                                       1031, &num_values)) > 0) {
+      const size_t size = expanded.size();
+      for (int i = 0; i < num_runs; ++i) {
+        ASSERT_GT(run_lengths[i], 0);
+        if (i > 0) ASSERT_NE(run_values[i - 1], run_values[i]);
+        expanded.insert(expanded.end(), run_lengths[i], run_values[i]);
+      }
+      ASSERT_EQ(size + num_values, expanded.size());
+    }
+    ASSERT_EQ(values, expanded) << "max runs " << max_runs;
+  }
+}
+
+}  // namespace test
+
+}  // namespace parquet
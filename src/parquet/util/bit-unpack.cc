@@ -0,0 +1,151 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "parquet/util/bit-unpack.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define PARQUET_UNPACK_AVX2 1
+#include <immintrin.h>
+#endif
+
+namespace parquet {
+namespace internal {
+
+void UnpackBits32Scalar(const uint8_t* in, int64_t in_length, int num_values,
+                        int bit_width, uint32_t* out) {
+  if (bit_width == 0) {
+    std::fill(out, out + num_values, 0u);
+    return;
+  }
+  const uint64_t mask = (static_cast<uint64_t>(1) << bit_width) - 1;
+  int64_t bit_offset = 0;
+  for (int i = 0; i < num_values; ++i, bit_offset += bit_width) {
+    const int64_t byte_offset = bit_offset >> 3;
+    // A value plus its shift spans at most 39 bits, so a single 64-bit load
+    // covers it. Near the end of the input the bytes are gathered one by one.
+    uint64_t word = 0;
+    if (byte_offset + 8 <= in_length) {
+      memcpy(&word, in + byte_offset, sizeof(word));
+    } else {
+      for (int64_t j = byte_offset; j < in_length; ++j) {
+        word |= static_cast<uint64_t>(in[j]) << ((j - byte_offset) * 8);
+      }
+    }
+    out[i] = static_cast<uint32_t>((word >> (bit_offset & 7)) & mask);
+  }
+}
+
+#ifdef PARQUET_UNPACK_AVX2
+
+// Eight values are unpacked per iteration. A group of eight values occupies
+// exactly bit_width bytes, so the per-lane byte offsets and shifts are the same
+// for every group. Widths up to 25 bits fit into a 32-bit load at the value's
+// first byte, wider values need a 64-bit gather.
+__attribute__((target("avx2"))) static void UnpackBits32Avx2(const uint8_t* in,
+                                                             int64_t in_length,
+                                                             int num_values,
+                                                             int bit_width,
+                                                             uint32_t* out) {
+  int64_t num_groups = 0;
+  if (bit_width > 0) {
+    // The loads of the last lane reach beyond the group, stop the vectorized
+    // loop at the last group whose loads stay within the input
+    const int64_t load_size = bit_width <= 25 ? 4 : 8;
+    const int64_t group_span = ((7 * bit_width) >> 3) + load_size;
+    if (in_length >= group_span) {
+      num_groups = std::min<int64_t>(num_values / 8,
+                                     (in_length - group_span) / bit_width + 1);
+    }
+  }
+
+  const __m256i lanes = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+  const __m256i bit_offsets = _mm256_mullo_epi32(lanes, _mm256_set1_epi32(bit_width));
+  const __m256i byte_offsets = _mm256_srli_epi32(bit_offsets, 3);
+  const __m256i shifts = _mm256_and_si256(bit_offsets, _mm256_set1_epi32(7));
+  const uint32_t mask32 = bit_width == 32 ? ~0u : (1u << bit_width) - 1;
+  const __m256i mask = _mm256_set1_epi32(static_cast<int32_t>(mask32));
+
+  const uint8_t* group = in;
+  uint32_t* group_out = out;
+  if (bit_width <= 25) {
+    for (int64_t g = 0; g < num_groups; ++g, group += bit_width, group_out += 8) {
+      __m256i v =
+          _mm256_i32gather_epi32(reinterpret_cast<const int*>(group), byte_offsets, 1);
+      v = _mm256_and_si256(_mm256_srlv_epi32(v, shifts), mask);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(group_out), v);
+    }
+  } else {
+    const __m128i offsets_lo = _mm256_castsi256_si128(byte_offsets);
+    const __m128i offsets_hi = _mm256_extracti128_si256(byte_offsets, 1);
+    const __m256i shifts_lo = _mm256_cvtepu32_epi64(_mm256_castsi256_si128(shifts));
+    const __m256i shifts_hi = _mm256_cvtepu32_epi64(_mm256_extracti128_si256(shifts, 1));
+    // Moves the low halves of the 64-bit lanes into the lower 128 bits
+    const __m256i low_halves = _mm256_setr_epi32(0, 2, 4, 6, 0, 2, 4, 6);
+    for (int64_t g = 0; g < num_groups; ++g, group += bit_width, group_out += 8) {
+      const long long* base = reinterpret_cast<const long long*>(group);  // NOLINT
+      __m256i lo = _mm256_srlv_epi64(_mm256_i32gather_epi64(base, offsets_lo, 1),
+                                     shifts_lo);
+      __m256i hi = _mm256_srlv_epi64(_mm256_i32gather_epi64(base, offsets_hi, 1),
+                                     shifts_hi);
+      lo = _mm256_permutevar8x32_epi32(lo, low_halves);
+      hi = _mm256_permutevar8x32_epi32(hi, low_halves);
+      __m256i v = _mm256_and_si256(_mm256_permute2x128_si256(lo, hi, 0x20), mask);
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(group_out), v);
+    }
+  }
+
+  const int values_done = static_cast<int>(num_groups * 8);
+  const int64_t bytes_done = num_groups * bit_width;
+  UnpackBits32Scalar(in + bytes_done, in_length - bytes_done, num_values - values_done,
+                     bit_width, out + values_done);
+}
+
+#endif  // PARQUET_UNPACK_AVX2
+
+namespace {
+
+typedef void (*UnpackBits32Func)(const uint8_t*, int64_t, int, int, uint32_t*);
+
+UnpackBits32Func ResolveUnpackBits32() {
+#ifdef PARQUET_UNPACK_AVX2
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("avx2")) {
+    return UnpackBits32Avx2;
+  }
+#endif
+  return UnpackBits32Scalar;
+}
+
+UnpackBits32Func GetUnpackBits32() {
+  static const UnpackBits32Func func = ResolveUnpackBits32();
+  return func;
+}
+
+}  // namespace
+
+void UnpackBits32(const uint8_t* in, int64_t in_length, int num_values, int bit_width,
+                  uint32_t* out) {
+  GetUnpackBits32()(in, in_length, num_values, bit_width, out);
+}
+
+bool UnpackBits32IsVectorized() { return GetUnpackBits32() != UnpackBits32Scalar; }
+
+}  // namespace internal
+}  // namespace parquet
@@ -0,0 +1,44 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef PARQUET_UTIL_BIT_UNPACK_H
+#define PARQUET_UTIL_BIT_UNPACK_H
+
+#include <cstdint>
+
+#include "parquet/util/visibility.h"
+
+namespace parquet {
+namespace internal {
+
+// Unpack num_values little-endian bit-packed values of bit_width bits (0 to 32)
+// from in, reading no more than in_length bytes. Uses an AVX2 kernel when the
+// CPU supports it, the choice is made once at the first call.
+PARQUET_EXPORT void UnpackBits32(const uint8_t* in, int64_t in_length, int num_values,
+                                 int bit_width, uint32_t* out);
+
+// Portable implementation of UnpackBits32
+PARQUET_EXPORT void UnpackBits32Scalar(const uint8_t* in, int64_t in_length,
+                                       int num_values, int bit_width, uint32_t* out);
+
+// True if UnpackBits32 dispatches to a SIMD kernel on this machine
+PARQUET_EXPORT bool UnpackBits32IsVectorized();
+
+}  // namespace internal
+}  // namespace parquet
+
+#endif  // PARQUET_UTIL_BIT_UNPACK_H
@@ -0,0 +1,82 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "parquet/util/byte-stream-split.h"
+
+namespace parquet {
+
+namespace test {
+
+// Encodes random values with ByteStreamSplitEncode and its scalar version,
+// then decodes them back from every offset of the streams
+void CheckByteStreamSplit(int width) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> byte(0, 255);
+
+  for (int64_t num_values : {0, 1, 15, 16, 17, 33, 100, 1000}) {
+    std::vector<uint8_t> values(num_values * width);
+    for (auto& b : values) {
+      b = static_cast<uint8_t>(byte(gen));
+    }
+
+    std::vector<uint8_t> encoded(values.size());
+    std::vector<uint8_t> encoded_scalar(values.size());
+    internal::ByteStreamSplitEncode(values.data(), width, num_values, encoded.data());
+    internal::ByteStreamSplitEncodeScalar(values.data(), width, num_values,
+                                          encoded_scalar.data());
+    ASSERT_EQ(encoded_scalar, encoded);
+    for (int64_t i = 0; i < num_values; ++i) {
+      for (int k = 0; k < width; ++k) {
+        ASSERT_EQ(values[i * width + k], encoded[k * num_values + i]);
+      }
+    }
+
+    for (int64_t offset : {0, 1, 16, 19}) {
+      if (offset > num_values) continue;
+      const int64_t num_decoded = num_values - offset;
+      std::vector<uint8_t> decoded(num_decoded * width);
+      std::vector<uint8_t> decoded_scalar(num_decoded * width);
+      internal::ByteStreamSplitDecode(encoded.data() + offset, width, num_decoded,
+                                      num_values, decoded.data());
+      internal::ByteStreamSplitDecodeScalar(encoded.data() + offset, width, num_decoded,
+                                            num_values, decoded_scalar.data());
+      ASSERT_EQ(decoded_scalar, decoded);
+      ASSERT_EQ(std::vector<uint8_t>(values.begin() + offset * width, values.end()),
+                decoded);
+    }
+  }
+}
+
+TEST(ByteStreamSplit, Width4) { CheckByteStreamSplit(4); }
+
+TEST(ByteStreamSplit, Width8) { CheckByteStreamSplit(8); }
+
+TEST(ByteStreamSplit, OtherWidths) {
+  CheckByteStreamSplit(1);
+  CheckByteStreamSplit(2);
+  CheckByteStreamSplit(12);
+}
+
+}  // namespace test
+
+}  // namespace parquet
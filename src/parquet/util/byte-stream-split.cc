@@ -0,0 +1,168 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "parquet/util/byte-stream-split.h"
+
+#if defined(__SSE2__)
+#define PARQUET_BYTE_STREAM_SPLIT_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace parquet {
+namespace internal {
+
+namespace {
+
+#ifdef PARQUET_BYTE_STREAM_SPLIT_SSE2
+
+// A block of 16 values of kWidth bytes is held in kWidth registers. Byte i of
+// register r is at address 16 * r + i of the block. Interleaving register j
+// with register j + kWidth / 2 rotates the bits of all addresses left by one.
+template <int kWidth>
+inline void Interleave(const __m128i* in, __m128i* out) {
+  for (int j = 0; j < kWidth / 2; ++j) {
+    out[2 * j] = _mm_unpacklo_epi8(in[j], in[j + kWidth / 2]);
+    out[2 * j + 1] = _mm_unpackhi_epi8(in[j], in[j + kWidth / 2]);
+  }
+}
+
+// Rotates the addresses of a block left by num_rotations bits
+template <int kWidth>
+inline void Rotate(__m128i* block, int num_rotations) {
+  __m128i scratch[kWidth];
+  for (int i = 0; i < num_rotations; ++i) {
+    Interleave<kWidth>(block, scratch);
+    for (int j = 0; j < kWidth; ++j) {
+      block[j] = scratch[j];
+    }
+  }
+}
+
+// Byte k of value v is at address kWidth * v + k, it goes to 16 * k + v,
+// which is a rotation left by the 4 bits of v
+template <int kWidth>
+void ByteStreamSplitEncodeSse2(const uint8_t* values, int64_t num_values,
+                               uint8_t* out) {
+  const int64_t num_blocks = num_values / 16;
+  __m128i block[kWidth];
+  for (int64_t b = 0; b < num_blocks; ++b) {
+    const uint8_t* src = values + b * 16 * kWidth;
+    for (int j = 0; j < kWidth; ++j) {
+      block[j] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + 16 * j));
+    }
+    Rotate<kWidth>(block, 4);
+    for (int k = 0; k < kWidth; ++k) {
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out + k * num_values + b * 16),
+                       block[k]);
+    }
+  }
+  const int64_t done = num_blocks * 16;
+  for (int64_t i = done; i < num_values; ++i) {
+    for (int k = 0; k < kWidth; ++k) {
+      out[k * num_values + i] = values[i * kWidth + k];
+    }
+  }
+}
+
+// The inverse, a rotation left by the log2(kWidth) bits of k
+template <int kWidth>
+void ByteStreamSplitDecodeSse2(const uint8_t* data, int64_t num_values, int64_t stride,
+                               uint8_t* out) {
+  const int num_rotations = kWidth == 4 ? 2 : 3;
+  const int64_t num_blocks = num_values / 16;
+  __m128i block[kWidth];
+  for (int64_t b = 0; b < num_blocks; ++b) {
+    for (int k = 0; k < kWidth; ++k) {
+      block[k] =
+          _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + k * stride + b * 16));
+    }
+    Rotate<kWidth>(block, num_rotations);
+    uint8_t* dest = out + b * 16 * kWidth;
+    for (int j = 0; j < kWidth; ++j) {
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + 16 * j), block[j]);
+    }
+  }
+  const int64_t done = num_blocks * 16;
+  for (int64_t i = done; i < num_values; ++i) {
+    for (int k = 0; k < kWidth; ++k) {
+      out[i * kWidth + k] = data[k * stride + i];
+    }
+  }
+}
+
+#endif  // PARQUET_BYTE_STREAM_SPLIT_SSE2
+
+}  // namespace
+
+void ByteStreamSplitEncodeScalar(const uint8_t* values, int width, int64_t num_values,
+                                 uint8_t* out) {
+  for (int k = 0; k < width; ++k) {
+    uint8_t* stream = out + k * num_values;
+    for (int64_t i = 0; i < num_values; ++i) {
+      stream[i] = values[i * width + k];
+    }
+  }
+}
+
+void ByteStreamSplitDecodeScalar(const uint8_t* data, int width, int64_t num_values,
+                                 int64_t stride, uint8_t* out) {
+  for (int k = 0; k < width; ++k) {
+    const uint8_t* stream = data + k * stride;
+    for (int64_t i = 0; i < num_values; ++i) {
+      out[i * width + k] = stream[i];
+    }
+  }
+}
+
+void ByteStreamSplitEncode(const uint8_t* values, int width, int64_t num_values,
+                           uint8_t* out) {
+#ifdef PARQUET_BYTE_STREAM_SPLIT_SSE2
+  if (width == 4) {
+    ByteStreamSplitEncodeSse2<4>(values, num_values, out);
+    return;
+  } else if (width == 8) {
+    ByteStreamSplitEncodeSse2<8>(values, num_values, out);
+    return;
+  }
+#endif
+  ByteStreamSplitEncodeScalar(values, width, num_values, out);
+}
+
+void ByteStreamSplitDecode(const uint8_t* data, int width, int64_t num_values,
+                           int64_t stride, uint8_t* out) {
+#ifdef PARQUET_BYTE_STREAM_SPLIT_SSE2
+  if (width == 4) {
+    ByteStreamSplitDecodeSse2<4>(data, num_values, stride, out);
+    return;
+  } else if (width == 8) {
+    ByteStreamSplitDecodeSse2<8>(data, num_values, stride, out);
+    return;
+  }
+#endif
+  ByteStreamSplitDecodeScalar(data, width, num_values, stride, out);
+}
+
+bool ByteStreamSplitIsVectorized(int width) {
+#ifdef PARQUET_BYTE_STREAM_SPLIT_SSE2
+  return width == 4 || width == 8;
+#else
+  return false;
+#endif
+}
+
+}  // namespace internal
+}  // namespace parquet
@@ -0,0 +1,56 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef PARQUET_UTIL_BYTE_STREAM_SPLIT_H
+#define PARQUET_UTIL_BYTE_STREAM_SPLIT_H
+
+#include <cstdint>
+
+#include "parquet/util/visibility.h"
+
+namespace parquet {
+namespace internal {
+
+// Transposes num_values values of width bytes into width streams of
+// num_values bytes: byte k of value i is written to out[k * num_values + i].
+// Values of 4 and 8 bytes are transposed 16 at a time with SSE2 on x86.
+PARQUET_EXPORT void ByteStreamSplitEncode(const uint8_t* values, int width,
+                                          int64_t num_values, uint8_t* out);
+
+// Gathers num_values values of width bytes from streams that are stride bytes
+// apart, byte k of value i is read from data[k * stride + i]. data points to
+// the first value to decode in the first stream.
+PARQUET_EXPORT void ByteStreamSplitDecode(const uint8_t* data, int width,
+                                          int64_t num_values, int64_t stride,
+                                          uint8_t* out);
+
+// Byte by byte implementations of ByteStreamSplitEncode and
+// ByteStreamSplitDecode
+PARQUET_EXPORT void ByteStreamSplitEncodeScalar(const uint8_t* values, int width,
+                                                int64_t num_values, uint8_t* out);
+
+PARQUET_EXPORT void ByteStreamSplitDecodeScalar(const uint8_t* data, int width,
+                                                int64_t num_values, int64_t stride,
+                                                uint8_t* out);
+
+// True if values of width bytes are transposed with SIMD on this machine
+PARQUET_EXPORT bool ByteStreamSplitIsVectorized(int width);
+
+}  // namespace internal
+}  // namespace parquet
+
+#endif  // PARQUET_UTIL_BYTE_STREAM_SPLIT_H
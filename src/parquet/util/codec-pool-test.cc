@@ -0,0 +1,75 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <cstdint>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "parquet/util/codec-pool.h"
+
+namespace parquet {
+
+TEST(TestCodecPool, Uncompressed) {
+  CodecPool pool;
+  ASSERT_EQ(nullptr, pool.Borrow(Compression::UNCOMPRESSED));
+  ASSERT_EQ(0, pool.num_idle());
+}
+
+TEST(TestCodecPool, ReusesReturnedCodecs) {
+  CodecPool pool;
+  ::arrow::Codec* first = nullptr;
+  {
+    PooledCodec codec = pool.Borrow(Compression::SNAPPY);
+    ASSERT_NE(nullptr, codec);
+    first = codec.get();
+    ASSERT_EQ(0, pool.num_idle());
+  }
+  ASSERT_EQ(1, pool.num_idle());
+
+  PooledCodec codec = pool.Borrow(Compression::SNAPPY);
+  ASSERT_EQ(first, codec.get());
+  ASSERT_EQ(0, pool.num_idle());
+
+  // A codec is only borrowed by one user at a time
+  PooledCodec other = pool.Borrow(Compression::SNAPPY);
+  ASSERT_NE(nullptr, other);
+  ASSERT_NE(codec.get(), other.get());
+}
+
+TEST(TestCodecPool, KeyedOnCodec) {
+  CodecPool pool;
+  { PooledCodec codec = pool.Borrow(Compression::SNAPPY); }
+  ASSERT_EQ(1, pool.num_idle());
+
+  PooledCodec codec = pool.Borrow(Compression::GZIP);
+  ASSERT_NE(nullptr, codec);
+  ASSERT_EQ(1, pool.num_idle());
+}
+
+TEST(TestCodecPool, BoundedIdleCodecs) {
+  CodecPool pool(2);
+  {
+    std::vector<PooledCodec> codecs;
+    for (int i = 0; i < 5; ++i) {
+      codecs.push_back(pool.Borrow(Compression::SNAPPY));
+    }
+  }
+  ASSERT_EQ(2, pool.num_idle());
+}
+
+}  // namespace parquet
@@ -0,0 +1,69 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "parquet/util/codec-pool.h"
+
+namespace parquet {
+
+void CodecReturner::operator()(::arrow::Codec* codec) const {
+  std::unique_ptr<::arrow::Codec> instance(codec);
+  if (pool_ != nullptr && instance != nullptr) {
+    pool_->Return(codec_, std::move(instance));
+  }
+}
+
+CodecPool* CodecPool::GetDefault() {
+  static CodecPool* pool = new CodecPool();
+  return pool;
+}
+
+PooledCodec CodecPool::Borrow(Compression::type codec) {
+  const int key = static_cast<int>(codec);
+  std::unique_ptr<::arrow::Codec> instance;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto it = idle_.find(key);
+    if (it != idle_.end() && !it->second.empty()) {
+      instance = std::move(it->second.back());
+      it->second.pop_back();
+    }
+  }
+  if (instance == nullptr) {
+    instance = GetCodecFromArrow(codec);
+  }
+  return PooledCodec(instance.release(), CodecReturner(this, codec));
+}
+
+int64_t CodecPool::num_idle() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  int64_t num_idle = 0;
+  for (const auto& item : idle_) {
+    num_idle += static_cast<int64_t>(item.second.size());
+  }
+  return num_idle;
+}
+
+void CodecPool::Return(Compression::type codec,
+                       std::unique_ptr<::arrow::Codec> instance) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  auto& idle = idle_[static_cast<int>(codec)];
+  if (static_cast<int>(idle.size()) < max_idle_) {
+    idle.push_back(std::move(instance));
+  }
+}
+
+}  // namespace parquet
@@ -0,0 +1,84 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef PARQUET_UTIL_CODEC_POOL_H
+#define PARQUET_UTIL_CODEC_POOL_H
+
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+#include "arrow/util/compression.h"
+
+#include "parquet/types.h"
+#include "parquet/util/memory.h"
+#include "parquet/util/visibility.h"
+
+namespace parquet {
+
+class CodecPool;
+
+// Gives a borrowed codec back to its pool instead of deleting it
+class PARQUET_EXPORT CodecReturner {
+ public:
+  CodecReturner() : pool_(nullptr), codec_(Compression::UNCOMPRESSED) {}
+  CodecReturner(CodecPool* pool, Compression::type codec) : pool_(pool), codec_(codec) {}
+
+  void operator()(::arrow::Codec* codec) const;
+
+ private:
+  CodecPool* pool_;
+  Compression::type codec_;
+};
+
+using PooledCodec = std::unique_ptr<::arrow::Codec, CodecReturner>;
+
+// Free lists of codecs that column readers and writers borrow from and give
+// back, so that the state of a codec, e.g. the zlib streams of GZIP, is set
+// up once and reused by the following column chunks. A borrowed codec is
+// used by a single thread at a time.
+class PARQUET_EXPORT CodecPool {
+ public:
+  // At most max_idle codecs of every codec are kept
+  explicit CodecPool(int max_idle = 64) : max_idle_(max_idle) {}
+
+  // Process-wide pool, it is never destroyed so that codecs can be given
+  // back during static destruction
+  static CodecPool* GetDefault();
+
+  // An idle codec or a new one, nullptr for Compression::UNCOMPRESSED
+  PooledCodec Borrow(Compression::type codec);
+
+  // Number of idle codecs of every codec together
+  int64_t num_idle() const;
+
+ private:
+  friend class CodecReturner;
+
+  void Return(Compression::type codec, std::unique_ptr<::arrow::Codec> instance);
+
+  const int max_idle_;
+  mutable std::mutex mutex_;
+  std::map<int, std::vector<std::unique_ptr<::arrow::Codec>>> idle_;
+};
+
+}  // namespace parquet
+
+#endif  // PARQUET_UTIL_CODEC_POOL_H
@@ -0,0 +1,102 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "parquet/exception.h"
+#include "parquet/util/io-uring.h"
+#include "parquet/util/memory.h"
+
+namespace parquet {
+
+class TestIoUringFile : public ::testing::TestWithParam<bool> {
+ public:
+  void SetUp() override {
+    char path[] = "/tmp/parquet-io-uring-test-XXXXXX";
+    int fd = mkstemp(path);
+    ASSERT_GE(fd, 0);
+    path_ = path;
+
+    data_.resize(1024 * 1024 + 123);
+    for (size_t i = 0; i < data_.size(); ++i) {
+      data_[i] = static_cast<uint8_t>(i * 7 + i / 4096);
+    }
+    ASSERT_EQ(static_cast<ssize_t>(data_.size()), write(fd, data_.data(), data_.size()));
+    close(fd);
+  }
+
+  void TearDown() override { unlink(path_.c_str()); }
+
+  void CheckRange(const ReadRange& range, const std::shared_ptr<Buffer>& buffer) {
+    const int64_t size = static_cast<int64_t>(data_.size());
+    const int64_t expected = std::min(range.length, size - range.offset);
+    ASSERT_EQ(expected, buffer->size());
+    ASSERT_EQ(0, memcmp(data_.data() + range.offset, buffer->data(), expected));
+  }
+
+ protected:
+  std::string path_;
+  std::vector<uint8_t> data_;
+};
+
+TEST_P(TestIoUringFile, ReadRanges) {
+  IoUringOptions options;
+  // Fewer entries than ranges so that submitting has to wait for completions
+  options.queue_depth = 2;
+  options.direct_io = GetParam();
+  std::unique_ptr<IoUringFile> file;
+  try {
+    file = IoUringFile::Open(path_, options);
+  } catch (const ParquetException& e) {
+    // io_uring or O_DIRECT may not be available, e.g. in containers or tmpfs
+    std::cout << "Skipping: " << e.what() << std::endl;
+    return;
+  }
+  ASSERT_EQ(static_cast<int64_t>(data_.size()), file->Size());
+
+  std::vector<ReadRange> ranges = {
+      {0, 100}, {4095, 2}, {10000, 300000}, {500000, 0}, {1024 * 1024, 1000}};
+  auto reads = file->ReadRangesAsync(ranges);
+  ASSERT_EQ(ranges.size(), reads.size());
+  // Wait in reverse order, the reads complete independently
+  for (size_t i = reads.size(); i > 0; --i) {
+    CheckRange(ranges[i - 1], reads[i - 1].get());
+  }
+
+  CheckRange({12345, 678}, file->ReadAtAsync(12345, 678).get());
+  CheckRange({200, 50}, file->ReadAt(200, 50));
+
+  // Reads that nobody waits for are collected when the file is closed
+  file->ReadRangesAsync(ranges);
+  file->Close();
+  ASSERT_THROW(file->ReadAtAsync(0, 10), ParquetException);
+}
+
+INSTANTIATE_TEST_CASE_P(DirectIo, TestIoUringFile, ::testing::Values(false, true));
+
+}  // namespace parquet
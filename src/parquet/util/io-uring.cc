@@ -0,0 +1,402 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "parquet/util/io-uring.h"
+
+#include <fcntl.h>
+#include <linux/io_uring.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <limits>
+#include <sstream>
+
+#include "parquet/exception.h"
+
+namespace parquet {
+
+namespace {
+
+std::string ErrnoMessage(const std::string& what, int error) {
+  std::stringstream ss;
+  ss << what << ": " << std::strerror(error);
+  return ss.str();
+}
+
+// Returns bytes read, fewer than nbytes only at the end of the file
+int64_t ReadFully(int fd, int64_t position, int64_t nbytes, uint8_t* out) {
+  int64_t total = 0;
+  while (total < nbytes) {
+    const ssize_t ret = pread(fd, out + total, static_cast<size_t>(nbytes - total),
+                              static_cast<off_t>(position + total));
+    if (ret < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      throw ParquetException(ErrnoMessage("Failed reading file", errno));
+    }
+    if (ret == 0) {
+      break;
+    }
+    total += ret;
+  }
+  return total;
+}
+
+}  // namespace
+
+// The submission and completion queues shared with the kernel
+struct IoUringFile::Ring {
+  explicit Ring(uint32_t entries) {
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    fd = static_cast<int>(syscall(__NR_io_uring_setup, entries, &params));
+    if (fd < 0) {
+      throw ParquetException(ErrnoMessage("Failed to set up io_uring", errno));
+    }
+    sq_entries = params.sq_entries;
+    try {
+      MapQueues(params);
+    } catch (...) {
+      Unmap();
+      throw;
+    }
+  }
+
+  ~Ring() { Unmap(); }
+
+  void MapQueues(const io_uring_params& params) {
+    sq_size = params.sq_off.array + params.sq_entries * sizeof(unsigned);
+    cq_size = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+    const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_mmap) {
+      sq_size = cq_size = std::max(sq_size, cq_size);
+    }
+    sqes_size = params.sq_entries * sizeof(io_uring_sqe);
+
+    sq_ptr = Map(sq_size, IORING_OFF_SQ_RING);
+    cq_ptr = single_mmap ? sq_ptr : Map(cq_size, IORING_OFF_CQ_RING);
+    sqes = static_cast<io_uring_sqe*>(Map(sqes_size, IORING_OFF_SQES));
+
+    uint8_t* sq = static_cast<uint8_t*>(sq_ptr);
+    sq_tail = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    sq_mask = *reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+    sq_array = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+
+    uint8_t* cq = static_cast<uint8_t*>(cq_ptr);
+    cq_head = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    cq_tail = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    cq_mask = *reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    cqes = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+  }
+
+  void Unmap() {
+    if (sqes != nullptr) munmap(sqes, sqes_size);
+    if (cq_ptr != nullptr && cq_ptr != sq_ptr) munmap(cq_ptr, cq_size);
+    if (sq_ptr != nullptr) munmap(sq_ptr, sq_size);
+    close(fd);
+  }
+
+  void* Map(size_t size, off_t offset) {
+    void* result = mmap(nullptr, size, PROT_READ | PROT_WRITE,
+                        MAP_SHARED | MAP_POPULATE, fd, offset);
+    if (result == MAP_FAILED) {
+      throw ParquetException(ErrnoMessage("Failed to map io_uring", errno));
+    }
+    return result;
+  }
+
+  int fd = -1;
+  uint32_t sq_entries = 0;
+
+  void* sq_ptr = nullptr;
+  size_t sq_size = 0;
+  unsigned* sq_tail = nullptr;
+  unsigned sq_mask = 0;
+  unsigned* sq_array = nullptr;
+
+  io_uring_sqe* sqes = nullptr;
+  size_t sqes_size = 0;
+
+  void* cq_ptr = nullptr;
+  size_t cq_size = 0;
+  unsigned* cq_head = nullptr;
+  unsigned* cq_tail = nullptr;
+  unsigned cq_mask = 0;
+  io_uring_cqe* cqes = nullptr;
+};
+
+struct IoUringFile::Request {
+  ReadRange range;
+  // The bytes at read_offset land at data, which is aligned for O_DIRECT
+  std::shared_ptr<PoolBuffer> buffer;
+  uint8_t* data;
+  int64_t read_offset;
+  int64_t read_length;
+
+  // False if Finish reads the range with pread
+  bool submitted;
+  bool done;
+  // Bytes read or a negated errno
+  int32_t result;
+};
+
+std::unique_ptr<IoUringFile> IoUringFile::Open(const std::string& path,
+                                               const IoUringOptions& options,
+                                               ::arrow::MemoryPool* pool) {
+  if (options.direct_io && (options.direct_io_alignment <= 0 ||
+                            (options.direct_io_alignment &
+                             (options.direct_io_alignment - 1)) != 0)) {
+    throw ParquetException("direct_io_alignment must be a power of two");
+  }
+  const int fd = open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    throw ParquetException(ErrnoMessage("Failed to open " + path, errno));
+  }
+  struct stat st;
+  if (fstat(fd, &st) != 0) {
+    const int error = errno;
+    close(fd);
+    throw ParquetException(ErrnoMessage("Failed to stat " + path, error));
+  }
+  int direct_fd = fd;
+  if (options.direct_io) {
+    direct_fd = open(path.c_str(), O_RDONLY | O_CLOEXEC | O_DIRECT);
+    if (direct_fd < 0) {
+      const int error = errno;
+      close(fd);
+      throw ParquetException(ErrnoMessage("Failed to open " + path, error));
+    }
+  }
+  try {
+    return std::unique_ptr<IoUringFile>(
+        new IoUringFile(pool, options, fd, direct_fd, static_cast<int64_t>(st.st_size)));
+  } catch (...) {
+    if (direct_fd != fd) close(direct_fd);
+    close(fd);
+    throw;
+  }
+}
+
+IoUringFile::IoUringFile(::arrow::MemoryPool* pool, const IoUringOptions& options,
+                         int fd, int direct_fd, int64_t size)
+    : pool_(pool),
+      options_(options),
+      fd_(fd),
+      direct_fd_(direct_fd),
+      size_(size),
+      position_(0),
+      ring_(new Ring(std::max(options.queue_depth, static_cast<uint32_t>(1)))),
+      num_queued_(0),
+      next_request_id_(0) {}
+
+IoUringFile::~IoUringFile() {
+  try {
+    Close();
+  } catch (...) {
+  }
+}
+
+void IoUringFile::Close() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (ring_ == nullptr) {
+    return;
+  }
+  // The kernel writes into the buffers of the reads in flight
+  while (!in_flight_.empty()) {
+    Submit(1);
+  }
+  ring_.reset();
+  if (direct_fd_ != fd_) close(direct_fd_);
+  close(fd_);
+}
+
+int64_t IoUringFile::Tell() { return position_; }
+
+int64_t IoUringFile::Size() const { return size_; }
+
+int64_t IoUringFile::Read(int64_t nbytes, uint8_t* out) {
+  const int64_t bytes_read = ReadAt(position_, nbytes, out);
+  position_ += bytes_read;
+  return bytes_read;
+}
+
+std::shared_ptr<Buffer> IoUringFile::Read(int64_t nbytes) {
+  std::shared_ptr<Buffer> result = ReadAt(position_, nbytes);
+  position_ += result->size();
+  return result;
+}
+
+std::shared_ptr<Buffer> IoUringFile::ReadAt(int64_t position, int64_t nbytes) {
+  std::shared_ptr<PoolBuffer> result = AllocateBuffer(pool_, nbytes);
+  const int64_t bytes_read = ReadAt(position, nbytes, result->mutable_data());
+  if (bytes_read < nbytes) {
+    PARQUET_THROW_NOT_OK(result->Resize(bytes_read));
+  }
+  return result;
+}
+
+int64_t IoUringFile::ReadAt(int64_t position, int64_t nbytes, uint8_t* out) {
+  return ReadFully(fd_, position, nbytes, out);
+}
+
+std::future<std::shared_ptr<Buffer>> IoUringFile::ReadAtAsync(int64_t position,
+                                                              int64_t nbytes) {
+  return std::move(ReadRangesAsync({{position, nbytes}})[0]);
+}
+
+std::vector<std::future<std::shared_ptr<Buffer>>> IoUringFile::ReadRangesAsync(
+    const std::vector<ReadRange>& ranges) {
+  std::vector<std::shared_ptr<Request>> requests;
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (ring_ == nullptr) {
+      throw ParquetException("IoUringFile is closed");
+    }
+    for (const ReadRange& range : ranges) {
+      requests.push_back(Prepare(range));
+    }
+    Submit(0);
+  }
+  std::vector<std::future<std::shared_ptr<Buffer>>> result;
+  for (const auto& request : requests) {
+    result.push_back(MakeFuture(request));
+  }
+  return result;
+}
+
+std::shared_ptr<IoUringFile::Request> IoUringFile::Prepare(const ReadRange& range) {
+  auto request = std::make_shared<Request>();
+  request->range = range;
+  request->submitted = false;
+  request->done = true;
+  request->result = 0;
+
+  const int64_t alignment = options_.direct_io ? options_.direct_io_alignment : 1;
+  request->read_offset = range.offset & ~(alignment - 1);
+  const int64_t read_end =
+      (range.offset + range.length + alignment - 1) & ~(alignment - 1);
+  request->read_length = read_end - request->read_offset;
+  request->buffer = AllocateBuffer(pool_, request->read_length + alignment);
+  const auto address = reinterpret_cast<uintptr_t>(request->buffer->mutable_data());
+  const auto mask = static_cast<uintptr_t>(alignment - 1);
+  request->data = reinterpret_cast<uint8_t*>((address + mask) & ~mask);
+
+  if (range.length <= 0 || request->read_length > std::numeric_limits<int32_t>::max()) {
+    // Nothing to read or too large for a single request
+    return request;
+  }
+
+  // Keep at most as many reads in flight as the submission queue holds, which
+  // leaves the completion queue, twice as large, room for all of them
+  while (in_flight_.size() >= ring_->sq_entries) {
+    Submit(1);
+  }
+
+  const uint64_t id = next_request_id_++;
+  const unsigned tail = *ring_->sq_tail;
+  const unsigned index = tail & ring_->sq_mask;
+  io_uring_sqe* sqe = &ring_->sqes[index];
+  memset(sqe, 0, sizeof(*sqe));
+  sqe->opcode = IORING_OP_READ;
+  sqe->fd = direct_fd_;
+  sqe->off = static_cast<uint64_t>(request->read_offset);
+  sqe->addr = reinterpret_cast<uint64_t>(request->data);
+  sqe->len = static_cast<uint32_t>(request->read_length);
+  sqe->user_data = id;
+  ring_->sq_array[index] = index;
+  __atomic_store_n(ring_->sq_tail, tail + 1, __ATOMIC_RELEASE);
+
+  request->submitted = true;
+  request->done = false;
+  ++num_queued_;
+  in_flight_[id] = request;
+  return request;
+}
+
+void IoUringFile::Submit(uint32_t min_complete) {
+  if (num_queued_ > 0 || min_complete > 0) {
+    const unsigned flags = min_complete > 0 ? IORING_ENTER_GETEVENTS : 0;
+    const int ret = static_cast<int>(syscall(__NR_io_uring_enter, ring_->fd,
+                                             num_queued_, min_complete, flags,
+                                             nullptr, 0));
+    if (ret < 0) {
+      if (errno != EINTR) {
+        throw ParquetException(ErrnoMessage("io_uring_enter failed", errno));
+      }
+    } else {
+      num_queued_ -= static_cast<uint32_t>(ret);
+    }
+  }
+  Reap();
+}
+
+void IoUringFile::Reap() {
+  unsigned head = *ring_->cq_head;
+  const unsigned tail = __atomic_load_n(ring_->cq_tail, __ATOMIC_ACQUIRE);
+  for (; head != tail; ++head) {
+    const io_uring_cqe& cqe = ring_->cqes[head & ring_->cq_mask];
+    auto it = in_flight_.find(cqe.user_data);
+    if (it != in_flight_.end()) {
+      it->second->result = cqe.res;
+      it->second->done = true;
+      in_flight_.erase(it);
+    }
+  }
+  __atomic_store_n(ring_->cq_head, head, __ATOMIC_RELEASE);
+}
+
+std::shared_ptr<Buffer> IoUringFile::Finish(const std::shared_ptr<Request>& request) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    while (!request->done) {
+      Submit(1);
+    }
+  }
+  const ReadRange& range = request->range;
+  const int64_t skip = range.offset - request->read_offset;
+  int64_t bytes_read = 0;
+  if (!request->submitted) {
+    bytes_read = ReadFully(fd_, range.offset, range.length, request->data + skip);
+  } else if (request->result < 0) {
+    throw ParquetException(ErrnoMessage("Failed reading file", -request->result));
+  } else {
+    bytes_read = std::min(std::max(request->result - skip, static_cast<int64_t>(0)),
+                          range.length);
+    if (bytes_read < range.length && range.offset + bytes_read < size_) {
+      // Short read before the end of the file
+      bytes_read += ReadFully(fd_, range.offset + bytes_read, range.length - bytes_read,
+                              request->data + skip + bytes_read);
+    }
+  }
+  const int64_t data_offset = request->data - request->buffer->data();
+  return ::arrow::SliceBuffer(request->buffer, data_offset + skip, bytes_read);
+}
+
+std::future<std::shared_ptr<Buffer>> IoUringFile::MakeFuture(
+    const std::shared_ptr<Request>& request) {
+  // The read is already in the hands of the kernel, the thread waiting for it
+  // collects the completions
+  return std::async(std::launch::deferred, [this, request]() { return Finish(request); });
+}
+
+}  // namespace parquet
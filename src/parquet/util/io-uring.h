@@ -0,0 +1,125 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef PARQUET_UTIL_IO_URING_H
+#define PARQUET_UTIL_IO_URING_H
+
+#include <cstdint>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "arrow/memory_pool.h"
+
+#include "parquet/util/memory.h"
+#include "parquet/util/visibility.h"
+
+namespace parquet {
+
+struct PARQUET_EXPORT IoUringOptions {
+  IoUringOptions() : queue_depth(64), direct_io(false), direct_io_alignment(4096) {}
+
+  // Number of reads the ring keeps in flight
+  uint32_t queue_depth;
+
+  // Open the file with O_DIRECT for the asynchronous reads, bypassing the page
+  // cache. Reads are widened to direct_io_alignment and land in buffers with
+  // that alignment
+  bool direct_io;
+  int64_t direct_io_alignment;
+};
+
+// Local file whose asynchronous reads go through a Linux io_uring. All of the
+// ranges passed to ReadRangesAsync, e.g. the coalesced column chunk ranges of
+// ParquetFileReader::PreBuffer, are submitted with a single system call.
+// Completions are collected by whichever thread waits on one of the futures.
+// The synchronous reads use pread. Thread-safe
+class PARQUET_EXPORT IoUringFile : public RandomAccessSource {
+ public:
+  static std::unique_ptr<IoUringFile> Open(
+      const std::string& path, const IoUringOptions& options = IoUringOptions(),
+      ::arrow::MemoryPool* pool = ::arrow::default_memory_pool());
+
+  ~IoUringFile() override;
+
+  void Close() override;
+
+  int64_t Tell() override;
+
+  int64_t Size() const override;
+
+  // Returns bytes read
+  int64_t Read(int64_t nbytes, uint8_t* out) override;
+
+  std::shared_ptr<Buffer> Read(int64_t nbytes) override;
+
+  std::shared_ptr<Buffer> ReadAt(int64_t position, int64_t nbytes) override;
+
+  /// Returns bytes read
+  int64_t ReadAt(int64_t position, int64_t nbytes, uint8_t* out) override;
+
+  std::future<std::shared_ptr<Buffer>> ReadAtAsync(int64_t position,
+                                                   int64_t nbytes) override;
+
+  std::vector<std::future<std::shared_ptr<Buffer>>> ReadRangesAsync(
+      const std::vector<ReadRange>& ranges) override;
+
+ private:
+  struct Request;
+  struct Ring;
+
+  IoUringFile(::arrow::MemoryPool* pool, const IoUringOptions& options, int fd,
+              int direct_fd, int64_t size);
+
+  // Queue the read of range into the submission ring, the caller holds mutex_
+  std::shared_ptr<Request> Prepare(const ReadRange& range);
+
+  // Hand the queued reads to the kernel, waiting for at least min_complete of
+  // the reads in flight. The caller holds mutex_
+  void Submit(uint32_t min_complete);
+
+  // Collect the completed reads, the caller holds mutex_
+  void Reap();
+
+  // Wait until request completed and return its bytes
+  std::shared_ptr<Buffer> Finish(const std::shared_ptr<Request>& request);
+
+  std::future<std::shared_ptr<Buffer>> MakeFuture(
+      const std::shared_ptr<Request>& request);
+
+  ::arrow::MemoryPool* pool_;
+  IoUringOptions options_;
+  int fd_;
+  // fd_ unless the asynchronous reads use O_DIRECT
+  int direct_fd_;
+  int64_t size_;
+  int64_t position_;
+
+  std::mutex mutex_;
+  std::unique_ptr<Ring> ring_;
+  // Reads queued in the ring but not handed to the kernel yet
+  uint32_t num_queued_;
+  uint64_t next_request_id_;
+  std::unordered_map<uint64_t, std::shared_ptr<Request>> in_flight_;
+};
+
+}  // namespace parquet
+
+#endif  // PARQUET_UTIL_IO_URING_H
@@ -0,0 +1,248 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <cstdint>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "parquet/util/list-levels.h"
+
+namespace parquet {
+
+namespace test {
+
+static bool GetBit(const std::vector<uint8_t>& bits, int64_t i) {
+  return (bits[i / 8] >> (i % 8)) & 1;
+}
+
+// The lists of a leaf nested in list_depth lists, nullable[j] for list j and
+// nullable[list_depth] for the leaf
+class ListLevels {
+ public:
+  explicit ListLevels(const std::vector<bool>& nullable)
+      : nullable_(nullable),
+        list_depth_(static_cast<int>(nullable.size()) - 1),
+        gen_(42) {
+    int16_t def_level = 0;
+    for (int j = 0; j < list_depth_; ++j) {
+      null_def_levels_.push_back(nullable_[j] ? def_level : static_cast<int16_t>(-1));
+      def_level = static_cast<int16_t>(def_level + (nullable_[j] ? 1 : 0));
+      empty_def_levels_.push_back(def_level);
+      ++def_level;
+    }
+    values_def_level_ = def_level;
+    max_def_level_ = static_cast<int16_t>(def_level + (nullable_[list_depth_] ? 1 : 0));
+  }
+
+  void AddLevel(int16_t def_level, int16_t rep_level) {
+    def_levels_.push_back(def_level);
+    rep_levels_.push_back(rep_level);
+  }
+
+  // Append the levels of a random list at depth j
+  void AddRandomList(int j, int16_t rep_level) {
+    std::uniform_int_distribution<int> percent(0, 99);
+    if (nullable_[j] && percent(gen_) < 10) {
+      AddLevel(null_def_levels_[j], rep_level);
+      return;
+    }
+    if (percent(gen_) < 10) {
+      AddLevel(empty_def_levels_[j], rep_level);
+      return;
+    }
+    const int num_items = 1 + percent(gen_) % 4;
+    for (int k = 0; k < num_items; ++k) {
+      const auto item_rep_level = k == 0 ? rep_level : static_cast<int16_t>(j + 1);
+      if (j + 1 < list_depth_) {
+        AddRandomList(j + 1, item_rep_level);
+      } else if (nullable_[list_depth_] && percent(gen_) < 20) {
+        AddLevel(values_def_level_, item_rep_level);
+      } else {
+        AddLevel(max_def_level_, item_rep_level);
+      }
+    }
+  }
+
+  void Convert() {
+    const auto num_levels = static_cast<int64_t>(def_levels_.size());
+    offsets_.assign(list_depth_, std::vector<int32_t>(num_levels + 1, -1));
+    valid_bits_.assign(list_depth_, std::vector<uint8_t>(num_levels / 8 + 1, 0));
+    list_lengths_.assign(list_depth_, -1);
+    null_counts_.assign(list_depth_, -1);
+    std::vector<int32_t*> offsets;
+    std::vector<uint8_t*> valid_bits;
+    for (int j = 0; j < list_depth_; ++j) {
+      offsets.push_back(offsets_[j].data());
+      valid_bits.push_back(valid_bits_[j].data());
+    }
+    internal::LevelsToListOffsets(def_levels_.data(), rep_levels_.data(), num_levels,
+                                  list_depth_, empty_def_levels_.data(),
+                                  null_def_levels_.data(), values_def_level_,
+                                  offsets.data(), valid_bits.data(),
+                                  list_lengths_.data(), null_counts_.data());
+  }
+
+  // Rebuild the levels from the lists, which checks them against the levels
+  // they were converted from
+  void CheckRoundTrip() {
+    std::vector<int16_t> def_levels;
+    std::vector<int16_t> rep_levels;
+    for (int64_t i = 0; i < list_lengths_[0]; ++i) {
+      AppendLevels(0, i, 0, &def_levels, &rep_levels);
+    }
+    ASSERT_EQ(def_levels_, def_levels);
+    ASSERT_EQ(rep_levels_, rep_levels);
+
+    for (int j = 0; j < list_depth_; ++j) {
+      int64_t null_count = 0;
+      for (int64_t i = 0; i < list_lengths_[j]; ++i) {
+        null_count += !GetBit(valid_bits_[j], i);
+      }
+      ASSERT_EQ(null_count, null_counts_[j]) << j;
+    }
+    int64_t num_values = 0;
+    for (int16_t def_level : def_levels_) {
+      num_values += def_level >= values_def_level_;
+    }
+    ASSERT_EQ(num_values, offsets_[list_depth_ - 1][list_lengths_[list_depth_ - 1]]);
+  }
+
+  std::vector<int16_t> def_levels_;
+  std::vector<int16_t> rep_levels_;
+  std::vector<std::vector<int32_t>> offsets_;
+  std::vector<std::vector<uint8_t>> valid_bits_;
+  std::vector<int64_t> list_lengths_;
+  std::vector<int64_t> null_counts_;
+
+ private:
+  void AppendLevels(int j, int64_t i, int16_t rep_level, std::vector<int16_t>* def_levels,
+                    std::vector<int16_t>* rep_levels) {
+    if (!GetBit(valid_bits_[j], i)) {
+      def_levels->push_back(null_def_levels_[j]);
+      rep_levels->push_back(rep_level);
+      return;
+    }
+    const int32_t begin = offsets_[j][i];
+    const int32_t end = offsets_[j][i + 1];
+    if (begin == end) {
+      def_levels->push_back(empty_def_levels_[j]);
+      rep_levels->push_back(rep_level);
+      return;
+    }
+    for (int32_t k = begin; k < end; ++k) {
+      const auto item_rep_level = k == begin ? rep_level : static_cast<int16_t>(j + 1);
+      if (j + 1 < list_depth_) {
+        AppendLevels(j + 1, k, item_rep_level, def_levels, rep_levels);
+      } else {
+        // Null values are not part of the lists, take them from the levels
+        def_levels->push_back(def_levels_[def_levels->size()]);
+        rep_levels->push_back(item_rep_level);
+      }
+    }
+  }
+
+  std::vector<bool> nullable_;
+  int list_depth_;
+  std::vector<int16_t> empty_def_levels_;
+  std::vector<int16_t> null_def_levels_;
+  int16_t values_def_level_;
+  int16_t max_def_level_;
+  std::mt19937 gen_;
+};
+
+TEST(LevelsToListOffsets, List) {
+  // [1, null], null, [], [2]
+  ListLevels levels({true, true});
+  levels.AddLevel(3, 0);
+  levels.AddLevel(2, 1);
+  levels.AddLevel(0, 0);
+  levels.AddLevel(1, 0);
+  levels.AddLevel(3, 0);
+  levels.Convert();
+
+  ASSERT_EQ(4, levels.list_lengths_[0]);
+  ASSERT_EQ(1, levels.null_counts_[0]);
+  const std::vector<int32_t> offsets = {0, 2, 2, 2, 3};
+  for (int i = 0; i < 5; ++i) {
+    ASSERT_EQ(offsets[i], levels.offsets_[0][i]) << i;
+  }
+  const std::vector<bool> valid = {true, false, true, true};
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_EQ(valid[i], GetBit(levels.valid_bits_[0], i)) << i;
+  }
+}
+
+TEST(LevelsToListOffsets, NestedList) {
+  // [[1], [], null], [], [[2, 3]]
+  ListLevels levels({false, true, false});
+  levels.AddLevel(3, 0);
+  levels.AddLevel(2, 1);
+  levels.AddLevel(1, 1);
+  levels.AddLevel(0, 0);
+  levels.AddLevel(3, 0);
+  levels.AddLevel(3, 2);
+  levels.Convert();
+
+  ASSERT_EQ(3, levels.list_lengths_[0]);
+  ASSERT_EQ(0, levels.null_counts_[0]);
+  ASSERT_EQ(4, levels.list_lengths_[1]);
+  ASSERT_EQ(1, levels.null_counts_[1]);
+  const std::vector<int32_t> outer_offsets = {0, 3, 3, 4};
+  const std::vector<int32_t> inner_offsets = {0, 1, 1, 1, 3};
+  for (int i = 0; i < 4; ++i) {
+    ASSERT_EQ(outer_offsets[i], levels.offsets_[0][i]) << i;
+  }
+  for (int i = 0; i < 5; ++i) {
+    ASSERT_EQ(inner_offsets[i], levels.offsets_[1][i]) << i;
+  }
+  ASSERT_FALSE(GetBit(levels.valid_bits_[1], 2));
+  levels.CheckRoundTrip();
+}
+
+TEST(LevelsToListOffsets, RandomLists) {
+  for (const auto& nullable : std::vector<std::vector<bool>>{{true, true},
+                                                             {false, false},
+                                                             {false, true},
+                                                             {true, false, true},
+                                                             {true, true, true, true}}) {
+    ListLevels levels(nullable);
+    for (int i = 0; i < 500; ++i) {
+      levels.AddRandomList(0, 0);
+    }
+    levels.Convert();
+    levels.CheckRoundTrip();
+  }
+}
+
+TEST(LevelsToListOffsets, Empty) {
+  for (const auto& nullable :
+       std::vector<std::vector<bool>>{{true, true}, {true, false, true}}) {
+    ListLevels levels(nullable);
+    levels.Convert();
+    for (size_t j = 0; j < nullable.size() - 1; ++j) {
+      ASSERT_EQ(0, levels.list_lengths_[j]);
+      ASSERT_EQ(0, levels.null_counts_[j]);
+      ASSERT_EQ(0, levels.offsets_[j][0]);
+    }
+  }
+}
+
+}  // namespace test
+
+}  // namespace parquet
@@ -0,0 +1,105 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "parquet/util/list-levels.h"
+
+namespace parquet {
+namespace internal {
+
+namespace {
+
+inline void SetBitTo(uint8_t* bits, int64_t i, bool value) {
+  const auto mask = static_cast<uint8_t>(1 << (i % 8));
+  bits[i / 8] = static_cast<uint8_t>((bits[i / 8] & ~mask) | (value ? mask : 0));
+}
+
+// The common list<primitive> case. The offset and validity bit of the next
+// list are written for every level and kept only if the level starts a list,
+// which leaves the loop without data dependent branches.
+void LevelsToListOffsetsFlat(const int16_t* def_levels, const int16_t* rep_levels,
+                             int64_t num_levels, int16_t null_def_level,
+                             int16_t values_def_level, int32_t* offsets,
+                             uint8_t* valid_bits, int64_t* list_length,
+                             int64_t* null_count) {
+  int64_t length = 0;
+  int64_t nulls = 0;
+  int32_t values_offset = 0;
+  for (int64_t i = 0; i < num_levels; ++i) {
+    const bool starts_list = rep_levels[i] == 0;
+    const bool is_null = def_levels[i] == null_def_level;
+    offsets[length] = values_offset;
+    SetBitTo(valid_bits, length, !is_null);
+    nulls += starts_list && is_null;
+    length += starts_list;
+    values_offset += def_levels[i] >= values_def_level;
+  }
+  offsets[length] = values_offset;
+  *list_length = length;
+  *null_count = nulls;
+}
+
+}  // namespace
+
+void LevelsToListOffsets(const int16_t* def_levels, const int16_t* rep_levels,
+                         int64_t num_levels, int list_depth,
+                         const int16_t* empty_def_levels, const int16_t* null_def_levels,
+                         int16_t values_def_level, int32_t* const* offsets,
+                         uint8_t* const* valid_bits, int64_t* list_lengths,
+                         int64_t* null_counts) {
+  if (list_depth == 1) {
+    LevelsToListOffsetsFlat(def_levels, rep_levels, num_levels, null_def_levels[0],
+                            values_def_level, offsets[0], valid_bits[0],
+                            &list_lengths[0], &null_counts[0]);
+    return;
+  }
+
+  for (int j = 0; j < list_depth; ++j) {
+    list_lengths[j] = 0;
+    null_counts[j] = 0;
+  }
+  // A list starts at the lists that its repetition level does not repeat and
+  // ends the descent at the first list its definition level is null or empty
+  // at. Lists hold offsets into the next inner list, the innermost one into
+  // the values.
+  int32_t values_offset = 0;
+  for (int64_t i = 0; i < num_levels; ++i) {
+    const int16_t def_level = def_levels[i];
+    for (int j = rep_levels[i]; j < list_depth; ++j) {
+      const int64_t k = list_lengths[j]++;
+      offsets[j][k] = j + 1 < list_depth ? static_cast<int32_t>(list_lengths[j + 1])
+                                         : values_offset;
+      if (def_level == null_def_levels[j]) {
+        SetBitTo(valid_bits[j], k, false);
+        ++null_counts[j];
+        break;
+      }
+      SetBitTo(valid_bits[j], k, true);
+      if (def_level == empty_def_levels[j]) {
+        break;
+      }
+    }
+    values_offset += def_level >= values_def_level;
+  }
+  for (int j = 0; j < list_depth; ++j) {
+    offsets[j][list_lengths[j]] = j + 1 < list_depth
+                                      ? static_cast<int32_t>(list_lengths[j + 1])
+                                      : values_offset;
+  }
+}
+
+}  // namespace internal
+}  // namespace parquet
@@ -0,0 +1,49 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef PARQUET_UTIL_LIST_LEVELS_H
+#define PARQUET_UTIL_LIST_LEVELS_H
+
+#include <cstdint>
+
+#include "parquet/util/visibility.h"
+
+namespace parquet {
+namespace internal {
+
+// Converts the num_levels definition and repetition levels of a leaf nested in
+// list_depth lists, whose maximum repetition level is list_depth, into the
+// offsets and validity bitmaps of the lists, the outermost list first.
+//
+// List j is empty at definition level empty_def_levels[j] and null at
+// null_def_levels[j], -1 if it is not nullable. Levels from values_def_level
+// on have a slot in the leaf values. offsets[j] must have room for
+// num_levels + 1 entries and valid_bits[j] for num_levels bits. The number of
+// lists at depth j and the number of null ones are returned in
+// list_lengths[j] and null_counts[j].
+PARQUET_EXPORT void LevelsToListOffsets(const int16_t* def_levels,
+                                        const int16_t* rep_levels, int64_t num_levels,
+                                        int list_depth, const int16_t* empty_def_levels,
+                                        const int16_t* null_def_levels,
+                                        int16_t values_def_level, int32_t* const* offsets,
+                                        uint8_t* const* valid_bits, int64_t* list_lengths,
+                                        int64_t* null_counts);
+
+}  // namespace internal
+}  // namespace parquet
+
+#endif  // PARQUET_UTIL_LIST_LEVELS_H
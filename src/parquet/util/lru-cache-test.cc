@@ -0,0 +1,108 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <cstdint>
+#include <string>
+
+#include <gtest/gtest.h>
+
+#include "parquet/util/lru-cache.h"
+
+namespace parquet {
+
+namespace test {
+
+struct StringSize {
+  int64_t operator()(const std::string& value) const {
+    return static_cast<int64_t>(value.size());
+  }
+};
+
+typedef internal::LruCache<int, std::string, StringSize> StringCache;
+
+TEST(TestLruCache, GetAndPut) {
+  StringCache cache(10);
+  ASSERT_EQ(nullptr, cache.Get(1));
+
+  cache.Put(1, "abc");
+  cache.Put(2, "de");
+  ASSERT_EQ("abc", *cache.Get(1));
+  ASSERT_EQ("de", *cache.Get(2));
+  ASSERT_EQ(5, cache.size());
+  ASSERT_EQ(2, cache.num_entries());
+}
+
+TEST(TestLruCache, EvictsLeastRecentlyUsed) {
+  StringCache cache(10);
+  cache.Put(1, "aaaa");
+  cache.Put(2, "bbbb");
+  // 1 becomes the most recently used entry, so adding 3 evicts 2
+  ASSERT_NE(nullptr, cache.Get(1));
+  cache.Put(3, "cccc");
+
+  ASSERT_NE(nullptr, cache.Get(1));
+  ASSERT_EQ(nullptr, cache.Get(2));
+  ASSERT_NE(nullptr, cache.Get(3));
+  ASSERT_EQ(8, cache.size());
+
+  // Evicts as many entries as needed to make room
+  cache.Put(4, "dddddddddd");
+  ASSERT_EQ(nullptr, cache.Get(1));
+  ASSERT_EQ(nullptr, cache.Get(3));
+  ASSERT_EQ("dddddddddd", *cache.Get(4));
+  ASSERT_EQ(10, cache.size());
+  ASSERT_EQ(1, cache.num_entries());
+}
+
+TEST(TestLruCache, SkipsOversizedValues) {
+  StringCache cache(4);
+  cache.Put(1, "ab");
+  cache.Put(2, "abcde");
+
+  ASSERT_EQ(nullptr, cache.Get(2));
+  // The entries already cached are kept
+  ASSERT_EQ("ab", *cache.Get(1));
+  ASSERT_EQ(2, cache.size());
+}
+
+TEST(TestLruCache, ReplacesExistingKey) {
+  StringCache cache(10);
+  cache.Put(1, "abc");
+  cache.Put(1, "abcdef");
+
+  ASSERT_EQ("abcdef", *cache.Get(1));
+  ASSERT_EQ(6, cache.size());
+  ASSERT_EQ(1, cache.num_entries());
+}
+
+TEST(TestLruCache, Clear) {
+  StringCache cache(10);
+  cache.Put(1, "abc");
+  cache.Put(2, "de");
+  cache.Clear();
+
+  ASSERT_EQ(nullptr, cache.Get(1));
+  ASSERT_EQ(0, cache.size());
+  ASSERT_EQ(0, cache.num_entries());
+
+  cache.Put(3, "fgh");
+  ASSERT_EQ("fgh", *cache.Get(3));
+}
+
+}  // namespace test
+
+}  // namespace parquet
@@ -0,0 +1,102 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef PARQUET_UTIL_LRU_CACHE_H
+#define PARQUET_UTIL_LRU_CACHE_H
+
+#include <cstdint>
+#include <functional>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+namespace parquet {
+namespace internal {
+
+// Cache bounded by the total size of its values, which evicts the least
+// recently used entries first. SizeOf()(value) returns the size of a value.
+//
+// Not thread-safe, the caches built on it guard it with their own mutex.
+template <typename Key, typename Value, typename SizeOf, typename Hash = std::hash<Key>>
+class LruCache {
+ public:
+  explicit LruCache(int64_t capacity) : capacity_(capacity), size_(0) {}
+
+  // Returns nullptr if key is not cached. The value becomes the most recently
+  // used one and stays valid until the next Put or Clear.
+  const Value* Get(const Key& key) {
+    auto it = index_.find(key);
+    if (it == index_.end()) {
+      return nullptr;
+    }
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return &it->second->second;
+  }
+
+  // Values larger than the capacity are not cached. A value already cached
+  // for the key, e.g. by a concurrent reader, is replaced.
+  void Put(Key key, Value value) {
+    const int64_t value_size = SizeOf()(value);
+    if (value_size > capacity_) {
+      return;
+    }
+    auto it = index_.find(key);
+    if (it != index_.end()) {
+      size_ -= SizeOf()(it->second->second);
+      entries_.erase(it->second);
+      index_.erase(it);
+    }
+    EvictTo(capacity_ - value_size);
+    entries_.emplace_front(key, std::move(value));
+    index_[std::move(key)] = entries_.begin();
+    size_ += value_size;
+  }
+
+  void Clear() {
+    entries_.clear();
+    index_.clear();
+    size_ = 0;
+  }
+
+  int64_t capacity() const { return capacity_; }
+
+  // Total size of the cached values
+  int64_t size() const { return size_; }
+  int64_t num_entries() const { return static_cast<int64_t>(entries_.size()); }
+
+ private:
+  typedef std::pair<Key, Value> Entry;
+
+  void EvictTo(int64_t target_size) {
+    while (size_ > target_size && !entries_.empty()) {
+      size_ -= SizeOf()(entries_.back().second);
+      index_.erase(entries_.back().first);
+      entries_.pop_back();
+    }
+  }
+
+  const int64_t capacity_;
+  // Most recently used first
+  std::list<Entry> entries_;
+  std::unordered_map<Key, typename std::list<Entry>::iterator, Hash> index_;
+  int64_t size_;
+};
+
+}  // namespace internal
+}  // namespace parquet
+
+#endif  // PARQUET_UTIL_LRU_CACHE_H
@@ -15,8 +15,10 @@
 // specific language governing permissions and limitations
 // under the License.
 
+#include <algorithm>
 #include <cstdint>
 #include <cstdio>
+#include <cstring>
 #include <memory>
 #include <string>
 #include <vector>
@@ -229,6 +231,25 @@ TEST(ChunkedAllocatorTest, MemoryOverhead) {
   p.FreeAll();
 }
 
+TEST(ChunkedAllocatorTest, MemoryLimit) {
+  ChunkedAllocator p;
+  const int64_t limit = 3 * ChunkedAllocatorTest::INITIAL_CHUNK_SIZE;
+  p.set_memory_limit(limit);
+  while (!p.memory_limit_reached()) {
+    ASSERT_TRUE(p.Allocate(ChunkedAllocatorTest::INITIAL_CHUNK_SIZE / 4) != nullptr);
+  }
+  // New chunks are not larger than the rest of the limit
+  ASSERT_EQ(limit, p.total_allocated_bytes());
+  ASSERT_EQ(limit, p.GetTotalChunkSizes());
+
+  // Allocations above the limit still succeed
+  ASSERT_TRUE(p.Allocate(ChunkedAllocatorTest::INITIAL_CHUNK_SIZE) != nullptr);
+
+  p.Clear();
+  ASSERT_FALSE(p.memory_limit_reached());
+  p.FreeAll();
+}
+
 // Test that the ChunkedAllocator overhead is bounded when we make alternating
 // large and small allocations.
 TEST(ChunkedAllocatorTest, FragmentationOverhead) {
@@ -250,6 +271,161 @@ TEST(ChunkedAllocatorTest, FragmentationOverhead) {
   p.FreeAll();
 }
 
+TEST(TestLimitedMemoryPool, Basics) {
+  LimitedMemoryPool pool(default_memory_pool(), 1000);
+  ASSERT_EQ(1000, pool.limit());
+
+  uint8_t* first;
+  ASSERT_TRUE(pool.Allocate(600, &first).ok());
+  ASSERT_EQ(600, pool.bytes_allocated());
+
+  // Neither a new allocation nor growing one may exceed the limit
+  uint8_t* second;
+  ::arrow::Status status = pool.Allocate(500, &second);
+  ASSERT_TRUE(status.IsOutOfMemory());
+  ASSERT_EQ(600, pool.bytes_allocated());
+  ASSERT_TRUE(pool.Reallocate(600, 1200, &first).IsOutOfMemory());
+  ASSERT_TRUE(pool.Reallocate(600, 1000, &first).ok());
+  ASSERT_EQ(1000, pool.bytes_allocated());
+
+  // Shrinking always succeeds
+  ASSERT_TRUE(pool.Reallocate(1000, 200, &first).ok());
+  ASSERT_TRUE(pool.Allocate(500, &second).ok());
+  ASSERT_EQ(700, pool.bytes_allocated());
+  ASSERT_EQ(1000, pool.max_memory());
+
+  pool.Free(first, 200);
+  pool.Free(second, 500);
+  ASSERT_EQ(0, pool.bytes_allocated());
+
+  // Buffers fail to grow past the limit
+  std::shared_ptr<PoolBuffer> buffer = AllocateBuffer(&pool, 100);
+  ASSERT_FALSE(buffer->Resize(2000).ok());
+  buffer.reset();
+  ASSERT_EQ(0, pool.bytes_allocated());
+}
+
+TEST(TestChainedOutputStream, Basics) {
+  std::vector<uint8_t> data(5000);
+  for (size_t i = 0; i < data.size(); i++) {
+    data[i] = static_cast<uint8_t>(i * 7);
+  }
+
+  ChainedOutputStream stream(default_memory_pool(), 16, 64);
+  int64_t written = 0;
+  for (int64_t length : {0, 10, 10, 1, 100, 3, 2000, 5, 1876}) {
+    stream.Write(data.data() + written, length);
+    written += length;
+    ASSERT_EQ(written, stream.Tell());
+  }
+  ASSERT_EQ(5000, written);
+  ASSERT_LT(1, stream.num_chunks());
+
+  // The chunks are written to the sink in order
+  InMemoryOutputStream sink;
+  stream.WriteTo(&sink);
+  std::shared_ptr<Buffer> gathered = sink.GetBuffer();
+  ASSERT_EQ(5000, gathered->size());
+  ASSERT_EQ(0, memcmp(data.data(), gathered->data(), data.size()));
+
+  std::shared_ptr<Buffer> buffer = stream.GetBuffer();
+  ASSERT_EQ(5000, buffer->size());
+  ASSERT_EQ(0, memcmp(data.data(), buffer->data(), data.size()));
+  ASSERT_EQ(0, stream.Tell());
+
+  // The first chunk is reused after Clear
+  stream.Write(data.data(), 40);
+  stream.Clear();
+  ASSERT_EQ(0, stream.Tell());
+  stream.Write(data.data() + 1, 12);
+  ASSERT_EQ(1, stream.num_chunks());
+  buffer = stream.GetBuffer();
+  ASSERT_EQ(12, buffer->size());
+  ASSERT_EQ(0, memcmp(data.data() + 1, buffer->data(), 12));
+
+  // Nothing written
+  buffer = stream.GetBuffer();
+  ASSERT_EQ(0, buffer->size());
+}
+
+// Fails the writes once limit bytes are written
+class FailingOutputStream : public InMemoryOutputStream {
+ public:
+  explicit FailingOutputStream(int64_t limit) : limit_(limit), num_closes_(0) {}
+
+  void Close() override { ++num_closes_; }
+
+  void Write(const uint8_t* data, int64_t length) override {
+    if (Tell() + length > limit_) {
+      throw ParquetException("disk full");
+    }
+    InMemoryOutputStream::Write(data, length);
+  }
+
+  int num_closes() const { return num_closes_; }
+
+ private:
+  int64_t limit_;
+  int num_closes_;
+};
+
+TEST(TestAsyncOutputStream, Basics) {
+  std::vector<uint8_t> data(10000);
+  for (size_t i = 0; i < data.size(); i++) {
+    data[i] = static_cast<uint8_t>(i * 13);
+  }
+
+  auto sink = std::make_shared<InMemoryOutputStream>();
+  sink->Write(data.data(), 7);
+  AsyncOutputStream stream(sink, 100, 300);
+  ASSERT_EQ(7, stream.Tell());
+  int64_t written = 7;
+  for (int64_t length : {1, 2, 99, 500, 3, 0, 1000, 8388}) {
+    stream.Write(data.data() + written, length);
+    written += length;
+    ASSERT_EQ(written, stream.Tell());
+  }
+  stream.Flush();
+  ASSERT_EQ(written, sink->Tell());
+  stream.Close();
+
+  std::shared_ptr<Buffer> buffer = sink->GetBuffer();
+  ASSERT_EQ(10000, buffer->size());
+  ASSERT_EQ(0, memcmp(data.data(), buffer->data(), data.size()));
+  ASSERT_THROW(stream.Write(data.data(), 1), ParquetException);
+}
+
+TEST(TestAsyncOutputStream, Errors) {
+  std::vector<uint8_t> data(1000);
+  auto sink = std::make_shared<FailingOutputStream>(250);
+  {
+    AsyncOutputStream stream(sink, 100, 200);
+    // The error of the third block is thrown by a later call
+    ASSERT_THROW(
+        {
+          for (int i = 0; i < 10; ++i) {
+            stream.Write(data.data(), 100);
+          }
+          stream.Close();
+        },
+        ParquetException);
+    ASSERT_THROW(stream.Flush(), ParquetException);
+  }
+  ASSERT_EQ(200, sink->Tell());
+}
+
+TEST(TestAsyncOutputStream, FailedClose) {
+  std::vector<uint8_t> data(50);
+  auto sink = std::make_shared<FailingOutputStream>(0);
+  AsyncOutputStream stream(sink, 100, 200);
+  // The partial block is only written by the flush of Close
+  stream.Write(data.data(), 50);
+  ASSERT_THROW(stream.Close(), ParquetException);
+  ASSERT_EQ(1, sink->num_closes());
+  ASSERT_THROW(stream.Close(), ParquetException);
+  ASSERT_EQ(1, sink->num_closes());
+}
+
 TEST(TestBufferedInputStream, Basics) {
   int64_t source_size = 256;
   int64_t stream_offset = 10;
@@ -312,6 +488,160 @@ TEST(TestBufferedInputStream, Basics) {
   }
 }
 
+TEST(TestWindowedInputStream, Basics) {
+  int64_t source_size = 256;
+  int64_t stream_offset = 10;
+  int64_t stream_size = source_size - stream_offset;
+  int64_t window_size = 50;
+  std::shared_ptr<PoolBuffer> buf = AllocateBuffer(default_memory_pool(), source_size);
+  for (int i = 0; i < source_size; i++) {
+    buf->mutable_data()[i] = static_cast<uint8_t>(i);
+  }
+
+  auto wrapper =
+      std::make_shared<ArrowInputFile>(std::make_shared<::arrow::io::BufferReader>(buf));
+  // Room for a single read ahead
+  auto budget = std::make_shared<ReadAheadBudget>(window_size);
+
+  const uint8_t* output;
+  int64_t bytes_read;
+  {
+    WindowedInputStream stream(default_memory_pool(), window_size, wrapper.get(),
+                               stream_offset, stream_size, budget);
+
+    output = stream.Peek(10, &bytes_read);
+    ASSERT_EQ(10, bytes_read);
+    for (int i = 0; i < 10; i++) {
+      ASSERT_EQ(10 + i, output[i]) << i;
+    }
+    ASSERT_EQ(window_size, budget->used());
+
+    // A second stream finds the budget used up and reads its windows on demand
+    WindowedInputStream other(default_memory_pool(), window_size, wrapper.get(), 0,
+                              source_size, budget);
+    output = other.Read(100, &bytes_read);
+    ASSERT_EQ(100, bytes_read);
+    ASSERT_EQ(99, output[99]);
+
+    output = stream.Read(30, &bytes_read);
+    ASSERT_EQ(30, bytes_read);
+    for (int i = 0; i < 30; i++) {
+      ASSERT_EQ(10 + i, output[i]) << i;
+    }
+    // source is at offset 40, read across the window boundary
+    output = stream.Read(20, &bytes_read);
+    ASSERT_EQ(20, bytes_read);
+    for (int i = 0; i < 20; i++) {
+      ASSERT_EQ(40 + i, output[i]) << i;
+    }
+    // read more than the window size
+    output = stream.Read(120, &bytes_read);
+    ASSERT_EQ(120, bytes_read);
+    for (int i = 0; i < 120; i++) {
+      ASSERT_EQ(60 + i, output[i]) << i;
+    }
+
+    stream.Advance(60);
+    // source is at offset 240, read outside of source boundary
+    output = stream.Read(30, &bytes_read);
+    ASSERT_EQ(16, bytes_read);
+    for (int i = 0; i < 16; i++) {
+      ASSERT_EQ(240 + i, output[i]) << i;
+    }
+  }
+  // Read aheads give their bytes back when they are consumed or abandoned
+  ASSERT_EQ(0, budget->used());
+}
+
+TEST(TestDoubleBufferedInputStream, Basics) {
+  int64_t source_size = 256;
+  int64_t stream_offset = 10;
+  int64_t stream_size = source_size - stream_offset;
+  int64_t buffer_size = 50;
+  std::shared_ptr<PoolBuffer> buf = AllocateBuffer(default_memory_pool(), source_size);
+  for (int i = 0; i < source_size; i++) {
+    buf->mutable_data()[i] = static_cast<uint8_t>(i);
+  }
+
+  auto wrapper =
+      std::make_shared<ArrowInputFile>(std::make_shared<::arrow::io::BufferReader>(buf));
+  DoubleBufferedInputStream stream(default_memory_pool(), buffer_size, wrapper.get(),
+                                   stream_offset, stream_size);
+
+  const uint8_t* output;
+  int64_t bytes_read;
+  output = stream.Peek(10, &bytes_read);
+  ASSERT_EQ(10, bytes_read);
+  for (int i = 0; i < 10; i++) {
+    ASSERT_EQ(10 + i, output[i]) << i;
+  }
+  output = stream.Read(40, &bytes_read);
+  ASSERT_EQ(40, bytes_read);
+  for (int i = 0; i < 40; i++) {
+    ASSERT_EQ(10 + i, output[i]) << i;
+  }
+  // source is at offset 50, read across the buffer boundary
+  output = stream.Read(30, &bytes_read);
+  ASSERT_EQ(30, bytes_read);
+  for (int i = 0; i < 30; i++) {
+    ASSERT_EQ(50 + i, output[i]) << i;
+  }
+  // read more than two buffers
+  output = stream.Read(120, &bytes_read);
+  ASSERT_EQ(120, bytes_read);
+  for (int i = 0; i < 120; i++) {
+    ASSERT_EQ(80 + i, output[i]) << i;
+  }
+
+  stream.Advance(30);
+  // source is at offset 230, read outside of source boundary
+  output = stream.Read(30, &bytes_read);
+  ASSERT_EQ(26, bytes_read);
+  for (int i = 0; i < 26; i++) {
+    ASSERT_EQ(230 + i, output[i]) << i;
+  }
+}
+
+// Counts the asynchronous reads that go through the source
+class CountingInputFile : public ArrowInputFile {
+ public:
+  explicit CountingInputFile(const std::shared_ptr<Buffer>& buffer)
+      : ArrowInputFile(std::make_shared<::arrow::io::BufferReader>(buffer)),
+        num_async_reads_(0) {}
+
+  std::future<std::shared_ptr<Buffer>> ReadAtAsync(int64_t position,
+                                                   int64_t nbytes) override {
+    ++num_async_reads_;
+    return ArrowInputFile::ReadAtAsync(position, nbytes);
+  }
+
+  int num_async_reads() const { return num_async_reads_; }
+
+ private:
+  int num_async_reads_;
+};
+
+TEST(TestDoubleBufferedInputStream, ReadsAheadThroughSource) {
+  int64_t source_size = 256;
+  std::shared_ptr<PoolBuffer> buf = AllocateBuffer(default_memory_pool(), source_size);
+  for (int i = 0; i < source_size; i++) {
+    buf->mutable_data()[i] = static_cast<uint8_t>(i);
+  }
+
+  CountingInputFile source(buf);
+  DoubleBufferedInputStream stream(default_memory_pool(), 50, &source, 0, source_size);
+  for (int i = 0; i < source_size; i += 25) {
+    int64_t bytes_read;
+    const uint8_t* output = stream.Read(25, &bytes_read);
+    ASSERT_EQ(std::min<int64_t>(25, source_size - i), bytes_read);
+    for (int j = 0; j < bytes_read; j++) {
+      ASSERT_EQ(static_cast<uint8_t>(i + j), output[j]) << i + j;
+    }
+  }
+  // The first buffer is read on demand, the following ones ahead of time
+  ASSERT_EQ(5, source.num_async_reads());
+}
+
 TEST(TestArrowInputFile, Basics) {
   std::string data = "this is the data";
   auto data_buffer = reinterpret_cast<const uint8_t*>(data.c_str());
@@ -336,4 +666,43 @@ TEST(TestArrowInputFile, Basics) {
   ASSERT_TRUE(expected_buffer->Equals(*pq_buffer.get()));
 }
 
+TEST(TestArrowInputFile, ReadAtAsync) {
+  std::string data = "this is the data";
+  auto data_buffer = reinterpret_cast<const uint8_t*>(data.c_str());
+
+  auto file = std::make_shared<::arrow::io::BufferReader>(data_buffer, data.size());
+  auto source = std::make_shared<ArrowInputFile>(file);
+
+  auto first = source->ReadAtAsync(0, 4);
+  auto second = source->ReadAtAsync(8, 3);
+
+  std::shared_ptr<Buffer> pq_buffer;
+  ASSERT_NO_THROW(pq_buffer = second.get());
+  ASSERT_TRUE(std::make_shared<Buffer>(data_buffer + 8, 3)->Equals(*pq_buffer));
+  ASSERT_NO_THROW(pq_buffer = first.get());
+  ASSERT_TRUE(std::make_shared<Buffer>(data_buffer, 4)->Equals(*pq_buffer));
+}
+
+TEST(TestCoalesceReadRanges, Basics) {
+  auto check = [](std::vector<ReadRange> ranges, int64_t hole_size_limit,
+                  std::vector<ReadRange> expected) {
+    std::vector<ReadRange> coalesced = CoalesceReadRanges(ranges, hole_size_limit);
+    ASSERT_EQ(expected.size(), coalesced.size());
+    for (size_t i = 0; i < expected.size(); ++i) {
+      ASSERT_EQ(expected[i].offset, coalesced[i].offset) << i;
+      ASSERT_EQ(expected[i].length, coalesced[i].length) << i;
+    }
+  };
+
+  check({}, 10, {});
+  check({{110, 11}}, 10, {{110, 11}});
+  // Adjacent and unsorted
+  check({{20, 10}, {0, 10}, {10, 10}}, 0, {{0, 30}});
+  // Holes up to the limit are merged, larger ones are not
+  check({{0, 10}, {15, 5}, {40, 10}}, 5, {{0, 20}, {40, 10}});
+  check({{0, 10}, {15, 5}, {40, 10}}, 4, {{0, 10}, {15, 5}, {40, 10}});
+  // Overlapping and contained ranges
+  check({{0, 100}, {10, 10}, {90, 20}}, 0, {{0, 110}});
+}
+
 }  // namespace parquet
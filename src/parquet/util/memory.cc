@@ -20,8 +20,12 @@
 #include <algorithm>
 #include <cstdint>
 #include <cstdio>
+#include <exception>
+#include <future>
+#include <sstream>
 #include <string>
 #include <utility>
+#include <vector>
 
 #include "arrow/status.h"
 #include "arrow/util/bit-util.h"
@@ -34,6 +38,64 @@ using arrow::MemoryPool;
 
 namespace parquet {
 
+// ----------------------------------------------------------------------
+// LimitedMemoryPool
+
+static ::arrow::Status LimitExceeded(int64_t size, int64_t limit) {
+  std::stringstream ss;
+  ss << "Allocation of " << size << " bytes exceeds the memory limit of " << limit
+     << " bytes";
+  return ::arrow::Status::OutOfMemory(ss.str());
+}
+
+LimitedMemoryPool::LimitedMemoryPool(MemoryPool* pool, int64_t limit)
+    : pool_(pool), limit_(limit), bytes_allocated_(0), max_memory_(0) {}
+
+bool LimitedMemoryPool::Reserve(int64_t num_bytes) {
+  int64_t allocated = bytes_allocated_.load();
+  do {
+    if (limit_ > 0 && num_bytes > 0 && allocated + num_bytes > limit_) {
+      return false;
+    }
+  } while (!bytes_allocated_.compare_exchange_weak(allocated, allocated + num_bytes));
+  int64_t max_memory = max_memory_.load();
+  while (allocated + num_bytes > max_memory &&
+         !max_memory_.compare_exchange_weak(max_memory, allocated + num_bytes)) {
+  }
+  return true;
+}
+
+::arrow::Status LimitedMemoryPool::Allocate(int64_t size, uint8_t** out) {
+  if (!Reserve(size)) {
+    return LimitExceeded(size, limit_);
+  }
+  ::arrow::Status status = pool_->Allocate(size, out);
+  if (!status.ok()) {
+    bytes_allocated_ -= size;
+  }
+  return status;
+}
+
+::arrow::Status LimitedMemoryPool::Reallocate(int64_t old_size, int64_t new_size,
+                                              uint8_t** ptr) {
+  if (!Reserve(new_size - old_size)) {
+    return LimitExceeded(new_size - old_size, limit_);
+  }
+  ::arrow::Status status = pool_->Reallocate(old_size, new_size, ptr);
+  if (!status.ok()) {
+    bytes_allocated_ -= new_size - old_size;
+  }
+  return status;
+}
+
+void LimitedMemoryPool::Free(uint8_t* buffer, int64_t size) {
+  pool_->Free(buffer, size);
+  bytes_allocated_ -= size;
+}
+
+// ----------------------------------------------------------------------
+// Vector
+
 template <class T>
 Vector<T>::Vector(int64_t size, MemoryPool* pool)
     : buffer_(AllocateUniqueBuffer(pool, size * sizeof(T))),
@@ -95,6 +157,7 @@ ChunkedAllocator::ChunkedAllocator(MemoryPool* pool)
       total_allocated_bytes_(0),
       peak_allocated_bytes_(0),
       total_reserved_bytes_(0),
+      memory_limit_(0),
       pool_(pool) {}
 
 ChunkedAllocator::ChunkInfo::ChunkInfo(int64_t size, uint8_t* buf)
@@ -195,6 +258,10 @@ bool ChunkedAllocator::FindChunk(int64_t min_size) {
     DCHECK_LE(next_chunk_size_, MAX_CHUNK_SIZE);
 
     chunk_size = std::max<int64_t>(min_size, next_chunk_size_);
+    if (memory_limit_ > 0) {
+      chunk_size = std::max<int64_t>(
+          min_size, std::min<int64_t>(chunk_size, memory_limit_ - total_reserved_bytes_));
+    }
 
     // Allocate a new chunk. Return early if malloc fails.
     uint8_t* buf = nullptr;
@@ -216,8 +283,9 @@ bool ChunkedAllocator::FindChunk(int64_t min_size) {
     total_reserved_bytes_ += chunk_size;
     // Don't increment the chunk size until the allocation succeeds: if an attempted
     // large allocation fails we don't want to increase the chunk size further.
-    next_chunk_size_ =
-        static_cast<int>(std::min<int64_t>(chunk_size * 2, MAX_CHUNK_SIZE));
+    // Chunks cut short by the memory limit do not shrink the next ones
+    next_chunk_size_ = static_cast<int>(std::min<int64_t>(
+        std::max<int64_t>(chunk_size * 2, INITIAL_CHUNK_SIZE), MAX_CHUNK_SIZE));
   }
 
   DCHECK_LT(current_chunk_idx_, static_cast<int>(chunks_.size()));
@@ -333,9 +401,30 @@ int64_t ArrowFileMethods::Tell() {
   return position;
 }
 
+std::future<std::shared_ptr<Buffer>> RandomAccessSource::ReadAtAsync(int64_t position,
+                                                                     int64_t nbytes) {
+  return std::async(std::launch::async, [this, position, nbytes]() {
+    return this->ReadAt(position, nbytes);
+  });
+}
+
+std::vector<std::future<std::shared_ptr<Buffer>>> RandomAccessSource::ReadRangesAsync(
+    const std::vector<ReadRange>& ranges) {
+  std::vector<std::future<std::shared_ptr<Buffer>>> result;
+  for (const ReadRange& range : ranges) {
+    result.push_back(ReadAtAsync(range.offset, range.length));
+  }
+  return result;
+}
+
+std::string RandomAccessSource::cache_key() const { return ""; }
+
 ArrowInputFile::ArrowInputFile(
-    const std::shared_ptr<::arrow::io::ReadableFileInterface>& file)
-    : file_(file) {}
+    const std::shared_ptr<::arrow::io::ReadableFileInterface>& file,
+    const std::string& cache_key)
+    : file_(file), cache_key_(cache_key) {}
+
+std::string ArrowInputFile::cache_key() const { return cache_key_; }
 
 ::arrow::io::FileInterface* ArrowInputFile::file_interface() { return file_.get(); }
 
@@ -381,6 +470,16 @@ void ArrowOutputStream::Write(const uint8_t* data, int64_t length) {
   PARQUET_THROW_NOT_OK(file_->Write(data, length));
 }
 
+// ----------------------------------------------------------------------
+// InputStream
+
+std::shared_ptr<Buffer> InputStream::ReadAsBuffer(int64_t num_to_read, bool* shared) {
+  int64_t bytes_read = 0;
+  const uint8_t* data = Read(num_to_read, &bytes_read);
+  *shared = false;
+  return std::make_shared<Buffer>(data, bytes_read);
+}
+
 // ----------------------------------------------------------------------
 // InMemoryInputStream
 
@@ -412,6 +511,15 @@ const uint8_t* InMemoryInputStream::Read(int64_t num_to_read, int64_t* num_bytes
 
 void InMemoryInputStream::Advance(int64_t num_bytes) { offset_ += num_bytes; }
 
+std::shared_ptr<Buffer> InMemoryInputStream::ReadAsBuffer(int64_t num_to_read,
+                                                          bool* shared) {
+  const int64_t num_bytes = std::min(num_to_read, len_ - offset_);
+  std::shared_ptr<Buffer> result = ::arrow::SliceBuffer(buffer_, offset_, num_bytes);
+  offset_ += num_bytes;
+  *shared = true;
+  return result;
+}
+
 // ----------------------------------------------------------------------
 // In-memory output stream
 
@@ -449,6 +557,232 @@ std::shared_ptr<Buffer> InMemoryOutputStream::GetBuffer() {
   return result;
 }
 
+// ----------------------------------------------------------------------
+// ChainedOutputStream
+
+constexpr int64_t ChainedOutputStream::kDefaultMaxChunkSize;
+
+ChainedOutputStream::ChainedOutputStream(MemoryPool* pool, int64_t initial_chunk_size,
+                                         int64_t max_chunk_size)
+    : pool_(pool),
+      initial_chunk_size_(initial_chunk_size > 0 ? initial_chunk_size
+                                                 : kInMemoryDefaultCapacity),
+      max_chunk_size_(std::max(max_chunk_size, initial_chunk_size_)),
+      last_chunk_size_(0),
+      size_(0) {}
+
+void ChainedOutputStream::AddChunk(int64_t min_size) {
+  int64_t chunk_size = chunks_.empty()
+                           ? initial_chunk_size_
+                           : std::min(2 * chunks_.back()->size(), max_chunk_size_);
+  chunks_.push_back(AllocateBuffer(pool_, std::max(chunk_size, min_size)));
+  last_chunk_size_ = 0;
+}
+
+void ChainedOutputStream::Write(const uint8_t* data, int64_t length) {
+  if (length == 0) {
+    return;
+  }
+  int64_t available = chunks_.empty() ? 0 : chunks_.back()->size() - last_chunk_size_;
+  if (available > 0) {
+    const int64_t n = std::min(available, length);
+    memcpy(chunks_.back()->mutable_data() + last_chunk_size_, data, n);
+    last_chunk_size_ += n;
+    size_ += n;
+    data += n;
+    length -= n;
+  }
+  if (length > 0) {
+    // What does not fit into the current chunk goes to a single new one, so a
+    // write spans at most two chunks
+    AddChunk(length);
+    memcpy(chunks_.back()->mutable_data(), data, length);
+    last_chunk_size_ = length;
+    size_ += length;
+  }
+}
+
+void ChainedOutputStream::Clear() {
+  if (chunks_.size() > 1) {
+    chunks_.resize(1);
+  }
+  last_chunk_size_ = 0;
+  size_ = 0;
+}
+
+void ChainedOutputStream::WriteTo(OutputStream* sink) const {
+  for (size_t i = 0; i < chunks_.size(); ++i) {
+    const int64_t length =
+        i + 1 == chunks_.size() ? last_chunk_size_ : chunks_[i]->size();
+    sink->Write(chunks_[i]->data(), length);
+  }
+}
+
+std::shared_ptr<Buffer> ChainedOutputStream::GetBuffer() {
+  std::shared_ptr<ResizableBuffer> result;
+  if (chunks_.size() == 1) {
+    result = chunks_[0];
+    PARQUET_THROW_NOT_OK(result->Resize(size_));
+  } else {
+    result = AllocateBuffer(pool_, size_);
+    uint8_t* out = result->mutable_data();
+    for (size_t i = 0; i < chunks_.size(); ++i) {
+      const int64_t length =
+          i + 1 == chunks_.size() ? last_chunk_size_ : chunks_[i]->size();
+      memcpy(out, chunks_[i]->data(), length);
+      out += length;
+    }
+  }
+  chunks_.clear();
+  last_chunk_size_ = 0;
+  size_ = 0;
+  return result;
+}
+
+// ----------------------------------------------------------------------
+// AsyncOutputStream
+
+AsyncOutputStream::AsyncOutputStream(const std::shared_ptr<OutputStream>& sink,
+                                     int64_t block_size, int64_t max_in_flight,
+                                     MemoryPool* pool)
+    : sink_(sink),
+      pool_(pool),
+      block_size_(std::max<int64_t>(block_size, 1)),
+      max_in_flight_(std::max(max_in_flight, block_size_)),
+      position_(sink->Tell()),
+      closed_(false),
+      block_length_(0),
+      in_flight_(0),
+      stopped_(false) {
+  worker_ = std::thread([this]() { WriteBlocks(); });
+}
+
+AsyncOutputStream::~AsyncOutputStream() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopped_ = true;
+  }
+  queued_.notify_one();
+  if (worker_.joinable()) {
+    worker_.join();
+  }
+}
+
+void AsyncOutputStream::Write(const uint8_t* data, int64_t length) {
+  if (closed_) {
+    throw ParquetException("Write to a closed AsyncOutputStream");
+  }
+  while (length > 0) {
+    if (block_ == nullptr) {
+      block_ = AllocateBuffer(pool_, block_size_);
+      block_length_ = 0;
+    }
+    const int64_t n = std::min(length, block_size_ - block_length_);
+    memcpy(block_->mutable_data() + block_length_, data, n);
+    block_length_ += n;
+    position_ += n;
+    data += n;
+    length -= n;
+    if (block_length_ == block_size_) {
+      QueueBlock();
+    }
+  }
+}
+
+void AsyncOutputStream::QueueBlock() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  CheckError();
+  if (block_ == nullptr || block_length_ == 0) {
+    return;
+  }
+  written_.wait(lock, [this]() {
+    return error_ != nullptr || in_flight_ + block_length_ <= max_in_flight_;
+  });
+  CheckError();
+  std::shared_ptr<Buffer> block = block_;
+  if (block_length_ < block_size_) {
+    block = ::arrow::SliceBuffer(block_, 0, block_length_);
+  }
+  queue_.push_back(std::move(block));
+  in_flight_ += block_length_;
+  block_.reset();
+  block_length_ = 0;
+  queued_.notify_one();
+}
+
+void AsyncOutputStream::Flush() {
+  QueueBlock();
+  std::unique_lock<std::mutex> lock(mutex_);
+  written_.wait(lock, [this]() { return error_ != nullptr || in_flight_ == 0; });
+  CheckError();
+}
+
+void AsyncOutputStream::Close() {
+  if (closed_) {
+    // A failed close keeps failing
+    std::lock_guard<std::mutex> lock(mutex_);
+    CheckError();
+    return;
+  }
+  closed_ = true;
+  // The sink is closed even if the last blocks could not be written
+  std::exception_ptr error;
+  try {
+    Flush();
+  } catch (...) {
+    error = std::current_exception();
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopped_ = true;
+  }
+  queued_.notify_one();
+  worker_.join();
+  sink_->Close();
+  if (error != nullptr) {
+    std::rethrow_exception(error);
+  }
+}
+
+void AsyncOutputStream::CheckError() {
+  // The stream stays failed, all the following calls throw the same error
+  if (error_ != nullptr) {
+    std::rethrow_exception(error_);
+  }
+}
+
+void AsyncOutputStream::WriteBlocks() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  while (true) {
+    queued_.wait(lock, [this]() { return stopped_ || !queue_.empty(); });
+    if (queue_.empty()) {
+      return;
+    }
+    std::shared_ptr<Buffer> block = queue_.front();
+    queue_.pop_front();
+    lock.unlock();
+    std::exception_ptr error;
+    try {
+      sink_->Write(block->data(), block->size());
+    } catch (...) {
+      error = std::current_exception();
+    }
+    lock.lock();
+    in_flight_ -= block->size();
+    if (error != nullptr) {
+      error_ = error;
+      // The blocks behind the failed one are dropped
+      for (const auto& queued : queue_) {
+        in_flight_ -= queued->size();
+      }
+      queue_.clear();
+      written_.notify_all();
+      return;
+    }
+    written_.notify_all();
+  }
+}
+
 // ----------------------------------------------------------------------
 // BufferedInputStream
 
@@ -495,6 +829,287 @@ void BufferedInputStream::Advance(int64_t num_bytes) {
   buffer_offset_ += num_bytes;
 }
 
+// ----------------------------------------------------------------------
+// DoubleBufferedInputStream
+
+DoubleBufferedInputStream::DoubleBufferedInputStream(MemoryPool* pool,
+                                                     int64_t buffer_size,
+                                                     RandomAccessSource* source,
+                                                     int64_t start, int64_t num_bytes)
+    : source_(source),
+      buffer_size_(std::max(buffer_size, static_cast<int64_t>(1))),
+      position_(start),
+      stream_end_(start + num_bytes),
+      current_(0),
+      current_data_(nullptr),
+      current_start_(start),
+      current_length_(0),
+      read_ahead_start_(0) {
+  buffers_[0] = AllocateBuffer(pool, 2 * buffer_size_);
+  buffers_[1] = AllocateBuffer(pool, 2 * buffer_size_);
+}
+
+DoubleBufferedInputStream::~DoubleBufferedInputStream() {
+  // The read ahead refers to the source
+  try {
+    FinishReadAhead();
+  } catch (...) {
+  }
+}
+
+const uint8_t* DoubleBufferedInputStream::Peek(int64_t num_to_peek,
+                                               int64_t* num_bytes) {
+  *num_bytes = std::min(num_to_peek, stream_end_ - position_);
+  if (position_ < current_start_ ||
+      position_ + *num_bytes > current_start_ + current_length_) {
+    Refill(*num_bytes);
+  }
+  return current_data_ + (position_ - current_start_);
+}
+
+const uint8_t* DoubleBufferedInputStream::Read(int64_t num_to_read,
+                                               int64_t* num_bytes) {
+  const uint8_t* result = Peek(num_to_read, num_bytes);
+  position_ += *num_bytes;
+  return result;
+}
+
+void DoubleBufferedInputStream::Advance(int64_t num_bytes) { position_ += num_bytes; }
+
+void DoubleBufferedInputStream::Refill(int64_t num_bytes) {
+  const int64_t current_end = current_start_ + current_length_;
+  // Bytes at the current position that the current buffer still holds
+  int64_t tail = 0;
+  if (position_ >= current_start_ && position_ < current_end) {
+    tail = current_end - position_;
+  }
+  const uint8_t* tail_data = current_data_ + (position_ - current_start_);
+
+  // The read ahead starts at current_end, skip its bytes before the position
+  const int64_t ahead_bytes = FinishReadAhead();
+  const int64_t skip = position_ + tail - read_ahead_start_;
+  PoolBuffer* other = buffers_[1 - current_].get();
+  uint8_t* ahead_data = other->mutable_data() + buffer_size_;
+
+  if (tail <= buffer_size_ && skip >= 0 && skip < ahead_bytes) {
+    // Move the tail in front of the bytes read ahead
+    uint8_t* data = ahead_data + skip - tail;
+    if (tail > 0) {
+      memcpy(data, tail_data, tail);
+    }
+    current_data_ = data;
+    current_length_ = tail + ahead_bytes - skip;
+  } else {
+    const int64_t length =
+        std::min(std::max(num_bytes, buffer_size_), stream_end_ - position_);
+    if (other->size() < buffer_size_ + length) {
+      PARQUET_THROW_NOT_OK(other->Resize(buffer_size_ + length, false));
+      ahead_data = other->mutable_data() + buffer_size_;
+    }
+    if (tail > 0) {
+      memcpy(ahead_data, tail_data, tail);
+    }
+    const int64_t bytes_read =
+        source_->ReadAt(position_ + tail, length - tail, ahead_data + tail);
+    if (bytes_read < length - tail) {
+      throw ParquetException("Failed reading column data from source");
+    }
+    current_data_ = ahead_data;
+    current_length_ = length;
+  }
+  current_ = 1 - current_;
+  current_start_ = position_;
+
+  if (current_length_ < num_bytes) {
+    // Peeking at more bytes than were read ahead
+    PoolBuffer* current = buffers_[current_].get();
+    const int64_t offset = current_data_ - current->data();
+    if (current->size() < offset + num_bytes) {
+      PARQUET_THROW_NOT_OK(current->Resize(offset + num_bytes, false));
+    }
+    uint8_t* data = current->mutable_data() + offset;
+    const int64_t missing = num_bytes - current_length_;
+    if (source_->ReadAt(current_start_ + current_length_, missing,
+                        data + current_length_) < missing) {
+      throw ParquetException("Failed reading column data from source");
+    }
+    current_data_ = data;
+    current_length_ = num_bytes;
+  }
+  StartReadAhead();
+}
+
+void DoubleBufferedInputStream::StartReadAhead() {
+  const int64_t start = current_start_ + current_length_;
+  const int64_t length = std::min(buffer_size_, stream_end_ - start);
+  if (length <= 0) {
+    return;
+  }
+  PoolBuffer* other = buffers_[1 - current_].get();
+  if (other->size() < buffer_size_ + length) {
+    PARQUET_THROW_NOT_OK(other->Resize(buffer_size_ + length, false));
+  }
+  read_ahead_start_ = start;
+  read_ahead_ = source_->ReadAtAsync(start, length);
+}
+
+int64_t DoubleBufferedInputStream::FinishReadAhead() {
+  if (!read_ahead_.valid()) {
+    return -1;
+  }
+  std::shared_ptr<Buffer> ahead = read_ahead_.get();
+  // StartReadAhead made room for the bytes behind the space of the tail
+  uint8_t* out = buffers_[1 - current_]->mutable_data() + buffer_size_;
+  if (ahead->size() > 0) {
+    memcpy(out, ahead->data(), ahead->size());
+  }
+  return ahead->size();
+}
+
+// ----------------------------------------------------------------------
+// ReadAheadBudget
+
+bool ReadAheadBudget::TryReserve(int64_t num_bytes) {
+  int64_t used = used_.load();
+  do {
+    if (used + num_bytes > capacity_) {
+      return false;
+    }
+  } while (!used_.compare_exchange_weak(used, used + num_bytes));
+  return true;
+}
+
+void ReadAheadBudget::Release(int64_t num_bytes) { used_ -= num_bytes; }
+
+// ----------------------------------------------------------------------
+// WindowedInputStream
+
+WindowedInputStream::WindowedInputStream(MemoryPool* pool, int64_t window_size,
+                                         RandomAccessSource* source, int64_t start,
+                                         int64_t num_bytes,
+                                         std::shared_ptr<ReadAheadBudget> budget)
+    : pool_(pool),
+      source_(source),
+      budget_(std::move(budget)),
+      window_size_(std::max(window_size, static_cast<int64_t>(1))),
+      position_(start),
+      stream_end_(start + num_bytes),
+      window_(AllocateBuffer(pool, 0)),
+      window_start_(start),
+      read_ahead_start_(0),
+      read_ahead_reserved_(0) {}
+
+WindowedInputStream::~WindowedInputStream() {
+  // The read ahead refers to the source
+  try {
+    FinishReadAhead();
+  } catch (...) {
+  }
+}
+
+const uint8_t* WindowedInputStream::Peek(int64_t num_to_peek, int64_t* num_bytes) {
+  *num_bytes = std::min(num_to_peek, stream_end_ - position_);
+  if (position_ < window_start_ ||
+      position_ + *num_bytes > window_start_ + window_->size()) {
+    Refill(*num_bytes);
+  }
+  return window_->data() + (position_ - window_start_);
+}
+
+const uint8_t* WindowedInputStream::Read(int64_t num_to_read, int64_t* num_bytes) {
+  const uint8_t* result = Peek(num_to_read, num_bytes);
+  position_ += *num_bytes;
+  return result;
+}
+
+void WindowedInputStream::Advance(int64_t num_bytes) { position_ += num_bytes; }
+
+void WindowedInputStream::Refill(int64_t num_bytes) {
+  const int64_t window_end = window_start_ + window_->size();
+  // Bytes at the current position that the window still holds
+  int64_t tail = 0;
+  if (position_ >= window_start_ && position_ < window_end) {
+    tail = window_end - position_;
+  }
+
+  // The read ahead starts at window_end, skip its bytes before the position
+  std::shared_ptr<Buffer> ahead = FinishReadAhead();
+  int64_t ahead_offset = 0;
+  int64_t ahead_bytes = 0;
+  if (ahead != nullptr) {
+    ahead_offset = position_ + tail - read_ahead_start_;
+    if (ahead_offset >= 0 && ahead_offset < ahead->size()) {
+      ahead_bytes = ahead->size() - ahead_offset;
+    }
+  }
+
+  if (tail == 0 && ahead_bytes >= num_bytes) {
+    // Sequential reads that end at a window boundary
+    window_ = ::arrow::SliceBuffer(ahead, ahead_offset, ahead_bytes);
+  } else {
+    int64_t length = ahead_bytes > 0 ? tail + ahead_bytes : window_size_;
+    length = std::min(std::max(length, num_bytes), stream_end_ - position_);
+    std::shared_ptr<PoolBuffer> buffer = AllocateBuffer(pool_, length);
+    uint8_t* out = buffer->mutable_data();
+    if (tail > 0) {
+      memcpy(out, window_->data() + (position_ - window_start_), tail);
+    }
+    int64_t filled = tail;
+    const int64_t from_ahead = std::min(ahead_bytes, length - filled);
+    if (from_ahead > 0) {
+      memcpy(out + filled, ahead->data() + ahead_offset, from_ahead);
+      filled += from_ahead;
+    }
+    if (filled < length) {
+      const int64_t bytes_read =
+          source_->ReadAt(position_ + filled, length - filled, out + filled);
+      if (bytes_read < length - filled) {
+        throw ParquetException("Failed reading column data from source");
+      }
+    }
+    window_ = buffer;
+  }
+  window_start_ = position_;
+  StartReadAhead();
+}
+
+void WindowedInputStream::StartReadAhead() {
+  const int64_t start = window_start_ + window_->size();
+  const int64_t length = std::min(window_size_, stream_end_ - start);
+  if (length <= 0) {
+    return;
+  }
+  if (budget_ != nullptr) {
+    if (!budget_->TryReserve(length)) {
+      return;
+    }
+    read_ahead_reserved_ = length;
+  }
+  read_ahead_start_ = start;
+  read_ahead_ = source_->ReadAtAsync(start, length);
+}
+
+std::shared_ptr<Buffer> WindowedInputStream::FinishReadAhead() {
+  if (!read_ahead_.valid()) {
+    return nullptr;
+  }
+  std::shared_ptr<Buffer> result;
+  std::exception_ptr error;
+  try {
+    result = read_ahead_.get();
+  } catch (...) {
+    error = std::current_exception();
+  }
+  if (budget_ != nullptr) {
+    budget_->Release(read_ahead_reserved_);
+  }
+  read_ahead_reserved_ = 0;
+  if (error) {
+    std::rethrow_exception(error);
+  }
+  return result;
+}
+
 std::shared_ptr<PoolBuffer> AllocateBuffer(MemoryPool* pool, int64_t size) {
   auto result = std::make_shared<PoolBuffer>(pool);
   if (size > 0) {
@@ -511,4 +1126,29 @@ std::unique_ptr<PoolBuffer> AllocateUniqueBuffer(MemoryPool* pool, int64_t size)
   return result;
 }
 
+std::vector<ReadRange> CoalesceReadRanges(std::vector<ReadRange> ranges,
+                                          int64_t hole_size_limit) {
+  std::vector<ReadRange> coalesced;
+  if (ranges.empty()) {
+    return coalesced;
+  }
+  std::sort(ranges.begin(), ranges.end(), [](const ReadRange& a, const ReadRange& b) {
+    return a.offset < b.offset;
+  });
+
+  ReadRange current = ranges[0];
+  for (size_t i = 1; i < ranges.size(); ++i) {
+    const ReadRange& next = ranges[i];
+    const int64_t current_end = current.offset + current.length;
+    if (next.offset - current_end <= hole_size_limit) {
+      current.length = std::max(current_end, next.offset + next.length) - current.offset;
+    } else {
+      coalesced.push_back(current);
+      current = next;
+    }
+  }
+  coalesced.push_back(current);
+  return coalesced;
+}
+
 }  // namespace parquet
@@ -19,11 +19,17 @@
 #define PARQUET_UTIL_MEMORY_H
 
 #include <atomic>
+#include <condition_variable>
 #include <cstdint>
 #include <cstdlib>
 #include <cstring>
+#include <deque>
+#include <exception>
+#include <future>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "arrow/buffer.h"
@@ -76,6 +82,35 @@ using MutableBuffer = ::arrow::MutableBuffer;
 using ResizableBuffer = ::arrow::ResizableBuffer;
 using PoolBuffer = ::arrow::PoolBuffer;
 
+// A MemoryPool that allocates from another pool and fails allocations with
+// OutOfMemory rather than let the bytes it has allocated exceed limit, 0 for
+// no limit. Share one between the readers of a process to give them a common
+// budget. Thread-safe
+class PARQUET_EXPORT LimitedMemoryPool : public ::arrow::MemoryPool {
+ public:
+  LimitedMemoryPool(::arrow::MemoryPool* pool, int64_t limit);
+
+  ::arrow::Status Allocate(int64_t size, uint8_t** out) override;
+  ::arrow::Status Reallocate(int64_t old_size, int64_t new_size, uint8_t** ptr) override;
+  void Free(uint8_t* buffer, int64_t size) override;
+
+  int64_t bytes_allocated() const override { return bytes_allocated_.load(); }
+  int64_t max_memory() const override { return max_memory_.load(); }
+
+  int64_t limit() const { return limit_; }
+
+  ::arrow::MemoryPool* pool() const { return pool_; }
+
+ private:
+  // Adds num_bytes to bytes_allocated_, false if that exceeds limit_
+  bool Reserve(int64_t num_bytes);
+
+  ::arrow::MemoryPool* pool_;
+  const int64_t limit_;
+  std::atomic<int64_t> bytes_allocated_;
+  std::atomic<int64_t> max_memory_;
+};
+
 template <class T>
 class PARQUET_EXPORT Vector {
  public:
@@ -87,6 +122,7 @@ class PARQUET_EXPORT Vector {
   inline T& operator[](int64_t i) const { return data_[i]; }
 
   const T* data() const { return data_; }
+  int64_t size() const { return size_; }
 
  private:
   std::unique_ptr<PoolBuffer> buffer_;
@@ -177,6 +213,16 @@ class PARQUET_EXPORT ChunkedAllocator {
   /// Return sum of chunk_sizes_.
   int64_t GetTotalChunkSizes() const;
 
+  /// Limit the bytes handed out by Allocate() to about 'limit', 0 for no limit.
+  /// New chunks do not grow past what is left of the limit for the next
+  /// allocations. An allocation that does not fit is still served, callers
+  /// check memory_limit_reached() and stop allocating.
+  void set_memory_limit(int64_t limit) { memory_limit_ = limit; }
+  int64_t memory_limit() const { return memory_limit_; }
+  bool memory_limit_reached() const {
+    return memory_limit_ > 0 && total_allocated_bytes_ >= memory_limit_;
+  }
+
  private:
   friend class ChunkedAllocatorTest;
   static const int INITIAL_CHUNK_SIZE = 4 * 1024;
@@ -216,6 +262,9 @@ class PARQUET_EXPORT ChunkedAllocator {
   /// sum of all bytes allocated in chunks_
   int64_t total_reserved_bytes_;
 
+  /// See set_memory_limit(), 0 if there is none
+  int64_t memory_limit_;
+
   std::vector<ChunkInfo> chunks_;
 
   ::arrow::MemoryPool* pool_;
@@ -253,6 +302,8 @@ class PARQUET_EXPORT FileInterface {
   virtual int64_t Tell() = 0;
 };
 
+struct ReadRange;
+
 /// It is the responsibility of implementations to mind threadsafety of shared
 /// resources
 class PARQUET_EXPORT RandomAccessSource : virtual public FileInterface {
@@ -270,6 +321,28 @@ class PARQUET_EXPORT RandomAccessSource : virtual public FileInterface {
 
   /// Returns bytes read
   virtual int64_t ReadAt(int64_t position, int64_t nbytes, uint8_t* out) = 0;
+
+  /// \brief Start reading nbytes at position without waiting for the result
+  ///
+  /// Several requests may be in flight at the same time. Errors are reported
+  /// by rethrowing the exception from std::future::get. The default
+  /// implementation issues the blocking ReadAt on a separate thread; sources
+  /// backed by storage with native asynchronous I/O should override it.
+  virtual std::future<std::shared_ptr<Buffer>> ReadAtAsync(int64_t position,
+                                                           int64_t nbytes);
+
+  /// \brief Start reading all of the ranges at once
+  ///
+  /// Sources that can submit a batch of requests with a single call override
+  /// this, the default implementation calls ReadAtAsync for every range.
+  virtual std::vector<std::future<std::shared_ptr<Buffer>>> ReadRangesAsync(
+      const std::vector<ReadRange>& ranges);
+
+  /// \brief Identifies the contents of the source in a BlockCache
+  ///
+  /// Sources with the same key must hold the same bytes. Sources returning an
+  /// empty key, the default, are not cached.
+  virtual std::string cache_key() const;
 };
 
 class PARQUET_EXPORT OutputStream : virtual public FileInterface {
@@ -295,7 +368,8 @@ class PARQUET_EXPORT ArrowFileMethods : virtual public FileInterface {
 class PARQUET_EXPORT ArrowInputFile : public ArrowFileMethods, public RandomAccessSource {
  public:
   explicit ArrowInputFile(
-      const std::shared_ptr<::arrow::io::ReadableFileInterface>& file);
+      const std::shared_ptr<::arrow::io::ReadableFileInterface>& file,
+      const std::string& cache_key = "");
 
   int64_t Size() const override;
 
@@ -311,6 +385,8 @@ class PARQUET_EXPORT ArrowInputFile : public ArrowFileMethods, public RandomAcce
 
   std::shared_ptr<::arrow::io::ReadableFileInterface> file() const { return file_; }
 
+  std::string cache_key() const override;
+
   // Diamond inheritance
   using ArrowFileMethods::Close;
   using ArrowFileMethods::Tell;
@@ -318,6 +394,7 @@ class PARQUET_EXPORT ArrowInputFile : public ArrowFileMethods, public RandomAcce
  private:
   ::arrow::io::FileInterface* file_interface() override;
   std::shared_ptr<::arrow::io::ReadableFileInterface> file_;
+  std::string cache_key_;
 };
 
 class PARQUET_EXPORT ArrowOutputStream : public ArrowFileMethods, public OutputStream {
@@ -359,6 +436,9 @@ class PARQUET_EXPORT InMemoryOutputStream : public OutputStream {
   // Get pointer to the underlying buffer
   const Buffer& GetBufferRef() const { return *buffer_; }
 
+  // Bytes held by the stream, 0 once its buffer is taken by GetBuffer
+  int64_t capacity() const { return buffer_ ? capacity_ : 0; }
+
   // Return complete stream as Buffer
   std::shared_ptr<Buffer> GetBuffer();
 
@@ -373,6 +453,118 @@ class PARQUET_EXPORT InMemoryOutputStream : public OutputStream {
   DISALLOW_COPY_AND_ASSIGN(InMemoryOutputStream);
 };
 
+// An in-memory output stream made of a chain of buffers from the pool. The
+// written bytes are never moved: a chunk that is full is followed by a new
+// one, twice as large up to max_chunk_size, instead of being reallocated.
+// WriteTo passes the chunks to the sink one after the other.
+class PARQUET_EXPORT ChainedOutputStream : public OutputStream {
+ public:
+  static constexpr int64_t kDefaultMaxChunkSize = 1 << 20;
+
+  explicit ChainedOutputStream(
+      ::arrow::MemoryPool* pool = ::arrow::default_memory_pool(),
+      int64_t initial_chunk_size = kInMemoryDefaultCapacity,
+      int64_t max_chunk_size = kDefaultMaxChunkSize);
+
+  // Close is a no-op with the in-memory stream
+  void Close() override {}
+
+  int64_t Tell() override { return size_; }
+
+  void Write(const uint8_t* data, int64_t length) override;
+
+  // Drops the contents, the first chunk is kept for reuse
+  void Clear();
+
+  // Number of chunks that hold the contents
+  int num_chunks() const { return static_cast<int>(chunks_.size()); }
+
+  // Writes the contents to sink, chunk by chunk
+  void WriteTo(OutputStream* sink) const;
+
+  // Return the contents as one Buffer, which copies them unless they fit in
+  // a single chunk. The stream is empty afterwards
+  std::shared_ptr<Buffer> GetBuffer();
+
+ private:
+  // Appends a chunk of at least min_size bytes
+  void AddChunk(int64_t min_size);
+
+  ::arrow::MemoryPool* pool_;
+  int64_t initial_chunk_size_;
+  int64_t max_chunk_size_;
+  std::vector<std::shared_ptr<ResizableBuffer>> chunks_;
+  // Number of bytes used in the last chunk
+  int64_t last_chunk_size_;
+  int64_t size_;
+
+  DISALLOW_COPY_AND_ASSIGN(ChainedOutputStream);
+};
+
+// Decorator that coalesces the writes to sink into blocks of block_size bytes
+// and writes the blocks to sink from a background thread, so that the writer
+// does not wait for every write to a slow sink. Write blocks while the
+// blocks queued or being written reach max_in_flight bytes. An error of sink
+// is thrown by the following calls to Write, Flush and Close, the blocks
+// after the failed one are dropped. Close writes the last block, waits for
+// the background thread and closes sink. Not thread-safe
+class PARQUET_EXPORT AsyncOutputStream : public OutputStream {
+ public:
+  AsyncOutputStream(const std::shared_ptr<OutputStream>& sink, int64_t block_size,
+                    int64_t max_in_flight,
+                    ::arrow::MemoryPool* pool = ::arrow::default_memory_pool());
+
+  // Waits for the queued blocks, errors are ignored
+  ~AsyncOutputStream() override;
+
+  // Writes the queued blocks and closes sink. The sink is closed even if a
+  // block could not be written, the error is then thrown by every later Close
+  void Close() override;
+
+  // Position in the stream, counting the bytes that are not written to sink
+  // yet
+  int64_t Tell() override { return position_; }
+
+  void Write(const uint8_t* data, int64_t length) override;
+
+  // Queue the current block and wait until all blocks are written to sink
+  void Flush();
+
+ private:
+  // Queue the current block, waiting for room in the in-flight budget
+  void QueueBlock();
+
+  void WriteBlocks();
+
+  // Throws the error of the background thread, if any. Requires mutex_
+  void CheckError();
+
+  std::shared_ptr<OutputStream> sink_;
+  ::arrow::MemoryPool* pool_;
+  const int64_t block_size_;
+  const int64_t max_in_flight_;
+  int64_t position_;
+  bool closed_;
+
+  // Block the writes are copied into
+  std::shared_ptr<PoolBuffer> block_;
+  int64_t block_length_;
+
+  std::thread worker_;
+
+  // Guard the state shared with the worker thread
+  std::mutex mutex_;
+  std::condition_variable queued_;
+  std::condition_variable written_;
+  std::deque<std::shared_ptr<Buffer>> queue_;
+  // Bytes of the queued blocks and of the block being written
+  int64_t in_flight_;
+  bool stopped_;
+  std::exception_ptr error_;
+
+  DISALLOW_COPY_AND_ASSIGN(AsyncOutputStream);
+};
+
 // ----------------------------------------------------------------------
 // Streaming input interfaces
 
@@ -396,6 +588,12 @@ class InputStream {
   // Advance the stream without reading
   virtual void Advance(int64_t num_bytes) = 0;
 
+  // Identical to Read(), but returns the bytes as a buffer. If *shared is set
+  // to true, the buffer shares ownership of the bytes and remains valid after
+  // the stream is read further or destroyed. Otherwise it is only valid as
+  // long as a pointer returned by Read() would be.
+  virtual std::shared_ptr<Buffer> ReadAsBuffer(int64_t num_to_read, bool* shared);
+
   virtual ~InputStream() {}
 
  protected:
@@ -412,6 +610,8 @@ class PARQUET_EXPORT InMemoryInputStream : public InputStream {
 
   virtual void Advance(int64_t num_bytes);
 
+  virtual std::shared_ptr<Buffer> ReadAsBuffer(int64_t num_to_read, bool* shared);
+
  private:
   std::shared_ptr<Buffer> buffer_;
   int64_t len_;
@@ -437,12 +637,138 @@ class PARQUET_EXPORT BufferedInputStream : public InputStream {
   int64_t buffer_size_;
 };
 
+// Variant of BufferedInputStream that reads the next buffer_size bytes with
+// RandomAccessSource::ReadAtAsync while the current buffer is consumed, they
+// are then copied into a second buffer. Bytes at the end of the current
+// buffer that are peeked at together with the following ones are moved in
+// front of the bytes read ahead, for which each buffer reserves buffer_size
+// bytes, so the stream holds about four times buffer_size. Peeking at more
+// bytes than that grows the buffers.
+class PARQUET_EXPORT DoubleBufferedInputStream : public InputStream {
+ public:
+  DoubleBufferedInputStream(::arrow::MemoryPool* pool, int64_t buffer_size,
+                            RandomAccessSource* source, int64_t start,
+                            int64_t num_bytes);
+  ~DoubleBufferedInputStream() override;
+
+  virtual const uint8_t* Peek(int64_t num_to_peek, int64_t* num_bytes);
+  virtual const uint8_t* Read(int64_t num_to_read, int64_t* num_bytes);
+
+  virtual void Advance(int64_t num_bytes);
+
+ private:
+  // Make the current bytes start at the current position and hold at least
+  // num_bytes bytes, then start reading the bytes after them
+  void Refill(int64_t num_bytes);
+
+  void StartReadAhead();
+
+  // Wait for the read ahead, returns the number of bytes read or -1 if no
+  // read ahead was started
+  int64_t FinishReadAhead();
+
+  RandomAccessSource* source_;
+  int64_t buffer_size_;
+  int64_t position_;
+  int64_t stream_end_;
+
+  // buffers_[current_] holds the bytes of the stream that are read, the other
+  // one receives the read ahead at offset buffer_size_
+  std::shared_ptr<PoolBuffer> buffers_[2];
+  int current_;
+  const uint8_t* current_data_;
+  int64_t current_start_;
+  int64_t current_length_;
+
+  std::future<std::shared_ptr<Buffer>> read_ahead_;
+  int64_t read_ahead_start_;
+};
+
+// Bytes that a group of streams, e.g. those of the column readers of a file,
+// may hold in reads ahead of their position. Thread-safe
+class PARQUET_EXPORT ReadAheadBudget {
+ public:
+  explicit ReadAheadBudget(int64_t capacity) : capacity_(capacity), used_(0) {}
+
+  // Returns false and reserves nothing if fewer than num_bytes are left
+  bool TryReserve(int64_t num_bytes);
+
+  void Release(int64_t num_bytes);
+
+  int64_t capacity() const { return capacity_; }
+
+  int64_t used() const { return used_.load(); }
+
+ private:
+  const int64_t capacity_;
+  std::atomic<int64_t> used_;
+};
+
+// Implementation of an InputStream that holds a window of window_size bytes
+// of the source and reads the following window_size bytes in the background
+// while the current window is consumed. The window grows to fit bytes that
+// are peeked at once, e.g. a page that is larger than window_size. If a
+// budget is given, the read ahead only starts if the budget has room for it;
+// otherwise the next window is read when it is needed.
+class PARQUET_EXPORT WindowedInputStream : public InputStream {
+ public:
+  WindowedInputStream(::arrow::MemoryPool* pool, int64_t window_size,
+                      RandomAccessSource* source, int64_t start, int64_t num_bytes,
+                      std::shared_ptr<ReadAheadBudget> budget = nullptr);
+  ~WindowedInputStream() override;
+
+  virtual const uint8_t* Peek(int64_t num_to_peek, int64_t* num_bytes);
+  virtual const uint8_t* Read(int64_t num_to_read, int64_t* num_bytes);
+
+  virtual void Advance(int64_t num_bytes);
+
+ private:
+  // Make the window start at the current position and hold at least
+  // num_bytes bytes, then start reading the bytes after it
+  void Refill(int64_t num_bytes);
+
+  void StartReadAhead();
+
+  // Wait for the read ahead and return its bytes, nullptr if none was started
+  std::shared_ptr<Buffer> FinishReadAhead();
+
+  ::arrow::MemoryPool* pool_;
+  RandomAccessSource* source_;
+  std::shared_ptr<ReadAheadBudget> budget_;
+  int64_t window_size_;
+  int64_t position_;
+  int64_t stream_end_;
+
+  std::shared_ptr<Buffer> window_;
+  int64_t window_start_;
+
+  std::future<std::shared_ptr<Buffer>> read_ahead_;
+  int64_t read_ahead_start_;
+  // Bytes of the read ahead that are reserved from budget_
+  int64_t read_ahead_reserved_;
+};
+
 std::shared_ptr<PoolBuffer> PARQUET_EXPORT AllocateBuffer(::arrow::MemoryPool* pool,
                                                           int64_t size = 0);
 
 std::unique_ptr<PoolBuffer> PARQUET_EXPORT AllocateUniqueBuffer(::arrow::MemoryPool* pool,
                                                                 int64_t size = 0);
 
+// ----------------------------------------------------------------------
+// Read planning
+
+// A contiguous byte range of a RandomAccessSource
+struct PARQUET_EXPORT ReadRange {
+  int64_t offset;
+  int64_t length;
+};
+
+// Sort the ranges by offset and merge those that overlap or are separated by
+// at most hole_size_limit bytes. Reading the bytes of a small hole is usually
+// much cheaper than issuing another request to high-latency storage.
+std::vector<ReadRange> PARQUET_EXPORT CoalesceReadRanges(std::vector<ReadRange> ranges,
+                                                         int64_t hole_size_limit);
+
 }  // namespace parquet
 
 #endif  // PARQUET_UTIL_MEMORY_H
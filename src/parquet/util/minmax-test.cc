@@ -0,0 +1,194 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <random>
+#include <type_traits>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "parquet/util/minmax.h"
+
+namespace parquet {
+
+namespace test {
+
+template <typename T>
+typename std::enable_if<std::is_integral<T>::value, T>::type RandomValue(
+    std::mt19937* gen) {
+  return static_cast<T>(std::uniform_int_distribution<int64_t>(
+      std::numeric_limits<T>::min(), std::numeric_limits<T>::max())(*gen));
+}
+
+template <typename T>
+typename std::enable_if<std::is_floating_point<T>::value, T>::type RandomValue(
+    std::mt19937* gen) {
+  return static_cast<T>(std::uniform_real_distribution<double>(-1e6, 1e6)(*gen));
+}
+
+// The reference compares the values with < on their signed or unsigned type
+// and skips NaNs
+template <typename T>
+typename std::enable_if<std::is_integral<T>::value, bool>::type Less(T a, T b,
+                                                                    bool is_unsigned) {
+  typedef typename std::make_unsigned<T>::type U;
+  return is_unsigned ? static_cast<U>(a) < static_cast<U>(b) : a < b;
+}
+
+template <typename T>
+typename std::enable_if<std::is_floating_point<T>::value, bool>::type Less(T a, T b,
+                                                                          bool) {
+  return a < b;
+}
+
+template <typename T>
+void CheckMinMax(const std::vector<T>& values, const uint8_t* valid_bits,
+                 int64_t valid_bits_offset, bool is_unsigned) {
+  bool expected_found = false;
+  T expected_min = T(), expected_max = T();
+  for (size_t i = 0; i < values.size(); ++i) {
+    const int64_t bit = valid_bits_offset + static_cast<int64_t>(i);
+    if ((valid_bits != nullptr && !((valid_bits[bit / 8] >> (bit % 8)) & 1)) ||
+        std::isnan(static_cast<double>(values[i]))) {
+      continue;
+    }
+    if (!expected_found) {
+      expected_found = true;
+      expected_min = expected_max = values[i];
+    }
+    if (Less(values[i], expected_min, is_unsigned)) expected_min = values[i];
+    if (Less(expected_max, values[i], is_unsigned)) expected_max = values[i];
+  }
+
+  const auto length = static_cast<int64_t>(values.size());
+  for (bool scalar : {false, true}) {
+    T min = T(), max = T();
+    const bool found =
+        scalar ? internal::MinMaxScalar(values.data(), length, valid_bits,
+                                        valid_bits_offset, is_unsigned, &min, &max)
+               : internal::MinMax(values.data(), length, valid_bits, valid_bits_offset,
+                                  is_unsigned, &min, &max);
+    ASSERT_EQ(expected_found, found);
+    if (found) {
+      ASSERT_EQ(expected_min, min);
+      ASSERT_EQ(expected_max, max);
+    }
+  }
+}
+
+template <typename T>
+class TestMinMax : public ::testing::Test {
+ public:
+  // Integers are checked in both sort orders, floating point values as signed
+  std::vector<bool> Orders() const {
+    if (std::is_integral<T>::value) return {false, true};
+    return {false};
+  }
+};
+
+typedef ::testing::Types<int32_t, int64_t, float, double> MinMaxTypes;
+
+TYPED_TEST_CASE(TestMinMax, MinMaxTypes);
+
+TYPED_TEST(TestMinMax, Dense) {
+  std::mt19937 gen(42);
+  for (int length : {0, 1, 3, 4, 7, 8, 9, 31, 100, 1000}) {
+    std::vector<TypeParam> values(length);
+    for (auto& value : values) value = RandomValue<TypeParam>(&gen);
+    for (bool is_unsigned : this->Orders()) {
+      CheckMinMax(values, nullptr, 0, is_unsigned);
+    }
+  }
+}
+
+TYPED_TEST(TestMinMax, Spaced) {
+  std::mt19937 gen(42);
+  for (double null_probability : {0.0, 0.1, 0.5, 0.9, 1.0}) {
+    std::bernoulli_distribution is_null(null_probability);
+    for (int length : {1, 7, 8, 17, 100, 1000}) {
+      for (int64_t offset : {0, 5, 8}) {
+        std::vector<TypeParam> values(length);
+        std::vector<uint8_t> valid_bits((offset + length + 7) / 8, 0);
+        for (int i = 0; i < length; ++i) {
+          values[i] = RandomValue<TypeParam>(&gen);
+          if (!is_null(gen)) {
+            valid_bits[(offset + i) / 8] |=
+                static_cast<uint8_t>(1 << ((offset + i) % 8));
+          }
+        }
+        for (bool is_unsigned : this->Orders()) {
+          CheckMinMax(values, valid_bits.data(), offset, is_unsigned);
+        }
+      }
+    }
+  }
+}
+
+TYPED_TEST(TestMinMax, Extremes) {
+  // The extremes of the type must not be mistaken for the initial state
+  const TypeParam lowest = std::numeric_limits<TypeParam>::lowest();
+  const TypeParam highest = std::numeric_limits<TypeParam>::max();
+  for (int length : {1, 5, 16}) {
+    for (bool is_unsigned : this->Orders()) {
+      CheckMinMax(std::vector<TypeParam>(length, lowest), nullptr, 0, is_unsigned);
+      CheckMinMax(std::vector<TypeParam>(length, highest), nullptr, 0, is_unsigned);
+      std::vector<TypeParam> values(length, static_cast<TypeParam>(0));
+      values[length - 1] = static_cast<TypeParam>(-1);
+      CheckMinMax(values, nullptr, 0, is_unsigned);
+    }
+  }
+}
+
+template <typename T>
+class TestMinMaxFloatingPoint : public ::testing::Test {};
+
+typedef ::testing::Types<float, double> FloatingPointTypes;
+
+TYPED_TEST_CASE(TestMinMaxFloatingPoint, FloatingPointTypes);
+
+TYPED_TEST(TestMinMaxFloatingPoint, NaN) {
+  const TypeParam nan = std::numeric_limits<TypeParam>::quiet_NaN();
+  const TypeParam inf = std::numeric_limits<TypeParam>::infinity();
+  std::mt19937 gen(42);
+  for (int length : {1, 4, 8, 13, 100}) {
+    CheckMinMax(std::vector<TypeParam>(length, nan), nullptr, 0, false);
+    CheckMinMax(std::vector<TypeParam>(length, inf), nullptr, 0, false);
+    CheckMinMax(std::vector<TypeParam>(length, -inf), nullptr, 0, false);
+
+    // NaNs at the start, the end and in between
+    std::vector<TypeParam> values(length);
+    for (int i = 0; i < length; ++i) {
+      values[i] = i % 3 == 0 ? nan : RandomValue<TypeParam>(&gen);
+    }
+    values[length - 1] = nan;
+    CheckMinMax(values, nullptr, 0, false);
+
+    // Only the NaNs are valid
+    std::vector<uint8_t> valid_bits((length + 7) / 8, 0);
+    for (int i = 0; i < length; i += 3) {
+      valid_bits[i / 8] |= static_cast<uint8_t>(1 << (i % 8));
+    }
+    CheckMinMax(values, valid_bits.data(), 0, false);
+  }
+}
+
+}  // namespace test
+
+}  // namespace parquet
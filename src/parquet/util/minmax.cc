@@ -0,0 +1,408 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "parquet/util/minmax.h"
+
+#include <algorithm>
+#include <limits>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define PARQUET_MINMAX_AVX2 1
+#include <immintrin.h>
+#endif
+
+namespace parquet {
+namespace internal {
+
+namespace {
+
+// Integers compared as unsigned are mapped to signed integers of the same
+// order by flipping their sign bit. The mapping is its own inverse.
+template <typename T, bool kUnsigned>
+struct OrderKey {
+  static T Map(T value) { return value; }
+};
+
+template <typename T>
+struct OrderKey<T, true> {
+  static T Map(T value) {
+    return static_cast<T>(value ^ std::numeric_limits<T>::min());
+  }
+};
+
+template <typename T>
+T MinIdentity() {
+  return std::numeric_limits<T>::has_infinity ? std::numeric_limits<T>::infinity()
+                                              : std::numeric_limits<T>::max();
+}
+
+template <typename T>
+T MaxIdentity() {
+  return std::numeric_limits<T>::has_infinity ? -std::numeric_limits<T>::infinity()
+                                              : std::numeric_limits<T>::lowest();
+}
+
+// Running min and max of order keys. A NaN compares false with everything
+// and leaves the state as it is.
+template <typename T>
+struct MinMaxState {
+  MinMaxState() : min(MinIdentity<T>()), max(MaxIdentity<T>()) {}
+
+  void Update(T value) {
+    min = std::min(min, value);
+    max = std::max(max, value);
+  }
+
+  void Merge(T other_min, T other_max) {
+    min = std::min(min, other_min);
+    max = std::max(max, other_max);
+  }
+
+  // The identities are only left in place if no value was seen
+  template <typename Key>
+  bool Finish(T* out_min, T* out_max) const {
+    if (!(min <= max)) {
+      return false;
+    }
+    *out_min = Key::Map(min);
+    *out_max = Key::Map(max);
+    return true;
+  }
+
+  T min;
+  T max;
+};
+
+// num_bits (at most 8) bits of bitmap starting at offset, reading only the
+// bytes they span
+inline uint32_t LoadBits(const uint8_t* bitmap, int64_t offset, int num_bits) {
+  const uint8_t* bytes = bitmap + offset / 8;
+  const int shift = static_cast<int>(offset % 8);
+  uint32_t bits = bytes[0];
+  if (shift + num_bits > 8) {
+    bits |= static_cast<uint32_t>(bytes[1]) << 8;
+  }
+  return (bits >> shift) & ((1u << num_bits) - 1);
+}
+
+template <typename T, typename Key>
+void UpdateRange(const T* values, int64_t begin, int64_t end, const uint8_t* valid_bits,
+                 int64_t valid_bits_offset, MinMaxState<T>* state) {
+  if (valid_bits == nullptr) {
+    for (int64_t i = begin; i < end; ++i) {
+      state->Update(Key::Map(values[i]));
+    }
+    return;
+  }
+  int64_t i = begin;
+  for (; i + 8 <= end; i += 8) {
+    const uint32_t bits = LoadBits(valid_bits, valid_bits_offset + i, 8);
+    if (bits == 0xFF) {
+      for (int j = 0; j < 8; ++j) {
+        state->Update(Key::Map(values[i + j]));
+      }
+    } else {
+      for (int j = 0; j < 8; ++j) {
+        if ((bits >> j) & 1) {
+          state->Update(Key::Map(values[i + j]));
+        }
+      }
+    }
+  }
+  for (; i < end; ++i) {
+    if (LoadBits(valid_bits, valid_bits_offset + i, 1)) {
+      state->Update(Key::Map(values[i]));
+    }
+  }
+}
+
+template <typename T, bool kUnsigned>
+bool MinMaxScalarImpl(const T* values, int64_t length, const uint8_t* valid_bits,
+                      int64_t valid_bits_offset, T* out_min, T* out_max) {
+  typedef OrderKey<T, kUnsigned> Key;
+  MinMaxState<T> state;
+  UpdateRange<T, Key>(values, 0, length, valid_bits, valid_bits_offset, &state);
+  return state.template Finish<Key>(out_min, out_max);
+}
+
+#ifdef PARQUET_MINMAX_AVX2
+
+#define PARQUET_TARGET_AVX2 __attribute__((target("avx2")))
+
+// Operations on a register of values of every type. Min and Max take the
+// accumulator first: the floating point instructions return their second
+// operand if either one is NaN, so a NaN value never replaces the accumulator.
+// Select keeps the lanes of value whose bit is set and takes the others from
+// other.
+struct Int32Lanes {
+  typedef int32_t T;
+  typedef __m256i V;
+  static constexpr int kLanes = 8;
+
+  PARQUET_TARGET_AVX2 static V Load(const T* values) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values));
+  }
+  PARQUET_TARGET_AVX2 static V Set(T value) { return _mm256_set1_epi32(value); }
+  PARQUET_TARGET_AVX2 static V Min(V acc, V value) {
+    return _mm256_min_epi32(acc, value);
+  }
+  PARQUET_TARGET_AVX2 static V Max(V acc, V value) {
+    return _mm256_max_epi32(acc, value);
+  }
+  PARQUET_TARGET_AVX2 static V FlipSign(V value) {
+    return _mm256_xor_si256(value, _mm256_set1_epi32(std::numeric_limits<T>::min()));
+  }
+  PARQUET_TARGET_AVX2 static V Select(uint32_t bits, V value, V other) {
+    const __m256i lane_bits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+    const __m256i set = _mm256_and_si256(_mm256_set1_epi32(static_cast<int>(bits)),
+                                         lane_bits);
+    return _mm256_blendv_epi8(other, value, _mm256_cmpeq_epi32(set, lane_bits));
+  }
+  PARQUET_TARGET_AVX2 static void Store(V v, T* out) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), v);
+  }
+};
+
+struct Int64Lanes {
+  typedef int64_t T;
+  typedef __m256i V;
+  static constexpr int kLanes = 4;
+
+  PARQUET_TARGET_AVX2 static V Load(const T* values) {
+    return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values));
+  }
+  PARQUET_TARGET_AVX2 static V Set(T value) { return _mm256_set1_epi64x(value); }
+  // AVX2 has no 64-bit min and max, they are a compare and a blend
+  PARQUET_TARGET_AVX2 static V Min(V acc, V value) {
+    return _mm256_blendv_epi8(acc, value, _mm256_cmpgt_epi64(acc, value));
+  }
+  PARQUET_TARGET_AVX2 static V Max(V acc, V value) {
+    return _mm256_blendv_epi8(acc, value, _mm256_cmpgt_epi64(value, acc));
+  }
+  PARQUET_TARGET_AVX2 static V FlipSign(V value) {
+    return _mm256_xor_si256(value, _mm256_set1_epi64x(std::numeric_limits<T>::min()));
+  }
+  PARQUET_TARGET_AVX2 static V Select(uint32_t bits, V value, V other) {
+    const __m256i lane_bits = _mm256_setr_epi64x(1, 2, 4, 8);
+    const __m256i set = _mm256_and_si256(_mm256_set1_epi64x(bits), lane_bits);
+    return _mm256_blendv_epi8(other, value, _mm256_cmpeq_epi64(set, lane_bits));
+  }
+  PARQUET_TARGET_AVX2 static void Store(V v, T* out) {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), v);
+  }
+};
+
+struct FloatLanes {
+  typedef float T;
+  typedef __m256 V;
+  static constexpr int kLanes = 8;
+
+  PARQUET_TARGET_AVX2 static V Load(const T* values) { return _mm256_loadu_ps(values); }
+  PARQUET_TARGET_AVX2 static V Set(T value) { return _mm256_set1_ps(value); }
+  PARQUET_TARGET_AVX2 static V Min(V acc, V value) { return _mm256_min_ps(value, acc); }
+  PARQUET_TARGET_AVX2 static V Max(V acc, V value) { return _mm256_max_ps(value, acc); }
+  PARQUET_TARGET_AVX2 static V FlipSign(V value) { return value; }
+  PARQUET_TARGET_AVX2 static V Select(uint32_t bits, V value, V other) {
+    const __m256i lane_bits = _mm256_setr_epi32(1, 2, 4, 8, 16, 32, 64, 128);
+    const __m256i set = _mm256_and_si256(_mm256_set1_epi32(static_cast<int>(bits)),
+                                         lane_bits);
+    const __m256 mask = _mm256_castsi256_ps(_mm256_cmpeq_epi32(set, lane_bits));
+    return _mm256_blendv_ps(other, value, mask);
+  }
+  PARQUET_TARGET_AVX2 static void Store(V v, T* out) { _mm256_storeu_ps(out, v); }
+};
+
+struct DoubleLanes {
+  typedef double T;
+  typedef __m256d V;
+  static constexpr int kLanes = 4;
+
+  PARQUET_TARGET_AVX2 static V Load(const T* values) { return _mm256_loadu_pd(values); }
+  PARQUET_TARGET_AVX2 static V Set(T value) { return _mm256_set1_pd(value); }
+  PARQUET_TARGET_AVX2 static V Min(V acc, V value) { return _mm256_min_pd(value, acc); }
+  PARQUET_TARGET_AVX2 static V Max(V acc, V value) { return _mm256_max_pd(value, acc); }
+  PARQUET_TARGET_AVX2 static V FlipSign(V value) { return value; }
+  PARQUET_TARGET_AVX2 static V Select(uint32_t bits, V value, V other) {
+    const __m256i lane_bits = _mm256_setr_epi64x(1, 2, 4, 8);
+    const __m256i set = _mm256_and_si256(_mm256_set1_epi64x(bits), lane_bits);
+    const __m256d mask = _mm256_castsi256_pd(_mm256_cmpeq_epi64(set, lane_bits));
+    return _mm256_blendv_pd(other, value, mask);
+  }
+  PARQUET_TARGET_AVX2 static void Store(V v, T* out) { _mm256_storeu_pd(out, v); }
+};
+
+// Lane-wise min and max of full registers, the lanes are reduced at the end
+// and the values that do not fill a register are handled by UpdateRange
+template <typename Lanes, bool kUnsigned>
+PARQUET_TARGET_AVX2 bool MinMaxAvx2(const typename Lanes::T* values, int64_t length,
+                                    const uint8_t* valid_bits, int64_t valid_bits_offset,
+                                    typename Lanes::T* out_min,
+                                    typename Lanes::T* out_max) {
+  typedef typename Lanes::T T;
+  typedef typename Lanes::V V;
+  typedef OrderKey<T, kUnsigned> Key;
+  constexpr int kLanes = Lanes::kLanes;
+
+  const V min_identity = Lanes::Set(MinIdentity<T>());
+  const V max_identity = Lanes::Set(MaxIdentity<T>());
+  V min = min_identity;
+  V max = max_identity;
+  const int64_t num_full = length / kLanes * kLanes;
+  if (valid_bits == nullptr) {
+    for (int64_t i = 0; i < num_full; i += kLanes) {
+      V value = Lanes::Load(values + i);
+      if (kUnsigned) {
+        value = Lanes::FlipSign(value);
+      }
+      min = Lanes::Min(min, value);
+      max = Lanes::Max(max, value);
+    }
+  } else {
+    for (int64_t i = 0; i < num_full; i += kLanes) {
+      const uint32_t bits = LoadBits(valid_bits, valid_bits_offset + i, kLanes);
+      if (bits == 0) {
+        continue;
+      }
+      V value = Lanes::Load(values + i);
+      if (kUnsigned) {
+        value = Lanes::FlipSign(value);
+      }
+      min = Lanes::Min(min, Lanes::Select(bits, value, min_identity));
+      max = Lanes::Max(max, Lanes::Select(bits, value, max_identity));
+    }
+  }
+
+  T lane_min[kLanes];
+  T lane_max[kLanes];
+  Lanes::Store(min, lane_min);
+  Lanes::Store(max, lane_max);
+  MinMaxState<T> state;
+  for (int j = 0; j < kLanes; ++j) {
+    state.Merge(lane_min[j], lane_max[j]);
+  }
+  UpdateRange<T, Key>(values, num_full, length, valid_bits, valid_bits_offset, &state);
+  return state.template Finish<Key>(out_min, out_max);
+}
+
+#undef PARQUET_TARGET_AVX2
+
+bool ResolveUseAvx2() {
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx2");
+}
+
+bool UseAvx2() {
+  static const bool use_avx2 = ResolveUseAvx2();
+  return use_avx2;
+}
+
+#endif  // PARQUET_MINMAX_AVX2
+
+}  // namespace
+
+bool MinMaxScalar(const int32_t* values, int64_t length, const uint8_t* valid_bits,
+                  int64_t valid_bits_offset, bool is_unsigned, int32_t* min,
+                  int32_t* max) {
+  return is_unsigned ? MinMaxScalarImpl<int32_t, true>(values, length, valid_bits,
+                                                       valid_bits_offset, min, max)
+                     : MinMaxScalarImpl<int32_t, false>(values, length, valid_bits,
+                                                        valid_bits_offset, min, max);
+}
+
+bool MinMaxScalar(const int64_t* values, int64_t length, const uint8_t* valid_bits,
+                  int64_t valid_bits_offset, bool is_unsigned, int64_t* min,
+                  int64_t* max) {
+  return is_unsigned ? MinMaxScalarImpl<int64_t, true>(values, length, valid_bits,
+                                                       valid_bits_offset, min, max)
+                     : MinMaxScalarImpl<int64_t, false>(values, length, valid_bits,
+                                                        valid_bits_offset, min, max);
+}
+
+bool MinMaxScalar(const float* values, int64_t length, const uint8_t* valid_bits,
+                  int64_t valid_bits_offset, bool, float* min, float* max) {
+  return MinMaxScalarImpl<float, false>(values, length, valid_bits, valid_bits_offset,
+                                        min, max);
+}
+
+bool MinMaxScalar(const double* values, int64_t length, const uint8_t* valid_bits,
+                  int64_t valid_bits_offset, bool, double* min, double* max) {
+  return MinMaxScalarImpl<double, false>(values, length, valid_bits, valid_bits_offset,
+                                         min, max);
+}
+
+bool MinMax(const int32_t* values, int64_t length, const uint8_t* valid_bits,
+            int64_t valid_bits_offset, bool is_unsigned, int32_t* min, int32_t* max) {
+#ifdef PARQUET_MINMAX_AVX2
+  if (UseAvx2()) {
+    return is_unsigned ? MinMaxAvx2<Int32Lanes, true>(values, length, valid_bits,
+                                                      valid_bits_offset, min, max)
+                       : MinMaxAvx2<Int32Lanes, false>(values, length, valid_bits,
+                                                       valid_bits_offset, min, max);
+  }
+#endif
+  return MinMaxScalar(values, length, valid_bits, valid_bits_offset, is_unsigned, min,
+                      max);
+}
+
+bool MinMax(const int64_t* values, int64_t length, const uint8_t* valid_bits,
+            int64_t valid_bits_offset, bool is_unsigned, int64_t* min, int64_t* max) {
+#ifdef PARQUET_MINMAX_AVX2
+  if (UseAvx2()) {
+    return is_unsigned ? MinMaxAvx2<Int64Lanes, true>(values, length, valid_bits,
+                                                      valid_bits_offset, min, max)
+                       : MinMaxAvx2<Int64Lanes, false>(values, length, valid_bits,
+                                                       valid_bits_offset, min, max);
+  }
+#endif
+  return MinMaxScalar(values, length, valid_bits, valid_bits_offset, is_unsigned, min,
+                      max);
+}
+
+bool MinMax(const float* values, int64_t length, const uint8_t* valid_bits,
+            int64_t valid_bits_offset, bool is_unsigned, float* min, float* max) {
+#ifdef PARQUET_MINMAX_AVX2
+  if (UseAvx2()) {
+    return MinMaxAvx2<FloatLanes, false>(values, length, valid_bits, valid_bits_offset,
+                                         min, max);
+  }
+#endif
+  return MinMaxScalar(values, length, valid_bits, valid_bits_offset, is_unsigned, min,
+                      max);
+}
+
+bool MinMax(const double* values, int64_t length, const uint8_t* valid_bits,
+            int64_t valid_bits_offset, bool is_unsigned, double* min, double* max) {
+#ifdef PARQUET_MINMAX_AVX2
+  if (UseAvx2()) {
+    return MinMaxAvx2<DoubleLanes, false>(values, length, valid_bits, valid_bits_offset,
+                                          min, max);
+  }
+#endif
+  return MinMaxScalar(values, length, valid_bits, valid_bits_offset, is_unsigned, min,
+                      max);
+}
+
+bool MinMaxIsVectorized() {
+#ifdef PARQUET_MINMAX_AVX2
+  return UseAvx2();
+#else
+  return false;
+#endif
+}
+
+}  // namespace internal
+}  // namespace parquet
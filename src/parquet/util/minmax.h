@@ -0,0 +1,67 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef PARQUET_UTIL_MINMAX_H
+#define PARQUET_UTIL_MINMAX_H
+
+#include <cstdint>
+
+#include "parquet/util/visibility.h"
+
+namespace parquet {
+namespace internal {
+
+// Min and max of length values, written to min and max. If valid_bits is not
+// nullptr, only the values whose bit is set, starting at valid_bits_offset,
+// are considered. Integers are compared as unsigned if is_unsigned, floating
+// point values always as signed and NaNs are skipped. Returns false, leaving
+// min and max untouched, if no value was considered. Uses AVX2 kernels when
+// the CPU supports them, the choice is made once at the first call.
+PARQUET_EXPORT bool MinMax(const int32_t* values, int64_t length,
+                           const uint8_t* valid_bits, int64_t valid_bits_offset,
+                           bool is_unsigned, int32_t* min, int32_t* max);
+PARQUET_EXPORT bool MinMax(const int64_t* values, int64_t length,
+                           const uint8_t* valid_bits, int64_t valid_bits_offset,
+                           bool is_unsigned, int64_t* min, int64_t* max);
+PARQUET_EXPORT bool MinMax(const float* values, int64_t length, const uint8_t* valid_bits,
+                           int64_t valid_bits_offset, bool is_unsigned, float* min,
+                           float* max);
+PARQUET_EXPORT bool MinMax(const double* values, int64_t length,
+                           const uint8_t* valid_bits, int64_t valid_bits_offset,
+                           bool is_unsigned, double* min, double* max);
+
+// Portable implementations of MinMax
+PARQUET_EXPORT bool MinMaxScalar(const int32_t* values, int64_t length,
+                                 const uint8_t* valid_bits, int64_t valid_bits_offset,
+                                 bool is_unsigned, int32_t* min, int32_t* max);
+PARQUET_EXPORT bool MinMaxScalar(const int64_t* values, int64_t length,
+                                 const uint8_t* valid_bits, int64_t valid_bits_offset,
+                                 bool is_unsigned, int64_t* min, int64_t* max);
+PARQUET_EXPORT bool MinMaxScalar(const float* values, int64_t length,
+                                 const uint8_t* valid_bits, int64_t valid_bits_offset,
+                                 bool is_unsigned, float* min, float* max);
+PARQUET_EXPORT bool MinMaxScalar(const double* values, int64_t length,
+                                 const uint8_t* valid_bits, int64_t valid_bits_offset,
+                                 bool is_unsigned, double* min, double* max);
+
+// True if MinMax dispatches to SIMD kernels on this machine
+PARQUET_EXPORT bool MinMaxIsVectorized();
+
+}  // namespace internal
+}  // namespace parquet
+
+#endif  // PARQUET_UTIL_MINMAX_H
@@ -0,0 +1,387 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef PARQUET_UTIL_RLE_DECODER_H
+#define PARQUET_UTIL_RLE_DECODER_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+
+#include "arrow/util/bit-util.h"
+
+#include "parquet/exception.h"
+#include "parquet/util/bit-unpack.h"
+#include "parquet/util/logging.h"
+#include "parquet/util/spacing.h"
+
+namespace parquet {
+
+// Decoder for the RLE / bit-packing hybrid encoding used for repetition and
+// definition levels and for dictionary indices. Bit-packed runs are unpacked
+// in blocks with internal::UnpackBits32 and then converted, or looked up in a
+// dictionary, from that block.
+class RleBitPackedDecoder {
+ public:
+  RleBitPackedDecoder() { Reset(nullptr, 0, 0); }
+
+  RleBitPackedDecoder(const uint8_t* data, int length, int bit_width) {
+    Reset(data, length, bit_width);
+  }
+
+  void Reset(const uint8_t* data, int length, int bit_width) {
+    DCHECK_GE(bit_width, 0);
+    DCHECK_LE(bit_width, 32);
+    data_ = data;
+    end_ = data + length;
+    bit_width_ = bit_width;
+    repeat_count_ = 0;
+    literal_count_ = 0;
+    current_value_ = 0;
+    buffer_pos_ = 0;
+    buffer_length_ = 0;
+  }
+
+  // Decode up to batch_size values, returns the number of values decoded
+  template <typename T>
+  int GetBatch(T* values, int batch_size) {
+    return GetBatchImpl(values, batch_size,
+                        [](uint32_t value) { return static_cast<T>(value); });
+  }
+
+  // Decode up to batch_size indices and store the dictionary entries they
+  // refer to. Throws if an index is outside of the dictionary.
+  template <typename T>
+  int GetBatchWithDict(const T* dictionary, int64_t dictionary_length, T* values,
+                       int batch_size) {
+    return GetBatchImpl(values, batch_size, [=](uint32_t index) {
+      if (index >= dictionary_length) {
+        throw ParquetException("Dictionary index out of bounds");
+      }
+      return dictionary[index];
+    });
+  }
+
+  // Decode up to batch_size values of bit width 1 into the bits of valid_bits,
+  // starting at valid_bits_offset, and add the number of zeros to null_count.
+  // Repeated runs are written as ranges of bits and bit-packed runs are
+  // copied over, their bytes already are a bitmap. Bits that follow the decoded
+  // ones in the same byte may be cleared. Returns the number of values decoded.
+  int GetBatchBitmap(uint8_t* valid_bits, int64_t valid_bits_offset, int batch_size,
+                     int64_t* null_count);
+
+  // Skip up to num_values values, returns the number of values skipped.
+  // Repeated runs are skipped by count and whole groups of 8 bit-packed
+  // values by advancing over their bytes, without unpacking them.
+  int Skip(int num_values);
+
+  // Skip up to num_values values as long as they equal value, returns the
+  // number of values skipped. Repeated runs are compared once, bit-packed ones
+  // value by value. For sources that know what the values should be, like
+  // indices into a dictionary of one entry.
+  int SkipEqual(uint32_t value, int num_values);
+
+  // Decode up to batch_size values as up to max_runs runs of equal values,
+  // values[i] repeated run_lengths[i] times. Repeated runs are returned whole,
+  // bit-packed values are merged with their equal neighbours. The runs of two
+  // calls can have the same value. Returns the number of runs and stores the
+  // number of values they hold in num_values.
+  template <typename T>
+  int GetRuns(T* values, int32_t* run_lengths, int max_runs, int batch_size,
+              int* num_values);
+
+  // Number of values left in the repeated run at the current position, whose
+  // value is stored in value. 0 if the following values are bit-packed or
+  // there are none. The header of the next run is read if the current one is
+  // exhausted, no values are consumed.
+  int64_t RepeatedRunLength(uint32_t* value) {
+    if (repeat_count_ == 0 && buffer_pos_ == buffer_length_ && literal_count_ == 0) {
+      NextRun();
+    }
+    if (repeat_count_ == 0) {
+      return 0;
+    }
+    *value = current_value_;
+    return repeat_count_;
+  }
+
+ private:
+  // Number of values unpacked at once from a bit-packed run, a multiple of 8
+  static constexpr int kBufferSize = 1024;
+
+  template <typename T, typename Convert>
+  int GetBatchImpl(T* values, int batch_size, Convert&& convert);
+
+  // Read the header of the next non-empty run
+  bool NextRun();
+
+  // Unpack the next block of the current bit-packed run into buffer_
+  bool FillBuffer();
+
+  const uint8_t* data_;
+  const uint8_t* end_;
+  int bit_width_;
+
+  // Values left in the current repeated run and its value
+  int64_t repeat_count_;
+  uint32_t current_value_;
+
+  // Values of the current bit-packed run that are not unpacked yet
+  int64_t literal_count_;
+
+  uint32_t buffer_[kBufferSize];
+  int buffer_pos_;
+  int buffer_length_;
+};
+
+template <typename T, typename Convert>
+inline int RleBitPackedDecoder::GetBatchImpl(T* values, int batch_size,
+                                             Convert&& convert) {
+  int values_read = 0;
+  while (values_read < batch_size) {
+    const int remaining = batch_size - values_read;
+    if (repeat_count_ > 0) {
+      const int n = static_cast<int>(std::min<int64_t>(remaining, repeat_count_));
+      std::fill(values + values_read, values + values_read + n, convert(current_value_));
+      repeat_count_ -= n;
+      values_read += n;
+    } else if (buffer_pos_ < buffer_length_) {
+      const int n = std::min(remaining, buffer_length_ - buffer_pos_);
+      const uint32_t* block = buffer_ + buffer_pos_;
+      T* out = values + values_read;
+      for (int i = 0; i < n; ++i) {
+        out[i] = convert(block[i]);
+      }
+      buffer_pos_ += n;
+      values_read += n;
+    } else if (literal_count_ > 0) {
+      if (!FillBuffer()) break;
+    } else if (!NextRun()) {
+      break;
+    }
+  }
+  return values_read;
+}
+
+inline int RleBitPackedDecoder::Skip(int num_values) {
+  int values_skipped = 0;
+  while (values_skipped < num_values) {
+    const int remaining = num_values - values_skipped;
+    if (repeat_count_ > 0) {
+      const int n = static_cast<int>(std::min<int64_t>(remaining, repeat_count_));
+      repeat_count_ -= n;
+      values_skipped += n;
+    } else if (buffer_pos_ < buffer_length_) {
+      const int n = std::min(remaining, buffer_length_ - buffer_pos_);
+      buffer_pos_ += n;
+      values_skipped += n;
+    } else if (literal_count_ > 0) {
+      // Bit-packed runs hold a multiple of 8 values, so skipping whole groups
+      // of 8 keeps data_ byte aligned
+      const int64_t n = std::min<int64_t>(remaining, literal_count_) / 8 * 8;
+      const int64_t num_bytes = n * bit_width_ / 8;
+      if (n > 0 && num_bytes <= end_ - data_) {
+        data_ += num_bytes;
+        literal_count_ -= n;
+        values_skipped += static_cast<int>(n);
+      } else if (!FillBuffer()) {
+        break;
+      }
+    } else if (!NextRun()) {
+      break;
+    }
+  }
+  return values_skipped;
+}
+
+inline int RleBitPackedDecoder::SkipEqual(uint32_t value, int num_values) {
+  int values_skipped = 0;
+  while (values_skipped < num_values) {
+    const int remaining = num_values - values_skipped;
+    if (repeat_count_ > 0) {
+      if (current_value_ != value) break;
+      const int n = static_cast<int>(std::min<int64_t>(remaining, repeat_count_));
+      repeat_count_ -= n;
+      values_skipped += n;
+    } else if (buffer_pos_ < buffer_length_) {
+      const int n = std::min(remaining, buffer_length_ - buffer_pos_);
+      int i = 0;
+      while (i < n && buffer_[buffer_pos_ + i] == value) ++i;
+      buffer_pos_ += i;
+      values_skipped += i;
+      if (i < n) break;
+    } else if (literal_count_ > 0) {
+      if (!FillBuffer()) break;
+    } else if (!NextRun()) {
+      break;
+    }
+  }
+  return values_skipped;
+}
+
+template <typename T>
+inline int RleBitPackedDecoder::GetRuns(T* values, int32_t* run_lengths, int max_runs,
+                                        int batch_size, int* num_values) {
+  int num_runs = 0;
+  int values_read = 0;
+  // Extend the last run by n copies of value or start a new one, returns
+  // false if there is no room for it
+  auto append = [&](T value, int n) {
+    if (num_runs > 0 && values[num_runs - 1] == value) {
+      run_lengths[num_runs - 1] += n;
+    } else if (num_runs < max_runs) {
+      values[num_runs] = value;
+      run_lengths[num_runs] = n;
+      ++num_runs;
+    } else {
+      return false;
+    }
+    return true;
+  };
+  while (values_read < batch_size) {
+    const int remaining = batch_size - values_read;
+    if (repeat_count_ > 0) {
+      const int n = static_cast<int>(std::min<int64_t>(remaining, repeat_count_));
+      if (!append(static_cast<T>(current_value_), n)) break;
+      repeat_count_ -= n;
+      values_read += n;
+    } else if (buffer_pos_ < buffer_length_) {
+      const int n = std::min(remaining, buffer_length_ - buffer_pos_);
+      int i = 0;
+      while (i < n && append(static_cast<T>(buffer_[buffer_pos_ + i]), 1)) ++i;
+      buffer_pos_ += i;
+      values_read += i;
+      if (i < n) break;
+    } else if (literal_count_ > 0) {
+      if (!FillBuffer()) break;
+    } else if (!NextRun()) {
+      break;
+    }
+  }
+  *num_values = values_read;
+  return num_runs;
+}
+
+inline int RleBitPackedDecoder::GetBatchBitmap(uint8_t* valid_bits,
+                                               int64_t valid_bits_offset, int batch_size,
+                                               int64_t* null_count) {
+  DCHECK_EQ(bit_width_, 1);
+  int values_read = 0;
+  while (values_read < batch_size) {
+    const int remaining = batch_size - values_read;
+    const int64_t offset = valid_bits_offset + values_read;
+    if (repeat_count_ > 0) {
+      const int n = static_cast<int>(std::min<int64_t>(remaining, repeat_count_));
+      const bool is_set = current_value_ != 0;
+      internal::SetBits(valid_bits, offset, n, is_set);
+      if (!is_set) {
+        *null_count += n;
+      }
+      repeat_count_ -= n;
+      values_read += n;
+    } else if (buffer_pos_ < buffer_length_) {
+      const int n = std::min(remaining, buffer_length_ - buffer_pos_);
+      for (int i = 0; i < n; ++i) {
+        const bool is_set = buffer_[buffer_pos_ + i] != 0;
+        ::arrow::BitUtil::SetBitTo(valid_bits, offset + i, is_set);
+        *null_count += is_set ? 0 : 1;
+      }
+      buffer_pos_ += n;
+      values_read += n;
+    } else if (literal_count_ > 0) {
+      // Groups of 8 values are single bytes of the bitmap at bit width 1
+      const int64_t n = std::min<int64_t>(remaining, literal_count_) / 8 * 8;
+      const int64_t num_bytes = n / 8;
+      if (n > 0 && num_bytes <= end_ - data_) {
+        const int shift = static_cast<int>(offset % 8);
+        uint8_t* out = valid_bits + offset / 8;
+        if (shift == 0) {
+          memcpy(out, data_, static_cast<size_t>(num_bytes));
+        } else {
+          // Merge every byte into the two bytes of valid_bits it straddles
+          const uint8_t low_mask = static_cast<uint8_t>((1 << shift) - 1);
+          for (int64_t i = 0; i < num_bytes; ++i) {
+            out[i] = static_cast<uint8_t>((out[i] & low_mask) | (data_[i] << shift));
+            out[i + 1] = static_cast<uint8_t>(data_[i] >> (8 - shift));
+          }
+        }
+        *null_count += n - ::arrow::CountSetBits(data_, 0, n);
+        data_ += num_bytes;
+        literal_count_ -= n;
+        values_read += static_cast<int>(n);
+      } else if (!FillBuffer()) {
+        break;
+      }
+    } else if (!NextRun()) {
+      break;
+    }
+  }
+  return values_read;
+}
+
+inline bool RleBitPackedDecoder::NextRun() {
+  while (repeat_count_ == 0 && literal_count_ == 0) {
+    // ULEB128 run header, the lowest bit tells the kind of the run
+    uint32_t indicator = 0;
+    int shift = 0;
+    uint8_t byte = 0;
+    do {
+      if (data_ >= end_ || shift > 28) return false;
+      byte = *data_++;
+      indicator |= static_cast<uint32_t>(byte & 0x7F) << shift;
+      shift += 7;
+    } while (byte & 0x80);
+
+    if (indicator & 1) {
+      literal_count_ = static_cast<int64_t>(indicator >> 1) * 8;
+    } else {
+      repeat_count_ = indicator >> 1;
+      const int num_bytes = (bit_width_ + 7) / 8;
+      if (end_ - data_ < num_bytes) return false;
+      current_value_ = 0;
+      for (int i = 0; i < num_bytes; ++i) {
+        current_value_ |= static_cast<uint32_t>(data_[i]) << (8 * i);
+      }
+      data_ += num_bytes;
+    }
+  }
+  return true;
+}
+
+inline bool RleBitPackedDecoder::FillBuffer() {
+  int n = static_cast<int>(std::min<int64_t>(literal_count_, kBufferSize));
+  const int64_t available = end_ - data_;
+  if (bit_width_ > 0 && static_cast<int64_t>(n / 8) * bit_width_ > available) {
+    // Truncated run, only keep the values that are completely present
+    n = static_cast<int>(std::min<int64_t>(n, available * 8 / bit_width_));
+    literal_count_ = n;
+  }
+  if (n == 0) {
+    literal_count_ = 0;
+    return false;
+  }
+  internal::UnpackBits32(data_, available, n, bit_width_, buffer_);
+  data_ += (static_cast<int64_t>(n) * bit_width_ + 7) / 8;
+  literal_count_ -= n;
+  buffer_pos_ = 0;
+  buffer_length_ = n;
+  return true;
+}
+
+}  // namespace parquet
+
+#endif  // PARQUET_UTIL_RLE_DECODER_H
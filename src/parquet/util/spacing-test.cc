@@ -0,0 +1,169 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <cstdint>
+#include <cstring>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "parquet/util/spacing.h"
+
+namespace parquet {
+
+namespace test {
+
+template <int N>
+struct Value {
+  uint8_t bytes[N];
+
+  bool operator==(const Value& other) const {
+    return memcmp(bytes, other.bytes, N) == 0;
+  }
+};
+
+// Spaces the dense values with SpaceValues and SpaceValuesScalar, at bit
+// offsets that are and are not byte aligned, and compares the present values
+template <typename T>
+void CheckSpaceValues(double null_probability) {
+  std::mt19937 gen(42);
+  std::bernoulli_distribution is_null(null_probability);
+  std::uniform_int_distribution<int> byte(0, 255);
+
+  for (int num_values : {0, 1, 7, 8, 15, 16, 17, 100, 1000}) {
+    for (int64_t offset : {0, 3, 8, 13}) {
+      std::vector<uint8_t> valid_bits((offset + num_values + 7) / 8, 0);
+      std::vector<T> expected(num_values);
+      std::vector<T> dense;
+      for (int i = 0; i < num_values; ++i) {
+        if (!is_null(gen)) {
+          valid_bits[(offset + i) / 8] |= static_cast<uint8_t>(1 << ((offset + i) % 8));
+          T value;
+          for (auto& b : reinterpret_cast<uint8_t(&)[sizeof(T)]>(value)) {
+            b = static_cast<uint8_t>(byte(gen));
+          }
+          expected[i] = value;
+          dense.push_back(value);
+        }
+      }
+      const int null_count = num_values - static_cast<int>(dense.size());
+
+      for (bool scalar : {false, true}) {
+        std::vector<T> buffer(dense);
+        buffer.resize(num_values);
+        uint8_t* bytes = reinterpret_cast<uint8_t*>(buffer.data());
+        if (scalar) {
+          internal::SpaceValuesScalar(bytes, static_cast<int>(sizeof(T)), num_values,
+                                      null_count, valid_bits.data(), offset);
+        } else {
+          internal::SpaceValues(buffer.data(), num_values, null_count, valid_bits.data(),
+                                offset);
+        }
+        for (int i = 0; i < num_values; ++i) {
+          if ((valid_bits[(offset + i) / 8] >> ((offset + i) % 8)) & 1) {
+            ASSERT_TRUE(expected[i] == buffer[i])
+                << num_values << " " << offset << " " << i;
+          }
+        }
+      }
+    }
+  }
+}
+
+template <typename T>
+class TestSpaceValues : public ::testing::Test {};
+
+typedef ::testing::Types<uint8_t, uint32_t, uint64_t, Value<12>, Value<16>, Value<3>>
+    SpaceValuesTypes;
+
+TYPED_TEST_CASE(TestSpaceValues, SpaceValuesTypes);
+
+TYPED_TEST(TestSpaceValues, Sparse) { CheckSpaceValues<TypeParam>(0.9); }
+
+TYPED_TEST(TestSpaceValues, Half) { CheckSpaceValues<TypeParam>(0.5); }
+
+TYPED_TEST(TestSpaceValues, Dense) { CheckSpaceValues<TypeParam>(0.05); }
+
+TYPED_TEST(TestSpaceValues, NoNulls) { CheckSpaceValues<TypeParam>(0); }
+
+TYPED_TEST(TestSpaceValues, AllNulls) { CheckSpaceValues<TypeParam>(1); }
+
+static bool GetBit(const std::vector<uint8_t>& bits, int64_t i) {
+  return (bits[i / 8] >> (i % 8)) & 1;
+}
+
+TEST(CopyBits, Offsets) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int> byte(0, 255);
+  std::vector<uint8_t> src(40);
+  for (auto& b : src) {
+    b = static_cast<uint8_t>(byte(gen));
+  }
+
+  for (int64_t src_offset : {0, 3, 8, 13}) {
+    for (int64_t dst_offset : {0, 5, 16}) {
+      for (int64_t length : {0, 1, 7, 8, 9, 64, 250}) {
+        std::vector<uint8_t> dst(40, 0xA5);
+        const std::vector<uint8_t> before = dst;
+        internal::CopyBits(src.data(), src_offset, length, dst.data(), dst_offset);
+        for (int64_t i = 0; i < 320; ++i) {
+          const bool expected = i >= dst_offset && i < dst_offset + length
+                                    ? GetBit(src, src_offset + i - dst_offset)
+                                    : GetBit(before, i);
+          ASSERT_EQ(expected, GetBit(dst, i)) << src_offset << " " << dst_offset << " "
+                                              << length << " " << i;
+        }
+      }
+    }
+  }
+}
+
+TEST(SetBits, Offsets) {
+  for (bool value : {true, false}) {
+    for (int64_t offset : {0, 3, 8, 13}) {
+      for (int64_t length : {0, 1, 5, 8, 9, 64, 250}) {
+        std::vector<uint8_t> bits(40, 0xA5);
+        const std::vector<uint8_t> before = bits;
+        internal::SetBits(bits.data(), offset, length, value);
+        for (int64_t i = 0; i < 320; ++i) {
+          const bool expected =
+              i >= offset && i < offset + length ? value : GetBit(before, i);
+          ASSERT_EQ(expected, GetBit(bits, i)) << offset << " " << length << " " << i;
+        }
+      }
+    }
+  }
+}
+
+TEST(SpaceBits, Nulls) {
+  // Values 1, 0, 1, 1 spread to the valid slots 1, 2, 4, 5 of 7
+  const std::vector<uint8_t> src = {0x0D << 2};
+  const std::vector<uint8_t> valid_bits = {0x36 << 1};
+  std::vector<uint8_t> dst = {0xFF, 0xFF};
+  internal::SpaceBits(src.data(), 2, 7, valid_bits.data(), 1, dst.data(), 3);
+  const bool expected[] = {false, true, false, false, true, true, false};
+  for (int64_t i = 0; i < 7; ++i) {
+    ASSERT_EQ(expected[i], GetBit(dst, 3 + i)) << i;
+  }
+  ASSERT_EQ(0x07, dst[0] & 0x07);
+  ASSERT_EQ(0xFC, dst[1] & 0xFC);
+}
+
+}  // namespace test
+
+}  // namespace parquet
@@ -0,0 +1,295 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "parquet/util/spacing.h"
+
+#include <cstring>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define PARQUET_SPACE_AVX512 1
+#include <immintrin.h>
+#endif
+
+namespace parquet {
+namespace internal {
+
+namespace {
+
+// Positions of the set bits of every byte value
+struct SetBitPositions {
+  SetBitPositions() {
+    for (int byte = 0; byte < 256; ++byte) {
+      count[byte] = 0;
+      for (int bit = 0; bit < 8; ++bit) {
+        if (byte & (1 << bit)) {
+          positions[byte][count[byte]++] = static_cast<uint8_t>(bit);
+        }
+      }
+    }
+  }
+
+  uint8_t positions[256][8];
+  uint8_t count[256];
+};
+
+const SetBitPositions& GetSetBitPositions() {
+  static const SetBitPositions table;
+  return table;
+}
+
+inline bool GetBit(const uint8_t* bitmap, int64_t i) {
+  return (bitmap[i >> 3] >> (i & 7)) & 1;
+}
+
+// The num_bits bits (at most 16) of bitmap at offset, as the low bits of the
+// result. Only the bytes that hold them are read.
+inline uint32_t LoadBits(const uint8_t* bitmap, int64_t offset, int num_bits) {
+  const int64_t first = offset >> 3;
+  const int64_t last = (offset + num_bits - 1) >> 3;
+  uint32_t word = 0;
+  for (int64_t i = first; i <= last; ++i) {
+    word |= static_cast<uint32_t>(bitmap[i]) << (8 * (i - first));
+  }
+  return (word >> (offset & 7)) & ((1u << num_bits) - 1);
+}
+
+template <int N>
+struct Bytes {
+  uint8_t data[N];
+};
+
+// Space the slots from first_slot on one by one and return the number of
+// values left for the slots before. As the values were filled in from the
+// front, all implementations space them from the back.
+template <typename T>
+int SpaceTail(T* buffer, int num_values, int first_slot, int values_left,
+              const uint8_t* valid_bits, int64_t valid_bits_offset) {
+  for (int i = num_values - 1; i >= first_slot; --i) {
+    if (GetBit(valid_bits, valid_bits_offset + i)) {
+      buffer[i] = buffer[--values_left];
+    }
+  }
+  return values_left;
+}
+
+// Groups of 8 slots, the set bits of their byte of valid_bits are looked up
+template <typename T>
+void SpaceValuesTable(T* buffer, int num_values, int values_left,
+                      const uint8_t* valid_bits, int64_t valid_bits_offset) {
+  const SetBitPositions& table = GetSetBitPositions();
+  const int num_groups = num_values / 8;
+  values_left = SpaceTail(buffer, num_values, num_groups * 8, values_left, valid_bits,
+                          valid_bits_offset);
+  for (int g = num_groups - 1; g >= 0; --g) {
+    const uint32_t byte = LoadBits(valid_bits, valid_bits_offset + 8 * g, 8);
+    const int count = table.count[byte];
+    const uint8_t* positions = table.positions[byte];
+    values_left -= count;
+    // The slot of a value is never before it, moving the last value first
+    // does not overwrite the others
+    const T* values = buffer + values_left;
+    T* slots = buffer + 8 * g;
+    for (int j = count - 1; j >= 0; --j) {
+      slots[positions[j]] = values[j];
+    }
+  }
+}
+
+// Values of other sizes, one by one
+void SpaceValuesBytes(uint8_t* buffer, int value_size, int num_values, int values_left,
+                      const uint8_t* valid_bits, int64_t valid_bits_offset) {
+  for (int i = num_values - 1; i >= 0; --i) {
+    if (GetBit(valid_bits, valid_bits_offset + i)) {
+      --values_left;
+      memmove(buffer + static_cast<int64_t>(i) * value_size,
+              buffer + static_cast<int64_t>(values_left) * value_size, value_size);
+    }
+  }
+}
+
+#ifdef PARQUET_SPACE_AVX512
+
+// VPEXPAND loads as many consecutive values as a group has set bits and
+// places them in the lanes of the set bits, the other lanes are zeroed
+__attribute__((target("avx512f"))) void SpaceValues32Avx512(
+    uint32_t* buffer, int num_values, int values_left, const uint8_t* valid_bits,
+    int64_t valid_bits_offset) {
+  const int num_groups = num_values / 16;
+  values_left = SpaceTail(buffer, num_values, num_groups * 16, values_left, valid_bits,
+                          valid_bits_offset);
+  for (int g = num_groups - 1; g >= 0; --g) {
+    const uint32_t mask = LoadBits(valid_bits, valid_bits_offset + 16 * g, 16);
+    values_left -= __builtin_popcount(mask);
+    const __m512i v = _mm512_maskz_expandloadu_epi32(static_cast<__mmask16>(mask),
+                                                     buffer + values_left);
+    _mm512_storeu_si512(buffer + 16 * g, v);
+  }
+}
+
+__attribute__((target("avx512f"))) void SpaceValues64Avx512(
+    uint64_t* buffer, int num_values, int values_left, const uint8_t* valid_bits,
+    int64_t valid_bits_offset) {
+  const int num_groups = num_values / 8;
+  values_left = SpaceTail(buffer, num_values, num_groups * 8, values_left, valid_bits,
+                          valid_bits_offset);
+  for (int g = num_groups - 1; g >= 0; --g) {
+    const uint32_t mask = LoadBits(valid_bits, valid_bits_offset + 8 * g, 8);
+    values_left -= __builtin_popcount(mask);
+    const __m512i v =
+        _mm512_maskz_expandloadu_epi64(static_cast<__mmask8>(mask), buffer + values_left);
+    _mm512_storeu_si512(buffer + 8 * g, v);
+  }
+}
+
+#endif  // PARQUET_SPACE_AVX512
+
+bool ResolveHasAvx512() {
+#ifdef PARQUET_SPACE_AVX512
+  __builtin_cpu_init();
+  return __builtin_cpu_supports("avx512f");
+#else
+  return false;
+#endif
+}
+
+bool HasAvx512() {
+  static const bool has_avx512 = ResolveHasAvx512();
+  return has_avx512;
+}
+
+}  // namespace
+
+void SpaceValuesScalar(uint8_t* buffer, int value_size, int num_values, int null_count,
+                       const uint8_t* valid_bits, int64_t valid_bits_offset) {
+  const int values_left = num_values - null_count;
+  switch (value_size) {
+    case 1:
+      SpaceValuesTable(buffer, num_values, values_left, valid_bits, valid_bits_offset);
+      break;
+    case 4:
+      SpaceValuesTable(reinterpret_cast<uint32_t*>(buffer), num_values, values_left,
+                       valid_bits, valid_bits_offset);
+      break;
+    case 8:
+      SpaceValuesTable(reinterpret_cast<uint64_t*>(buffer), num_values, values_left,
+                       valid_bits, valid_bits_offset);
+      break;
+    case 12:
+      SpaceValuesTable(reinterpret_cast<Bytes<12>*>(buffer), num_values, values_left,
+                       valid_bits, valid_bits_offset);
+      break;
+    case 16:
+      SpaceValuesTable(reinterpret_cast<Bytes<16>*>(buffer), num_values, values_left,
+                       valid_bits, valid_bits_offset);
+      break;
+    default:
+      SpaceValuesBytes(buffer, value_size, num_values, values_left, valid_bits,
+                       valid_bits_offset);
+      break;
+  }
+}
+
+void SpaceValues(uint8_t* buffer, int value_size, int num_values, int null_count,
+                 const uint8_t* valid_bits, int64_t valid_bits_offset) {
+  if (null_count == 0) {
+    // Every slot holds its value already
+    return;
+  }
+#ifdef PARQUET_SPACE_AVX512
+  if (SpaceValuesIsVectorized(value_size)) {
+    const int values_left = num_values - null_count;
+    if (value_size == 4) {
+      SpaceValues32Avx512(reinterpret_cast<uint32_t*>(buffer), num_values, values_left,
+                          valid_bits, valid_bits_offset);
+    } else {
+      SpaceValues64Avx512(reinterpret_cast<uint64_t*>(buffer), num_values, values_left,
+                          valid_bits, valid_bits_offset);
+    }
+    return;
+  }
+#endif
+  SpaceValuesScalar(buffer, value_size, num_values, null_count, valid_bits,
+                    valid_bits_offset);
+}
+
+bool SpaceValuesIsVectorized(int value_size) {
+  return (value_size == 4 || value_size == 8) && HasAvx512();
+}
+
+namespace {
+
+inline void SetBitTo(uint8_t* bits, int64_t i, bool value) {
+  const uint8_t mask = static_cast<uint8_t>(1 << (i % 8));
+  bits[i / 8] = static_cast<uint8_t>(value ? bits[i / 8] | mask : bits[i / 8] & ~mask);
+}
+
+}  // namespace
+
+void CopyBits(const uint8_t* src, int64_t src_offset, int64_t length, uint8_t* dst,
+              int64_t dst_offset) {
+  // Bit by bit up to a byte boundary of dst
+  for (; length > 0 && dst_offset % 8 != 0; --length) {
+    SetBitTo(dst, dst_offset++, GetBit(src, src_offset++));
+  }
+
+  const int64_t num_bytes = length / 8;
+  const uint8_t* in = src + src_offset / 8;
+  uint8_t* out = dst + dst_offset / 8;
+  const int shift = static_cast<int>(src_offset % 8);
+  if (shift == 0) {
+    memcpy(out, in, static_cast<size_t>(num_bytes));
+  } else {
+    // The bits of byte i of out are in bytes i and i + 1 of in, which are both
+    // part of the copied bits
+    for (int64_t i = 0; i < num_bytes; ++i) {
+      out[i] = static_cast<uint8_t>((in[i] >> shift) | (in[i + 1] << (8 - shift)));
+    }
+  }
+  src_offset += num_bytes * 8;
+  dst_offset += num_bytes * 8;
+  length -= num_bytes * 8;
+
+  for (; length > 0; --length) {
+    SetBitTo(dst, dst_offset++, GetBit(src, src_offset++));
+  }
+}
+
+void SetBits(uint8_t* bits, int64_t offset, int64_t length, bool value) {
+  for (; length > 0 && offset % 8 != 0; --length) {
+    SetBitTo(bits, offset++, value);
+  }
+  const int64_t num_bytes = length / 8;
+  memset(bits + offset / 8, value ? 0xFF : 0, static_cast<size_t>(num_bytes));
+  offset += num_bytes * 8;
+  length -= num_bytes * 8;
+  for (; length > 0; --length) {
+    SetBitTo(bits, offset++, value);
+  }
+}
+
+void SpaceBits(const uint8_t* src, int64_t src_offset, int64_t length,
+               const uint8_t* valid_bits, int64_t valid_bits_offset, uint8_t* dst,
+               int64_t dst_offset) {
+  for (int64_t i = 0; i < length; ++i) {
+    const bool is_valid = GetBit(valid_bits, valid_bits_offset + i);
+    SetBitTo(dst, dst_offset + i, is_valid && GetBit(src, src_offset));
+    src_offset += is_valid;
+  }
+}
+
+}  // namespace internal
+}  // namespace parquet
@@ -0,0 +1,75 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef PARQUET_UTIL_SPACING_H
+#define PARQUET_UTIL_SPACING_H
+
+#include <cstdint>
+
+#include "parquet/util/visibility.h"
+
+namespace parquet {
+namespace internal {
+
+// Spread the first num_values - null_count values of buffer, in place and in
+// order, to the num_values slots whose bit in valid_bits is set, starting at
+// valid_bits_offset. The slots of nulls are left initialized but unspecified.
+// Values of 4 and 8 bytes are expanded with AVX-512 when the CPU supports it,
+// the choice is made once at the first call. Otherwise, and for the other
+// sizes, the positions of the set bits of every byte of valid_bits are looked
+// up in a table.
+PARQUET_EXPORT void SpaceValues(uint8_t* buffer, int value_size, int num_values,
+                                int null_count, const uint8_t* valid_bits,
+                                int64_t valid_bits_offset);
+
+template <typename T>
+inline void SpaceValues(T* buffer, int num_values, int null_count,
+                        const uint8_t* valid_bits, int64_t valid_bits_offset) {
+  SpaceValues(reinterpret_cast<uint8_t*>(buffer), static_cast<int>(sizeof(T)),
+              num_values, null_count, valid_bits, valid_bits_offset);
+}
+
+// Table based implementation of SpaceValues
+PARQUET_EXPORT void SpaceValuesScalar(uint8_t* buffer, int value_size, int num_values,
+                                      int null_count, const uint8_t* valid_bits,
+                                      int64_t valid_bits_offset);
+
+// True if SpaceValues dispatches values of value_size bytes to a SIMD kernel
+// on this machine
+PARQUET_EXPORT bool SpaceValuesIsVectorized(int value_size);
+
+// Copy the length bits of src starting at bit src_offset to dst starting at
+// bit dst_offset. The other bits of dst are kept. Whole bytes of dst are
+// written at once.
+PARQUET_EXPORT void CopyBits(const uint8_t* src, int64_t src_offset, int64_t length,
+                             uint8_t* dst, int64_t dst_offset);
+
+// Set, or clear if value is false, the length bits of bits that start at
+// offset. Whole bytes are written at once.
+PARQUET_EXPORT void SetBits(uint8_t* bits, int64_t offset, int64_t length, bool value);
+
+// The bitmap counterpart of SpaceValues: bit i of the length bits of dst that
+// start at dst_offset is the next bit of src, from src_offset on, if bit
+// valid_bits_offset + i of valid_bits is set, and cleared otherwise
+PARQUET_EXPORT void SpaceBits(const uint8_t* src, int64_t src_offset, int64_t length,
+                              const uint8_t* valid_bits, int64_t valid_bits_offset,
+                              uint8_t* dst, int64_t dst_offset);
+
+}  // namespace internal
+}  // namespace parquet
+
+#endif  // PARQUET_UTIL_SPACING_H
@@ -23,9 +23,14 @@
 #include <sys/time.h>
 #endif
 
+#include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <ctime>
 #include <iostream>
 
+#include "parquet/util/macros.h"
+
 namespace parquet {
 
 class StopWatch {
@@ -47,6 +52,37 @@ class StopWatch {
   struct timeval start_time;
 };
 
+// Adds the nanoseconds from its construction to its destruction to a counter
+// of counters, does nothing if counters is nullptr
+template <typename Counters>
+class ScopedCounterTimer {
+ public:
+  typedef std::atomic<int64_t> Counters::*Counter;
+
+  ScopedCounterTimer(Counters* counters, Counter counter)
+      : counters_(counters), counter_(counter) {
+    if (counters_ != nullptr) {
+      start_ = std::chrono::steady_clock::now();
+    }
+  }
+
+  ~ScopedCounterTimer() {
+    if (counters_ != nullptr) {
+      const auto elapsed = std::chrono::steady_clock::now() - start_;
+      const int64_t nanos =
+          std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+      (counters_->*counter_).fetch_add(nanos, std::memory_order_relaxed);
+    }
+  }
+
+ private:
+  Counters* counters_;
+  Counter counter_;
+  std::chrono::steady_clock::time_point start_;
+
+  DISALLOW_COPY_AND_ASSIGN(ScopedCounterTimer);
+};
+
 }  // namespace parquet
 
 #endif
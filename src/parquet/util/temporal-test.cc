@@ -0,0 +1,168 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "parquet/util/temporal.h"
+
+namespace parquet {
+
+namespace test {
+
+static Int96 MakeInt96(uint32_t julian_day, int64_t nanoseconds) {
+  Int96 value;
+  memcpy(value.value, &nanoseconds, sizeof(int64_t));
+  value.value[2] = julian_day;
+  return value;
+}
+
+TEST(TemporalConversion, Int96ToNanoseconds) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<uint32_t> day(2415021, 2488070);
+  std::uniform_int_distribution<int64_t> nanos(0, 86400000000000LL - 1);
+
+  for (int64_t num_values : {0, 1, 2, 3, 17, 1000}) {
+    std::vector<Int96> values;
+    for (int64_t i = 0; i < num_values; ++i) {
+      values.push_back(MakeInt96(day(gen), nanos(gen)));
+    }
+    std::vector<int64_t> out(num_values);
+    std::vector<int64_t> out_scalar(num_values);
+    internal::Int96ToNanoseconds(values.data(), num_values, out.data());
+    internal::Int96ToNanosecondsScalar(values.data(), num_values, out_scalar.data());
+    ASSERT_EQ(out_scalar, out);
+  }
+
+  // The Unix epoch is Julian day 2440588, before it the values are negative
+  std::vector<Int96> values = {MakeInt96(2440588, 0), MakeInt96(2440588, 1),
+                               MakeInt96(2440589, 5), MakeInt96(2440587, 0)};
+  std::vector<int64_t> out(values.size());
+  internal::Int96ToNanoseconds(values.data(), 4, out.data());
+  ASSERT_EQ(std::vector<int64_t>({0, 1, 86400000000005LL, -86400000000000LL}), out);
+}
+
+TEST(TemporalConversion, DaysToMilliseconds) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int32_t> day(-1000000, 1000000);
+
+  for (int64_t num_values : {0, 1, 3, 4, 5, 17, 1000}) {
+    std::vector<int32_t> days(num_values);
+    for (auto& d : days) {
+      d = day(gen);
+    }
+    if (num_values > 1) {
+      days.front() = INT32_MIN;
+      days.back() = INT32_MAX;
+    }
+    std::vector<int64_t> out(num_values);
+    std::vector<int64_t> out_scalar(num_values);
+    internal::DaysToMilliseconds(days.data(), num_values, out.data());
+    internal::DaysToMillisecondsScalar(days.data(), num_values, out_scalar.data());
+    ASSERT_EQ(out_scalar, out);
+    for (int64_t i = 0; i < num_values; ++i) {
+      ASSERT_EQ(static_cast<int64_t>(days[i]) * 86400000LL, out[i]) << i;
+    }
+  }
+}
+
+TEST(TemporalConversion, MultiplyTimestamps) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int64_t> seconds(-4000000000LL, 4000000000LL);
+
+  for (int64_t num_values : {0, 1, 2, 3, 17, 1000}) {
+    std::vector<int64_t> values(num_values);
+    for (auto& v : values) {
+      v = seconds(gen);
+    }
+    for (int64_t factor : {1000LL, 1000000LL, 1000000000LL}) {
+      std::vector<int64_t> out(num_values);
+      std::vector<int64_t> out_scalar(num_values);
+      internal::MultiplyTimestamps(values.data(), num_values, factor, out.data());
+      internal::MultiplyTimestampsScalar(values.data(), num_values, factor,
+                                         out_scalar.data());
+      ASSERT_EQ(out_scalar, out);
+      for (int64_t i = 0; i < num_values; ++i) {
+        ASSERT_EQ(values[i] * factor, out[i]) << i;
+      }
+    }
+  }
+}
+
+TEST(TemporalConversion, DivideTimestamps) {
+  std::mt19937 gen(42);
+  std::uniform_int_distribution<int64_t> value(std::numeric_limits<int64_t>::min(),
+                                               std::numeric_limits<int64_t>::max());
+
+  for (int64_t factor : {1LL, 3LL, 1000LL, 1000000LL}) {
+    for (int64_t num_values : {0, 1, 2, 3, 17, 1000}) {
+      std::vector<int64_t> values(num_values);
+      for (auto& v : values) {
+        v = value(gen) / factor * factor;
+      }
+      if (num_values > 1) {
+        values.front() = std::numeric_limits<int64_t>::min() / factor * factor;
+        values.back() = std::numeric_limits<int64_t>::max() / factor * factor;
+      }
+      std::vector<int64_t> out(num_values);
+      ASSERT_EQ(-1, internal::DivideTimestamps(values.data(), num_values, factor,
+                                               nullptr, 0, true, out.data()));
+      for (int64_t i = 0; i < num_values; ++i) {
+        ASSERT_EQ(values[i] / factor, out[i]) << i;
+      }
+    }
+  }
+
+  std::vector<int64_t> values = {5000, -7000, 8001, 9000, -10001, 12000};
+  std::vector<int64_t> out(values.size());
+  ASSERT_EQ(2, internal::DivideTimestamps(values.data(), 6, 1000, nullptr, 0, true,
+                                          out.data()));
+  ASSERT_EQ(5, out[0]);
+  ASSERT_EQ(-7, out[1]);
+
+  // Null values are not checked, bit 0 of the bitmap is skipped by the offset
+  const uint8_t valid_bits[] = {0x33};
+  ASSERT_EQ(4, internal::DivideTimestamps(values.data(), 6, 1000, valid_bits, 1, true,
+                                          out.data()));
+  ASSERT_EQ(8, out[2]);
+  ASSERT_EQ(9, out[3]);
+
+  // Without the check the values are rounded towards zero
+  ASSERT_EQ(-1, internal::DivideTimestamps(values.data(), 6, 1000, nullptr, 0, false,
+                                           out.data()));
+  ASSERT_EQ(std::vector<int64_t>({5, -7, 8, 9, -10, 12}), out);
+}
+
+TEST(TemporalConversion, NanosecondsToInt96) {
+  std::vector<int64_t> values = {0, 1, 86400000000005LL, -86400000000000LL,
+                                 1489269000000001LL};
+  std::vector<Int96> out(values.size());
+  internal::NanosecondsToInt96(values.data(), 5, out.data());
+  std::vector<int64_t> roundtrip(values.size());
+  internal::Int96ToNanoseconds(out.data(), 5, roundtrip.data());
+  ASSERT_EQ(values, roundtrip);
+  ASSERT_EQ(2440589U, out[2].value[2]);
+}
+
+}  // namespace test
+
+}  // namespace parquet
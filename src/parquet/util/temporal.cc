@@ -0,0 +1,294 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "parquet/util/temporal.h"
+
+#include <cstring>
+#include <limits>
+
+#include "arrow/util/bit-util.h"
+
+#if defined(__SSE2__)
+#define PARQUET_TEMPORAL_SSE2 1
+#include <emmintrin.h>
+#endif
+
+namespace parquet {
+namespace internal {
+
+namespace {
+
+constexpr int64_t kJulianToUnixEpochDays = 2440588LL;
+constexpr int64_t kMillisecondsInADay = 86400000LL;
+constexpr int64_t kNanosecondsInADay = kMillisecondsInADay * 1000LL * 1000LL;
+
+#ifdef PARQUET_TEMPORAL_SSE2
+
+// SSE2 only multiplies the low 32 bits of 64 bit lanes, so we multiply the
+// two halves of each lane separately, modulo 2^64. The low half of c is
+// c_lo, its high half c_hi.
+inline __m128i Multiply64(__m128i x, __m128i c_lo, __m128i c_hi) {
+  const __m128i x_hi = _mm_srli_epi64(x, 32);
+  const __m128i cross =
+      _mm_add_epi64(_mm_mul_epu32(x_hi, c_lo), _mm_mul_epu32(x, c_hi));
+  return _mm_add_epi64(_mm_mul_epu32(x, c_lo), _mm_slli_epi64(cross, 32));
+}
+
+// Loads the nanoseconds and the Julian day of values i and i + 1
+inline void LoadInt96Pair(const uint8_t* values, __m128i* nanos, __m128i* days) {
+  *nanos = _mm_unpacklo_epi64(
+      _mm_loadl_epi64(reinterpret_cast<const __m128i*>(values)),
+      _mm_loadl_epi64(reinterpret_cast<const __m128i*>(values + 12)));
+  uint32_t day0;
+  uint32_t day1;
+  memcpy(&day0, values + 8, sizeof(uint32_t));
+  memcpy(&day1, values + 20, sizeof(uint32_t));
+  *days = _mm_unpacklo_epi64(_mm_cvtsi32_si128(static_cast<int>(day0)),
+                             _mm_cvtsi32_si128(static_cast<int>(day1)));
+}
+
+void Int96ToNanosecondsSse2(const Int96* values, int64_t num_values, int64_t* out) {
+  // The Julian days are unsigned, the epoch offset is subtracted at the end
+  const __m128i c_lo = _mm_set1_epi64x(kNanosecondsInADay & 0xFFFFFFFFLL);
+  const __m128i c_hi = _mm_set1_epi64x(kNanosecondsInADay >> 32);
+  // Modulo 2^64 as well
+  const __m128i epoch = _mm_set1_epi64x(static_cast<int64_t>(
+      static_cast<uint64_t>(kJulianToUnixEpochDays) * kNanosecondsInADay));
+  const uint8_t* data = reinterpret_cast<const uint8_t*>(values);
+  const int64_t num_pairs = num_values / 2;
+  for (int64_t p = 0; p < num_pairs; ++p) {
+    __m128i nanos;
+    __m128i days;
+    LoadInt96Pair(data + p * 24, &nanos, &days);
+    const __m128i day_nanos = Multiply64(days, c_lo, c_hi);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * p),
+                     _mm_add_epi64(_mm_sub_epi64(day_nanos, epoch), nanos));
+  }
+  const int64_t done = num_pairs * 2;
+  Int96ToNanosecondsScalar(values + done, num_values - done, out + done);
+}
+
+void DaysToMillisecondsSse2(const int32_t* days, int64_t num_values, int64_t* out) {
+  const __m128i c_lo = _mm_set1_epi64x(kMillisecondsInADay);
+  const __m128i c_hi = _mm_setzero_si128();
+  const int64_t num_blocks = num_values / 4;
+  for (int64_t b = 0; b < num_blocks; ++b) {
+    const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(days + 4 * b));
+    // Sign extend to 64 bits
+    const __m128i sign = _mm_srai_epi32(d, 31);
+    const __m128i lo = _mm_unpacklo_epi32(d, sign);
+    const __m128i hi = _mm_unpackhi_epi32(d, sign);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4 * b),
+                     Multiply64(lo, c_lo, c_hi));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 4 * b + 2),
+                     Multiply64(hi, c_lo, c_hi));
+  }
+  const int64_t done = num_blocks * 4;
+  DaysToMillisecondsScalar(days + done, num_values - done, out + done);
+}
+
+// Signed 64 bit a > b in all bits of each lane. SSE2 only compares 32 bit
+// lanes, so the low halves are compared unsigned and the high halves decide
+// unless they are equal.
+inline __m128i CompareGreater64(__m128i a, __m128i b) {
+  const int32_t sign = std::numeric_limits<int32_t>::min();
+  const __m128i flip = _mm_set_epi32(0, sign, 0, sign);
+  const __m128i gt = _mm_cmpgt_epi32(_mm_xor_si128(a, flip), _mm_xor_si128(b, flip));
+  const __m128i eq = _mm_cmpeq_epi32(a, b);
+  const __m128i hi = _mm_or_si128(gt, _mm_and_si128(eq, _mm_slli_epi64(gt, 32)));
+  return _mm_shuffle_epi32(hi, _MM_SHUFFLE(3, 3, 1, 1));
+}
+
+void MultiplyTimestampsSse2(const int64_t* values, int64_t num_values, int64_t factor,
+                            int64_t* out) {
+  const uint64_t c = static_cast<uint64_t>(factor);
+  const __m128i c_lo = _mm_set1_epi64x(static_cast<int64_t>(c & 0xFFFFFFFFULL));
+  const __m128i c_hi = _mm_set1_epi64x(static_cast<int64_t>(c >> 32));
+  const int64_t num_pairs = num_values / 2;
+  for (int64_t p = 0; p < num_pairs; ++p) {
+    const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + 2 * p));
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(out + 2 * p), Multiply64(x, c_lo, c_hi));
+  }
+  const int64_t done = num_pairs * 2;
+  MultiplyTimestampsScalar(values + done, num_values - done, factor, out + done);
+}
+
+// SSE2 cannot divide, but a multiple of factor = odd * 2^shift is divided
+// exactly by shifting it right and multiplying with the inverse of odd modulo
+// 2^64. The result is in [INT64_MIN / odd, INT64_MAX / odd] if and only if
+// the shifted value was a multiple of odd, so pairs that fail the check fall
+// back to a real division.
+int64_t DivideTimestampsSse2(const int64_t* values, int64_t num_values, int64_t factor,
+                             const uint8_t* valid_bits, int64_t valid_bits_offset,
+                             bool check_truncation, int64_t* out) {
+  uint64_t odd = static_cast<uint64_t>(factor);
+  int shift = 0;
+  while ((odd & 1) == 0) {
+    odd >>= 1;
+    ++shift;
+  }
+  // Newton's iteration, each step doubles the number of correct low bits
+  uint64_t inverse = odd;
+  for (int i = 0; i < 5; ++i) {
+    inverse *= 2 - odd * inverse;
+  }
+  const __m128i inv_lo = _mm_set1_epi64x(static_cast<int64_t>(inverse & 0xFFFFFFFFULL));
+  const __m128i inv_hi = _mm_set1_epi64x(static_cast<int64_t>(inverse >> 32));
+  const __m128i q_min = _mm_set1_epi64x(std::numeric_limits<int64_t>::min() /
+                                        static_cast<int64_t>(odd));
+  const __m128i q_max = _mm_set1_epi64x(std::numeric_limits<int64_t>::max() /
+                                        static_cast<int64_t>(odd));
+  const __m128i low_mask = _mm_set1_epi64x(static_cast<int64_t>((1ULL << shift) - 1));
+  const __m128i shift_right = _mm_cvtsi32_si128(shift);
+  const __m128i shift_left = _mm_cvtsi32_si128(64 - shift);
+  const __m128i zero = _mm_setzero_si128();
+
+  const int64_t num_pairs = num_values / 2;
+  for (int64_t p = 0; p < num_pairs; ++p) {
+    const int64_t i = 2 * p;
+    const __m128i x = _mm_loadu_si128(reinterpret_cast<const __m128i*>(values + i));
+    // Arithmetic shift right, emulated with the sign of the high halves
+    const __m128i sign =
+        _mm_shuffle_epi32(_mm_srai_epi32(x, 31), _MM_SHUFFLE(3, 3, 1, 1));
+    const __m128i y =
+        _mm_or_si128(_mm_srl_epi64(x, shift_right), _mm_sll_epi64(sign, shift_left));
+    const __m128i q = Multiply64(y, inv_lo, inv_hi);
+
+    const __m128i low_zero = _mm_cmpeq_epi32(_mm_and_si128(x, low_mask), zero);
+    const __m128i exact = _mm_and_si128(
+        low_zero, _mm_shuffle_epi32(low_zero, _MM_SHUFFLE(2, 3, 0, 1)));
+    const __m128i out_of_range =
+        _mm_or_si128(CompareGreater64(q, q_max), CompareGreater64(q_min, q));
+    if (_mm_movemask_epi8(_mm_andnot_si128(out_of_range, exact)) == 0xFFFF) {
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), q);
+      continue;
+    }
+    const int64_t lossy =
+        DivideTimestampsScalar(values + i, 2, factor, valid_bits, valid_bits_offset + i,
+                               check_truncation, out + i);
+    if (lossy >= 0) {
+      return i + lossy;
+    }
+  }
+  const int64_t done = num_pairs * 2;
+  const int64_t lossy =
+      DivideTimestampsScalar(values + done, num_values - done, factor, valid_bits,
+                             valid_bits_offset + done, check_truncation, out + done);
+  return lossy >= 0 ? done + lossy : -1;
+}
+
+#endif  // PARQUET_TEMPORAL_SSE2
+
+}  // namespace
+
+void Int96ToNanosecondsScalar(const Int96* values, int64_t num_values, int64_t* out) {
+  for (int64_t i = 0; i < num_values; ++i) {
+    int64_t nanoseconds;
+    memcpy(&nanoseconds, values[i].value, sizeof(int64_t));
+    const int64_t days_since_epoch =
+        static_cast<int64_t>(values[i].value[2]) - kJulianToUnixEpochDays;
+    out[i] = days_since_epoch * kNanosecondsInADay + nanoseconds;
+  }
+}
+
+void DaysToMillisecondsScalar(const int32_t* days, int64_t num_values, int64_t* out) {
+  for (int64_t i = 0; i < num_values; ++i) {
+    out[i] = static_cast<int64_t>(days[i]) * kMillisecondsInADay;
+  }
+}
+
+void MultiplyTimestampsScalar(const int64_t* values, int64_t num_values, int64_t factor,
+                              int64_t* out) {
+  for (int64_t i = 0; i < num_values; ++i) {
+    out[i] = static_cast<int64_t>(static_cast<uint64_t>(values[i]) *
+                                  static_cast<uint64_t>(factor));
+  }
+}
+
+int64_t DivideTimestampsScalar(const int64_t* values, int64_t num_values,
+                               int64_t factor, const uint8_t* valid_bits,
+                               int64_t valid_bits_offset, bool check_truncation,
+                               int64_t* out) {
+  for (int64_t i = 0; i < num_values; ++i) {
+    if (check_truncation && values[i] % factor != 0 &&
+        (valid_bits == nullptr ||
+         ::arrow::BitUtil::GetBit(valid_bits, valid_bits_offset + i))) {
+      return i;
+    }
+    out[i] = values[i] / factor;
+  }
+  return -1;
+}
+
+void NanosecondsToInt96(const int64_t* values, int64_t num_values, Int96* out) {
+  // The division by a constant is strength reduced by the compiler, SSE2 has
+  // no 64 bit multiply high to do better
+  for (int64_t i = 0; i < num_values; ++i) {
+    const int64_t nanoseconds = values[i] % kNanosecondsInADay;
+    memcpy(out[i].value, &nanoseconds, sizeof(int64_t));
+    out[i].value[2] = static_cast<uint32_t>(values[i] / kNanosecondsInADay +
+                                            kJulianToUnixEpochDays);
+  }
+}
+
+void Int96ToNanoseconds(const Int96* values, int64_t num_values, int64_t* out) {
+#ifdef PARQUET_TEMPORAL_SSE2
+  Int96ToNanosecondsSse2(values, num_values, out);
+#else
+  Int96ToNanosecondsScalar(values, num_values, out);
+#endif
+}
+
+void DaysToMilliseconds(const int32_t* days, int64_t num_values, int64_t* out) {
+#ifdef PARQUET_TEMPORAL_SSE2
+  DaysToMillisecondsSse2(days, num_values, out);
+#else
+  DaysToMillisecondsScalar(days, num_values, out);
+#endif
+}
+
+void MultiplyTimestamps(const int64_t* values, int64_t num_values, int64_t factor,
+                        int64_t* out) {
+#ifdef PARQUET_TEMPORAL_SSE2
+  MultiplyTimestampsSse2(values, num_values, factor, out);
+#else
+  MultiplyTimestampsScalar(values, num_values, factor, out);
+#endif
+}
+
+int64_t DivideTimestamps(const int64_t* values, int64_t num_values, int64_t factor,
+                         const uint8_t* valid_bits, int64_t valid_bits_offset,
+                         bool check_truncation, int64_t* out) {
+#ifdef PARQUET_TEMPORAL_SSE2
+  return DivideTimestampsSse2(values, num_values, factor, valid_bits, valid_bits_offset,
+                              check_truncation, out);
+#else
+  return DivideTimestampsScalar(values, num_values, factor, valid_bits,
+                                valid_bits_offset, check_truncation, out);
+#endif
+}
+
+bool TemporalConversionIsVectorized() {
+#ifdef PARQUET_TEMPORAL_SSE2
+  return true;
+#else
+  return false;
+#endif
+}
+
+}  // namespace internal
+}  // namespace parquet
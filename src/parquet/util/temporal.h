@@ -0,0 +1,81 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef PARQUET_UTIL_TEMPORAL_H
+#define PARQUET_UTIL_TEMPORAL_H
+
+#include <cstdint>
+
+#include "parquet/types.h"
+#include "parquet/util/visibility.h"
+
+namespace parquet {
+namespace internal {
+
+// Converts num_values Impala timestamps, the nanoseconds of the day in the
+// first 8 bytes and the Julian day in the last 4, to nanoseconds since the
+// Unix epoch. Two values are converted at a time with SSE2 on x86.
+PARQUET_EXPORT void Int96ToNanoseconds(const Int96* values, int64_t num_values,
+                                       int64_t* out);
+
+// Converts num_values days since the Unix epoch to milliseconds, four at a
+// time with SSE2 on x86
+PARQUET_EXPORT void DaysToMilliseconds(const int32_t* days, int64_t num_values,
+                                       int64_t* out);
+
+// Multiplies num_values timestamps by factor, modulo 2^64, two at a time with
+// SSE2 on x86
+PARQUET_EXPORT void MultiplyTimestamps(const int64_t* values, int64_t num_values,
+                                       int64_t factor, int64_t* out);
+
+// Divides num_values timestamps by a positive factor, rounding towards zero.
+// Unless check_truncation is false, stops at the first value that is valid in
+// valid_bits (all are if valid_bits is null) and not a multiple of factor and
+// returns its index; returns -1 once all values were converted. Multiples of
+// factor are divided exactly with SSE2 on x86, two at a time.
+PARQUET_EXPORT int64_t DivideTimestamps(const int64_t* values, int64_t num_values,
+                                        int64_t factor, const uint8_t* valid_bits,
+                                        int64_t valid_bits_offset,
+                                        bool check_truncation, int64_t* out);
+
+// Converts num_values nanoseconds since the Unix epoch to Impala timestamps
+PARQUET_EXPORT void NanosecondsToInt96(const int64_t* values, int64_t num_values,
+                                       Int96* out);
+
+// Value by value implementations of the conversions above
+PARQUET_EXPORT void Int96ToNanosecondsScalar(const Int96* values, int64_t num_values,
+                                             int64_t* out);
+
+PARQUET_EXPORT void DaysToMillisecondsScalar(const int32_t* days, int64_t num_values,
+                                             int64_t* out);
+
+PARQUET_EXPORT void MultiplyTimestampsScalar(const int64_t* values, int64_t num_values,
+                                             int64_t factor, int64_t* out);
+
+PARQUET_EXPORT int64_t DivideTimestampsScalar(const int64_t* values,
+                                              int64_t num_values, int64_t factor,
+                                              const uint8_t* valid_bits,
+                                              int64_t valid_bits_offset,
+                                              bool check_truncation, int64_t* out);
+
+// True if the conversions above use SIMD on this machine
+PARQUET_EXPORT bool TemporalConversionIsVectorized();
+
+}  // namespace internal
+}  // namespace parquet
+
+#endif  // PARQUET_UTIL_TEMPORAL_H
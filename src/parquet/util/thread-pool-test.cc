@@ -0,0 +1,140 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "parquet/exception.h"
+#include "parquet/util/thread-pool.h"
+
+namespace parquet {
+
+TEST(TestThreadPool, ParallelFor) {
+  ThreadPool pool(4);
+  ASSERT_EQ(4, pool.num_threads());
+
+  std::vector<int> results(1000, 0);
+  pool.ParallelFor(8, static_cast<int>(results.size()), [&results](int i) {
+    results[i] = i * 2;
+  });
+  for (size_t i = 0; i < results.size(); ++i) {
+    ASSERT_EQ(static_cast<int>(i) * 2, results[i]);
+  }
+}
+
+TEST(TestThreadPool, ParallelismLimit) {
+  ThreadPool pool(8);
+  std::atomic<int> running(0);
+  std::atomic<int> max_running(0);
+  pool.ParallelFor(2, 100, [&running, &max_running](int i) {
+    const int now = ++running;
+    int previous = max_running.load();
+    while (now > previous && !max_running.compare_exchange_weak(previous, now)) {
+    }
+    std::this_thread::yield();
+    --running;
+  });
+  ASSERT_LE(max_running.load(), 2);
+}
+
+TEST(TestThreadPool, Nested) {
+  // Tasks of the pool that wait for tasks of the pool must not deadlock
+  ThreadPool pool(2);
+  std::atomic<int64_t> sum(0);
+  pool.ParallelFor(4, 8, [&pool, &sum](int i) {
+    pool.ParallelFor(4, 100, [&sum, i](int j) { sum += i * 100 + j; });
+  });
+  ASSERT_EQ(799 * 800 / 2, sum.load());
+}
+
+TEST(TestThreadPool, Exceptions) {
+  ThreadPool pool(4);
+  ASSERT_THROW(pool.ParallelFor(4, 100,
+                                [](int i) {
+                                  if (i == 10) {
+                                    throw ParquetException("task failed");
+                                  }
+                                }),
+               ParquetException);
+
+  auto status = ParallelFor(&pool, 4, 100, [](int i) {
+    return i == 42 ? ::arrow::Status::Invalid("task 42") : ::arrow::Status::OK();
+  });
+  ASSERT_TRUE(status.IsInvalid());
+  ASSERT_TRUE(ParallelFor(&pool, 4, 100, [](int i) { return ::arrow::Status::OK(); }).ok());
+}
+
+TEST(TestThreadPool, LargestFirst) {
+  ThreadPool pool(4);
+  const std::vector<int64_t> costs = {5, 100, 0, 7, 100, 42};
+
+  // Without parallelism the calling thread runs the tasks in the cost order
+  std::vector<int> started;
+  ASSERT_TRUE(ParallelForLargestFirst(&pool, 1, costs, [&started](int i) {
+                started.push_back(i);
+                return ::arrow::Status::OK();
+              }).ok());
+  ASSERT_EQ(std::vector<int>({1, 4, 5, 3, 0, 2}), started);
+
+  std::vector<int> results(costs.size(), 0);
+  ASSERT_TRUE(ParallelForLargestFirst(&pool, 4, costs, [&results](int i) {
+                results[i] = i + 1;
+                return ::arrow::Status::OK();
+              }).ok());
+  ASSERT_EQ(std::vector<int>({1, 2, 3, 4, 5, 6}), results);
+
+  auto status = ParallelForLargestFirst(&pool, 4, costs, [](int i) {
+    return i == 3 ? ::arrow::Status::Invalid("task 3") : ::arrow::Status::OK();
+  });
+  ASSERT_TRUE(status.IsInvalid());
+}
+
+TEST(TestThreadPool, Spawn) {
+  std::atomic<int> count(0);
+  {
+    ThreadPool pool(3);
+    for (int i = 0; i < 100; ++i) {
+      pool.Spawn([&count]() { ++count; });
+    }
+    // The destructor runs the queued tasks
+  }
+  ASSERT_EQ(100, count.load());
+  ASSERT_GE(ThreadPool::GetDefault()->num_threads(), 1);
+}
+
+TEST(TestThreadPool, SpawnExceptions) {
+  std::atomic<int> count(0);
+  {
+    ThreadPool pool(2);
+    for (int i = 0; i < 100; ++i) {
+      pool.Spawn([&count, i]() {
+        if (i % 2 == 0) {
+          throw ParquetException("task failed");
+        }
+        ++count;
+      });
+    }
+  }
+  ASSERT_EQ(50, count.load());
+}
+
+}  // namespace parquet
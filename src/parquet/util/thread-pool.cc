@@ -0,0 +1,188 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "parquet/util/thread-pool.h"
+
+#include <algorithm>
+#include <deque>
+#include <exception>
+#include <utility>
+
+namespace parquet {
+
+namespace {
+
+// The pool and the index of the worker that runs on this thread, if any
+thread_local const ThreadPool* current_pool = nullptr;
+thread_local int current_worker = -1;
+
+}  // namespace
+
+struct ThreadPool::Worker {
+  std::mutex mutex;
+  std::deque<std::function<void()>> tasks;
+};
+
+ThreadPool::ThreadPool(int num_threads) : next_worker_(0), pending_(0), shutdown_(false) {
+  if (num_threads <= 0) {
+    throw ParquetException("ThreadPool needs at least one thread");
+  }
+  for (int i = 0; i < num_threads; ++i) {
+    workers_.emplace_back(new Worker());
+  }
+  for (int i = 0; i < num_threads; ++i) {
+    threads_.emplace_back(&ThreadPool::WorkerLoop, this, i);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    shutdown_ = true;
+  }
+  cv_.notify_all();
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+}
+
+std::shared_ptr<ThreadPool> ThreadPool::GetDefault() {
+  static std::shared_ptr<ThreadPool> pool = std::make_shared<ThreadPool>(
+      std::max(static_cast<int>(std::thread::hardware_concurrency()), 1));
+  return pool;
+}
+
+void ThreadPool::Spawn(std::function<void()> task) {
+  if (current_pool == this) {
+    Worker* worker = workers_[current_worker].get();
+    std::lock_guard<std::mutex> lock(worker->mutex);
+    worker->tasks.push_front(std::move(task));
+  } else {
+    Worker* worker = workers_[next_worker_++ % workers_.size()].get();
+    std::lock_guard<std::mutex> lock(worker->mutex);
+    worker->tasks.push_back(std::move(task));
+  }
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++pending_;
+  }
+  cv_.notify_one();
+}
+
+bool ThreadPool::TryPop(int index, std::function<void()>* task) {
+  const int num_workers = static_cast<int>(workers_.size());
+  for (int i = 0; i < num_workers; ++i) {
+    Worker* worker = workers_[(index + i) % num_workers].get();
+    std::lock_guard<std::mutex> lock(worker->mutex);
+    if (worker->tasks.empty()) {
+      continue;
+    }
+    if (i == 0) {
+      *task = std::move(worker->tasks.front());
+      worker->tasks.pop_front();
+    } else {
+      *task = std::move(worker->tasks.back());
+      worker->tasks.pop_back();
+    }
+    return true;
+  }
+  return false;
+}
+
+void ThreadPool::WorkerLoop(int index) {
+  current_pool = this;
+  current_worker = index;
+  while (true) {
+    std::function<void()> task;
+    if (TryPop(index, &task)) {
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        --pending_;
+      }
+      try {
+        task();
+      } catch (...) {
+        // Nobody waits on a spawned task, the worker lives on for the others
+      }
+      continue;
+    }
+    std::unique_lock<std::mutex> lock(mutex_);
+    // A task may be counted but not taken out of its queue yet, in which case
+    // the loop tries again
+    cv_.wait(lock, [this] { return pending_ > 0 || shutdown_; });
+    if (pending_ == 0) {
+      return;
+    }
+  }
+}
+
+void ThreadPool::ParallelFor(int parallelism, int num_tasks,
+                             const std::function<void(int)>& func) {
+  struct State {
+    State() : next(0), remaining(0) {}
+
+    std::atomic<int> next;
+    std::mutex mutex;
+    std::condition_variable done;
+    int remaining;
+    std::exception_ptr error;
+  };
+  auto state = std::make_shared<State>();
+  state->remaining = num_tasks;
+
+  // Claims and runs tasks until none are left. Helpers that start after all
+  // tasks have been claimed return without touching func
+  auto RunTasks = [state, num_tasks, &func]() {
+    int i;
+    while ((i = state->next++) < num_tasks) {
+      bool failed;
+      {
+        std::lock_guard<std::mutex> lock(state->mutex);
+        failed = state->error != nullptr;
+      }
+      if (!failed) {
+        try {
+          func(i);
+        } catch (...) {
+          std::lock_guard<std::mutex> lock(state->mutex);
+          if (state->error == nullptr) {
+            state->error = std::current_exception();
+          }
+        }
+      }
+      std::lock_guard<std::mutex> lock(state->mutex);
+      if (--state->remaining == 0) {
+        state->done.notify_all();
+      }
+    }
+  };
+
+  const int num_helpers =
+      std::min(std::min(parallelism, num_tasks), num_threads() + 1) - 1;
+  for (int i = 0; i < num_helpers; ++i) {
+    Spawn(RunTasks);
+  }
+  RunTasks();
+
+  std::unique_lock<std::mutex> lock(state->mutex);
+  state->done.wait(lock, [&state] { return state->remaining == 0; });
+  if (state->error != nullptr) {
+    std::rethrow_exception(state->error);
+  }
+}
+
+}  // namespace parquet
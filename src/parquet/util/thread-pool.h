@@ -0,0 +1,127 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef PARQUET_UTIL_THREAD_POOL_H
+#define PARQUET_UTIL_THREAD_POOL_H
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+#include "arrow/status.h"
+
+#include "parquet/exception.h"
+#include "parquet/util/visibility.h"
+
+namespace parquet {
+
+// Work-stealing pool of threads that is meant to be shared by all readers and
+// writers of a process, so that concurrent reads do not oversubscribe the
+// machine or pay for creating threads. Every worker has a queue of its own:
+// tasks spawned from a worker go to the front of its queue and are run LIFO,
+// idle workers steal from the back of the other queues.
+class PARQUET_EXPORT ThreadPool {
+ public:
+  explicit ThreadPool(int num_threads);
+
+  // Runs the queued tasks and joins the workers
+  ~ThreadPool();
+
+  // Process-wide pool with a worker per hardware thread
+  static std::shared_ptr<ThreadPool> GetDefault();
+
+  int num_threads() const { return static_cast<int>(threads_.size()); }
+
+  // Queue task to run on a worker. An exception thrown by task is caught and
+  // dropped, so tasks that can fail pass their error on themselves, as
+  // ParallelFor does
+  void Spawn(std::function<void()> task);
+
+  // Call func(0), ..., func(num_tasks - 1) with at most parallelism of the
+  // calls running at the same time, i.e. parallelism is the limit of the
+  // query. The calling thread runs tasks too, so that it is safe to use from
+  // tasks of the pool. Once a call threw, the tasks not started yet are
+  // skipped and the first exception is rethrown.
+  void ParallelFor(int parallelism, int num_tasks, const std::function<void(int)>& func);
+
+ private:
+  struct Worker;
+
+  void WorkerLoop(int index);
+
+  // Pop from the front of the queue of worker index or steal from the others
+  bool TryPop(int index, std::function<void()>* task);
+
+  std::vector<std::unique_ptr<Worker>> workers_;
+  std::vector<std::thread> threads_;
+  std::atomic<uint32_t> next_worker_;
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  // Number of queued tasks, guarded by mutex_
+  int64_t pending_;
+  bool shutdown_;
+};
+
+// ParallelFor for functions that return an arrow::Status, returns the first
+// error
+template <typename Function>
+::arrow::Status ParallelFor(ThreadPool* pool, int parallelism, int num_tasks,
+                            Function&& func) {
+  std::vector<::arrow::Status> statuses(num_tasks);
+  try {
+    pool->ParallelFor(parallelism, num_tasks, [&statuses, &func](int i) {
+      statuses[i] = func(i);
+      if (!statuses[i].ok()) {
+        // Skip the remaining tasks
+        throw ParquetException(statuses[i].ToString());
+      }
+    });
+  } catch (const ParquetException& e) {
+    for (const auto& status : statuses) {
+      RETURN_NOT_OK(status);
+    }
+    return ::arrow::Status::IOError(e.what());
+  }
+  return ::arrow::Status::OK();
+}
+
+// ParallelFor over the tasks 0, ..., costs.size() - 1 that starts them in the
+// order of decreasing estimated cost. The threads claim the next task as they
+// become free, so a large task does not start last while the others idle.
+template <typename Function>
+::arrow::Status ParallelForLargestFirst(ThreadPool* pool, int parallelism,
+                                        const std::vector<int64_t>& costs,
+                                        Function&& func) {
+  std::vector<int> order(costs.size());
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&costs](int a, int b) { return costs[a] > costs[b]; });
+  return ParallelFor(pool, parallelism, static_cast<int>(order.size()),
+                     [&order, &func](int i) { return func(order[i]); });
+}
+
+}  // namespace parquet
+
+#endif  // PARQUET_UTIL_THREAD_POOL_H
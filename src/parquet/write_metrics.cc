@@ -0,0 +1,66 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include "parquet/write_metrics.h"
+
+namespace parquet {
+
+ColumnWriteMetrics ColumnWriteCounters::Get() const {
+  ColumnWriteMetrics result;
+  result.values_written = values_written.load(std::memory_order_relaxed);
+  result.uncompressed_bytes = uncompressed_bytes.load(std::memory_order_relaxed);
+  result.compressed_bytes = compressed_bytes.load(std::memory_order_relaxed);
+  result.num_data_pages = num_data_pages.load(std::memory_order_relaxed);
+  result.num_dictionary_pages = num_dictionary_pages.load(std::memory_order_relaxed);
+  result.num_dictionary_fallbacks =
+      num_dictionary_fallbacks.load(std::memory_order_relaxed);
+  result.fallback_dictionary_bytes =
+      fallback_dictionary_bytes.load(std::memory_order_relaxed);
+  result.peak_dictionary_memory_bytes =
+      peak_dictionary_memory_bytes.load(std::memory_order_relaxed);
+  result.num_auto_plain = num_auto_plain.load(std::memory_order_relaxed);
+  result.num_auto_dictionary = num_auto_dictionary.load(std::memory_order_relaxed);
+  result.num_auto_delta = num_auto_delta.load(std::memory_order_relaxed);
+  result.num_auto_byte_stream_split =
+      num_auto_byte_stream_split.load(std::memory_order_relaxed);
+  result.auto_encoding_nanos = auto_encoding_nanos.load(std::memory_order_relaxed);
+  result.statistics_nanos = statistics_nanos.load(std::memory_order_relaxed);
+  result.dictionary_nanos = dictionary_nanos.load(std::memory_order_relaxed);
+  result.encode_nanos = encode_nanos.load(std::memory_order_relaxed);
+  result.compress_nanos = compress_nanos.load(std::memory_order_relaxed);
+  return result;
+}
+
+std::shared_ptr<ColumnWriteCounters> WriteMetrics::column(const std::string& path) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::shared_ptr<ColumnWriteCounters>& counters = columns_[path];
+  if (counters == nullptr) {
+    counters = std::make_shared<ColumnWriteCounters>();
+  }
+  return counters;
+}
+
+std::map<std::string, ColumnWriteMetrics> WriteMetrics::Get() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  std::map<std::string, ColumnWriteMetrics> result;
+  for (const auto& column : columns_) {
+    result[column.first] = column.second->Get();
+  }
+  return result;
+}
+
+}  // namespace parquet
@@ -0,0 +1,143 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#ifndef PARQUET_WRITE_METRICS_H
+#define PARQUET_WRITE_METRICS_H
+
+#include <atomic>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "parquet/util/stopwatch.h"
+#include "parquet/util/visibility.h"
+
+namespace parquet {
+
+// Totals of the writes of a leaf column, see WriteMetrics
+struct PARQUET_EXPORT ColumnWriteMetrics {
+  ColumnWriteMetrics()
+      : values_written(0),
+        uncompressed_bytes(0),
+        compressed_bytes(0),
+        num_data_pages(0),
+        num_dictionary_pages(0),
+        num_dictionary_fallbacks(0),
+        fallback_dictionary_bytes(0),
+        peak_dictionary_memory_bytes(0),
+        num_auto_plain(0),
+        num_auto_dictionary(0),
+        num_auto_delta(0),
+        num_auto_byte_stream_split(0),
+        auto_encoding_nanos(0),
+        statistics_nanos(0),
+        dictionary_nanos(0),
+        encode_nanos(0),
+        compress_nanos(0) {}
+
+  // Values, including nulls, of the data pages that were written
+  int64_t values_written;
+  // Size of the encoded pages before and after compression, without the page
+  // headers
+  int64_t uncompressed_bytes;
+  int64_t compressed_bytes;
+  int64_t num_data_pages;
+  int64_t num_dictionary_pages;
+
+  // Column chunks that fell back from dictionary encoding to PLAIN, and the
+  // sum of the encoded sizes of their dictionaries at that point
+  int64_t num_dictionary_fallbacks;
+  int64_t fallback_dictionary_bytes;
+  // Most memory reserved for the BYTE_ARRAY or FIXED_LEN_BYTE_ARRAY values of
+  // the dictionary of a column chunk, see ChunkedAllocator
+  int64_t peak_dictionary_memory_bytes;
+
+  // Column chunks whose encoding was chosen from a sample of their values,
+  // by the chosen encoding, see WriterProperties::Builder::enable_auto_encoding,
+  // and the time spent encoding the samples
+  int64_t num_auto_plain;
+  int64_t num_auto_dictionary;
+  int64_t num_auto_delta;
+  int64_t num_auto_byte_stream_split;
+  int64_t auto_encoding_nanos;
+
+  // Time spent updating the statistics, dictionary encoding the values, i.e.
+  // mostly hashing them, encoding the values otherwise, and compressing the
+  // pages
+  int64_t statistics_nanos;
+  int64_t dictionary_nanos;
+  int64_t encode_nanos;
+  int64_t compress_nanos;
+};
+
+// The counters of a column that its writers add to, possibly concurrently
+struct PARQUET_EXPORT ColumnWriteCounters {
+  std::atomic<int64_t> values_written{0};
+  std::atomic<int64_t> uncompressed_bytes{0};
+  std::atomic<int64_t> compressed_bytes{0};
+  std::atomic<int64_t> num_data_pages{0};
+  std::atomic<int64_t> num_dictionary_pages{0};
+  std::atomic<int64_t> num_dictionary_fallbacks{0};
+  std::atomic<int64_t> fallback_dictionary_bytes{0};
+  std::atomic<int64_t> peak_dictionary_memory_bytes{0};
+  std::atomic<int64_t> num_auto_plain{0};
+  std::atomic<int64_t> num_auto_dictionary{0};
+  std::atomic<int64_t> num_auto_delta{0};
+  std::atomic<int64_t> num_auto_byte_stream_split{0};
+  std::atomic<int64_t> auto_encoding_nanos{0};
+  std::atomic<int64_t> statistics_nanos{0};
+  std::atomic<int64_t> dictionary_nanos{0};
+  std::atomic<int64_t> encode_nanos{0};
+  std::atomic<int64_t> compress_nanos{0};
+
+  static void Add(std::atomic<int64_t>* counter, int64_t value) {
+    counter->fetch_add(value, std::memory_order_relaxed);
+  }
+
+  static void Max(std::atomic<int64_t>* counter, int64_t value) {
+    int64_t current = counter->load(std::memory_order_relaxed);
+    while (current < value &&
+           !counter->compare_exchange_weak(current, value, std::memory_order_relaxed)) {
+    }
+  }
+
+  ColumnWriteMetrics Get() const;
+};
+
+typedef ScopedCounterTimer<ColumnWriteCounters> ScopedWriteTimer;
+
+// Thread-safe per column metrics of the column and page writers of files that
+// are written with these WriterProperties, keyed on the dot path of the
+// column. Like ReadMetrics, the writers only count when a WriteMetrics is set
+class PARQUET_EXPORT WriteMetrics {
+ public:
+  // The counters of the column, created on first use
+  std::shared_ptr<ColumnWriteCounters> column(const std::string& path);
+
+  // The totals so far of every column that was written
+  std::map<std::string, ColumnWriteMetrics> Get() const;
+
+ private:
+  mutable std::mutex mutex_;
+  std::map<std::string, std::shared_ptr<ColumnWriteCounters>> columns_;
+};
+
+}  // namespace parquet
+
+#endif  // PARQUET_WRITE_METRICS_H
@@ -0,0 +1,80 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "arrow/io/file.h"
+
+#include "parquet/api/reader.h"
+#include "parquet/api/writer.h"
+
+// Concatenates the row groups of files with the same schema into a single
+// file. The column chunks are copied as they are, without decoding and
+// re-encoding the pages.
+static void Usage() {
+  std::cerr << "Usage: parquet-concat <output> <input>...\n";
+}
+
+int main(int argc, char** argv) {
+  if (argc < 3) {
+    Usage();
+    return -1;
+  }
+  const std::string output_path = argv[1];
+
+  try {
+    std::vector<std::shared_ptr<::arrow::io::ReadableFile>> inputs;
+    std::vector<std::shared_ptr<parquet::FileMetaData>> metadata;
+    for (int i = 2; i < argc; i++) {
+      std::shared_ptr<::arrow::io::ReadableFile> input;
+      PARQUET_THROW_NOT_OK(::arrow::io::ReadableFile::Open(argv[i], &input));
+      metadata.push_back(parquet::ReadMetaData(input));
+      if (!metadata.back()->schema()->Equals(*metadata[0]->schema())) {
+        std::cerr << "The schema of " << argv[i] << " differs from the schema of "
+                  << argv[2] << std::endl;
+        return -1;
+      }
+      inputs.push_back(input);
+    }
+
+    std::shared_ptr<::arrow::io::FileOutputStream> output;
+    PARQUET_THROW_NOT_OK(::arrow::io::FileOutputStream::Open(output_path, &output));
+    auto schema = std::static_pointer_cast<parquet::schema::GroupNode>(
+        metadata[0]->schema()->schema_root());
+    std::unique_ptr<parquet::ParquetFileWriter> writer =
+        parquet::ParquetFileWriter::Open(output, schema,
+                                         parquet::default_writer_properties(),
+                                         metadata[0]->key_value_metadata());
+    int64_t num_rows = 0;
+    for (size_t i = 0; i < inputs.size(); i++) {
+      parquet::ArrowInputFile source(inputs[i]);
+      writer->AppendRowGroups(&source, *metadata[i]);
+      num_rows += metadata[i]->num_rows();
+    }
+    writer->Close();
+    std::cout << "Wrote " << num_rows << " rows from " << inputs.size() << " files to "
+              << output_path << std::endl;
+  } catch (const std::exception& e) {
+    std::cerr << "Parquet error: " << e.what() << std::endl;
+    return -1;
+  }
+
+  return 0;
+}
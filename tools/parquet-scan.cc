@@ -14,61 +14,226 @@
 // KIND, either express or implied.  See the License for the
 // specific language governing permissions and limitations
 // under the License.
-
-#include <ctime>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <iomanip>
 #include <iostream>
-#include <list>
+#include <map>
 #include <memory>
+#include <string>
+#include <thread>
+#include <vector>
 
 #include "parquet/api/reader.h"
+#include "parquet/arrow/reader.h"
+#include "parquet/read_metrics.h"
 
-int main(int argc, char** argv) {
-  if (argc > 4 || argc < 1) {
-    std::cerr << "Usage: parquet-scan [--batch-size=] [--columns=...] <file>"
-              << std::endl;
-    return -1;
+// Scans the values of the columns of a file and reports the wall time and
+// throughput, with a per-column breakdown of the read metrics
+static void Usage() {
+  std::cerr << "Usage: parquet-scan [--batch-size=] [--columns=...] [--threads=]\n"
+            << "                    [--io=mmap|buffered|file]"
+            << " [--reader=low-level|arrow]\n"
+            << "                    [--metrics] <file>\n"
+            << "  --columns takes leaf column indices or dot paths\n";
+}
+
+// Reads the row groups and columns in tasks of a column chunk each, which
+// num_threads threads take in turn. Returns the number of rows
+static int64_t ScanLowLevel(parquet::ParquetFileReader* reader,
+                            const std::vector<int>& columns, int batch_size,
+                            int num_threads) {
+  const int num_row_groups = reader->metadata()->num_row_groups();
+  const int64_t num_tasks = static_cast<int64_t>(num_row_groups) * columns.size();
+  std::atomic<int64_t> next_task(0);
+  // The rows of the chunks of the first column, by thread
+  std::vector<int64_t> thread_rows(num_threads, 0);
+  std::vector<std::string> errors(num_threads);
+
+  auto scan = [&](int thread) {
+    std::vector<int16_t> rep_levels(batch_size);
+    std::vector<int16_t> def_levels(batch_size);
+    std::vector<uint8_t> values;
+    try {
+      for (int64_t task = next_task++; task < num_tasks; task = next_task++) {
+        const int row_group = static_cast<int>(task / columns.size());
+        const size_t column = static_cast<size_t>(task % columns.size());
+        std::shared_ptr<parquet::ColumnReader> col_reader =
+            reader->RowGroup(row_group)->Column(columns[column]);
+        values.resize(batch_size *
+                      parquet::GetTypeByteSize(col_reader->descr()->physical_type()));
+        int64_t rows = 0;
+        int64_t values_buffered = 0;
+        while (col_reader->HasNext()) {
+          rows += parquet::ScanAllValues(batch_size, def_levels.data(), rep_levels.data(),
+                                         values.data(), &values_buffered,
+                                         col_reader.get());
+        }
+        if (column == 0) {
+          thread_rows[thread] += rows;
+        }
+      }
+    } catch (const std::exception& e) {
+      errors[thread] = e.what();
+      next_task = num_tasks;
+    }
+  };
+
+  std::vector<std::thread> threads;
+  for (int i = 1; i < num_threads; i++) {
+    threads.emplace_back(scan, i);
+  }
+  scan(0);
+  for (std::thread& thread : threads) {
+    thread.join();
   }
+  for (const std::string& error : errors) {
+    if (!error.empty()) {
+      throw parquet::ParquetException(error);
+    }
+  }
+  int64_t total_rows = 0;
+  for (int64_t rows : thread_rows) {
+    total_rows += rows;
+  }
+  return total_rows;
+}
 
+static int64_t ScanArrow(std::unique_ptr<parquet::ParquetFileReader> reader,
+                         const std::vector<int>& columns, int num_threads) {
+  parquet::arrow::FileReader arrow_reader(::arrow::default_memory_pool(),
+                                          std::move(reader));
+  arrow_reader.set_num_threads(num_threads);
+  std::shared_ptr<::arrow::Table> table;
+  ::arrow::Status status = arrow_reader.ReadTable(columns, &table);
+  if (!status.ok()) {
+    throw parquet::ParquetException(status.ToString());
+  }
+  return table->num_rows();
+}
+
+int main(int argc, char** argv) {
   std::string filename;
 
   // Read command-line options
   int batch_size = 256;
+  int num_threads = 1;
+  std::string io = "mmap";
+  std::string reader_type = "low-level";
+  bool print_metrics = false;
   const std::string COLUMNS_PREFIX = "--columns=";
   const std::string BATCH_SIZE_PREFIX = "--batch-size=";
-  std::vector<int> columns;
-  int num_columns = 0;
+  const std::string THREADS_PREFIX = "--threads=";
+  const std::string IO_PREFIX = "--io=";
+  const std::string READER_PREFIX = "--reader=";
+  std::vector<std::string> column_names;
 
-  char *param, *value;
   for (int i = 1; i < argc; i++) {
-    if ((param = std::strstr(argv[i], COLUMNS_PREFIX.c_str()))) {
-      value = std::strtok(param + COLUMNS_PREFIX.length(), ",");
+    const std::string arg = argv[i];
+    if (arg.compare(0, COLUMNS_PREFIX.length(), COLUMNS_PREFIX) == 0) {
+      char* value = std::strtok(argv[i] + COLUMNS_PREFIX.length(), ",");
       while (value) {
-        columns.push_back(std::atoi(value));
+        column_names.push_back(value);
         value = std::strtok(nullptr, ",");
-        num_columns++;
-      }
-    } else if ((param = std::strstr(argv[i], BATCH_SIZE_PREFIX.c_str()))) {
-      value = std::strtok(param + BATCH_SIZE_PREFIX.length(), " ");
-      if (value) {
-        batch_size = std::atoi(value);
       }
+    } else if (arg.compare(0, BATCH_SIZE_PREFIX.length(), BATCH_SIZE_PREFIX) == 0) {
+      batch_size = std::atoi(arg.c_str() + BATCH_SIZE_PREFIX.length());
+    } else if (arg.compare(0, THREADS_PREFIX.length(), THREADS_PREFIX) == 0) {
+      num_threads = std::atoi(arg.c_str() + THREADS_PREFIX.length());
+    } else if (arg.compare(0, IO_PREFIX.length(), IO_PREFIX) == 0) {
+      io = arg.substr(IO_PREFIX.length());
+    } else if (arg.compare(0, READER_PREFIX.length(), READER_PREFIX) == 0) {
+      reader_type = arg.substr(READER_PREFIX.length());
+    } else if (arg == "--metrics") {
+      print_metrics = true;
+    } else if (arg.compare(0, 2, "--") == 0 || !filename.empty()) {
+      Usage();
+      return -1;
     } else {
-      filename = argv[i];
+      filename = arg;
     }
   }
+  if (filename.empty() || batch_size < 1 || num_threads < 1 ||
+      (io != "mmap" && io != "buffered" && io != "file") ||
+      (reader_type != "low-level" && reader_type != "arrow")) {
+    Usage();
+    return -1;
+  }
 
   try {
-    double total_time;
-    std::clock_t start_time = std::clock();
+    parquet::ReaderProperties properties = parquet::default_reader_properties();
+    if (io == "buffered") {
+      properties.enable_buffered_stream();
+    }
+    auto metrics = std::make_shared<parquet::ReadMetrics>();
+    if (print_metrics) {
+      properties.set_read_metrics(metrics);
+    }
+
+    auto start_time = std::chrono::steady_clock::now();
     std::unique_ptr<parquet::ParquetFileReader> reader =
-        parquet::ParquetFileReader::OpenFile(filename);
+        parquet::ParquetFileReader::OpenFile(filename, io == "mmap", properties);
+    std::shared_ptr<parquet::FileMetaData> file_metadata = reader->metadata();
+
+    std::vector<int> columns;
+    for (const std::string& name : column_names) {
+      char* end;
+      const long index = std::strtol(name.c_str(), &end, 10);  // NOLINT
+      const int column = *end == '\0' ? static_cast<int>(index)
+                                      : file_metadata->schema()->ColumnIndex(name);
+      if (column < 0 || column >= file_metadata->num_columns()) {
+        std::cerr << "Unknown column: " << name << std::endl;
+        return -1;
+      }
+      columns.push_back(column);
+    }
+    if (columns.empty()) {
+      for (int i = 0; i < file_metadata->num_columns(); i++) {
+        columns.push_back(i);
+      }
+    }
 
-    int64_t total_rows = parquet::ScanFileContents(columns, batch_size, reader.get());
+    int64_t total_rows = 0;
+    if (reader_type == "arrow") {
+      total_rows = ScanArrow(std::move(reader), columns, num_threads);
+    } else {
+      total_rows = ScanLowLevel(reader.get(), columns, batch_size, num_threads);
+    }
+    const double total_time =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - start_time)
+            .count();
 
-    total_time = static_cast<double>(std::clock() - start_time) /
-      static_cast<double>(CLOCKS_PER_SEC);
-    std::cout << total_rows << " rows scanned in " << total_time << " seconds."
-              << std::endl;
+    // The bytes of the scanned column chunks as stored in the file
+    int64_t total_bytes = 0;
+    for (int r = 0; r < file_metadata->num_row_groups(); r++) {
+      auto row_group = file_metadata->RowGroup(r);
+      for (int column : columns) {
+        total_bytes += row_group->ColumnChunk(column)->total_compressed_size();
+      }
+    }
+
+    std::cout << total_rows << " rows scanned in " << total_time << " seconds, "
+              << static_cast<double>(total_bytes) / (1 << 20) / total_time << " MB/s, "
+              << static_cast<double>(total_rows) / total_time << " rows/s." << std::endl;
+
+    if (print_metrics) {
+      std::cout << std::left << std::setw(32) << "column" << std::right
+                << std::setw(14) << "bytes" << std::setw(8) << "pages" << std::setw(10)
+                << "io ms" << std::setw(14) << "decompress ms" << std::setw(10)
+                << "levels ms" << std::setw(10) << "values ms" << std::endl;
+      for (const auto& column : metrics->Get()) {
+        const parquet::ColumnReadMetrics& m = column.second;
+        std::cout << std::left << std::setw(32) << column.first << std::right
+                  << std::setw(14) << m.bytes_read << std::setw(8)
+                  << m.num_data_pages + m.num_dictionary_pages << std::setw(10)
+                  << m.io_nanos / 1000000 << std::setw(14) << m.decompress_nanos / 1000000
+                  << std::setw(10) << m.level_decode_nanos / 1000000 << std::setw(10)
+                  << m.value_decode_nanos / 1000000 << std::endl;
+      }
+    }
   } catch (const std::exception& e) {
     std::cerr << "Parquet error: " << e.what() << std::endl;
     return -1;
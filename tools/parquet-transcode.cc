@@ -0,0 +1,106 @@
+// Licensed to the Apache Software Foundation (ASF) under one
+// or more contributor license agreements.  See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership.  The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License.  You may obtain a copy of the License at
+//
+//   http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing,
+// software distributed under the License is distributed on an
+// "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+// KIND, either express or implied.  See the License for the
+// specific language governing permissions and limitations
+// under the License.
+
+#include <algorithm>
+#include <cctype>
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "arrow/io/file.h"
+
+#include "parquet/api/reader.h"
+#include "parquet/api/writer.h"
+
+// Rewrites a file with another codec. The pages are decompressed and
+// recompressed, their values are never decoded.
+static void Usage() {
+  std::cerr << "Usage: parquet-transcode --codec=<codec> <input> <output>\n"
+            << "  <codec> is one of uncompressed, snappy, gzip, brotli, lz4, zstd\n";
+}
+
+static bool ParseCodec(std::string name, parquet::Compression::type* codec) {
+  std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+  if (name == "uncompressed") {
+    *codec = parquet::Compression::UNCOMPRESSED;
+  } else if (name == "snappy") {
+    *codec = parquet::Compression::SNAPPY;
+  } else if (name == "gzip") {
+    *codec = parquet::Compression::GZIP;
+  } else if (name == "brotli") {
+    *codec = parquet::Compression::BROTLI;
+  } else if (name == "lz4") {
+    *codec = parquet::Compression::LZ4;
+  } else if (name == "zstd") {
+    *codec = parquet::Compression::ZSTD;
+  } else {
+    return false;
+  }
+  return true;
+}
+
+int main(int argc, char** argv) {
+  std::string input_path;
+  std::string output_path;
+  parquet::Compression::type codec = parquet::Compression::UNCOMPRESSED;
+  bool has_codec = false;
+  const std::string CODEC_PREFIX = "--codec=";
+
+  for (int i = 1; i < argc; i++) {
+    const std::string arg = argv[i];
+    if (arg.compare(0, CODEC_PREFIX.length(), CODEC_PREFIX) == 0) {
+      has_codec = ParseCodec(arg.substr(CODEC_PREFIX.length()), &codec);
+      if (!has_codec) {
+        Usage();
+        return -1;
+      }
+    } else if (arg.compare(0, 2, "--") == 0 || !output_path.empty()) {
+      Usage();
+      return -1;
+    } else if (input_path.empty()) {
+      input_path = arg;
+    } else {
+      output_path = arg;
+    }
+  }
+  if (!has_codec || output_path.empty()) {
+    Usage();
+    return -1;
+  }
+
+  try {
+    std::unique_ptr<parquet::ParquetFileReader> reader =
+        parquet::ParquetFileReader::OpenFile(input_path, false);
+    std::shared_ptr<parquet::FileMetaData> metadata = reader->metadata();
+
+    parquet::WriterProperties::Builder builder;
+    builder.compression(codec);
+    std::shared_ptr<::arrow::io::FileOutputStream> output;
+    PARQUET_THROW_NOT_OK(::arrow::io::FileOutputStream::Open(output_path, &output));
+    auto schema = std::static_pointer_cast<parquet::schema::GroupNode>(
+        metadata->schema()->schema_root());
+    std::unique_ptr<parquet::ParquetFileWriter> writer = parquet::ParquetFileWriter::Open(
+        output, schema, builder.build(), metadata->key_value_metadata());
+    writer->TranscodeRowGroups(reader.get());
+    writer->Close();
+  } catch (const std::exception& e) {
+    std::cerr << "Parquet error: " << e.what() << std::endl;
+    return -1;
+  }
+
+  return 0;
+}